@@ -9,10 +9,12 @@
 // Arguments:
 // - cchRowWidth - the length of the default text attribute
 // - attr - the default text attribute
+// - allocator - the allocator for the attribute runs. TextBuffer
+//   uses this to allocate the runs of all rows from a shared pool.
 // Return Value:
 // - constructed object
-ATTR_ROW::ATTR_ROW(const uint16_t width, const TextAttribute attr) :
-    _data(width, attr) {}
+ATTR_ROW::ATTR_ROW(const uint16_t width, const TextAttribute attr, const allocator_type& allocator) :
+    _data(width, attr, allocator) {}
 
 // Routine Description:
 // - Sets all properties of the ATTR_ROW to default values
@@ -67,6 +69,42 @@ std::vector<uint16_t> ATTR_ROW::GetHyperlinks() const
     return ids;
 }
 
+// Routine Description:
+// - Finds the attribute that colors most of the beginning of this row. Runs
+//   with a non-default color win over the ones without, so that a red error
+//   message stands out even when it's followed by plain text.
+// Arguments:
+// - endIndex - the number of cells to look at, usually the length of the text
+// Return value:
+// - The longest colored run's attribute, or the first cell's if there's none
+TextAttribute ATTR_ROW::GetDominantAttr(const uint16_t endIndex) const
+{
+    const auto& runs = _data.runs();
+    auto dominant = runs.front().value;
+    uint16_t dominantLength = 0;
+    uint16_t begin = 0;
+    for (const auto& run : runs)
+    {
+        if (begin >= endIndex)
+        {
+            break;
+        }
+
+        const auto& attr = run.value;
+        if (!attr.GetForeground().IsDefault() || !attr.BackgroundIsDefault() || attr.IsReverseVideo())
+        {
+            const auto length = std::min(run.length, gsl::narrow_cast<uint16_t>(endIndex - begin));
+            if (length > dominantLength)
+            {
+                dominant = attr;
+                dominantLength = length;
+            }
+        }
+        begin = gsl::narrow_cast<uint16_t>(begin + run.length);
+    }
+    return dominant;
+}
+
 // Routine Description:
 // - Sets the attributes (colors) of all character positions from the given position through the end of the row.
 // Arguments:
@@ -108,6 +146,23 @@ void ATTR_ROW::Replace(const uint16_t beginIndex, const uint16_t endIndex, const
     _data.replace(beginIndex, endIndex, newAttr);
 }
 
+// Routine Description:
+// - Replaces the attributes of the range starting at targetIndex with the ones
+//   of the range [beginIndex, endIndex) of the given row, run by run.
+//   The source may be this very row, even if the ranges overlap.
+// Arguments:
+// - source - the row to copy the attributes from
+// - beginIndex, endIndex: The [beginIndex, endIndex) range of source to copy.
+// - targetIndex - the first column in this row to copy the attributes to.
+// Return Value:
+// - <none>
+void ATTR_ROW::CopyAttrs(const ATTR_ROW& source, const uint16_t beginIndex, const uint16_t endIndex, const uint16_t targetIndex)
+{
+    // The slice is a copy, which is what makes copying within the same row work.
+    const auto runs = source._data.slice(beginIndex, endIndex);
+    _data.replace(targetIndex, gsl::narrow_cast<uint16_t>(targetIndex + runs.size()), runs.runs());
+}
+
 ATTR_ROW::const_iterator ATTR_ROW::begin() const noexcept
 {
     return _data.begin();
@@ -128,6 +183,15 @@ ATTR_ROW::const_iterator ATTR_ROW::cend() const noexcept
     return _data.cend();
 }
 
+// Routine Description:
+// - Provides the runs the attributes are stored as, so that they can be
+//   walked one run at a time (see TextBufferRunIterator). Their lengths
+//   always add up to the width of the row.
+const ATTR_ROW::run_container& ATTR_ROW::Runs() const noexcept
+{
+    return _data.runs();
+}
+
 bool operator==(const ATTR_ROW& a, const ATTR_ROW& b) noexcept
 {
     return a._data == b._data;
@@ -25,12 +25,14 @@ Revision History:
 
 class ATTR_ROW final
 {
-    using rle_vector = til::small_rle<TextAttribute, uint16_t, 1>;
+    using rle_vector = til::pmr::rle<TextAttribute, uint16_t>;
 
 public:
     using const_iterator = rle_vector::const_iterator;
+    using allocator_type = rle_vector::allocator_type;
+    using run_container = rle_vector::container;
 
-    ATTR_ROW(uint16_t width, TextAttribute attr);
+    ATTR_ROW(uint16_t width, TextAttribute attr, const allocator_type& allocator = {});
 
     ~ATTR_ROW() = default;
 
@@ -42,11 +44,13 @@ public:
 
     TextAttribute GetAttrByColumn(uint16_t column) const;
     std::vector<uint16_t> GetHyperlinks() const;
+    TextAttribute GetDominantAttr(const uint16_t endIndex) const;
 
     bool SetAttrToEnd(uint16_t beginIndex, TextAttribute attr);
     void ReplaceAttrs(const TextAttribute& toBeReplacedAttr, const TextAttribute& replaceWith);
     void Resize(uint16_t newWidth);
     void Replace(uint16_t beginIndex, uint16_t endIndex, const TextAttribute& newAttr);
+    void CopyAttrs(const ATTR_ROW& source, uint16_t beginIndex, uint16_t endIndex, uint16_t targetIndex);
 
     const_iterator begin() const noexcept;
     const_iterator end() const noexcept;
@@ -54,6 +58,8 @@ public:
     const_iterator cbegin() const noexcept;
     const_iterator cend() const noexcept;
 
+    const run_container& Runs() const noexcept;
+
     friend bool operator==(const ATTR_ROW& a, const ATTR_ROW& b) noexcept;
     friend class ROW;
 
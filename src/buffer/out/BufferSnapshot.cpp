@@ -0,0 +1,280 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+
+#include "BufferSnapshot.hpp"
+#include "PackedRow.hpp"
+#include "textBuffer.hpp"
+
+struct SnapshotHeader
+{
+    COORD size;
+    COORD cursorPosition;
+    uint16_t currentHyperlinkId;
+};
+
+static SnapshotHeader _ReadHeader(SnapshotDecoder& decoder)
+{
+    THROW_HR_IF(HRESULT_FROM_WIN32(ERROR_INVALID_DATA), decoder.Read<uint32_t>() != BufferSnapshot::Magic);
+    THROW_HR_IF(HRESULT_FROM_WIN32(ERROR_UNSUPPORTED_TYPE), decoder.Read<uint16_t>() != BufferSnapshot::Version);
+    // The attributes are stored as they're laid out in memory.
+    THROW_HR_IF(HRESULT_FROM_WIN32(ERROR_UNSUPPORTED_TYPE), decoder.Read<uint16_t>() != sizeof(TextAttribute));
+
+    SnapshotHeader header;
+    header.size.X = decoder.Read<SHORT>();
+    header.size.Y = decoder.Read<SHORT>();
+    header.cursorPosition.X = decoder.Read<SHORT>();
+    header.cursorPosition.Y = decoder.Read<SHORT>();
+    header.currentHyperlinkId = decoder.Read<uint16_t>();
+    THROW_HR_IF(HRESULT_FROM_WIN32(ERROR_INVALID_DATA), header.size.X <= 0 || header.size.Y <= 0);
+    return header;
+}
+
+// Routine Description:
+// - Brings the snapshot up to date with the given buffer. Only the rows that
+//   changed since the last update are encoded again, so this is cheap to
+//   call repeatedly. The caller must hold the lock of the buffer.
+// Arguments:
+// - buffer - the buffer to take the snapshot of
+// Return Value:
+// - <none>
+void BufferSnapshot::Update(const TextBuffer& buffer)
+{
+    const auto size = buffer.GetSize();
+    _size = size.Dimensions();
+    _cursorPosition = buffer.GetCursor().GetPosition();
+    _currentHyperlinkId = buffer._currentHyperlinkId;
+
+    _hyperlinks.clear();
+    for (const auto& [id, uri] : buffer._hyperlinkMap)
+    {
+        _hyperlinks.emplace_back(id, til::u16u8(uri));
+    }
+    _customHyperlinkIds.clear();
+    for (const auto& [key, id] : buffer._hyperlinkCustomIdMap)
+    {
+        _customHyperlinkIds.emplace_back(til::u16u8(key), id);
+    }
+
+    // A row's generation changes whenever its contents might have, and no two
+    // rows ever share one. Every row we saw before can thus reuse its encoding.
+    std::unordered_map<uint64_t, std::string> encodedRows;
+    encodedRows.reserve(gsl::narrow_cast<size_t>(size.Height()));
+    _rows.clear();
+    for (SHORT y = 0; y < size.Height(); ++y)
+    {
+        const auto& row = buffer.GetRowByOffset(y);
+        const auto generation = row.GetGeneration();
+        _rows.emplace_back(generation);
+
+        if (const auto it = _encodedRows.find(generation); it != _encodedRows.end())
+        {
+            encodedRows.emplace(generation, std::move(it->second));
+        }
+        else
+        {
+            std::string encoded;
+            SnapshotEncoder encoder{ encoded };
+            PackedRow::Pack(row).Serialize(encoder);
+            encodedRows.emplace(generation, std::move(encoded));
+        }
+    }
+    _encodedRows = std::move(encodedRows);
+}
+
+// Routine Description:
+// - Formats the snapshot as it was at the last Update(). This doesn't touch
+//   the buffer, so it doesn't need its lock.
+// Arguments:
+// - <none>
+// Return Value:
+// - the bytes of the snapshot
+std::string BufferSnapshot::Serialize() const
+{
+    size_t rowBytes = 0;
+    for (const auto& [generation, encoded] : _encodedRows)
+    {
+        rowBytes += sizeof(uint32_t) + encoded.size();
+    }
+
+    std::string bytes;
+    bytes.reserve(64 + rowBytes);
+    SnapshotEncoder encoder{ bytes };
+
+    encoder.Write(Magic);
+    encoder.Write(Version);
+    encoder.Write(gsl::narrow<uint16_t>(sizeof(TextAttribute)));
+    encoder.Write(_size.X);
+    encoder.Write(_size.Y);
+    encoder.Write(_cursorPosition.X);
+    encoder.Write(_cursorPosition.Y);
+    encoder.Write(_currentHyperlinkId);
+
+    encoder.Write(gsl::narrow<uint32_t>(_hyperlinks.size()));
+    for (const auto& [id, uri] : _hyperlinks)
+    {
+        encoder.Write(id);
+        encoder.WriteString(uri);
+    }
+
+    encoder.Write(gsl::narrow<uint32_t>(_customHyperlinkIds.size()));
+    for (const auto& [key, id] : _customHyperlinkIds)
+    {
+        encoder.WriteString(key);
+        encoder.Write(id);
+    }
+
+    encoder.Write(gsl::narrow<uint32_t>(_rows.size()));
+    for (const auto generation : _rows)
+    {
+        encoder.WriteString(_encodedRows.at(generation));
+    }
+
+    return bytes;
+}
+
+// Routine Description:
+// - Writes the snapshot as it was at the last Update() to the given file.
+//   It's written to a temporary file first, which then replaces the given
+//   one. This way a crash in the middle of writing doesn't lose the previous
+//   snapshot. This doesn't touch the buffer, so it can run in the background.
+// Arguments:
+// - path - the file to write
+// Return Value:
+// - <none>
+void BufferSnapshot::WriteToFile(const std::wstring& path) const
+{
+    const auto bytes = Serialize();
+    const auto temporaryPath = path + L".tmp";
+
+    {
+        wil::unique_hfile file{ CreateFileW(temporaryPath.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr) };
+        THROW_LAST_ERROR_IF(!file);
+        DWORD written = 0;
+        THROW_IF_WIN32_BOOL_FALSE(WriteFile(file.get(), bytes.data(), gsl::narrow<DWORD>(bytes.size()), &written, nullptr));
+    }
+
+    THROW_IF_WIN32_BOOL_FALSE(MoveFileExW(temporaryPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING));
+}
+
+// Routine Description:
+// - Returns the size of the buffer that the snapshot was taken of, so that a
+//   buffer of the right width can be created to restore it into.
+// Arguments:
+// - bytes - the snapshot
+// Return Value:
+// - the width and height of the buffer, in cells
+COORD BufferSnapshot::ReadSize(const std::string_view bytes)
+{
+    SnapshotDecoder decoder{ bytes };
+    return _ReadHeader(decoder).size;
+}
+
+// Routine Description:
+// - Restores the contents of a snapshot into the given buffer. The buffer
+//   needs to be as wide as the buffer the snapshot was taken of (see
+//   ReadSize). If it has fewer rows, only the most recent rows are restored.
+// - The whole snapshot is validated before the buffer is modified, so a broken
+//   snapshot leaves the buffer untouched.
+// Arguments:
+// - bytes - the snapshot
+// - buffer - the buffer to restore into
+// Return Value:
+// - <none>
+void BufferSnapshot::Restore(const std::string_view bytes, TextBuffer& buffer)
+{
+    SnapshotDecoder decoder{ bytes };
+    const auto header = _ReadHeader(decoder);
+
+    const auto size = buffer.GetSize();
+    THROW_HR_IF(E_INVALIDARG, header.size.X != size.Width());
+
+    std::vector<std::pair<uint16_t, std::wstring>> hyperlinks;
+    hyperlinks.resize(decoder.ReadCount(sizeof(uint16_t) + sizeof(uint32_t)));
+    for (auto& [id, uri] : hyperlinks)
+    {
+        id = decoder.Read<uint16_t>();
+        uri = til::u8u16(decoder.ReadString());
+    }
+
+    std::vector<std::pair<std::wstring, uint16_t>> customHyperlinkIds;
+    customHyperlinkIds.resize(decoder.ReadCount(sizeof(uint32_t) + sizeof(uint16_t)));
+    for (auto& [key, id] : customHyperlinkIds)
+    {
+        key = til::u8u16(decoder.ReadString());
+        id = decoder.Read<uint16_t>();
+    }
+
+    const auto rowCount = decoder.ReadCount(sizeof(uint32_t));
+    const auto skippedRows = rowCount > gsl::narrow_cast<size_t>(size.Height()) ? rowCount - size.Height() : 0;
+    std::vector<PackedRow> rows;
+    rows.reserve(rowCount - skippedRows);
+    for (size_t i = 0; i < rowCount; ++i)
+    {
+        const auto encoded = decoder.ReadString();
+        if (i < skippedRows)
+        {
+            continue;
+        }
+
+        SnapshotDecoder rowDecoder{ encoded };
+        auto row = PackedRow::Deserialize(rowDecoder);
+        THROW_HR_IF(HRESULT_FROM_WIN32(ERROR_INVALID_DATA), row.Width() != gsl::narrow_cast<size_t>(size.Width()));
+        rows.emplace_back(std::move(row));
+    }
+    THROW_HR_IF(HRESULT_FROM_WIN32(ERROR_INVALID_DATA), !decoder.AtEnd());
+
+    for (size_t i = 0; i < rows.size(); ++i)
+    {
+        rows[i].Unpack(buffer.GetRowByOffset(i));
+    }
+
+    buffer._hyperlinkMap.clear();
+    for (auto& [id, uri] : hyperlinks)
+    {
+        buffer._hyperlinkMap.emplace(id, std::move(uri));
+    }
+    buffer._hyperlinkCustomIdMap.clear();
+    for (auto& [key, id] : customHyperlinkIds)
+    {
+        buffer._hyperlinkCustomIdMap.emplace(std::move(key), id);
+    }
+    // Like in GetHyperlinkId, 0 isn't a valid ID.
+    buffer._currentHyperlinkId = header.currentHyperlinkId ? header.currentHyperlinkId : 1;
+    // The IDs that were free before may be in use by the restored rows.
+    // The ones that are free in the snapshot will be found by the next sweep.
+    buffer._freeHyperlinkIds.clear();
+
+    auto cursorPosition = header.cursorPosition;
+    cursorPosition.Y = gsl::narrow_cast<SHORT>(cursorPosition.Y - skippedRows);
+    size.Clamp(cursorPosition);
+    buffer.GetCursor().SetPosition(cursorPosition);
+}
+
+// Routine Description:
+// - Restores the contents of a snapshot file into the given buffer. The file
+//   is memory mapped, so the rows are decoded straight from it. See Restore.
+// Arguments:
+// - path - the snapshot file
+// - buffer - the buffer to restore into
+// Return Value:
+// - <none>
+void BufferSnapshot::RestoreFromFile(const std::wstring& path, TextBuffer& buffer)
+{
+    wil::unique_hfile file{ CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr) };
+    THROW_LAST_ERROR_IF(!file);
+
+    LARGE_INTEGER fileSize{};
+    THROW_IF_WIN32_BOOL_FALSE(GetFileSizeEx(file.get(), &fileSize));
+    // Mapping an empty file fails, and it wouldn't be a valid snapshot anyway.
+    THROW_HR_IF(HRESULT_FROM_WIN32(ERROR_INVALID_DATA), fileSize.QuadPart == 0);
+
+    wil::unique_handle mapping{ CreateFileMappingW(file.get(), nullptr, PAGE_READONLY, 0, 0, nullptr) };
+    THROW_LAST_ERROR_IF(!mapping);
+
+    wil::unique_mapview_ptr<char> view{ static_cast<char*>(MapViewOfFile(mapping.get(), FILE_MAP_READ, 0, 0, 0)) };
+    THROW_LAST_ERROR_IF(!view);
+
+    Restore({ view.get(), gsl::narrow<size_t>(fileSize.QuadPart) }, buffer);
+}
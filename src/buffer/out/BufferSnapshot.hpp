@@ -0,0 +1,134 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- BufferSnapshot.hpp
+
+Abstract:
+- A compact, versioned binary snapshot of a TextBuffer, so that its contents
+  can be saved and restored without re-parsing any VT.
+- Every row is stored as a PackedRow (UTF-8 text, run length encoded
+  attributes, line rendition and wrap flags), next to the hyperlink table and
+  the cursor position.
+- Snapshots are meant to be taken repeatedly: Update() only re-encodes the rows
+  whose generation changed since the last call and is the only part that needs
+  the buffer (and thus its lock). WriteToFile() can then run in the background.
+- Snapshot files are memory mapped on restore and the rows are streamed
+  straight into the TextBuffer.
+
+Format (all values little endian):
+- header: magic "WTBS", uint16 version, uint16 sizeof(TextAttribute),
+  int16 width, int16 height, int16 cursor x, int16 cursor y,
+  uint16 current hyperlink ID
+- hyperlinks: uint32 count, { uint16 ID, string URI }
+- custom hyperlink IDs: uint32 count, { string key, uint16 ID }
+- rows: uint32 count, { string PackedRow }, oldest row first
+- strings are a uint32 length in bytes followed by that many bytes of UTF-8
+--*/
+
+#pragma once
+
+class TextBuffer;
+
+// Appends values to the bytes of a snapshot.
+class SnapshotEncoder final
+{
+public:
+    explicit SnapshotEncoder(std::string& bytes) noexcept :
+        _bytes{ bytes }
+    {
+    }
+
+    template<typename T>
+    void Write(const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        _bytes.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void WriteString(const std::string_view value)
+    {
+        Write(gsl::narrow<uint32_t>(value.size()));
+        _bytes.append(value);
+    }
+
+private:
+    std::string& _bytes;
+};
+
+// Reads values back from the bytes of a snapshot.
+// Throws if the snapshot ends prematurely.
+class SnapshotDecoder final
+{
+public:
+    explicit SnapshotDecoder(const std::string_view bytes) noexcept :
+        _bytes{ bytes }
+    {
+    }
+
+    template<typename T>
+    T Read()
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        T value;
+        memcpy(&value, _Consume(sizeof(T)).data(), sizeof(T));
+        return value;
+    }
+
+    std::string_view ReadString()
+    {
+        return _Consume(Read<uint32_t>());
+    }
+
+    // Reads the count of a list whose elements take at least elementSize bytes.
+    // This way a broken snapshot can't make us allocate absurd amounts of memory.
+    size_t ReadCount(const size_t elementSize)
+    {
+        const size_t count = Read<uint32_t>();
+        THROW_HR_IF(HRESULT_FROM_WIN32(ERROR_INVALID_DATA), count > _bytes.size() / elementSize);
+        return count;
+    }
+
+    bool AtEnd() const noexcept
+    {
+        return _bytes.empty();
+    }
+
+private:
+    std::string_view _Consume(const size_t size)
+    {
+        THROW_HR_IF(HRESULT_FROM_WIN32(ERROR_INVALID_DATA), size > _bytes.size());
+        const auto consumed = _bytes.substr(0, size);
+        _bytes = _bytes.substr(size);
+        return consumed;
+    }
+
+    std::string_view _bytes;
+};
+
+class BufferSnapshot final
+{
+public:
+    static constexpr uint32_t Magic = 0x53425457; // "WTBS"
+    static constexpr uint16_t Version = 1;
+
+    void Update(const TextBuffer& buffer);
+    std::string Serialize() const;
+    void WriteToFile(const std::wstring& path) const;
+
+    static COORD ReadSize(const std::string_view bytes);
+    static void Restore(const std::string_view bytes, TextBuffer& buffer);
+    static void RestoreFromFile(const std::wstring& path, TextBuffer& buffer);
+
+private:
+    COORD _size{};
+    COORD _cursorPosition{};
+    uint16_t _currentHyperlinkId = 0;
+    std::vector<std::pair<uint16_t, std::string>> _hyperlinks;
+    std::vector<std::pair<std::string, uint16_t>> _customHyperlinkIds;
+    // The generation of every row, oldest first, and the encoded PackedRow
+    // for each of those generations.
+    std::vector<uint64_t> _rows;
+    std::unordered_map<uint64_t, std::string> _encodedRows;
+};
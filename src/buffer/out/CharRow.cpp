@@ -10,20 +10,77 @@
 // Routine Description:
 // - constructor
 // Arguments:
-// - rowWidth - the size (in wchar_t) of the char and attribute rows
-// - pParent - the parent ROW
+// - width - the number of cells in each row
+// - height - the number of rows
 // Return Value:
 // - instantiated object
-// Note: will through if unable to allocate char/attribute buffers
+// Note: will throw if unable to allocate the char/attribute buffers
+CharRowStorage::CharRowStorage(const size_t width, const size_t height) :
+    _chars{ std::make_unique<wchar_t[]>(width * height) },
+    _dbcsAttrs{ std::make_unique<DbcsAttribute[]>(width * height) },
+    _width{ width },
+    _height{ height }
+{
+}
+
+size_t CharRowStorage::width() const noexcept
+{
+    return _width;
+}
+
+size_t CharRowStorage::height() const noexcept
+{
+    return _height;
+}
+
 #pragma warning(push)
-#pragma warning(disable : 26447) // small_vector's constructor says it can throw but it should not given how we use it.  This suppresses this error for the AuditMode build.
-CharRow::CharRow(size_t rowWidth, ROW* const pParent) noexcept :
-    _data(rowWidth, value_type()),
-    _pParent{ FAIL_FAST_IF_NULL(pParent) }
+#pragma warning(disable : 26481) // Don't use pointer arithmetic. Use span instead (bounds.1).
+
+// Routine Description:
+// - returns the glyph cells of the given row
+// Arguments:
+// - row - the index of the row, in storage order
+// Return Value:
+// - a span of width() glyphs
+// Note: will throw exception if row is out of bounds
+gsl::span<wchar_t> CharRowStorage::Chars(const size_t row) const
 {
+    THROW_HR_IF(E_INVALIDARG, row >= _height);
+    return { _chars.get() + row * _width, _width };
 }
+
+// Routine Description:
+// - returns the DBCS attribute cells of the given row
+// Arguments:
+// - row - the index of the row, in storage order
+// Return Value:
+// - a span of width() attributes
+// Note: will throw exception if row is out of bounds
+gsl::span<DbcsAttribute> CharRowStorage::DbcsAttrs(const size_t row) const
+{
+    THROW_HR_IF(E_INVALIDARG, row >= _height);
+    return { _dbcsAttrs.get() + row * _width, _width };
+}
+
 #pragma warning(pop)
 
+// Routine Description:
+// - constructor
+// Arguments:
+// - chars - the glyph cells of this row, owned by the parent buffer
+// - dbcsAttrs - the DBCS attribute cells of this row. Must be the same size as chars.
+// - pParent - the parent ROW
+// Return Value:
+// - instantiated object
+CharRow::CharRow(const gsl::span<wchar_t> chars, const gsl::span<DbcsAttribute> dbcsAttrs, ROW* const pParent) noexcept :
+    _chars{ chars },
+    _dbcsAttrs{ dbcsAttrs },
+    _pParent{ FAIL_FAST_IF_NULL(pParent) }
+{
+    FAIL_FAST_IF(_chars.size() != _dbcsAttrs.size());
+    Reset();
+}
+
 // Routine Description:
 // - gets the size of the row, in glyph cells
 // Arguments:
@@ -32,59 +89,109 @@ CharRow::CharRow(size_t rowWidth, ROW* const pParent) noexcept :
 // - the size of the row
 size_t CharRow::size() const noexcept
 {
-    return _data.size();
+    return _chars.size();
 }
 
 // Routine Description:
 // - Sets all properties of the CharRowBase to default values
+// - The cells aren't cleared right away, as most rows that are reset (for
+//   instance the ones scrolling in at the bottom) are only partially, if
+//   at all, written to before they're reset again. See _Materialize.
 // Arguments:
 // - sRowWidth - The width of the row.
 // Return Value:
 // - <none>
 void CharRow::Reset() noexcept
 {
-    for (auto& cell : _data)
-    {
-        cell.Reset();
-    }
+    _pendingReset = true;
+    _measuredRight = 0;
 }
 
 // Routine Description:
-// - resizes the width of the CharRowBase
+// - Clears the cells for real after a Reset, right before they're modified
+//   (or a mutable reference to them is handed out).
 // Arguments:
-// - newSize - the new width of the character and attributes rows
+// - <none>
 // Return Value:
-// - S_OK on success, otherwise relevant error code
-[[nodiscard]] HRESULT CharRow::Resize(const size_t newSize) noexcept
+// - <none>
+void CharRow::_Materialize() noexcept
 {
-    try
+    if (_pendingReset)
     {
-        const value_type insertVals;
-        _data.resize(newSize, insertVals);
+        std::fill(_chars.begin(), _chars.end(), UNICODE_SPACE);
+        std::fill(_dbcsAttrs.begin(), _dbcsAttrs.end(), DbcsAttribute{});
+        _pendingReset = false;
     }
-    CATCH_RETURN();
-
-    return S_OK;
 }
 
-typename CharRow::iterator CharRow::begin() noexcept
+// Routine Description:
+// - Like _Materialize, but for a write of the given cells, which doesn't
+//   need the cells to be cleared first if it covers the entire row.
+// Arguments:
+// - column - the first cell that's about to be written
+// - count - the number of cells that are about to be written
+// Return Value:
+// - <none>
+void CharRow::_MaterializeUnlessOverwritten(const size_t column, const size_t count) noexcept
 {
-    return _data.begin();
+    if (column == 0 && count == size())
+    {
+        _pendingReset = false;
+    }
+    else
+    {
+        _Materialize();
+    }
 }
 
-typename CharRow::const_iterator CharRow::cbegin() const noexcept
+// Routine Description:
+// - moves the contents of the row into new cells, which changes the width of the row.
+//   Columns past the old width are filled with spaces.
+// Arguments:
+// - chars - the new glyph cells of this row, owned by the parent buffer
+// - dbcsAttrs - the new DBCS attribute cells of this row. Must be the same size as chars.
+// Return Value:
+// - <none>
+void CharRow::Resize(const gsl::span<wchar_t> chars, const gsl::span<DbcsAttribute> dbcsAttrs) noexcept
 {
-    return _data.cbegin();
-}
+    FAIL_FAST_IF(chars.size() != dbcsAttrs.size());
 
-typename CharRow::iterator CharRow::end() noexcept
-{
-    return _data.end();
+    if (_pendingReset)
+    {
+        // The new cells will be cleared like the old ones would have been.
+        _chars = chars;
+        _dbcsAttrs = dbcsAttrs;
+        return;
+    }
+
+    const auto count = std::min(_chars.size(), chars.size());
+    if (chars.data() != _chars.data())
+    {
+        std::copy_n(_chars.begin(), count, chars.begin());
+        std::copy_n(_dbcsAttrs.begin(), count, dbcsAttrs.begin());
+    }
+    std::fill(chars.begin() + count, chars.end(), UNICODE_SPACE);
+    std::fill(dbcsAttrs.begin() + count, dbcsAttrs.end(), DbcsAttribute{});
+
+    _chars = chars;
+    _dbcsAttrs = dbcsAttrs;
+
+    // The new columns are all spaces, so only cutting content off moves the right edge.
+    if (_measuredRight != UnknownRight && _measuredRight > chars.size())
+    {
+        _measuredRight = UnknownRight;
+    }
 }
 
-typename CharRow::const_iterator CharRow::cend() const noexcept
+// Routine Description:
+// - checks if the cell at the given column contains a space glyph
+// Arguments:
+// - column - the column to check. Must be in bounds.
+// Return Value:
+// - true if cell contains a space glyph, false otherwise
+bool CharRow::_IsSpace(const size_t column) const noexcept
 {
-    return _data.cend();
+    return !til::at(_dbcsAttrs, column).IsGlyphStored() && til::at(_chars, column) == UNICODE_SPACE;
 }
 
 // Routine Description:
@@ -95,33 +202,182 @@ typename CharRow::const_iterator CharRow::cend() const noexcept
 // - The calculated left boundary of the internal string.
 size_t CharRow::MeasureLeft() const noexcept
 {
-    const_iterator it = _data.cbegin();
-    while (it != _data.cend() && it->IsSpace())
+    if (_pendingReset)
     {
-        ++it;
+        return size();
     }
-    return it - _data.cbegin();
+
+    size_t column = 0;
+    while (column < size() && _IsSpace(column))
+    {
+        ++column;
+    }
+    return column;
 }
 
 // Routine Description:
 // - Inspects the current internal string to find the right edge of it
+// - The result is cached and maintained by the writes to this row, so this
+//   only walks the row when it was modified in a way we can't keep track of.
 // Arguments:
 // - <none>
 // Return Value:
 // - The calculated right boundary of the internal string.
 size_t CharRow::MeasureRight() const
 {
-    const_reverse_iterator it = _data.crbegin();
-    while (it != _data.crend() && it->IsSpace())
+    if (_measuredRight == UnknownRight)
     {
-        ++it;
+        size_t column = size();
+        while (column > 0 && _IsSpace(column - 1))
+        {
+            --column;
+        }
+        _measuredRight = column;
+    }
+    return _measuredRight;
+}
+
+// Routine Description:
+// - Updates the cached right edge after the given cells were modified. Only
+//   the modified cells are looked at, unless they were the right edge and
+//   are all spaces now, in which case the next MeasureRight walks the row.
+// Arguments:
+// - column - the first modified cell
+// - count - the number of modified cells
+// Return Value:
+// - <none>
+void CharRow::_CellsChanged(const size_t column, const size_t count) noexcept
+{
+    const auto end = std::min(column + count, size());
+    if (_measuredRight == UnknownRight || end < _measuredRight)
+    {
+        // There's content past the modified cells, so the right edge didn't move.
+        return;
+    }
+
+    // Every cell past the modified ones is a space, so the last one
+    // of them that isn't is the new right edge.
+    for (auto right = end; right > column; --right)
+    {
+        if (!_IsSpace(right - 1))
+        {
+            _measuredRight = right;
+            return;
+        }
+    }
+
+    if (column < _measuredRight)
+    {
+        // The content ended in the modified cells and they're blank now.
+        _measuredRight = UnknownRight;
     }
-    return _data.crend() - it;
 }
 
 void CharRow::ClearCell(const size_t column)
 {
-    _data.at(column).Reset();
+    THROW_HR_IF(E_INVALIDARG, column >= size());
+    _Materialize();
+    til::at(_chars, column) = UNICODE_SPACE;
+    til::at(_dbcsAttrs, column).Reset();
+    _CellsChanged(column, 1);
+}
+
+// Routine Description:
+// - writes a glyph and its DBCS attribute into a cell. Unlike assigning to
+//   DbcsAttrAt and GlyphAt, this keeps the right edge of the row measured.
+// Arguments:
+// - column - the column of the cell to write
+// - dbcsAttr - the DBCS attribute of the glyph
+// - chars - the glyph
+// Return Value:
+// - <none>
+void CharRow::WriteCell(const size_t column, const DbcsAttribute dbcsAttr, const std::wstring_view chars)
+{
+    THROW_HR_IF(E_INVALIDARG, column >= size());
+    _Materialize();
+    til::at(_dbcsAttrs, column) = dbcsAttr;
+    GlyphAt(column) = chars;
+}
+
+// Routine Description:
+// - copies single-width glyphs of one code unit each into consecutive cells
+// Arguments:
+// - column - the column of the first cell to write
+// - chars - the glyphs to write. It's the caller's responsibility to
+//   ensure that every one of them is a narrow, non-surrogate character.
+// Return Value:
+// - <none>
+void CharRow::WriteNarrowGlyphs(const size_t column, const std::wstring_view chars)
+{
+    THROW_HR_IF(E_INVALIDARG, column > size() || chars.size() > size() - column);
+    _MaterializeUnlessOverwritten(column, chars.size());
+    std::copy(chars.begin(), chars.end(), _chars.begin() + column);
+    std::fill_n(_dbcsAttrs.begin() + column, chars.size(), DbcsAttribute{});
+    _CellsChanged(column, chars.size());
+}
+
+// Routine Description:
+// - fills consecutive cells with the same single-width glyph of one code unit
+// Arguments:
+// - column - the column of the first cell to fill
+// - count - the number of cells to fill
+// - wch - the glyph to fill with. It's the caller's responsibility to
+//   ensure that it is a narrow, non-surrogate character.
+// Return Value:
+// - <none>
+void CharRow::FillNarrowGlyphs(const size_t column, const size_t count, const wchar_t wch)
+{
+    THROW_HR_IF(E_INVALIDARG, column > size() || count > size() - column);
+    _MaterializeUnlessOverwritten(column, count);
+    std::fill_n(_chars.begin() + column, count, wch);
+    std::fill_n(_dbcsAttrs.begin() + column, count, DbcsAttribute{});
+    _CellsChanged(column, count);
+}
+
+// Routine Description:
+// - copies cells from the given row (which may be this one) into this one,
+//   like memmove does. Glyphs that are kept in the UnicodeStorage aren't
+//   carried over, so it's the caller's responsibility to ensure that none of
+//   the source cells holds one.
+// Arguments:
+// - source - the row to copy from
+// - sourceColumn - the column of the first cell to copy
+// - targetColumn - the column in this row to copy the first cell to
+// - count - the number of cells to copy
+// Return Value:
+// - <none>
+void CharRow::CopyCells(const CharRow& source, const size_t sourceColumn, const size_t targetColumn, const size_t count)
+{
+    THROW_HR_IF(E_INVALIDARG, sourceColumn > source.size() || count > source.size() - sourceColumn);
+    THROW_HR_IF(E_INVALIDARG, targetColumn > size() || count > size() - targetColumn);
+
+    // Whether the source is blank must be checked before the target is
+    // materialized, as they might be the same row.
+    const auto sourceIsBlank = source._pendingReset;
+    _MaterializeUnlessOverwritten(targetColumn, count);
+    if (sourceIsBlank)
+    {
+        // The source cells are all spaces, they just don't know it yet.
+        std::fill_n(_chars.begin() + targetColumn, count, UNICODE_SPACE);
+        std::fill_n(_dbcsAttrs.begin() + targetColumn, count, DbcsAttribute{});
+        _CellsChanged(targetColumn, count);
+        return;
+    }
+
+    const auto copy = [&](const auto& from, const auto& to) {
+        const auto first = from.begin() + sourceColumn;
+        if (&source != this || targetColumn < sourceColumn)
+        {
+            std::copy(first, first + count, to.begin() + targetColumn);
+        }
+        else
+        {
+            std::copy_backward(first, first + count, to.begin() + targetColumn + count);
+        }
+    };
+    copy(source._chars, _chars);
+    copy(source._dbcsAttrs, _dbcsAttrs);
+    _CellsChanged(targetColumn, count);
 }
 
 // Routine Description:
@@ -132,14 +388,11 @@ void CharRow::ClearCell(const size_t column)
 // - True if there is valid text in this row. False otherwise.
 bool CharRow::ContainsText() const noexcept
 {
-    for (const value_type& cell : _data)
+    if (_measuredRight != UnknownRight)
     {
-        if (!cell.IsSpace())
-        {
-            return true;
-        }
+        return _measuredRight != 0;
     }
-    return false;
+    return MeasureLeft() != size();
 }
 
 // Routine Description:
@@ -151,7 +404,13 @@ bool CharRow::ContainsText() const noexcept
 // Note: will throw exception if column is out of bounds
 const DbcsAttribute& CharRow::DbcsAttrAt(const size_t column) const
 {
-    return _data.at(column).DbcsAttr();
+    THROW_HR_IF(E_INVALIDARG, column >= size());
+    if (_pendingReset)
+    {
+        static const DbcsAttribute blank{};
+        return blank;
+    }
+    return til::at(_dbcsAttrs, column);
 }
 
 // Routine Description:
@@ -161,9 +420,14 @@ const DbcsAttribute& CharRow::DbcsAttrAt(const size_t column) const
 // Return Value:
 // - the attribute
 // Note: will throw exception if column is out of bounds
+// Note: as we can't tell what's done with the attribute, the right edge
+//   of the row has to be measured again afterwards. See WriteCell.
 DbcsAttribute& CharRow::DbcsAttrAt(const size_t column)
 {
-    return _data.at(column).DbcsAttr();
+    THROW_HR_IF(E_INVALIDARG, column >= size());
+    _Materialize();
+    _measuredRight = UnknownRight;
+    return til::at(_dbcsAttrs, column);
 }
 
 // Routine Description:
@@ -175,7 +439,11 @@ DbcsAttribute& CharRow::DbcsAttrAt(const size_t column)
 // Note: will throw exception if column is out of bounds
 void CharRow::ClearGlyph(const size_t column)
 {
-    _data.at(column).EraseChars();
+    THROW_HR_IF(E_INVALIDARG, column >= size());
+    _Materialize();
+    til::at(_dbcsAttrs, column).SetGlyphStored(false);
+    til::at(_chars, column) = UNICODE_SPACE;
+    _CellsChanged(column, 1);
 }
 
 // Routine Description:
@@ -187,7 +455,7 @@ void CharRow::ClearGlyph(const size_t column)
 // - Note: will throw exception if column is out of bounds
 const CharRow::reference CharRow::GlyphAt(const size_t column) const
 {
-    THROW_HR_IF(E_INVALIDARG, column >= _data.size());
+    THROW_HR_IF(E_INVALIDARG, column >= size());
     return { const_cast<CharRow&>(*this), column };
 }
 
@@ -200,47 +468,110 @@ const CharRow::reference CharRow::GlyphAt(const size_t column) const
 // - Note: will throw exception if column is out of bounds
 CharRow::reference CharRow::GlyphAt(const size_t column)
 {
-    THROW_HR_IF(E_INVALIDARG, column >= _data.size());
+    THROW_HR_IF(E_INVALIDARG, column >= size());
+    _Materialize();
     return { *this, column };
 }
 
 std::wstring CharRow::GetText() const
 {
     std::wstring wstr;
-    wstr.reserve(_data.size());
+    wstr.reserve(size());
+    AppendText(wstr, 0, size());
+    return wstr;
+}
 
-    for (size_t i = 0; i < _data.size(); ++i)
+// Routine Description:
+// - Appends the text of the given range of columns to a string. Like in
+//   GetText, the trailing halves of wide glyphs are skipped, so a wide glyph
+//   is appended in full if its leading half is in the range.
+// - Runs of narrow glyphs that are stored right in the row are appended in
+//   one go. Only wide glyphs and the ones in the UnicodeStorage are looked
+//   at one by one.
+// Arguments:
+// - text - the string to append to
+// - left - the first column
+// - right - the column past the last one. It's clamped to the row's width.
+// Return Value:
+// - <none>
+void CharRow::AppendText(std::wstring& text, const size_t left, const size_t right) const
+{
+    const auto end = std::min(right, size());
+    if (_pendingReset)
     {
-        const auto glyph = GlyphAt(i);
-        if (!DbcsAttrAt(i).IsTrailing())
+        text.append(end > left ? end - left : 0, UNICODE_SPACE);
+        return;
+    }
+
+    auto column = left;
+    while (column < end)
+    {
+        auto runEnd = column;
+        while (runEnd < end && til::at(_dbcsAttrs, runEnd).IsSingle() && !til::at(_dbcsAttrs, runEnd).IsGlyphStored())
+        {
+            ++runEnd;
+        }
+        if (runEnd != column)
+        {
+            text.append(&til::at(_chars, column), runEnd - column);
+            column = runEnd;
+            continue;
+        }
+
+        const auto& dbcsAttr = til::at(_dbcsAttrs, column);
+        if (!dbcsAttr.IsTrailing())
         {
-            for (const auto wch : glyph)
+            if (dbcsAttr.IsGlyphStored())
             {
-                wstr.push_back(wch);
+                text.append(GlyphAt(column));
+            }
+            else
+            {
+                text.push_back(til::at(_chars, column));
             }
         }
+        ++column;
+    }
+}
+
+// Routine Description:
+// - Constructs a classifier for the given word delimiters
+// Arguments:
+// - wordDelimiters: the delimiters defined as a part of the DelimiterClass::DelimiterChar.
+//   The classifier refers to them, so they must outlive it.
+DelimiterClassifier::DelimiterClassifier(const std::wstring_view wordDelimiters) noexcept :
+    _wordDelimiters{ wordDelimiters }
+{
+    for (const auto ch : wordDelimiters)
+    {
+        if (ch < _asciiDelimiters.size())
+        {
+            til::at(_asciiDelimiters, ch) = true;
+        }
+        else
+        {
+            _hasNonAsciiDelimiters = true;
+        }
     }
-    return wstr;
 }
 
 // Method Description:
-// - get delimiter class for a position in the char row
-// - used for double click selection and uia word navigation
+// - get delimiter class for a glyph
 // Arguments:
-// - column: column to get text data for
-// - wordDelimiters: the delimiters defined as a part of the DelimiterClass::DelimiterChar
+// - glyph: the (first character of the) glyph to classify
 // Return Value:
 // - the delimiter class for the given char
-const DelimiterClass CharRow::DelimiterClassAt(const size_t column, const std::wstring_view wordDelimiters) const
+DelimiterClass DelimiterClassifier::Classify(const wchar_t glyph) const noexcept
 {
-    THROW_HR_IF(E_INVALIDARG, column >= _data.size());
-
-    const auto glyph = *GlyphAt(column).begin();
     if (glyph <= UNICODE_SPACE)
     {
         return DelimiterClass::ControlChar;
     }
-    else if (wordDelimiters.find(glyph) != std::wstring_view::npos)
+    else if (glyph < _asciiDelimiters.size())
+    {
+        return til::at(_asciiDelimiters, glyph) ? DelimiterClass::DelimiterChar : DelimiterClass::RegularChar;
+    }
+    else if (_hasNonAsciiDelimiters && _wordDelimiters.find(glyph) != std::wstring_view::npos)
     {
         return DelimiterClass::DelimiterChar;
     }
@@ -250,25 +581,36 @@ const DelimiterClass CharRow::DelimiterClassAt(const size_t column, const std::w
     }
 }
 
-UnicodeStorage& CharRow::GetUnicodeStorage() noexcept
+// Method Description:
+// - get delimiter class for a position in the char row
+// - used for double click selection and uia word navigation
+// Arguments:
+// - column: column to get text data for
+// - classifier: sorts the glyph into its delimiter class
+// Return Value:
+// - the delimiter class for the given char
+const DelimiterClass CharRow::DelimiterClassAt(const size_t column, const DelimiterClassifier& classifier) const
 {
-    return _pParent->GetUnicodeStorage();
+    THROW_HR_IF(E_INVALIDARG, column >= size());
+    if (_pendingReset)
+    {
+        return classifier.Classify(UNICODE_SPACE);
+    }
+
+    // Only the first character of the glyph matters. Unless the glyph
+    // needed the UnicodeStorage, that's right here in the row.
+    const auto glyph = til::at(_dbcsAttrs, column).IsGlyphStored() ? *GlyphAt(column).begin() : til::at(_chars, column);
+    return classifier.Classify(glyph);
 }
 
-const UnicodeStorage& CharRow::GetUnicodeStorage() const noexcept
+UnicodeStorage& CharRow::GetUnicodeStorage() noexcept
 {
     return _pParent->GetUnicodeStorage();
 }
 
-// Routine Description:
-// - calculates the key used by the given column of the char row to store glyph data in UnicodeStorage
-// Arguments:
-// - column - the column to generate the key for
-// Return Value:
-// - the COORD key for data access from UnicodeStorage for the column
-COORD CharRow::GetStorageKey(const size_t column) const noexcept
+const UnicodeStorage& CharRow::GetUnicodeStorage() const noexcept
 {
-    return { gsl::narrow<SHORT>(column), _pParent->GetId() };
+    return std::as_const(*_pParent).GetUnicodeStorage();
 }
 
 // Routine Description:
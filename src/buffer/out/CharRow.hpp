@@ -22,11 +22,34 @@ Revision History:
 
 #include "DbcsAttribute.hpp"
 #include "CharRowCellReference.hpp"
-#include "CharRowCell.hpp"
 #include "UnicodeStorage.hpp"
 
 class ROW;
 
+// The glyphs and DBCS attributes of all rows of a TextBuffer are stored in
+// two contiguous arrays, sliced into one span of `width` cells per row.
+// Compared to every row allocating its own cells this results in a single
+// allocation per buffer (instead of one per row and resize), and keeps
+// the glyphs of a row together for the hot loops that only look at the text.
+class CharRowStorage final
+{
+public:
+    CharRowStorage() = default;
+    CharRowStorage(const size_t width, const size_t height);
+
+    size_t width() const noexcept;
+    size_t height() const noexcept;
+
+    gsl::span<wchar_t> Chars(const size_t row) const;
+    gsl::span<DbcsAttribute> DbcsAttrs(const size_t row) const;
+
+private:
+    std::unique_ptr<wchar_t[]> _chars;
+    std::unique_ptr<DbcsAttribute[]> _dbcsAttrs;
+    size_t _width = 0;
+    size_t _height = 0;
+};
+
 enum class DelimiterClass
 {
     ControlChar,
@@ -34,6 +57,23 @@ enum class DelimiterClass
     RegularChar
 };
 
+// Sorts glyphs into DelimiterClasses for a given set of word delimiters.
+// Word navigation classifies cell after cell with the same delimiters,
+// so instead of searching the delimiter string for each cell we look the
+// ASCII ones (which is usually all of them) up in a table.
+class DelimiterClassifier final
+{
+public:
+    explicit DelimiterClassifier(const std::wstring_view wordDelimiters) noexcept;
+
+    DelimiterClass Classify(const wchar_t glyph) const noexcept;
+
+private:
+    std::wstring_view _wordDelimiters;
+    std::array<bool, 128> _asciiDelimiters{};
+    bool _hasNonAsciiDelimiters = false;
+};
+
 // the characters of one row of screen buffer
 // we keep the following values so that we don't write
 // more pixels to the screen than we have to:
@@ -48,16 +88,12 @@ class CharRow final
 {
 public:
     using glyph_type = typename wchar_t;
-    using value_type = typename CharRowCell;
-    using iterator = typename boost::container::small_vector_base<value_type>::iterator;
-    using const_iterator = typename boost::container::small_vector_base<value_type>::const_iterator;
-    using const_reverse_iterator = typename boost::container::small_vector_base<value_type>::const_reverse_iterator;
     using reference = typename CharRowCellReference;
 
-    CharRow(size_t rowWidth, ROW* const pParent) noexcept;
+    CharRow(const gsl::span<wchar_t> chars, const gsl::span<DbcsAttribute> dbcsAttrs, ROW* const pParent) noexcept;
 
     size_t size() const noexcept;
-    [[nodiscard]] HRESULT Resize(const size_t newSize) noexcept;
+    void Resize(const gsl::span<wchar_t> chars, const gsl::span<DbcsAttribute> dbcsAttrs) noexcept;
     size_t MeasureLeft() const noexcept;
     size_t MeasureRight() const;
     bool ContainsText() const noexcept;
@@ -65,24 +101,14 @@ public:
     DbcsAttribute& DbcsAttrAt(const size_t column);
     void ClearGlyph(const size_t column);
 
-    const DelimiterClass DelimiterClassAt(const size_t column, const std::wstring_view wordDelimiters) const;
+    const DelimiterClass DelimiterClassAt(const size_t column, const DelimiterClassifier& classifier) const;
 
     // working with glyphs
     const reference GlyphAt(const size_t column) const;
     reference GlyphAt(const size_t column);
 
-    // iterators
-    iterator begin() noexcept;
-    const_iterator cbegin() const noexcept;
-    const_iterator begin() const noexcept { return cbegin(); }
-
-    iterator end() noexcept;
-    const_iterator cend() const noexcept;
-    const_iterator end() const noexcept { return cend(); }
-
     UnicodeStorage& GetUnicodeStorage() noexcept;
     const UnicodeStorage& GetUnicodeStorage() const noexcept;
-    COORD GetStorageKey(const size_t column) const noexcept;
 
     void UpdateParent(ROW* const pParent);
 
@@ -92,24 +118,44 @@ public:
 private:
     void Reset() noexcept;
     void ClearCell(const size_t column);
+    void WriteCell(const size_t column, const DbcsAttribute dbcsAttr, const std::wstring_view chars);
+    void WriteNarrowGlyphs(const size_t column, const std::wstring_view chars);
+    void FillNarrowGlyphs(const size_t column, const size_t count, const wchar_t wch);
+    void CopyCells(const CharRow& source, const size_t sourceColumn, const size_t targetColumn, const size_t count);
     std::wstring GetText() const;
+    void AppendText(std::wstring& text, const size_t left, const size_t right) const;
+    bool _IsSpace(const size_t column) const noexcept;
+    void _CellsChanged(const size_t column, const size_t count) noexcept;
+    void _Materialize() noexcept;
+    void _MaterializeUnlessOverwritten(const size_t column, const size_t count) noexcept;
 
 protected:
-    // storage for glyph data and dbcs attributes
-    boost::container::small_vector<value_type, 120> _data;
+    // glyph data and dbcs attributes, both slices of the parent buffer's CharRowStorage
+    gsl::span<wchar_t> _chars;
+    gsl::span<DbcsAttribute> _dbcsAttrs;
 
     // ROW that this CharRow belongs to
     ROW* _pParent;
+
+    // The result of MeasureRight, kept up to date by the writes that go through
+    // this class (see _CellsChanged). UnknownRight when it needs to be measured
+    // again, for instance after handing out a mutable DbcsAttribute.
+    static constexpr size_t UnknownRight = SIZE_MAX;
+    mutable size_t _measuredRight = UnknownRight;
+
+    // Set by Reset. The cells are only filled with spaces once they're about
+    // to be modified (see _Materialize). Until then, reading them yields
+    // spaces without touching them, so that concurrent readers stay safe.
+    bool _pendingReset = false;
 };
 
 template<typename InputIt1, typename InputIt2>
-void OverwriteColumns(InputIt1 startChars, InputIt1 endChars, InputIt2 startAttrs, CharRow::iterator outIt)
+void OverwriteColumns(InputIt1 startChars, InputIt1 endChars, InputIt2 startAttrs, CharRow& charRow)
 {
-    std::transform(startChars,
-                   endChars,
-                   startAttrs,
-                   outIt,
-                   [](const wchar_t wch, const DbcsAttribute attr) {
-                       return CharRow::value_type{ wch, attr };
-                   });
+    size_t column = 0;
+    for (; startChars != endChars; ++startChars, ++startAttrs, ++column)
+    {
+        charRow.GlyphAt(column) = std::wstring_view{ &*startChars, 1 };
+        charRow.DbcsAttrAt(column) = *startAttrs;
+    }
 }
@@ -12,18 +12,20 @@
 void CharRowCellReference::operator=(const std::wstring_view chars)
 {
     THROW_HR_IF(E_INVALIDARG, chars.empty());
+    // The row might have been reset since this reference was handed out.
+    _parent._Materialize();
     if (chars.size() == 1)
     {
-        _cellData().Char() = chars.front();
-        _cellData().DbcsAttr().SetGlyphStored(false);
+        _charData() = chars.front();
+        _dbcsAttr().SetGlyphStored(false);
     }
     else
     {
         auto& storage = _parent.GetUnicodeStorage();
-        const auto key = _parent.GetStorageKey(_index);
-        storage.StoreGlyph(key, { chars.cbegin(), chars.cend() });
-        _cellData().DbcsAttr().SetGlyphStored(true);
+        storage.StoreGlyph(_index, chars);
+        _dbcsAttr().SetGlyphStored(true);
     }
+    _parent._CellsChanged(_index, 1);
 }
 
 // Routine Description:
@@ -36,21 +38,50 @@ CharRowCellReference::operator std::wstring_view() const
 }
 
 // Routine Description:
-// - The CharRowCell this object "references"
+// - The glyph cell this object "references". This does not access any char data through UnicodeStorage.
 // Return Value:
-// - ref to the CharRowCell
-CharRowCell& CharRowCellReference::_cellData()
+// - ref to the cell's wchar
+wchar_t& CharRowCellReference::_charData()
 {
-    return _parent._data.at(_index);
+    return til::at(_parent._chars, _index);
 }
 
 // Routine Description:
-// - The CharRowCell this object "references"
+// - The glyph cell this object "references". This does not access any char data through UnicodeStorage.
 // Return Value:
-// - ref to the CharRowCell
-const CharRowCell& CharRowCellReference::_cellData() const
+// - ref to the cell's wchar
+const wchar_t& CharRowCellReference::_charData() const
 {
-    return _parent._data.at(_index);
+    if (_parent._pendingReset)
+    {
+        // A row that was reset is all spaces, even if its cells don't know yet.
+        static const wchar_t space = UNICODE_SPACE;
+        return space;
+    }
+    return til::at(_parent._chars, _index);
+}
+
+// Routine Description:
+// - The DBCS attribute cell this object "references"
+// Return Value:
+// - ref to the cell's DbcsAttribute
+DbcsAttribute& CharRowCellReference::_dbcsAttr()
+{
+    return til::at(_parent._dbcsAttrs, _index);
+}
+
+// Routine Description:
+// - The DBCS attribute cell this object "references"
+// Return Value:
+// - ref to the cell's DbcsAttribute
+const DbcsAttribute& CharRowCellReference::_dbcsAttr() const
+{
+    if (_parent._pendingReset)
+    {
+        static const DbcsAttribute blank{};
+        return blank;
+    }
+    return til::at(_parent._dbcsAttrs, _index);
 }
 
 // Routine Description:
@@ -59,15 +90,13 @@ const CharRowCell& CharRowCellReference::_cellData() const
 // - the glyph data
 std::wstring_view CharRowCellReference::_glyphData() const
 {
-    if (_cellData().DbcsAttr().IsGlyphStored())
+    if (_dbcsAttr().IsGlyphStored())
     {
-        const auto& text = _parent.GetUnicodeStorage().GetText(_parent.GetStorageKey(_index));
-
-        return { text.data(), text.size() };
+        return std::as_const(_parent).GetUnicodeStorage().GetText(_index);
     }
     else
     {
-        return { &_cellData().Char(), 1 };
+        return { &_charData(), 1 };
     }
 }
 
@@ -77,13 +106,13 @@ std::wstring_view CharRowCellReference::_glyphData() const
 // - iterator of the glyph data
 CharRowCellReference::const_iterator CharRowCellReference::begin() const
 {
-    if (_cellData().DbcsAttr().IsGlyphStored())
+    if (_dbcsAttr().IsGlyphStored())
     {
-        return _parent.GetUnicodeStorage().GetText(_parent.GetStorageKey(_index)).data();
+        return std::as_const(_parent).GetUnicodeStorage().GetText(_index).data();
     }
     else
     {
-        return &_cellData().Char();
+        return &_charData();
     }
 }
 
@@ -96,21 +125,21 @@ CharRowCellReference::const_iterator CharRowCellReference::begin() const
 // TODO GH 2672: eliminate using pointers raw as begin/end markers in this class
 CharRowCellReference::const_iterator CharRowCellReference::end() const
 {
-    if (_cellData().DbcsAttr().IsGlyphStored())
+    if (_dbcsAttr().IsGlyphStored())
     {
-        const auto& chars = _parent.GetUnicodeStorage().GetText(_parent.GetStorageKey(_index));
+        const auto chars = std::as_const(_parent).GetUnicodeStorage().GetText(_index);
         return chars.data() + chars.size();
     }
     else
     {
-        return &_cellData().Char() + 1;
+        return &_charData() + 1;
     }
 }
 #pragma warning(pop)
 
 bool operator==(const CharRowCellReference& ref, const std::vector<wchar_t>& glyph)
 {
-    const DbcsAttribute& dbcsAttr = ref._cellData().DbcsAttr();
+    const DbcsAttribute& dbcsAttr = ref._dbcsAttr();
     if (glyph.size() == 1 && dbcsAttr.IsGlyphStored())
     {
         return false;
@@ -121,12 +150,12 @@ bool operator==(const CharRowCellReference& ref, const std::vector<wchar_t>& gly
     }
     else if (glyph.size() == 1 && !dbcsAttr.IsGlyphStored())
     {
-        return ref._cellData().Char() == glyph.front();
+        return ref._charData() == glyph.front();
     }
     else
     {
-        const auto& chars = ref._parent.GetUnicodeStorage().GetText(ref._parent.GetStorageKey(ref._index));
-        return chars == glyph;
+        const auto chars = std::as_const(ref._parent).GetUnicodeStorage().GetText(ref._index);
+        return chars == std::wstring_view{ glyph.data(), glyph.size() };
     }
 }
 
@@ -0,0 +1,170 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+
+#include "CommandTimeline.hpp"
+
+// Routine Description:
+// - Returns the number of rows the output of a finished command spans. A row
+//   the output ends at the beginning of (usually the next prompt's) isn't
+//   counted.
+// Return Value:
+// - the number of rows, or nothing if the command has no output or isn't
+//   finished yet.
+std::optional<ptrdiff_t> CommandTimeline::Command::OutputRowCount() const noexcept
+{
+    if (!outputStart || !outputEnd)
+    {
+        return std::nullopt;
+    }
+    return outputEnd->y() - outputStart->y() + (outputEnd->x() > 0 ? 1 : 0);
+}
+
+// Routine Description:
+// - Records an OSC 133 mark.
+// - A prompt starts a new command. If it's written above the most recent
+//   prompts (for instance after the screen was cleared), the commands at and
+//   below it were overwritten and are dropped.
+// - The other marks complete the most recent command. They're ignored if
+//   there's no command yet, or if they'd end up before its prompt.
+// Arguments:
+// - kind - the mark
+// - position - the absolute position of the cursor
+// - exitCode - the exit code of a CommandFinished mark, if the shell sent one
+// Return Value:
+// - <none>
+void CommandTimeline::AddMark(const MarkKind kind, const til::point position, const std::optional<unsigned int> exitCode)
+{
+    if (kind == MarkKind::PromptStart)
+    {
+        while (!_commands.empty() && _commands.back().promptStart.y() >= position.y())
+        {
+            _commands.pop_back();
+        }
+        auto& command = _commands.emplace_back();
+        command.promptStart = position;
+        return;
+    }
+
+    if (_commands.empty() || position < _commands.back().promptStart)
+    {
+        return;
+    }
+
+    auto& command = _commands.back();
+    switch (kind)
+    {
+    case MarkKind::CommandStart:
+        command.commandStart = position;
+        break;
+    case MarkKind::OutputStart:
+        command.outputStart = position;
+        break;
+    case MarkKind::CommandFinished:
+        // Some shells finish the previous command right before every prompt,
+        // even if nothing was run. Such a command has no output.
+        if (command.outputStart)
+        {
+            command.outputEnd = std::max(position, *command.outputStart);
+            command.exitCode = exitCode;
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+// Routine Description:
+// - Drops the commands whose prompt is above the given row, because the row
+//   it's on was evicted from the buffer.
+// Arguments:
+// - row - the absolute row of the first row the buffer still has
+// Return Value:
+// - <none>
+void CommandTimeline::EraseBefore(const ptrdiff_t row) noexcept
+{
+    while (!_commands.empty() && _commands.front().promptStart.y() < row)
+    {
+        _commands.pop_front();
+    }
+}
+
+void CommandTimeline::Clear() noexcept
+{
+    _commands.clear();
+}
+
+size_t CommandTimeline::Size() const noexcept
+{
+    return _commands.size();
+}
+
+// Routine Description:
+// - Returns the command the given row belongs to: the last one whose prompt
+//   starts at or above the row.
+std::optional<CommandTimeline::Command> CommandTimeline::GetCommandAt(const ptrdiff_t row) const
+{
+    const auto it = _UpperBound(row);
+    if (it == _commands.begin())
+    {
+        return std::nullopt;
+    }
+    return *(it - 1);
+}
+
+// Routine Description:
+// - Returns the last command whose prompt starts above the given row.
+std::optional<CommandTimeline::Command> CommandTimeline::GetPreviousCommand(const ptrdiff_t row) const
+{
+    return GetCommandAt(row - 1);
+}
+
+// Routine Description:
+// - Returns the first command whose prompt starts below the given row.
+std::optional<CommandTimeline::Command> CommandTimeline::GetNextCommand(const ptrdiff_t row) const
+{
+    const auto it = _UpperBound(row);
+    if (it == _commands.end())
+    {
+        return std::nullopt;
+    }
+    return *it;
+}
+
+// Routine Description:
+// - Returns a copy of the timeline with all positions passed through the given
+//   function. It must preserve their order, like reflowing a buffer does.
+// Arguments:
+// - map - translates a position in this timeline into the new one
+// Return Value:
+// - the new timeline
+CommandTimeline CommandTimeline::Remap(const std::function<til::point(til::point)>& map) const
+{
+    const auto mapOptional = [&](const std::optional<til::point>& position) -> std::optional<til::point> {
+        if (position)
+        {
+            return map(*position);
+        }
+        return std::nullopt;
+    };
+
+    CommandTimeline remapped;
+    for (const auto& command : _commands)
+    {
+        auto& copy = remapped._commands.emplace_back(command);
+        copy.promptStart = map(command.promptStart);
+        copy.commandStart = mapOptional(command.commandStart);
+        copy.outputStart = mapOptional(command.outputStart);
+        copy.outputEnd = mapOptional(command.outputEnd);
+    }
+    return remapped;
+}
+
+// Returns the first command whose prompt starts below the given row.
+std::deque<CommandTimeline::Command>::const_iterator CommandTimeline::_UpperBound(const ptrdiff_t row) const noexcept
+{
+    return std::upper_bound(_commands.begin(), _commands.end(), row, [](const ptrdiff_t row, const Command& command) noexcept {
+        return row < command.promptStart.y();
+    });
+}
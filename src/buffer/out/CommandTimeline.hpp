@@ -0,0 +1,60 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- CommandTimeline.hpp
+
+Abstract:
+- The commands that a shell marked in a TextBuffer with FinalTerm's shell
+  integration sequences (OSC 133). Each command consists of its prompt, the
+  command line typed after it, and the output of running it.
+- The commands are kept sorted by the row of their prompt, so that the command
+  at, before or after any row is found with a binary search. This makes
+  jumping between prompts independent of the amount of output in between.
+- Positions are absolute: row 0 is the first row the buffer ever had, so they
+  don't change when the buffer circles. The TextBuffer translates them to and
+  from its own rows and drops the commands whose prompt was evicted.
+--*/
+
+#pragma once
+
+class CommandTimeline final
+{
+public:
+    // The marks of OSC 133, in the order a shell emits them for each command.
+    enum class MarkKind
+    {
+        PromptStart, // A
+        CommandStart, // B, the end of the prompt
+        OutputStart, // C, the command was submitted
+        CommandFinished // D, with an optional exit code
+    };
+
+    struct Command
+    {
+        til::point promptStart;
+        std::optional<til::point> commandStart;
+        std::optional<til::point> outputStart;
+        std::optional<til::point> outputEnd;
+        std::optional<unsigned int> exitCode;
+
+        std::optional<ptrdiff_t> OutputRowCount() const noexcept;
+    };
+
+    void AddMark(const MarkKind kind, const til::point position, const std::optional<unsigned int> exitCode = std::nullopt);
+    void EraseBefore(const ptrdiff_t row) noexcept;
+    void Clear() noexcept;
+
+    size_t Size() const noexcept;
+    std::optional<Command> GetCommandAt(const ptrdiff_t row) const;
+    std::optional<Command> GetPreviousCommand(const ptrdiff_t row) const;
+    std::optional<Command> GetNextCommand(const ptrdiff_t row) const;
+
+    CommandTimeline Remap(const std::function<til::point(til::point)>& map) const;
+
+private:
+    std::deque<Command>::const_iterator _UpperBound(const ptrdiff_t row) const noexcept;
+
+    std::deque<Command> _commands;
+};
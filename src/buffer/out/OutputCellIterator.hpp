@@ -33,6 +33,9 @@ public:
     using pointer = OutputCellView*;
     using reference = OutputCellView&;
 
+    // The attribute may differ from cell to cell (or be left alone). See TextCellIterator.
+    static constexpr bool UniformAttribute = false;
+
     OutputCellIterator(const wchar_t& wch, const size_t fillLimit = 0) noexcept;
     OutputCellIterator(const TextAttribute& attr, const size_t fillLimit = 0) noexcept;
     OutputCellIterator(const wchar_t& wch, const TextAttribute& attr, const size_t fillLimit = 0) noexcept;
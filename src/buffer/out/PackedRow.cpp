@@ -0,0 +1,247 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+
+#include "PackedRow.hpp"
+#include "BufferSnapshot.hpp"
+
+// Routine Description:
+// - Encodes the contents of the given row.
+// Arguments:
+// - row - the row to pack
+// Return Value:
+// - the packed row
+PackedRow PackedRow::Pack(const ROW& row)
+{
+    PackedRow packed;
+    packed._lineRendition = row.GetLineRendition();
+    packed._wrapForced = row.WasWrapForced();
+    packed._doubleBytePadded = row.WasDoubleBytePadded();
+
+    const auto& charRow = row.GetCharRow();
+    std::wstring text;
+    text.reserve(charRow.size());
+
+    std::vector<til::rle_pair<uint8_t, uint16_t>> cells;
+
+    for (size_t column = 0; column < charRow.size(); ++column)
+    {
+        const auto& dbcsAttr = charRow.DbcsAttrAt(column);
+        uint8_t flags = dbcsAttr.IsLeading() ? Leading : dbcsAttr.IsTrailing() ? Trailing : Single;
+
+        if (!dbcsAttr.IsTrailing())
+        {
+            const std::wstring_view glyph = charRow.GlyphAt(column);
+            if (dbcsAttr.IsGlyphStored())
+            {
+                flags |= GlyphStored;
+                packed._storedGlyphLengths.emplace_back(gsl::narrow<uint8_t>(glyph.size()));
+            }
+            text.append(glyph);
+        }
+
+        if (!cells.empty() && cells.back().value == flags)
+        {
+            ++cells.back().length;
+        }
+        else
+        {
+            cells.emplace_back(flags, gsl::narrow_cast<uint16_t>(1));
+        }
+    }
+
+    THROW_IF_FAILED(til::u16u8(text, packed._text));
+    packed._text.shrink_to_fit();
+    packed._storedGlyphLengths.shrink_to_fit();
+
+    cells.shrink_to_fit();
+    packed._cells = til::rle<uint8_t, uint16_t>{ std::move(cells) };
+
+    const auto& attrRow = row.GetAttrRow();
+    for (auto it = attrRow.cbegin(); it != attrRow.cend();)
+    {
+        const auto attr = *it;
+        auto length = gsl::narrow_cast<uint16_t>(0);
+        for (; it != attrRow.cend() && *it == attr; ++it)
+        {
+            ++length;
+        }
+        packed._attrs.emplace_back(attr, length);
+    }
+    packed._attrs.shrink_to_fit();
+
+    return packed;
+}
+
+// Routine Description:
+// - Restores the packed contents into the given row.
+// Arguments:
+// - row - the row to overwrite. Must be exactly Width() cells wide.
+// Return Value:
+// - <none>
+void PackedRow::Unpack(ROW& row) const
+{
+    THROW_HR_IF(E_INVALIDARG, row.size() != Width());
+
+    std::wstring text;
+    THROW_IF_FAILED(til::u8u16(_text, text));
+
+    row.SetLineRendition(_lineRendition);
+    row.SetWrapForced(_wrapForced);
+    row.SetDoubleBytePadded(_doubleBytePadded);
+
+    auto& charRow = row.GetCharRow();
+    size_t column = 0;
+    size_t textOffset = 0;
+    auto storedGlyphLength = _storedGlyphLengths.cbegin();
+
+    for (const auto& run : _cells.runs())
+    {
+        const auto flags = run.value;
+        DbcsAttribute dbcsAttr;
+        if (flags & Leading)
+        {
+            dbcsAttr.SetLeading();
+        }
+        else if (flags & Trailing)
+        {
+            dbcsAttr.SetTrailing();
+        }
+
+        for (uint16_t i = 0; i < run.length; ++i, ++column)
+        {
+            charRow.DbcsAttrAt(column) = dbcsAttr;
+
+            if (flags & Trailing)
+            {
+                // Trailing cells repeat the glyph of their leading cell.
+                charRow.GlyphAt(column) = static_cast<std::wstring_view>(charRow.GlyphAt(column - 1));
+                continue;
+            }
+
+            size_t length = 1;
+            if (flags & GlyphStored)
+            {
+                THROW_HR_IF(E_UNEXPECTED, storedGlyphLength == _storedGlyphLengths.cend());
+                length = *storedGlyphLength++;
+            }
+
+            THROW_HR_IF(E_UNEXPECTED, textOffset + length > text.size());
+            charRow.GlyphAt(column) = std::wstring_view{ text }.substr(textOffset, length);
+            textOffset += length;
+        }
+    }
+
+    auto& attrRow = row.GetAttrRow();
+    uint16_t attrStart = 0;
+    for (const auto& run : _attrs)
+    {
+        const auto attrEnd = gsl::narrow_cast<uint16_t>(attrStart + run.length);
+        attrRow.Replace(attrStart, attrEnd, run.value);
+        attrStart = attrEnd;
+    }
+}
+
+// Routine Description:
+// - Appends the packed row to a snapshot. The attributes are stored as
+//   they're laid out in memory, which BufferSnapshot's header accounts for.
+// Arguments:
+// - encoder - the snapshot to append to
+// Return Value:
+// - <none>
+void PackedRow::Serialize(SnapshotEncoder& encoder) const
+{
+    static_assert(std::is_trivially_copyable_v<TextAttribute>);
+
+    encoder.Write(static_cast<uint8_t>(_lineRendition));
+    encoder.Write(static_cast<uint8_t>((_wrapForced ? 1 : 0) | (_doubleBytePadded ? 2 : 0)));
+    encoder.WriteString(_text);
+    encoder.WriteString({ reinterpret_cast<const char*>(_storedGlyphLengths.data()), _storedGlyphLengths.size() });
+
+    const auto& cells = _cells.runs();
+    encoder.Write(gsl::narrow<uint32_t>(cells.size()));
+    for (const auto& run : cells)
+    {
+        encoder.Write(run.value);
+        encoder.Write(run.length);
+    }
+
+    encoder.Write(gsl::narrow<uint32_t>(_attrs.size()));
+    for (const auto& run : _attrs)
+    {
+        encoder.Write(run.value);
+        encoder.Write(run.length);
+    }
+}
+
+// Routine Description:
+// - Reads a packed row that was written by Serialize().
+// Arguments:
+// - decoder - the snapshot to read from
+// Return Value:
+// - the packed row
+PackedRow PackedRow::Deserialize(SnapshotDecoder& decoder)
+{
+    PackedRow packed;
+
+    const auto lineRendition = decoder.Read<uint8_t>();
+    THROW_HR_IF(E_UNEXPECTED, lineRendition > static_cast<uint8_t>(LineRendition::DoubleHeightBottom));
+    packed._lineRendition = static_cast<LineRendition>(lineRendition);
+
+    const auto flags = decoder.Read<uint8_t>();
+    packed._wrapForced = WI_IsFlagSet(flags, 1);
+    packed._doubleBytePadded = WI_IsFlagSet(flags, 2);
+
+    packed._text = decoder.ReadString();
+    const auto storedGlyphLengths = decoder.ReadString();
+    packed._storedGlyphLengths.assign(storedGlyphLengths.begin(), storedGlyphLengths.end());
+
+    std::vector<til::rle_pair<uint8_t, uint16_t>> cells;
+    cells.resize(decoder.ReadCount(sizeof(uint8_t) + sizeof(uint16_t)));
+    for (auto& run : cells)
+    {
+        run.value = decoder.Read<uint8_t>();
+        run.length = decoder.Read<uint16_t>();
+    }
+    packed._cells = til::rle<uint8_t, uint16_t>{ std::move(cells) };
+
+    size_t attrsWidth = 0;
+    packed._attrs.resize(decoder.ReadCount(sizeof(TextAttribute) + sizeof(uint16_t)));
+    for (auto& run : packed._attrs)
+    {
+        run.value = decoder.Read<TextAttribute>();
+        run.length = decoder.Read<uint16_t>();
+        attrsWidth += run.length;
+    }
+
+    // Unpack() trusts the attributes to cover exactly the row's cells.
+    THROW_HR_IF(E_UNEXPECTED, attrsWidth != packed.Width());
+
+    return packed;
+}
+
+// Routine Description:
+// - Returns the width of the packed row in cells.
+size_t PackedRow::Width() const noexcept
+{
+    return _cells.size();
+}
+
+// Routine Description:
+// - Returns the text of the packed row, like ROW::GetText().
+std::wstring PackedRow::GetText() const
+{
+    return til::u8u16(_text);
+}
+
+// Routine Description:
+// - Returns the approximate amount of memory used by this packed row.
+size_t PackedRow::ByteSize() const noexcept
+{
+    return sizeof(*this) +
+           _text.capacity() +
+           _storedGlyphLengths.capacity() +
+           _cells.runs().capacity() * sizeof(til::rle_pair<uint8_t, uint16_t>) +
+           _attrs.capacity() * sizeof(til::rle_pair<TextAttribute, uint16_t>);
+}
@@ -0,0 +1,57 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- PackedRow.hpp
+
+Abstract:
+- A compact, read-only encoding of a ROW for rows that have scrolled far out of view.
+- The text is stored as UTF-8 and the attributes as their run length encoding,
+  which usually makes a packed row a small fraction of the size of an expanded one.
+  Cells are restored exactly (including wide glyphs and surrogate pairs) by Unpack().
+--*/
+
+#pragma once
+
+#include "Row.hpp"
+
+class SnapshotEncoder;
+class SnapshotDecoder;
+
+class PackedRow final
+{
+public:
+    PackedRow() = default;
+
+    static PackedRow Pack(const ROW& row);
+    void Unpack(ROW& row) const;
+
+    // The encoding used by BufferSnapshot.
+    void Serialize(SnapshotEncoder& encoder) const;
+    static PackedRow Deserialize(SnapshotDecoder& decoder);
+
+    size_t Width() const noexcept;
+    size_t ByteSize() const noexcept;
+    std::wstring GetText() const;
+
+private:
+    // Per cell flags, run length encoded. Most rows consist of a single run.
+    enum CellFlags : uint8_t
+    {
+        Single = 0x00,
+        Leading = 0x01,
+        Trailing = 0x02,
+        GlyphStored = 0x04,
+    };
+
+    // The glyphs of all non-trailing cells, concatenated.
+    std::string _text;
+    // The length (in UTF-16 code units) of every cell flagged as GlyphStored, in order.
+    std::vector<uint8_t> _storedGlyphLengths;
+    til::rle<uint8_t, uint16_t> _cells;
+    std::vector<til::rle_pair<TextAttribute, uint16_t>> _attrs;
+    LineRendition _lineRendition = LineRendition::SingleWidth;
+    bool _wrapForced = false;
+    bool _doubleBytePadded = false;
+};
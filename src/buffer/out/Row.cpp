@@ -11,23 +11,39 @@
 // - constructor
 // Arguments:
 // - rowId - the row index in the text buffer
-// - rowWidth - the width of the row, cell elements
+// - chars - the glyph cells of the row, owned by the text buffer
+// - dbcsAttrs - the DBCS attribute cells of the row, owned by the text buffer
 // - fillAttribute - the default text attribute
+// - attrResource - the memory resource to allocate the attribute runs from
 // - pParent - the text buffer that this row belongs to
 // Return Value:
 // - constructed object
-ROW::ROW(const SHORT rowId, const unsigned short rowWidth, const TextAttribute fillAttribute, TextBuffer* const pParent) :
+ROW::ROW(const SHORT rowId, const gsl::span<wchar_t> chars, const gsl::span<DbcsAttribute> dbcsAttrs, const TextAttribute fillAttribute, std::pmr::memory_resource* const attrResource, TextBuffer* const pParent) :
     _id{ rowId },
-    _rowWidth{ rowWidth },
-    _charRow{ rowWidth, this },
-    _attrRow{ rowWidth, fillAttribute },
+    _rowWidth{ gsl::narrow<unsigned short>(chars.size()) },
+    _charRow{ chars, dbcsAttrs, this },
+    _attrRow{ gsl::narrow<uint16_t>(chars.size()), fillAttribute, attrResource },
     _lineRendition{ LineRendition::SingleWidth },
     _wrapForced{ false },
     _doubleBytePadded{ false },
+    _generation{ s_NextGeneration() },
     _pParent{ pParent }
 {
 }
 
+// Routine Description:
+// - Hands out a new row generation. These are never reused, across all
+//   rows of all text buffers, so that 0 can stand for "no generation".
+// Arguments:
+// - <none>
+// Return Value:
+// - a generation no row has had before
+uint64_t ROW::s_NextGeneration() noexcept
+{
+    static std::atomic<uint64_t> lastGeneration{ 0 };
+    return lastGeneration.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
 // Routine Description:
 // - Sets all properties of the ROW to default values
 // Arguments:
@@ -36,10 +52,12 @@ ROW::ROW(const SHORT rowId, const unsigned short rowWidth, const TextAttribute f
 // - <none>
 bool ROW::Reset(const TextAttribute Attr)
 {
+    _BumpGeneration();
     _lineRendition = LineRendition::SingleWidth;
     _wrapForced = false;
     _doubleBytePadded = false;
     _charRow.Reset();
+    _unicodeStorage.Reset();
     try
     {
         _attrRow.Reset(Attr);
@@ -54,21 +72,27 @@ bool ROW::Reset(const TextAttribute Attr)
 
 // Routine Description:
 // - resizes ROW to new width
+// - The text is always moved into the new cells, even if resizing the
+//   attributes fails, so that the ROW never refers to the old cells afterwards.
 // Arguments:
-// - width - the new width, in cells
+// - chars - the new glyph cells of the row, owned by the text buffer
+// - dbcsAttrs - the new DBCS attribute cells of the row, owned by the text buffer
 // Return Value:
 // - S_OK if successful, otherwise relevant error
-[[nodiscard]] HRESULT ROW::Resize(const unsigned short width)
+[[nodiscard]] HRESULT ROW::Resize(const gsl::span<wchar_t> chars, const gsl::span<DbcsAttribute> dbcsAttrs) noexcept
 {
-    RETURN_IF_FAILED(_charRow.Resize(width));
+    _BumpGeneration();
+    _charRow.Resize(chars, dbcsAttrs);
+    _unicodeStorage.Trim(chars.size());
+
     try
     {
+        const auto width = gsl::narrow<unsigned short>(chars.size());
         _attrRow.Resize(width);
+        _rowWidth = width;
     }
     CATCH_RETURN();
 
-    _rowWidth = width;
-
     return S_OK;
 }
 
@@ -81,17 +105,280 @@ bool ROW::Reset(const TextAttribute Attr)
 void ROW::ClearColumn(const size_t column)
 {
     THROW_HR_IF(E_INVALIDARG, column >= _charRow.size());
+    _BumpGeneration();
     _charRow.ClearCell(column);
 }
 
+// Routine Description:
+// - writes text consisting only of narrow glyphs of one code unit each into
+//   the row, as a faster alternative to WriteCells for such text.
+// Arguments:
+// - text - the text to write. The caller must ensure that it is all narrow.
+// - index - column in row to start writing at
+// - attr - the attribute to apply to all written cells
+// - wrap - change the wrap flag if we hit the end of the row while writing
+// Return Value:
+// - the number of characters that were written. This is less than the size
+//   of text if the text didn't fit into the rest of the row.
+size_t ROW::WriteNarrowText(const std::wstring_view text, const size_t index, const TextAttribute& attr, const std::optional<bool> wrap)
+{
+    THROW_HR_IF(E_INVALIDARG, index >= _charRow.size());
+
+    const auto count = std::min(text.size(), _charRow.size() - index);
+    if (count == 0)
+    {
+        return 0;
+    }
+
+    _BumpGeneration();
+    _charRow.WriteNarrowGlyphs(index, text.substr(0, count));
+    _attrRow.Replace(gsl::narrow_cast<uint16_t>(index), gsl::narrow_cast<uint16_t>(index + count), attr);
+
+    if (wrap.has_value() && index + count == _charRow.size())
+    {
+        SetWrapForced(*wrap);
+    }
+
+    return count;
+}
+
+// Routine Description:
+// - fills part of the row with a single narrow glyph of one code unit, leaving
+//   the attributes of the cells alone. This is what FillConsoleOutputCharacter
+//   does, without going through WriteCells cell by cell.
+// Arguments:
+// - wch - the glyph to fill with. The caller must ensure that it is narrow.
+// - index - column in row to start filling at
+// - count - the number of cells to fill
+// - wrap - change the wrap flag if we hit the end of the row while filling
+// Return Value:
+// - the number of cells that were filled. This is less than count if the
+//   rest of the row is shorter than that.
+size_t ROW::FillNarrowText(const wchar_t wch, const size_t index, const size_t count, const std::optional<bool> wrap)
+{
+    THROW_HR_IF(E_INVALIDARG, index >= _charRow.size());
+
+    const auto filled = std::min(count, _charRow.size() - index);
+    if (filled == 0)
+    {
+        return 0;
+    }
+
+    _BumpGeneration();
+    _charRow.FillNarrowGlyphs(index, filled, wch);
+
+    if (wrap.has_value() && index + filled == _charRow.size())
+    {
+        SetWrapForced(*wrap);
+    }
+
+    return filled;
+}
+
+// Routine Description:
+// - sets the attribute of part of the row, leaving its text alone. This is
+//   what FillConsoleOutputAttribute does, with a single run replacement
+//   instead of going through WriteCells cell by cell.
+// Arguments:
+// - attr - the attribute to apply
+// - index - column in row to start filling at
+// - count - the number of cells to fill
+// Return Value:
+// - the number of cells that were filled. This is less than count if the
+//   rest of the row is shorter than that.
+size_t ROW::FillAttributes(const TextAttribute& attr, const size_t index, const size_t count)
+{
+    THROW_HR_IF(E_INVALIDARG, index >= _charRow.size());
+
+    const auto filled = std::min(count, _charRow.size() - index);
+    if (filled == 0)
+    {
+        return 0;
+    }
+
+    _BumpGeneration();
+    _attrRow.Replace(gsl::narrow_cast<uint16_t>(index), gsl::narrow_cast<uint16_t>(index + filled), attr);
+
+    return filled;
+}
+
+// Routine Description:
+// - copies a span of cells from the given row (which may be this one) into
+//   this one, text and attributes alike, as a faster alternative to reading
+//   and writing them one by one. This is how rectangular scrolls move the
+//   parts of rows that aren't the full width of the buffer.
+// - Spans that WriteCells would have to pad (a trailing half at the start of
+//   the row or a leading half at its end) or that contain glyphs kept in the
+//   UnicodeStorage aren't copied. The caller needs to copy those cell by cell.
+// Arguments:
+// - source - the row to copy from
+// - sourceColumn - the column of the first cell to copy
+// - targetColumn - the column in this row to copy the first cell to
+// - count - the number of cells to copy
+// Return Value:
+// - true if the cells were copied, false if the caller must copy them instead.
+bool ROW::CopyCells(const ROW& source, const size_t sourceColumn, const size_t targetColumn, const size_t count)
+{
+    THROW_HR_IF(E_INVALIDARG, sourceColumn >= source.size() || count > source.size() - sourceColumn);
+    THROW_HR_IF(E_INVALIDARG, targetColumn >= size() || count > size() - targetColumn);
+
+    if (count == 0)
+    {
+        return true;
+    }
+
+    const auto& sourceChars = source._charRow;
+    if ((targetColumn == 0 && sourceChars.DbcsAttrAt(sourceColumn).IsTrailing()) ||
+        (targetColumn + count == size() && sourceChars.DbcsAttrAt(sourceColumn + count - 1).IsLeading()))
+    {
+        return false;
+    }
+    for (size_t i = sourceColumn; i < sourceColumn + count; ++i)
+    {
+        if (sourceChars.DbcsAttrAt(i).IsGlyphStored())
+        {
+            return false;
+        }
+    }
+
+    _BumpGeneration();
+    _charRow.CopyCells(sourceChars, sourceColumn, targetColumn, count);
+    _attrRow.CopyAttrs(source._attrRow, gsl::narrow_cast<uint16_t>(sourceColumn), gsl::narrow_cast<uint16_t>(sourceColumn + count), gsl::narrow_cast<uint16_t>(targetColumn));
+
+    // Writing the cells one by one marks the row as wrapped when reaching its end.
+    if (targetColumn + count == size())
+    {
+        SetWrapForced(true);
+    }
+
+    return true;
+}
+
+// Routine Description:
+// - writes legacy CHAR_INFO cells into the row, as a faster alternative to
+//   WriteCells for WriteConsoleOutput. Attributes are converted once per run
+//   of equal legacy attributes instead of once per cell.
+// - Leading and trailing bytes that don't fit are padded the same way WriteCells does.
+// Arguments:
+// - charInfos - the cells to write
+// - index - column in row to start writing at
+// - cellsWritten - receives the number of cells that were written, including padding
+// Return Value:
+// - the number of CHAR_INFOs that were written.
+size_t ROW::WriteCharInfos(const gsl::span<const CHAR_INFO> charInfos, const size_t index, size_t& cellsWritten)
+{
+    THROW_HR_IF(E_INVALIDARG, index >= _charRow.size());
+
+    _BumpGeneration();
+
+    const auto finalColumnInRow = _charRow.size() - 1;
+    auto it = charInfos.begin();
+    auto column = index;
+    auto colorStarts = index;
+    WORD currentColor = 0;
+
+    while (it != charInfos.end() && column <= finalColumnInRow)
+    {
+        const auto color = gsl::narrow_cast<WORD>(it->Attributes & ~COMMON_LVB_SBCSDBCS);
+        if (column == colorStarts)
+        {
+            currentColor = color;
+        }
+        else if (color != currentColor)
+        {
+            _attrRow.Replace(gsl::narrow_cast<uint16_t>(colorStarts), gsl::narrow_cast<uint16_t>(column), TextAttribute{ currentColor });
+            currentColor = color;
+            colorStarts = column;
+        }
+
+        DbcsAttribute dbcsAttr;
+        if (WI_IsFlagSet(it->Attributes, COMMON_LVB_LEADING_BYTE))
+        {
+            dbcsAttr.SetLeading();
+        }
+        else if (WI_IsFlagSet(it->Attributes, COMMON_LVB_TRAILING_BYTE))
+        {
+            dbcsAttr.SetTrailing();
+        }
+
+        if (column == 0 && dbcsAttr.IsTrailing())
+        {
+            _charRow.ClearCell(column);
+        }
+        else if (column == finalColumnInRow && dbcsAttr.IsLeading())
+        {
+            _charRow.ClearCell(column);
+            SetDoubleBytePadded(true);
+        }
+        else
+        {
+            _charRow.WriteCell(column, dbcsAttr, std::wstring_view{ &it->Char.UnicodeChar, 1 });
+            ++it;
+        }
+
+        ++column;
+    }
+
+    if (column > colorStarts)
+    {
+        _attrRow.Replace(gsl::narrow_cast<uint16_t>(colorStarts), gsl::narrow_cast<uint16_t>(column), TextAttribute{ currentColor });
+    }
+
+    cellsWritten = column - index;
+    return gsl::narrow_cast<size_t>(it - charInfos.begin());
+}
+
+// Routine Description:
+// - reads cells of the row as legacy CHAR_INFOs, as a faster alternative to
+//   walking them with a TextBufferCellIterator for ReadConsoleOutput. The legacy
+//   attribute is computed once per attribute run instead of once per cell.
+// Arguments:
+// - index - column in row to start reading at
+// - charInfos - receives the cells. Reading stops at the end of the row.
+// Return Value:
+// - the number of cells that were read.
+size_t ROW::ReadCharInfos(const size_t index, const gsl::span<CHAR_INFO> charInfos) const
+{
+    THROW_HR_IF(E_INVALIDARG, index >= _charRow.size());
+
+    const auto endIndex = index + std::min(charInfos.size(), _charRow.size() - index);
+    auto out = charInfos.begin();
+    size_t runStart = 0;
+
+    for (const auto& run : _attrRow._data.runs())
+    {
+        const size_t runEnd = runStart + run.length;
+        const auto begin = std::max(runStart, index);
+        const auto end = std::min(runEnd, endIndex);
+        if (begin < end)
+        {
+            const auto legacyAttr = run.value.GetLegacyAttributes();
+            for (auto column = begin; column < end; ++column, ++out)
+            {
+                out->Char.UnicodeChar = Utf16ToUcs2(_charRow.GlyphAt(column));
+                out->Attributes = legacyAttr | _charRow.DbcsAttrAt(column).GeneratePublicApiAttributeFormat();
+            }
+        }
+
+        runStart = runEnd;
+        if (runStart >= endIndex)
+        {
+            break;
+        }
+    }
+
+    return endIndex - index;
+}
+
 UnicodeStorage& ROW::GetUnicodeStorage() noexcept
 {
-    return _pParent->GetUnicodeStorage();
+    _BumpGeneration();
+    return _unicodeStorage;
 }
 
 const UnicodeStorage& ROW::GetUnicodeStorage() const noexcept
 {
-    return _pParent->GetUnicodeStorage();
+    return _unicodeStorage;
 }
 
 // Routine Description:
@@ -104,6 +391,41 @@ const UnicodeStorage& ROW::GetUnicodeStorage() const noexcept
 // Return Value:
 // - iterator to first cell that was not written to this row.
 OutputCellIterator ROW::WriteCells(OutputCellIterator it, const size_t index, const std::optional<bool> wrap, std::optional<size_t> limitRight)
+{
+    return _WriteCells(it, index, wrap, limitRight);
+}
+
+// Routine Description:
+// - writes text with a single attribute to the row. Like WriteCells with an
+//   OutputCellIterator over the same text, but compiled for this case alone.
+// Arguments:
+// - it - iterator over the text to write
+// - index - column in row to start writing at
+// - wrap - change the wrap flag if we hit the end of the row while writing and there's still more data in the iterator.
+// - limitRight - right inclusive column ID for the last write in this row. (optional, will just write to the end of row if nullopt)
+// Return Value:
+// - iterator to first cell that was not written to this row.
+TextCellIterator ROW::WriteText(TextCellIterator it, const size_t index, const std::optional<bool> wrap, std::optional<size_t> limitRight)
+{
+    return _WriteCells(it, index, wrap, limitRight);
+}
+
+// A uniform attribute is always stored along with the text.
+template<typename TIterator>
+static bool s_WritesText(const TIterator& it) noexcept
+{
+    if constexpr (TIterator::UniformAttribute)
+    {
+        return true;
+    }
+    else
+    {
+        return it->TextAttrBehavior() != TextAttributeBehavior::StoredOnly;
+    }
+}
+
+template<typename TIterator>
+TIterator ROW::_WriteCells(TIterator it, const size_t index, const std::optional<bool> wrap, std::optional<size_t> limitRight)
 {
     THROW_HR_IF(E_INVALIDARG, index >= _charRow.size());
     THROW_HR_IF(E_INVALIDARG, limitRight.value_or(0) >= _charRow.size());
@@ -111,35 +433,41 @@ OutputCellIterator ROW::WriteCells(OutputCellIterator it, const size_t index, co
     // If we're given a right-side column limit, use it. Otherwise, the write limit is the final column index available in the char row.
     const auto finalColumnInRow = limitRight.value_or(_charRow.size() - 1);
 
-    auto currentColor = it->TextAttr();
-    uint16_t colorUses = 0;
+    _BumpGeneration();
+
+    [[maybe_unused]] auto currentColor = it->TextAttr();
+    [[maybe_unused]] uint16_t colorUses = 0;
     uint16_t colorStarts = gsl::narrow_cast<uint16_t>(index);
     uint16_t currentIndex = colorStarts;
 
     while (it && currentIndex <= finalColumnInRow)
     {
         // Fill the color if the behavior isn't set to keeping the current color.
-        if (it->TextAttrBehavior() != TextAttributeBehavior::Current)
+        // A uniform attribute is applied to the whole run once we're done instead.
+        if constexpr (!TIterator::UniformAttribute)
         {
-            // If the color of this cell is the same as the run we're currently on,
-            // just increment the counter.
-            if (currentColor == it->TextAttr())
-            {
-                ++colorUses;
-            }
-            else
+            if (it->TextAttrBehavior() != TextAttributeBehavior::Current)
             {
-                // Otherwise, commit this color into the run and save off the new one.
-                // Now commit the new color runs into the attr row.
-                _attrRow.Replace(colorStarts, currentIndex, currentColor);
-                currentColor = it->TextAttr();
-                colorUses = 1;
-                colorStarts = currentIndex;
+                // If the color of this cell is the same as the run we're currently on,
+                // just increment the counter.
+                if (currentColor == it->TextAttr())
+                {
+                    ++colorUses;
+                }
+                else
+                {
+                    // Otherwise, commit this color into the run and save off the new one.
+                    // Now commit the new color runs into the attr row.
+                    _attrRow.Replace(colorStarts, currentIndex, currentColor);
+                    currentColor = it->TextAttr();
+                    colorUses = 1;
+                    colorStarts = currentIndex;
+                }
             }
         }
 
         // Fill the text if the behavior isn't set to saying there's only a color stored in this iterator.
-        if (it->TextAttrBehavior() != TextAttributeBehavior::StoredOnly)
+        if (s_WritesText(it))
         {
             const bool fillingLastColumn = currentIndex == finalColumnInRow;
 
@@ -163,8 +491,7 @@ OutputCellIterator ROW::WriteCells(OutputCellIterator it, const size_t index, co
             // Otherwise, copy the data given and increment the iterator.
             else
             {
-                _charRow.DbcsAttrAt(currentIndex) = it->DbcsAttr();
-                _charRow.GlyphAt(currentIndex) = it->Chars();
+                _charRow.WriteCell(currentIndex, it->DbcsAttr(), it->Chars());
                 ++it;
             }
 
@@ -189,7 +516,14 @@ OutputCellIterator ROW::WriteCells(OutputCellIterator it, const size_t index, co
     }
 
     // Now commit the final color into the attr row
-    if (colorUses)
+    if constexpr (TIterator::UniformAttribute)
+    {
+        if (currentIndex > colorStarts)
+        {
+            _attrRow.Replace(colorStarts, currentIndex, it.GetAttribute());
+        }
+    }
+    else if (colorUses)
     {
         _attrRow.Replace(colorStarts, currentIndex, currentColor);
     }
@@ -24,6 +24,7 @@ Revision History:
 #include "LineRendition.hpp"
 #include "OutputCell.hpp"
 #include "OutputCellIterator.hpp"
+#include "TextCellIterator.hpp"
 #include "CharRow.hpp"
 #include "UnicodeStorage.hpp"
 
@@ -32,38 +33,71 @@ class TextBuffer;
 class ROW final
 {
 public:
-    ROW(const SHORT rowId, const unsigned short rowWidth, const TextAttribute fillAttribute, TextBuffer* const pParent);
+    ROW(const SHORT rowId, const gsl::span<wchar_t> chars, const gsl::span<DbcsAttribute> dbcsAttrs, const TextAttribute fillAttribute, std::pmr::memory_resource* const attrResource, TextBuffer* const pParent);
 
     size_t size() const noexcept { return _rowWidth; }
 
-    void SetWrapForced(const bool wrap) noexcept { _wrapForced = wrap; }
+    void SetWrapForced(const bool wrap) noexcept
+    {
+        _BumpGeneration();
+        _wrapForced = wrap;
+    }
     bool WasWrapForced() const noexcept { return _wrapForced; }
 
-    void SetDoubleBytePadded(const bool doubleBytePadded) noexcept { _doubleBytePadded = doubleBytePadded; }
+    void SetDoubleBytePadded(const bool doubleBytePadded) noexcept
+    {
+        _BumpGeneration();
+        _doubleBytePadded = doubleBytePadded;
+    }
     bool WasDoubleBytePadded() const noexcept { return _doubleBytePadded; }
 
     const CharRow& GetCharRow() const noexcept { return _charRow; }
-    CharRow& GetCharRow() noexcept { return _charRow; }
+    CharRow& GetCharRow() noexcept
+    {
+        _BumpGeneration();
+        return _charRow;
+    }
 
     const ATTR_ROW& GetAttrRow() const noexcept { return _attrRow; }
-    ATTR_ROW& GetAttrRow() noexcept { return _attrRow; }
+    ATTR_ROW& GetAttrRow() noexcept
+    {
+        _BumpGeneration();
+        return _attrRow;
+    }
 
     LineRendition GetLineRendition() const noexcept { return _lineRendition; }
-    void SetLineRendition(const LineRendition lineRendition) noexcept { _lineRendition = lineRendition; }
+    void SetLineRendition(const LineRendition lineRendition) noexcept
+    {
+        _BumpGeneration();
+        _lineRendition = lineRendition;
+    }
+
+    // The generation changes whenever the contents of the row might have changed,
+    // to a value that no other row has ever had. Two equal generations therefore
+    // mean that the row looks the same, even if it was moved around in the meantime.
+    uint64_t GetGeneration() const noexcept { return _generation; }
 
     SHORT GetId() const noexcept { return _id; }
     void SetId(const SHORT id) noexcept { _id = id; }
 
     bool Reset(const TextAttribute Attr);
-    [[nodiscard]] HRESULT Resize(const unsigned short width);
+    [[nodiscard]] HRESULT Resize(const gsl::span<wchar_t> chars, const gsl::span<DbcsAttribute> dbcsAttrs) noexcept;
 
     void ClearColumn(const size_t column);
     std::wstring GetText() const { return _charRow.GetText(); }
+    void AppendText(std::wstring& text, const size_t left, const size_t right) const { _charRow.AppendText(text, left, right); }
 
     UnicodeStorage& GetUnicodeStorage() noexcept;
     const UnicodeStorage& GetUnicodeStorage() const noexcept;
 
     OutputCellIterator WriteCells(OutputCellIterator it, const size_t index, const std::optional<bool> wrap = std::nullopt, std::optional<size_t> limitRight = std::nullopt);
+    TextCellIterator WriteText(TextCellIterator it, const size_t index, const std::optional<bool> wrap = std::nullopt, std::optional<size_t> limitRight = std::nullopt);
+    size_t WriteNarrowText(const std::wstring_view text, const size_t index, const TextAttribute& attr, const std::optional<bool> wrap = std::nullopt);
+    size_t FillNarrowText(const wchar_t wch, const size_t index, const size_t count, const std::optional<bool> wrap = std::nullopt);
+    size_t FillAttributes(const TextAttribute& attr, const size_t index, const size_t count);
+    bool CopyCells(const ROW& source, const size_t sourceColumn, const size_t targetColumn, const size_t count);
+    size_t WriteCharInfos(const gsl::span<const CHAR_INFO> charInfos, const size_t index, size_t& cellsWritten);
+    size_t ReadCharInfos(const size_t index, const gsl::span<CHAR_INFO> charInfos) const;
 
 #ifdef UNIT_TESTING
     friend constexpr bool operator==(const ROW& a, const ROW& b) noexcept;
@@ -71,8 +105,15 @@ public:
 #endif
 
 private:
+    void _BumpGeneration() noexcept { _generation = s_NextGeneration(); }
+    static uint64_t s_NextGeneration() noexcept;
+
+    template<typename TIterator>
+    TIterator _WriteCells(TIterator it, const size_t index, const std::optional<bool> wrap, std::optional<size_t> limitRight);
+
     CharRow _charRow;
     ATTR_ROW _attrRow;
+    UnicodeStorage _unicodeStorage;
     LineRendition _lineRendition;
     SHORT _id;
     unsigned short _rowWidth;
@@ -80,6 +121,7 @@ private:
     bool _wrapForced;
     // Occurs when the user runs out of text to support a double byte character and we're forced to the next line
     bool _doubleBytePadded;
+    uint64_t _generation;
     TextBuffer* _pParent; // non ownership pointer
 };
 
@@ -0,0 +1,95 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+
+#include "ScrollbackOverview.hpp"
+#include "textBuffer.hpp"
+
+// Routine Description:
+// - Brings the summaries up to date with the given buffer. Only the rows whose
+//   generation changed since the last update are summarized again, which is
+//   the case for the few rows that were written to and the ones that were
+//   recycled when the buffer circled. The caller must hold the lock of the buffer.
+// Arguments:
+// - buffer - the buffer to summarize
+// Return Value:
+// - <none>
+void ScrollbackOverview::Update(const TextBuffer& buffer)
+{
+    const size_t height = buffer.TotalRowCount();
+    if (_rows.size() != height)
+    {
+        // The buffer was resized (or reflowed), which rebuilds all of its rows anyway.
+        _rows.clear();
+        _rows.resize(height);
+    }
+    _firstRow = gsl::narrow_cast<size_t>(buffer.GetFirstRowIndex());
+
+    for (size_t y = 0; y < height; ++y)
+    {
+        const auto& row = buffer.GetRowByOffset(y);
+        auto& entry = til::at(_rows, (_firstRow + y) % height);
+        if (entry.generation == row.GetGeneration())
+        {
+            continue;
+        }
+
+        const auto textLength = gsl::narrow_cast<uint16_t>(row.GetCharRow().MeasureRight());
+        entry.generation = row.GetGeneration();
+        entry.summary.attr = row.GetAttrRow().GetDominantAttr(textLength);
+        entry.summary.textLength = textLength;
+    }
+}
+
+// Routine Description:
+// - Downsamples the summaries of the first rowCount rows into the given number
+//   of buckets of consecutive rows. Each bucket gets the color of its most
+//   prominent row (colored rows win over plain ones, then longer text over
+//   shorter text) and the average length of its rows' text.
+// - Call Update() first. If there are fewer rows than buckets, rows are
+//   repeated across several buckets.
+// Arguments:
+// - rowCount - the number of rows to summarize, counted from the oldest row
+// - buckets - the number of summaries to return
+// Return Value:
+// - one summary per bucket, from the oldest rows to the newest
+std::vector<ScrollbackOverview::Summary> ScrollbackOverview::Downsample(const size_t rowCount, const size_t buckets) const
+{
+    std::vector<Summary> result;
+    const auto height = _rows.size();
+    const auto rows = std::min(rowCount, height);
+    if (rows == 0)
+    {
+        return result;
+    }
+
+    result.reserve(buckets);
+    for (size_t bucket = 0; bucket < buckets; ++bucket)
+    {
+        const auto begin = bucket * rows / buckets;
+        const auto end = std::max(begin + 1, (bucket + 1) * rows / buckets);
+
+        const Summary* prominent = nullptr;
+        size_t totalLength = 0;
+        for (auto y = begin; y < end; ++y)
+        {
+            const auto& summary = til::at(_rows, (_firstRow + y) % height).summary;
+            totalLength += summary.textLength;
+
+            if (!prominent ||
+                std::make_pair(_IsColored(summary.attr), summary.textLength) > std::make_pair(_IsColored(prominent->attr), prominent->textLength))
+            {
+                prominent = &summary;
+            }
+        }
+
+        result.emplace_back(Summary{ prominent->attr, gsl::narrow_cast<uint16_t>(totalLength / (end - begin)) });
+    }
+    return result;
+}
+
+bool ScrollbackOverview::_IsColored(const TextAttribute& attr) noexcept
+{
+    return !attr.GetForeground().IsDefault() || !attr.BackgroundIsDefault() || attr.IsReverseVideo();
+}
@@ -0,0 +1,51 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- ScrollbackOverview.hpp
+
+Abstract:
+- A downsampled summary of a TextBuffer, for drawing an overview of the whole
+  scrollback next to the scroll bar.
+- Every row is summarized by the attribute that colors most of its text (see
+  ATTR_ROW::GetDominantAttr) and the length of that text. The summaries are
+  kept per row of the buffer's storage along with the row's generation, so
+  Update() only summarizes the rows that changed since the last call, even
+  when the buffer circled in between.
+- Like the TextBuffer itself, this isn't thread-safe. Use it under the lock
+  that protects the buffer.
+--*/
+
+#pragma once
+
+#include "TextAttribute.hpp"
+
+class TextBuffer;
+
+class ScrollbackOverview final
+{
+public:
+    struct Summary
+    {
+        TextAttribute attr;
+        uint16_t textLength = 0;
+    };
+
+    void Update(const TextBuffer& buffer);
+    std::vector<Summary> Downsample(const size_t rowCount, const size_t buckets) const;
+
+private:
+    struct Entry
+    {
+        // Generations start at 1, so 0 marks a row we didn't summarize yet.
+        uint64_t generation = 0;
+        Summary summary;
+    };
+
+    static bool _IsColored(const TextAttribute& attr) noexcept;
+
+    // Indexed by the rows' position in the storage, not by their offset.
+    std::vector<Entry> _rows;
+    size_t _firstRow = 0;
+};
@@ -0,0 +1,268 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+
+#include "ScrollbackSpill.hpp"
+#include "BufferSnapshot.hpp"
+#include "PackedRow.hpp"
+
+// Routine Description:
+// - Creates the spill file and its index. Existing files at the path are
+//   replaced.
+// Arguments:
+// - path - the spill file. The index is written to path + ".idx".
+ScrollbackSpill::ScrollbackSpill(std::wstring path) :
+    _path{ std::move(path) }
+{
+    _file.reset(CreateFileW(_path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr));
+    THROW_LAST_ERROR_IF(!_file);
+
+    const auto indexPath = _path + L".idx";
+    _index.reset(CreateFileW(indexPath.c_str(), GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr));
+    THROW_LAST_ERROR_IF(!_index);
+
+    _LoadCompressionApi();
+}
+
+ScrollbackSpill::~ScrollbackSpill()
+{
+    try
+    {
+        Flush();
+    }
+    CATCH_LOG();
+
+    if (_compressor)
+    {
+        _closeCompressor(_compressor);
+    }
+    if (_decompressor)
+    {
+        _closeDecompressor(_decompressor);
+    }
+}
+
+void ScrollbackSpill::_LoadCompressionApi() noexcept
+{
+    _cabinet.reset(LoadLibraryExW(L"cabinet.dll", nullptr, LOAD_LIBRARY_SEARCH_SYSTEM32));
+    if (!_cabinet)
+    {
+        return;
+    }
+
+    const auto createCompressor = GetProcAddressByFunctionDeclaration(_cabinet.get(), CreateCompressor);
+    const auto createDecompressor = GetProcAddressByFunctionDeclaration(_cabinet.get(), CreateDecompressor);
+    _compress = GetProcAddressByFunctionDeclaration(_cabinet.get(), Compress);
+    _decompress = GetProcAddressByFunctionDeclaration(_cabinet.get(), Decompress);
+    _closeCompressor = GetProcAddressByFunctionDeclaration(_cabinet.get(), CloseCompressor);
+    _closeDecompressor = GetProcAddressByFunctionDeclaration(_cabinet.get(), CloseDecompressor);
+    if (!createCompressor || !createDecompressor || !_compress || !_decompress || !_closeCompressor || !_closeDecompressor)
+    {
+        return;
+    }
+
+    if (!createCompressor(COMPRESS_ALGORITHM_XPRESS_HUFF, nullptr, &_compressor))
+    {
+        _compressor = nullptr;
+    }
+    if (!createDecompressor(COMPRESS_ALGORITHM_XPRESS_HUFF, nullptr, &_decompressor))
+    {
+        _decompressor = nullptr;
+    }
+}
+
+// Routine Description:
+// - Spills the given row. Call this right before the row is recycled.
+//   Whenever RowsPerChunk rows have been collected, they're written out.
+// Arguments:
+// - row - the row that's about to be evicted from the buffer
+// Return Value:
+// - <none>
+void ScrollbackSpill::Append(const ROW& row)
+{
+    std::string encoded;
+    SnapshotEncoder encoder{ encoded };
+    PackedRow::Pack(row).Serialize(encoder);
+    _pendingRows.emplace_back(std::move(encoded));
+
+    if (_pendingRows.size() >= RowsPerChunk)
+    {
+        _WriteChunk();
+    }
+}
+
+// Routine Description:
+// - Writes out the rows that don't fill a chunk yet, so that the files
+//   contain every spilled row.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void ScrollbackSpill::Flush()
+{
+    if (!_pendingRows.empty())
+    {
+        _WriteChunk();
+    }
+}
+
+void ScrollbackSpill::_WriteChunk()
+{
+    std::string raw;
+    SnapshotEncoder encoder{ raw };
+    for (const auto& row : _pendingRows)
+    {
+        encoder.WriteString(row);
+    }
+
+    Chunk chunk{};
+    chunk.firstRow = _chunks.empty() ? 0 : _chunks.back().firstRow + _chunks.back().rowCount;
+    chunk.offset = _fileSize;
+    chunk.rawSize = gsl::narrow<uint32_t>(raw.size());
+    chunk.rowCount = gsl::narrow<uint32_t>(_pendingRows.size());
+
+    std::string compressed;
+    if (_compressor)
+    {
+        SIZE_T required = 0;
+        // The first call only tells us how large the output can get.
+        if (!_compress(_compressor, raw.data(), raw.size(), nullptr, 0, &required) && GetLastError() == ERROR_INSUFFICIENT_BUFFER)
+        {
+            compressed.resize(required);
+            SIZE_T size = 0;
+            if (_compress(_compressor, raw.data(), raw.size(), compressed.data(), compressed.size(), &size) && size < raw.size())
+            {
+                compressed.resize(size);
+                chunk.flags |= CompressedFlag;
+            }
+        }
+    }
+
+    const std::string_view stored{ WI_IsFlagSet(chunk.flags, CompressedFlag) ? compressed : raw };
+    chunk.storedSize = gsl::narrow<uint32_t>(stored.size());
+    _WriteAt(_file.get(), chunk.offset, stored);
+    _fileSize += stored.size();
+
+    std::string record;
+    SnapshotEncoder recordEncoder{ record };
+    recordEncoder.Write(chunk.firstRow);
+    recordEncoder.Write(chunk.offset);
+    recordEncoder.Write(chunk.storedSize);
+    recordEncoder.Write(chunk.rawSize);
+    recordEncoder.Write(chunk.rowCount);
+    recordEncoder.Write(chunk.flags);
+    _WriteAt(_index.get(), _chunks.size() * record.size(), record);
+
+    _chunks.emplace_back(chunk);
+    _pendingRows.clear();
+}
+
+void ScrollbackSpill::_WriteAt(const HANDLE file, const uint64_t offset, const std::string_view bytes)
+{
+    OVERLAPPED overlapped{};
+    overlapped.Offset = static_cast<DWORD>(offset);
+    overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+    DWORD written = 0;
+    THROW_IF_WIN32_BOOL_FALSE(WriteFile(file, bytes.data(), gsl::narrow<DWORD>(bytes.size()), &written, &overlapped));
+}
+
+// Routine Description:
+// - Returns the number of rows spilled so far, including the ones that
+//   aren't written out yet. Row 0 is the first row ever evicted.
+size_t ScrollbackSpill::RowCount() const noexcept
+{
+    const auto written = _chunks.empty() ? 0 : _chunks.back().firstRow + _chunks.back().rowCount;
+    return gsl::narrow_cast<size_t>(written) + _pendingRows.size();
+}
+
+// Routine Description:
+// - Restores a spilled row, paging in its chunk if necessary.
+// Arguments:
+// - index - the row number, from 0 to RowCount()
+// - row - the row to overwrite. Must be exactly as wide as the spilled row,
+//   which is the width the buffer had when it was evicted.
+// Return Value:
+// - <none>
+void ScrollbackSpill::ReadRow(const size_t index, ROW& row) const
+{
+    SnapshotDecoder decoder{ _GetEncodedRow(index) };
+    PackedRow::Deserialize(decoder).Unpack(row);
+}
+
+// Routine Description:
+// - Returns the text of a spilled row, for instance to search through it.
+// Arguments:
+// - index - the row number, from 0 to RowCount()
+// Return Value:
+// - the text of the row, like ROW::GetText()
+std::wstring ScrollbackSpill::GetRowText(const size_t index) const
+{
+    SnapshotDecoder decoder{ _GetEncodedRow(index) };
+    return PackedRow::Deserialize(decoder).GetText();
+}
+
+const std::wstring& ScrollbackSpill::Path() const noexcept
+{
+    return _path;
+}
+
+std::string_view ScrollbackSpill::_GetEncodedRow(const size_t index) const
+{
+    THROW_HR_IF(E_BOUNDS, index >= RowCount());
+
+    const auto it = std::upper_bound(_chunks.begin(), _chunks.end(), index, [](const size_t index, const Chunk& chunk) {
+        return index < chunk.firstRow;
+    });
+    if (it == _chunks.begin() || index >= (it - 1)->firstRow + (it - 1)->rowCount)
+    {
+        // It's one of the rows that aren't written out yet.
+        const auto written = _chunks.empty() ? 0 : _chunks.back().firstRow + _chunks.back().rowCount;
+        return til::at(_pendingRows, index - gsl::narrow_cast<size_t>(written));
+    }
+
+    const auto chunk = gsl::narrow_cast<size_t>(it - 1 - _chunks.begin());
+    const auto& rows = _LoadChunk(chunk);
+    return til::at(rows, index - gsl::narrow_cast<size_t>(til::at(_chunks, chunk).firstRow));
+}
+
+const std::vector<std::string_view>& ScrollbackSpill::_LoadChunk(const size_t index) const
+{
+    if (_cachedChunk == index)
+    {
+        return _cachedChunkRows;
+    }
+
+    const auto& chunk = til::at(_chunks, index);
+    std::string stored;
+    stored.resize(chunk.storedSize);
+    OVERLAPPED overlapped{};
+    overlapped.Offset = static_cast<DWORD>(chunk.offset);
+    overlapped.OffsetHigh = static_cast<DWORD>(chunk.offset >> 32);
+    DWORD read = 0;
+    THROW_IF_WIN32_BOOL_FALSE(ReadFile(_file.get(), stored.data(), chunk.storedSize, &read, &overlapped));
+    THROW_HR_IF(HRESULT_FROM_WIN32(ERROR_HANDLE_EOF), read != chunk.storedSize);
+
+    _cachedChunk = SIZE_MAX;
+    if (WI_IsFlagSet(chunk.flags, CompressedFlag))
+    {
+        THROW_HR_IF(E_NOT_VALID_STATE, !_decompressor);
+        _cachedChunkBytes.resize(chunk.rawSize);
+        SIZE_T size = 0;
+        THROW_IF_WIN32_BOOL_FALSE(_decompress(_decompressor, stored.data(), stored.size(), _cachedChunkBytes.data(), _cachedChunkBytes.size(), &size));
+        THROW_HR_IF(HRESULT_FROM_WIN32(ERROR_INVALID_DATA), size != chunk.rawSize);
+    }
+    else
+    {
+        _cachedChunkBytes = std::move(stored);
+    }
+
+    _cachedChunkRows.clear();
+    SnapshotDecoder decoder{ _cachedChunkBytes };
+    for (uint32_t i = 0; i < chunk.rowCount; ++i)
+    {
+        _cachedChunkRows.emplace_back(decoder.ReadString());
+    }
+    _cachedChunk = index;
+    return _cachedChunkRows;
+}
@@ -0,0 +1,95 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- ScrollbackSpill.hpp
+
+Abstract:
+- An append-only file that the rows evicted from a TextBuffer's circular
+  buffer are spilled into, so that the history isn't limited by memory.
+- Rows are encoded as PackedRows (see BufferSnapshot) and collected into chunks
+  of up to RowsPerChunk rows. Every chunk is compressed (XPRESS Huffman, if the
+  Compression API is available) and appended to the file, and its location and
+  first row number are appended to an index file next to it (<path>.idx).
+- Reading a spilled row back pages in (and caches) the chunk containing it.
+- Spilled rows keep their hyperlink IDs, but the buffer forgets the URI of a
+  hyperlink once no row in it refers to it anymore and may reuse its ID for
+  a different hyperlink later on.
+- Like the TextBuffer itself, this isn't thread-safe. Use it under the lock
+  that protects the buffer.
+
+Index format (all values little endian), one record per chunk:
+- uint64 first row, uint64 offset in the file, uint32 stored size,
+  uint32 raw size, uint32 row count, uint32 flags (1 = compressed)
+- a chunk is its rows, each a uint32 length followed by the PackedRow
+--*/
+
+#pragma once
+
+#include <compressapi.h>
+
+class ROW;
+
+class ScrollbackSpill final
+{
+public:
+    static constexpr size_t RowsPerChunk = 256;
+
+    explicit ScrollbackSpill(std::wstring path);
+    ~ScrollbackSpill();
+
+    ScrollbackSpill(const ScrollbackSpill&) = delete;
+    ScrollbackSpill& operator=(const ScrollbackSpill&) = delete;
+
+    void Append(const ROW& row);
+    void Flush();
+
+    size_t RowCount() const noexcept;
+    void ReadRow(const size_t index, ROW& row) const;
+    std::wstring GetRowText(const size_t index) const;
+
+    const std::wstring& Path() const noexcept;
+
+private:
+    struct Chunk
+    {
+        uint64_t firstRow;
+        uint64_t offset;
+        uint32_t storedSize;
+        uint32_t rawSize;
+        uint32_t rowCount;
+        uint32_t flags;
+    };
+    static constexpr uint32_t CompressedFlag = 1;
+
+    void _LoadCompressionApi() noexcept;
+    void _WriteChunk();
+    std::string_view _GetEncodedRow(const size_t index) const;
+    const std::vector<std::string_view>& _LoadChunk(const size_t chunk) const;
+    static void _WriteAt(const HANDLE file, const uint64_t offset, const std::string_view bytes);
+
+    std::wstring _path;
+    wil::unique_hfile _file;
+    wil::unique_hfile _index;
+    uint64_t _fileSize = 0;
+    std::vector<Chunk> _chunks;
+
+    // The Compression API lives in cabinet.dll, which we load on demand.
+    // Without it, chunks are stored uncompressed.
+    wil::unique_hmodule _cabinet;
+    COMPRESSOR_HANDLE _compressor = nullptr;
+    DECOMPRESSOR_HANDLE _decompressor = nullptr;
+    decltype(&::Compress) _compress = nullptr;
+    decltype(&::Decompress) _decompress = nullptr;
+    decltype(&::CloseCompressor) _closeCompressor = nullptr;
+    decltype(&::CloseDecompressor) _closeDecompressor = nullptr;
+
+    // The encoded rows that don't fill a chunk yet.
+    std::vector<std::string> _pendingRows;
+
+    // The chunk that was paged in last.
+    mutable size_t _cachedChunk = SIZE_MAX;
+    mutable std::string _cachedChunkBytes;
+    mutable std::vector<std::string_view> _cachedChunkRows;
+};
@@ -0,0 +1,120 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- TextCellIterator.hpp
+
+Abstract:
+- Read-only view into a run of text that's written into the output buffer with a single attribute.
+- This is what OutputCellIterator does for text and an attribute, but as a type of its own. It
+  doesn't switch on a mode for every cell and everything is inline, so the writers taking it
+  (ROW::WriteText, TextBuffer::WriteText) are compiled specifically for it.
+- If the attribute applies to every cell, UniformAttribute is true and the writer applies it to
+  the whole run at once, instead of comparing it cell by cell.
+
+--*/
+
+#pragma once
+
+#include "TextAttribute.hpp"
+#include "OutputCellView.hpp"
+
+#include "../../types/inc/GlyphWidth.hpp"
+#include "../../types/inc/Utf16Parser.hpp"
+
+class TextCellIterator final
+{
+public:
+    static constexpr bool UniformAttribute = true;
+
+    TextCellIterator(const std::wstring_view utf16Text, const TextAttribute attribute) :
+        _text{ utf16Text },
+        _attr{ attribute },
+        _currentView{ s_GenerateView(utf16Text, attribute) }
+    {
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return _pos < _text.size();
+    }
+
+    TextCellIterator& operator++()
+    {
+        // Keep track of total distance moved (cells filled)
+        ++_distance;
+
+        // A wide glyph takes two cells: the view is returned once as the leading and once as the trailing half.
+        auto dbcsAttr = _currentView.DbcsAttr();
+        if (dbcsAttr.IsLeading())
+        {
+            dbcsAttr.SetTrailing();
+            _currentView.UpdateDbcsAttribute(dbcsAttr);
+        }
+        else
+        {
+            _pos += _currentView.Chars().size();
+            if (_pos < _text.size())
+            {
+                _currentView = s_GenerateView(_text.substr(_pos), _attr);
+            }
+        }
+
+        return *this;
+    }
+
+    const OutputCellView& operator*() const noexcept
+    {
+        return _currentView;
+    }
+
+    const OutputCellView* operator->() const noexcept
+    {
+        return &_currentView;
+    }
+
+    const TextAttribute& GetAttribute() const noexcept
+    {
+        return _attr;
+    }
+
+    ptrdiff_t GetCellDistance(const TextCellIterator& other) const noexcept
+    {
+        return _distance - other._distance;
+    }
+
+    ptrdiff_t GetInputDistance(const TextCellIterator& other) const noexcept
+    {
+        return _pos - other._pos;
+    }
+
+private:
+    static OutputCellView s_GenerateView(const std::wstring_view text, const TextAttribute attr)
+    {
+        DbcsAttribute dbcsAttr;
+
+        // Anything but a surrogate is a glyph of its own, which saves us the parser.
+        if (!text.empty() && (text.front() < 0xD800 || text.front() > 0xDFFF))
+        {
+            if (IsGlyphFullWidth(text.front()))
+            {
+                dbcsAttr.SetLeading();
+            }
+            return OutputCellView(text.substr(0, 1), dbcsAttr, attr, TextAttributeBehavior::Stored);
+        }
+
+        const auto glyph = Utf16Parser::ParseNext(text);
+        if (IsGlyphFullWidth(glyph))
+        {
+            dbcsAttr.SetLeading();
+        }
+        return OutputCellView(glyph, dbcsAttr, attr, TextAttributeBehavior::Stored);
+    }
+
+    std::wstring_view _text;
+    TextAttribute _attr;
+    OutputCellView _currentView;
+    size_t _pos = 0;
+    size_t _distance = 0;
+};
@@ -107,8 +107,13 @@ void TextColor::SetColor(const COLORREF rgbColor) noexcept
 // - <none>
 void TextColor::SetIndex(const BYTE index, const bool isIndex256) noexcept
 {
+    // The unused channels are cleared like in the constructors, because equality compares
+    // all of them. Otherwise a stale RGB value would keep otherwise identical attributes from
+    // being merged into a single run in the ATTR_ROW and split render runs unnecessarily.
     _meta = isIndex256 ? ColorType::IsIndex256 : ColorType::IsIndex16;
     _index = index;
+    _green = 0;
+    _blue = 0;
 }
 
 // Method Description:
@@ -120,7 +125,11 @@ void TextColor::SetIndex(const BYTE index, const bool isIndex256) noexcept
 // - <none>
 void TextColor::SetDefault() noexcept
 {
+    // See SetIndex() for why the channels are cleared as well.
     _meta = ColorType::IsDefault;
+    _red = 0;
+    _green = 0;
+    _blue = 0;
 }
 
 // Method Description:
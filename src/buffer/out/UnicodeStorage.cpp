@@ -5,7 +5,9 @@
 #include "UnicodeStorage.hpp"
 
 UnicodeStorage::UnicodeStorage() noexcept :
-    _map{}
+    _entries{},
+    _pool{},
+    _unused{ 0 }
 {
 }
 
@@ -14,11 +16,13 @@ UnicodeStorage::UnicodeStorage() noexcept :
 // Arguments:
 // - key - the key into the storage
 // Return Value:
-// - the glyph data associated with key
+// - the glyph data associated with key. It's valid until the storage is modified.
 // Note: will throw exception if key is not stored yet
-const UnicodeStorage::mapped_type& UnicodeStorage::GetText(const key_type key) const
+std::wstring_view UnicodeStorage::GetText(const key_type key) const
 {
-    return _map.at(key);
+    const auto it = _lowerBound(key);
+    THROW_HR_IF(E_INVALIDARG, it == _entries.end() || it->column != key);
+    return std::wstring_view{ _pool }.substr(it->offset, it->length);
 }
 
 // Routine Description:
@@ -26,9 +30,37 @@ const UnicodeStorage::mapped_type& UnicodeStorage::GetText(const key_type key) c
 // Arguments:
 // - key - the key into the storage
 // - glyph - the glyph data to store
-void UnicodeStorage::StoreGlyph(const key_type key, const mapped_type& glyph)
+void UnicodeStorage::StoreGlyph(const key_type key, const std::wstring_view glyph)
 {
-    _map.insert_or_assign(key, glyph);
+    auto it = _lowerBound(key);
+    if (it != _entries.end() && it->column == key)
+    {
+        // Glyphs are overwritten by glyphs of the same size most of the time,
+        // in which case we can simply reuse the old spot in the pool.
+        if (glyph.size() <= it->length)
+        {
+            std::copy(glyph.begin(), glyph.end(), _pool.begin() + it->offset);
+            _unused += it->length - glyph.size();
+            it->length = glyph.size();
+            return;
+        }
+
+        _unused += it->length;
+    }
+    else
+    {
+        it = _entries.insert(it, Entry{ key, 0, 0 });
+    }
+
+    it->offset = _pool.size();
+    it->length = glyph.size();
+    _pool.append(glyph);
+
+    // Don't let overwritten glyphs pile up forever.
+    if (_unused > _pool.size() / 2)
+    {
+        _Compact();
+    }
 }
 
 // Routine Description:
@@ -37,62 +69,86 @@ void UnicodeStorage::StoreGlyph(const key_type key, const mapped_type& glyph)
 // - key - the key to remove
 void UnicodeStorage::Erase(const key_type key) noexcept
 {
-    _map.erase(key);
+    const auto it = _lowerBound(key);
+    if (it != _entries.end() && it->column == key)
+    {
+        _unused += it->length;
+        _entries.erase(it);
+    }
 }
 
 // Routine Description:
-// - Remaps all of the stored items to new coordinate positions
-//   based on a bulk rearrangement of row IDs and potential row width resize.
+// - Removes all the stored items that are beyond the (new) width of the row.
 // Arguments:
-// - rowMap - A map of the old row IDs to the new row IDs.
-// - width - The width of the new row. Remove any items that are beyond the row width.
-//         - Use nullopt if we're not resizing the width of the row, just renumbering the rows.
-void UnicodeStorage::Remap(const std::unordered_map<SHORT, SHORT>& rowMap, const std::optional<SHORT> width)
+// - width - The width of the row.
+void UnicodeStorage::Trim(const size_t width) noexcept
 {
-    // Make a temporary map to hold all the new row positioning
-    std::unordered_map<key_type, mapped_type> newMap;
-
-    // Walk through every stored item.
-    for (const auto& pair : _map)
+    while (!_entries.empty() && _entries.back().column >= width)
     {
-        // Extract the old coordinate position
-        const auto oldCoord = pair.first;
-
-        // Only try to short-circuit based on width if we were told it changed
-        // by being given a new width value.
-        if (width.has_value())
-        {
-            // Get the column ID
-            const auto oldColId = oldCoord.X;
-
-            // If the column index is at/beyond the row width, don't bother copying it to the new map.
-            if (oldColId >= width.value())
-            {
-                continue;
-            }
-        }
+        _unused += _entries.back().length;
+        _entries.pop_back();
+    }
 
-        // Get the row ID from the position as that's what we need to remap
-        const auto oldRowId = oldCoord.Y;
+    if (_entries.empty())
+    {
+        Reset();
+    }
+}
 
-        // Use the mapping given to convert the old row ID to the new row ID
-        const auto mapIter = rowMap.find(oldRowId);
+// Routine Description:
+// - Removes all the stored items.
+void UnicodeStorage::Reset() noexcept
+{
+    _entries.clear();
+    _pool.clear();
+    _unused = 0;
+}
 
-        // If there's no mapping to a new row, don't bother copying it to the new map. The row is gone.
-        if (mapIter == rowMap.end())
-        {
-            continue;
-        }
+// Routine Description:
+// - Returns how many bytes this storage has allocated on the heap.
+size_t UnicodeStorage::MemoryUsage() const noexcept
+{
+    auto bytes = _entries.capacity() * sizeof(Entry);
+    // Short strings are stored inside the std::wstring itself.
+    if (_pool.capacity() > std::wstring{}.capacity())
+    {
+        bytes += (_pool.capacity() + 1) * sizeof(wchar_t);
+    }
+    return bytes;
+}
 
-        const auto newRowId = mapIter->second;
+// Routine Description:
+// - finds the first entry at or after the given column
+// Arguments:
+// - key - the column to look for
+// Return Value:
+// - the entry for key, the entry it would have to be inserted before, or end()
+std::vector<UnicodeStorage::Entry>::iterator UnicodeStorage::_lowerBound(const key_type key) noexcept
+{
+    return std::lower_bound(_entries.begin(), _entries.end(), key, [](const Entry& entry, const key_type column) noexcept {
+        return entry.column < column;
+    });
+}
 
-        // Generate a new coordinate with the same X as the old one, but a new Y value.
-        const auto newCoord = COORD{ oldCoord.X, newRowId };
+std::vector<UnicodeStorage::Entry>::const_iterator UnicodeStorage::_lowerBound(const key_type key) const noexcept
+{
+    return std::lower_bound(_entries.begin(), _entries.end(), key, [](const Entry& entry, const key_type column) noexcept {
+        return entry.column < column;
+    });
+}
 
-        // Put the adjusted coordinate into the map with the original value.
-        newMap.emplace(newCoord, pair.second);
+// Routine Description:
+// - Rebuilds the pool out of the glyphs that are still in use.
+void UnicodeStorage::_Compact()
+{
+    std::wstring pool;
+    pool.reserve(_pool.size() - _unused);
+    for (auto& entry : _entries)
+    {
+        const auto offset = pool.size();
+        pool.append(_pool, entry.offset, entry.length);
+        entry.offset = offset;
     }
-
-    // Swap into the stored map, free the temporary when we exit.
-    _map.swap(newMap);
+    _pool = std::move(pool);
+    _unused = 0;
 }
@@ -7,6 +7,8 @@ Module Name:
 
 Abstract:
 - dynamic storage location for glyphs that can't normally fit in the output buffer
+- Every ROW owns one, so that the glyphs travel with their row when rows
+  are rotated or resized, instead of having to be re-keyed.
 
 Author(s):
 - Austin Diviness (AustDi) 02-May-2018
@@ -15,50 +17,46 @@ Author(s):
 #pragma once
 
 #include <vector>
-#include <unordered_map>
-#include <climits>
-
-// std::unordered_map needs help to know how to hash a COORD
-namespace std
-{
-    template<>
-    struct hash<COORD>
-    {
-        // Routine Description:
-        // - hashes a coord. coord will be hashed by storing the x and y values consecutively in the lower
-        // bits of a size_t.
-        // Arguments:
-        // - coord - the coord to hash
-        // Return Value:
-        // - the hashed coord
-        constexpr size_t operator()(const COORD& coord) const noexcept
-        {
-            size_t retVal = coord.Y;
-            const size_t xCoord = coord.X;
-            retVal |= xCoord << (sizeof(coord.Y) * CHAR_BIT);
-            return retVal;
-        }
-    };
-}
+#include <string>
 
 class UnicodeStorage final
 {
 public:
-    using key_type = typename COORD;
-    using mapped_type = typename std::vector<wchar_t>;
+    // the column within the owning row
+    using key_type = size_t;
 
     UnicodeStorage() noexcept;
 
-    const mapped_type& GetText(const key_type key) const;
+    std::wstring_view GetText(const key_type key) const;
 
-    void StoreGlyph(const key_type key, const mapped_type& glyph);
+    void StoreGlyph(const key_type key, const std::wstring_view glyph);
 
     void Erase(const key_type key) noexcept;
 
-    void Remap(const std::unordered_map<SHORT, SHORT>& rowMap, const std::optional<SHORT> width);
+    void Trim(const size_t width) noexcept;
+
+    void Reset() noexcept;
+
+    size_t MemoryUsage() const noexcept;
 
 private:
-    std::unordered_map<key_type, mapped_type> _map;
+    // Where the glyph for a column lives in the _pool.
+    // The entries are sorted by column, for a binary search.
+    struct Entry
+    {
+        key_type column;
+        size_t offset;
+        size_t length;
+    };
+
+    std::vector<Entry>::iterator _lowerBound(const key_type key) noexcept;
+    std::vector<Entry>::const_iterator _lowerBound(const key_type key) const noexcept;
+    void _Compact();
+
+    std::vector<Entry> _entries;
+    std::wstring _pool;
+    // The number of characters in the _pool that no entry refers to anymore.
+    size_t _unused;
 
 #ifdef UNIT_TESTING
     friend class UnicodeStorageTests;
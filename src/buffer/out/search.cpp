@@ -60,6 +60,26 @@ Search::Search(IUiaData& uiaData,
     _coordNext = _coordAnchor;
 }
 
+// Routine Description:
+// - Constructs a Search object that finds matches of a regular expression.
+// - Unlike the literal search, regex matches are found on logical lines,
+//   so that a match can span rows that were wrapped.
+// Arguments:
+// - uiaData - The IUiaData type reference, it is for providing selection methods
+// - regex - The compiled expression to search for. It must outlive this object.
+// - direction - The direction to search (upward or downward)
+Search::Search(IUiaData& uiaData,
+               const std::wregex& regex,
+               const Direction direction) :
+    _direction(direction),
+    _sensitivity(Sensitivity::CaseSensitive),
+    _uiaData(uiaData),
+    _coordAnchor(s_GetInitialAnchor(uiaData, direction)),
+    _regex(&regex)
+{
+    _coordNext = _coordAnchor;
+}
+
 // Routine Description
 // - Locates the next instance of the search term within the screen buffer.
 // Arguments:
@@ -69,6 +89,11 @@ Search::Search(IUiaData& uiaData,
 // - NOTE: You can FindNext() again after False to go around the buffer again.
 bool Search::FindNext()
 {
+    if (_regex)
+    {
+        return _FindNextRegexMatch();
+    }
+
     if (_reachedEnd)
     {
         _reachedEnd = false;
@@ -193,12 +218,14 @@ bool Search::_FindNeedleInHaystackAt(const COORD pos, COORD& start, COORD& end)
     end = { 0 };
 
     COORD bufferPos = pos;
+    const auto& textBuffer = _uiaData.GetTextBuffer();
 
     for (const auto& needleCell : _needle)
     {
         // Haystack is the buffer. Needle is the string we were given.
-        const auto hayIter = _uiaData.GetTextBuffer().GetTextDataAt(bufferPos);
-        const auto hayChars = *hayIter;
+        // Nearly every position fails on the first cell, so read the glyph straight
+        // out of the row instead of constructing a text iterator for each cell.
+        const std::wstring_view hayChars = textBuffer.GetRowByOffset(bufferPos.Y).GetCharRow().GlyphAt(bufferPos.X);
         const auto needleChars = std::wstring_view(needleCell.data(), needleCell.size());
 
         // If we didn't match at any point of the needle, return false.
@@ -323,6 +350,142 @@ void Search::_UpdateNextPosition()
     }
 }
 
+// Routine Description:
+// - Collects the text of the logical line that starts at the given row.
+//   The line continues onto the following rows for as long as they were wrapped.
+// Arguments:
+// - top - The first row of the line
+// - text - Receives the text of the line, without trailing spaces
+// - positions - Receives the buffer position of each code unit in text
+// Return Value:
+// - The last row of the line
+SHORT Search::_GetLogicalLine(const SHORT top, std::wstring& text, std::vector<COORD>& positions) const
+{
+    const auto& textBuffer = _uiaData.GetTextBuffer();
+    const auto lastRow = _uiaData.GetTextBufferEndPosition().Y;
+
+    text.clear();
+    positions.clear();
+
+    auto y = top;
+    for (;; ++y)
+    {
+        const auto& row = textBuffer.GetRowByOffset(y);
+        const auto& charRow = row.GetCharRow();
+        for (size_t x = 0; x < charRow.size(); ++x)
+        {
+            if (charRow.DbcsAttrAt(x).IsTrailing())
+            {
+                continue;
+            }
+
+            const std::wstring_view glyph = charRow.GlyphAt(x);
+            text.append(glyph);
+            positions.insert(positions.end(), glyph.size(), COORD{ gsl::narrow_cast<SHORT>(x), y });
+        }
+
+        if (!row.WasWrapForced() || y >= lastRow)
+        {
+            break;
+        }
+    }
+
+    const auto trimmed = text.find_last_not_of(L' ') + 1;
+    text.resize(trimmed);
+    positions.resize(trimmed);
+    return y;
+}
+
+// Routine Description:
+// - Finds the next match of the regex, starting at the next search position
+//   and wrapping around the buffer once.
+// Return Value:
+// - True if we found a match. False if there's none in the whole buffer.
+bool Search::_FindNextRegexMatch()
+{
+    const auto& textBuffer = _uiaData.GetTextBuffer();
+    const auto lastRow = _uiaData.GetTextBufferEndPosition().Y;
+    const auto forward = _direction == Direction::Forward;
+
+    // Start at the beginning of the logical line that holds the next position.
+    auto startTop = std::min(_coordNext.Y, lastRow);
+    while (startTop > 0 && textBuffer.GetRowByOffset(startTop - 1).WasWrapForced())
+    {
+        --startTop;
+    }
+
+    std::wstring text;
+    std::vector<COORD> positions;
+    auto lineTop = startTop;
+
+    for (auto firstPass = true;; firstPass = false)
+    {
+        const auto lineBottom = _GetLogicalLine(lineTop, text, positions);
+
+        // On the first pass the match has to start at or after (or before, going backward)
+        // the next position. We'll come back around to the rest of the line at the very end.
+        std::optional<std::pair<COORD, COORD>> found;
+        for (auto it = std::wsregex_iterator{ text.cbegin(), text.cend(), *_regex }; it != std::wsregex_iterator{}; ++it)
+        {
+            const auto& match = *it;
+            if (match.length() == 0)
+            {
+                continue;
+            }
+
+            const auto start = til::at(positions, gsl::narrow_cast<size_t>(match.position()));
+            if (firstPass)
+            {
+                const auto startsAfter = start.Y > _coordNext.Y || (start.Y == _coordNext.Y && start.X >= _coordNext.X);
+                const auto startsBefore = start.Y < _coordNext.Y || (start.Y == _coordNext.Y && start.X <= _coordNext.X);
+                if (forward ? !startsAfter : !startsBefore)
+                {
+                    continue;
+                }
+            }
+
+            auto end = til::at(positions, gsl::narrow_cast<size_t>(match.position() + match.length() - 1));
+            if (textBuffer.GetRowByOffset(end.Y).GetCharRow().DbcsAttrAt(end.X).IsLeading())
+            {
+                end.X++;
+            }
+
+            found.emplace(start, end);
+            if (forward)
+            {
+                break;
+            }
+        }
+
+        if (found)
+        {
+            _coordSelStart = found->first;
+            _coordSelEnd = found->second;
+            _coordNext = _coordSelStart;
+            _UpdateNextPosition();
+            return true;
+        }
+
+        if (!firstPass && lineTop == startTop)
+        {
+            return false;
+        }
+
+        if (forward)
+        {
+            lineTop = lineBottom >= lastRow ? 0 : gsl::narrow_cast<SHORT>(lineBottom + 1);
+        }
+        else
+        {
+            lineTop = lineTop <= 0 ? lastRow : gsl::narrow_cast<SHORT>(lineTop - 1);
+            while (lineTop > 0 && textBuffer.GetRowByOffset(lineTop - 1).WasWrapForced())
+            {
+                --lineTop;
+            }
+        }
+    }
+}
+
 // Routine Description:
 // - Creates a "needle" of the correct format for comparison to the screen buffer text data
 //   that we can use for our search
@@ -336,11 +499,11 @@ std::vector<std::vector<wchar_t>> Search::s_CreateNeedleFromString(const std::ws
     std::vector<std::vector<wchar_t>> cells;
     for (const auto chars : charData)
     {
-        if (IsGlyphFullWidth(std::wstring_view{ chars.data(), chars.size() }))
+        if (IsGlyphFullWidth(chars))
         {
-            cells.emplace_back(chars);
+            cells.emplace_back(chars.begin(), chars.end());
         }
-        cells.emplace_back(chars);
+        cells.emplace_back(chars.begin(), chars.end());
     }
     return cells;
 }
@@ -51,6 +51,10 @@ public:
            const Sensitivity sensitivity,
            const COORD anchor);
 
+    Search(Microsoft::Console::Types::IUiaData& uiaData,
+           const std::wregex& regex,
+           const Direction dir);
+
     bool FindNext();
     void Select() const;
     void Color(const TextAttribute attr) const;
@@ -63,6 +67,9 @@ private:
     bool _CompareChars(const std::wstring_view one, const std::wstring_view two) const noexcept;
     void _UpdateNextPosition();
 
+    bool _FindNextRegexMatch();
+    SHORT _GetLogicalLine(const SHORT top, std::wstring& text, std::vector<COORD>& positions) const;
+
     void _IncrementCoord(COORD& coord) const noexcept;
     void _DecrementCoord(COORD& coord) const noexcept;
 
@@ -80,6 +87,7 @@ private:
     const Direction _direction;
     const Sensitivity _sensitivity;
     Microsoft::Console::Types::IUiaData& _uiaData;
+    const std::wregex* const _regex = nullptr;
 
 #ifdef UNIT_TESTING
     friend class SearchTests;
@@ -5,6 +5,10 @@
 
 #include "textBuffer.hpp"
 #include "CharRow.hpp"
+#include "CommandTimeline.hpp"
+#include "ScrollbackSpill.hpp"
+
+#include <execution>
 
 #include "../types/inc/utils.hpp"
 #include "../types/inc/convert.hpp"
@@ -34,18 +38,22 @@ TextBuffer::TextBuffer(const COORD screenBufferSize,
     _firstRow{ 0 },
     _currentAttributes{ defaultAttributes },
     _cursor{ cursorSize, *this },
+    _charRowStorage{ static_cast<size_t>(screenBufferSize.X), static_cast<size_t>(screenBufferSize.Y) },
+    _attrRowAccounting{ til::pmr::get_default_resource() },
+    _attrRowPool{ &_attrRowAccounting },
     _storage{},
-    _unicodeStorage{},
-    _renderTarget{ renderTarget },
+    _renderTarget{ &renderTarget },
     _size{},
     _currentHyperlinkId{ 1 },
-    _currentPatternId{ 0 }
+    _nextHyperlinkSweep{ MinimumHyperlinkSweep },
+    _currentPatternId{ 0 },
+    _evictedRows{ 0 }
 {
     // initialize ROWs
     _storage.reserve(static_cast<size_t>(screenBufferSize.Y));
     for (size_t i = 0; i < static_cast<size_t>(screenBufferSize.Y); ++i)
     {
-        _storage.emplace_back(static_cast<SHORT>(i), screenBufferSize.X, _currentAttributes, this);
+        _storage.emplace_back(static_cast<SHORT>(i), _charRowStorage.Chars(i), _charRowStorage.DbcsAttrs(i), _currentAttributes, &_attrRowPool, this);
     }
 
     _UpdateSize();
@@ -334,6 +342,30 @@ OutputCellIterator TextBuffer::Write(const OutputCellIterator givenIt)
 OutputCellIterator TextBuffer::Write(const OutputCellIterator givenIt,
                                      const COORD target,
                                      const std::optional<bool> wrap)
+{
+    return _Write(givenIt, target, wrap);
+}
+
+// Routine Description:
+// - Writes text with a single attribute to the output buffer. Like Write() with
+//   an OutputCellIterator over the same text, but compiled for this case alone.
+// Arguments:
+// - givenIt - Iterator over the text to write
+// - target - the row/column to start writing the text to
+// - wrap - change the wrap flag if we hit the end of the row while writing and there's still more data
+// Return Value:
+// - The final position of the iterator
+TextCellIterator TextBuffer::WriteText(const TextCellIterator givenIt,
+                                       const COORD target,
+                                       const std::optional<bool> wrap)
+{
+    return _Write(givenIt, target, wrap);
+}
+
+template<typename TIterator>
+TIterator TextBuffer::_Write(const TIterator givenIt,
+                             const COORD target,
+                             const std::optional<bool> wrap)
 {
     // Make mutable copy so we can walk.
     auto it = givenIt;
@@ -349,7 +381,7 @@ OutputCellIterator TextBuffer::Write(const OutputCellIterator givenIt,
     {
         // Attempt to write as much data as possible onto this line.
         // NOTE: if wrap = true/false, we want to set the line's wrap to true/false (respectively) if we reach the end of the line
-        it = WriteLine(it, lineTarget, wrap);
+        it = _WriteLine(it, lineTarget, wrap, std::nullopt);
 
         // Move to the next line down.
         lineTarget.X = 0;
@@ -372,6 +404,31 @@ OutputCellIterator TextBuffer::WriteLine(const OutputCellIterator givenIt,
                                          const COORD target,
                                          const std::optional<bool> wrap,
                                          std::optional<size_t> limitRight)
+{
+    return _WriteLine(givenIt, target, wrap, limitRight);
+}
+
+// Routine Description:
+// - Writes one line of text with a single attribute to the output buffer.
+//   Like WriteLine() with an OutputCellIterator over the same text.
+// Arguments:
+// - givenIt - Iterator over the text to write
+// - target - Coordinate targeted within output buffer
+// - wrap - change the wrap flag if we hit the end of the row while writing and there's still more data in the iterator.
+// Return Value:
+// - The iterator, but advanced to where we stopped writing. Use to find input consumed length or cells written length.
+TextCellIterator TextBuffer::WriteTextLine(const TextCellIterator givenIt,
+                                           const COORD target,
+                                           const std::optional<bool> wrap)
+{
+    return _WriteLine(givenIt, target, wrap, std::nullopt);
+}
+
+template<typename TIterator>
+TIterator TextBuffer::_WriteLine(const TIterator givenIt,
+                                 const COORD target,
+                                 const std::optional<bool> wrap,
+                                 const std::optional<size_t> limitRight)
 {
     // If we're not in bounds, exit early.
     if (!GetSize().IsInBounds(target))
@@ -381,7 +438,15 @@ OutputCellIterator TextBuffer::WriteLine(const OutputCellIterator givenIt,
 
     //  Get the row and write the cells
     ROW& row = GetRowByOffset(target.Y);
-    const auto newIt = row.WriteCells(givenIt, target.X, wrap, limitRight);
+    TIterator newIt = givenIt;
+    if constexpr (std::is_same_v<TIterator, TextCellIterator>)
+    {
+        newIt = row.WriteText(givenIt, target.X, wrap, limitRight);
+    }
+    else
+    {
+        newIt = row.WriteCells(givenIt, target.X, wrap, limitRight);
+    }
 
     // Take the cell distance written and notify that it needs to be repainted.
     const auto written = newIt.GetCellDistance(givenIt);
@@ -391,6 +456,145 @@ OutputCellIterator TextBuffer::WriteLine(const OutputCellIterator givenIt,
     return newIt;
 }
 
+// Routine Description:
+// - Writes the leading run of printable ASCII characters of the given text
+//   onto a single line of the output buffer, using a single attribute.
+//   Printable ASCII is always narrow, so unlike Write() and WriteLine() this
+//   doesn't need to go through an OutputCellIterator cell by cell and can
+//   copy the text into the row at once. This is the common case for most output.
+// Arguments:
+// - text - The text to write
+// - attr - The attribute to apply to all written cells
+// - target - Coordinate targeted within output buffer
+// - wrap - change the wrap flag if we hit the end of the row while writing
+// Return Value:
+// - The number of characters written. Writing stops at the first character that
+//   isn't printable ASCII, or at the end of the row. The caller is expected to
+//   write anything past that with Write() instead.
+size_t TextBuffer::WriteNarrowText(const std::wstring_view text,
+                                   const TextAttribute attr,
+                                   const COORD target,
+                                   const std::optional<bool> wrap)
+{
+    if (!GetSize().IsInBounds(target))
+    {
+        return 0;
+    }
+
+    const auto end = std::find_if(text.begin(), text.end(), [](const auto wch) noexcept {
+        return wch < L' ' || wch > L'~';
+    });
+    const auto narrowText = text.substr(0, gsl::narrow_cast<size_t>(end - text.begin()));
+    if (narrowText.empty())
+    {
+        return 0;
+    }
+
+    ROW& row = GetRowByOffset(target.Y);
+    const auto written = row.WriteNarrowText(narrowText, target.X, attr, wrap);
+
+    _NotifyPaint(Viewport::FromDimensions(target, { gsl::narrow<SHORT>(written), 1 }));
+
+    return written;
+}
+
+// Routine Description:
+// - Fills the output buffer with a single narrow glyph, starting at the given
+//   position and continuing onto the following lines, without changing any
+//   attributes. Like Write() with a fill OutputCellIterator for that glyph,
+//   but a whole line at a time.
+// Arguments:
+// - wch - The glyph to fill with. The caller must ensure that it's a narrow,
+//   non-surrogate character, for instance printable ASCII.
+// - count - The number of cells to fill
+// - target - Coordinate of the first cell to fill
+// - wrap - change the wrap flag of every line we fill up to its end
+// Return Value:
+// - The number of cells that were filled. This is less than count if the end
+//   of the buffer was reached.
+size_t TextBuffer::FillNarrowText(const wchar_t wch,
+                                  const size_t count,
+                                  const COORD target,
+                                  const std::optional<bool> wrap)
+{
+    const auto size = GetSize();
+    auto lineTarget = target;
+    size_t filled = 0;
+
+    while (filled < count && size.IsInBounds(lineTarget))
+    {
+        ROW& row = GetRowByOffset(lineTarget.Y);
+        const auto written = row.FillNarrowText(wch, lineTarget.X, count - filled, wrap);
+        _NotifyPaint(Viewport::FromDimensions(lineTarget, { gsl::narrow<SHORT>(written), 1 }));
+
+        filled += written;
+        lineTarget.X = 0;
+        ++lineTarget.Y;
+    }
+
+    return filled;
+}
+
+// Routine Description:
+// - Applies a single attribute to the output buffer, starting at the given
+//   position and continuing onto the following lines, without changing any
+//   text. Like Write() with a fill OutputCellIterator for that attribute,
+//   but with one run replacement per line.
+// Arguments:
+// - attr - The attribute to apply
+// - count - The number of cells to fill
+// - target - Coordinate of the first cell to fill
+// Return Value:
+// - The number of cells that were filled. This is less than count if the end
+//   of the buffer was reached.
+size_t TextBuffer::FillAttributes(const TextAttribute attr,
+                                  const size_t count,
+                                  const COORD target)
+{
+    const auto size = GetSize();
+    auto lineTarget = target;
+    size_t filled = 0;
+
+    while (filled < count && size.IsInBounds(lineTarget))
+    {
+        ROW& row = GetRowByOffset(lineTarget.Y);
+        const auto written = row.FillAttributes(attr, lineTarget.X, count - filled);
+        _NotifyPaint(Viewport::FromDimensions(lineTarget, { gsl::narrow<SHORT>(written), 1 }));
+
+        filled += written;
+        lineTarget.X = 0;
+        ++lineTarget.Y;
+    }
+
+    return filled;
+}
+
+// Routine Description:
+// - Writes legacy CHAR_INFO cells to the output buffer, like Write() does with
+//   an OutputCellIterator over them, but a whole line at a time.
+// Arguments:
+// - charInfos - The cells to write
+// - target - the row/column to start writing the cells to
+// Return Value:
+// - <none>
+void TextBuffer::WriteCharInfos(gsl::span<const CHAR_INFO> charInfos, const COORD target)
+{
+    const auto size = GetSize();
+    auto lineTarget = target;
+
+    while (!charInfos.empty() && size.IsInBounds(lineTarget))
+    {
+        ROW& row = GetRowByOffset(lineTarget.Y);
+        size_t cellsWritten = 0;
+        const auto written = row.WriteCharInfos(charInfos, lineTarget.X, cellsWritten);
+        _NotifyPaint(Viewport::FromDimensions(lineTarget, { gsl::narrow<SHORT>(cellsWritten), 1 }));
+
+        charInfos = charInfos.subspan(written);
+        lineTarget.X = 0;
+        ++lineTarget.Y;
+    }
+}
+
 //Routine Description:
 // - Inserts one codepoint into the buffer at the current cursor position and advances the cursor as appropriate.
 //Arguments:
@@ -555,11 +759,21 @@ bool TextBuffer::IncrementCircularBuffer(const bool inVtMode)
 {
     // FirstRow is at any given point in time the array index in the circular buffer that corresponds
     // to the logical position 0 in the window (cursor coordinates and all other coordinates).
-    _renderTarget.TriggerCircling();
+    _renderTarget->TriggerCircling();
 
     // Prune hyperlinks to delete obsolete references
     _PruneHyperlinks();
 
+    // The old "first row" is about to be lost, unless we can spill it to disk.
+    if (_scrollbackSpill)
+    {
+        try
+        {
+            _scrollbackSpill->Append(_storage.at(_firstRow));
+        }
+        CATCH_LOG();
+    }
+
     // Second, clean out the old "first row" as it will become the "last row" of the buffer after the circle is performed.
     auto fillAttributes = _currentAttributes;
     if (inVtMode)
@@ -580,6 +794,9 @@ bool TextBuffer::IncrementCircularBuffer(const bool inVtMode)
         {
             _firstRow = 0;
         }
+
+        _evictedRows++;
+        _commandTimeline.EraseBefore(_evictedRows);
     }
     return fSuccess;
 }
@@ -680,6 +897,34 @@ void TextBuffer::_SetFirstRowIndex(const SHORT FirstRowIndex) noexcept
     _firstRow = FirstRowIndex;
 }
 
+// Routine Description:
+// - Fills whole rows with spaces in the given attributes, which is what erasing
+//   them does. Unlike writing a run of spaces into them, this resets each row in one
+//   go, including its wrap flag. The line rendition of the rows is left unchanged.
+// Arguments:
+// - firstRow - The first row to erase.
+// - lastRow - The row after the last one to erase.
+// - attr - The attributes to fill the rows with.
+// Return Value:
+// - <none>
+void TextBuffer::EraseRows(const SHORT firstRow, const SHORT lastRow, const TextAttribute attr)
+{
+    if (firstRow >= lastRow)
+    {
+        return;
+    }
+
+    for (auto y = firstRow; y < lastRow; y++)
+    {
+        auto& row = GetRowByOffset(y);
+        const auto lineRendition = row.GetLineRendition();
+        row.Reset(attr);
+        row.SetLineRendition(lineRendition);
+    }
+
+    _NotifyPaint(Viewport::FromExclusive({ 0, firstRow, _size.Width(), lastRow }));
+}
+
 void TextBuffer::ScrollRows(const SHORT firstRow, const SHORT size, const SHORT delta)
 {
     // If we don't have to move anything, leave early.
@@ -688,18 +933,34 @@ void TextBuffer::ScrollRows(const SHORT firstRow, const SHORT size, const SHORT
         return;
     }
 
+    // These are the rows affected by the scroll: The ones being moved and the ones
+    // they're moved over, which end up on the other side of them.
+    // For instance, if delta is -2, size is 3 and firstRow is 5,
+    // then rows 5, 6 and 7 move up 2 spots into rows 3 and 4,
+    // so rows 3 to 7 (the range [3, 8)) are affected.
+    const auto top = gsl::narrow_cast<size_t>(firstRow + std::min<SHORT>(delta, 0));
+    const auto count = gsl::narrow_cast<size_t>(size + std::abs(delta));
+
     // OK. We're about to play games by moving rows around within the deque to
     // scroll a massive region in a faster way than copying things.
-    // To make this easier, first correct the circular buffer to have the first row be 0 again.
-    if (_firstRow != 0)
+    // The rows are stored circularly, so that as long as the affected rows are stored
+    // contiguously we only need to rotate them where they are. Otherwise, we first
+    // correct the circular buffer to have the first row be 0 again.
+    auto storageTop = (_firstRow + top) % _storage.size();
+    const auto normalize = storageTop + count > _storage.size();
+    if (normalize)
     {
         // Rotate the buffer to put the first row at the front.
         std::rotate(_storage.begin(), _storage.begin() + _firstRow, _storage.end());
 
         // The first row is now at the top.
         _firstRow = 0;
+        storageTop = top;
     }
 
+    const auto first = _storage.begin() + storageTop;
+    const auto last = first + count;
+
     // Rotate just the subsection specified
     if (delta < 0)
     {
@@ -710,12 +971,12 @@ void TextBuffer::ScrollRows(const SHORT firstRow, const SHORT size, const SHORT
         // | 0 begin
         // | 1
         // | 2
-        // | 3 A. begin + firstRow + delta (because delta is negative)
+        // | 3 A. first (firstRow + delta, because delta is negative)
         // | 4
-        // | 5 B. begin + firstRow
+        // | 5 B. first - delta (firstRow)
         // | 6
         // | 7
-        // | 8 C. begin + firstRow + size
+        // | 8 C. last (firstRow + size)
         // | 9
         // | 10
         // | 11
@@ -736,7 +997,7 @@ void TextBuffer::ScrollRows(const SHORT firstRow, const SHORT size, const SHORT
         // | 10
         // | 11
         // - end
-        std::rotate(_storage.begin() + firstRow + delta, _storage.begin() + firstRow, _storage.begin() + firstRow + size);
+        std::rotate(first, first - delta, last);
     }
     else
     {
@@ -749,12 +1010,12 @@ void TextBuffer::ScrollRows(const SHORT firstRow, const SHORT size, const SHORT
         // | 2
         // | 3
         // | 4
-        // | 5 A. begin + firstRow
+        // | 5 A. first (firstRow)
         // | 6
         // | 7
-        // | 8 B. begin + firstRow + size
+        // | 8 B. last - delta (firstRow + size)
         // | 9
-        // | 10 C. begin + firstRow + size + delta
+        // | 10 C. last (firstRow + size + delta)
         // | 11
         // - end
         // We want B-1 to slide down to C-1 (the positive delta) and everything from [A, B) to slide down with it.
@@ -773,12 +1034,24 @@ void TextBuffer::ScrollRows(const SHORT firstRow, const SHORT size, const SHORT
         // | 10
         // | 11
         // - end
-        std::rotate(_storage.begin() + firstRow, _storage.begin() + firstRow + size, _storage.begin() + firstRow + size + delta);
+        std::rotate(first, last - delta, last);
     }
 
     // Renumber the IDs now that we've rearranged where the rows sit within the buffer.
-    // Refreshing should also delegate to the UnicodeStorage to re-key all the stored unicode sequences (where applicable).
-    _RefreshRowIDs(std::nullopt);
+    // If the whole buffer was rotated above, all of them need to be updated,
+    // otherwise only the ones we just moved around.
+    if (normalize)
+    {
+        _RefreshRowIDs(std::nullopt);
+    }
+    else
+    {
+        for (auto it = first; it != last; ++it)
+        {
+            it->SetId(gsl::narrow_cast<SHORT>(it - _storage.begin()));
+            it->GetCharRow().UpdateParent(&*it);
+        }
+    }
 }
 
 Cursor& TextBuffer::GetCursor() noexcept
@@ -884,6 +1157,53 @@ void TextBuffer::Reset()
     {
         row.Reset(attr);
     }
+
+    _commandTimeline.Clear();
+}
+
+// Routine Description:
+// - Prepares a buffer that's no longer used to be used again, as if it had just been
+//   constructed with the given arguments. Its rows and their memory are kept and only reset,
+//   which is a lot cheaper than allocating a new buffer, for instance whenever an
+//   application enters the alternate screen buffer.
+// Arguments:
+// - screenBufferSize - the size of the buffer
+// - defaultAttributes - the attributes the rows are filled with
+// - cursorSize - the size of the cursor
+// - renderTarget - the render target of the buffer's new owner
+// Return Value:
+// - <none>
+void TextBuffer::Recycle(const COORD screenBufferSize,
+                         const TextAttribute defaultAttributes,
+                         const UINT cursorSize,
+                         Microsoft::Console::Render::IRenderTarget& renderTarget)
+{
+    _renderTarget = &renderTarget;
+
+    if (GetSize().Dimensions() != screenBufferSize)
+    {
+        THROW_IF_FAILED(ResizeTraditional(screenBufferSize));
+    }
+
+    // Every row is about to be blank, so their order doesn't matter anymore.
+    _SetFirstRowIndex(0);
+    _currentAttributes = defaultAttributes;
+    Reset();
+
+    const Cursor freshCursor{ cursorSize, *this };
+    _cursor.CopyProperties(freshCursor);
+    _cursor.SetSize(cursorSize);
+    _cursor.ResetDelayEOLWrap();
+    _cursor.SetPosition({ 0, 0 });
+
+    _hyperlinkMap.clear();
+    _hyperlinkCustomIdMap.clear();
+    _currentHyperlinkId = 1;
+    _freeHyperlinkIds.clear();
+    _nextHyperlinkSweep = MinimumHyperlinkSweep;
+    ClearPatternRecognizers();
+    _scrollbackSpill.reset();
+    _evictedRows = 0;
 }
 
 // Routine Description:
@@ -896,18 +1216,86 @@ void TextBuffer::Reset()
 {
     RETURN_HR_IF(E_INVALIDARG, newSize.X < 0 || newSize.Y < 0);
 
+    SHORT TopRow = 0; // new top row of the screen buffer
+    if (newSize.Y <= GetCursor().GetPosition().Y)
+    {
+        TopRow = GetCursor().GetPosition().Y - newSize.Y + 1;
+    }
+    return _ResizeTraditional(newSize, TopRow);
+}
+
+// Routine Description:
+// - Resizes the buffer in place, if that gives the same result as reflowing it into a new buffer of the
+//   given size with Reflow() would: when only the height changes, or when no row is wrapped and none
+//   would need to be. The rows (and their text and attributes) are kept instead of being copied into
+//   a freshly allocated buffer, which makes resizing large buffers a lot cheaper.
+// - Like Reflow(), this keeps the rows up to the last one with text or the cursor on it,
+//   dropping as many rows from the top as necessary.
+// Arguments:
+// - newSize - the new size of the buffer
+// Return Value:
+// - S_OK if the buffer was resized. S_FALSE if it needs to be reflowed into a new buffer instead.
+[[nodiscard]] HRESULT TextBuffer::TryReflowInPlace(const COORD newSize) noexcept
+try
+{
+    RETURN_HR_IF(E_INVALIDARG, newSize.X <= 0 || newSize.Y <= 0);
+
+    auto& cursor = GetCursor();
+    const auto cursorPosition = cursor.GetPosition();
+    const auto lastChar = GetLastNonSpaceCharacter();
+
+    if (newSize.X != GetSize().Width())
+    {
+        const auto newLineWidth = [&](const size_t row) -> size_t {
+            // Use shift right to quickly divide the width by 2 for double width lines, like GetLineWidth().
+            return gsl::narrow_cast<size_t>(newSize.X >> (IsDoubleWidthLine(row) ? 1 : 0));
+        };
+
+        if (gsl::narrow_cast<size_t>(cursorPosition.X) >= newLineWidth(cursorPosition.Y))
+        {
+            return S_FALSE;
+        }
+        for (SHORT y = 0; y <= lastChar.Y; ++y)
+        {
+            // Rows that fill their new width would already wrap into the next one.
+            const auto& row = GetRowByOffset(y);
+            if (row.WasWrapForced() || row.GetCharRow().MeasureRight() >= newLineWidth(y))
+            {
+                return S_FALSE;
+            }
+        }
+    }
+
+    const auto lastRow = std::max(cursorPosition.Y, lastChar.Y);
+    const auto topRow = gsl::narrow_cast<SHORT>(lastRow >= newSize.Y ? lastRow - newSize.Y + 1 : 0);
+    RETURN_IF_FAILED(_ResizeTraditional(newSize, topRow));
+
+    cursor.SetYPosition(cursorPosition.Y - topRow);
+    return S_OK;
+}
+CATCH_RETURN()
+
+// Routine Description:
+// - Resizes the buffer without reflowing it. The rows above the given top row are dropped.
+// Arguments:
+// - newSize - the new size of the buffer
+// - TopRow - the row that becomes the top row of the resized buffer
+// Return Value:
+// - S_OK if successful or an appropriate HRESULT otherwise.
+[[nodiscard]] HRESULT TextBuffer::_ResizeTraditional(const COORD newSize, const SHORT TopRow) noexcept
+{
     try
     {
         const auto currentSize = GetSize().Dimensions();
         const auto attributes = GetCurrentAttributes();
 
-        SHORT TopRow = 0; // new top row of the screen buffer
-        if (newSize.Y <= GetCursor().GetPosition().Y)
-        {
-            TopRow = GetCursor().GetPosition().Y - newSize.Y + 1;
-        }
         const SHORT TopRowIndex = (GetFirstRowIndex() + TopRow) % currentSize.Y;
 
+        // Allocate the text storage for the new size up front. The existing rows
+        // will be moved into it by _RefreshRowIDs, while we keep the old storage
+        // alive until they're done.
+        const auto oldCharRowStorage = std::exchange(_charRowStorage, CharRowStorage{ static_cast<size_t>(newSize.X), static_cast<size_t>(newSize.Y) });
+
         // rotate rows until the top row is at index 0
         for (int i = 0; i < TopRowIndex; i++)
         {
@@ -917,6 +1305,10 @@ void TextBuffer::Reset()
 
         _SetFirstRowIndex(0);
 
+        // The rows above the new top row are gone, just like when the buffer circles.
+        _evictedRows += TopRow;
+        _commandTimeline.EraseBefore(_evictedRows);
+
         // realloc in the Y direction
         // remove rows if we're shrinking
         while (_storage.size() > static_cast<size_t>(newSize.Y))
@@ -926,12 +1318,13 @@ void TextBuffer::Reset()
         // add rows if we're growing
         while (_storage.size() < static_cast<size_t>(newSize.Y))
         {
-            _storage.emplace_back(static_cast<short>(_storage.size()), newSize.X, attributes, this);
+            const auto i = _storage.size();
+            _storage.emplace_back(static_cast<short>(i), _charRowStorage.Chars(i), _charRowStorage.DbcsAttrs(i), attributes, &_attrRowPool, this);
         }
 
         // Now that we've tampered with the row placement, refresh all the row IDs.
         // Also take advantage of the row ID refresh loop to resize the rows in the X dimension
-        // and cleanup the UnicodeStorage characters that might fall outside the resized buffer.
+        // which also drops the UnicodeStorage characters that fall outside the resized buffer.
         _RefreshRowIDs(newSize.X);
 
         // Update the cached size value
@@ -942,55 +1335,46 @@ void TextBuffer::Reset()
     return S_OK;
 }
 
-const UnicodeStorage& TextBuffer::GetUnicodeStorage() const noexcept
-{
-    return _unicodeStorage;
-}
-
-UnicodeStorage& TextBuffer::GetUnicodeStorage() noexcept
-{
-    return _unicodeStorage;
-}
-
 // Routine Description:
 // - Method to help refresh all the Row IDs after manipulating the row
 //   by shuffling pointers around.
 // - This will also update parent pointers that are stored in depth within the buffer
 //   (e.g. it will update CharRow parents pointing at Rows that might have been moved around)
-// - Optionally takes a new row width if we're resizing to perform a resize operation and cleanup
-//   any high unicode (UnicodeStorage) runs while we're already looping through the rows.
+// - Optionally takes a new row width if we're resizing to perform a resize operation
+//   while we're already looping through the rows. The rows' UnicodeStorage moves along with them.
 // Arguments:
 // - newRowWidth - Optional new value for the row width.
 void TextBuffer::_RefreshRowIDs(std::optional<SHORT> newRowWidth)
 {
-    std::unordered_map<SHORT, SHORT> rowMap;
+    HRESULT resizeResult = S_OK;
     SHORT i = 0;
     for (auto& it : _storage)
     {
-        // Build a map so we can update Unicode Storage
-        rowMap.emplace(it.GetId(), i);
+        // Resize the rows in the X dimension if we have a new width
+        if (newRowWidth.has_value())
+        {
+            // Move the row into its slice of the (already resized) text storage.
+            // We must do this for every row, even if one of them fails,
+            // as the caller is about to free the old storage.
+            const auto hr = it.Resize(_charRowStorage.Chars(i), _charRowStorage.DbcsAttrs(i));
+            if (SUCCEEDED(resizeResult))
+            {
+                resizeResult = hr;
+            }
+        }
 
         // Update the IDs
         it.SetId(i++);
 
         // Also update the char row parent pointers as they can get shuffled up in the rotates.
         it.GetCharRow().UpdateParent(&it);
-
-        // Resize the rows in the X dimension if we have a new width
-        if (newRowWidth.has_value())
-        {
-            // Realloc in the X direction
-            THROW_IF_FAILED(it.Resize(newRowWidth.value()));
-        }
     }
-
-    // Give the new mapping to Unicode Storage
-    _unicodeStorage.Remap(rowMap, newRowWidth);
+    THROW_IF_FAILED(resizeResult);
 }
 
 void TextBuffer::_NotifyPaint(const Viewport& viewport) const
 {
-    _renderTarget.TriggerRedraw(viewport);
+    _renderTarget->TriggerRedraw(viewport);
 }
 
 // Routine Description:
@@ -1033,7 +1417,7 @@ ROW& TextBuffer::_GetPrevRowNoWrap(const ROW& Row)
 // - This buffer's current render target.
 Microsoft::Console::Render::IRenderTarget& TextBuffer::GetRenderTarget() noexcept
 {
-    return _renderTarget;
+    return *_renderTarget;
 }
 
 // Method Description:
@@ -1041,12 +1425,12 @@ Microsoft::Console::Render::IRenderTarget& TextBuffer::GetRenderTarget() noexcep
 // - used for double click selection and uia word navigation
 // Arguments:
 // - pos: the buffer cell under observation
-// - wordDelimiters: the delimiters defined as a part of the DelimiterClass::DelimiterChar
+// - classifier: sorts characters into word and non-word (delimiter/control) ones
 // Return Value:
 // - the delimiter class for the given char
-const DelimiterClass TextBuffer::_GetDelimiterClassAt(const COORD pos, const std::wstring_view wordDelimiters) const
+const DelimiterClass TextBuffer::_GetDelimiterClassAt(const COORD pos, const DelimiterClassifier& classifier) const
 {
-    return GetRowByOffset(pos.Y).GetCharRow().DelimiterClassAt(pos.X, wordDelimiters);
+    return GetRowByOffset(pos.Y).GetCharRow().DelimiterClassAt(pos.X, classifier);
 }
 
 // Method Description:
@@ -1089,11 +1473,11 @@ const COORD TextBuffer::GetWordStart(const COORD target, const std::wstring_view
 
     if (accessibilityMode)
     {
-        return _GetWordStartForAccessibility(copy, wordDelimiters);
+        return _GetWordStartForAccessibility(copy, DelimiterClassifier{ wordDelimiters });
     }
     else
     {
-        return _GetWordStartForSelection(copy, wordDelimiters);
+        return _GetWordStartForSelection(copy, DelimiterClassifier{ wordDelimiters });
     }
 }
 
@@ -1101,17 +1485,17 @@ const COORD TextBuffer::GetWordStart(const COORD target, const std::wstring_view
 // - Helper method for GetWordStart(). Get the COORD for the beginning of the word (accessibility definition) you are on
 // Arguments:
 // - target - a COORD on the word you are currently on
-// - wordDelimiters - what characters are we considering for the separation of words
+// - classifier - sorts characters into word and non-word (delimiter/control) ones
 // Return Value:
 // - The COORD for the first character on the current/previous READABLE "word" (inclusive)
-const COORD TextBuffer::_GetWordStartForAccessibility(const COORD target, const std::wstring_view wordDelimiters) const
+const COORD TextBuffer::_GetWordStartForAccessibility(const COORD target, const DelimiterClassifier& classifier) const
 {
     COORD result = target;
     const auto bufferSize = GetSize();
     bool stayAtOrigin = false;
 
     // ignore left boundary. Continue until readable text found
-    while (_GetDelimiterClassAt(result, wordDelimiters) != DelimiterClass::RegularChar)
+    while (_GetDelimiterClassAt(result, classifier) != DelimiterClass::RegularChar)
     {
         if (!bufferSize.DecrementInBounds(result))
         {
@@ -1123,7 +1507,7 @@ const COORD TextBuffer::_GetWordStartForAccessibility(const COORD target, const
     }
 
     // make sure we expand to the left boundary or the beginning of the word
-    while (_GetDelimiterClassAt(result, wordDelimiters) == DelimiterClass::RegularChar)
+    while (_GetDelimiterClassAt(result, classifier) == DelimiterClass::RegularChar)
     {
         if (!bufferSize.DecrementInBounds(result))
         {
@@ -1134,7 +1518,7 @@ const COORD TextBuffer::_GetWordStartForAccessibility(const COORD target, const
     }
 
     // move off of delimiter and onto word start
-    if (!stayAtOrigin && _GetDelimiterClassAt(result, wordDelimiters) != DelimiterClass::RegularChar)
+    if (!stayAtOrigin && _GetDelimiterClassAt(result, classifier) != DelimiterClass::RegularChar)
     {
         bufferSize.IncrementInBounds(result);
     }
@@ -1146,23 +1530,23 @@ const COORD TextBuffer::_GetWordStartForAccessibility(const COORD target, const
 // - Helper method for GetWordStart(). Get the COORD for the beginning of the word (selection definition) you are on
 // Arguments:
 // - target - a COORD on the word you are currently on
-// - wordDelimiters - what characters are we considering for the separation of words
+// - classifier - sorts characters into word and non-word (delimiter/control) ones
 // Return Value:
 // - The COORD for the first character on the current word or delimiter run (stopped by the left margin)
-const COORD TextBuffer::_GetWordStartForSelection(const COORD target, const std::wstring_view wordDelimiters) const
+const COORD TextBuffer::_GetWordStartForSelection(const COORD target, const DelimiterClassifier& classifier) const
 {
     COORD result = target;
     const auto bufferSize = GetSize();
 
-    const auto initialDelimiter = _GetDelimiterClassAt(result, wordDelimiters);
+    const auto initialDelimiter = _GetDelimiterClassAt(result, classifier);
 
     // expand left until we hit the left boundary or a different delimiter class
-    while (result.X > bufferSize.Left() && (_GetDelimiterClassAt(result, wordDelimiters) == initialDelimiter))
+    while (result.X > bufferSize.Left() && (_GetDelimiterClassAt(result, classifier) == initialDelimiter))
     {
         bufferSize.DecrementInBounds(result);
     }
 
-    if (_GetDelimiterClassAt(result, wordDelimiters) != initialDelimiter)
+    if (_GetDelimiterClassAt(result, classifier) != initialDelimiter)
     {
         // move off of delimiter
         bufferSize.IncrementInBounds(result);
@@ -1202,11 +1586,11 @@ const COORD TextBuffer::GetWordEnd(const COORD target, const std::wstring_view w
     if (accessibilityMode)
     {
         const auto lastCharPos{ GetLastNonSpaceCharacter() };
-        return _GetWordEndForAccessibility(target, wordDelimiters, lastCharPos);
+        return _GetWordEndForAccessibility(target, DelimiterClassifier{ wordDelimiters }, lastCharPos);
     }
     else
     {
-        return _GetWordEndForSelection(target, wordDelimiters);
+        return _GetWordEndForSelection(target, DelimiterClassifier{ wordDelimiters });
     }
 }
 
@@ -1214,11 +1598,11 @@ const COORD TextBuffer::GetWordEnd(const COORD target, const std::wstring_view w
 // - Helper method for GetWordEnd(). Get the COORD for the beginning of the next READABLE word
 // Arguments:
 // - target - a COORD on the word you are currently on
-// - wordDelimiters - what characters are we considering for the separation of words
+// - classifier - sorts characters into word and non-word (delimiter/control) ones
 // - lastCharPos - the position of the last nonspace character in the text buffer (to improve performance)
 // Return Value:
 // - The COORD for the first character of the next readable "word". If no next word, return one past the end of the buffer
-const COORD TextBuffer::_GetWordEndForAccessibility(const COORD target, const std::wstring_view wordDelimiters, const COORD lastCharPos) const
+const COORD TextBuffer::_GetWordEndForAccessibility(const COORD target, const DelimiterClassifier& classifier, const COORD lastCharPos) const
 {
     const auto bufferSize = GetSize();
     COORD result = target;
@@ -1230,7 +1614,7 @@ const COORD TextBuffer::_GetWordEndForAccessibility(const COORD target, const st
     }
 
     // ignore right boundary. Continue through readable text found
-    while (_GetDelimiterClassAt(result, wordDelimiters) == DelimiterClass::RegularChar)
+    while (_GetDelimiterClassAt(result, classifier) == DelimiterClass::RegularChar)
     {
         if (!bufferSize.IncrementInBounds(result, true))
         {
@@ -1245,7 +1629,7 @@ const COORD TextBuffer::_GetWordEndForAccessibility(const COORD target, const st
     }
 
     // make sure we expand to the beginning of the NEXT word
-    while (_GetDelimiterClassAt(result, wordDelimiters) != DelimiterClass::RegularChar)
+    while (_GetDelimiterClassAt(result, classifier) != DelimiterClass::RegularChar)
     {
         if (!bufferSize.IncrementInBounds(result, true))
         {
@@ -1263,10 +1647,10 @@ const COORD TextBuffer::_GetWordEndForAccessibility(const COORD target, const st
 // - Helper method for GetWordEnd(). Get the COORD for the beginning of the NEXT word
 // Arguments:
 // - target - a COORD on the word you are currently on
-// - wordDelimiters - what characters are we considering for the separation of words
+// - classifier - sorts characters into word and non-word (delimiter/control) ones
 // Return Value:
 // - The COORD for the last character of the current word or delimiter run (stopped by right margin)
-const COORD TextBuffer::_GetWordEndForSelection(const COORD target, const std::wstring_view wordDelimiters) const
+const COORD TextBuffer::_GetWordEndForSelection(const COORD target, const DelimiterClassifier& classifier) const
 {
     const auto bufferSize = GetSize();
 
@@ -1277,15 +1661,15 @@ const COORD TextBuffer::_GetWordEndForSelection(const COORD target, const std::w
     }
 
     COORD result = target;
-    const auto initialDelimiter = _GetDelimiterClassAt(result, wordDelimiters);
+    const auto initialDelimiter = _GetDelimiterClassAt(result, classifier);
 
     // expand right until we hit the right boundary or a different delimiter class
-    while (result.X < bufferSize.RightInclusive() && (_GetDelimiterClassAt(result, wordDelimiters) == initialDelimiter))
+    while (result.X < bufferSize.RightInclusive() && (_GetDelimiterClassAt(result, classifier) == initialDelimiter))
     {
         bufferSize.IncrementInBounds(result);
     }
 
-    if (_GetDelimiterClassAt(result, wordDelimiters) != initialDelimiter)
+    if (_GetDelimiterClassAt(result, classifier) != initialDelimiter)
     {
         // move off of delimiter
         bufferSize.DecrementInBounds(result);
@@ -1309,6 +1693,8 @@ void TextBuffer::_PruneHyperlinks()
         // Only make it an unordered set now because set always heap allocates but vector
         // doesn't when the set is empty (saving an allocation in the common case of no links.)
         std::unordered_set<uint16_t> firstRowRefs{ hyperlinks.cbegin(), hyperlinks.cend() };
+        // The link that's currently being written may not have made it into any other row yet.
+        firstRowRefs.erase(_currentAttributes.GetHyperlinkId());
 
         const auto total = TotalRowCount();
         // Loop through all the rows in the buffer except the first row -
@@ -1354,7 +1740,7 @@ bool TextBuffer::MoveToNextWord(COORD& pos, const std::wstring_view wordDelimite
     // move to the beginning of the next word
     // NOTE: _GetWordEnd...() returns the exclusive position of the "end of the word"
     //       This is also the inclusive start of the next word.
-    auto copy{ _GetWordEndForAccessibility(pos, wordDelimiters, lastCharPos) };
+    auto copy{ _GetWordEndForAccessibility(pos, DelimiterClassifier{ wordDelimiters }, lastCharPos) };
 
     if (copy == GetSize().EndExclusive())
     {
@@ -1560,9 +1946,13 @@ void TextBuffer::_ExpandTextRow(SMALL_RECT& textRow) const
 {
     const auto bufferSize = GetSize();
 
+    // Look at the row's DBCS attributes directly. Creating a cell iterator
+    // for the two edges of every row adds up on tall block selections.
+    const auto& charRow = GetRowByOffset(textRow.Top).GetCharRow();
+
     // expand left side of rect
     COORD targetPoint{ textRow.Left, textRow.Top };
-    if (GetCellDataAt(targetPoint)->DbcsAttr().IsTrailing())
+    if (charRow.DbcsAttrAt(textRow.Left).IsTrailing())
     {
         if (targetPoint.X == bufferSize.Left())
         {
@@ -1577,7 +1967,7 @@ void TextBuffer::_ExpandTextRow(SMALL_RECT& textRow) const
 
     // expand right side of rect
     targetPoint = { textRow.Right, textRow.Bottom };
-    if (GetCellDataAt(targetPoint)->DbcsAttr().IsLeading())
+    if (charRow.DbcsAttrAt(textRow.Right).IsLeading())
     {
         if (targetPoint.X == bufferSize.RightInclusive())
         {
@@ -1615,8 +2005,7 @@ const TextBuffer::TextAndColor TextBuffer::GetText(const bool includeCRLF,
     data.text.reserve(rows);
     if (copyTextColor)
     {
-        data.FgAttr.reserve(rows);
-        data.BkAttr.reserve(rows);
+        data.ColorRuns.reserve(rows);
     }
 
     // for each row in the selection
@@ -1626,51 +2015,59 @@ const TextBuffer::TextAndColor TextBuffer::GetText(const bool includeCRLF,
 
         const Viewport highlight = Viewport::FromInclusive(selectionRects.at(i));
 
-        // retrieve the data from the screen buffer
-        auto it = GetCellDataAt(highlight.Origin(), highlight);
-
         // allocate a string buffer
         std::wstring selectionText;
-        std::vector<COLORREF> selectionFgAttr;
-        std::vector<COLORREF> selectionBkAttr;
+        std::vector<TextAndColor::ColorRun> selectionColorRuns;
+        std::optional<TextAttribute> lastAttr;
 
         // preallocate to avoid reallocs
         selectionText.reserve(gsl::narrow<size_t>(highlight.Width()) + 2); // + 2 for \r\n if we munged it
-        if (copyTextColor)
+
+        // We apply formatting to rows if the row was NOT wrapped or formatting of wrapped rows is allowed
+        const bool shouldFormatRow = formatWrappedRows || !GetRowByOffset(iRow).WasWrapForced();
+
+        if (!copyTextColor)
         {
-            selectionFgAttr.reserve(gsl::narrow<size_t>(highlight.Width()) + 2);
-            selectionBkAttr.reserve(gsl::narrow<size_t>(highlight.Width()) + 2);
+            // Without colors, the text can be sliced right out of the row,
+            // instead of walking it cell by cell. If the trailing whitespace
+            // is going to be trimmed anyways, we can stop where the text ends.
+            const auto& row = GetRowByOffset(iRow);
+            auto right = gsl::narrow_cast<size_t>(highlight.RightExclusive());
+            if (trimTrailingWhitespace && shouldFormatRow)
+            {
+                right = std::min(right, row.GetCharRow().MeasureRight());
+            }
+            row.AppendText(selectionText, gsl::narrow_cast<size_t>(highlight.Left()), right);
         }
-
-        // copy char data into the string buffer, skipping trailing bytes
-        while (it)
+        else
         {
-            const auto& cell = *it;
-
-            if (!cell.DbcsAttr().IsTrailing())
+            // Walk the row one attribute run at a time. The text of a run is
+            // sliced right out of the row, skipping the trailing halves of
+            // wide glyphs, and its colors are only looked up once.
+            const auto& row = GetRowByOffset(iRow);
+            for (TextBufferRunIterator run{ row, gsl::narrow_cast<size_t>(highlight.Left()), gsl::narrow_cast<size_t>(highlight.RightExclusive()) }; run; ++run)
             {
-                const auto chars = cell.Chars();
-                selectionText.append(chars);
+                const auto length = selectionText.size();
+                run.AppendText(selectionText);
+                if (selectionText.size() == length)
+                {
+                    // The run only held the trailing half of a wide glyph.
+                    continue;
+                }
 
-                if (copyTextColor)
+                // Only map the attribute to colors when it changes,
+                // and otherwise just extend the current color run.
+                const auto& attr = run.TextAttr();
+                if (lastAttr != attr)
                 {
-                    const auto cellData = cell.TextAttr();
-                    const auto [CellFgAttr, CellBkAttr] = GetAttributeColors(cellData);
-                    for (size_t j = 0; j < chars.size(); ++j)
-                    {
-                        selectionFgAttr.push_back(CellFgAttr);
-                        selectionBkAttr.push_back(CellBkAttr);
-                    }
+                    const auto [CellFgAttr, CellBkAttr] = GetAttributeColors(attr);
+                    selectionColorRuns.push_back({ CellFgAttr, CellBkAttr, 0 });
+                    lastAttr = attr;
                 }
+                selectionColorRuns.back().length += selectionText.size() - length;
             }
-#pragma warning(suppress : 26444)
-            // TODO GH 2675: figure out why there's custom construction/destruction happening here
-            it++;
         }
 
-        // We apply formatting to rows if the row was NOT wrapped or formatting of wrapped rows is allowed
-        const bool shouldFormatRow = formatWrappedRows || !GetRowByOffset(iRow).WasWrapForced();
-
         if (trimTrailingWhitespace)
         {
             if (shouldFormatRow)
@@ -1679,10 +2076,9 @@ const TextBuffer::TextAndColor TextBuffer::GetText(const bool includeCRLF,
                 while (!selectionText.empty() && selectionText.back() == UNICODE_SPACE)
                 {
                     selectionText.pop_back();
-                    if (copyTextColor)
+                    if (copyTextColor && --selectionColorRuns.back().length == 0)
                     {
-                        selectionFgAttr.pop_back();
-                        selectionBkAttr.pop_back();
+                        selectionColorRuns.pop_back();
                     }
                 }
             }
@@ -1702,10 +2098,7 @@ const TextBuffer::TextAndColor TextBuffer::GetText(const bool includeCRLF,
                 {
                     // cant see CR/LF so just use black FG & BK
                     COLORREF const Blackness = RGB(0x00, 0x00, 0x00);
-                    selectionFgAttr.push_back(Blackness);
-                    selectionFgAttr.push_back(Blackness);
-                    selectionBkAttr.push_back(Blackness);
-                    selectionBkAttr.push_back(Blackness);
+                    selectionColorRuns.push_back({ Blackness, Blackness, 2 });
                 }
             }
         }
@@ -1713,8 +2106,7 @@ const TextBuffer::TextAndColor TextBuffer::GetText(const bool includeCRLF,
         data.text.emplace_back(std::move(selectionText));
         if (copyTextColor)
         {
-            data.FgAttr.emplace_back(std::move(selectionFgAttr));
-            data.BkAttr.emplace_back(std::move(selectionBkAttr));
+            data.ColorRuns.emplace_back(std::move(selectionColorRuns));
         }
     }
 
@@ -1783,65 +2175,29 @@ std::string TextBuffer::GenHTML(const TextAndColor& rows,
         std::optional<COLORREF> bkColor = std::nullopt;
         for (size_t row = 0; row < rows.text.size(); row++)
         {
-            size_t startOffset = 0;
-
             if (row != 0)
             {
                 htmlBuilder << "<BR>";
             }
 
-            for (size_t col = 0; col < rows.text.at(row).length(); col++)
-            {
-                const auto writeAccumulatedChars = [&](bool includeCurrent) {
-                    if (col >= startOffset)
-                    {
-                        const auto unescapedText = ConvertToA(CP_UTF8, std::wstring_view(rows.text.at(row)).substr(startOffset, col - startOffset + includeCurrent));
-                        for (const auto c : unescapedText)
-                        {
-                            switch (c)
-                            {
-                            case '<':
-                                htmlBuilder << "&lt;";
-                                break;
-                            case '>':
-                                htmlBuilder << "&gt;";
-                                break;
-                            case '&':
-                                htmlBuilder << "&amp;";
-                                break;
-                            default:
-                                htmlBuilder << c;
-                            }
-                        }
-
-                        startOffset = col;
-                    }
-                };
+            // do not include \r nor \n as they don't have color attributes
+            // and are not HTML friendly. For line break use '<BR>' instead.
+            const std::wstring_view rowText{ rows.text.at(row) };
+            const auto textLength = std::min(rowText.find_first_of(L"\r\n"), rowText.size());
 
-                if (rows.text.at(row).at(col) == '\r' || rows.text.at(row).at(col) == '\n')
+            size_t col = 0;
+            for (const auto& run : rows.ColorRuns.at(row))
+            {
+                if (col >= textLength)
                 {
-                    // do not include \r nor \n as they don't have color attributes
-                    // and are not HTML friendly. For line break use '<BR>' instead.
-                    writeAccumulatedChars(false);
                     break;
                 }
 
-                bool colorChanged = false;
-                if (!fgColor.has_value() || rows.FgAttr.at(row).at(col) != fgColor.value())
+                if (!fgColor.has_value() || run.fg != fgColor.value() ||
+                    !bkColor.has_value() || run.bk != bkColor.value())
                 {
-                    fgColor = rows.FgAttr.at(row).at(col);
-                    colorChanged = true;
-                }
-
-                if (!bkColor.has_value() || rows.BkAttr.at(row).at(col) != bkColor.value())
-                {
-                    bkColor = rows.BkAttr.at(row).at(col);
-                    colorChanged = true;
-                }
-
-                if (colorChanged)
-                {
-                    writeAccumulatedChars(false);
+                    fgColor = run.fg;
+                    bkColor = run.bk;
 
                     if (hasWrittenAnyText)
                     {
@@ -1860,11 +2216,26 @@ std::string TextBuffer::GenHTML(const TextAndColor& rows,
 
                 hasWrittenAnyText = true;
 
-                // if this is the last character in the row, flush the whole row
-                if (col == rows.text.at(row).length() - 1)
+                const auto length = std::min(run.length, textLength - col);
+                const auto unescapedText = ConvertToA(CP_UTF8, rowText.substr(col, length));
+                for (const auto c : unescapedText)
                 {
-                    writeAccumulatedChars(true);
+                    switch (c)
+                    {
+                    case '<':
+                        htmlBuilder << "&lt;";
+                        break;
+                    case '>':
+                        htmlBuilder << "&gt;";
+                        break;
+                    case '&':
+                        htmlBuilder << "&amp;";
+                        break;
+                    default:
+                        htmlBuilder << c;
+                    }
                 }
+                col += length;
             }
         }
 
@@ -1971,61 +2342,29 @@ std::string TextBuffer::GenRTF(const TextAndColor& rows, const int fontHeightPoi
         std::optional<COLORREF> bkColor = std::nullopt;
         for (size_t row = 0; row < rows.text.size(); ++row)
         {
-            size_t startOffset = 0;
-
             if (row != 0)
             {
                 contentBuilder << "\\line "; // new line
             }
 
-            for (size_t col = 0; col < rows.text.at(row).length(); ++col)
-            {
-                const auto writeAccumulatedChars = [&](bool includeCurrent) {
-                    if (col >= startOffset)
-                    {
-                        const auto unescapedText = ConvertToA(CP_UTF8, std::wstring_view(rows.text.at(row)).substr(startOffset, col - startOffset + includeCurrent));
-                        for (const auto c : unescapedText)
-                        {
-                            switch (c)
-                            {
-                            case '\\':
-                            case '{':
-                            case '}':
-                                contentBuilder << "\\" << c;
-                                break;
-                            default:
-                                contentBuilder << c;
-                            }
-                        }
-
-                        startOffset = col;
-                    }
-                };
+            // do not include \r nor \n as they don't have color attributes.
+            // For line break use \line instead.
+            const std::wstring_view rowText{ rows.text.at(row) };
+            const auto textLength = std::min(rowText.find_first_of(L"\r\n"), rowText.size());
 
-                if (rows.text.at(row).at(col) == '\r' || rows.text.at(row).at(col) == '\n')
+            size_t col = 0;
+            for (const auto& run : rows.ColorRuns.at(row))
+            {
+                if (col >= textLength)
                 {
-                    // do not include \r nor \n as they don't have color attributes.
-                    // For line break use \line instead.
-                    writeAccumulatedChars(false);
                     break;
                 }
 
-                bool colorChanged = false;
-                if (!fgColor.has_value() || rows.FgAttr.at(row).at(col) != fgColor.value())
+                if (!fgColor.has_value() || run.fg != fgColor.value() ||
+                    !bkColor.has_value() || run.bk != bkColor.value())
                 {
-                    fgColor = rows.FgAttr.at(row).at(col);
-                    colorChanged = true;
-                }
-
-                if (!bkColor.has_value() || rows.BkAttr.at(row).at(col) != bkColor.value())
-                {
-                    bkColor = rows.BkAttr.at(row).at(col);
-                    colorChanged = true;
-                }
-
-                if (colorChanged)
-                {
-                    writeAccumulatedChars(false);
+                    fgColor = run.fg;
+                    bkColor = run.bk;
 
                     int bkColorIndex = 0;
                     if (colorMap.find(bkColor.value()) != colorMap.end())
@@ -2066,11 +2405,22 @@ std::string TextBuffer::GenRTF(const TextAndColor& rows, const int fontHeightPoi
                                    << " ";
                 }
 
-                // if this is the last character in the row, flush the whole row
-                if (col == rows.text.at(row).length() - 1)
+                const auto length = std::min(run.length, textLength - col);
+                const auto unescapedText = ConvertToA(CP_UTF8, rowText.substr(col, length));
+                for (const auto c : unescapedText)
                 {
-                    writeAccumulatedChars(true);
+                    switch (c)
+                    {
+                    case '\\':
+                    case '{':
+                    case '}':
+                        contentBuilder << "\\" << c;
+                        break;
+                    default:
+                        contentBuilder << c;
+                    }
                 }
+                col += length;
             }
         }
 
@@ -2132,6 +2482,33 @@ HRESULT TextBuffer::Reflow(TextBuffer& oldBuffer,
     bool foundOldMutable = false;
     bool foundOldVisible = false;
     HRESULT hr = S_OK;
+
+    // Measuring the "right" (one past the last printable character) of a row
+    // whose right edge isn't cached requires scanning it from the end. The old
+    // buffer is only read from here on, so do that for all rows up front and
+    // in parallel (every row caches its own edge, so they don't interfere). Large buffers
+    // consist mostly of rows of this kind of independent work, while pouring
+    // the text into the new buffer below has to happen in order.
+    std::vector<short> oldRights;
+    try
+    {
+        oldRights.resize(std::max<short>(cOldRowsTotal, 0));
+        std::for_each(std::execution::par, oldRights.begin(), oldRights.end(), [&](short& right) {
+            const auto iOldRow = gsl::narrow_cast<size_t>(&right - oldRights.data());
+            right = gsl::narrow_cast<short>(oldBuffer.GetRowByOffset(iOldRow).GetCharRow().MeasureRight());
+        });
+    }
+    CATCH_RETURN();
+
+    // Where each old row starts in the new buffer, as an absolute position
+    // (see _evictedRows), so that the shell integration marks can follow it.
+    std::vector<til::point> newRowStarts;
+    try
+    {
+        newRowStarts.reserve(oldRights.size());
+    }
+    CATCH_RETURN();
+
     // Loop through all the rows of the old buffer and reprint them into the new buffer
     for (short iOldRow = 0; iOldRow < cOldRowsTotal; iOldRow++)
     {
@@ -2139,11 +2516,12 @@ HRESULT TextBuffer::Reflow(TextBuffer& oldBuffer,
         const ROW& row = oldBuffer.GetRowByOffset(iOldRow);
         const short cOldColsTotal = oldBuffer.GetLineWidth(iOldRow);
         const CharRow& charRow = row.GetCharRow();
-        short iRight = gsl::narrow_cast<short>(charRow.MeasureRight());
+        short iRight = til::at(oldRights, iOldRow);
 
         // If we're starting a new row, try and preserve the line rendition
         // from the row in the original buffer.
         const auto newBufferPos = newBuffer.GetCursor().GetPosition();
+        newRowStarts.emplace_back(newBufferPos.X, newBufferPos.Y + newBuffer._evictedRows);
         if (newBufferPos.X == 0)
         {
             auto& newRow = newBuffer.GetRowByOffset(newBufferPos.Y);
@@ -2174,31 +2552,80 @@ HRESULT TextBuffer::Reflow(TextBuffer& oldBuffer,
             }
         }
 
-        // Loop through every character in the current row (up to
-        // the "right" boundary, which is one past the final valid
-        // character)
-        for (short iOldCol = 0; iOldCol < iRight; iOldCol++)
+        // Most rows start at the beginning of a new row and fit into it
+        // without wrapping, for instance when only the height of the buffer
+        // changes or the buffer grows wider. Such rows don't need to be poured
+        // character by character through InsertCharacter(): copy their cells
+        // and attribute runs over directly and place the cursor after them.
+        if (newBufferPos.X == 0 && iRight < newBuffer.GetLineWidth(newBufferPos.Y))
         {
-            if (iOldCol == cOldCursorPos.X && iOldRow == cOldCursorPos.Y)
+            if (iOldRow == cOldCursorPos.Y && cOldCursorPos.X < iRight)
             {
-                cNewCursorPos = newCursor.GetPosition();
+                cNewCursorPos = { cOldCursorPos.X, newBufferPos.Y };
                 fFoundCursorPos = true;
             }
 
             try
             {
-                // TODO: MSFT: 19446208 - this should just use an iterator and the inserter...
-                const auto glyph = row.GetCharRow().GlyphAt(iOldCol);
-                const auto dbcsAttr = row.GetCharRow().DbcsAttrAt(iOldCol);
-                const auto textAttr = row.GetAttrRow().GetAttrByColumn(iOldCol);
+                auto& newRow = newBuffer.GetRowByOffset(newBufferPos.Y);
+                auto& newCharRow = newRow.GetCharRow();
+                auto& newAttrRow = newRow.GetAttrRow();
+                auto attrIt = row.GetAttrRow().cbegin();
+                std::optional<TextAttribute> lastAttr;
 
-                if (!newBuffer.InsertCharacter(glyph, dbcsAttr, textAttr))
+                for (short iOldCol = 0; iOldCol < iRight; iOldCol++, ++attrIt)
                 {
-                    hr = E_OUTOFMEMORY;
-                    break;
+                    newCharRow.GlyphAt(iOldCol) = static_cast<std::wstring_view>(charRow.GlyphAt(iOldCol));
+                    newCharRow.DbcsAttrAt(iOldCol) = charRow.DbcsAttrAt(iOldCol);
+
+                    // Just like InsertCharacter(), the attribute of the last
+                    // copied cell extends to the end of the new row.
+                    if (lastAttr != *attrIt)
+                    {
+                        lastAttr = *attrIt;
+                        if (!newAttrRow.SetAttrToEnd(iOldCol, *lastAttr))
+                        {
+                            hr = E_OUTOFMEMORY;
+                            break;
+                        }
+                    }
                 }
             }
             CATCH_RETURN();
+
+            newCursor.SetXPosition(iRight);
+        }
+        else
+        {
+            // Loop through every character in the current row (up to
+            // the "right" boundary, which is one past the final valid
+            // character)
+            // The attributes are walked with an iterator: looking each column up with
+            // GetAttrByColumn() scans the runs from the start of the row every time.
+            auto attrIt = row.GetAttrRow().cbegin();
+            for (short iOldCol = 0; iOldCol < iRight; iOldCol++, ++attrIt)
+            {
+                if (iOldCol == cOldCursorPos.X && iOldRow == cOldCursorPos.Y)
+                {
+                    cNewCursorPos = newCursor.GetPosition();
+                    fFoundCursorPos = true;
+                }
+
+                try
+                {
+                    // TODO: MSFT: 19446208 - this should just use an iterator and the inserter...
+                    const auto glyph = row.GetCharRow().GlyphAt(iOldCol);
+                    const auto dbcsAttr = row.GetCharRow().DbcsAttrAt(iOldCol);
+                    const auto textAttr = *attrIt;
+
+                    if (!newBuffer.InsertCharacter(glyph, dbcsAttr, textAttr))
+                    {
+                        hr = E_OUTOFMEMORY;
+                        break;
+                    }
+                }
+                CATCH_RETURN();
+            }
         }
 
         // If we found the old row that the caller was interested in, set the
@@ -2292,6 +2719,27 @@ HRESULT TextBuffer::Reflow(TextBuffer& oldBuffer,
         newBuffer.CopyHyperlinkMaps(oldBuffer);
         newBuffer.CopyPatterns(oldBuffer);
 
+        // Move the shell integration marks along with the text they were on.
+        try
+        {
+            const ptrdiff_t newWidth = newBuffer.GetSize().Width();
+            const auto lastOldRow = gsl::narrow_cast<ptrdiff_t>(newRowStarts.size()) - 1;
+            const auto lastNewRowStart = newRowStarts.empty() ? til::point{ 0, newBuffer._evictedRows - 1 } : newRowStarts.back();
+            newBuffer._commandTimeline = oldBuffer._commandTimeline.Remap([&](const til::point position) {
+                const auto oldRow = position.y() - oldBuffer._evictedRows;
+                if (oldRow >= 0 && oldRow <= lastOldRow)
+                {
+                    const auto& start = til::at(newRowStarts, gsl::narrow_cast<size_t>(oldRow));
+                    const auto column = start.x() + position.x();
+                    return til::point{ column % newWidth, start.y() + column / newWidth };
+                }
+                // Marks below the last row with text keep their distance to it.
+                return til::point{ std::min(position.x(), newWidth - 1), lastNewRowStart.y() + oldRow - lastOldRow };
+            });
+            newBuffer._commandTimeline.EraseBefore(newBuffer._evictedRows);
+        }
+        CATCH_LOG();
+
         // If we found where to put the cursor while placing characters into the buffer,
         //   just put the cursor there. Otherwise we have to advance manually.
         if (fFoundCursorPos)
@@ -2385,33 +2833,99 @@ std::wstring TextBuffer::GetHyperlinkUriFromId(uint16_t id) const
 // - The internal hyperlink ID
 uint16_t TextBuffer::GetHyperlinkId(std::wstring_view uri, std::wstring_view id)
 {
-    uint16_t numericId = 0;
     if (id.empty())
     {
-        // no custom id specified, return our internal count
-        numericId = _currentHyperlinkId;
-        ++_currentHyperlinkId;
+        // no custom id specified, return a new one
+        return _AllocateHyperlinkId();
     }
-    else
+
+    // allocate a new id if the custom id does not already exist
+    std::wstring newId{ id };
+    // hash the URL and add it to the custom ID - GH#7698
+    newId += L"%" + std::to_wstring(std::hash<std::wstring_view>{}(uri));
+    if (const auto it = _hyperlinkCustomIdMap.find(newId); it != _hyperlinkCustomIdMap.end())
+    {
+        return it->second;
+    }
+    const auto numericId = _AllocateHyperlinkId();
+    _hyperlinkCustomIdMap.emplace(std::move(newId), numericId);
+    return numericId;
+}
+
+// Routine Description:
+// - Hands out an unused hyperlink ID. IDs of removed hyperlinks are recycled
+//   first, so that _currentHyperlinkId only grows with the number of hyperlinks
+//   that are alive at the same time, instead of wrapping around and colliding
+//   with IDs that are still in use.
+// - Hyperlinks that were overwritten in place (instead of scrolling away) are
+//   only found by sweeping the buffer, which we do whenever the map has grown
+//   enough since the last sweep or when we run out of IDs.
+// Arguments:
+// - <none>
+// Return Value:
+// - The hyperlink ID. Never 0.
+uint16_t TextBuffer::_AllocateHyperlinkId()
+{
+    if (_freeHyperlinkIds.empty() && (_hyperlinkMap.size() >= _nextHyperlinkSweep || _currentHyperlinkId == 0))
     {
-        // assign _currentHyperlinkId if the custom id does not already exist
-        std::wstring newId{ id };
-        // hash the URL and add it to the custom ID - GH#7698
-        newId += L"%" + std::to_wstring(std::hash<std::wstring_view>{}(uri));
-        const auto result = _hyperlinkCustomIdMap.emplace(newId, _currentHyperlinkId);
-        if (result.second)
+        _SweepHyperlinks();
+    }
+
+    if (!_freeHyperlinkIds.empty())
+    {
+        const auto id = _freeHyperlinkIds.back();
+        _freeHyperlinkIds.pop_back();
+        return id;
+    }
+
+    if (_currentHyperlinkId == 0)
+    {
+        // All 65535 IDs are referenced by the buffer. There's nothing left to
+        // do but to reuse one, like we used to when the counter wrapped around.
+        _currentHyperlinkId = 1;
+    }
+    return _currentHyperlinkId++;
+}
+
+// Routine Description:
+// - Removes every hyperlink that isn't referenced by any row of the buffer
+//   (or the current attributes) anymore, and makes its ID available again.
+//   This is what catches the links whose rows were overwritten in place,
+//   for instance by a full screen application or by erasing the display.
+// - This walks the attributes of the entire buffer, so the next sweep only
+//   happens once the map has grown to twice the size it has afterwards.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void TextBuffer::_SweepHyperlinks()
+{
+    std::vector<bool> referenced(size_t{ UINT16_MAX } + 1);
+    referenced.at(_currentAttributes.GetHyperlinkId()) = true;
+
+    const auto total = TotalRowCount();
+    for (size_t i = 0; i != total; ++i)
+    {
+        for (const auto id : GetRowByOffset(i).GetAttrRow().GetHyperlinks())
         {
-            // the custom id did not already exist
-            ++_currentHyperlinkId;
+            referenced.at(id) = true;
         }
-        numericId = (*(result.first)).second;
     }
-    // _currentHyperlinkId could overflow, make sure its not 0
-    if (_currentHyperlinkId == 0)
+
+    std::vector<uint16_t> unreferenced;
+    for (const auto& [id, uri] : _hyperlinkMap)
     {
-        ++_currentHyperlinkId;
+        if (!referenced.at(id))
+        {
+            unreferenced.emplace_back(id);
+        }
     }
-    return numericId;
+    for (const auto id : unreferenced)
+    {
+        RemoveHyperlinkFromMap(id);
+    }
+
+    _nextHyperlinkSweep = std::max(MinimumHyperlinkSweep, _hyperlinkMap.size() * 2);
 }
 
 // Method Description:
@@ -2421,7 +2935,15 @@ uint16_t TextBuffer::GetHyperlinkId(std::wstring_view uri, std::wstring_view id)
 // - The ID of the hyperlink to be removed
 void TextBuffer::RemoveHyperlinkFromMap(uint16_t id) noexcept
 {
-    _hyperlinkMap.erase(id);
+    if (_hyperlinkMap.erase(id))
+    {
+        // If we can't remember the ID, it's merely lost until the map is cleared.
+        try
+        {
+            _freeHyperlinkIds.emplace_back(id);
+        }
+        CATCH_LOG();
+    }
     for (const auto& customIdPair : _hyperlinkCustomIdMap)
     {
         if (customIdPair.second == id)
@@ -2461,19 +2983,63 @@ void TextBuffer::CopyHyperlinkMaps(const TextBuffer& other)
     _hyperlinkMap = other._hyperlinkMap;
     _hyperlinkCustomIdMap = other._hyperlinkCustomIdMap;
     _currentHyperlinkId = other._currentHyperlinkId;
+    _freeHyperlinkIds = other._freeHyperlinkIds;
+    _nextHyperlinkSweep = other._nextHyperlinkSweep;
+}
+
+// Method Description:
+// - Adds up the memory that this buffer holds on to. The hyperlink maps are
+//   estimated, as we can't see how much the nodes of an unordered_map cost.
+// Arguments:
+// - <none>
+// Return Value:
+// - The number of bytes, by what they're used for.
+TextBuffer::MemoryUsage TextBuffer::GetMemoryUsage() const noexcept
+{
+    // Short strings are stored inside the std::wstring itself.
+    const auto stringBytes = [](const std::wstring& str) noexcept -> size_t {
+        return str.capacity() > std::wstring{}.capacity() ? (str.capacity() + 1) * sizeof(wchar_t) : 0;
+    };
+
+    MemoryUsage usage{};
+    usage.rows = _storage.capacity() * sizeof(ROW);
+    usage.text = _charRowStorage.width() * _charRowStorage.height() * (sizeof(wchar_t) + sizeof(DbcsAttribute));
+    usage.attributes = _attrRowAccounting.bytes();
+
+    for (const auto& row : _storage)
+    {
+        usage.unicodeStorage += row.GetUnicodeStorage().MemoryUsage();
+    }
+
+    // Every node of an unordered_map holds the value and a pointer to the next node.
+    // The buckets are an array of one pointer each.
+    for (const auto& [id, uri] : _hyperlinkMap)
+    {
+        usage.hyperlinks += sizeof(void*) + sizeof(std::pair<const uint16_t, std::wstring>) + stringBytes(uri);
+    }
+    for (const auto& [customId, id] : _hyperlinkCustomIdMap)
+    {
+        usage.hyperlinks += sizeof(void*) + sizeof(std::pair<const std::wstring, uint16_t>) + stringBytes(customId);
+    }
+    usage.hyperlinks += (_hyperlinkMap.bucket_count() + _hyperlinkCustomIdMap.bucket_count()) * sizeof(void*);
+
+    return usage;
 }
 
 // Method Description:
 // - Adds a regex pattern we should search for
 // - The searching does not happen here, we only search when asked to by TerminalCore
+// - The pattern is compiled once here, rather than every time we search
 // Arguments:
-// - The regex pattern
+// - regexString - The regex pattern
+// - requiredLiteral - Optional text that every match of the pattern contains.
+//   When given, GetPatterns only runs the regex if this text is present.
 // Return value:
 // - An ID that the caller should associate with the given pattern
-const size_t TextBuffer::AddPatternRecognizer(const std::wstring_view regexString)
+const size_t TextBuffer::AddPatternRecognizer(const std::wstring_view regexString, const std::wstring_view requiredLiteral)
 {
     ++_currentPatternId;
-    _idsAndPatterns.emplace(std::make_pair(_currentPatternId, regexString));
+    _idsAndPatterns.emplace(_currentPatternId, PatternRecognizer{ std::wregex{ regexString.begin(), regexString.end() }, std::wstring{ requiredLiteral } });
     return _currentPatternId;
 }
 
@@ -2495,6 +3061,98 @@ void TextBuffer::CopyPatterns(const TextBuffer& OtherBuffer)
     _currentPatternId = OtherBuffer._currentPatternId;
 }
 
+// Method Description:
+// - Sets the file that rows are spilled into once they scroll out of the
+//   buffer. A buffer that replaces this one (for instance when resizing)
+//   should share the same spill.
+// Arguments:
+// - spill: the spill, or nullptr to discard evicted rows again
+// Return Value:
+// - <none>
+void TextBuffer::SetScrollbackSpill(std::shared_ptr<ScrollbackSpill> spill) noexcept
+{
+    _scrollbackSpill = std::move(spill);
+}
+
+const std::shared_ptr<ScrollbackSpill>& TextBuffer::GetScrollbackSpill() const noexcept
+{
+    return _scrollbackSpill;
+}
+
+// Method Description:
+// - Records a shell integration mark (OSC 133) at the cursor position.
+// Arguments:
+// - kind: the mark
+// - exitCode: the exit code of a CommandFinished mark, if the shell sent one
+// Return Value:
+// - <none>
+void TextBuffer::AddCommandMark(const CommandTimeline::MarkKind kind, const std::optional<unsigned int> exitCode)
+{
+    const auto position = GetCursor().GetPosition();
+    _commandTimeline.AddMark(kind, { position.X, position.Y + _evictedRows }, exitCode);
+}
+
+size_t TextBuffer::GetCommandCount() const noexcept
+{
+    return _commandTimeline.Size();
+}
+
+ptrdiff_t TextBuffer::GetEvictedRowCount() const noexcept
+{
+    return _evictedRows;
+}
+
+// Method Description:
+// - Returns the command the given row belongs to, i.e. the last one whose
+//   prompt starts at or above it.
+// Arguments:
+// - row: a row of the buffer
+// Return Value:
+// - the command with its positions in rows of the buffer, if there is one
+std::optional<CommandTimeline::Command> TextBuffer::GetCommandAt(const ptrdiff_t row) const
+{
+    return _ToBufferRows(_commandTimeline.GetCommandAt(row + _evictedRows));
+}
+
+// Method Description:
+// - Returns the last command whose prompt starts above the given row.
+// Arguments:
+// - row: a row of the buffer
+// Return Value:
+// - the command with its positions in rows of the buffer, if there is one
+std::optional<CommandTimeline::Command> TextBuffer::GetPreviousCommand(const ptrdiff_t row) const
+{
+    return _ToBufferRows(_commandTimeline.GetPreviousCommand(row + _evictedRows));
+}
+
+// Method Description:
+// - Returns the first command whose prompt starts below the given row.
+// Arguments:
+// - row: a row of the buffer
+// Return Value:
+// - the command with its positions in rows of the buffer, if there is one
+std::optional<CommandTimeline::Command> TextBuffer::GetNextCommand(const ptrdiff_t row) const
+{
+    return _ToBufferRows(_commandTimeline.GetNextCommand(row + _evictedRows));
+}
+
+std::optional<CommandTimeline::Command> TextBuffer::_ToBufferRows(std::optional<CommandTimeline::Command> command) const
+{
+    if (command)
+    {
+        const til::point offset{ 0, -_evictedRows };
+        command->promptStart += offset;
+        for (auto position : { &command->commandStart, &command->outputStart, &command->outputEnd })
+        {
+            if (*position)
+            {
+                **position += offset;
+            }
+        }
+    }
+    return command;
+}
+
 // Method Description:
 // - Finds patterns within the requested region of the text buffer
 // Arguments:
@@ -2521,10 +3179,18 @@ PointTree TextBuffer::GetPatterns(const size_t firstRow, const size_t lastRow) c
     // for each pattern we know of, iterate through the string
     for (const auto& idAndPattern : _idsAndPatterns)
     {
-        std::wregex regexObj{ idAndPattern.second };
+        const auto& recognizer = idAndPattern.second;
+
+        // Most text contains no matches at all and running the regex is
+        // expensive, so first do a cheap search for text every match needs.
+        if (!recognizer.requiredLiteral.empty() &&
+            concatAll.find(recognizer.requiredLiteral) == std::wstring::npos)
+        {
+            continue;
+        }
 
         // search through the run with our regex object
-        auto words_begin = std::wsregex_iterator(concatAll.begin(), concatAll.end(), regexObj);
+        auto words_begin = std::wsregex_iterator(concatAll.begin(), concatAll.end(), recognizer.regex);
         auto words_end = std::wsregex_iterator();
 
         size_t lenUpToThis = 0;
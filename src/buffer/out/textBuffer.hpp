@@ -51,17 +51,20 @@ filling in the last row, and updating the screen.
 
 #include <vector>
 
+#include "CommandTimeline.hpp"
 #include "cursor.h"
 #include "Row.hpp"
 #include "TextAttribute.hpp"
-#include "UnicodeStorage.hpp"
 #include "../types/inc/Viewport.hpp"
 
 #include "../buffer/out/textBufferCellIterator.hpp"
 #include "../buffer/out/textBufferTextIterator.hpp"
+#include "../buffer/out/textBufferRunIterator.hpp"
 
 #include "../renderer/inc/IRenderTarget.hpp"
 
+class ScrollbackSpill;
+
 class TextBuffer final
 {
 public:
@@ -92,11 +95,35 @@ public:
                              const COORD target,
                              const std::optional<bool> wrap = true);
 
+    size_t FillNarrowText(const wchar_t wch,
+                          const size_t count,
+                          const COORD target,
+                          const std::optional<bool> wrap = true);
+
+    size_t FillAttributes(const TextAttribute attr,
+                          const size_t count,
+                          const COORD target);
+
+    void WriteCharInfos(gsl::span<const CHAR_INFO> charInfos, const COORD target);
+
     OutputCellIterator WriteLine(const OutputCellIterator givenIt,
                                  const COORD target,
                                  const std::optional<bool> setWrap = std::nullopt,
                                  const std::optional<size_t> limitRight = std::nullopt);
 
+    TextCellIterator WriteText(const TextCellIterator givenIt,
+                               const COORD target,
+                               const std::optional<bool> wrap = true);
+
+    TextCellIterator WriteTextLine(const TextCellIterator givenIt,
+                                   const COORD target,
+                                   const std::optional<bool> setWrap = std::nullopt);
+
+    size_t WriteNarrowText(const std::wstring_view text,
+                           const TextAttribute attr,
+                           const COORD target,
+                           const std::optional<bool> wrap = true);
+
     bool InsertCharacter(const wchar_t wch, const DbcsAttribute dbcsAttribute, const TextAttribute attr);
     bool InsertCharacter(const std::wstring_view chars, const DbcsAttribute dbcsAttribute, const TextAttribute attr);
     bool IncrementCursor();
@@ -115,6 +142,7 @@ public:
     const Microsoft::Console::Types::Viewport GetSize() const noexcept;
 
     void ScrollRows(const SHORT firstRow, const SHORT size, const SHORT delta);
+    void EraseRows(const SHORT firstRow, const SHORT lastRow, const TextAttribute attr);
 
     UINT TotalRowCount() const noexcept;
 
@@ -133,11 +161,13 @@ public:
     COORD BufferToScreenPosition(const COORD position) const;
 
     void Reset();
+    void Recycle(const COORD screenBufferSize,
+                 const TextAttribute defaultAttributes,
+                 const UINT cursorSize,
+                 Microsoft::Console::Render::IRenderTarget& renderTarget);
 
     [[nodiscard]] HRESULT ResizeTraditional(const COORD newSize) noexcept;
-
-    const UnicodeStorage& GetUnicodeStorage() const noexcept;
-    UnicodeStorage& GetUnicodeStorage() noexcept;
+    [[nodiscard]] HRESULT TryReflowInPlace(const COORD newSize) noexcept;
 
     Microsoft::Console::Render::IRenderTarget& GetRenderTarget() noexcept;
 
@@ -160,12 +190,31 @@ public:
     std::wstring GetCustomIdFromId(uint16_t id) const;
     void CopyHyperlinkMaps(const TextBuffer& OtherBuffer);
 
+    // How many bytes the buffer holds on to, by what they're used for.
+    struct MemoryUsage
+    {
+        size_t rows; // the ROW objects themselves
+        size_t text; // the characters and their DBCS attributes
+        size_t attributes; // the attribute runs
+        size_t unicodeStorage; // glyphs that don't fit into a single wchar_t
+        size_t hyperlinks; // the URIs and custom IDs of hyperlinks
+    };
+
+    MemoryUsage GetMemoryUsage() const noexcept;
+
     class TextAndColor
     {
     public:
+        struct ColorRun
+        {
+            COLORREF fg;
+            COLORREF bk;
+            size_t length; // in wchar_t's of the row's text
+        };
+
         std::vector<std::wstring> text;
-        std::vector<std::vector<COLORREF>> FgAttr;
-        std::vector<std::vector<COLORREF>> BkAttr;
+        // The colors of each row's text, as runs covering the whole row.
+        std::vector<std::vector<ColorRun>> ColorRuns;
     };
 
     const TextAndColor GetText(const bool includeCRLF,
@@ -195,14 +244,39 @@ public:
                           const std::optional<Microsoft::Console::Types::Viewport> lastCharacterViewport,
                           std::optional<std::reference_wrapper<PositionInformation>> positionInfo);
 
-    const size_t AddPatternRecognizer(const std::wstring_view regexString);
+    const size_t AddPatternRecognizer(const std::wstring_view regexString, const std::wstring_view requiredLiteral = {});
     void ClearPatternRecognizers() noexcept;
     void CopyPatterns(const TextBuffer& OtherBuffer);
     interval_tree::IntervalTree<til::point, size_t> GetPatterns(const size_t firstRow, const size_t lastRow) const;
 
+    // Rows evicted by IncrementCircularBuffer are appended to the spill, if there is one.
+    void SetScrollbackSpill(std::shared_ptr<ScrollbackSpill> spill) noexcept;
+    const std::shared_ptr<ScrollbackSpill>& GetScrollbackSpill() const noexcept;
+
+    // The number of rows that scrolled out of the buffer so far. Adding it to a row
+    // turns it into an absolute row number that stays put while the buffer scrolls.
+    ptrdiff_t GetEvictedRowCount() const noexcept;
+
+    // Shell integration marks (OSC 133), see CommandTimeline. Rows are rows of the buffer.
+    void AddCommandMark(const CommandTimeline::MarkKind kind, const std::optional<unsigned int> exitCode = std::nullopt);
+    size_t GetCommandCount() const noexcept;
+    std::optional<CommandTimeline::Command> GetCommandAt(const ptrdiff_t row) const;
+    std::optional<CommandTimeline::Command> GetPreviousCommand(const ptrdiff_t row) const;
+    std::optional<CommandTimeline::Command> GetNextCommand(const ptrdiff_t row) const;
+
 private:
+    template<typename TIterator>
+    TIterator _Write(const TIterator givenIt, const COORD target, const std::optional<bool> wrap);
+    template<typename TIterator>
+    TIterator _WriteLine(const TIterator givenIt, const COORD target, const std::optional<bool> wrap, const std::optional<size_t> limitRight);
+
     void _UpdateSize();
     Microsoft::Console::Types::Viewport _size;
+    // backing memory for the text and attribute runs of all rows in _storage. Must outlive them.
+    CharRowStorage _charRowStorage;
+    // counts what _attrRowPool got from the heap. Must outlive the pool.
+    til::pmr::counting_resource _attrRowAccounting;
+    std::pmr::unsynchronized_pool_resource _attrRowPool;
     std::vector<ROW> _storage;
     Cursor _cursor;
 
@@ -210,16 +284,21 @@ private:
 
     TextAttribute _currentAttributes;
 
-    // storage location for glyphs that can't fit into the buffer normally
-    UnicodeStorage _unicodeStorage;
-
     std::unordered_map<uint16_t, std::wstring> _hyperlinkMap;
     std::unordered_map<std::wstring, uint16_t> _hyperlinkCustomIdMap;
     uint16_t _currentHyperlinkId;
+    // IDs whose hyperlink was removed from the map and that can be handed out again.
+    std::vector<uint16_t> _freeHyperlinkIds;
+    // Once the map holds this many hyperlinks, the rows are swept for the ones
+    // that aren't referenced anymore. See _SweepHyperlinks.
+    size_t _nextHyperlinkSweep;
+    static constexpr size_t MinimumHyperlinkSweep = 1024;
 
     void _RefreshRowIDs(std::optional<SHORT> newRowWidth);
+    [[nodiscard]] HRESULT _ResizeTraditional(const COORD newSize, const SHORT topRow) noexcept;
 
-    Microsoft::Console::Render::IRenderTarget& _renderTarget;
+    // A pointer, so that Recycle() can hand the buffer to a new owner.
+    Microsoft::Console::Render::IRenderTarget* _renderTarget;
 
     void _SetFirstRowIndex(const SHORT FirstRowIndex) noexcept;
 
@@ -239,17 +318,36 @@ private:
 
     void _ExpandTextRow(SMALL_RECT& selectionRow) const;
 
-    const DelimiterClass _GetDelimiterClassAt(const COORD pos, const std::wstring_view wordDelimiters) const;
-    const COORD _GetWordStartForAccessibility(const COORD target, const std::wstring_view wordDelimiters) const;
-    const COORD _GetWordStartForSelection(const COORD target, const std::wstring_view wordDelimiters) const;
-    const COORD _GetWordEndForAccessibility(const COORD target, const std::wstring_view wordDelimiters, const COORD lastCharPos) const;
-    const COORD _GetWordEndForSelection(const COORD target, const std::wstring_view wordDelimiters) const;
+    const DelimiterClass _GetDelimiterClassAt(const COORD pos, const DelimiterClassifier& classifier) const;
+    const COORD _GetWordStartForAccessibility(const COORD target, const DelimiterClassifier& classifier) const;
+    const COORD _GetWordStartForSelection(const COORD target, const DelimiterClassifier& classifier) const;
+    const COORD _GetWordEndForAccessibility(const COORD target, const DelimiterClassifier& classifier, const COORD lastCharPos) const;
+    const COORD _GetWordEndForSelection(const COORD target, const DelimiterClassifier& classifier) const;
 
     void _PruneHyperlinks();
+    void _SweepHyperlinks();
+    uint16_t _AllocateHyperlinkId();
 
-    std::unordered_map<size_t, std::wstring> _idsAndPatterns;
+    struct PatternRecognizer
+    {
+        std::wregex regex;
+        // Text that every match contains. If it isn't in the searched text,
+        // the regex can't match and we don't need to run it at all.
+        std::wstring requiredLiteral;
+    };
+
+    std::unordered_map<size_t, PatternRecognizer> _idsAndPatterns;
     size_t _currentPatternId;
 
+    std::shared_ptr<ScrollbackSpill> _scrollbackSpill;
+
+    // The timeline's positions are absolute, offset by how many rows were evicted so far.
+    CommandTimeline _commandTimeline;
+    ptrdiff_t _evictedRows;
+    std::optional<CommandTimeline::Command> _ToBufferRows(std::optional<CommandTimeline::Command> command) const;
+
+    friend class BufferSnapshot;
+
 #ifdef UNIT_TESTING
     friend class TextBufferTests;
     friend class UiaTextRangeTests;
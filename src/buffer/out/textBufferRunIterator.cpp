@@ -0,0 +1,94 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+
+#include "textBufferRunIterator.hpp"
+
+#include "Row.hpp"
+
+#pragma hdrstop
+
+// Routine Description:
+// - Creates a new read-only iterator over the attribute runs of a row
+// Arguments:
+// - row - the row to walk through
+// - left - the first column to yield
+// - right - the column past the last one to yield. It's clamped to the row's width.
+TextBufferRunIterator::TextBufferRunIterator(const ROW& row, const size_t left, const size_t right) :
+    _row{ row },
+    _run{ row.GetAttrRow().Runs().begin() },
+    _left{ left },
+    _right{ left },
+    _end{ std::min(right, row.size()) }
+{
+    if (_left < _end)
+    {
+        // Skip the runs that end before the first column.
+        size_t runEnd = _run->length;
+        while (runEnd <= _left)
+        {
+            ++_run;
+            runEnd += _run->length;
+        }
+        _right = std::min(runEnd, _end);
+    }
+}
+
+// Routine Description:
+// - Tells if the iterator still points at a run (hasn't passed the right column yet)
+// Return Value:
+// - True if this iterator can still be dereferenced for data. False if we've passed the end and are out of data.
+TextBufferRunIterator::operator bool() const noexcept
+{
+    return _left < _end;
+}
+
+// Routine Description:
+// - Moves to the next run. Every run but the first starts at the beginning
+//   of its ATTR_ROW run, so this doesn't need to seek.
+// Return Value:
+// - Reference to self after movement.
+TextBufferRunIterator& TextBufferRunIterator::operator++()
+{
+    _left = _right;
+    if (_left < _end)
+    {
+        ++_run;
+        _right = std::min(_left + _run->length, _end);
+    }
+    return *this;
+}
+
+// Routine Description:
+// - The attribute shared by all cells of the current run
+const TextAttribute& TextBufferRunIterator::TextAttr() const noexcept
+{
+    return _run->value;
+}
+
+// Routine Description:
+// - The first column of the current run
+size_t TextBufferRunIterator::Left() const noexcept
+{
+    return _left;
+}
+
+// Routine Description:
+// - The column past the last one of the current run
+size_t TextBufferRunIterator::Right() const noexcept
+{
+    return _right;
+}
+
+// Routine Description:
+// - Appends the text of the current run to a string. Like ROW::AppendText,
+//   a wide glyph is appended by the run that holds its leading half.
+// Arguments:
+// - text - the string to append to
+// Return Value:
+// - <none>
+void TextBufferRunIterator::AppendText(std::wstring& text) const
+{
+    _row.AppendText(text, _left, _right);
+}
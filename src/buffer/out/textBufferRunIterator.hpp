@@ -0,0 +1,43 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- textBufferRunIterator.hpp
+
+Abstract:
+- This module walks through the cells of a row one attribute run at a time
+- Every run is a range of columns that share the same TextAttribute, taken
+  straight from the row's ATTR_ROW. The glyphs of a run can then be read from
+  the row's CharRow without re-fetching the row or re-seeking the attributes
+  for every single cell, as a TextBufferCellIterator would.
+- It is intended for read-only operations
+--*/
+
+#pragma once
+
+#include "AttrRow.hpp"
+
+class ROW;
+
+class TextBufferRunIterator final
+{
+public:
+    TextBufferRunIterator(const ROW& row, const size_t left, const size_t right);
+
+    explicit operator bool() const noexcept;
+    TextBufferRunIterator& operator++();
+
+    const TextAttribute& TextAttr() const noexcept;
+    size_t Left() const noexcept;
+    size_t Right() const noexcept;
+
+    void AppendText(std::wstring& text) const;
+
+private:
+    const ROW& _row;
+    ATTR_ROW::run_container::const_iterator _run;
+    size_t _left;
+    size_t _right;
+    size_t _end;
+};
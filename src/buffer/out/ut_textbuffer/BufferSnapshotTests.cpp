@@ -0,0 +1,143 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "WexTestClass.h"
+#include "../../inc/consoletaeftemplates.hpp"
+
+#include "../textBuffer.hpp"
+#include "../BufferSnapshot.hpp"
+#include "../../renderer/inc/DummyRenderTarget.hpp"
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+class BufferSnapshotTests
+{
+    TEST_CLASS(BufferSnapshotTests);
+
+    TEST_METHOD(RoundTrip);
+    TEST_METHOD(UpdateOnlyReencodesChangedRows);
+    TEST_METHOD(RestoreIntoFewerRows);
+    TEST_METHOD(RestoreRejectsBrokenSnapshots);
+
+    static void _verifyBuffersEqual(const TextBuffer& expected, const TextBuffer& actual, const size_t expectedFirstRow = 0)
+    {
+        const auto height = gsl::narrow_cast<size_t>(actual.GetSize().Height());
+        for (size_t y = 0; y < height; ++y)
+        {
+            Log::Comment(NoThrowString().Format(L"row %zu", y));
+            const auto& expectedRow = expected.GetRowByOffset(y + expectedFirstRow);
+            const auto& actualRow = actual.GetRowByOffset(y);
+            VERIFY_ARE_EQUAL(expectedRow.GetText(), actualRow.GetText());
+            VERIFY_ARE_EQUAL(expectedRow.WasWrapForced(), actualRow.WasWrapForced());
+            VERIFY_ARE_EQUAL(static_cast<int>(expectedRow.GetLineRendition()), static_cast<int>(actualRow.GetLineRendition()));
+            VERIFY_IS_TRUE(expectedRow.GetAttrRow() == actualRow.GetAttrRow());
+        }
+    }
+};
+
+static DummyRenderTarget target;
+
+void BufferSnapshotTests::RoundTrip()
+{
+    TextBuffer source{ { 20, 4 }, TextAttribute{ 0x7 }, 0, target };
+
+    auto& first = source.GetRowByOffset(0);
+    first.WriteCells(OutputCellIterator{ L"ab\x6771", TextAttribute{ 0x1e } }, 0);
+    first.WriteCells(OutputCellIterator{ L"\xD83D\xDE00c", TextAttribute{ 0x2f } }, 4);
+    first.SetWrapForced(true);
+
+    auto& second = source.GetRowByOffset(1);
+    second.SetLineRendition(LineRendition::DoubleWidth);
+    second.WriteCells(OutputCellIterator{ L"wide", TextAttribute{ 0x7 } }, 0);
+
+    TextAttribute link{ 0x7 };
+    link.SetHyperlinkId(source.GetHyperlinkId(L"https://example.com", L"custom"));
+    source.AddHyperlinkToMap(L"https://example.com", link.GetHyperlinkId());
+    source.GetRowByOffset(2).WriteCells(OutputCellIterator{ L"link", link }, 3);
+
+    source.GetCursor().SetPosition({ 7, 2 });
+
+    BufferSnapshot snapshot;
+    snapshot.Update(source);
+    const auto bytes = snapshot.Serialize();
+
+    const auto size = BufferSnapshot::ReadSize(bytes);
+    VERIFY_ARE_EQUAL(20, size.X);
+    VERIFY_ARE_EQUAL(4, size.Y);
+
+    TextBuffer destination{ size, TextAttribute{ 0x7 }, 0, target };
+    BufferSnapshot::Restore(bytes, destination);
+
+    _verifyBuffersEqual(source, destination);
+    VERIFY_ARE_EQUAL(source.GetCursor().GetPosition(), destination.GetCursor().GetPosition());
+    VERIFY_ARE_EQUAL(L"https://example.com", destination.GetHyperlinkUriFromId(link.GetHyperlinkId()));
+    // The custom ID must map to the same hyperlink as before.
+    VERIFY_ARE_EQUAL(link.GetHyperlinkId(), destination.GetHyperlinkId(L"https://example.com", L"custom"));
+}
+
+void BufferSnapshotTests::UpdateOnlyReencodesChangedRows()
+{
+    TextBuffer source{ { 20, 4 }, TextAttribute{ 0x7 }, 0, target };
+    source.GetRowByOffset(0).WriteCells(OutputCellIterator{ L"first", TextAttribute{ 0x7 } }, 0);
+
+    BufferSnapshot snapshot;
+    snapshot.Update(source);
+
+    source.GetRowByOffset(1).WriteCells(OutputCellIterator{ L"second", TextAttribute{ 0x1e } }, 0);
+    snapshot.Update(source);
+
+    // An incrementally updated snapshot must be identical to a new one.
+    BufferSnapshot fresh;
+    fresh.Update(source);
+    VERIFY_ARE_EQUAL(fresh.Serialize(), snapshot.Serialize());
+
+    TextBuffer destination{ { 20, 4 }, TextAttribute{ 0x7 }, 0, target };
+    BufferSnapshot::Restore(snapshot.Serialize(), destination);
+    _verifyBuffersEqual(source, destination);
+}
+
+void BufferSnapshotTests::RestoreIntoFewerRows()
+{
+    TextBuffer source{ { 10, 6 }, TextAttribute{ 0x7 }, 0, target };
+    for (size_t y = 0; y < 6; ++y)
+    {
+        source.GetRowByOffset(y).WriteCells(OutputCellIterator{ std::to_wstring(y), TextAttribute{ 0x7 } }, 0);
+    }
+    source.GetCursor().SetPosition({ 1, 5 });
+
+    BufferSnapshot snapshot;
+    snapshot.Update(source);
+
+    // Only the 3 most recent rows fit and the cursor moves up along with them.
+    TextBuffer destination{ { 10, 3 }, TextAttribute{ 0x7 }, 0, target };
+    BufferSnapshot::Restore(snapshot.Serialize(), destination);
+    _verifyBuffersEqual(source, destination, 3);
+    VERIFY_ARE_EQUAL((COORD{ 1, 2 }), destination.GetCursor().GetPosition());
+}
+
+void BufferSnapshotTests::RestoreRejectsBrokenSnapshots()
+{
+    TextBuffer source{ { 10, 2 }, TextAttribute{ 0x7 }, 0, target };
+    source.GetRowByOffset(0).WriteCells(OutputCellIterator{ L"keep", TextAttribute{ 0x7 } }, 0);
+
+    BufferSnapshot snapshot;
+    snapshot.Update(source);
+    const auto bytes = snapshot.Serialize();
+
+    TextBuffer destination{ { 10, 2 }, TextAttribute{ 0x7 }, 0, target };
+    destination.GetRowByOffset(0).WriteCells(OutputCellIterator{ L"original", TextAttribute{ 0x7 } }, 0);
+
+    Log::Comment(L"A truncated snapshot must be rejected and leave the buffer untouched.");
+    VERIFY_THROWS(BufferSnapshot::Restore(std::string_view{ bytes }.substr(0, bytes.size() - 1), destination), wil::ResultException);
+    VERIFY_ARE_EQUAL(L"original  ", destination.GetRowByOffset(0).GetText());
+
+    Log::Comment(L"So must one that isn't a snapshot at all.");
+    VERIFY_THROWS(BufferSnapshot::Restore("garbage", destination), wil::ResultException);
+
+    Log::Comment(L"And one of a buffer of a different width.");
+    TextBuffer wide{ { 20, 2 }, TextAttribute{ 0x7 }, 0, target };
+    VERIFY_THROWS(BufferSnapshot::Restore(bytes, wide), wil::ResultException);
+}
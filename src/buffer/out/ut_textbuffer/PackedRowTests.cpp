@@ -0,0 +1,93 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "WexTestClass.h"
+#include "../../inc/consoletaeftemplates.hpp"
+
+#include "../textBuffer.hpp"
+#include "../PackedRow.hpp"
+#include "../../renderer/inc/DummyRenderTarget.hpp"
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+class PackedRowTests
+{
+    TEST_CLASS(PackedRowTests);
+
+    TEST_METHOD(RoundTrip);
+    TEST_METHOD(RoundTripEmptyRow);
+    TEST_METHOD(UnpackRejectsWidthMismatch);
+
+    static void _verifyRowsEqual(const ROW& expected, const ROW& actual)
+    {
+        VERIFY_ARE_EQUAL(expected.size(), actual.size());
+        VERIFY_ARE_EQUAL(expected.WasWrapForced(), actual.WasWrapForced());
+        VERIFY_ARE_EQUAL(expected.WasDoubleBytePadded(), actual.WasDoubleBytePadded());
+        VERIFY_ARE_EQUAL(static_cast<int>(expected.GetLineRendition()), static_cast<int>(actual.GetLineRendition()));
+        VERIFY_ARE_EQUAL(expected.GetText(), actual.GetText());
+
+        const auto& expectedChars = expected.GetCharRow();
+        const auto& actualChars = actual.GetCharRow();
+        for (size_t column = 0; column < expected.size(); ++column)
+        {
+            Log::Comment(NoThrowString().Format(L"column %zu", column));
+            VERIFY_ARE_EQUAL(static_cast<std::wstring_view>(expectedChars.GlyphAt(column)), static_cast<std::wstring_view>(actualChars.GlyphAt(column)));
+            VERIFY_IS_TRUE(expectedChars.DbcsAttrAt(column) == actualChars.DbcsAttrAt(column));
+            VERIFY_ARE_EQUAL(expected.GetAttrRow().GetAttrByColumn(gsl::narrow<uint16_t>(column)),
+                             actual.GetAttrRow().GetAttrByColumn(gsl::narrow<uint16_t>(column)));
+        }
+    }
+};
+
+static DummyRenderTarget target;
+
+void PackedRowTests::RoundTrip()
+{
+    TextBuffer buffer{ { 20, 2 }, TextAttribute{ 0x7 }, 0, target };
+
+    auto& source = buffer.GetRowByOffset(0);
+    source.WriteCells(OutputCellIterator{ L"ab\x6771", TextAttribute{ 0x1e } }, 0);
+    source.WriteCells(OutputCellIterator{ L"\xD83D\xDE00c", TextAttribute{ 0x2f } }, 4);
+    source.WriteCells(OutputCellIterator{ L"tail", TextAttribute{ 0x7 } }, 16);
+    source.SetWrapForced(true);
+    source.SetLineRendition(LineRendition::DoubleWidth);
+
+    const auto packed = PackedRow::Pack(source);
+    VERIFY_ARE_EQUAL(source.size(), packed.Width());
+
+    auto& destination = buffer.GetRowByOffset(1);
+    destination.WriteCells(OutputCellIterator{ L"garbage garbage", TextAttribute{ 0x4c } }, 0);
+    packed.Unpack(destination);
+
+    _verifyRowsEqual(source, destination);
+}
+
+void PackedRowTests::RoundTripEmptyRow()
+{
+    TextBuffer buffer{ { 80, 2 }, TextAttribute{ 0x7 }, 0, target };
+
+    const auto& source = buffer.GetRowByOffset(0);
+    const auto packed = PackedRow::Pack(source);
+
+    // A blank row consists of one run of cells and one run of attributes,
+    // so it must be considerably smaller than the 3 bytes per cell of an expanded row.
+    VERIFY_IS_LESS_THAN(packed.ByteSize(), source.size() * (sizeof(wchar_t) + sizeof(DbcsAttribute)));
+
+    auto& destination = buffer.GetRowByOffset(1);
+    destination.WriteCells(OutputCellIterator{ L"\x6771\x6771", TextAttribute{ 0x4c } }, 10);
+    packed.Unpack(destination);
+
+    _verifyRowsEqual(source, destination);
+}
+
+void PackedRowTests::UnpackRejectsWidthMismatch()
+{
+    TextBuffer narrow{ { 10, 1 }, TextAttribute{ 0x7 }, 0, target };
+    TextBuffer wide{ { 20, 1 }, TextAttribute{ 0x7 }, 0, target };
+
+    const auto packed = PackedRow::Pack(narrow.GetRowByOffset(0));
+    VERIFY_THROWS(packed.Unpack(wide.GetRowByOffset(0)), wil::ResultException);
+}
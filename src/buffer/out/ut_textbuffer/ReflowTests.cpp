@@ -746,21 +746,21 @@ class ReflowTests
             row.SetWrapForced(testRow.wrap);
 
             size_t j{};
-            for (auto it{ charRow.begin() }; it != charRow.end(); ++it)
+            for (size_t col{}; col < charRow.size(); ++col)
             {
                 // Yes, we're about to manually create a buffer. It is unpleasant.
                 const auto ch{ til::at(testRow.text, j) };
-                it->Char() = ch;
+                charRow.GlyphAt(col) = std::wstring_view{ &ch, 1 };
                 if (IsGlyphFullWidth(ch))
                 {
-                    it->DbcsAttr().SetLeading();
-                    it++;
-                    it->Char() = ch;
-                    it->DbcsAttr().SetTrailing();
+                    charRow.DbcsAttrAt(col).SetLeading();
+                    col++;
+                    charRow.GlyphAt(col) = std::wstring_view{ &ch, 1 };
+                    charRow.DbcsAttrAt(col).SetTrailing();
                 }
                 else
                 {
-                    it->DbcsAttr().SetSingle();
+                    charRow.DbcsAttrAt(col).SetSingle();
                 }
                 j++;
             }
@@ -795,27 +795,27 @@ class ReflowTests
             VERIFY_ARE_EQUAL(testRow.wrap, row.WasWrapForced(), indexString);
 
             size_t j{};
-            for (auto it{ charRow.begin() }; it != charRow.end(); ++it)
+            for (size_t col{}; col < charRow.size(); ++col)
             {
-                indexString.Format(L"[Cell %d, %d; Text line index %d]", it - charRow.begin(), i, j);
+                indexString.Format(L"[Cell %d, %d; Text line index %d]", col, i, j);
                 // Yes, we're about to manually create a buffer. It is unpleasant.
                 const auto ch{ til::at(testRow.text, j) };
                 if (IsGlyphFullWidth(ch))
                 {
                     // Char is full width in test buffer, so
                     // ensure that real buffer is LEAD, TRAIL (ch)
-                    VERIFY_IS_TRUE(it->DbcsAttr().IsLeading(), indexString);
-                    VERIFY_ARE_EQUAL(ch, it->Char(), indexString);
+                    VERIFY_IS_TRUE(charRow.DbcsAttrAt(col).IsLeading(), indexString);
+                    VERIFY_ARE_EQUAL(ch, *charRow.GlyphAt(col).begin(), indexString);
 
-                    it++;
-                    VERIFY_IS_TRUE(it->DbcsAttr().IsTrailing(), indexString);
+                    col++;
+                    VERIFY_IS_TRUE(charRow.DbcsAttrAt(col).IsTrailing(), indexString);
                 }
                 else
                 {
-                    VERIFY_IS_TRUE(it->DbcsAttr().IsSingle(), indexString);
+                    VERIFY_IS_TRUE(charRow.DbcsAttrAt(col).IsSingle(), indexString);
                 }
 
-                VERIFY_ARE_EQUAL(ch, it->Char(), indexString);
+                VERIFY_ARE_EQUAL(ch, *charRow.GlyphAt(col).begin(), indexString);
                 j++;
             }
             i++;
@@ -828,6 +828,21 @@ class ReflowTests
             TEST_METHOD_PROPERTY(L"DataSource", L"Export:ReflowTestDataSource")
         END_TEST_METHOD_PROPERTIES()
 
+        _runReflowTestCase(false);
+    }
+
+    TEST_METHOD(TestReflowCasesInPlace)
+    {
+        BEGIN_TEST_METHOD_PROPERTIES()
+            TEST_METHOD_PROPERTY(L"DataSource", L"Export:ReflowTestDataSource")
+        END_TEST_METHOD_PROPERTIES()
+
+        // Resizing in place must give the same results, whenever it's possible at all.
+        _runReflowTestCase(true);
+    }
+
+    static void _runReflowTestCase(const bool tryInPlace)
+    {
         WEX::TestExecution::DisableVerifyExceptions disableVerifyExceptions{};
         WEX::TestExecution::SetVerifyOutput verifyOutputScope{ WEX::TestExecution::VerifyOutputSettings::LogOnlyFailures };
 
@@ -843,10 +858,15 @@ class ReflowTests
             const auto& testBuffer{ til::at(testCase.buffers, bufferIndex) };
             Log::Comment(NoThrowString().Format(L"[%zu.%zu] Resizing to %dx%d", i, bufferIndex, testBuffer.size.X, testBuffer.size.Y));
 
-            auto newBuffer{ _textBufferByReflowingTextBuffer(*textBuffer, testBuffer.size) };
+            const auto hr = tryInPlace ? textBuffer->TryReflowInPlace(testBuffer.size) : S_FALSE;
+            VERIFY_SUCCEEDED(hr);
+            if (hr == S_FALSE)
+            {
+                auto newBuffer{ _textBufferByReflowingTextBuffer(*textBuffer, testBuffer.size) };
 
-            // All future operations are based on the new buffer
-            std::swap(textBuffer, newBuffer);
+                // All future operations are based on the new buffer
+                std::swap(textBuffer, newBuffer);
+            }
 
             _compareTextBufferAgainstTestBuffer(*textBuffer, testBuffer);
         }
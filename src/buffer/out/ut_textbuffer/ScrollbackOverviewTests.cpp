@@ -0,0 +1,79 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "WexTestClass.h"
+#include "../../inc/consoletaeftemplates.hpp"
+
+#include "../textBuffer.hpp"
+#include "../ScrollbackOverview.hpp"
+#include "../../renderer/inc/DummyRenderTarget.hpp"
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+class ScrollbackOverviewTests
+{
+    TEST_CLASS(ScrollbackOverviewTests);
+
+    TEST_METHOD(ColoredTextDominatesItsBucket);
+    TEST_METHOD(UpdateFollowsTheCircularBuffer);
+};
+
+static DummyRenderTarget target;
+
+void ScrollbackOverviewTests::ColoredTextDominatesItsBucket()
+{
+    TextBuffer buffer{ { 20, 8 }, TextAttribute{}, 0, target };
+    TextAttribute red{};
+    red.SetIndexedForeground(FOREGROUND_RED);
+
+    buffer.GetRowByOffset(0).WriteCells(OutputCellIterator{ L"plain text", TextAttribute{} }, 0);
+    buffer.GetRowByOffset(1).WriteCells(OutputCellIterator{ L"error", red }, 0);
+    buffer.GetRowByOffset(1).WriteCells(OutputCellIterator{ L": plain", TextAttribute{} }, 5);
+    buffer.GetRowByOffset(4).WriteCells(OutputCellIterator{ L"four", TextAttribute{} }, 0);
+
+    ScrollbackOverview overview;
+    overview.Update(buffer);
+    const auto buckets = overview.Downsample(8, 4);
+    VERIFY_ARE_EQUAL(4u, buckets.size());
+
+    Log::Comment(L"The red run wins over the longer plain text next to it.");
+    VERIFY_ARE_EQUAL(red, buckets[0].attr);
+    VERIFY_ARE_EQUAL(11, buckets[0].textLength);
+
+    Log::Comment(L"Rows without any text count towards the average length.");
+    VERIFY_ARE_EQUAL(TextAttribute{}, buckets[2].attr);
+    VERIFY_ARE_EQUAL(2, buckets[2].textLength);
+    VERIFY_ARE_EQUAL(0, buckets[3].textLength);
+
+    Log::Comment(L"With fewer rows than buckets, rows are repeated.");
+    const auto stretched = overview.Downsample(2, 4);
+    VERIFY_ARE_EQUAL(4u, stretched.size());
+    VERIFY_ARE_EQUAL(10, stretched[1].textLength);
+    VERIFY_ARE_EQUAL(red, stretched[2].attr);
+}
+
+void ScrollbackOverviewTests::UpdateFollowsTheCircularBuffer()
+{
+    TextBuffer buffer{ { 10, 4 }, TextAttribute{}, 0, target };
+    TextAttribute green{};
+    green.SetIndexedForeground(FOREGROUND_GREEN);
+    buffer.GetRowByOffset(0).WriteCells(OutputCellIterator{ L"first", green }, 0);
+
+    ScrollbackOverview overview;
+    overview.Update(buffer);
+    VERIFY_ARE_EQUAL(green, overview.Downsample(4, 4)[0].attr);
+
+    // The first row is recycled as the last one, and comes back empty.
+    buffer.IncrementCircularBuffer();
+    buffer.GetRowByOffset(0).WriteCells(OutputCellIterator{ L"2nd", TextAttribute{} }, 0);
+    overview.Update(buffer);
+
+    const auto buckets = overview.Downsample(4, 4);
+    VERIFY_ARE_EQUAL(TextAttribute{}, buckets[0].attr);
+    VERIFY_ARE_EQUAL(3, buckets[0].textLength);
+    VERIFY_ARE_EQUAL(TextAttribute{}, buckets[3].attr);
+    VERIFY_ARE_EQUAL(0, buckets[3].textLength);
+}
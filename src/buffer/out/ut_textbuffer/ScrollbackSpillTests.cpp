@@ -0,0 +1,102 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "WexTestClass.h"
+#include "../../inc/consoletaeftemplates.hpp"
+
+#include "../textBuffer.hpp"
+#include "../ScrollbackSpill.hpp"
+#include "../../renderer/inc/DummyRenderTarget.hpp"
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+class ScrollbackSpillTests
+{
+    TEST_CLASS(ScrollbackSpillTests);
+
+    TEST_METHOD(EvictedRowsAreSpilled);
+    TEST_METHOD(ReadBackAcrossChunks);
+
+    static std::wstring _spillPath()
+    {
+        return (std::filesystem::temp_directory_path() / L"ScrollbackSpillTests.wtspill").wstring();
+    }
+
+    static void _deleteSpill(const std::wstring& path)
+    {
+        DeleteFileW(path.c_str());
+        DeleteFileW((path + L".idx").c_str());
+    }
+};
+
+static DummyRenderTarget target;
+
+void ScrollbackSpillTests::EvictedRowsAreSpilled()
+{
+    const auto path = _spillPath();
+    auto cleanup = wil::scope_exit([&]() { _deleteSpill(path); });
+
+    TextBuffer buffer{ { 10, 3 }, TextAttribute{ 0x7 }, 0, target };
+    auto spill = std::make_shared<ScrollbackSpill>(path);
+    buffer.SetScrollbackSpill(spill);
+
+    for (auto i = 0; i < 5; ++i)
+    {
+        auto& row = buffer.GetRowByOffset(buffer.GetSize().Height() - 1);
+        row.WriteCells(OutputCellIterator{ std::to_wstring(i), TextAttribute{ 0x1e } }, 0);
+        buffer.IncrementCircularBuffer();
+    }
+
+    // The first row is evicted with every increment, starting with the 2
+    // blank rows the buffer was created with.
+    VERIFY_ARE_EQUAL(5u, spill->RowCount());
+    VERIFY_ARE_EQUAL(L"          ", spill->GetRowText(0));
+    VERIFY_ARE_EQUAL(L"          ", spill->GetRowText(1));
+    VERIFY_ARE_EQUAL(L"0         ", spill->GetRowText(2));
+    VERIFY_ARE_EQUAL(L"2         ", spill->GetRowText(4));
+
+    TextBuffer destination{ { 10, 1 }, TextAttribute{ 0x7 }, 0, target };
+    auto& row = destination.GetRowByOffset(0);
+    spill->ReadRow(3, row);
+    VERIFY_ARE_EQUAL(L"1         ", row.GetText());
+    VERIFY_ARE_EQUAL(TextAttribute{ 0x1e }, row.GetAttrRow().GetAttrByColumn(0));
+}
+
+void ScrollbackSpillTests::ReadBackAcrossChunks()
+{
+    const auto path = _spillPath();
+    auto cleanup = wil::scope_exit([&]() { _deleteSpill(path); });
+
+    TextBuffer buffer{ { 10, 1 }, TextAttribute{ 0x7 }, 0, target };
+    const auto rowCount = ScrollbackSpill::RowsPerChunk * 2 + 10;
+
+    {
+        ScrollbackSpill spill{ path };
+        auto& row = buffer.GetRowByOffset(0);
+        for (size_t i = 0; i < rowCount; ++i)
+        {
+            row.Reset(TextAttribute{ 0x7 });
+            row.WriteCells(OutputCellIterator{ std::to_wstring(i), TextAttribute{ 0x7 } }, 0);
+            spill.Append(row);
+        }
+        VERIFY_ARE_EQUAL(rowCount, spill.RowCount());
+
+        Log::Comment(L"Rows must be readable whether they're written out or still pending.");
+        VERIFY_ARE_EQUAL(L"0         ", spill.GetRowText(0));
+        VERIFY_ARE_EQUAL(L"300       ", spill.GetRowText(300));
+        VERIFY_ARE_EQUAL(L"257       ", spill.GetRowText(257));
+        VERIFY_ARE_EQUAL(L"521       ", spill.GetRowText(rowCount - 1));
+        VERIFY_THROWS(spill.GetRowText(rowCount), wil::ResultException);
+
+        spill.Flush();
+        VERIFY_ARE_EQUAL(L"521       ", spill.GetRowText(rowCount - 1));
+    }
+
+    Log::Comment(L"Every chunk must have been appended to the index.");
+    WIN32_FILE_ATTRIBUTE_DATA data{};
+    VERIFY_WIN32_BOOL_SUCCEEDED(GetFileAttributesExW((path + L".idx").c_str(), GetFileExInfoStandard, &data));
+    VERIFY_ARE_EQUAL(3u * 32u, data.nFileSizeLow);
+}
@@ -0,0 +1,90 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "WexTestClass.h"
+#include "../../inc/consoletaeftemplates.hpp"
+
+#include "../textBuffer.hpp"
+#include "../../renderer/inc/DummyRenderTarget.hpp"
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+class TextBufferRunIteratorTests
+{
+    TEST_CLASS(TextBufferRunIteratorTests);
+
+    TEST_METHOD(RunsFollowAttributes);
+    TEST_METHOD(RunsAreClippedToRange);
+
+    struct Run
+    {
+        size_t left;
+        size_t right;
+        TextAttribute attr;
+        std::wstring text;
+    };
+
+    static void _verifyRuns(const ROW& row, const size_t left, const size_t right, const std::vector<Run>& expected)
+    {
+        size_t i = 0;
+        for (TextBufferRunIterator run{ row, left, right }; run; ++run, ++i)
+        {
+            Log::Comment(NoThrowString().Format(L"run %zu", i));
+            VERIFY_IS_LESS_THAN(i, expected.size());
+            VERIFY_ARE_EQUAL(expected[i].left, run.Left());
+            VERIFY_ARE_EQUAL(expected[i].right, run.Right());
+            VERIFY_ARE_EQUAL(expected[i].attr, run.TextAttr());
+
+            std::wstring text;
+            run.AppendText(text);
+            VERIFY_ARE_EQUAL(expected[i].text, text);
+        }
+        VERIFY_ARE_EQUAL(expected.size(), i);
+    }
+};
+
+static DummyRenderTarget target;
+
+void TextBufferRunIteratorTests::RunsFollowAttributes()
+{
+    TextBuffer buffer{ { 20, 2 }, TextAttribute{ 0x7 }, 0, target };
+    auto& row = buffer.GetRowByOffset(0);
+    row.WriteCells(OutputCellIterator{ L"ab\x6771", TextAttribute{ 0x1e } }, 0);
+    row.WriteCells(OutputCellIterator{ L"cd", TextAttribute{ 0x2f } }, 4);
+
+    _verifyRuns(row, 0, 20, {
+                                { 0, 4, TextAttribute{ 0x1e }, L"ab\x6771" },
+                                { 4, 6, TextAttribute{ 0x2f }, L"cd" },
+                                { 6, 20, TextAttribute{ 0x7 }, std::wstring(14, L' ') },
+                            });
+
+    Log::Comment(L"A row that was never written to is a single run.");
+    _verifyRuns(buffer.GetRowByOffset(1), 0, 20, { { 0, 20, TextAttribute{ 0x7 }, std::wstring(20, L' ') } });
+}
+
+void TextBufferRunIteratorTests::RunsAreClippedToRange()
+{
+    TextBuffer buffer{ { 20, 1 }, TextAttribute{ 0x7 }, 0, target };
+    auto& row = buffer.GetRowByOffset(0);
+    row.WriteCells(OutputCellIterator{ L"ab\x6771", TextAttribute{ 0x1e } }, 0);
+    row.WriteCells(OutputCellIterator{ L"cd", TextAttribute{ 0x2f } }, 4);
+
+    Log::Comment(L"A run that only holds the trailing half of a wide glyph has no text of its own.");
+    _verifyRuns(row, 3, 10, {
+                                { 3, 4, TextAttribute{ 0x1e }, L"" },
+                                { 4, 6, TextAttribute{ 0x2f }, L"cd" },
+                                { 6, 10, TextAttribute{ 0x7 }, L"    " },
+                            });
+
+    Log::Comment(L"The right column is clamped to the width of the row.");
+    _verifyRuns(row, 5, 100, {
+                                 { 5, 6, TextAttribute{ 0x2f }, L"d" },
+                                 { 6, 20, TextAttribute{ 0x7 }, std::wstring(14, L' ') },
+                             });
+
+    Log::Comment(L"An empty range has no runs at all.");
+    _verifyRuns(row, 7, 7, {});
+}
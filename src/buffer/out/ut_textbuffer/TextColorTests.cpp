@@ -22,6 +22,7 @@ class TextColorTests
     TEST_METHOD(TestBrightIndexColor);
     TEST_METHOD(TestRgbColor);
     TEST_METHOD(TestChangeColor);
+    TEST_METHOD(TestChangedColorEquality);
 
     std::array<COLORREF, 256> _colorTable;
     COLORREF _defaultFg = RGB(1, 2, 3);
@@ -195,3 +196,18 @@ void TextColorTests::TestChangeColor()
     color = rgbColor.GetColor(_colorTable, _defaultBg, true);
     VERIFY_ARE_EQUAL(_colorTable[15], color);
 }
+
+void TextColorTests::TestChangedColorEquality()
+{
+    const TextColor rgbColor{ RGB(7, 8, 9) };
+
+    Log::Comment(L"A color changed to an index must equal one constructed with it.");
+    auto color = rgbColor;
+    color.SetIndex(7, false);
+    VERIFY_ARE_EQUAL(TextColor(7, false), color);
+
+    Log::Comment(L"A color changed to the default must equal a default constructed one.");
+    color = rgbColor;
+    color.SetDefault();
+    VERIFY_ARE_EQUAL(TextColor(), color);
+}
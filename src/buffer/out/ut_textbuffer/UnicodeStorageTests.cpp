@@ -18,34 +18,73 @@ class UnicodeStorageTests
     TEST_METHOD(CanOverwriteEmoji)
     {
         UnicodeStorage storage;
-        const COORD coord{ 1, 3 };
-        const std::vector<wchar_t> newMoon{ 0xD83C, 0xDF11 };
-        const std::vector<wchar_t> fullMoon{ 0xD83C, 0xDF15 };
+        const UnicodeStorage::key_type column = 1;
+        const std::wstring_view newMoon{ L"\xD83C\xDF11" };
+        const std::wstring_view fullMoon{ L"\xD83C\xDF15" };
 
         // store initial glyph
-        storage.StoreGlyph(coord, newMoon);
+        storage.StoreGlyph(column, newMoon);
 
         // verify it was stored
-        auto findIt = storage._map.find(coord);
-        VERIFY_ARE_NOT_EQUAL(findIt, storage._map.end());
-        const std::vector<wchar_t>& newMoonGlyph = findIt->second;
-        VERIFY_ARE_EQUAL(newMoonGlyph.size(), newMoon.size());
-        for (size_t i = 0; i < newMoon.size(); ++i)
-        {
-            VERIFY_ARE_EQUAL(newMoonGlyph.at(i), newMoon.at(i));
-        }
+        VERIFY_ARE_EQUAL(1u, storage._entries.size());
+        VERIFY_ARE_EQUAL(newMoon, storage.GetText(column));
 
         // overwrite it
-        storage.StoreGlyph(coord, fullMoon);
-
-        // verify the glyph was overwritten
-        findIt = storage._map.find(coord);
-        VERIFY_ARE_NOT_EQUAL(findIt, storage._map.end());
-        const std::vector<wchar_t>& fullMoonGlyph = findIt->second;
-        VERIFY_ARE_EQUAL(fullMoonGlyph.size(), fullMoon.size());
-        for (size_t i = 0; i < fullMoon.size(); ++i)
-        {
-            VERIFY_ARE_EQUAL(fullMoonGlyph.at(i), fullMoon.at(i));
-        }
+        storage.StoreGlyph(column, fullMoon);
+
+        // verify the glyph was overwritten, in place
+        VERIFY_ARE_EQUAL(1u, storage._entries.size());
+        VERIFY_ARE_EQUAL(fullMoon, storage.GetText(column));
+        VERIFY_ARE_EQUAL(fullMoon.size(), storage._pool.size());
+    }
+
+    TEST_METHOD(KeepsColumnsApart)
+    {
+        UnicodeStorage storage;
+        const std::wstring_view eggplant{ L"\xD83C\xDF46" };
+        const std::wstring_view peach{ L"\xD83C\xDF51" };
+        const std::wstring_view family{ L"\xD83D\xDC68\x200D\xD83D\xDC69\x200D\xD83D\xDC67" };
+
+        // store them out of order
+        storage.StoreGlyph(7, peach);
+        storage.StoreGlyph(2, eggplant);
+        storage.StoreGlyph(4, family);
+
+        VERIFY_ARE_EQUAL(eggplant, storage.GetText(2));
+        VERIFY_ARE_EQUAL(family, storage.GetText(4));
+        VERIFY_ARE_EQUAL(peach, storage.GetText(7));
+        VERIFY_THROWS(storage.GetText(3), wil::ResultException);
+
+        // a longer glyph can't reuse the old spot, but the others must survive the move
+        storage.StoreGlyph(2, family);
+        VERIFY_ARE_EQUAL(family, storage.GetText(2));
+        VERIFY_ARE_EQUAL(family, storage.GetText(4));
+        VERIFY_ARE_EQUAL(peach, storage.GetText(7));
+        VERIFY_IS_LESS_THAN_OR_EQUAL(storage._unused, storage._pool.size() / 2);
+
+        storage.Erase(4);
+        VERIFY_THROWS(storage.GetText(4), wil::ResultException);
+        VERIFY_ARE_EQUAL(family, storage.GetText(2));
+        VERIFY_ARE_EQUAL(peach, storage.GetText(7));
+    }
+
+    TEST_METHOD(TrimDropsColumnsBeyondWidth)
+    {
+        UnicodeStorage storage;
+        const std::wstring_view eggplant{ L"\xD83C\xDF46" };
+
+        storage.StoreGlyph(2, eggplant);
+        storage.StoreGlyph(9, eggplant);
+
+        storage.Trim(10);
+        VERIFY_ARE_EQUAL(2u, storage._entries.size());
+
+        storage.Trim(9);
+        VERIFY_ARE_EQUAL(1u, storage._entries.size());
+        VERIFY_ARE_EQUAL(eggplant, storage.GetText(2));
+
+        storage.Trim(2);
+        VERIFY_IS_TRUE(storage._entries.empty());
+        VERIFY_IS_TRUE(storage._pool.empty());
     }
 };
@@ -44,6 +44,7 @@ namespace SettingsModelLocalTests
         TEST_METHOD(LayerScancodeKeybindings);
 
         TEST_METHOD(TestExplicitUnbind);
+        TEST_METHOD(TestInheritedKeyChordLookup);
 
         TEST_METHOD(TestArbitraryArgs);
         TEST_METHOD(TestSplitPaneArgs);
@@ -56,6 +57,7 @@ namespace SettingsModelLocalTests
 
         TEST_METHOD(TestToggleCommandPaletteArgs);
         TEST_METHOD(TestMoveTabArgs);
+        TEST_METHOD(TestExportBufferArgs);
 
         TEST_METHOD(TestGetKeyBindingForAction);
         TEST_METHOD(KeybindingsWithoutVkey);
@@ -272,6 +274,49 @@ namespace SettingsModelLocalTests
         VERIFY_IS_FALSE(actionMap->IsKeyChordExplicitlyUnbound(keyChord));
     }
 
+    void KeyBindingsTests::TestInheritedKeyChordLookup()
+    {
+        const std::string parentString{ R"([ { "command": "copy", "keys": ["ctrl+c"] }, { "command": "paste", "keys": ["ctrl+v"] } ])" };
+        const std::string childString{ R"([ { "command": "unbound", "keys": ["ctrl+c"] } ])" };
+        const std::string rebindString{ R"([ { "command": "closePane", "keys": ["ctrl+v"] } ])" };
+
+        const auto parentJson = VerifyParseSucceeded(parentString);
+        const auto childJson = VerifyParseSucceeded(childString);
+        const auto rebindJson = VerifyParseSucceeded(rebindString);
+
+        const KeyChord ctrlC{ VirtualKeyModifiers::Control, static_cast<int32_t>('C'), 0 };
+        const KeyChord ctrlV{ VirtualKeyModifiers::Control, static_cast<int32_t>('V'), 0 };
+        const KeyChord ctrlX{ VirtualKeyModifiers::Control, static_cast<int32_t>('X'), 0 };
+
+        auto parentMap = winrt::make_self<implementation::ActionMap>();
+        parentMap->LayerJson(parentJson);
+
+        auto childMap = winrt::make_self<implementation::ActionMap>();
+        childMap->InsertParent(parentMap);
+        childMap->LayerJson(childJson);
+
+        Log::Comment(L"The child's unbinding masks the parent's binding");
+        VERIFY_IS_NULL(childMap->GetActionByKeyChord(ctrlC));
+        VERIFY_IS_TRUE(childMap->IsKeyChordExplicitlyUnbound(ctrlC));
+
+        Log::Comment(L"Key chords that the child doesn't mention come from the parent");
+        const auto pasteCmd{ childMap->GetActionByKeyChord(ctrlV) };
+        VERIFY_IS_NOT_NULL(pasteCmd);
+        VERIFY_ARE_EQUAL(ShortcutAction::PasteText, pasteCmd.ActionAndArgs().Action());
+        VERIFY_IS_FALSE(childMap->IsKeyChordExplicitlyUnbound(ctrlV));
+
+        Log::Comment(L"Key chords nobody bound are neither bound nor unbound");
+        VERIFY_IS_NULL(childMap->GetActionByKeyChord(ctrlX));
+        VERIFY_IS_FALSE(childMap->IsKeyChordExplicitlyUnbound(ctrlX));
+
+        Log::Comment(L"Layering more bindings after a lookup refreshes the result");
+        childMap->LayerJson(rebindJson);
+        const auto closePaneCmd{ childMap->GetActionByKeyChord(ctrlV) };
+        VERIFY_IS_NOT_NULL(closePaneCmd);
+        VERIFY_ARE_EQUAL(ShortcutAction::ClosePane, closePaneCmd.ActionAndArgs().Action());
+        VERIFY_IS_NULL(childMap->GetActionByKeyChord(ctrlC));
+    }
+
     void KeyBindingsTests::TestArbitraryArgs()
     {
         const std::string bindings0String{ R"([
@@ -647,6 +692,38 @@ namespace SettingsModelLocalTests
         }
     }
 
+    void KeyBindingsTests::TestExportBufferArgs()
+    {
+        const std::string bindings0String{ R"([
+            { "keys": ["up"], "command": { "action": "exportBuffer", "path": "C:\\logs\\session.txt" } },
+            { "keys": ["down"], "command": "exportBuffer" }
+        ])" };
+
+        const auto bindings0Json = VerifyParseSucceeded(bindings0String);
+
+        auto actionMap = winrt::make_self<implementation::ActionMap>();
+        VERIFY_ARE_EQUAL(0u, actionMap->_KeyMap.size());
+        actionMap->LayerJson(bindings0Json);
+        VERIFY_ARE_EQUAL(2u, actionMap->_KeyMap.size());
+
+        {
+            KeyChord kc{ false, false, false, false, static_cast<int32_t>(VK_UP), 0 };
+            auto actionAndArgs = ::TestUtils::GetActionAndArgs(*actionMap, kc);
+            VERIFY_ARE_EQUAL(ShortcutAction::ExportBuffer, actionAndArgs.Action());
+            const auto& realArgs = actionAndArgs.Args().as<ExportBufferArgs>();
+            // Verify the args have the expected value
+            VERIFY_ARE_EQUAL(L"C:\\logs\\session.txt", realArgs.Path());
+        }
+        {
+            KeyChord kc{ false, false, false, false, static_cast<int32_t>(VK_DOWN), 0 };
+            auto actionAndArgs = ::TestUtils::GetActionAndArgs(*actionMap, kc);
+            VERIFY_ARE_EQUAL(ShortcutAction::ExportBuffer, actionAndArgs.Action());
+            const auto& realArgs = actionAndArgs.Args().as<ExportBufferArgs>();
+            // Verify the args have the expected value
+            VERIFY_IS_TRUE(realArgs.Path().empty());
+        }
+    }
+
     void KeyBindingsTests::TestToggleCommandPaletteArgs()
     {
         const std::string bindings0String{ R"([
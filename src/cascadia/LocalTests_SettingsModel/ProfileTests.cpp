@@ -36,6 +36,7 @@ namespace SettingsModelLocalTests
         TEST_METHOD(LayerProfileProperties);
         TEST_METHOD(LayerProfileIcon);
         TEST_METHOD(LayerProfilesOnArray);
+        TEST_METHOD(LayerProfilesAfterReordering);
         TEST_METHOD(DuplicateProfileTest);
 
         TEST_CLASS_SETUP(ClassSetup)
@@ -308,6 +309,51 @@ namespace SettingsModelLocalTests
         VERIFY_ARE_EQUAL(L"profile4", settings->_allProfiles.GetAt(0).Name());
     }
 
+    void ProfileTests::LayerProfilesAfterReordering()
+    {
+        // _FindMatchingProfileIndex keeps an index of the profiles by GUID.
+        // Make sure it isn't fooled by profiles that moved around in the meantime.
+        const std::string profile0String{ R"({
+            "name" : "profile0",
+            "guid" : "{6239a42c-0000-49a3-80bd-e8fdd045185c}"
+        })" };
+        const std::string profile1String{ R"({
+            "name" : "profile1",
+            "guid" : "{6239a42c-1111-49a3-80bd-e8fdd045185c}"
+        })" };
+        const std::string profile2String{ R"({
+            "name" : "profile2"
+        })" };
+
+        const auto profile0Json = VerifyParseSucceeded(profile0String);
+        const auto profile1Json = VerifyParseSucceeded(profile1String);
+        const auto profile2Json = VerifyParseSucceeded(profile2String);
+
+        auto settings = winrt::make_self<implementation::CascadiaSettings>();
+        settings->_LayerOrCreateProfile(profile0Json);
+        settings->_LayerOrCreateProfile(profile1Json);
+        settings->_LayerOrCreateProfile(profile2Json);
+        VERIFY_ARE_EQUAL(3u, settings->_allProfiles.Size());
+        VERIFY_ARE_EQUAL(0u, settings->_FindMatchingProfileIndex(profile0Json).value());
+        VERIFY_ARE_EQUAL(1u, settings->_FindMatchingProfileIndex(profile1Json).value());
+        VERIFY_ARE_EQUAL(2u, settings->_FindMatchingProfileIndex(profile2Json).value());
+
+        Log::Comment(L"Swap the first and the last profile");
+        const auto profile0 = settings->_allProfiles.GetAt(0);
+        settings->_allProfiles.SetAt(0, settings->_allProfiles.GetAt(2));
+        settings->_allProfiles.SetAt(2, profile0);
+
+        VERIFY_ARE_EQUAL(2u, settings->_FindMatchingProfileIndex(profile0Json).value());
+        VERIFY_ARE_EQUAL(1u, settings->_FindMatchingProfileIndex(profile1Json).value());
+        VERIFY_ARE_EQUAL(0u, settings->_FindMatchingProfileIndex(profile2Json).value());
+
+        Log::Comment(L"Layering must still happen on the right profiles");
+        settings->_LayerOrCreateProfile(profile2Json);
+        VERIFY_ARE_EQUAL(3u, settings->_allProfiles.Size());
+        VERIFY_ARE_EQUAL(L"profile2", settings->_allProfiles.GetAt(0).Name());
+        VERIFY_ARE_EQUAL(L"profile0", settings->_allProfiles.GetAt(2).Name());
+    }
+
     void ProfileTests::DuplicateProfileTest()
     {
         const std::string profile0String{ R"({
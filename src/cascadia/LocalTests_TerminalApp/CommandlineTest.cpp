@@ -77,6 +77,7 @@ namespace TerminalAppLocalTests
         TEST_METHOD(TestFindTargetWindow);
         TEST_METHOD(TestFindTargetWindowHelp);
         TEST_METHOD(TestFindTargetWindowVersion);
+        TEST_METHOD(TestFindTargetWindowStartupProfile);
 
     private:
         void _buildCommandlinesHelper(AppCommandlineArgs& appArgs,
@@ -2073,4 +2074,33 @@ namespace TerminalAppLocalTests
 
         testHelper(std::vector<winrt::hstring>{ L"wt.exe", L"--version" });
     }
+
+    void CommandlineTest::TestFindTargetWindowStartupProfile()
+    {
+        Log::Comment(L"--startup-profile should always create a new window, even when a target window is given");
+
+        auto testHelper = [](auto&& args) {
+            auto result = appImpl::AppLogic::_doFindTargetWindow({ args }, WindowingMode::UseNew);
+            VERIFY_ARE_EQUAL(WindowingBehaviorUseNew, result.WindowId());
+            VERIFY_ARE_EQUAL(L"", result.WindowName());
+
+            result = appImpl::AppLogic::_doFindTargetWindow({ args }, WindowingMode::UseExisting);
+            VERIFY_ARE_EQUAL(WindowingBehaviorUseNew, result.WindowId());
+            VERIFY_ARE_EQUAL(L"", result.WindowName());
+
+            result = appImpl::AppLogic::_doFindTargetWindow({ args }, WindowingMode::UseAnyExisting);
+            VERIFY_ARE_EQUAL(WindowingBehaviorUseNew, result.WindowId());
+            VERIFY_ARE_EQUAL(L"", result.WindowName());
+        };
+
+        testHelper(std::vector<winrt::hstring>{ L"wt.exe", L"--startup-profile", L"startup.json" });
+        testHelper(std::vector<winrt::hstring>{ L"wt.exe", L"-w", L"0", L"--startup-profile", L"startup.json", L"new-tab" });
+
+        Log::Comment(L"The path is available after parsing the commandline");
+        ::TerminalApp::AppCommandlineArgs appArgs{};
+        std::vector<winrt::hstring> args{ L"wt.exe", L"--startup-profile", L"C:\\temp\\startup.json", L"nt" };
+        winrt::array_view<const winrt::hstring> argsView{ args };
+        VERIFY_ARE_EQUAL(0, appArgs.ParseArgs(argsView));
+        VERIFY_IS_TRUE(appArgs.GetStartupProfilePath() == "C:\\temp\\startup.json");
+    }
 }
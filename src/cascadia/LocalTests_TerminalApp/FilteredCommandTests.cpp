@@ -104,6 +104,15 @@ namespace TerminalAppLocalTests
                 VERIFY_ARE_EQUAL(segments.GetAt(0).TextSegment(), L"AAAAAABBBBBBCCC");
                 VERIFY_IS_FALSE(segments.GetAt(0).IsHighlighted());
             }
+            {
+                Log::Comment(L"Testing command name segmentation with filter of matching characters in the wrong order");
+                const auto filteredCommand = winrt::make_self<winrt::TerminalApp::implementation::FilteredCommand>(paletteItem);
+                filteredCommand->_Filter = L"ca";
+                auto segments = filteredCommand->_computeHighlightedName().Segments();
+                VERIFY_ARE_EQUAL(segments.Size(), 1u);
+                VERIFY_ARE_EQUAL(segments.GetAt(0).TextSegment(), L"AAAAAABBBBBBCCC");
+                VERIFY_IS_FALSE(segments.GetAt(0).IsHighlighted());
+            }
         });
 
         VERIFY_SUCCEEDED(result);
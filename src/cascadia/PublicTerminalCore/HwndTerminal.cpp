@@ -246,6 +246,10 @@ HRESULT HwndTerminal::Initialize()
 
     _multiClickTime = std::chrono::milliseconds{ GetDoubleClickTime() };
 
+    auto [tx, rx] = til::mpsc::channel<char>(OutputChannelCapacity);
+    _outputTx.emplace(std::move(tx));
+    _outputThread = std::thread([this, rx = std::move(rx)]() mutable { _OutputThread(std::move(rx)); });
+
     return S_OK;
 }
 
@@ -255,6 +259,14 @@ try
     // As a rule, detach resources from the Terminal before shutting them down.
     // This ensures that teardown is reentrant.
 
+    // Dropping the producer closes the channel. The output thread
+    // parses whatever is still queued and exits.
+    _outputTx.reset();
+    if (_outputThread.joinable())
+    {
+        _outputThread.join();
+    }
+
     // Shut down the renderer (and therefore the thread) before we implode
     if (auto localRenderEngine{ std::exchange(_renderEngine, nullptr) })
     {
@@ -380,6 +392,51 @@ void HwndTerminal::SendOutput(std::wstring_view data)
     _terminal->Write(data);
 }
 
+// Method Description:
+// - Queues UTF-8 encoded output to be parsed on the output thread.
+// - This only blocks if the parser has fallen behind by more than
+//   OutputChannelCapacity bytes, until enough of them have been processed.
+// Arguments:
+// - data - The UTF-8 encoded output. It doesn't need to end on a character boundary.
+void HwndTerminal::SendOutputUtf8(std::string_view data)
+{
+    if (_outputTx)
+    {
+        _outputTx->push(data.begin(), data.end());
+    }
+}
+
+// Method Description:
+// - The body of the output thread. It converts the queued UTF-8 into UTF-16
+//   and writes it into the terminal, until the channel is closed by Teardown.
+// Arguments:
+// - rx - The receiving end of the output channel.
+void HwndTerminal::_OutputThread(til::mpsc::consumer<char> rx) noexcept
+try
+{
+    std::string u8Str(OutputChannelCapacity, '\0');
+    std::wstring u16Str;
+    til::u8state u8State;
+
+    for (;;)
+    {
+        // This waits for at least one byte, but takes everything that's already
+        // queued, so that a burst of output is parsed with a single write.
+        const auto count = rx.pop_n(til::mpsc::block_initially, u8Str.begin(), u8Str.size()).first;
+        if (count == 0)
+        {
+            // All producers are gone.
+            break;
+        }
+
+        if (SUCCEEDED_LOG(til::u8u16({ u8Str.data(), count }, u16Str, u8State)) && !u16Str.empty())
+        {
+            _terminal->Write(u16Str);
+        }
+    }
+}
+CATCH_LOG();
+
 HRESULT _stdcall CreateTerminal(HWND parentHwnd, _Out_ void** hwnd, _Out_ void** terminal)
 {
     // In order for UIA to hook up properly there needs to be a "static" window hosting the
@@ -428,6 +485,22 @@ void _stdcall TerminalSendOutput(void* terminal, LPCWSTR data)
     publicTerminal->SendOutput(data);
 }
 
+/// <summary>
+/// Queues UTF-8 encoded output for the terminal. Unlike TerminalSendOutput the
+/// data is parsed on a separate thread and doesn't need to be null-terminated.
+/// The write and scroll callbacks triggered by this output are invoked on that thread as well.
+/// </summary>
+/// <param name="terminal">Terminal pointer.</param>
+/// <param name="data">UTF-8 encoded output. It may end in the middle of a character.</param>
+/// <param name="length">Length of data in bytes.</param>
+void _stdcall TerminalSendOutputUtf8(void* terminal, const char* data, size_t length)
+try
+{
+    const auto publicTerminal = static_cast<HwndTerminal*>(terminal);
+    publicTerminal->SendOutputUtf8({ data, length });
+}
+CATCH_LOG();
+
 /// <summary>
 /// Triggers a terminal resize using the new width and height in pixel.
 /// </summary>
@@ -9,6 +9,7 @@
 #include <UIAutomationCore.h>
 #include "../../types/IControlAccessibilityInfo.h"
 #include "../../types/TermControlUiaProvider.hpp"
+#include <til/mpsc.h>
 
 using namespace Microsoft::Console::VirtualTerminal;
 
@@ -26,6 +27,7 @@ typedef struct _TerminalTheme
 extern "C" {
 __declspec(dllexport) HRESULT _stdcall CreateTerminal(HWND parentHwnd, _Out_ void** hwnd, _Out_ void** terminal);
 __declspec(dllexport) void _stdcall TerminalSendOutput(void* terminal, LPCWSTR data);
+__declspec(dllexport) void _stdcall TerminalSendOutputUtf8(void* terminal, const char* data, size_t length);
 __declspec(dllexport) void _stdcall TerminalRegisterScrollCallback(void* terminal, void __stdcall callback(int, int, int));
 __declspec(dllexport) HRESULT _stdcall TerminalTriggerResize(_In_ void* terminal, _In_ short width, _In_ short height, _Out_ COORD* dimensions);
 __declspec(dllexport) HRESULT _stdcall TerminalTriggerResizeWithDimension(_In_ void* terminal, _In_ COORD dimensions, _Out_ SIZE* dimensionsInPixels);
@@ -60,6 +62,7 @@ public:
     HRESULT Initialize();
     void Teardown() noexcept;
     void SendOutput(std::wstring_view data);
+    void SendOutputUtf8(std::string_view data);
     HRESULT Refresh(const SIZE windowSize, _Out_ COORD* dimensions);
     void RegisterScrollCallback(std::function<void(int, int, int)> callback);
     void RegisterWriteCallback(const void _stdcall callback(wchar_t*));
@@ -84,6 +87,13 @@ private:
     bool _focused{ false };
     bool _uiaProviderInitialized{ false };
 
+    // UTF-8 output given to SendOutputUtf8 is parsed on this thread, so that
+    // large outputs don't block the caller (usually the UI thread).
+    // The channel is bounded, which throttles callers that outpace the parser.
+    static constexpr uint32_t OutputChannelCapacity{ 128 * 1024 };
+    std::optional<til::mpsc::producer<char>> _outputTx;
+    std::thread _outputThread;
+
     std::chrono::milliseconds _multiClickTime;
     unsigned int _multiClickCounter{};
     std::chrono::steady_clock::time_point _lastMouseClickTimestamp{};
@@ -108,6 +118,7 @@ private:
     friend void _stdcall TerminalKillFocus(void* terminal);
 
     void _UpdateFont(int newDpi);
+    void _OutputThread(til::mpsc::consumer<char> rx) noexcept;
     void _WriteTextToConnection(const std::wstring& text) noexcept;
     HRESULT _CopyTextToSystemClipboard(const TextBuffer::TextAndColor& rows, bool const fAlsoCopyFormatting);
     HRESULT _CopyToSystemClipboard(std::string stringToCopy, LPCWSTR lpszFormat);
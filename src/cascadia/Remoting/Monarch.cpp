@@ -146,16 +146,27 @@ namespace winrt::Microsoft::Terminal::Remoting::implementation
         catch (...)
         {
             LOG_CAUGHT_EXCEPTION();
-            // Remove the peasant from the list of peasants
-            _peasants.erase(peasantID);
-
-            // Remove the peasant from the list of MRU windows. They're dead.
-            // They can't be the MRU anymore.
-            _clearOldMruEntries(peasantID);
+            _removeDeadPeasant(peasantID);
             return nullptr;
         }
     }
 
+    // Method Description:
+    // - Forget about a peasant that we found to be dead.
+    // Arguments:
+    // - peasantID: The ID Of the dead peasant
+    // Return Value:
+    // - <none>
+    void Monarch::_removeDeadPeasant(const uint64_t peasantID)
+    {
+        // Remove the peasant from the list of peasants
+        _peasants.erase(peasantID);
+
+        // Remove the peasant from the list of MRU windows. They're dead.
+        // They can't be the MRU anymore.
+        _clearOldMruEntries(peasantID);
+    }
+
     // Method Description:
     // - Find the ID of the peasant with the given name. If no such peasant
     //   exists, then we'll return 0. If we encounter any peasants who have died
@@ -172,13 +183,47 @@ namespace winrt::Microsoft::Terminal::Remoting::implementation
             return 0;
         }
 
+        // Every call to a peasant is a cross-process call. Before asking all
+        // of them for their names, ask only the one that had this name when
+        // we last looked.
+        if (const auto hint = _peasantIdsByName.find(std::wstring{ name }); hint != _peasantIdsByName.end())
+        {
+            const auto hintedID = hint->second;
+            if (const auto peasantSearch = _peasants.find(hintedID); peasantSearch != _peasants.end())
+            {
+                try
+                {
+                    if (peasantSearch->second.WindowName() == name)
+                    {
+                        TraceLoggingWrite(g_hRemotingProvider,
+                                          "Monarch_lookupPeasantIdForName",
+                                          TraceLoggingWideString(std::wstring{ name }.c_str(), "name", "the name we're looking for"),
+                                          TraceLoggingUInt64(hintedID, "peasantID", "the ID of the peasant with that name"),
+                                          TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+                                          TraceLoggingKeyword(TIL_KEYWORD_TRACE));
+                        return hintedID;
+                    }
+                }
+                catch (...)
+                {
+                    LOG_CAUGHT_EXCEPTION();
+                    _removeDeadPeasant(hintedID);
+                }
+            }
+        }
+
         std::vector<uint64_t> peasantsToErase{};
         uint64_t result = 0;
+        _peasantIdsByName.clear();
         for (const auto& [id, p] : _peasants)
         {
             try
             {
                 auto otherName = p.WindowName();
+                if (!otherName.empty())
+                {
+                    _peasantIdsByName.insert_or_assign(std::wstring{ otherName }, id);
+                }
                 if (otherName == name)
                 {
                     result = id;
@@ -199,11 +244,7 @@ namespace winrt::Microsoft::Terminal::Remoting::implementation
         // Remove the dead peasants we came across while iterating.
         for (const auto& id : peasantsToErase)
         {
-            // Remove the peasant from the list of peasants
-            _peasants.erase(id);
-            // Remove the peasant from the list of MRU windows. They're dead.
-            // They can't be the MRU anymore.
-            _clearOldMruEntries(id);
+            _removeDeadPeasant(id);
         }
 
         TraceLoggingWrite(g_hRemotingProvider,
@@ -381,7 +422,32 @@ namespace winrt::Microsoft::Terminal::Remoting::implementation
         while (_mruPeasants.cbegin() + positionInList < _mruPeasants.cend())
         {
             const auto mruWindowArgs{ *(_mruPeasants.begin() + positionInList) };
-            const auto peasant{ _getPeasant(mruWindowArgs.PeasantID()) };
+            const auto peasantID{ mruWindowArgs.PeasantID() };
+            Remoting::IPeasant peasant{ nullptr };
+            bool isQuakeWindow = false;
+            if (ignoreQuakeWindow)
+            {
+                // Asking for the name already tells us whether the peasant is
+                // alive, so skip the extra cross-process call in _getPeasant.
+                if (const auto peasantSearch = _peasants.find(peasantID); peasantSearch != _peasants.end())
+                {
+                    try
+                    {
+                        isQuakeWindow = peasantSearch->second.WindowName() == QuakeWindowName;
+                        peasant = peasantSearch->second;
+                    }
+                    catch (...)
+                    {
+                        LOG_CAUGHT_EXCEPTION();
+                        _removeDeadPeasant(peasantID);
+                    }
+                }
+            }
+            else
+            {
+                peasant = _getPeasant(peasantID);
+            }
+
             if (!peasant)
             {
                 TraceLoggingWrite(g_hRemotingProvider,
@@ -398,7 +464,7 @@ namespace winrt::Microsoft::Terminal::Remoting::implementation
                 continue;
             }
 
-            if (ignoreQuakeWindow && peasant.WindowName() == QuakeWindowName)
+            if (isQuakeWindow)
             {
                 // The _quake window should never be treated as the MRU window.
                 // Skip it if we see it. Users can still target it with `wt -w
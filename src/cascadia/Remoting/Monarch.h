@@ -71,9 +71,15 @@ namespace winrt::Microsoft::Terminal::Remoting::implementation
 
         std::vector<Remoting::WindowActivatedArgs> _mruPeasants;
 
+        // The ID of the peasant that had each name the last time we asked.
+        // Peasants may have been renamed since, so an entry is only a hint
+        // that saves us from asking every peasant for its name.
+        std::unordered_map<std::wstring, uint64_t> _peasantIdsByName;
+
         winrt::Microsoft::Terminal::Remoting::IPeasant _getPeasant(uint64_t peasantID);
         uint64_t _getMostRecentPeasantID(bool limitToCurrentDesktop, const bool ignoreQuakeWindow);
         uint64_t _lookupPeasantIdForName(std::wstring_view name);
+        void _removeDeadPeasant(const uint64_t peasantID);
 
         void _peasantWindowActivated(const winrt::Windows::Foundation::IInspectable& sender,
                                      const winrt::Microsoft::Terminal::Remoting::WindowActivatedArgs& args);
@@ -216,6 +216,17 @@ namespace winrt::TerminalApp::implementation
         args.Handled(true);
     }
 
+    void TerminalPage::_HandleToggleBroadcastInput(const IInspectable& /*sender*/,
+                                                   const ActionEventArgs& args)
+    {
+        if (const auto activeTab{ _GetFocusedTabImpl() })
+        {
+            activeTab->ToggleBroadcastInput();
+        }
+
+        args.Handled(true);
+    }
+
     void TerminalPage::_HandleScrollUpPage(const IInspectable& /*sender*/,
                                            const ActionEventArgs& args)
     {
@@ -244,6 +255,36 @@ namespace winrt::TerminalApp::implementation
         args.Handled(true);
     }
 
+    void TerminalPage::_HandleScrollToPreviousCommand(const IInspectable& /*sender*/,
+                                                      const ActionEventArgs& args)
+    {
+        if (const auto& control{ _GetActiveControl() })
+        {
+            control.ScrollToCommand(true);
+            args.Handled(true);
+        }
+    }
+
+    void TerminalPage::_HandleScrollToNextCommand(const IInspectable& /*sender*/,
+                                                  const ActionEventArgs& args)
+    {
+        if (const auto& control{ _GetActiveControl() })
+        {
+            control.ScrollToCommand(false);
+            args.Handled(true);
+        }
+    }
+
+    void TerminalPage::_HandleSelectCommandOutput(const IInspectable& /*sender*/,
+                                                  const ActionEventArgs& args)
+    {
+        if (const auto& control{ _GetActiveControl() })
+        {
+            control.SelectCommandOutput();
+            args.Handled(true);
+        }
+    }
+
     void TerminalPage::_HandleFindMatch(const IInspectable& /*sender*/,
                                         const ActionEventArgs& args)
     {
@@ -405,6 +446,16 @@ namespace winrt::TerminalApp::implementation
         }
     }
 
+    void TerminalPage::_HandleTogglePerformanceOverlay(const IInspectable& /*sender*/,
+                                                       const ActionEventArgs& args)
+    {
+        if (const auto& termControl{ _GetActiveControl() })
+        {
+            termControl.TogglePerformanceOverlay();
+            args.Handled(true);
+        }
+    }
+
     void TerminalPage::_HandleToggleFocusMode(const IInspectable& /*sender*/,
                                               const ActionEventArgs& args)
     {
@@ -891,4 +942,26 @@ namespace winrt::TerminalApp::implementation
             }
         }
     }
+
+    void TerminalPage::_HandleExportBuffer(const IInspectable& /*sender*/,
+                                           const ActionEventArgs& args)
+    {
+        if (args)
+        {
+            if (const auto& realArgs = args.ActionArgs().try_as<ExportBufferArgs>())
+            {
+                // There's nowhere to write the buffer to without a path.
+                if (realArgs.Path().empty())
+                {
+                    return;
+                }
+
+                if (const auto& control{ _GetActiveControl() })
+                {
+                    control.ExportBuffer(realArgs.Path());
+                    args.Handled(true);
+                }
+            }
+        }
+    }
 }
@@ -187,6 +187,10 @@ void AppCommandlineArgs::_buildParser()
                     _windowTarget,
                     RS_A(L"CmdWindowTargetArgDesc"));
 
+    _app.add_option("--startup-profile",
+                    _startupProfilePath,
+                    RS_A(L"CmdStartupProfileArgDesc"));
+
     // Subcommands
     _buildNewTabParser();
     _buildSplitPaneParser();
@@ -1052,9 +1056,19 @@ void AppCommandlineArgs::FullResetState()
     _isHandoffListener = false;
 
     _windowTarget = {};
+    _startupProfilePath = {};
 }
 
 std::string_view AppCommandlineArgs::GetTargetWindow() const noexcept
 {
     return _windowTarget;
 }
+
+// Method Description:
+// - Returns the path of the file that the startup phase timings should be
+//   written to, as passed with `--startup-profile`. This is empty if no
+//   profile was requested.
+std::string_view AppCommandlineArgs::GetStartupProfilePath() const noexcept
+{
+    return _startupProfilePath;
+}
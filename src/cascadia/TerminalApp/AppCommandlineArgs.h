@@ -46,6 +46,7 @@ public:
     void FullResetState();
 
     std::string_view GetTargetWindow() const noexcept;
+    std::string_view GetStartupProfilePath() const noexcept;
 
 private:
     static const std::wregex _commandDelimiterRegex;
@@ -124,6 +125,7 @@ private:
     bool _shouldExitEarly{ false };
 
     std::string _windowTarget{};
+    std::string _startupProfilePath{};
     // Are you adding more args or attributes here? If they are not reset in _resetStateToDefault, make sure to reset them in FullResetState
 
     winrt::Microsoft::Terminal::Settings::Model::NewTerminalArgs _getNewTerminalArgs(NewTerminalSubcommand& subcommand);
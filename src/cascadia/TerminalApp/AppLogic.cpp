@@ -202,6 +202,7 @@ namespace winrt::TerminalApp::implementation
         // SetTitleBarContent
         _isElevated = _isUserAdmin();
         _root = winrt::make_self<TerminalPage>();
+        _root->SetStartupProfiler(_startupProfiler);
 
         _reloadSettings = std::make_shared<ThrottledFuncTrailing<>>(winrt::Windows::System::DispatcherQueue::GetForCurrentThread(), std::chrono::milliseconds(100), [weakSelf = get_weak()]() {
             if (auto self{ weakSelf.get() })
@@ -313,8 +314,14 @@ namespace winrt::TerminalApp::implementation
             {
                 _root->ToggleFocusMode();
             }
+
+            _startupProfiler->StopPhase(::TerminalApp::StartupProfiler::StartupActions);
         });
+
+        _startupProfiler->StartPhase(::TerminalApp::StartupProfiler::CreatePage);
         _root->Create();
+        _startupProfiler->StopPhase(::TerminalApp::StartupProfiler::CreatePage);
+        _startupProfiler->StartPhase(::TerminalApp::StartupProfiler::XamlLoad);
 
         _ApplyLanguageSettingChange();
         _RefreshThemeRoutine();
@@ -513,6 +520,9 @@ namespace winrt::TerminalApp::implementation
     void AppLogic::_OnLoaded(const IInspectable& /*sender*/,
                              const RoutedEventArgs& /*eventArgs*/)
     {
+        _startupProfiler->StopPhase(::TerminalApp::StartupProfiler::XamlLoad);
+        _startupProfiler->StartPhase(::TerminalApp::StartupProfiler::StartupActions);
+
         if (_settings.GlobalSettings().InputServiceWarning())
         {
             const auto keyboardServiceIsDisabled = !_IsKeyboardServiceEnabled();
@@ -816,6 +826,7 @@ namespace winrt::TerminalApp::implementation
     //      happening during startup, it'll need to happen on a background thread.
     void AppLogic::LoadSettings()
     {
+        _startupProfiler->StartPhase(::TerminalApp::StartupProfiler::LoadSettings);
         auto start = std::chrono::high_resolution_clock::now();
 
         TraceLoggingWrite(
@@ -857,6 +868,8 @@ namespace winrt::TerminalApp::implementation
         _RegisterSettingsChange();
 
         Jumplist::UpdateJumplist(_settings);
+
+        _startupProfiler->StopPhase(::TerminalApp::StartupProfiler::LoadSettings);
     }
 
     // Method Description:
@@ -1129,6 +1142,21 @@ namespace winrt::TerminalApp::implementation
         }
     }
 
+    // Method Description:
+    // - Used to tell the app that the window was minimized or restored, so
+    //   that the terminals don't paint while nobody can see them.
+    // Arguments:
+    // - showOrHide: false if the window was minimized, true if it was restored.
+    // Return Value:
+    // - <none>
+    void AppLogic::WindowVisibilityChanged(const bool showOrHide)
+    {
+        if (_root)
+        {
+            _root->WindowVisibilityChanged(showOrHide);
+        }
+    }
+
     winrt::TerminalApp::TaskbarState AppLogic::TaskbarState()
     {
         if (_root)
@@ -1154,9 +1182,13 @@ namespace winrt::TerminalApp::implementation
     //   or 0. (see AppLogic::_ParseArgs)
     int32_t AppLogic::SetStartupCommandline(array_view<const winrt::hstring> args)
     {
+        _startupProfiler->StartPhase(::TerminalApp::StartupProfiler::ParseCommandline);
         const auto result = _appArgs.ParseArgs(args);
+        _startupProfiler->StopPhase(::TerminalApp::StartupProfiler::ParseCommandline);
         if (result == 0)
         {
+            _startupProfiler->SetOutputPath(til::u8u16(_appArgs.GetStartupProfilePath()));
+
             // If the size of the arguments list is 1,
             // then it contains only the executable name and no other arguments.
             _hasCommandLineArguments = args.size() > 1;
@@ -1268,6 +1300,13 @@ namespace winrt::TerminalApp::implementation
                 return winrt::make<FindTargetWindowResult>(WindowingBehaviorUseNew);
             }
 
+            // Only a new window goes through startup, so there wouldn't be
+            // anything to profile in an existing one.
+            if (!appArgs.GetStartupProfilePath().empty())
+            {
+                return winrt::make<FindTargetWindowResult>(WindowingBehaviorUseNew);
+            }
+
             const std::string parsedTarget{ appArgs.GetTargetWindow() };
 
             // If the user did not provide any value on the commandline,
@@ -7,6 +7,7 @@
 #include "FindTargetWindowResult.g.h"
 #include "Jumplist.h"
 #include "LanguageProfileNotifier.h"
+#include "StartupProfiler.h"
 #include "TerminalPage.h"
 
 #include <inc/cppwinrt_utils.h>
@@ -89,6 +90,7 @@ namespace winrt::TerminalApp::implementation
         bool OnDirectKeyEvent(const uint32_t vkey, const uint8_t scanCode, const bool down);
 
         void WindowCloseButtonClicked();
+        void WindowVisibilityChanged(const bool showOrHide);
 
         winrt::TerminalApp::TaskbarState TaskbarState();
 
@@ -107,6 +109,9 @@ namespace winrt::TerminalApp::implementation
         bool _isUwp{ false };
         bool _isElevated{ false };
 
+        // Constructed first, so that the ProcessLaunch phase ends as early as possible.
+        std::shared_ptr<::TerminalApp::StartupProfiler> _startupProfiler{ std::make_shared<::TerminalApp::StartupProfiler>() };
+
         // If you add controls here, but forget to null them either here or in
         // the ctor, you're going to have a bad time. It'll mysteriously fail to
         // activate the AppLogic.
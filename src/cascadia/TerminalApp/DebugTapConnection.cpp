@@ -45,7 +45,20 @@ namespace winrt::Microsoft::TerminalApp::implementation
 
     DebugTapConnection::DebugTapConnection(ITerminalConnection wrappedConnection)
     {
-        _outputRevoker = wrappedConnection.TerminalOutput(winrt::auto_revoke, { this, &DebugTapConnection::_OutputHandler });
+        // Read straight from the buffer of the wrapped connection, if it lends it to us.
+        if (const auto outputView = wrappedConnection.try_as<ITerminalOutputView>())
+        {
+            _outputViewRevoker = outputView.TerminalOutputView(winrt::auto_revoke, [this](const winrt::array_view<const char16_t> output) {
+#pragma warning(suppress : 26490) // wchar_t and char16_t are the same UTF-16 code units.
+                _OutputHandler({ reinterpret_cast<const wchar_t*>(output.data()), output.size() });
+            });
+        }
+        else
+        {
+            _outputRevoker = wrappedConnection.TerminalOutput(winrt::auto_revoke, [this](const hstring& output) {
+                _OutputHandler(output);
+            });
+        }
         _stateChangedRevoker = wrappedConnection.StateChanged(winrt::auto_revoke, [this](auto&& /*s*/, auto&& /*e*/) {
             _StateChangedHandlers(*this, nullptr);
         });
@@ -79,6 +92,7 @@ namespace winrt::Microsoft::TerminalApp::implementation
     void DebugTapConnection::Close()
     {
         _outputRevoker.revoke();
+        _outputViewRevoker.revoke();
         _stateChangedRevoker.revoke();
         _wrappedConnection = nullptr;
     }
@@ -92,9 +106,9 @@ namespace winrt::Microsoft::TerminalApp::implementation
         return ConnectionState::Failed;
     }
 
-    void DebugTapConnection::_OutputHandler(const hstring str)
+    void DebugTapConnection::_OutputHandler(const std::wstring_view str)
     {
-        _TerminalOutputHandlers(til::visualize_control_codes(str));
+        _raiseOutput(til::visualize_control_codes(str));
     }
 
     // Called by the DebugInputTapConnection to print user input
@@ -102,7 +116,7 @@ namespace winrt::Microsoft::TerminalApp::implementation
     {
         auto clean{ til::visualize_control_codes(str) };
         auto formatted{ wil::str_printf<std::wstring>(L"\x1b[91m%ls\x1b[m", clean.data()) };
-        _TerminalOutputHandlers(formatted);
+        _raiseOutput(formatted);
     }
 
     // Wire us up so that we can forward input through
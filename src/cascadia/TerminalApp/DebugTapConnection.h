@@ -5,11 +5,13 @@
 
 #include <winrt/Microsoft.Terminal.TerminalConnection.h>
 #include "../../inc/cppwinrt_utils.h"
+#include "../TerminalConnection/ConnectionOutputHolder.h"
 
 namespace winrt::Microsoft::TerminalApp::implementation
 {
     class DebugInputTapConnection;
-    class DebugTapConnection : public winrt::implements<DebugTapConnection, winrt::Microsoft::Terminal::TerminalConnection::ITerminalConnection>
+    class DebugTapConnection : public winrt::implements<DebugTapConnection, winrt::Microsoft::Terminal::TerminalConnection::ITerminalConnection, winrt::Microsoft::Terminal::TerminalConnection::ITerminalOutputView>,
+                               public winrt::Microsoft::Terminal::TerminalConnection::implementation::ConnectionOutputHolder
     {
     public:
         explicit DebugTapConnection(Microsoft::Terminal::TerminalConnection::ITerminalConnection wrappedConnection);
@@ -23,15 +25,14 @@ namespace winrt::Microsoft::TerminalApp::implementation
 
         void SetInputTap(const Microsoft::Terminal::TerminalConnection::ITerminalConnection& inputTap);
 
-        WINRT_CALLBACK(TerminalOutput, winrt::Microsoft::Terminal::TerminalConnection::TerminalOutputHandler);
-
         TYPED_EVENT(StateChanged, winrt::Microsoft::Terminal::TerminalConnection::ITerminalConnection, winrt::Windows::Foundation::IInspectable);
 
     private:
         void _PrintInput(const hstring& data);
-        void _OutputHandler(const hstring str);
+        void _OutputHandler(const std::wstring_view str);
 
         winrt::Microsoft::Terminal::TerminalConnection::ITerminalConnection::TerminalOutput_revoker _outputRevoker;
+        winrt::Microsoft::Terminal::TerminalConnection::ITerminalOutputView::TerminalOutputView_revoker _outputViewRevoker;
         winrt::Microsoft::Terminal::TerminalConnection::ITerminalConnection::StateChanged_revoker _stateChangedRevoker;
         winrt::weak_ref<Microsoft::Terminal::TerminalConnection::ITerminalConnection> _wrappedConnection;
         winrt::weak_ref<Microsoft::Terminal::TerminalConnection::ITerminalConnection> _inputSide;
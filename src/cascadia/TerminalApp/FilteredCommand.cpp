@@ -17,6 +17,45 @@ using namespace winrt::Windows::Foundation;
 using namespace winrt::Windows::Foundation::Collections;
 using namespace winrt::Microsoft::Terminal::Settings::Model;
 
+namespace
+{
+    // Function Description:
+    // - Lowercases the given text according to the user's locale.
+    // - GH#9941: search should be locale-aware, so we can't just use towlower.
+    // Arguments:
+    // - text: the text to lowercase
+    // Return Value:
+    // - the lowercased text. If the lowercase form doesn't have the same length, the text is returned as-is,
+    //   so that offsets into the result are always offsets into the original text as well.
+    std::wstring foldCase(const std::wstring_view text)
+    {
+        std::wstring folded{ text };
+        if (!folded.empty())
+        {
+            const auto length = gsl::narrow<int>(folded.size());
+            const auto written = LCMapStringEx(LOCALE_NAME_USER_DEFAULT, LCMAP_LOWERCASE | LCMAP_LINGUISTIC_CASING, text.data(), length, folded.data(), length, nullptr, nullptr, 0);
+            if (written != length)
+            {
+                folded = text;
+            }
+        }
+        return folded;
+    }
+
+    // Function Description:
+    // - Computes a bitmask with one bit set for (a hash of) every character in the text.
+    //   If a filter contains a bit that the name doesn't, the filter can't match the name.
+    uint64_t computeCharMask(const std::wstring_view text) noexcept
+    {
+        uint64_t mask = 0;
+        for (const auto ch : text)
+        {
+            mask |= uint64_t{ 1 } << (ch % 64);
+        }
+        return mask;
+    }
+}
+
 namespace winrt::TerminalApp::implementation
 {
     // This class is a wrapper of PaletteItem, that is used as an item of a filterable list in CommandPalette.
@@ -26,6 +65,7 @@ namespace winrt::TerminalApp::implementation
         _Filter(L""),
         _Weight(0)
     {
+        _updateFoldedName();
         _HighlightedName = _computeHighlightedName();
 
         // Recompute the highlighted name if the item name changes
@@ -33,6 +73,7 @@ namespace winrt::TerminalApp::implementation
             auto filteredCommand{ weakThis.get() };
             if (filteredCommand && e.PropertyName() == L"Name")
             {
+                filteredCommand->_updateFoldedName();
                 filteredCommand->HighlightedName(filteredCommand->_computeHighlightedName());
                 filteredCommand->Weight(filteredCommand->_computeWeight());
             }
@@ -51,6 +92,14 @@ namespace winrt::TerminalApp::implementation
         }
     }
 
+    // Method Description:
+    // - Caches the lowercased item name and its character mask used by _computeHighlightedName.
+    void FilteredCommand::_updateFoldedName()
+    {
+        _foldedName = foldCase(_Item.Name());
+        _foldedNameMask = computeCharMask(_foldedName);
+    }
+
     // Method Description:
     // - Looks up the filter characters within the item name.
     // Iterating through the filter and the item name it tries to associate the next filter character
@@ -78,25 +127,43 @@ namespace winrt::TerminalApp::implementation
         uint32_t nextOffsetToReport = 0;
         uint32_t currentOffset = 0;
 
-        for (const auto searchChar : _Filter)
-        {
-            const WCHAR searchCharAsString[] = { searchChar, L'\0' };
-            while (true)
+        // GH#9941: search should be locale-aware as well,
+        // so both the filter and the name are lowercased according to the user's locale.
+        const auto foldedFilter = foldCase(_Filter);
+
+        // Most items don't match the filter at all. Reject them before building any segments:
+        // first with the character mask and then by looking for the filter as a subsequence of the name.
+        const auto filterMatches = [&]() {
+            if ((computeCharMask(foldedFilter) & ~_foldedNameMask) != 0)
             {
-                if (currentOffset == commandName.size())
+                return false;
+            }
+            size_t offset = 0;
+            for (const auto searchChar : foldedFilter)
+            {
+                offset = _foldedName.find(searchChar, offset);
+                if (offset == std::wstring::npos)
                 {
-                    // There are still unmatched filter characters but we finished scanning the name.
-                    // In this case we return the entire item name as unmatched
-                    auto entireNameSegment{ winrt::make<HighlightedTextSegment>(commandName, false) };
-                    segments.Clear();
-                    segments.Append(entireNameSegment);
-                    return winrt::make<HighlightedText>(segments);
+                    return false;
                 }
+                offset++;
+            }
+            return true;
+        };
+        // (the size check guards against indexing past the name with a stale _foldedName)
+        if (_foldedName.size() != commandName.size() || !filterMatches())
+        {
+            // In this case we return the entire item name as unmatched
+            segments.Append(winrt::make<HighlightedTextSegment>(commandName, false));
+            return winrt::make<HighlightedText>(segments);
+        }
 
-                // GH#9941: search should be locale-aware as well
-                // We use the same comparison method as upon sorting to guarantee consistent behavior
-                const WCHAR currentCharAsString[] = { commandName[currentOffset], L'\0' };
-                auto isCurrentCharMatched = lstrcmpi(searchCharAsString, currentCharAsString) == 0;
+        for (const auto searchChar : foldedFilter)
+        {
+            while (true)
+            {
+                // The filter is known to match, so we can't run past the end of the name here.
+                auto isCurrentCharMatched = _foldedName[currentOffset] == searchChar;
                 if (isProcessingMatchedSegment != isCurrentCharMatched)
                 {
                     // We reached the end of the region (matched character came after a series of unmatched or vice versa).
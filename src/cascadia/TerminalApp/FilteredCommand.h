@@ -33,6 +33,12 @@ namespace winrt::TerminalApp::implementation
     private:
         winrt::TerminalApp::HighlightedText _computeHighlightedName();
         int _computeWeight();
+        void _updateFoldedName();
+
+        // The item name lowercased once (rather than comparing it char-by-char with lstrcmpi on every keystroke),
+        // plus a bitmask of the characters it contains so that most non-matching filters are rejected immediately.
+        std::wstring _foldedName;
+        uint64_t _foldedNameMask{ 0 };
         Windows::UI::Xaml::Data::INotifyPropertyChanged::PropertyChanged_revoker _itemChangedRevoker;
 
         friend class TerminalAppLocalTests::FilteredCommandTests;
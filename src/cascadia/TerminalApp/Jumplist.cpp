@@ -54,8 +54,14 @@ static std::wstring _normalizeIconPath(std::wstring_view path)
     return std::wstring{ fullPath };
 }
 
+std::atomic<uint64_t> Jumplist::_generation{ 0 };
+std::mutex Jumplist::_mutex;
+std::vector<std::pair<Jumplist::Entry, winrt::com_ptr<IShellLinkW>>> Jumplist::_committed;
+
 // Method Description:
-// - Updates the items of the Jumplist based on the given settings.
+// - Updates the items of the Jumplist based on the given settings. This
+//   returns right away, the update itself happens on a background thread.
+//   If the entries didn't change since the last update, nothing is written.
 // Arguments:
 // - settings - The settings object to update the jumplist with.
 // Return Value:
@@ -64,11 +70,40 @@ winrt::fire_and_forget Jumplist::UpdateJumplist(const CascadiaSettings& settings
 {
     // make sure to capture the settings _before_ the co_await
     const auto strongSettings = settings;
+    const auto generation = ++_generation;
 
     co_await winrt::resume_background();
 
+    // The jumplist is never urgent. Don't let it compete with the startup
+    // or a settings reload for the CPU or the disk.
+    const auto backgroundMode = SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_BEGIN);
+    const auto restorePriority = wil::scope_exit([&]() noexcept {
+        if (backgroundMode)
+        {
+            SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_END);
+        }
+    });
+
     try
     {
+        const std::lock_guard lock{ _mutex };
+
+        // The settings were reloaded again while we were waiting,
+        // and the update for those will follow right after us.
+        if (generation != _generation.load())
+        {
+            co_return;
+        }
+
+        const auto entries = _collectEntries(strongSettings);
+        // For instance when only the color scheme of a profile changed.
+        if (std::equal(entries.begin(), entries.end(), _committed.begin(), _committed.end(), [](const auto& entry, const auto& committed) {
+                return entry == committed.first;
+            }))
+        {
+            co_return;
+        }
+
         auto jumplistInstance = winrt::create_instance<ICustomDestinationList>(CLSID_DestinationList, CLSCTX_ALL);
 
         // Start the Jumplist edit transaction
@@ -76,12 +111,14 @@ winrt::fire_and_forget Jumplist::UpdateJumplist(const CascadiaSettings& settings
         winrt::com_ptr<IObjectCollection> jumplistItems;
         jumplistItems.capture(jumplistInstance, &ICustomDestinationList::BeginList, &slots);
 
-        // It's easier to clear the list and re-add everything. The settings aren't
-        // updated often, and there likely isn't a huge amount of items to add.
+        // The jumplist can only be replaced as a whole. The shell links of
+        // the entries that didn't change are reused though, which skips
+        // resolving their icons and creating them all over again.
         THROW_IF_FAILED(jumplistItems->Clear());
 
         // Update the list of profiles.
-        THROW_IF_FAILED(_updateProfiles(jumplistItems.get(), strongSettings.ActiveProfiles().GetView()));
+        std::vector<std::pair<Entry, winrt::com_ptr<IShellLinkW>>> links;
+        THROW_IF_FAILED(_updateProfiles(jumplistItems.get(), entries, links));
 
         // TODO GH#1571: Add items from the future customizable new tab dropdown as well.
         // This could either replace the default profiles, or be added alongside them.
@@ -92,32 +129,65 @@ winrt::fire_and_forget Jumplist::UpdateJumplist(const CascadiaSettings& settings
         THROW_IF_FAILED(jumplistInstance->AddUserTasks(jumplistItems.get()));
 
         THROW_IF_FAILED(jumplistInstance->CommitList());
+
+        _committed = std::move(links);
     }
     CATCH_LOG();
 }
 
 // Method Description:
-// - Creates and adds a ShellLink object to the Jumplist for each profile.
+// - Collects the jumplist entries for the profiles in the given settings.
+// Arguments:
+// - settings - The settings to collect the entries of
+// Return Value:
+// - An entry for each active profile, in order
+std::vector<Jumplist::Entry> Jumplist::_collectEntries(const CascadiaSettings& settings)
+{
+    const auto profiles = settings.ActiveProfiles();
+
+    std::vector<Entry> entries;
+    entries.reserve(profiles.Size());
+    for (const auto& profile : profiles)
+    {
+        // Craft the arguments following "wt.exe"
+        entries.push_back({ std::wstring{ profile.Name() }, std::wstring{ profile.Icon() }, fmt::format(L"-p {}", to_hstring(profile.Guid())) });
+    }
+    return entries;
+}
+
+// Method Description:
+// - Adds a ShellLink object to the Jumplist for each entry. The links of
+//   the last committed jumplist are reused for the entries that didn't change.
 // Arguments:
 // - jumplistItems - The jumplist item list
-// - profiles - The profiles to add to the jumplist
+// - entries - The entries to add to the jumplist
+// - links - Receives the entries next to their shell links
 // Return Value:
 // - S_OK or HRESULT failure code.
-[[nodiscard]] HRESULT Jumplist::_updateProfiles(IObjectCollection* jumplistItems, winrt::Windows::Foundation::Collections::IVectorView<Profile> profiles) noexcept
+[[nodiscard]] HRESULT Jumplist::_updateProfiles(IObjectCollection* jumplistItems, const std::vector<Entry>& entries, std::vector<std::pair<Entry, winrt::com_ptr<IShellLinkW>>>& links) noexcept
 {
     try
     {
-        for (const auto& profile : profiles)
+        links.reserve(entries.size());
+        for (const auto& entry : entries)
         {
-            // Craft the arguments following "wt.exe"
-            auto args = fmt::format(L"-p {}", to_hstring(profile.Guid()));
-
-            // Create the shell link object for the profile
             winrt::com_ptr<IShellLinkW> shLink;
-            const auto normalizedIconPath{ _normalizeIconPath(profile.Icon()) };
-            RETURN_IF_FAILED(_createShellLink(profile.Name(), normalizedIconPath, args, shLink.put()));
+            const auto committed = std::find_if(_committed.begin(), _committed.end(), [&](const auto& pair) {
+                return pair.first == entry;
+            });
+            if (committed != _committed.end())
+            {
+                shLink = committed->second;
+            }
+            else
+            {
+                // Create the shell link object for the profile
+                const auto normalizedIconPath{ _normalizeIconPath(entry.icon) };
+                RETURN_IF_FAILED(_createShellLink(entry.name, normalizedIconPath, entry.args, shLink.put()));
+            }
 
             RETURN_IF_FAILED(jumplistItems->AddObject(shLink.get()));
+            links.emplace_back(entry, std::move(shLink));
         }
 
         return S_OK;
@@ -8,6 +8,9 @@
 // - The Jumplist is the menu that pops up when right clicking a pinned
 // item in the taskbar. This class handles updating the Terminal's jumplist
 // using the Terminal's settings.
+// - The jumplist is updated on a background thread at background priority,
+// off the settings load path. Only the entries that changed since the last
+// update get new shell links, and an unchanged jumplist isn't committed again.
 //
 
 #pragma once
@@ -21,6 +24,28 @@ public:
     static winrt::fire_and_forget UpdateJumplist(const winrt::Microsoft::Terminal::Settings::Model::CascadiaSettings& settings) noexcept;
 
 private:
-    [[nodiscard]] static HRESULT _updateProfiles(IObjectCollection* jumplistItems, winrt::Windows::Foundation::Collections::IVectorView<winrt::Microsoft::Terminal::Settings::Model::Profile> profiles) noexcept;
+    struct Entry
+    {
+        std::wstring name;
+        std::wstring icon;
+        std::wstring args;
+
+        bool operator==(const Entry& other) const noexcept
+        {
+            return name == other.name && icon == other.icon && args == other.args;
+        }
+    };
+
+    static std::vector<Entry> _collectEntries(const winrt::Microsoft::Terminal::Settings::Model::CascadiaSettings& settings);
+    [[nodiscard]] static HRESULT _updateProfiles(IObjectCollection* jumplistItems, const std::vector<Entry>& entries, std::vector<std::pair<Entry, winrt::com_ptr<IShellLinkW>>>& links) noexcept;
     [[nodiscard]] static HRESULT _createShellLink(const std::wstring_view name, const std::wstring_view path, const std::wstring_view args, IShellLinkW** shLink) noexcept;
+
+    // Every call to UpdateJumplist bumps the generation. A background update
+    // that finds it has been bumped again in the meantime bails out, as
+    // there's a newer one queued right behind it.
+    static std::atomic<uint64_t> _generation;
+    // Serializes the background updates and guards the state below.
+    static std::mutex _mutex;
+    // The entries of the last committed jumplist, next to their shell links.
+    static std::vector<std::pair<Entry, winrt::com_ptr<IShellLinkW>>> _committed;
 };
@@ -2357,32 +2357,47 @@ Pane::SnapChildrenSizeResult Pane::_CalcSnappedChildrenSizes(const bool widthOrH
     // unpredictable way, regardless which child has the snap priority or whether we snap them
     // upward, downward or to nearest.
     //   With present way we run the same sequence of actions regardless to the fullSize value and
-    // only just stop at various moments when the built sizes reaches it.  Eventually, this could
-    // be optimized for simple cases like when both children are both leaves with the same character
-    // size, but it doesn't seem to be beneficial.
+    // only just stop at various moments when the built sizes reaches it.
+    //   That's also what makes this cheap to call for every step of a live resize: the sizes
+    // after each step are remembered in _snapStepCache, until the layout of our descendants
+    // changes. Smaller sizes are then a binary search, and larger ones only take the steps
+    // that weren't taken before.
 
-    auto sizeTree = _CreateMinSizeTree(widthOrHeight);
-    LayoutSizeNode lastSizeTree{ sizeTree };
+    auto& cache = til::at(_snapStepCache, widthOrHeight ? 1 : 0);
 
-    while (sizeTree.size < fullSize)
+    std::vector<float> key;
+    _AppendSnapKey(widthOrHeight, key);
+    if (!cache.sizeTree || key != cache.key)
     {
-        lastSizeTree = sizeTree;
-        _AdvanceSnappedDimension(widthOrHeight, sizeTree);
+        cache.key = std::move(key);
+        cache.sizeTree = std::make_unique<LayoutSizeNode>(_CreateMinSizeTree(widthOrHeight));
+        cache.steps.clear();
+        cache.steps.push_back({ cache.sizeTree->size, { cache.sizeTree->firstChild->size, cache.sizeTree->secondChild->size } });
+    }
 
-        if (sizeTree.size == fullSize)
-        {
-            // If we just hit exactly the requested value, then just return the
-            // current state of children.
-            return { { sizeTree.firstChild->size, sizeTree.secondChild->size },
-                     { sizeTree.firstChild->size, sizeTree.secondChild->size } };
-        }
+    while (cache.steps.back().size < fullSize)
+    {
+        _AdvanceSnappedDimension(widthOrHeight, *cache.sizeTree);
+        cache.steps.push_back({ cache.sizeTree->size, { cache.sizeTree->firstChild->size, cache.sizeTree->secondChild->size } });
+    }
+
+    // The sizes never decrease from one step to the next, so this finds the
+    // first step at which we reached (or exceeded) the requested size.
+    const auto reached = std::lower_bound(cache.steps.begin(), cache.steps.end(), fullSize, [](const SnapStep& step, const float size) {
+        return step.size < size;
+    });
+
+    if (reached->size == fullSize || reached == cache.steps.begin())
+    {
+        // If we just hit exactly the requested value (or can't get any
+        // smaller), then just return the state of children at that step.
+        return { reached->childSizes, reached->childSizes };
     }
 
-    // We exceeded the requested size in the loop above, so lastSizeTree will have
-    // the last good sizes (so that children fit in) and sizeTree has the next possible
+    // We exceeded the requested size at this step, so the previous one has the
+    // last good sizes (so that children fit in) and this one has the next possible
     // snapped sizes. Return them as lower and higher snap possibilities.
-    return { { lastSizeTree.firstChild->size, lastSizeTree.secondChild->size },
-             { sizeTree.firstChild->size, sizeTree.secondChild->size } };
+    return { (reached - 1)->childSizes, reached->childSizes };
 }
 
 // Method Description:
@@ -2658,6 +2673,37 @@ Pane::LayoutSizeNode Pane::_CreateMinSizeTree(const bool widthOrHeight) const
     return node;
 }
 
+// Method Description:
+// - Appends everything the snapped layout of this pane depends on to the
+//   given key: the split of each parent, and the minimum size, cell size and
+//   borders of each leaf. If the key of a pane didn't change, neither did
+//   the steps _CalcSnappedChildrenSizes takes for it.
+// Arguments:
+// - widthOrHeight: if true operates on width, otherwise on height
+// - key: the key to append to
+// Return Value:
+// - <none>
+void Pane::_AppendSnapKey(const bool widthOrHeight, std::vector<float>& key) const
+{
+    if (_IsLeaf())
+    {
+        const auto minSize = _GetMinSize();
+        const auto cellSize = _control.CharacterDimensions();
+        // Leaves are marked with a negative value, which no split state has.
+        key.push_back(-1.0f);
+        key.push_back(widthOrHeight ? minSize.Width : minSize.Height);
+        key.push_back(widthOrHeight ? cellSize.Width : cellSize.Height);
+        key.push_back(static_cast<float>(WI_EnumValue(_borders)));
+    }
+    else
+    {
+        key.push_back(static_cast<float>(_splitState));
+        key.push_back(_desiredSplitPosition);
+        _firstChild->_AppendSnapKey(widthOrHeight, key);
+        _secondChild->_AppendSnapKey(widthOrHeight, key);
+    }
+}
+
 // Method Description:
 // - Adjusts split position so that no child pane is smaller then its
 //   minimum size
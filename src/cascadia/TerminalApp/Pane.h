@@ -228,6 +228,7 @@ private:
     void _AdvanceSnappedDimension(const bool widthOrHeight, LayoutSizeNode& sizeNode) const;
     winrt::Windows::Foundation::Size _GetMinSize() const;
     LayoutSizeNode _CreateMinSizeTree(const bool widthOrHeight) const;
+    void _AppendSnapKey(const bool widthOrHeight, std::vector<float>& key) const;
     float _ClampSplitPosition(const bool widthOrHeight, const float requestedValue, const float totalSize) const;
 
     winrt::Microsoft::Terminal::Settings::Model::SplitState _convertAutomaticSplitState(const winrt::Microsoft::Terminal::Settings::Model::SplitState& splitType) const;
@@ -322,6 +323,25 @@ private:
         void _AssignChildNode(std::unique_ptr<LayoutSizeNode>& nodeField, const LayoutSizeNode* const newNode);
     };
 
+    // The steps _CalcSnappedChildrenSizes took so far to grow our children,
+    // for height (0) and width (1). The steps only depend on the layout of our
+    // descendants, which the key captures, and not on the requested size.
+    struct SnapStep
+    {
+        float size;
+        std::pair<float, float> childSizes;
+    };
+
+    struct SnapStepCache
+    {
+        std::vector<float> key;
+        std::vector<SnapStep> steps;
+        // The state of the tree after the last step, to take further steps from.
+        std::unique_ptr<LayoutSizeNode> sizeTree;
+    };
+
+    mutable std::array<SnapStepCache, 2> _snapStepCache;
+
     friend struct winrt::TerminalApp::implementation::TerminalTab;
     friend class ::TerminalAppLocalTests::TabTests;
 };
@@ -0,0 +1,205 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "pch.h"
+#include "RecordingTapConnection.h"
+#include "../TerminalConnection/Asciicast.h"
+
+using namespace ::winrt::Microsoft::Terminal::TerminalConnection;
+using namespace ::winrt::Windows::Foundation;
+using namespace ::Microsoft::Terminal::TerminalConnection;
+
+namespace winrt::Microsoft::TerminalApp::implementation
+{
+    // Method Description:
+    // - Creates the recording, replacing any file at the given path, and
+    //   writes its header.
+    // Arguments:
+    // - path: the file to record into
+    // - rows, columns: the initial size of the terminal
+    SessionRecorder::SessionRecorder(const std::wstring& path, uint32_t rows, uint32_t columns) :
+        _start{ std::chrono::steady_clock::now() }
+    {
+        _file.reset(CreateFileW(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr));
+        THROW_LAST_ERROR_IF(!_file);
+
+        _pending = Asciicast::FormatHeader(columns, rows, std::time(nullptr));
+        _writer = std::thread{ &SessionRecorder::_WriterThread, this };
+    }
+
+    SessionRecorder::~SessionRecorder()
+    {
+        Close();
+    }
+
+    void SessionRecorder::RecordOutput(const std::wstring_view data)
+    {
+        _Record('o', til::u16u8(data));
+    }
+
+    void SessionRecorder::RecordInput(const std::wstring_view data)
+    {
+        _Record('i', til::u16u8(data));
+    }
+
+    void SessionRecorder::RecordResize(uint32_t rows, uint32_t columns)
+    {
+        _Record('r', fmt::format("{}x{}", columns, rows));
+    }
+
+    // Method Description:
+    // - Writes out everything that's still pending and stops the writer.
+    //   Anything recorded after this is dropped.
+    void SessionRecorder::Close() noexcept
+    {
+        {
+            std::lock_guard guard{ _mutex };
+            _closing = true;
+        }
+        _wake.notify_one();
+
+        if (_writer.joinable())
+        {
+            _writer.join();
+        }
+    }
+
+    void SessionRecorder::_Record(const char type, const std::string_view utf8)
+    {
+        const std::chrono::duration<double> time{ std::chrono::steady_clock::now() - _start };
+
+        bool wake;
+        {
+            std::lock_guard guard{ _mutex };
+            if (_closing)
+            {
+                return;
+            }
+            Asciicast::AppendEvent(_pending, time.count(), type, utf8);
+            wake = _pending.size() >= FlushThreshold;
+        }
+
+        if (wake)
+        {
+            _wake.notify_one();
+        }
+    }
+
+    void SessionRecorder::_WriterThread() noexcept
+    {
+        LOG_IF_FAILED(SetThreadDescription(GetCurrentThread(), L"SessionRecorder Writer Thread"));
+
+        // The buffers are swapped back and forth, so that neither is
+        // reallocated once it's grown to the usual size of a flush.
+        std::string writing;
+        for (;;)
+        {
+            bool closing;
+            {
+                std::unique_lock lock{ _mutex };
+                _wake.wait_for(lock, FlushInterval, [&]() { return _closing || _pending.size() >= FlushThreshold; });
+                closing = _closing;
+                writing.swap(_pending);
+            }
+
+            if (!writing.empty())
+            {
+                DWORD written = 0;
+                // If the disk is full, there's nothing better to do than losing the rest of the recording.
+                LOG_IF_WIN32_BOOL_FALSE(WriteFile(_file.get(), writing.data(), gsl::narrow_cast<DWORD>(writing.size()), &written, nullptr));
+                writing.clear();
+            }
+
+            if (closing)
+            {
+                return;
+            }
+        }
+    }
+
+    RecordingTapConnection::RecordingTapConnection(ITerminalConnection wrappedConnection, std::unique_ptr<SessionRecorder> recorder) :
+        _wrappedConnection{ std::move(wrappedConnection) },
+        _recorder{ std::move(recorder) }
+    {
+        // This is registered before anyone else had the chance to subscribe,
+        // so the output is recorded before it's handed to the terminal.
+        _outputRevoker = _wrappedConnection.TerminalOutput(winrt::auto_revoke, [this](const hstring& str) {
+            _recorder->RecordOutput(str);
+        });
+    }
+
+    void RecordingTapConnection::Start()
+    {
+        _wrappedConnection.Start();
+    }
+
+    void RecordingTapConnection::WriteInput(hstring const& data)
+    {
+        _recorder->RecordInput(data);
+        _wrappedConnection.WriteInput(data);
+    }
+
+    void RecordingTapConnection::Resize(uint32_t rows, uint32_t columns)
+    {
+        _recorder->RecordResize(rows, columns);
+        _wrappedConnection.Resize(rows, columns);
+    }
+
+    void RecordingTapConnection::Close()
+    {
+        _wrappedConnection.Close();
+        _outputRevoker.revoke();
+        _recorder->Close();
+    }
+
+    ConnectionState RecordingTapConnection::State() const noexcept
+    {
+        return _wrappedConnection.State();
+    }
+
+    winrt::event_token RecordingTapConnection::TerminalOutput(TerminalOutputHandler const& handler)
+    {
+        return _wrappedConnection.TerminalOutput(handler);
+    }
+
+    void RecordingTapConnection::TerminalOutput(winrt::event_token const& token) noexcept
+    {
+        _wrappedConnection.TerminalOutput(token);
+    }
+
+    winrt::event_token RecordingTapConnection::StateChanged(TypedEventHandler<ITerminalConnection, IInspectable> const& handler)
+    {
+        return _wrappedConnection.StateChanged(handler);
+    }
+
+    void RecordingTapConnection::StateChanged(winrt::event_token const& token) noexcept
+    {
+        _wrappedConnection.StateChanged(token);
+    }
+}
+
+// Function Description
+// - Wraps the given connection, so that its traffic is recorded into a new
+//   file in the given directory. The file is named after the time the
+//   recording started, so that recordings sort chronologically.
+// Arguments:
+// - baseConnection: the connection to record
+// - directory: where to put the recording. It's created if it doesn't exist.
+// - rows, columns: the initial size of the terminal
+// Return Value:
+// - a connection to be used in place of the original one
+ITerminalConnection OpenRecordingTapConnection(ITerminalConnection baseConnection, const std::wstring_view directory, uint32_t rows, uint32_t columns)
+{
+    using namespace winrt::Microsoft::TerminalApp::implementation;
+
+    std::filesystem::path path{ directory };
+    std::filesystem::create_directories(path);
+
+    SYSTEMTIME now{};
+    GetLocalTime(&now);
+    // The tick count tells apart the sessions that start within the same second.
+    path /= fmt::format(L"{:04}{:02}{:02}-{:02}{:02}{:02}-{:08x}.cast", now.wYear, now.wMonth, now.wDay, now.wHour, now.wMinute, now.wSecond, GetTickCount());
+
+    auto recorder{ std::make_unique<SessionRecorder>(path.wstring(), rows, columns) };
+    return winrt::make<RecordingTapConnection>(std::move(baseConnection), std::move(recorder));
+}
@@ -0,0 +1,74 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include <condition_variable>
+#include <winrt/Microsoft.Terminal.TerminalConnection.h>
+
+namespace winrt::Microsoft::TerminalApp::implementation
+{
+    // Writes the traffic of a connection to an asciicast v2 file (see
+    // TerminalConnection/Asciicast.h), which ReplayConnection can play back.
+    // Events are collected in memory and written by a background thread,
+    // so recording doesn't slow down the connection's output thread.
+    class SessionRecorder
+    {
+    public:
+        SessionRecorder(const std::wstring& path, uint32_t rows, uint32_t columns);
+        ~SessionRecorder();
+
+        SessionRecorder(const SessionRecorder&) = delete;
+        SessionRecorder& operator=(const SessionRecorder&) = delete;
+
+        void RecordOutput(const std::wstring_view data);
+        void RecordInput(const std::wstring_view data);
+        void RecordResize(uint32_t rows, uint32_t columns);
+        void Close() noexcept;
+
+    private:
+        // Once this much is pending, the writer thread is woken up early.
+        static constexpr size_t FlushThreshold = 64 * 1024;
+        // Otherwise pending events are written at least this often,
+        // so that a crash loses at most this much of the recording.
+        static constexpr std::chrono::seconds FlushInterval{ 1 };
+
+        void _Record(const char type, const std::string_view utf8);
+        void _WriterThread() noexcept;
+
+        wil::unique_hfile _file;
+        std::chrono::steady_clock::time_point _start;
+
+        std::mutex _mutex;
+        std::condition_variable _wake;
+        std::string _pending;
+        bool _closing = false;
+        std::thread _writer;
+    };
+
+    // Forwards everything to the wrapped connection, recording the output,
+    // input and resizes that pass through it on the way.
+    class RecordingTapConnection : public winrt::implements<RecordingTapConnection, winrt::Microsoft::Terminal::TerminalConnection::ITerminalConnection>
+    {
+    public:
+        RecordingTapConnection(Microsoft::Terminal::TerminalConnection::ITerminalConnection wrappedConnection, std::unique_ptr<SessionRecorder> recorder);
+        void Initialize(const Windows::Foundation::Collections::ValueSet& /*settings*/){};
+        void Start();
+        void WriteInput(hstring const& data);
+        void Resize(uint32_t rows, uint32_t columns);
+        void Close();
+        winrt::Microsoft::Terminal::TerminalConnection::ConnectionState State() const noexcept;
+
+        winrt::event_token TerminalOutput(winrt::Microsoft::Terminal::TerminalConnection::TerminalOutputHandler const& handler);
+        void TerminalOutput(winrt::event_token const& token) noexcept;
+        winrt::event_token StateChanged(winrt::Windows::Foundation::TypedEventHandler<winrt::Microsoft::Terminal::TerminalConnection::ITerminalConnection, winrt::Windows::Foundation::IInspectable> const& handler);
+        void StateChanged(winrt::event_token const& token) noexcept;
+
+    private:
+        winrt::Microsoft::Terminal::TerminalConnection::ITerminalConnection _wrappedConnection;
+        winrt::Microsoft::Terminal::TerminalConnection::ITerminalConnection::TerminalOutput_revoker _outputRevoker;
+        std::unique_ptr<SessionRecorder> _recorder;
+    };
+}
+
+winrt::Microsoft::Terminal::TerminalConnection::ITerminalConnection OpenRecordingTapConnection(winrt::Microsoft::Terminal::TerminalConnection::ITerminalConnection baseConnection, const std::wstring_view directory, uint32_t rows, uint32_t columns);
@@ -0,0 +1,227 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "pch.h"
+#include "StartupProfiler.h"
+
+using namespace ::TerminalApp;
+
+static constexpr uint64_t _FileTimeToUint64(const FILETIME& fileTime) noexcept
+{
+    return (static_cast<uint64_t>(fileTime.dwHighDateTime) << 32) | fileTime.dwLowDateTime;
+}
+
+StartupProfiler::StartupProfiler() noexcept
+{
+    FILETIME creationTime{};
+    FILETIME exitTime{};
+    FILETIME kernelTime{};
+    FILETIME userTime{};
+    if (LOG_IF_WIN32_BOOL_FALSE(GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime)))
+    {
+        _processCreationTime = _FileTimeToUint64(creationTime);
+    }
+    else
+    {
+        // Without the creation time, the best we can do is measure from here.
+        FILETIME now{};
+        GetSystemTimePreciseAsFileTime(&now);
+        _processCreationTime = _FileTimeToUint64(now);
+    }
+
+    // We're constructed by the AppLogic, so everything up to here was the
+    // process launching. The ExecutableStarted event of the WindowsTerminal
+    // provider already marks this phase in a trace.
+    try
+    {
+        _phases.emplace_back(Phase{ ProcessLaunch, 0, _MicrosecondsSinceProcessCreation() });
+    }
+    CATCH_LOG();
+}
+
+// Method Description:
+// - Marks the beginning of the given startup phase. Startup only happens
+//   once, so a phase that was already started is left alone.
+// Arguments:
+// - name: one of the phase names declared in StartupProfiler.h
+// Return Value:
+// - <none>
+void StartupProfiler::StartPhase(const char* name) noexcept
+try
+{
+    if (_completed || _FindPhase(name))
+    {
+        return;
+    }
+
+    const auto now = _MicrosecondsSinceProcessCreation();
+    _phases.emplace_back(Phase{ name, now, std::nullopt });
+
+#pragma warning(suppress : 26477 26485 26494 26482 26446 26447) // We don't control TraceLoggingWrite
+    TraceLoggingWrite(g_hTerminalAppProvider,
+                      "StartupPhase",
+                      TraceLoggingString(name, "Phase"),
+                      TraceLoggingInt64(now, "SinceProcessStartUs"),
+                      TraceLoggingOpcode(WINEVENT_OPCODE_START),
+                      TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+                      TraceLoggingKeyword(TIL_KEYWORD_TRACE));
+}
+CATCH_LOG()
+
+// Method Description:
+// - Marks the end of the given startup phase. When both the startup actions
+//   and the first control are done, startup is complete, and we'll write the
+//   output file if one was requested.
+// Arguments:
+// - name: one of the phase names declared in StartupProfiler.h
+// Return Value:
+// - <none>
+void StartupProfiler::StopPhase(const char* name) noexcept
+{
+    auto phase = _FindPhase(name);
+    if (_completed || !phase || phase->stopMicroseconds)
+    {
+        return;
+    }
+
+    const auto now = _MicrosecondsSinceProcessCreation();
+    phase->stopMicroseconds = now;
+
+#pragma warning(suppress : 26477 26485 26494 26482 26446 26447) // We don't control TraceLoggingWrite
+    TraceLoggingWrite(g_hTerminalAppProvider,
+                      "StartupPhase",
+                      TraceLoggingString(name, "Phase"),
+                      TraceLoggingInt64(now, "SinceProcessStartUs"),
+                      TraceLoggingInt64(now - phase->startMicroseconds, "DurationUs"),
+                      TraceLoggingOpcode(WINEVENT_OPCODE_STOP),
+                      TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+                      TraceLoggingKeyword(TIL_KEYWORD_TRACE));
+
+    if (_IsPhaseStopped(StartupActions) && _IsPhaseStopped(FirstControl))
+    {
+        _Complete();
+    }
+}
+
+bool StartupProfiler::IsPhaseStarted(const char* name) const noexcept
+{
+    return _FindPhase(name) != nullptr;
+}
+
+// Method Description:
+// - Sets the file that the phase timeline is written to once startup is done.
+// Arguments:
+// - path: the path of the JSON file. If it's empty, no file is written.
+// Return Value:
+// - <none>
+void StartupProfiler::SetOutputPath(std::wstring path) noexcept
+{
+    _outputPath = std::move(path);
+}
+
+// Method Description:
+// - Formats the timeline of all recorded phases as JSON. Phases are listed in
+//   the order they were started. Phases that haven't stopped yet don't
+//   have a duration.
+// Arguments:
+// - <none>
+// Return Value:
+// - the JSON document, encoded as UTF-8
+std::string StartupProfiler::ToJson() const
+{
+    int64_t totalMicroseconds = 0;
+    std::string phases;
+    for (const auto& phase : _phases)
+    {
+        if (!phases.empty())
+        {
+            phases.append(",\n");
+        }
+
+        if (phase.stopMicroseconds)
+        {
+            const auto stop = *phase.stopMicroseconds;
+            totalMicroseconds = std::max(totalMicroseconds, stop);
+            phases.append(fmt::format(R"(    {{ "name": "{}", "startUs": {}, "stopUs": {}, "durationUs": {} }})",
+                                      phase.name,
+                                      phase.startMicroseconds,
+                                      stop,
+                                      stop - phase.startMicroseconds));
+        }
+        else
+        {
+            phases.append(fmt::format(R"(    {{ "name": "{}", "startUs": {} }})",
+                                      phase.name,
+                                      phase.startMicroseconds));
+        }
+    }
+
+    return fmt::format("{{\n  \"version\": \"{}\",\n  \"processId\": {},\n  \"totalUs\": {},\n  \"phases\": [\n{}\n  ]\n}}\n",
+                       til::u16u8(winrt::Microsoft::Terminal::Settings::Model::CascadiaSettings::ApplicationVersion()),
+                       GetCurrentProcessId(),
+                       totalMicroseconds,
+                       phases);
+}
+
+int64_t StartupProfiler::_MicrosecondsSinceProcessCreation() const noexcept
+{
+    FILETIME now{};
+    GetSystemTimePreciseAsFileTime(&now);
+    // FILETIMEs are in 100ns units.
+    return static_cast<int64_t>(_FileTimeToUint64(now) - _processCreationTime) / 10;
+}
+
+StartupProfiler::Phase* StartupProfiler::_FindPhase(const char* name) noexcept
+{
+    const auto it = std::find_if(_phases.begin(), _phases.end(), [name](const auto& phase) {
+        return strcmp(phase.name, name) == 0;
+    });
+    return it == _phases.end() ? nullptr : &*it;
+}
+
+const StartupProfiler::Phase* StartupProfiler::_FindPhase(const char* name) const noexcept
+{
+    const auto it = std::find_if(_phases.begin(), _phases.end(), [name](const auto& phase) {
+        return strcmp(phase.name, name) == 0;
+    });
+    return it == _phases.end() ? nullptr : &*it;
+}
+
+bool StartupProfiler::_IsPhaseStopped(const char* name) const noexcept
+{
+    const auto phase = _FindPhase(name);
+    return phase && phase->stopMicroseconds.has_value();
+}
+
+void StartupProfiler::_Complete() noexcept
+{
+    _completed = true;
+
+#pragma warning(suppress : 26477 26485 26494 26482 26446 26447) // We don't control TraceLoggingWrite
+    TraceLoggingWrite(g_hTerminalAppProvider,
+                      "StartupCompleted",
+                      TraceLoggingDescription("Event emitted once the startup actions and the first control are done"),
+                      TraceLoggingInt64(_MicrosecondsSinceProcessCreation(), "SinceProcessStartUs"),
+                      TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+                      TraceLoggingKeyword(TIL_KEYWORD_TRACE));
+
+    try
+    {
+        _WriteOutputFile();
+    }
+    CATCH_LOG();
+}
+
+void StartupProfiler::_WriteOutputFile() const
+{
+    if (_outputPath.empty())
+    {
+        return;
+    }
+
+    const auto json = ToJson();
+    wil::unique_hfile file{ CreateFileW(_outputPath.c_str(), GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr) };
+    THROW_LAST_ERROR_IF(!file);
+    DWORD written = 0;
+    THROW_IF_WIN32_BOOL_FALSE(WriteFile(file.get(), json.data(), gsl::narrow<DWORD>(json.size()), &written, nullptr));
+}
@@ -0,0 +1,68 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+//
+// Module Name:
+// - StartupProfiler.h
+//
+// Abstract:
+// - Records how long each phase of launching the Terminal takes, relative to
+//   the creation of the process. Every phase is written as a pair of
+//   "StartupPhase" start/stop events on the TerminalApp provider. Once the
+//   first control has been initialized, the whole timeline is written as a
+//   JSON file, if one was requested with `wt --startup-profile <path>`.
+//
+
+#pragma once
+
+namespace TerminalApp
+{
+    class StartupProfiler final
+    {
+    public:
+        // From the process being created to the AppLogic being constructed.
+        // This one is recorded when the profiler is constructed.
+        static constexpr const char* ProcessLaunch = "ProcessLaunch";
+        // Reading, parsing and layering the settings, which includes
+        // generating the dynamic profiles.
+        static constexpr const char* LoadSettings = "LoadSettings";
+        static constexpr const char* ParseCommandline = "ParseCommandline";
+        static constexpr const char* CreatePage = "CreatePage";
+        // From TerminalPage::Create returning to the page being loaded.
+        static constexpr const char* XamlLoad = "XamlLoad";
+        // From the page being loaded to all the startup actions being done.
+        static constexpr const char* StartupActions = "StartupActions";
+        // From the first TermControl being constructed to it being
+        // initialized. This includes setting up the renderer and the graphics
+        // device and starting the connection.
+        static constexpr const char* FirstControl = "FirstControl";
+
+        StartupProfiler() noexcept;
+
+        void StartPhase(const char* name) noexcept;
+        void StopPhase(const char* name) noexcept;
+        bool IsPhaseStarted(const char* name) const noexcept;
+
+        void SetOutputPath(std::wstring path) noexcept;
+        std::string ToJson() const;
+
+    private:
+        struct Phase
+        {
+            const char* name;
+            int64_t startMicroseconds;
+            std::optional<int64_t> stopMicroseconds;
+        };
+
+        int64_t _MicrosecondsSinceProcessCreation() const noexcept;
+        Phase* _FindPhase(const char* name) noexcept;
+        const Phase* _FindPhase(const char* name) const noexcept;
+        bool _IsPhaseStopped(const char* name) const noexcept;
+        void _Complete() noexcept;
+        void _WriteOutputFile() const;
+
+        uint64_t _processCreationTime{ 0 };
+        std::vector<Phase> _phases;
+        std::wstring _outputPath;
+        bool _completed{ false };
+    };
+}
@@ -499,6 +499,7 @@ namespace winrt::TerminalApp::implementation
         // To close the window here, we need to close the hosting window.
         if (_tabs.Size() == 0)
         {
+            _FlushClipboard();
             _LastTabClosedHandlers(*this, nullptr);
         }
         else if (focusedTabIndex.has_value() && focusedTabIndex.value() == gsl::narrow_cast<uint32_t>(tabIndex))
@@ -848,6 +849,8 @@ namespace winrt::TerminalApp::implementation
             _tabContent.Children().Clear();
             _tabContent.Children().Append(tab.Content());
 
+            _UpdateTabVisibility(tab);
+
             // GH#7409: If the tab switcher is open, then we _don't_ want to
             // automatically focus the new tab here. The tab switcher wants
             // to be able to "preview" the selected tab as the user tabs
@@ -875,6 +878,46 @@ namespace winrt::TerminalApp::implementation
         CATCH_LOG();
     }
 
+    // Method Description:
+    // - Lets the panes of the selected tab paint, and suspends painting for
+    //   all the others, since they can't be seen. Nothing is painted at all
+    //   while the window is minimized.
+    // Arguments:
+    // - selectedTab: the tab that is currently shown
+    // Return Value:
+    // - <none>
+    void TerminalPage::_UpdateTabVisibility(const winrt::TerminalApp::TabBase& selectedTab)
+    {
+        for (const auto& tab : _tabs)
+        {
+            if (const auto terminalTab{ _GetTerminalTabImpl(tab) })
+            {
+                terminalTab->VisibilityChanged(_windowVisible && tab == selectedTab);
+            }
+        }
+    }
+
+    // Method Description:
+    // - Called when the window was minimized or restored, to suspend or
+    //   resume painting in the selected tab.
+    // Arguments:
+    // - showOrHide: false if the window was minimized (or hidden), true if it was restored.
+    // Return Value:
+    // - <none>
+    void TerminalPage::WindowVisibilityChanged(const bool showOrHide)
+    {
+        if (_windowVisible == showOrHide)
+        {
+            return;
+        }
+
+        _windowVisible = showOrHide;
+        if (const auto tab{ _GetFocusedTab() })
+        {
+            _UpdateTabVisibility(tab);
+        }
+    }
+
     // Method Description:
     // - Responds to the TabView control's Selection Changed event (to move a
     //      new terminal control into focus) when not in in the middle of a tab rearrangement.
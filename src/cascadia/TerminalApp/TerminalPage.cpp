@@ -15,12 +15,11 @@
 #include "TabRowControl.h"
 #include "ColorHelper.h"
 #include "DebugTapConnection.h"
+#include "RecordingTapConnection.h"
 #include "SettingsTab.h"
 #include "RenameWindowRequestedArgs.g.cpp"
 #include "../inc/WindowingBehavior.h"
 
-#include <til/latch.h>
-
 using namespace winrt;
 using namespace winrt::Windows::Foundation::Collections;
 using namespace winrt::Windows::UI::Xaml;
@@ -835,6 +834,13 @@ namespace winrt::TerminalApp::implementation
                                                                                        winrt::guid()));
         }
 
+        else if (connectionType == TerminalConnection::ReplayConnection::ConnectionType())
+        {
+            // A replay profile's commandline is the recording to play back.
+            connection = TerminalConnection::ReplayConnection();
+            connection.Initialize(TerminalConnection::ReplayConnection::CreateSettings(settings.Commandline(), 1.0));
+        }
+
         else
         {
             // profile is guaranteed to exist here
@@ -882,6 +888,21 @@ namespace winrt::TerminalApp::implementation
             connection = conhostConn;
         }
 
+        // Recording a replay would only make a copy of the recording.
+        const auto recordingDirectory{ _settings.GlobalSettings().SessionRecordingDirectory() };
+        if (!recordingDirectory.empty() && connectionType != TerminalConnection::ReplayConnection::ConnectionType())
+        {
+            try
+            {
+                connection = OpenRecordingTapConnection(connection,
+                                                        recordingDirectory,
+                                                        ::base::saturated_cast<uint32_t>(settings.InitialRows()),
+                                                        ::base::saturated_cast<uint32_t>(settings.InitialCols()));
+            }
+            // Not being able to record is no reason not to open the session.
+            CATCH_LOG();
+        }
+
         TraceLoggingWrite(
             g_hTerminalAppProvider,
             "ConnectionCreated",
@@ -1358,7 +1379,17 @@ namespace winrt::TerminalApp::implementation
             TerminalSettingsCreateResult controlSettings{ nullptr };
             Profile profile{ nullptr };
 
-            if (splitMode == SplitType::Duplicate)
+            if (splitMode == SplitType::Mirror)
+            {
+                // A mirror shows the focused terminal itself, so there's
+                // neither new settings nor a new connection to create.
+                profile = tab.GetFocusedProfile();
+                if (!profile)
+                {
+                    return;
+                }
+            }
+            else if (splitMode == SplitType::Duplicate)
             {
                 profile = tab.GetFocusedProfile();
                 if (profile)
@@ -1392,7 +1423,11 @@ namespace winrt::TerminalApp::implementation
                 controlSettings = TerminalSettings::CreateWithNewTerminalArgs(_settings, newTerminalArgs, *_bindings);
             }
 
-            const auto controlConnection = _CreateConnectionFromSettings(profile, controlSettings.DefaultSettings());
+            ITerminalConnection controlConnection{ nullptr };
+            if (splitMode != SplitType::Mirror)
+            {
+                controlConnection = _CreateConnectionFromSettings(profile, controlSettings.DefaultSettings());
+            }
 
             const float contentWidth = ::base::saturated_cast<float>(_tabContent.ActualWidth());
             const float contentHeight = ::base::saturated_cast<float>(_tabContent.ActualHeight());
@@ -1410,7 +1445,8 @@ namespace winrt::TerminalApp::implementation
                 return;
             }
 
-            auto newControl = _InitControl(controlSettings, controlConnection);
+            auto newControl = splitMode == SplitType::Mirror ? tab.GetActiveTerminalControl().CreateMirror() :
+                                                               _InitControl(controlSettings, controlConnection);
 
             // Hookup our event handlers to the new terminal
             _RegisterTerminalEvents(newControl);
@@ -1629,34 +1665,68 @@ namespace winrt::TerminalApp::implementation
         // copy text to dataPack
         dataPack.SetText(copiedData.Text());
 
+        // The HTML and RTF are rendered on demand (delayed rendering): they're
+        // only generated once an application asks for them, on a background
+        // thread. Most pastes only ever ask for the text.
+        const auto provideFormat = [](const CopyToClipboardEventArgs copiedData, const DataProviderRequest request, const bool html) -> fire_and_forget {
+            const auto deferral = request.GetDeferral();
+            co_await winrt::resume_background();
+            try
+            {
+                const auto data = html ? copiedData.Html() : copiedData.Rtf();
+                request.SetData(winrt::box_value(data));
+            }
+            CATCH_LOG();
+            deferral.Complete();
+        };
+
         if (WI_IsFlagSet(copyFormats, CopyFormat::HTML))
         {
             // copy html to dataPack
-            const auto htmlData = copiedData.Html();
-            if (!htmlData.empty())
-            {
-                dataPack.SetHtmlFormat(htmlData);
-            }
+            dataPack.SetDataProvider(StandardDataFormats::Html(), [=](const DataProviderRequest& request) {
+                provideFormat(copiedData, request, true);
+            });
         }
 
         if (WI_IsFlagSet(copyFormats, CopyFormat::RTF))
         {
             // copy rtf data to dataPack
-            const auto rtfData = copiedData.Rtf();
-            if (!rtfData.empty())
-            {
-                dataPack.SetRtf(rtfData);
-            }
+            dataPack.SetDataProvider(StandardDataFormats::Rtf(), [=](const DataProviderRequest& request) {
+                provideFormat(copiedData, request, false);
+            });
         }
 
         try
         {
+            // We don't Flush() right away, since that would render every format
+            // immediately. Instead, we flush when the window closes, so that
+            // the clipboard keeps its content after we're gone. See _FlushClipboard.
             Clipboard::SetContent(dataPack);
-            Clipboard::Flush();
+            _clipboardNeedsFlush = true;
         }
         CATCH_LOG();
     }
 
+    // Method Description:
+    // - Renders all the delayed formats of what we copied to the clipboard, so
+    //   that it outlives this window. If someone else took over the clipboard
+    //   meanwhile, this fails and there's nothing to do.
+    // Arguments:
+    // - <none>
+    // Return Value:
+    // - <none>
+    void TerminalPage::_FlushClipboard() noexcept
+    {
+        if (std::exchange(_clipboardNeedsFlush, false))
+        {
+            try
+            {
+                Clipboard::Flush();
+            }
+            CATCH_LOG();
+        }
+    }
+
     // Function Description:
     // - This function is called when the `TermControl` requests that we send
     //   it the clipboard's content.
@@ -1989,10 +2059,26 @@ namespace winrt::TerminalApp::implementation
         // Give term control a child of the settings so that any overrides go in the child
         // This way, when we do a settings reload we just update the parent and the overrides remain
         const auto child = TerminalSettings::CreateWithParent(settings);
+
+        // The first control of the window is the end of startup. Only that
+        // one gets timed, everything after it is already past startup.
+        const auto timeFirstControl = _startupProfiler && !_startupProfiler->IsPhaseStarted(::TerminalApp::StartupProfiler::FirstControl);
+        if (timeFirstControl)
+        {
+            _startupProfiler->StartPhase(::TerminalApp::StartupProfiler::FirstControl);
+        }
+
         TermControl term{ child.DefaultSettings(), connection };
 
         term.UnfocusedAppearance(child.UnfocusedSettings()); // It is okay for the unfocused settings to be null
 
+        if (timeFirstControl)
+        {
+            term.Initialized([profiler = _startupProfiler](auto&&, auto&&) {
+                profiler->StopPhase(::TerminalApp::StartupProfiler::FirstControl);
+            });
+        }
+
         return term;
     }
 
@@ -2197,6 +2283,18 @@ namespace winrt::TerminalApp::implementation
         }
     }
 
+    // Routine Description:
+    // - Gives this page the profiler that the startup phases are recorded in.
+    //   The page records how long it takes the first control to initialize.
+    // Arguments:
+    // - profiler - the AppLogic's startup profiler
+    // Return Value:
+    // - <none>
+    void TerminalPage::SetStartupProfiler(std::shared_ptr<::TerminalApp::StartupProfiler> profiler) noexcept
+    {
+        _startupProfiler = std::move(profiler);
+    }
+
     winrt::TerminalApp::IDialogPresenter TerminalPage::DialogPresenter() const
     {
         return _dialogPresenter.get();
@@ -2526,8 +2624,7 @@ namespace winrt::TerminalApp::implementation
     {
         // We need to be on the UI thread in order for _OpenNewTab to run successfully.
         // HasThreadAccess will return true if we're currently on a UI thread and false otherwise.
-        // When we're on a COM thread, we'll need to dispatch the calls to the UI thread
-        // and wait on it hence the locking mechanism.
+        // When we're on a COM thread, we'll need to dispatch the calls to the UI thread.
         if (Dispatcher().HasThreadAccess())
         {
             try
@@ -2555,18 +2652,29 @@ namespace winrt::TerminalApp::implementation
         }
         else
         {
-            til::latch latch{ 1 };
-            HRESULT finalVal = S_OK;
-
-            Dispatcher().RunAsync(CoreDispatcherPriority::Normal, [&]() {
-                // Re-running ourselves under the dispatcher will cause us to take the first branch above.
-                finalVal = _OnNewConnection(connection);
-
-                latch.count_down();
+            // We don't wait for the tab to be created. The handoff is complete
+            // once the connection holds onto the pseudoconsole, and the console
+            // application shouldn't have to wait for our UI. Until the tab starts
+            // the connection, its output simply waits in the pipe.
+            Dispatcher().RunAsync(CoreDispatcherPriority::Normal, [weakThis = get_weak(), connection]() {
+                if (auto page{ weakThis.get() })
+                {
+                    // Re-running ourselves under the dispatcher will cause us to take the first branch above.
+                    if (FAILED(page->_OnNewConnection(connection)))
+                    {
+                        // We can't hand the failure back to the console anymore.
+                        // Closing the connection at least doesn't leave the
+                        // application hanging without a window.
+                        connection.Close();
+                    }
+                }
+                else
+                {
+                    connection.Close();
+                }
             });
 
-            latch.wait();
-            return finalVal;
+            return S_OK;
         }
     }
 
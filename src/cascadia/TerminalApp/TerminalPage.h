@@ -8,6 +8,7 @@
 #include "AppKeyBindings.h"
 #include "AppCommandlineArgs.h"
 #include "RenameWindowRequestedArgs.g.h"
+#include "StartupProfiler.h"
 #include "Toast.h"
 
 #define DECLARE_ACTION_HANDLER(action) void _Handle##action(const IInspectable& sender, const Microsoft::Terminal::Settings::Model::ActionEventArgs& args);
@@ -70,6 +71,7 @@ namespace winrt::TerminalApp::implementation
         winrt::hstring ApplicationVersion();
 
         winrt::fire_and_forget CloseWindow();
+        void WindowVisibilityChanged(const bool showOrHide);
 
         void ToggleFocusMode();
         void ToggleFullscreen();
@@ -80,6 +82,7 @@ namespace winrt::TerminalApp::implementation
 
         void SetStartupActions(std::vector<Microsoft::Terminal::Settings::Model::ActionAndArgs>& actions);
         void SetInboundListener(bool isEmbedding);
+        void SetStartupProfiler(std::shared_ptr<::TerminalApp::StartupProfiler> profiler) noexcept;
         static std::vector<Microsoft::Terminal::Settings::Model::ActionAndArgs> ConvertExecuteCommandlineToActions(const Microsoft::Terminal::Settings::Model::ExecuteCommandlineArgs& args);
 
         winrt::TerminalApp::IDialogPresenter DialogPresenter() const;
@@ -151,8 +154,10 @@ namespace winrt::TerminalApp::implementation
         TerminalApp::SettingsTab _settingsTab{ nullptr };
 
         bool _isInFocusMode{ false };
+        bool _windowVisible{ true };
         bool _isFullscreen{ false };
         bool _isAlwaysOnTop{ false };
+        bool _clipboardNeedsFlush{ false };
         winrt::hstring _WindowName{};
         uint64_t _WindowId{ 0 };
 
@@ -175,6 +180,7 @@ namespace winrt::TerminalApp::implementation
         Windows::Foundation::Collections::IVector<Microsoft::Terminal::Settings::Model::ActionAndArgs> _startupActions;
         bool _shouldStartInboundListener{ false };
         bool _isEmbeddingInboundListener{ false };
+        std::shared_ptr<::TerminalApp::StartupProfiler> _startupProfiler{ nullptr };
 
         std::shared_ptr<Toast> _windowIdToast{ nullptr };
         std::shared_ptr<Toast> _windowRenameFailedToast{ nullptr };
@@ -273,6 +279,7 @@ namespace winrt::TerminalApp::implementation
         void _SetAcceleratorForMenuItem(Windows::UI::Xaml::Controls::MenuFlyoutItem& menuItem, const winrt::Microsoft::Terminal::Control::KeyChord& keyChord);
 
         winrt::fire_and_forget _CopyToClipboardHandler(const IInspectable sender, const winrt::Microsoft::Terminal::Control::CopyToClipboardEventArgs copiedData);
+        void _FlushClipboard() noexcept;
         winrt::fire_and_forget _PasteFromClipboardHandler(const IInspectable sender,
                                                           const Microsoft::Terminal::Control::PasteFromClipboardEventArgs eventArgs);
 
@@ -301,6 +308,7 @@ namespace winrt::TerminalApp::implementation
         void _OnTabCloseRequested(const IInspectable& sender, const Microsoft::UI::Xaml::Controls::TabViewTabCloseRequestedEventArgs& eventArgs);
         void _OnFirstLayout(const IInspectable& sender, const IInspectable& eventArgs);
         void _UpdatedSelectedTab(const winrt::TerminalApp::TabBase& tab);
+        void _UpdateTabVisibility(const winrt::TerminalApp::TabBase& selectedTab);
 
         void _OnDispatchCommandRequested(const IInspectable& sender, const Microsoft::Terminal::Settings::Model::Command& command);
         void _OnCommandLineExecutionRequested(const IInspectable& sender, const winrt::hstring& commandLine);
@@ -274,6 +274,24 @@ namespace winrt::TerminalApp::implementation
         _UpdateHeaderControlMaxWidth();
     }
 
+    // Method Description:
+    // - Tells the controls of all our panes whether they can currently be
+    //   seen, so that they don't paint while they can't.
+    // Arguments:
+    // - visible: false if we aren't the selected tab or the window is minimized.
+    // Return Value:
+    // - <none>
+    void TerminalTab::VisibilityChanged(const bool visible)
+    {
+        _rootPane->WalkTree([&](std::shared_ptr<Pane> pane) {
+            if (auto control = pane->GetTerminalControl())
+            {
+                control.VisibilityChanged(visible);
+            }
+            return false;
+        });
+    }
+
     // Method Description:
     // - Set the icon on the TabViewItem for this tab.
     // Arguments:
@@ -788,6 +806,12 @@ namespace winrt::TerminalApp::implementation
             control.FocusFollowMouseRequested(events.focusToken);
 
             _controlEvents.erase(paneId);
+
+            if (_broadcastInput)
+            {
+                control.BroadcastInputTo(nullptr);
+                _UpdateBroadcastInputTargets();
+            }
         }
     }
 
@@ -872,6 +896,11 @@ namespace winrt::TerminalApp::implementation
         });
 
         _controlEvents[paneId] = events;
+
+        if (_broadcastInput)
+        {
+            _UpdateBroadcastInputTargets();
+        }
     }
 
     // Method Description:
@@ -1561,6 +1590,58 @@ namespace winrt::TerminalApp::implementation
         }
     }
 
+    // Method Description:
+    // - Toggle broadcasting the input typed into any pane of this tab to all
+    //   of its other panes.
+    void TerminalTab::ToggleBroadcastInput()
+    {
+        _broadcastInput = !_broadcastInput;
+        _tabStatus.IsInputBroadcastActive(_broadcastInput);
+        _UpdateBroadcastInputTargets();
+    }
+
+    // Method Description:
+    // - Tells every control of this tab where to broadcast its input to: to
+    //   all the other controls while broadcasting is on, and nowhere otherwise.
+    //   Only the controls we're attached to count, so that a pane that's being
+    //   detached is left out.
+    void TerminalTab::_UpdateBroadcastInputTargets()
+    {
+        if (!_rootPane)
+        {
+            return;
+        }
+
+        std::vector<TermControl> controls;
+        _rootPane->WalkTree([&](auto pane) {
+            if (const auto control = pane->GetTerminalControl(); control && _controlEvents.count(pane->Id().value()))
+            {
+                controls.emplace_back(control);
+            }
+            return false;
+        });
+
+        for (const auto& control : controls)
+        {
+            if (!_broadcastInput)
+            {
+                control.BroadcastInputTo(nullptr);
+                continue;
+            }
+
+            std::vector<TermControl> targets;
+            targets.reserve(controls.size() - 1);
+            for (const auto& other : controls)
+            {
+                if (other != control)
+                {
+                    targets.emplace_back(other);
+                }
+            }
+            control.BroadcastInputTo(winrt::single_threaded_vector(std::move(targets)).GetView());
+        }
+    }
+
     // Method Description:
     // - Calculates if the tab is read-only.
     // The tab is considered read-only if one of the panes is read-only.
@@ -63,6 +63,7 @@ namespace winrt::TerminalApp::implementation
         bool FocusPane(const uint32_t id);
 
         void UpdateSettings();
+        void VisibilityChanged(const bool visible);
         winrt::fire_and_forget UpdateTitle();
 
         void Shutdown() override;
@@ -87,6 +88,7 @@ namespace winrt::TerminalApp::implementation
         int GetLeafPaneCount() const noexcept;
 
         void TogglePaneReadOnly();
+        void ToggleBroadcastInput();
         std::shared_ptr<Pane> GetActivePane() const;
         winrt::TerminalApp::TaskbarState GetCombinedTaskbarState() const;
 
@@ -135,6 +137,7 @@ namespace winrt::TerminalApp::implementation
         uint32_t _nextPaneId{ 0 };
 
         bool _receivedKeyDown{ false };
+        bool _broadcastInput{ false };
         bool _iconHidden{ false };
 
         winrt::hstring _runtimeTabText{};
@@ -170,6 +173,7 @@ namespace winrt::TerminalApp::implementation
         void _ClearTabBackgroundColor();
 
         void _RecalculateAndApplyReadOnly();
+        void _UpdateBroadcastInputTargets();
 
         void _UpdateProgressState();
 
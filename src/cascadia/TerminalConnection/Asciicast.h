@@ -0,0 +1,248 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- Asciicast.h
+
+Abstract:
+- Reads and writes session recordings in the asciicast v2 format[1]: a JSON
+  header line followed by one JSON array per event, each being
+  [seconds since the start, type, data]. The types we use are "o" for output,
+  "i" for input and "r" for a resize to "<columns>x<rows>".
+- This is header-only so that tools which don't link the connection DLL
+  (like TerminalBenchmark) can read recordings as well.
+
+[1]: https://github.com/asciinema/asciinema/blob/develop/doc/asciicast-v2.md
+--*/
+
+#pragma once
+
+#include <charconv>
+
+namespace Microsoft::Terminal::TerminalConnection::Asciicast
+{
+    struct Event
+    {
+        double time;
+        wchar_t type;
+        std::wstring data;
+    };
+
+    struct Recording
+    {
+        uint32_t columns = 0;
+        uint32_t rows = 0;
+        std::vector<Event> events;
+    };
+
+    // Appends the given UTF-8 as a JSON string, quotes included.
+    inline void AppendJsonString(std::string& out, const std::string_view utf8)
+    {
+        static constexpr char hex[] = "0123456789abcdef";
+
+        out.push_back('"');
+        for (const auto ch : utf8)
+        {
+            switch (ch)
+            {
+            case '"':
+                out.append("\\\"");
+                break;
+            case '\\':
+                out.append("\\\\");
+                break;
+            case '\n':
+                out.append("\\n");
+                break;
+            case '\r':
+                out.append("\\r");
+                break;
+            case '\t':
+                out.append("\\t");
+                break;
+            default:
+                if (static_cast<unsigned char>(ch) < 0x20)
+                {
+                    out.append("\\u00");
+                    out.push_back(til::at(hex, ch >> 4));
+                    out.push_back(til::at(hex, ch & 0xf));
+                }
+                else
+                {
+                    out.push_back(ch);
+                }
+                break;
+            }
+        }
+        out.push_back('"');
+    }
+
+    inline std::string FormatHeader(const uint32_t columns, const uint32_t rows, const int64_t timestamp)
+    {
+        return fmt::format(R"({{"version": 2, "width": {}, "height": {}, "timestamp": {}}})"
+                           "\n",
+                           columns,
+                           rows,
+                           timestamp);
+    }
+
+    inline void AppendEvent(std::string& out, const double time, const char type, const std::string_view utf8)
+    {
+        fmt::format_to(std::back_inserter(out), "[{:.6f}, \"{}\", ", time, type);
+        AppendJsonString(out, utf8);
+        out.append("]\n");
+    }
+
+    namespace details
+    {
+        inline void SkipSpaces(std::string_view& line) noexcept
+        {
+            while (!line.empty() && line.front() == ' ')
+            {
+                line.remove_prefix(1);
+            }
+        }
+
+        inline void Expect(std::string_view& line, const char ch)
+        {
+            SkipSpaces(line);
+            THROW_HR_IF(HRESULT_FROM_WIN32(ERROR_INVALID_DATA), line.empty() || line.front() != ch);
+            line.remove_prefix(1);
+        }
+
+        inline double ParseNumber(std::string_view& line)
+        {
+            SkipSpaces(line);
+            double value = 0;
+            const auto [end, error] = std::from_chars(line.data(), line.data() + line.size(), value);
+            THROW_HR_IF(HRESULT_FROM_WIN32(ERROR_INVALID_DATA), error != std::errc{});
+            line.remove_prefix(end - line.data());
+            return value;
+        }
+
+        inline std::wstring ParseString(std::string_view& line)
+        {
+            Expect(line, '"');
+
+            std::wstring value;
+            for (;;)
+            {
+                // Everything up to the next escape or the closing quote is taken as is.
+                const auto special = line.find_first_of("\"\\");
+                THROW_HR_IF(HRESULT_FROM_WIN32(ERROR_INVALID_DATA), special == std::string_view::npos);
+                value.append(til::u8u16(line.substr(0, special)));
+                const auto ch = line[special];
+                line.remove_prefix(special + 1);
+                if (ch == '"')
+                {
+                    return value;
+                }
+
+                THROW_HR_IF(HRESULT_FROM_WIN32(ERROR_INVALID_DATA), line.empty());
+                const auto escaped = line.front();
+                line.remove_prefix(1);
+                switch (escaped)
+                {
+                case 'n':
+                    value.push_back(L'\n');
+                    break;
+                case 'r':
+                    value.push_back(L'\r');
+                    break;
+                case 't':
+                    value.push_back(L'\t');
+                    break;
+                case 'b':
+                    value.push_back(L'\b');
+                    break;
+                case 'f':
+                    value.push_back(L'\f');
+                    break;
+                case 'u':
+                {
+                    // Surrogate pairs are two escapes in a row, which come out right on their own.
+                    THROW_HR_IF(HRESULT_FROM_WIN32(ERROR_INVALID_DATA), line.size() < 4);
+                    uint16_t unit = 0;
+                    const auto [end, error] = std::from_chars(line.data(), line.data() + 4, unit, 16);
+                    THROW_HR_IF(HRESULT_FROM_WIN32(ERROR_INVALID_DATA), error != std::errc{} || end != line.data() + 4);
+                    value.push_back(static_cast<wchar_t>(unit));
+                    line.remove_prefix(4);
+                    break;
+                }
+                default:
+                    // \" \\ and \/
+                    value.push_back(static_cast<wchar_t>(escaped));
+                    break;
+                }
+            }
+        }
+
+        inline uint32_t FindHeaderValue(const std::string_view header, const std::string_view key)
+        {
+            const auto position = header.find(key);
+            if (position == std::string_view::npos)
+            {
+                return 0;
+            }
+            auto rest = header.substr(position + key.size());
+            Expect(rest, ':');
+            return gsl::narrow_cast<uint32_t>(ParseNumber(rest));
+        }
+    }
+
+    // Routine Description:
+    // - Parses an asciicast v2 recording. Only the size is taken from the
+    //   header; everything else in it is ignored.
+    // - Throws if the recording is malformed.
+    // Arguments:
+    // - bytes - the contents of the recording
+    // Return Value:
+    // - the size of the terminal and the events, in the order they were recorded
+    inline Recording Parse(std::string_view bytes)
+    {
+        Recording recording;
+        bool haveHeader = false;
+
+        while (!bytes.empty())
+        {
+            const auto newline = bytes.find('\n');
+            auto line = bytes.substr(0, newline);
+            bytes.remove_prefix(newline == std::string_view::npos ? bytes.size() : newline + 1);
+
+            while (!line.empty() && (line.back() == '\r' || line.back() == ' '))
+            {
+                line.remove_suffix(1);
+            }
+            if (line.empty())
+            {
+                continue;
+            }
+
+            if (!haveHeader)
+            {
+                THROW_HR_IF(HRESULT_FROM_WIN32(ERROR_INVALID_DATA), line.front() != '{');
+                THROW_HR_IF(HRESULT_FROM_WIN32(ERROR_UNSUPPORTED_TYPE), details::FindHeaderValue(line, R"("version")") != 2);
+                recording.columns = details::FindHeaderValue(line, R"("width")");
+                recording.rows = details::FindHeaderValue(line, R"("height")");
+                haveHeader = true;
+                continue;
+            }
+
+            Event event;
+            details::Expect(line, '[');
+            event.time = details::ParseNumber(line);
+            details::Expect(line, ',');
+            const auto type = details::ParseString(line);
+            THROW_HR_IF(HRESULT_FROM_WIN32(ERROR_INVALID_DATA), type.size() != 1);
+            event.type = type.front();
+            details::Expect(line, ',');
+            event.data = details::ParseString(line);
+            details::Expect(line, ']');
+            recording.events.emplace_back(std::move(event));
+        }
+
+        THROW_HR_IF(HRESULT_FROM_WIN32(ERROR_INVALID_DATA), !haveHeader);
+        return recording;
+    }
+}
@@ -86,7 +86,7 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
     // - str: the string to write.
     void AzureConnection::_WriteStringWithNewline(const std::wstring_view str)
     {
-        _TerminalOutputHandlers(str + L"\r\n");
+        _raiseOutput(str + L"\r\n");
     }
 
     // Method description:
@@ -102,7 +102,7 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
         catch (const std::exception& runtimeException)
         {
             // This also catches the AzureException, which has a .what()
-            _TerminalOutputHandlers(_colorize(91, til::u8u16(std::string{ runtimeException.what() })));
+            _raiseOutput(_colorize(91, til::u8u16(std::string{ runtimeException.what() })));
         }
         catch (...)
         {
@@ -150,13 +150,13 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
 
         _currentInputMode = mode;
 
-        _TerminalOutputHandlers(L"> \x1b[92m"); // Make prompted user input green
+        _raiseOutput(L"> \x1b[92m"); // Make prompted user input green
 
         _inputEvent.wait(inputLock, [this, mode]() {
             return _currentInputMode != mode || _isStateAtOrBeyond(ConnectionState::Closing);
         });
 
-        _TerminalOutputHandlers(L"\x1b[m");
+        _raiseOutput(L"\x1b[m");
 
         if (_isStateAtOrBeyond(ConnectionState::Closing))
         {
@@ -184,11 +184,18 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
         if (_state == AzureState::TermConnected)
         {
             // If we're connected, we don't need to do any fun input shenanigans.
-            websocket_outgoing_message msg;
-            const auto str = winrt::to_string(data);
-            msg.set_utf8_message(str);
-
-            _cloudShellSocket.send(msg).get();
+            // The input is only buffered here. While a message is in flight,
+            // any further keystrokes pile up and are sent together once it's
+            // done, so fast typing over a slow link costs a message per round
+            // trip instead of one per key. This doesn't block the caller either.
+            std::lock_guard<std::mutex> lock{ _sendMutex };
+            THROW_IF_FAILED(til::u16u8(data, _u8Input, _u16State));
+            _pendingInput.append(_u8Input);
+            if (!_sendInFlight && !_pendingInput.empty())
+            {
+                _sendInFlight = true;
+                _SendPendingInputUnderLock();
+            }
             return;
         }
 
@@ -198,19 +205,19 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
             if (_userInput.size() > 0)
             {
                 _userInput.pop_back();
-                _TerminalOutputHandlers(L"\x08 \x08"); // overstrike the character with a space
+                _raiseOutput(L"\x08 \x08"); // overstrike the character with a space
             }
         }
         else
         {
-            _TerminalOutputHandlers(data); // echo back
+            _raiseOutput(data); // echo back
 
             switch (_currentInputMode)
             {
             case InputMode::Line:
                 if (data.size() > 0 && gsl::at(data, 0) == UNICODE_CARRIAGERETURN)
                 {
-                    _TerminalOutputHandlers(L"\r\n"); // we probably got a \r, so we need to advance to the next line.
+                    _raiseOutput(L"\r\n"); // we probably got a \r, so we need to advance to the next line.
                     _currentInputMode = InputMode::None; // toggling the mode indicates completion
                     _inputEvent.notify_one();
                     break;
@@ -223,6 +230,36 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
         }
     }
 
+    // Method description:
+    // - sends all the input buffered by WriteInput in a single message. Once
+    //   it's sent, this is called again for the input that piled up meanwhile.
+    //   The caller must hold _sendMutex.
+    void AzureConnection::_SendPendingInputUnderLock()
+    {
+        websocket_outgoing_message msg;
+        msg.set_utf8_message(std::exchange(_pendingInput, {}));
+
+        _cloudShellSocket.send(msg).then([self = get_strong()](const pplx::task<void>& sent) {
+            try
+            {
+                sent.get();
+            }
+            catch (...)
+            {
+                // The socket got closed. The output thread deals with that.
+                LOG_CAUGHT_EXCEPTION();
+            }
+
+            std::lock_guard<std::mutex> lock{ self->_sendMutex };
+            if (self->_pendingInput.empty() || !self->_isConnected())
+            {
+                self->_sendInFlight = false;
+                return;
+            }
+            self->_SendPendingInputUnderLock();
+        });
+    }
+
     // Method description:
     // - ascribes to the ITerminalConnection interface
     // - resizes the terminal
@@ -402,15 +439,20 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
                             }
                         }
 
+                        // Read the UTF-8 payload of the frame straight out of its stream
+                        // into our reused buffer. The decoder keeps its state across frames,
+                        // so a character split between two of them still comes out whole.
                         auto msg = msgT.get();
-                        auto msgStringTask = msg.extract_string();
-                        auto msgString = msgStringTask.get();
-
-                        // Convert to hstring
-                        const auto hstr = winrt::to_hstring(msgString);
+                        _u8Frame.resize(msg.length());
+                        const auto read = msg.body().streambuf().getn(reinterpret_cast<uint8_t*>(_u8Frame.data()), _u8Frame.size()).get();
+                        THROW_IF_FAILED(til::u8u16({ _u8Frame.data(), read }, _u16Output, _u8State));
+                        if (_u16Output.empty())
+                        {
+                            continue;
+                        }
 
                         // Pass the output to our registered event handlers
-                        _TerminalOutputHandlers(hstr);
+                        _raiseOutput(_u16Output);
                     }
                     return S_OK;
                 }
@@ -732,7 +774,7 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
         const auto shellType = _ParsePreferredShellType(settingsResponse);
         _WriteStringWithNewline(RS_(L"AzureRequestingTerminal"));
         const auto socketUri = _GetTerminal(shellType.value_or(L"pwsh"));
-        _TerminalOutputHandlers(L"\r\n");
+        _raiseOutput(L"\r\n");
 
         // Step 8: connecting to said terminal
         const auto connReqTask = _cloudShellSocket.connect(socketUri);
@@ -13,11 +13,12 @@
 
 #include "../cascadia/inc/cppwinrt_utils.h"
 #include "ConnectionStateHolder.h"
+#include "ConnectionOutputHolder.h"
 #include "AzureClient.h"
 
 namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
 {
-    struct AzureConnection : AzureConnectionT<AzureConnection>, ConnectionStateHolder<AzureConnection>
+    struct AzureConnection : AzureConnectionT<AzureConnection>, ConnectionStateHolder<AzureConnection>, ConnectionOutputHolder
     {
         static winrt::guid ConnectionType() noexcept;
         static bool IsAzureConnectionAvailable() noexcept;
@@ -30,8 +31,6 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
         void Resize(uint32_t rows, uint32_t columns);
         void Close();
 
-        WINRT_CALLBACK(TerminalOutput, TerminalOutputHandler);
-
     private:
         uint32_t _initialRows{};
         uint32_t _initialCols{};
@@ -98,6 +97,21 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
 
         web::websockets::client::websocket_client _cloudShellSocket;
 
+        // The output thread decodes every frame with these, so that we neither
+        // allocate nor convert twice per message.
+        std::string _u8Frame;
+        til::u8state _u8State{};
+        std::wstring _u16Output;
+
+        // The input that's waiting for the message in flight to be sent.
+        std::mutex _sendMutex;
+        std::string _pendingInput;
+        std::string _u8Input;
+        til::u16state _u16State{};
+        bool _sendInFlight{ false };
+
+        void _SendPendingInputUnderLock();
+
         static std::optional<utility::string_t> _ParsePreferredShellType(const web::json::value& settingsResponse);
     };
 }
@@ -35,7 +35,10 @@ try
     ComPtr<IUnknown> unk;
     RETURN_IF_FAILED(classFactory.As(&unk));
 
-    RETURN_IF_FAILED(CoRegisterClassObject(__uuidof(CTerminalHandoff), unk.Get(), CLSCTX_LOCAL_SERVER, REGCLS_SINGLEUSE, &g_cTerminalHandoffRegistration));
+    // We stay registered for as long as we listen, so that every further handoff
+    // lands in this already running process, instead of COM having to start
+    // a new one for each of them.
+    RETURN_IF_FAILED(CoRegisterClassObject(__uuidof(CTerminalHandoff), unk.Get(), CLSCTX_LOCAL_SERVER, REGCLS_MULTIPLEUSE, &g_cTerminalHandoffRegistration));
 
     _pfnHandoff = pfnHandoff;
 
@@ -93,22 +96,20 @@ static HRESULT _duplicateHandle(const HANDLE in, HANDLE& out) noexcept
 // - ref - Client reference handle for console session so it stays alive until we let go
 // - server - PTY process handle to track for lifetime/cleanup
 // - client - Process handle to client so we can track its lifetime and exit appropriately
+// - The handler only has to take the handles. The rest of the terminal attaches
+//   the connection asynchronously, so the client doesn't wait for a new tab.
 // Return Value:
 // - E_NOT_VALID_STATE if a event handler is not registered before calling. `::DuplicateHandle`
 //   error codes if we cannot manage to make our own copy of handles to retain. Or S_OK/error
 //   from the registered handler event function.
 HRESULT CTerminalHandoff::EstablishPtyHandoff(HANDLE in, HANDLE out, HANDLE signal, HANDLE ref, HANDLE server, HANDLE client)
 {
-    // Stash a local copy of _pfnHandoff before we stop listening.
-    auto localPfnHandoff = _pfnHandoff;
-
-    // Because we are REGCLS_SINGLEUSE... we need to `CoRevokeClassObject` after we handle this ONE call.
-    // COM does not automatically clean that up for us. We must do it.
-    s_StopListening();
-
-    std::unique_lock lock{ _mtx };
+    // We're REGCLS_MULTIPLEUSE, so several handoffs may come in at once on
+    // different COM threads. They only need to keep us from stopping meanwhile.
+    std::shared_lock lock{ _mtx };
 
     // Report an error if no one registered a handoff function before calling this.
+    const auto localPfnHandoff = _pfnHandoff;
     RETURN_HR_IF_NULL(E_NOT_VALID_STATE, localPfnHandoff);
 
     // Duplicate the handles from what we received.
@@ -0,0 +1,41 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include "../inc/cppwinrt_utils.h"
+
+namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
+{
+    // Provides the TerminalOutput and TerminalOutputView events of a
+    // connection that implements ITerminalOutputView.
+    struct ConnectionOutputHolder
+    {
+        WINRT_CALLBACK(TerminalOutput, TerminalOutputHandler);
+        WINRT_CALLBACK(TerminalOutputView, TerminalOutputViewHandler);
+
+    protected:
+        // Method Description:
+        // - Raises the given output through both events. The view handlers
+        //   read straight from the given string, so it only needs to stay
+        //   alive until this returns. A copy of it is only ever made for
+        //   the subscribers of TerminalOutput, if there are any.
+        // Arguments:
+        // - output: the output to raise
+        // Return Value:
+        // - <none>
+        void _raiseOutput(const std::wstring_view output)
+        {
+            if (_TerminalOutputViewHandlers)
+            {
+#pragma warning(suppress : 26490) // wchar_t and char16_t are the same UTF-16 code units.
+                const auto data = reinterpret_cast<const char16_t*>(output.data());
+                _TerminalOutputViewHandlers(winrt::array_view<const char16_t>{ data, gsl::narrow<uint32_t>(output.size()) });
+            }
+            if (_TerminalOutputHandlers)
+            {
+                _TerminalOutputHandlers(winrt::hstring{ output });
+            }
+        }
+    };
+}
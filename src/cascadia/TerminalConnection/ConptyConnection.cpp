@@ -34,6 +34,8 @@ using namespace ::Microsoft::Console;
 
 namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
 {
+    static constexpr DWORD s_pipeBufferSize = 128 * 1024;
+
     // Function Description:
     // - creates some basic anonymous pipes and passes them to CreatePseudoConsole
     // Arguments:
@@ -49,8 +51,10 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
         wil::unique_hfile outPipeOurSide, outPipePseudoConsoleSide;
         wil::unique_hfile inPipeOurSide, inPipePseudoConsoleSide;
 
-        RETURN_IF_WIN32_BOOL_FALSE(CreatePipe(&inPipePseudoConsoleSide, &inPipeOurSide, nullptr, 0));
-        RETURN_IF_WIN32_BOOL_FALSE(CreatePipe(&outPipeOurSide, &outPipePseudoConsoleSide, nullptr, 0));
+        // The default pipe buffer is only a page or so. Anything beyond that makes the
+        // writing side wait for the reading side, so give both pipes more room.
+        RETURN_IF_WIN32_BOOL_FALSE(CreatePipe(&inPipePseudoConsoleSide, &inPipeOurSide, nullptr, s_pipeBufferSize));
+        RETURN_IF_WIN32_BOOL_FALSE(CreatePipe(&outPipeOurSide, &outPipePseudoConsoleSide, nullptr, s_pipeBufferSize));
         RETURN_IF_FAILED(ConptyCreatePseudoConsole(size, inPipePseudoConsoleSide.get(), outPipePseudoConsoleSide.get(), dwFlags, phPC));
         *phInput = inPipeOurSide.release();
         *phOutput = outPipeOurSide.release();
@@ -123,6 +127,88 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
         };
     }
 
+    // The environment every client starts out with, before the per-profile
+    // variables are applied. Building it means reading and expanding the
+    // user's and the system's environment from the registry, which is slow
+    // enough to add up when opening a bunch of tabs at once. It's thus built
+    // once and kept until one of the keys it's built from changes, which is
+    // what a WM_SETTINGCHANGE "Environment" broadcast follows. The connection
+    // has no window to receive that broadcast, so it watches the keys instead.
+    struct BaseEnvironmentCache
+    {
+        std::mutex lock;
+        Utils::EnvironmentVariableMapW environment;
+        std::vector<wil::unique_hkey> keys;
+        wil::unique_event changed{ wil::EventOptions::ManualReset };
+        bool valid{ false };
+
+        // Opens the keys that CreateEnvironmentBlock reads. Returns false if
+        // any of them can't be watched, in which case nothing is cached.
+        bool OpenKeys() noexcept
+        {
+            static constexpr std::pair<HKEY, const wchar_t*> sources[]{
+                { HKEY_CURRENT_USER, L"Environment" },
+                { HKEY_CURRENT_USER, L"Volatile Environment" },
+                { HKEY_LOCAL_MACHINE, L"SYSTEM\\CurrentControlSet\\Control\\Session Manager\\Environment" },
+            };
+
+            if (keys.empty())
+            {
+                for (const auto& [root, subKey] : sources)
+                {
+                    wil::unique_hkey key;
+                    if (RegOpenKeyExW(root, subKey, 0, KEY_NOTIFY, key.put()) != ERROR_SUCCESS)
+                    {
+                        keys.clear();
+                        return false;
+                    }
+                    keys.emplace_back(std::move(key));
+                }
+            }
+            return true;
+        }
+
+        // Asks for the event to be signaled on the next change to any of the keys.
+        // Notifications are one-shot, so this has to be done again every time it fired.
+        bool Watch() noexcept
+        {
+            changed.ResetEvent();
+            for (const auto& key : keys)
+            {
+                if (RegNotifyChangeKeyValue(key.get(), TRUE, REG_NOTIFY_CHANGE_NAME | REG_NOTIFY_CHANGE_LAST_SET | REG_NOTIFY_THREAD_AGNOSTIC, changed.get(), TRUE) != ERROR_SUCCESS)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+
+    // Function Description:
+    // - Returns a copy of the environment that's used as the base of every
+    //   client's environment, rebuilding it only if it changed since the last call.
+    static Utils::EnvironmentVariableMapW _getBaseEnvironment()
+    {
+        static BaseEnvironmentCache cache;
+        std::lock_guard guard{ cache.lock };
+
+        if (!cache.valid || cache.changed.is_signaled())
+        {
+            // Start watching before reading, so that a change made while
+            // we're reading invalidates what we've read.
+            const auto watching = cache.OpenKeys() && cache.Watch();
+
+            cache.valid = false;
+            cache.environment.clear();
+            const auto newEnvironmentBlock{ Utils::CreateEnvironmentBlock() };
+            // Populate the environment map with the current environment.
+            THROW_IF_FAILED(Utils::UpdateEnvironmentMapW(cache.environment, newEnvironmentBlock.get()));
+            cache.valid = watching;
+        }
+
+        return cache.environment;
+    }
+
     // Function Description:
     // - launches the client application attached to the new pseudoconsole
     HRESULT ConptyConnection::_LaunchAttachedClient() noexcept
@@ -150,7 +236,7 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
 
         std::wstring cmdline{ wil::ExpandEnvironmentStringsW<std::wstring>(_commandline.c_str()) }; // mutable copy -- required for CreateProcessW
 
-        Utils::EnvironmentVariableMapW environment;
+        auto environment{ _getBaseEnvironment() };
         auto zeroEnvMap = wil::scope_exit([&]() noexcept {
             // Can't zero the keys, but at least we can zero the values.
             for (auto& [name, value] : environment)
@@ -161,12 +247,6 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
             environment.clear();
         });
 
-        {
-            const auto newEnvironmentBlock{ Utils::CreateEnvironmentBlock() };
-            // Populate the environment map with the current environment.
-            RETURN_IF_FAILED(Utils::UpdateEnvironmentMapW(environment, newEnvironmentBlock.get()));
-        }
-
         {
             // Convert connection Guid to string and ignore the enclosing '{}'.
             std::wstring wsGuid{ Utils::GuidToString(_guid) };
@@ -351,6 +431,20 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
         return _guid;
     }
 
+    // Method Description:
+    // - Tells the connection whether the user is interacting with its pane.
+    //   The thread that passes the output on to the terminal then gets a
+    //   higher priority, or a lower one with power throttling (EcoQoS) if
+    //   the pane isn't focused. See Utils::SetThreadSchedulingPolicy.
+    // Arguments:
+    // - focused: true if the pane of this connection has the focus.
+    // Return Value:
+    // - <none>
+    void ConptyConnection::SetFocused(const bool focused) noexcept
+    {
+        _outputThreadPolicy.store(focused ? Utils::ThreadSchedulingPolicy::Foreground : Utils::ThreadSchedulingPolicy::Background, std::memory_order_relaxed);
+    }
+
     void ConptyConnection::Start()
     try
     {
@@ -419,15 +513,15 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
         winrt::hstring failureText{ fmt::format(std::wstring_view{ RS_(L"ProcessFailedToLaunch") },
                                                 gsl::narrow_cast<unsigned long>(hr),
                                                 _commandline) };
-        _TerminalOutputHandlers(failureText);
+        _raiseOutput(failureText);
 
         // If the path was invalid, let's present an informative message to the user
         if (hr == HRESULT_FROM_WIN32(ERROR_DIRECTORY))
         {
             winrt::hstring badPathText{ fmt::format(std::wstring_view{ RS_(L"BadPathText") },
                                                     _startingDirectory) };
-            _TerminalOutputHandlers(L"\r\n");
-            _TerminalOutputHandlers(badPathText);
+            _raiseOutput(L"\r\n");
+            _raiseOutput(badPathText);
         }
 
         _transitionToState(ConnectionState::Failed);
@@ -445,8 +539,8 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
         try
         {
             winrt::hstring exitText{ fmt::format(std::wstring_view{ RS_(L"ProcessExited") }, status) };
-            _TerminalOutputHandlers(L"\r\n");
-            _TerminalOutputHandlers(exitText);
+            _raiseOutput(L"\r\n");
+            _raiseOutput(exitText);
         }
         CATCH_LOG();
     }
@@ -494,7 +588,99 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
         // convert from UTF-16LE to UTF-8 as ConPty expects UTF-8
         // TODO GH#3378 reconcile and unify UTF-8 converters
         std::string str = winrt::to_string(data);
-        LOG_IF_WIN32_BOOL_FALSE(WriteFile(_inPipe.get(), str.c_str(), (DWORD)str.length(), nullptr, nullptr));
+
+        {
+            std::lock_guard guard{ _inputLock };
+            if (_inputExit)
+            {
+                return;
+            }
+
+            if (!_inputThread.joinable())
+            {
+                _inputThread = std::thread([this]() {
+                    LOG_IF_FAILED(SetThreadDescription(GetCurrentThread(), L"ConptyConnection Input Thread"));
+                    _InputThread();
+                });
+            }
+
+            if (_pendingInput.empty())
+            {
+                _pendingInput = std::move(str);
+            }
+            else
+            {
+                _pendingInput.append(str);
+            }
+        }
+
+        _inputCondition.notify_one();
+    }
+
+    // Method Description:
+    // - Writes the input queued up by WriteInput to the pipe, in the order it
+    //   was written. Large inputs are written in chunks, so that conhost can
+    //   start working on the beginning of a paste while the rest is pending.
+    //   A full pipe only blocks this thread, not the one writing the input.
+    // Arguments:
+    // - <none>
+    // Return Value:
+    // - <none>
+    void ConptyConnection::_InputThread() noexcept
+    {
+        std::string input;
+
+        while (true)
+        {
+            {
+                std::unique_lock guard{ _inputLock };
+                _inputCondition.wait(guard, [&]() { return _inputExit || !_pendingInput.empty(); });
+                if (_inputExit)
+                {
+                    return;
+                }
+
+                // Swap buffers, so that the next write can reuse this one's memory.
+                input.clear();
+                std::swap(input, _pendingInput);
+            }
+
+            std::string_view remaining{ input };
+            while (!remaining.empty())
+            {
+                const auto chunk = remaining.substr(0, s_inputChunkSize);
+                DWORD written{};
+                if (!WriteFile(_inPipe.get(), chunk.data(), gsl::narrow_cast<DWORD>(chunk.size()), &written, nullptr))
+                {
+                    LOG_LAST_ERROR();
+                    break;
+                }
+                remaining = remaining.substr(written);
+            }
+        }
+    }
+
+    // Method Description:
+    // - Stops the input thread, dropping any input it hasn't written yet.
+    // Arguments:
+    // - <none>
+    // Return Value:
+    // - <none>
+    void ConptyConnection::_StopInputThread() noexcept
+    {
+        {
+            std::lock_guard guard{ _inputLock };
+            _inputExit = true;
+        }
+
+        _inputCondition.notify_one();
+
+        if (_inputThread.joinable())
+        {
+            // It might be stuck on a pipe that the other side stopped reading from.
+            CancelSynchronousIo(_inputThread.native_handle());
+            _inputThread.join();
+        }
     }
 
     void ConptyConnection::Resize(uint32_t rows, uint32_t columns)
@@ -523,6 +709,8 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
 
             _hPC.reset(); // tear down the pseudoconsole (this is like clicking X on a console window)
 
+            _StopInputThread(); // stop using _inPipe before we close it
+
             _inPipe.reset(); // break the pipes
             _outPipe.reset();
 
@@ -546,32 +734,140 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
     }
     CATCH_LOG()
 
+    // Method Description:
+    // - Reads the output pipe until it breaks, handing each filled buffer to
+    //   the output thread and reusing the ones it's done with.
+    // Arguments:
+    // - filled: the channel the filled buffers are sent to.
+    // - recycled: the channel the output thread returns parsed buffers through.
+    // Return Value:
+    // - The error that ended the read loop.
+    DWORD ConptyConnection::_ReadThread(const til::spsc::producer<std::string>& filled, const til::spsc::consumer<std::string>& recycled) noexcept
+    try
+    {
+        // Large bursts of output are read in larger chunks, so that they're parsed
+        // in a few large writes instead of many small ones. Once the output tapers
+        // off, the chunks shrink again to keep latency low.
+        auto readSize = s_minReadBufferSize;
+
+        while (true)
+        {
+            // This blocks once all buffers are in flight, which is when the pipe
+            // starts to fill up and the pseudoconsole has to wait for us.
+            auto buffer = recycled.pop();
+            if (!buffer)
+            {
+                // The output thread is gone.
+                return ERROR_OPERATION_ABORTED;
+            }
+
+            buffer->resize(readSize);
+
+            DWORD read{};
+            if (!ReadFile(_outPipe.get(), buffer->data(), gsl::narrow_cast<DWORD>(buffer->size()), &read, nullptr))
+            {
+                return GetLastError();
+            }
+
+            if (read == readSize)
+            {
+                // There's probably more waiting in the pipe.
+                readSize = std::min(readSize * 2, s_maxReadBufferSize);
+            }
+            else if (read < readSize / 4)
+            {
+                readSize = std::max(readSize / 2, s_minReadBufferSize);
+            }
+
+            buffer->resize(read);
+            if (!filled.emplace(std::move(*buffer)))
+            {
+                return ERROR_OPERATION_ABORTED;
+            }
+        }
+    }
+    catch (...)
+    {
+        LOG_CAUGHT_EXCEPTION();
+        return ERROR_OUTOFMEMORY;
+    }
+
     DWORD ConptyConnection::_OutputThread()
     {
         // Keep us alive until the output thread terminates; the destructor
         // won't wait for us, and the known exit points _do_.
         auto strongThis{ get_strong() };
 
+        std::thread reader;
+        DWORD readError{ ERROR_SUCCESS };
+
+        // Makes sure the reader thread has stopped before we return, and with it any use of _outPipe.
+        auto stopReader = wil::scope_exit([&]() noexcept {
+            if (reader.joinable())
+            {
+                // The reader might still block in ReadFile if we return before the pipe broke.
+                CancelSynchronousIo(reader.native_handle());
+                reader.join();
+            }
+        });
+
+        // The channels are declared after the scope_exit, so that
+        // they're destroyed first, which unblocks the reader.
+        auto [filledTx, filledRx] = til::spsc::channel<std::string>(s_readBufferCount);
+        auto [recycledTx, recycledRx] = til::spsc::channel<std::string>(s_readBufferCount);
+        for (uint32_t i = 0; i < s_readBufferCount; ++i)
+        {
+            recycledTx.emplace();
+        }
+
+        reader = std::thread([this, &readError, filled = std::move(filledTx), recycled = std::move(recycledRx)]() {
+            LOG_IF_FAILED(SetThreadDescription(GetCurrentThread(), L"ConptyConnection Read Thread"));
+            readError = _ReadThread(filled, recycled);
+            // filled goes out of scope with the lambda, telling the output thread that we're done.
+        });
+
+        std::array<std::string, s_readBufferCount> chunks;
+        auto appliedPolicy = Utils::ThreadSchedulingPolicy::Default;
+
         // process the data of the output pipe in a loop
         while (true)
         {
-            DWORD read{};
+            // This waits for at least one chunk, but also takes any others that are
+            // already waiting, so that a burst of output is passed on in one write.
+            const auto count = filledRx.pop_n(til::spsc::block_initially, chunks.begin(), chunks.size()).first;
 
-            const auto readFail{ !ReadFile(_outPipe.get(), _buffer.data(), gsl::narrow_cast<DWORD>(_buffer.size()), &read, nullptr) };
-            if (readFail) // reading failed (we must check this first, because read will also be 0.)
+            if (const auto policy = _outputThreadPolicy.load(std::memory_order_relaxed); policy != appliedPolicy)
             {
-                const auto lastError = GetLastError();
-                if (lastError != ERROR_BROKEN_PIPE && !_isStateAtOrBeyond(ConnectionState::Closing))
+                Utils::SetThreadSchedulingPolicy(GetCurrentThread(), policy);
+                appliedPolicy = policy;
+            }
+            if (count == 0) // the reader stopped (we must check this first, because the chunk will also be empty.)
+            {
+                if (!reader.joinable())
+                {
+                    // We already converted the remaining partials below.
+                    return 0;
+                }
+
+                reader.join();
+                if (readError != ERROR_BROKEN_PIPE && !_isStateAtOrBeyond(ConnectionState::Closing))
                 {
                     // EXIT POINT
-                    _indicateExitWithStatus(HRESULT_FROM_WIN32(lastError)); // print a message
+                    _indicateExitWithStatus(HRESULT_FROM_WIN32(readError)); // print a message
                     _transitionToState(ConnectionState::Failed);
-                    return gsl::narrow_cast<DWORD>(HRESULT_FROM_WIN32(lastError));
+                    return gsl::narrow_cast<DWORD>(HRESULT_FROM_WIN32(readError));
                 }
                 // else we call convertUTF8ChunkToUTF16 with an empty string_view to convert possible remaining partials to U+FFFD
+                chunks[0].clear();
+            }
+
+            auto& buffer = til::at(chunks, 0);
+            for (size_t i = 1; i < count; ++i)
+            {
+                buffer.append(til::at(chunks, i));
             }
 
-            const HRESULT result{ til::u8u16(std::string_view{ _buffer.data(), read }, _u16Str, _u8State) };
+            const HRESULT result{ til::u8u16(buffer, _u16Str, _u8State) };
             if (FAILED(result))
             {
                 if (_isStateAtOrBeyond(ConnectionState::Closing))
@@ -586,9 +882,20 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
                 return gsl::narrow_cast<DWORD>(result);
             }
 
+            // Hand the buffers back to the reader, so they can be refilled.
+            // Once the reader is gone this fails, which is fine.
+            for (size_t i = 0; i < count; ++i)
+            {
+                recycledTx.emplace(std::move(til::at(chunks, i)));
+            }
+
             if (_u16Str.empty())
             {
-                return 0;
+                if (!reader.joinable())
+                {
+                    return 0;
+                }
+                continue;
             }
 
             if (!_receivedFirstByte)
@@ -608,7 +915,7 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
             }
 
             // Pass the output to our registered event handlers
-            _TerminalOutputHandlers(_u16Str);
+            _raiseOutput(_u16Str);
         }
 
         return 0;
@@ -652,6 +959,12 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
     //   be awaiting our destruction breaks the deadlock.
     // Arguments:
     // - connection: the final living reference to an outgoing connection
+    ConptyConnection::~ConptyConnection()
+    {
+        // If the client exited on its own, Close() might have never stopped it.
+        _StopInputThread();
+    }
+
     winrt::fire_and_forget ConptyConnection::final_release(std::unique_ptr<ConptyConnection> connection)
     {
         co_await winrt::resume_background(); // move to background
@@ -5,10 +5,14 @@
 
 #include "ConptyConnection.g.h"
 #include "ConnectionStateHolder.h"
+#include "ConnectionOutputHolder.h"
 #include "../inc/cppwinrt_utils.h"
+#include "../../types/inc/utils.hpp"
 
 #include <conpty-static.h>
 
+#include <condition_variable>
+
 namespace wil
 {
     // These belong in WIL upstream, so when we reingest the change that has them we'll get rid of ours.
@@ -17,7 +21,7 @@ namespace wil
 
 namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
 {
-    struct ConptyConnection : ConptyConnectionT<ConptyConnection>, ConnectionStateHolder<ConptyConnection>
+    struct ConptyConnection : ConptyConnectionT<ConptyConnection>, ConnectionStateHolder<ConptyConnection>, ConnectionOutputHolder
     {
         ConptyConnection(const HANDLE hSig,
                          const HANDLE hIn,
@@ -27,6 +31,7 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
                          const HANDLE hClientProcess);
 
         ConptyConnection() noexcept = default;
+        ~ConptyConnection();
         void Initialize(const Windows::Foundation::Collections::ValueSet& settings);
 
         static winrt::fire_and_forget final_release(std::unique_ptr<ConptyConnection> connection);
@@ -37,6 +42,7 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
         void Close() noexcept;
 
         winrt::guid Guid() const noexcept;
+        void SetFocused(const bool focused) noexcept;
 
         static void StartInboundListener();
         static void StopInboundListener();
@@ -52,8 +58,6 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
                                                                          uint32_t columns,
                                                                          winrt::guid const& guid);
 
-        WINRT_CALLBACK(TerminalOutput, TerminalOutputHandler);
-
     private:
         HRESULT _LaunchAttachedClient() noexcept;
         void _indicateExitWithStatus(unsigned int status) noexcept;
@@ -80,11 +84,34 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
         wil::unique_static_pseudoconsole_handle _hPC;
         wil::unique_threadpool_wait _clientExitWait;
 
+        // The output is read by a separate thread into one of several buffers, so that
+        // the pipe keeps draining while the previous buffer is being parsed.
+        // Each read is between the min and max size, depending on how busy the pipe is.
+        static constexpr size_t s_minReadBufferSize = 4096;
+        static constexpr size_t s_maxReadBufferSize = 128 * 1024;
+        static constexpr uint32_t s_readBufferCount = 4;
+
+        // Applied by the output thread itself the next time it wakes up,
+        // so that nobody needs to hold on to its handle. See SetFocused.
+        std::atomic<::Microsoft::Console::Utils::ThreadSchedulingPolicy> _outputThreadPolicy{ ::Microsoft::Console::Utils::ThreadSchedulingPolicy::Default };
+
         til::u8state _u8State{};
         std::wstring _u16Str{};
-        std::array<char, 4096> _buffer{};
+
+        // Input is written to the pipe by a separate thread, so that a large paste
+        // doesn't block the caller while conhost works through it.
+        static constexpr size_t s_inputChunkSize = 64 * 1024;
+
+        std::thread _inputThread;
+        std::mutex _inputLock;
+        std::condition_variable _inputCondition;
+        std::string _pendingInput;
+        bool _inputExit{ false };
 
         DWORD _OutputThread();
+        void _InputThread() noexcept;
+        void _StopInputThread() noexcept;
+        DWORD _ReadThread(const til::spsc::producer<std::string>& filled, const til::spsc::consumer<std::string>& recycled) noexcept;
     };
 }
 
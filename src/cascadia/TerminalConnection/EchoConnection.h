@@ -6,10 +6,11 @@
 #include "EchoConnection.g.h"
 
 #include "../cascadia/inc/cppwinrt_utils.h"
+#include "ConnectionOutputHolder.h"
 
 namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
 {
-    struct EchoConnection : EchoConnectionT<EchoConnection>
+    struct EchoConnection : EchoConnectionT<EchoConnection>, ConnectionOutputHolder
     {
         EchoConnection() noexcept;
 
@@ -22,7 +23,6 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
 
         ConnectionState State() const noexcept { return ConnectionState::Connected; }
 
-        WINRT_CALLBACK(TerminalOutput, TerminalOutputHandler);
         TYPED_EVENT(StateChanged, ITerminalConnection, IInspectable);
     };
 }
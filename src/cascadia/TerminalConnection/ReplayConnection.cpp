@@ -0,0 +1,157 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "pch.h"
+#include "ReplayConnection.h"
+#include "Asciicast.h"
+
+#include "ReplayConnection.g.cpp"
+
+#include "LibraryResources.h"
+
+using namespace ::Microsoft::Terminal::TerminalConnection;
+
+// {4e2f4b1a-8c3d-4f0e-9a6b-2d7c5e1f3a90}
+static constexpr winrt::guid ReplayConnectionType = { 0x4e2f4b1a, 0x8c3d, 0x4f0e, { 0x9a, 0x6b, 0x2d, 0x7c, 0x5e, 0x1f, 0x3a, 0x90 } };
+
+namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
+{
+    winrt::guid ReplayConnection::ConnectionType() noexcept
+    {
+        return ReplayConnectionType;
+    }
+
+    // Function Description:
+    // - Helper function for constructing a ValueSet that we can use to get our settings from.
+    Windows::Foundation::Collections::ValueSet ReplayConnection::CreateSettings(const winrt::hstring& path, double speed)
+    {
+        Windows::Foundation::Collections::ValueSet vs{};
+        vs.Insert(L"path", Windows::Foundation::PropertyValue::CreateString(path));
+        vs.Insert(L"speed", Windows::Foundation::PropertyValue::CreateDouble(speed));
+        return vs;
+    }
+
+    void ReplayConnection::Initialize(const Windows::Foundation::Collections::ValueSet& settings)
+    {
+        if (settings)
+        {
+            _path = winrt::unbox_value_or<winrt::hstring>(settings.TryLookup(L"path").try_as<Windows::Foundation::IPropertyValue>(), _path);
+            _speed = winrt::unbox_value_or<double>(settings.TryLookup(L"speed").try_as<Windows::Foundation::IPropertyValue>(), _speed);
+        }
+    }
+
+    void ReplayConnection::Start()
+    {
+        _hOutputThread.reset(CreateThread(
+            nullptr,
+            0,
+            [](LPVOID lpParameter) noexcept {
+                const auto pInstance = static_cast<ReplayConnection*>(lpParameter);
+                if (pInstance)
+                {
+                    return pInstance->_OutputThread();
+                }
+                return gsl::narrow_cast<DWORD>(E_INVALIDARG);
+            },
+            this,
+            0,
+            nullptr));
+
+        THROW_LAST_ERROR_IF_NULL(_hOutputThread);
+
+        LOG_IF_FAILED(SetThreadDescription(_hOutputThread.get(), L"ReplayConnection Output Thread"));
+
+        _transitionToState(ConnectionState::Connecting);
+    }
+
+    // Input is dropped: it was part of the recording already.
+    void ReplayConnection::WriteInput(hstring const& /*data*/) noexcept
+    {
+    }
+
+    // The recorded output was laid out for the size it was recorded at,
+    // which we can't change. The terminal simply shows it as it is.
+    void ReplayConnection::Resize(uint32_t /*rows*/, uint32_t /*columns*/) noexcept
+    {
+    }
+
+    void ReplayConnection::Close()
+    {
+        if (_transitionToState(ConnectionState::Closing))
+        {
+            _closingEvent.SetEvent();
+
+            if (_hOutputThread)
+            {
+                WaitForSingleObject(_hOutputThread.get(), INFINITE);
+                _hOutputThread.reset();
+            }
+
+            _transitionToState(ConnectionState::Closed);
+        }
+    }
+
+    DWORD ReplayConnection::_OutputThread()
+    try
+    {
+        std::string bytes;
+        {
+            wil::unique_hfile file{ CreateFileW(_path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr) };
+            THROW_LAST_ERROR_IF(!file);
+            LARGE_INTEGER size{};
+            THROW_IF_WIN32_BOOL_FALSE(GetFileSizeEx(file.get(), &size));
+            bytes.resize(gsl::narrow<size_t>(size.QuadPart));
+            DWORD read = 0;
+            THROW_IF_WIN32_BOOL_FALSE(ReadFile(file.get(), bytes.data(), gsl::narrow<DWORD>(bytes.size()), &read, nullptr));
+            bytes.resize(read);
+        }
+        const auto recording = Asciicast::Parse(bytes);
+
+        _transitionToState(ConnectionState::Connected);
+
+        const auto start = std::chrono::steady_clock::now();
+        for (const auto& event : recording.events)
+        {
+            if (event.type != L'o')
+            {
+                continue;
+            }
+
+            if (_speed > 0)
+            {
+                const auto due = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>{ event.time / _speed });
+                const auto now = std::chrono::steady_clock::now();
+                if (due > now && _closingEvent.wait(gsl::narrow_cast<DWORD>(std::chrono::duration_cast<std::chrono::milliseconds>(due - now).count())))
+                {
+                    return 0;
+                }
+            }
+
+            if (_isStateAtOrBeyond(ConnectionState::Closing))
+            {
+                return 0;
+            }
+            _raiseOutput(event.data);
+        }
+
+        // Stay connected, so that the pane doesn't close before the
+        // recording could be looked at.
+        return 0;
+    }
+    catch (...)
+    {
+        const auto hr = wil::ResultFromCaughtException();
+        if (_isStateAtOrBeyond(ConnectionState::Closing))
+        {
+            return 0;
+        }
+
+        try
+        {
+            _raiseOutput(fmt::format(std::wstring_view{ RS_(L"ReplayFailed") }, static_cast<unsigned int>(hr), _path));
+        }
+        CATCH_LOG();
+        _transitionToState(ConnectionState::Failed);
+        return gsl::narrow_cast<DWORD>(hr);
+    }
+}
@@ -0,0 +1,44 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include "ReplayConnection.g.h"
+
+#include "../cascadia/inc/cppwinrt_utils.h"
+#include "ConnectionStateHolder.h"
+#include "ConnectionOutputHolder.h"
+
+namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
+{
+    // Plays back a session recording (see Asciicast.h), as if the output came
+    // from a real connection. The speed is a multiple of real time, or 0 to
+    // play everything back as fast as the terminal accepts it.
+    struct ReplayConnection : ReplayConnectionT<ReplayConnection>, ConnectionStateHolder<ReplayConnection>, ConnectionOutputHolder
+    {
+        static winrt::guid ConnectionType() noexcept;
+        static Windows::Foundation::Collections::ValueSet CreateSettings(const winrt::hstring& path, double speed);
+
+        ReplayConnection() = default;
+        void Initialize(const Windows::Foundation::Collections::ValueSet& settings);
+
+        void Start();
+        void WriteInput(hstring const& data) noexcept;
+        void Resize(uint32_t rows, uint32_t columns) noexcept;
+        void Close();
+
+    private:
+        DWORD _OutputThread();
+
+        hstring _path;
+        double _speed{ 1.0 };
+
+        wil::unique_handle _hOutputThread;
+        wil::unique_event _closingEvent{ wil::EventOptions::ManualReset };
+    };
+}
+
+namespace winrt::Microsoft::Terminal::TerminalConnection::factory_implementation
+{
+    BASIC_FACTORY(ReplayConnection);
+}
@@ -27,12 +27,36 @@ using namespace winrt::Windows::ApplicationModel::DataTransfer;
 // The updates are throttled to limit power usage.
 constexpr const auto ScrollBarUpdateInterval = std::chrono::milliseconds(8);
 
+// The minimum delay between two mouse motion reports, about one frame.
+constexpr const auto MouseMotionInterval = std::chrono::milliseconds(16);
+
 // The minimum delay between updating the TSF input control.
 constexpr const auto TsfRedrawInterval = std::chrono::milliseconds(100);
 
+// The minimum delay between raising the tab status events (title, tab color
+// and taskbar progress), about one frame.
+constexpr const auto TabStatusInterval = std::chrono::milliseconds(16);
+
+// The minimum delay between redrawing the scrollback minimap.
+constexpr const auto ScrollbackOverviewInterval = std::chrono::milliseconds(250);
+
 // The minimum delay between updating the locations of regex patterns
 constexpr const auto UpdatePatternLocationsInterval = std::chrono::milliseconds(500);
 
+// The minimum delay between resizing the buffer and the connection to the
+// size of the panel, while the panel keeps changing its size.
+constexpr const auto ResizeInterval = std::chrono::milliseconds(100);
+
+// The output rate is measured over windows of this length. Once the output
+// stopped for this long, we also leave the throughput mode.
+constexpr const auto ThroughputModeWindow = std::chrono::milliseconds(100);
+
+// The output rate (in characters per second) from which on we stop
+// invalidating the screen chunk by chunk, and the rate below which we go back
+// to it. They're apart, so that we don't keep toggling around the threshold.
+constexpr uint64_t EnterThroughputModeRate = 1'000'000;
+constexpr uint64_t LeaveThroughputModeRate = 250'000;
+
 namespace winrt::Microsoft::Terminal::Control::implementation
 {
     // Helper static function to ensure that all ambiguous-width glyphs are reported as narrow.
@@ -42,6 +66,33 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         return false; // glyph is not wide.
     }
 
+    // Writes one half of the "ControlInitializePhase" region, which breaks
+    // Initialize down into setting up the renderer and starting the
+    // connection. See ConsolePerf.regions.xml.
+    static void _traceInitializePhase(const char* phase, const bool start) noexcept
+    {
+        if (start)
+        {
+#pragma warning(suppress : 26477 26485 26494 26482 26446 26447) // We don't control TraceLoggingWrite
+            TraceLoggingWrite(g_hTerminalControlProvider,
+                              "ControlInitializePhase",
+                              TraceLoggingString(phase, "Phase"),
+                              TraceLoggingOpcode(WINEVENT_OPCODE_START),
+                              TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+                              TraceLoggingKeyword(TIL_KEYWORD_TRACE));
+        }
+        else
+        {
+#pragma warning(suppress : 26477 26485 26494 26482 26446 26447) // We don't control TraceLoggingWrite
+            TraceLoggingWrite(g_hTerminalControlProvider,
+                              "ControlInitializePhase",
+                              TraceLoggingString(phase, "Phase"),
+                              TraceLoggingOpcode(WINEVENT_OPCODE_STOP),
+                              TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+                              TraceLoggingKeyword(TIL_KEYWORD_TRACE));
+        }
+    }
+
     static bool _EnsureStaticInitialization()
     {
         // use C++11 magic statics to make sure we only do this once.
@@ -54,8 +105,55 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         return initialized;
     }
 
+    // Helper static function to compare the font features or axes of two settings.
+    // A missing map is the same as an empty one.
+    template<typename TMap>
+    static bool _FontMapsEqual(const TMap& a, const TMap& b)
+    {
+        const auto sizeA = a ? a.Size() : 0u;
+        const auto sizeB = b ? b.Size() : 0u;
+        if (sizeA != sizeB)
+        {
+            return false;
+        }
+        if (sizeA == 0)
+        {
+            return true;
+        }
+
+        for (const auto& [key, value] : a)
+        {
+            if (!b.HasKey(key) || b.Lookup(key) != value)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
     ControlCore::ControlCore(IControlSettings settings,
                              TerminalConnection::ITerminalConnection connection) :
+        ControlCore(settings, connection, nullptr)
+    {
+    }
+
+    // Method Description:
+    // - Creates a read-only mirror of the given core. The mirror renders the
+    //   same terminal with a viewport of its own, so the output is only
+    //   parsed once. It doesn't send any input, nor does it own the
+    //   connection: it only follows the connection's state.
+    // Arguments:
+    // - settings: the settings to render the terminal with
+    // - mirrored: the core to mirror
+    ControlCore::ControlCore(IControlSettings settings,
+                             const ControlCore& mirrored) :
+        ControlCore(settings, mirrored._connection, mirrored._terminal)
+    {
+    }
+
+    ControlCore::ControlCore(IControlSettings settings,
+                             TerminalConnection::ITerminalConnection connection,
+                             std::shared_ptr<::Microsoft::Terminal::Core::Terminal> mirroredTerminal) :
         _connection{ connection },
         _settings{ settings },
         _desiredFont{ DEFAULT_FONT_FACE, 0, DEFAULT_FONT_WEIGHT, { 0, DEFAULT_FONT_SIZE }, CP_UTF8 },
@@ -63,46 +161,72 @@ namespace winrt::Microsoft::Terminal::Control::implementation
     {
         _EnsureStaticInitialization();
 
-        _terminal = std::make_unique<::Microsoft::Terminal::Core::Terminal>();
+        if (mirroredTerminal)
+        {
+            _terminal = std::move(mirroredTerminal);
+            _mirror = std::make_unique<MirrorRenderData>(*_terminal);
+        }
+        else
+        {
+            _terminal = std::make_shared<::Microsoft::Terminal::Core::Terminal>();
+        }
 
         // Subscribe to the connection's disconnected event and call our connection closed handlers.
         _connectionStateChangedRevoker = _connection.StateChanged(winrt::auto_revoke, [this](auto&& /*s*/, auto&& /*v*/) {
             _ConnectionStateChangedHandlers(*this, nullptr);
         });
 
-        // This event is explicitly revoked in the destructor: does not need weak_ref
-        _connectionOutputEventToken = _connection.TerminalOutput({ this, &ControlCore::_connectionOutputHandler });
+        // The output and the callbacks of the terminal belong to the core that's mirrored.
+        if (!_mirror)
+        {
+            // This event is explicitly revoked in the destructor: does not need weak_ref
+            // If the connection supports it, its output is parsed straight from its buffer.
+            _connectionOutputView = _connection.try_as<TerminalConnection::ITerminalOutputView>();
+            if (_connectionOutputView)
+            {
+                _connectionOutputEventToken = _connectionOutputView.TerminalOutputView([this](const winrt::array_view<const char16_t> output) {
+#pragma warning(suppress : 26490) // wchar_t and char16_t are the same UTF-16 code units.
+                    _connectionOutputHandler({ reinterpret_cast<const wchar_t*>(output.data()), output.size() });
+                });
+            }
+            else
+            {
+                _connectionOutputEventToken = _connection.TerminalOutput([this](const hstring& output) {
+                    _connectionOutputHandler(output);
+                });
+            }
 
-        _terminal->SetWriteInputCallback([this](std::wstring& wstr) {
-            _sendInputToConnection(wstr);
-        });
+            _terminal->SetWriteInputCallback([this](std::wstring& wstr) {
+                _sendInputToConnection(wstr);
+            });
 
-        // GH#8969: pre-seed working directory to prevent potential races
-        _terminal->SetWorkingDirectory(_settings.StartingDirectory());
+            // GH#8969: pre-seed working directory to prevent potential races
+            _terminal->SetWorkingDirectory(_settings.StartingDirectory());
 
-        auto pfnCopyToClipboard = std::bind(&ControlCore::_terminalCopyToClipboard, this, std::placeholders::_1);
-        _terminal->SetCopyToClipboardCallback(pfnCopyToClipboard);
+            auto pfnCopyToClipboard = std::bind(&ControlCore::_terminalCopyToClipboard, this, std::placeholders::_1);
+            _terminal->SetCopyToClipboardCallback(pfnCopyToClipboard);
 
-        auto pfnWarningBell = std::bind(&ControlCore::_terminalWarningBell, this);
-        _terminal->SetWarningBellCallback(pfnWarningBell);
+            auto pfnWarningBell = std::bind(&ControlCore::_terminalWarningBell, this);
+            _terminal->SetWarningBellCallback(pfnWarningBell);
 
-        auto pfnTitleChanged = std::bind(&ControlCore::_terminalTitleChanged, this, std::placeholders::_1);
-        _terminal->SetTitleChangedCallback(pfnTitleChanged);
+            auto pfnTitleChanged = std::bind(&ControlCore::_terminalTitleChanged, this, std::placeholders::_1);
+            _terminal->SetTitleChangedCallback(pfnTitleChanged);
 
-        auto pfnTabColorChanged = std::bind(&ControlCore::_terminalTabColorChanged, this, std::placeholders::_1);
-        _terminal->SetTabColorChangedCallback(pfnTabColorChanged);
+            auto pfnTabColorChanged = std::bind(&ControlCore::_terminalTabColorChanged, this, std::placeholders::_1);
+            _terminal->SetTabColorChangedCallback(pfnTabColorChanged);
 
-        auto pfnBackgroundColorChanged = std::bind(&ControlCore::_terminalBackgroundColorChanged, this, std::placeholders::_1);
-        _terminal->SetBackgroundCallback(pfnBackgroundColorChanged);
+            auto pfnBackgroundColorChanged = std::bind(&ControlCore::_terminalBackgroundColorChanged, this, std::placeholders::_1);
+            _terminal->SetBackgroundCallback(pfnBackgroundColorChanged);
 
-        auto pfnScrollPositionChanged = std::bind(&ControlCore::_terminalScrollPositionChanged, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
-        _terminal->SetScrollPositionChangedCallback(pfnScrollPositionChanged);
+            auto pfnScrollPositionChanged = std::bind(&ControlCore::_terminalScrollPositionChanged, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
+            _terminal->SetScrollPositionChangedCallback(pfnScrollPositionChanged);
 
-        auto pfnTerminalCursorPositionChanged = std::bind(&ControlCore::_terminalCursorPositionChanged, this);
-        _terminal->SetCursorPositionChangedCallback(pfnTerminalCursorPositionChanged);
+            auto pfnTerminalCursorPositionChanged = std::bind(&ControlCore::_terminalCursorPositionChanged, this);
+            _terminal->SetCursorPositionChangedCallback(pfnTerminalCursorPositionChanged);
 
-        auto pfnTerminalTaskbarProgressChanged = std::bind(&ControlCore::_terminalTaskbarProgressChanged, this);
-        _terminal->TaskbarProgressChangedCallback(pfnTerminalTaskbarProgressChanged);
+            auto pfnTerminalTaskbarProgressChanged = std::bind(&ControlCore::_terminalTaskbarProgressChanged, this);
+            _terminal->TaskbarProgressChangedCallback(pfnTerminalTaskbarProgressChanged);
+        }
 
         // MSFT 33353327: Initialize the renderer in the ctor instead of Initialize().
         // We need the renderer to be ready to accept new engines before the SwapChainPanel is ready to go.
@@ -118,7 +242,9 @@ namespace winrt::Microsoft::Terminal::Control::implementation
             auto* const localPointerToThread = renderThread.get();
 
             // Now create the renderer and initialize the render thread.
-            _renderer = std::make_unique<::Microsoft::Console::Render::Renderer>(_terminal.get(), nullptr, 0, std::move(renderThread));
+            // A mirror renders the terminal with its own viewport.
+            ::Microsoft::Console::Render::IRenderData* const renderData = _mirror ? static_cast<::Microsoft::Console::Render::IRenderData*>(_mirror.get()) : _terminal.get();
+            _renderer = std::make_unique<::Microsoft::Console::Render::Renderer>(renderData, nullptr, 0, std::move(renderThread));
 
             _renderer->SetRendererEnteredErrorStateCallback([weakThis = get_weak()]() {
                 if (auto strongThis{ weakThis.get() })
@@ -175,13 +301,95 @@ namespace winrt::Microsoft::Terminal::Control::implementation
                 }
             });
 
-        _updateScrollBar = std::make_shared<ThrottledFuncTrailing<Control::ScrollPositionChangedArgs>>(
+        _updateScrollBar = std::make_shared<ThrottledFuncTrailing<>>(
             _dispatcher,
             ScrollBarUpdateInterval,
-            [weakThis = get_weak()](const auto& update) {
+            [weakThis = get_weak()]() {
+                if (auto core{ weakThis.get() }; !core->_IsClosing())
+                {
+                    core->_publishScrollPosition();
+                }
+            });
+
+        // * _resizeToPanel: Every resize reflows the buffer and sends a resize
+        //   to the connection, which in turn makes the shell redraw its
+        //   prompt. While the window is dragged, we get a SizeChanged for
+        //   about every frame, so we only follow the panel's latest size once
+        //   every 100ms. The trailing call guarantees that we end up at its
+        //   final size. Until then, the renderer keeps drawing at the old
+        //   size. Every pane's control does this, so a drag that resizes the
+        //   whole tree of panes still only resizes each of them so often.
+        _resizeToPanel = std::make_shared<ThrottledFuncTrailing<>>(
+            _dispatcher,
+            ResizeInterval,
+            [weakThis = get_weak()]() {
+                if (auto core{ weakThis.get() }; !core->_IsClosing())
+                {
+                    core->_resizeToPanelSize();
+                }
+            });
+
+        // * _leaveThroughputModeWhenIdle: While we're in the throughput mode,
+        //   this checks if the output stopped, since then there's no more
+        //   output to measure its rate with. See _updateThroughputMode.
+        _leaveThroughputModeWhenIdle = std::make_shared<ThrottledFuncTrailing<>>(
+            _dispatcher,
+            ThroughputModeWindow,
+            [weakThis = get_weak()]() {
+                if (auto core{ weakThis.get() }; !core->_IsClosing() && core->_throughputMode.load(std::memory_order_relaxed))
+                {
+                    const auto idle = std::chrono::steady_clock::now() - core->_lastOutputTime.load(std::memory_order_relaxed);
+                    if (idle >= ThroughputModeWindow)
+                    {
+                        core->_setThroughputMode(false, 0);
+                    }
+                    else
+                    {
+                        core->_leaveThroughputModeWhenIdle->Run();
+                    }
+                }
+            });
+
+        // * _flushMouseMotion: A high polling rate mouse reports far more
+        //   motion than a mouse mode application (tmux, htop, ...) can use.
+        //   The terminal only keeps the latest motion report and we send it
+        //   once per frame. Button presses and releases are sent right away.
+        if (!_mirror)
+        {
+            _terminal->EnableMouseMotionCoalescing(true);
+        }
+        _flushMouseMotion = std::make_shared<ThrottledFuncTrailing<>>(
+            _dispatcher,
+            MouseMotionInterval,
+            [weakThis = get_weak()]() {
+                if (auto core{ weakThis.get() }; !core->_IsClosing())
+                {
+                    auto lock = core->_terminal->LockForWriting();
+                    core->_terminal->FlushMouseMotion();
+                }
+            });
+
+        _updateScrollbackOverview = std::make_shared<ThrottledFuncTrailing<>>(
+            _dispatcher,
+            ScrollbackOverviewInterval,
+            [weakThis = get_weak()]() {
+                if (auto core{ weakThis.get() }; !core->_IsClosing())
+                {
+                    core->_ScrollbackOverviewChangedHandlers(*core, nullptr);
+                }
+            });
+
+        // * _publishTabStatus: Scripts can set the title or the progress
+        //   hundreds of times per second, and every event makes the tab hop
+        //   to the UI thread and update its XAML. We only remember what
+        //   changed and raise each event once per frame, with the latest state.
+        _publishTabStatus = std::make_shared<ThrottledFuncTrailing<>>(
+            _dispatcher,
+            TabStatusInterval,
+            [weakThis = get_weak()]() {
                 if (auto core{ weakThis.get() }; !core->_IsClosing())
                 {
-                    core->_ScrollPositionChangedHandlers(*core, update);
+                    core->_raiseTabStatus();
                 }
             });
 
@@ -222,6 +430,9 @@ namespace winrt::Microsoft::Terminal::Control::implementation
                 return false;
             }
 
+            _traceInitializePhase("Renderer", true);
+            auto stopRendererPhase = wil::scope_exit([]() noexcept { _traceInitializePhase("Renderer", false); });
+
             // Set up the DX Engine
             auto dxEngine = std::make_unique<::Microsoft::Console::Render::DxEngine>();
             _renderer->AddRenderEngine(dxEngine.get());
@@ -247,13 +458,24 @@ namespace winrt::Microsoft::Terminal::Control::implementation
             const auto vp = _renderEngine->GetViewportInCharacters(viewInPixels);
             const auto width = vp.Width();
             const auto height = vp.Height();
-            _connection.Resize(height, width);
+            if (_mirror)
+            {
+                // The mirrored terminal already exists and keeps its size.
+                // We only need to know how many of its rows we can show.
+                _mirror->SetViewHeight(height);
+                _mirror->SetChangedCallback([this]() { _mirrorChanged(); });
+                _terminal->AddMirror(*_mirror);
+            }
+            else
+            {
+                _connection.Resize(height, width);
 
-            // Override the default width and height to match the size of the swapChainPanel
-            _settings.InitialCols(width);
-            _settings.InitialRows(height);
+                // Override the default width and height to match the size of the swapChainPanel
+                _settings.InitialCols(width);
+                _settings.InitialRows(height);
 
-            _terminal->CreateFromSettings(_settings, *_renderer);
+                _terminal->CreateFromSettings(_settings, *_renderer);
+            }
 
             // IMPORTANT! Set this callback up sooner than later. If we do it
             // after Enable, then it'll be possible to paint the frame once
@@ -265,6 +487,9 @@ namespace winrt::Microsoft::Terminal::Control::implementation
             // We do this after we initially set the swapchain so as to avoid unnecessary callbacks (and locking problems)
             _renderEngine->SetCallback(std::bind(&ControlCore::_renderEngineSwapChainChanged, this));
 
+            // Closes the input latency activities, see _traceInputLatencyStart.
+            _renderEngine->SetPresentCallback(std::bind(&ControlCore::_renderEnginePresented, this));
+
             _renderEngine->SetRetroTerminalEffect(_settings.RetroTerminalEffect());
             _renderEngine->SetPixelShaderPath(_settings.PixelShaderPath());
             _renderEngine->SetForceFullRepaintRendering(_settings.ForceFullRepaintRendering());
@@ -280,13 +505,30 @@ namespace winrt::Microsoft::Terminal::Control::implementation
             }
 
             THROW_IF_FAILED(_renderEngine->Enable());
+            stopRendererPhase.reset();
+
+            // Get a device ready in the background for the next tab or pane that's opened.
+            if (!_settings.SoftwareRendering())
+            {
+                ::Microsoft::Console::Render::DxEngine::s_PrewarmDevice();
+            }
 
             _initializedTerminal = true;
         } // scope for TerminalLock
 
+        // A mirror's scroll bar has to start out at the mirrored terminal's size.
+        if (_mirror)
+        {
+            auto terminalLock = _terminal->LockForWriting();
+            _mirrorChanged();
+            return true;
+        }
+
         // Start the connection outside of lock, because it could
         // start writing output immediately.
+        _traceInitializePhase("ConnectionStart", true);
         _connection.Start();
+        _traceInitializePhase("ConnectionStart", false);
 
         return true;
     }
@@ -316,13 +558,81 @@ namespace winrt::Microsoft::Terminal::Control::implementation
     // - <none>
     void ControlCore::_sendInputToConnection(std::wstring_view wstr)
     {
-        if (_isReadOnly)
+        if (_isReadOnly || _mirror)
         {
             _raiseReadOnlyWarning();
         }
         else
         {
             _connection.WriteInput(wstr);
+
+            if (_userInputThreadId.load(std::memory_order_relaxed) == GetCurrentThreadId())
+            {
+                _broadcastInput(wstr);
+            }
+        }
+    }
+
+    // Method Description:
+    // - Writes the input that the user sent to our connection to the
+    //   connections we broadcast to as well. The input was encoded for our
+    //   terminal (its keyboard modes in particular) only once, and all the
+    //   other connections get the same bytes. They're written in the
+    //   background, so that the UI thread doesn't wait for dozens of pipes.
+    // Arguments:
+    // - wstr: the encoded input
+    // Return Value:
+    // - <none>
+    void ControlCore::_broadcastInput(std::wstring_view wstr)
+    {
+        {
+            const std::lock_guard guard{ _broadcastMutex };
+            if (_broadcastConnections.empty())
+            {
+                return;
+            }
+
+            _pendingBroadcastInput.append(wstr);
+            // If the writer is still busy, it'll pick this up along with the
+            // rest of the input that piled up in the meantime.
+            if (std::exchange(_writingBroadcastInput, true))
+            {
+                return;
+            }
+        }
+
+        _writeBroadcastInput();
+    }
+
+    winrt::fire_and_forget ControlCore::_writeBroadcastInput()
+    {
+        auto strongThis{ get_strong() };
+        co_await winrt::resume_background();
+
+        while (true)
+        {
+            winrt::hstring input;
+            std::vector<TerminalConnection::ITerminalConnection> connections;
+            {
+                const std::lock_guard guard{ _broadcastMutex };
+                if (_pendingBroadcastInput.empty())
+                {
+                    _writingBroadcastInput = false;
+                    co_return;
+                }
+                input = winrt::hstring{ _pendingBroadcastInput };
+                _pendingBroadcastInput.clear();
+                connections = _broadcastConnections;
+            }
+
+            for (const auto& connection : connections)
+            {
+                try
+                {
+                    connection.WriteInput(input);
+                }
+                CATCH_LOG();
+            }
         }
     }
 
@@ -334,6 +644,9 @@ namespace winrt::Microsoft::Terminal::Control::implementation
     // - <none>
     void ControlCore::SendInput(const winrt::hstring& wstr)
     {
+        _userInputThreadId.store(GetCurrentThreadId(), std::memory_order_relaxed);
+        auto endUserInput = wil::scope_exit([&]() noexcept { _userInputThreadId.store(0, std::memory_order_relaxed); });
+
         _sendInputToConnection(wstr);
     }
 
@@ -341,6 +654,17 @@ namespace winrt::Microsoft::Terminal::Control::implementation
                                     const WORD scanCode,
                                     const ::Microsoft::Terminal::Core::ControlKeyStates modifiers)
     {
+        // A mirror swallows the characters, TrySendKeyEvent already warned about them.
+        if (_mirror)
+        {
+            return true;
+        }
+
+        _traceInputLatencyStart();
+
+        _userInputThreadId.store(GetCurrentThreadId(), std::memory_order_relaxed);
+        auto endUserInput = wil::scope_exit([&]() noexcept { _userInputThreadId.store(0, std::memory_order_relaxed); });
+
         return _terminal->SendCharEvent(ch, scanCode, modifiers);
     }
 
@@ -359,6 +683,16 @@ namespace winrt::Microsoft::Terminal::Control::implementation
                                       const ControlKeyStates modifiers,
                                       const bool keyDown)
     {
+        // A mirror doesn't send any input, which would go to the mirrored connection.
+        if (_mirror)
+        {
+            if (keyDown && !KeyEvent::IsModifierKey(vkey))
+            {
+                _raiseReadOnlyWarning();
+            }
+            return true;
+        }
+
         // When there is a selection active, escape should clear it and NOT flow through
         // to the terminal. With any other keypress, it should clear the selection AND
         // flow through to the terminal.
@@ -387,6 +721,14 @@ namespace winrt::Microsoft::Terminal::Control::implementation
             }
         }
 
+        if (vkey && keyDown)
+        {
+            _traceInputLatencyStart();
+        }
+
+        _userInputThreadId.store(GetCurrentThreadId(), std::memory_order_relaxed);
+        auto endUserInput = wil::scope_exit([&]() noexcept { _userInputThreadId.store(0, std::memory_order_relaxed); });
+
         // If the terminal translated the key, mark the event as handled.
         // This will prevent the system from trying to get the character out
         // of it and sending us a CharacterReceived event.
@@ -403,16 +745,31 @@ namespace winrt::Microsoft::Terminal::Control::implementation
                                      const short wheelDelta,
                                      const TerminalInput::MouseButtonState state)
     {
-        return _terminal->SendMouseEvent(viewportPos, uiButton, states, wheelDelta, state);
+        if (_mirror)
+        {
+            return false;
+        }
+
+        const auto handled = _terminal->SendMouseEvent(viewportPos, uiButton, states, wheelDelta, state);
+        // The terminal might have held back a motion report, see _flushMouseMotion.
+        _flushMouseMotion->Run();
+        return handled;
     }
 
     void ControlCore::UserScrollViewport(const int viewTop)
     {
-        // Clear the regex pattern tree so the renderer does not try to render them while scrolling
-        _terminal->ClearPatternTree();
+        if (_mirror)
+        {
+            auto lock = _terminal->LockForWriting();
+            _mirror->UserScrollViewport(viewTop);
+            _mirrorChanged();
+            return;
+        }
 
         // This is a scroll event that wasn't initiated by the terminal
         //      itself - it was initiated by the mouse wheel, or the scrollbar.
+        // The terminal moves the regex patterns along with the viewport, so
+        // they don't need to be invalidated on every step of the scroll.
         _terminal->UserScrollViewport(viewTop);
 
         _updatePatternLocations->Run();
@@ -485,14 +842,101 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         }
     }
 
+    // Method Description:
+    // - Collects the renderer's and the terminal's performance counters. They
+    //   are read without taking the terminal lock, because the overlay that
+    //   displays them shouldn't add to the lock contention it's measuring.
+    // Return Value:
+    // - the current counter values
+    Control::PerformanceCounters ControlCore::GetPerformanceCounters() const
+    {
+        Control::PerformanceCounters counters{};
+        if (_renderer)
+        {
+            const auto frame = _renderer->GetFrameCounters();
+            counters.Frames = frame.frames;
+            counters.PaintMicroseconds = frame.paintMicroseconds;
+            counters.DirtyCells = frame.dirtyCells;
+        }
+        const auto terminal = _terminal->GetPerformanceCounters();
+        counters.ParsedChars = terminal.parsedChars;
+        counters.ParseMicroseconds = terminal.parseMicroseconds;
+        counters.LockWaitMicroseconds = terminal.lockWaitMicroseconds;
+        return counters;
+    }
+
+    // Method Description:
+    // - Adds up how much memory the buffer, the pattern tree and the render
+    //   engine's caches hold on to, and writes the result as a "MemoryUsage"
+    //   event too, so that traces of many tabs can be summed up. Unlike the
+    //   performance counters, this has to take the terminal lock, as it walks
+    //   the rows of the buffer and the caches that painting modifies.
+    // Return Value:
+    // - the number of bytes, by subsystem
+    Control::MemoryUsage ControlCore::GetMemoryUsage() const
+    {
+        Control::MemoryUsage usage{};
+        {
+            auto terminalLock = _terminal->LockForReading();
+
+            const auto buffer = _terminal->GetTextBuffer().GetMemoryUsage();
+            usage.BufferRows = buffer.rows;
+            usage.BufferText = buffer.text;
+            usage.BufferAttributes = buffer.attributes;
+            usage.BufferUnicodeStorage = buffer.unicodeStorage;
+            usage.BufferHyperlinks = buffer.hyperlinks;
+            usage.PatternTree = _terminal->GetPatternTreeMemoryUsage();
+
+            if (_renderEngine)
+            {
+                const auto engine = _renderEngine->GetMemoryUsage();
+                usage.ShapedTextCache = engine.shapedTextCache;
+                usage.FontFallbackCache = engine.fontFallbackCache;
+            }
+        }
+
+#pragma warning(suppress : 26477 26485 26494 26482 26446 26447) // We don't control TraceLoggingWrite
+        TraceLoggingWrite(g_hTerminalControlProvider,
+                          "MemoryUsage",
+                          TraceLoggingDescription("The memory held by a control, by subsystem"),
+                          TraceLoggingUInt64(usage.BufferRows, "BufferRows"),
+                          TraceLoggingUInt64(usage.BufferText, "BufferText"),
+                          TraceLoggingUInt64(usage.BufferAttributes, "BufferAttributes"),
+                          TraceLoggingUInt64(usage.BufferUnicodeStorage, "BufferUnicodeStorage"),
+                          TraceLoggingUInt64(usage.BufferHyperlinks, "BufferHyperlinks"),
+                          TraceLoggingUInt64(usage.PatternTree, "PatternTree"),
+                          TraceLoggingUInt64(usage.ShapedTextCache, "ShapedTextCache"),
+                          TraceLoggingUInt64(usage.FontFallbackCache, "FontFallbackCache"),
+                          TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+                          TraceLoggingKeyword(TIL_KEYWORD_TRACE));
+
+        return usage;
+    }
+
     // Method Description:
     // - Tell TerminalCore to update its knowledge about the locations of visible regex patterns
     // - We should call this (through the throttled function) when something causes the visible
     //   region to change, such as when new text enters the buffer or the viewport is scrolled
     void ControlCore::UpdatePatternLocations()
     {
-        auto lock = _terminal->LockForWriting();
-        _terminal->UpdatePatternsUnderLock();
+        // The patterns are those of the mirrored terminal's viewport.
+        if (_mirror)
+        {
+            return;
+        }
+
+        {
+            auto lock = _terminal->LockForWriting();
+            _terminal->UpdatePatternsUnderLock();
+            std::atomic_store(&_hyperlinkSnapshot, _terminal->GetHyperlinkSnapshot());
+            _hyperlinkSnapshotStale.store(false, std::memory_order_relaxed);
+        }
+
+        // What's under the mouse may have changed along with the snapshot.
+        if (_lastHoveredCell.has_value())
+        {
+            _updateHoveredCell(_lastHoveredCell, true);
+        }
     }
 
     // Method description:
@@ -508,15 +952,16 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         _updateHoveredCell(std::nullopt);
     }
 
-    void ControlCore::_updateHoveredCell(const std::optional<til::point> terminalPosition)
+    void ControlCore::_updateHoveredCell(const std::optional<til::point> terminalPosition, const bool force)
     {
-        if (terminalPosition == _lastHoveredCell)
+        if (!force && terminalPosition == _lastHoveredCell)
         {
             return;
         }
 
-        // GH#9618 - lock while we're reading from the terminal, and if we need
-        // to update something, then lock again to write the terminal.
+        // GH#9618 - we hit-test against the published snapshot, which doesn't
+        // need the lock. Only if we need to update something, we lock to write
+        // the terminal.
 
         _lastHoveredCell = terminalPosition;
         uint16_t newId{ 0u };
@@ -524,9 +969,17 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         decltype(_terminal->GetHyperlinkIntervalFromPosition(til::point{})) newInterval{ std::nullopt };
         if (terminalPosition.has_value())
         {
-            auto lock = _terminal->LockForReading(); // Lock for the duration of our reads.
-            newId = _terminal->GetHyperlinkIdAtPosition(*terminalPosition);
-            newInterval = _terminal->GetHyperlinkIntervalFromPosition(*terminalPosition);
+            const auto snapshot = std::atomic_load(&_hyperlinkSnapshot);
+            if (!snapshot || _hyperlinkSnapshotStale.load(std::memory_order_relaxed))
+            {
+                // The output scrolled the viewport since the snapshot was
+                // taken. Instead of waiting for the lock, we'll hit-test
+                // again once the next snapshot has been published.
+                _updatePatternLocations->Run();
+                return;
+            }
+            newId = snapshot->GetHyperlinkIdAtPosition(*terminalPosition);
+            newInterval = snapshot->GetHyperlinkIntervalFromPosition(*terminalPosition);
         }
 
         // If the hyperlink ID changed or the interval changed, trigger a redraw all
@@ -554,6 +1007,11 @@ namespace winrt::Microsoft::Terminal::Control::implementation
 
     winrt::hstring ControlCore::GetHyperlink(const til::point pos) const
     {
+        if (_mirror)
+        {
+            return {};
+        }
+
         // Lock for the duration of our reads.
         auto lock = _terminal->LockForReading();
         return winrt::hstring{ _terminal->GetHyperlinkAtPosition(pos) };
@@ -581,7 +1039,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
     {
         auto lock = _terminal->LockForWriting();
 
-        _settings = settings;
+        const auto previousSettings = std::exchange(_settings, settings);
 
         // Initialize our font information.
         const auto fontFace = _settings.FontFace();
@@ -593,11 +1051,27 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         //      The family is only used to determine if the font is truetype or
         //      not, but DX doesn't use that info at all.
         //      The Codepage is additionally not actually used by the DX engine at all.
-        _actualFont = { fontFace, 0, fontWeight.Weight, { 0, fontHeight }, CP_UTF8, false };
-        _desiredFont = { _actualFont };
+        const FontInfo newFont{ fontFace, 0, fontWeight.Weight, { 0, fontHeight }, CP_UTF8, false };
+        const FontInfoDesired newDesiredFont{ newFont };
+
+        // Recreating the font is the most expensive part of applying new settings,
+        // and whenever settings.json is saved, every control gets new settings.
+        // Most of the time, the font didn't change though, so we keep the one we have.
+        const auto fontChanged = !_initializedTerminal ||
+                                 !(newDesiredFont == _desiredFont) ||
+                                 !_FontMapsEqual(previousSettings.FontFeatures(), _settings.FontFeatures()) ||
+                                 !_FontMapsEqual(previousSettings.FontAxes(), _settings.FontAxes());
+        if (fontChanged)
+        {
+            _actualFont = newFont;
+            _desiredFont = newDesiredFont;
+        }
 
         // Update the terminal core with its new Core settings
-        _terminal->UpdateSettings(_settings);
+        if (!_mirror)
+        {
+            _terminal->UpdateSettings(_settings);
+        }
 
         if (!_initializedTerminal)
         {
@@ -611,6 +1085,11 @@ namespace winrt::Microsoft::Terminal::Control::implementation
 
         _updateAntiAliasingMode(_renderEngine.get());
 
+        if (!fontChanged)
+        {
+            return;
+        }
+
         // Refresh our font with the renderer
         const auto actualFontOldSize = _actualFont.GetSize();
         _updateFont();
@@ -629,7 +1108,10 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         auto lock = _terminal->LockForWriting();
 
         // Update the terminal core with its new Core settings
-        _terminal->UpdateAppearance(newAppearance);
+        if (!_mirror)
+        {
+            _terminal->UpdateAppearance(newAppearance);
+        }
 
         // Update DxEngine settings under the lock
         if (_renderEngine)
@@ -676,7 +1158,14 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         const int newDpi = static_cast<int>(static_cast<double>(USER_DEFAULT_SCREEN_DPI) *
                                             _compositionScale);
 
-        _terminal->SetFontInfo(_actualFont);
+        if (_mirror)
+        {
+            _mirror->SetFontInfo(_actualFont);
+        }
+        else
+        {
+            _terminal->SetFontInfo(_actualFont);
+        }
 
         if (_renderEngine)
         {
@@ -818,6 +1307,17 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         const auto viewInPixels = Viewport::FromDimensions({ 0, 0 },
                                                            { static_cast<short>(size.cx), static_cast<short>(size.cy) });
         const auto vp = _renderEngine->GetViewportInCharacters(viewInPixels);
+
+        // A mirror can't resize the mirrored terminal. It shows as many of
+        // its rows as fit and clips its columns.
+        if (_mirror)
+        {
+            THROW_IF_FAILED(_renderEngine->SetWindowSize(size));
+            _mirror->SetViewHeight(vp.Height());
+            _mirrorChanged();
+            return;
+        }
+
         const auto currentVP = _terminal->GetViewport();
 
         // Don't actually resize if viewport dimensions didn't change
@@ -849,11 +1349,30 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         _panelWidth = width;
         _panelHeight = height;
 
+        // The buffer and the connection follow the new size in a bit, see
+        // _resizeToPanel.
+        _resizeToPanel->Run();
+    }
+
+    // Method Description:
+    // - Resizes the buffer, the renderer and the connection to the size that
+    //   the panel had at the last SizeChanged.
+    // Arguments:
+    // - <none>
+    // Return Value:
+    // - <none>
+    void ControlCore::_resizeToPanelSize()
+    {
+        if (!_renderEngine)
+        {
+            return;
+        }
+
         auto lock = _terminal->LockForWriting();
         const auto currentEngineScale = _renderEngine->GetScaling();
 
-        auto scaledWidth = width * currentEngineScale;
-        auto scaledHeight = height * currentEngineScale;
+        auto scaledWidth = _panelWidth * currentEngineScale;
+        auto scaledHeight = _panelHeight * currentEngineScale;
         _doResizeUnderLock(scaledWidth, scaledHeight);
     }
 
@@ -895,6 +1414,11 @@ namespace winrt::Microsoft::Terminal::Control::implementation
 
     void ControlCore::SetSelectionAnchor(til::point const& position)
     {
+        if (_mirror)
+        {
+            return;
+        }
+
         auto lock = _terminal->LockForWriting();
         _terminal->SetSelectionAnchor(position);
     }
@@ -905,7 +1429,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
     // - position: the point in terminal coordinates (in cells, not pixels)
     void ControlCore::SetEndSelectionPoint(til::point const& position)
     {
-        if (!_terminal->IsSelectionActive())
+        if (!HasSelection())
         {
             return;
         }
@@ -946,40 +1470,49 @@ namespace winrt::Microsoft::Terminal::Control::implementation
                                                const Windows::Foundation::IReference<CopyFormat>& formats)
     {
         // no selection --> nothing to copy
-        if (!_terminal->IsSelectionActive())
+        if (!HasSelection())
         {
             return false;
         }
 
         // extract text from buffer
         // RetrieveSelectedTextFromBuffer will lock while it's reading
-        const auto bufferData = _terminal->RetrieveSelectedTextFromBuffer(singleLine);
+        const auto bufferData = std::make_shared<const TextBuffer::TextAndColor>(_terminal->RetrieveSelectedTextFromBuffer(singleLine));
 
         // convert text: vector<string> --> string
         std::wstring textData;
-        for (const auto& text : bufferData.text)
+        for (const auto& text : bufferData->text)
         {
             textData += text;
         }
 
+        // The HTML and RTF are only generated if whoever pastes asks for them.
+        // They work off of a copy of the selection, so they don't need the
+        // buffer (or its lock) anymore, and can be generated on any thread.
+        const auto fontHeight = _actualFont.GetUnscaledSize().Y;
+        const std::wstring fontFaceName{ _actualFont.GetFaceName() };
+        const til::color background{ _settings.DefaultBackground() };
+
         // convert text to HTML format
         // GH#5347 - Don't provide a title for the generated HTML, as many
         // web applications will paste the title first, followed by the HTML
         // content, which is unexpected.
-        const auto htmlData = formats == nullptr || WI_IsFlagSet(formats.Value(), CopyFormat::HTML) ?
-                                  TextBuffer::GenHTML(bufferData,
-                                                      _actualFont.GetUnscaledSize().Y,
-                                                      _actualFont.GetFaceName(),
-                                                      til::color{ _settings.DefaultBackground() }) :
-                                  "";
+        CopyToClipboardEventArgs::FormatGenerator generateHtml;
+        if (formats == nullptr || WI_IsFlagSet(formats.Value(), CopyFormat::HTML))
+        {
+            generateHtml = [=]() {
+                return winrt::to_hstring(TextBuffer::GenHTML(*bufferData, fontHeight, fontFaceName, background));
+            };
+        }
 
         // convert to RTF format
-        const auto rtfData = formats == nullptr || WI_IsFlagSet(formats.Value(), CopyFormat::RTF) ?
-                                 TextBuffer::GenRTF(bufferData,
-                                                    _actualFont.GetUnscaledSize().Y,
-                                                    _actualFont.GetFaceName(),
-                                                    til::color{ _settings.DefaultBackground() }) :
-                                 "";
+        CopyToClipboardEventArgs::FormatGenerator generateRtf;
+        if (formats == nullptr || WI_IsFlagSet(formats.Value(), CopyFormat::RTF))
+        {
+            generateRtf = [=]() {
+                return winrt::to_hstring(TextBuffer::GenRTF(*bufferData, fontHeight, fontFaceName, background));
+            };
+        }
 
         if (!_settings.CopyOnSelect())
         {
@@ -990,8 +1523,8 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         // send data up for clipboard
         _CopyToClipboardHandlers(*this,
                                  winrt::make<CopyToClipboardEventArgs>(winrt::hstring{ textData },
-                                                                       winrt::to_hstring(htmlData),
-                                                                       winrt::to_hstring(rtfData),
+                                                                       std::move(generateHtml),
+                                                                       std::move(generateRtf),
                                                                        formats));
         return true;
     }
@@ -1001,6 +1534,15 @@ namespace winrt::Microsoft::Terminal::Control::implementation
     //   before sending it over the terminal's connection.
     void ControlCore::PasteText(const winrt::hstring& hstr)
     {
+        if (_mirror)
+        {
+            _raiseReadOnlyWarning();
+            return;
+        }
+
+        _userInputThreadId.store(GetCurrentThreadId(), std::memory_order_relaxed);
+        auto endUserInput = wil::scope_exit([&]() noexcept { _userInputThreadId.store(0, std::memory_order_relaxed); });
+
         _terminal->WritePastedText(hstr);
         _terminal->ClearSelection();
         _terminal->TrySnapOnInput();
@@ -1073,7 +1615,8 @@ namespace winrt::Microsoft::Terminal::Control::implementation
     // - The taskbar state of this control
     const size_t ControlCore::TaskbarState() const noexcept
     {
-        return _terminal->GetTaskbarState();
+        // 1 is the "normal" state, which shows the export's progress value
+        return _exporting ? 1 : _terminal->GetTaskbarState();
     }
 
     // Method Description:
@@ -1082,12 +1625,12 @@ namespace winrt::Microsoft::Terminal::Control::implementation
     // - The taskbar progress of this control
     const size_t ControlCore::TaskbarProgress() const noexcept
     {
-        return _terminal->GetTaskbarProgress();
+        return _exporting ? _exportProgress.load() : _terminal->GetTaskbarProgress();
     }
 
     int ControlCore::ScrollOffset()
     {
-        return _terminal->GetScrollOffset();
+        return _mirror ? _mirror->ViewStartIndex() : _terminal->GetScrollOffset();
     }
 
     // Function Description:
@@ -1097,7 +1640,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
     // - The height of the terminal in lines of text
     int ControlCore::ViewHeight() const
     {
-        return _terminal->GetViewport().Height();
+        return _mirror ? _mirror->ViewHeight() : _terminal->GetViewport().Height();
     }
 
     // Function Description:
@@ -1129,10 +1672,11 @@ namespace winrt::Microsoft::Terminal::Control::implementation
     // - <none>
     void ControlCore::_terminalTitleChanged(std::wstring_view wstr)
     {
-        // Since this can only ever be triggered by output from the connection,
-        // then the Terminal already has the write lock when calling this
-        // callback.
-        _TitleChangedHandlers(*this, winrt::make<TitleChangedEventArgs>(winrt::hstring{ wstr }));
+        {
+            const std::lock_guard guard{ _pendingTitleMutex };
+            _pendingTitle = wstr;
+        }
+        _queueTabStatus(TabStatus::Title);
     }
 
     // Method Description:
@@ -1146,8 +1690,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
     // - <none>
     void ControlCore::_terminalTabColorChanged(const std::optional<til::color> /*color*/)
     {
-        // Raise a TabColorChanged event
-        _TabColorChangedHandlers(*this, nullptr);
+        _queueTabStatus(TabStatus::TabColor);
     }
 
     // Method Description:
@@ -1185,21 +1728,65 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         // TODO GH#9617: refine locking around pattern tree
         _terminal->ClearPatternTree();
 
-        // Start the throttled update of our scrollbar.
-        auto update{ winrt::make<ScrollPositionChangedArgs>(viewTop,
-                                                            viewHeight,
-                                                            bufferSize) };
+        // This is called for nearly every line of output, so all we do under
+        // the lock is to store the new position and to mark the snapshot of
+        // the hyperlinks as stale. The throttled update of our
+        // scrollbar then publishes whatever the latest one is.
+        _scrollViewTop.store(viewTop, std::memory_order_relaxed);
+        _scrollViewHeight.store(viewHeight, std::memory_order_relaxed);
+        _scrollBufferSize.store(bufferSize, std::memory_order_relaxed);
+        _hyperlinkSnapshotStale.store(true, std::memory_order_relaxed);
         if (!_inUnitTests)
         {
-            _updateScrollBar->Run(update);
+            _updateScrollBar->Run();
         }
         else
         {
-            _ScrollPositionChangedHandlers(*this, update);
+            _publishScrollPosition();
         }
 
         // Additionally, start the throttled update of where our links are.
-        _updatePatternLocations->Run();
+        // In the throughput mode, this waits until we leave it again.
+        if (!_throughputMode.load(std::memory_order_relaxed))
+        {
+            _updatePatternLocations->Run();
+        }
+        _updateScrollbackOverview->Run();
+    }
+
+    // Method Description:
+    // - Called whenever the mirrored terminal's buffer changed or the mirror
+    //   was scrolled or resized. Its renderer doesn't know what changed, so
+    //   it repaints the whole view, at most once per frame.
+    // - The write lock should be held when calling this method.
+    // Arguments:
+    // - <none>
+    // Return Value:
+    // - <none>
+    void ControlCore::_mirrorChanged()
+    {
+        _scrollViewTop.store(_mirror->ViewStartIndex(), std::memory_order_relaxed);
+        _scrollViewHeight.store(_mirror->ViewHeight(), std::memory_order_relaxed);
+        _scrollBufferSize.store(_terminal->GetBufferHeight(), std::memory_order_relaxed);
+        _renderer->TriggerRedrawAll();
+        _updateScrollBar->Run();
+        _updateScrollbackOverview->Run();
+    }
+
+    // Method Description:
+    // - Raises ScrollPositionChanged with the latest scroll position stored by
+    //   _terminalScrollPositionChanged. This doesn't need the terminal lock,
+    //   so the UI thread doesn't contend with the output for it.
+    // Arguments:
+    // - <none>
+    // Return Value:
+    // - <none>
+    void ControlCore::_publishScrollPosition()
+    {
+        auto update{ winrt::make<ScrollPositionChangedArgs>(_scrollViewTop.load(std::memory_order_relaxed),
+                                                            _scrollViewHeight.load(std::memory_order_relaxed),
+                                                            _scrollBufferSize.load(std::memory_order_relaxed)) };
+        _ScrollPositionChangedHandlers(*this, update);
     }
 
     void ControlCore::_terminalCursorPositionChanged()
@@ -1211,12 +1798,56 @@ namespace winrt::Microsoft::Terminal::Control::implementation
 
     void ControlCore::_terminalTaskbarProgressChanged()
     {
-        _TaskbarProgressChangedHandlers(*this, nullptr);
+        _queueTabStatus(TabStatus::TaskbarProgress);
+    }
+
+    // Method Description:
+    // - Remembers that a tab status changed and starts the throttled func
+    //   that raises its event. Can be called from any thread.
+    // Arguments:
+    // - status: the status that changed
+    // Return Value:
+    // - <none>
+    void ControlCore::_queueTabStatus(const TabStatus status)
+    {
+        _pendingTabStatus.fetch_or(static_cast<uint8_t>(status), std::memory_order_relaxed);
+        _publishTabStatus->Run();
+    }
+
+    // Method Description:
+    // - Raises the events of the tab statuses that changed since the last
+    //   call, once each. Only called on the UI thread, by _publishTabStatus.
+    //   Like _publishScrollPosition, this doesn't need the terminal lock.
+    // Arguments:
+    // - <none>
+    // Return Value:
+    // - <none>
+    void ControlCore::_raiseTabStatus()
+    {
+        const auto pending = _pendingTabStatus.exchange(0, std::memory_order_relaxed);
+        if (WI_IsFlagSet(pending, static_cast<uint8_t>(TabStatus::Title)))
+        {
+            winrt::hstring title;
+            {
+                const std::lock_guard guard{ _pendingTitleMutex };
+                title = winrt::hstring{ _pendingTitle };
+            }
+            _TitleChangedHandlers(*this, winrt::make<TitleChangedEventArgs>(title));
+        }
+        if (WI_IsFlagSet(pending, static_cast<uint8_t>(TabStatus::TabColor)))
+        {
+            _TabColorChangedHandlers(*this, nullptr);
+        }
+        if (WI_IsFlagSet(pending, static_cast<uint8_t>(TabStatus::TaskbarProgress)))
+        {
+            _TaskbarProgressChangedHandlers(*this, nullptr);
+        }
     }
 
     bool ControlCore::HasSelection() const
     {
-        return _terminal->IsSelectionActive();
+        // The selection belongs to the mirrored terminal.
+        return !_mirror && _terminal->IsSelectionActive();
     }
 
     bool ControlCore::CopyOnSelect() const
@@ -1250,13 +1881,15 @@ namespace winrt::Microsoft::Terminal::Control::implementation
     // - text: the text to search
     // - goForward: boolean that represents if the current search direction is forward
     // - caseSensitive: boolean that represents if the current search is case sensitive
+    // - regex: boolean that represents if the text is a regular expression
     // Return Value:
     // - <none>
     void ControlCore::Search(const winrt::hstring& text,
                              const bool goForward,
-                             const bool caseSensitive)
+                             const bool caseSensitive,
+                             const bool regex)
     {
-        if (text.size() == 0)
+        if (text.size() == 0 || _mirror)
         {
             return;
         }
@@ -1265,6 +1898,41 @@ namespace winrt::Microsoft::Terminal::Control::implementation
                                                 Search::Direction::Forward :
                                                 Search::Direction::Backward;
 
+        if (regex)
+        {
+            if (!_searchRegex || _searchRegexPattern != text || _searchRegexCaseSensitive != caseSensitive)
+            {
+                auto flags = std::regex_constants::ECMAScript | std::regex_constants::optimize;
+                if (!caseSensitive)
+                {
+                    flags |= std::regex_constants::icase;
+                }
+                try
+                {
+                    _searchRegex.emplace(text.c_str(), flags);
+                }
+                catch (const std::regex_error&)
+                {
+                    // An incomplete or invalid expression simply has no matches.
+                    _searchRegex.reset();
+                    return;
+                }
+                _searchRegexPattern = text;
+                _searchRegexCaseSensitive = caseSensitive;
+            }
+
+            auto lock = _terminal->LockForWriting();
+            ::Search search(*GetUiaData(), *_searchRegex, direction);
+            if (search.FindNext())
+            {
+                _terminal->SetBlockSelection(false);
+                search.Select();
+                _renderer->TriggerSelection();
+                _updateScrollbackOverview->Run();
+            }
+            return;
+        }
+
         const Search::Sensitivity sensitivity = caseSensitive ?
                                                     Search::Sensitivity::CaseSensitive :
                                                     Search::Sensitivity::CaseInsensitive;
@@ -1276,9 +1944,69 @@ namespace winrt::Microsoft::Terminal::Control::implementation
             _terminal->SetBlockSelection(false);
             search.Select();
             _renderer->TriggerSelection();
+            _updateScrollbackOverview->Run();
+        }
+    }
+
+    // Method Description:
+    // - Scrolls to the previous or next prompt, if the shell marks them with
+    //   OSC 133 (FinalTerm's shell integration).
+    // Arguments:
+    // - previous: true to go to the prompt above the top of the viewport,
+    //   false to go to the one below it
+    void ControlCore::ScrollToCommand(const bool previous)
+    {
+        auto lock = _terminal->LockForWriting();
+        if (_mirror)
+        {
+            if (_mirror->ScrollToCommand(previous))
+            {
+                _mirrorChanged();
+            }
+            return;
+        }
+        _terminal->ScrollToCommand(previous);
+    }
+
+    // Method Description:
+    // - Selects the output of the command at the top of the viewport, if the
+    //   shell marks its commands with OSC 133 (FinalTerm's shell integration).
+    void ControlCore::SelectCommandOutput()
+    {
+        if (_mirror)
+        {
+            return;
+        }
+
+        auto lock = _terminal->LockForWriting();
+        if (_terminal->SelectCommandOutput())
+        {
+            _renderer->TriggerSelection();
+            _updateScrollbackOverview->Run();
         }
     }
 
+    // Method Description:
+    // - Returns the colors of the scrollback minimap, see
+    //   Terminal::GetScrollbackOverview. This only summarizes the rows that
+    //   changed since the last call, so it's cheap to call whenever
+    //   ScrollbackOverviewChanged is raised.
+    // Arguments:
+    // - buckets: the number of colors to return, from the oldest rows to the newest.
+    // Return Value:
+    // - one color per bucket, or none if the terminal isn't initialized yet
+    com_array<Core::Color> ControlCore::GetScrollbackOverview(const int32_t buckets)
+    {
+        if (!_initializedTerminal || buckets <= 0)
+        {
+            return {};
+        }
+
+        auto lock = _terminal->LockForWriting();
+        const auto colors = _terminal->GetScrollbackOverview(gsl::narrow_cast<size_t>(buckets), til::color{ _settings.SelectionBackground() });
+        return com_array<Core::Color>{ colors.begin(), colors.end() };
+    }
+
     void ControlCore::SetBackgroundOpacity(const double opacity)
     {
         if (_renderEngine)
@@ -1320,8 +2048,34 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         {
             _closing = true;
 
+            // Stop the render thread right away instead of waiting for the
+            // destructor. This doesn't block on a paint that's underway.
+            if (_renderer)
+            {
+                _renderer->TriggerShutdown();
+            }
+
+            // A mirror leaves the connection to the mirrored core.
+            if (_mirror)
+            {
+                _connectionStateChangedRevoker.revoke();
+                _connection = nullptr;
+
+                auto lock = _terminal->LockForWriting();
+                _terminal->RemoveMirror(*_mirror);
+                return;
+            }
+
             // Stop accepting new output and state changes before we disconnect everything.
-            _connection.TerminalOutput(_connectionOutputEventToken);
+            if (_connectionOutputView)
+            {
+                _connectionOutputView.TerminalOutputView(_connectionOutputEventToken);
+                _connectionOutputView = nullptr;
+            }
+            else
+            {
+                _connection.TerminalOutput(_connectionOutputEventToken);
+            }
             _connectionStateChangedRevoker.revoke();
 
             // GH#1996 - Close the connection asynchronously on a background
@@ -1354,8 +2108,138 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         _SwapChainChangedHandlers(*this, nullptr);
     }
 
+    // Method Description:
+    // - Starts an "InputLatency" activity for a key press, if our provider is
+    //   being traced and no earlier key press is still waiting to be shown.
+    //   Only measuring the oldest one keeps a burst of typing from producing
+    //   overlapping activities, and it's the one the user waits on the longest.
+    // - The activity is continued with an event when the first output after
+    //   the key press was written into the terminal, see _traceInputLatencyOutput,
+    //   and stopped by the next presented frame, see _renderEnginePresented.
+    //   The stop event carries the total latency in microseconds, so it can
+    //   be aggregated without correlating the events first.
+    // Arguments:
+    // - <none>
+    // Return Value:
+    // - <none>
+    void ControlCore::_traceInputLatencyStart()
+    {
+        if (_inputLatencyPending.load(std::memory_order_relaxed) ||
+            !TraceLoggingProviderEnabled(g_hTerminalControlProvider, WINEVENT_LEVEL_VERBOSE, TIL_KEYWORD_TRACE))
+        {
+            return;
+        }
+
+        InputLatencyTrace trace;
+        trace.start = std::chrono::steady_clock::now();
+        LOG_IF_WIN32_ERROR(EventActivityIdControl(EVENT_ACTIVITY_CTRL_CREATE_ID, &trace.activityId));
+
+        {
+            const std::lock_guard guard{ _inputLatencyMutex };
+            if (_inputLatency)
+            {
+                return;
+            }
+            _inputLatency = trace;
+            _inputLatencyPending.store(true, std::memory_order_relaxed);
+        }
+
+#pragma warning(suppress : 26477 26485 26494 26482 26446 26447) // We don't control TraceLoggingWrite
+        TraceLoggingWriteActivity(g_hTerminalControlProvider,
+                                  "InputLatency",
+                                  &trace.activityId,
+                                  nullptr,
+                                  TraceLoggingOpcode(WINEVENT_OPCODE_START),
+                                  TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+                                  TraceLoggingKeyword(TIL_KEYWORD_TRACE));
+    }
+
+    // Method Description:
+    // - Marks the pending input latency activity as answered by the
+    //   connection, once its output was parsed into the terminal.
+    // Arguments:
+    // - <none>
+    // Return Value:
+    // - <none>
+    void ControlCore::_traceInputLatencyOutput()
+    {
+        if (!_inputLatencyPending.load(std::memory_order_relaxed))
+        {
+            return;
+        }
+
+        InputLatencyTrace trace;
+        {
+            const std::lock_guard guard{ _inputLatencyMutex };
+            if (!_inputLatency || _inputLatency->outputReceived)
+            {
+                return;
+            }
+            _inputLatency->outputReceived = true;
+            trace = *_inputLatency;
+            _inputLatencyOutputReceived.store(true, std::memory_order_relaxed);
+        }
+
+        const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - trace.start);
+
+#pragma warning(suppress : 26477 26485 26494 26482 26446 26447) // We don't control TraceLoggingWrite
+        TraceLoggingWriteActivity(g_hTerminalControlProvider,
+                                  "InputLatency_OutputReceived",
+                                  &trace.activityId,
+                                  nullptr,
+                                  TraceLoggingInt64(elapsed.count(), "ElapsedUs"),
+                                  TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+                                  TraceLoggingKeyword(TIL_KEYWORD_TRACE));
+    }
+
+    // Method Description:
+    // - Called by the DxEngine on the render thread after each presented frame.
+    //   Stops the pending input latency activity, if its output was received.
+    // Arguments:
+    // - <none>
+    // Return Value:
+    // - <none>
+    void ControlCore::_renderEnginePresented()
+    {
+        if (!_inputLatencyOutputReceived.load(std::memory_order_relaxed))
+        {
+            return;
+        }
+
+        InputLatencyTrace trace;
+        {
+            const std::lock_guard guard{ _inputLatencyMutex };
+            if (!_inputLatency || !_inputLatency->outputReceived)
+            {
+                return;
+            }
+            trace = *_inputLatency;
+            _inputLatency.reset();
+            _inputLatencyOutputReceived.store(false, std::memory_order_relaxed);
+            _inputLatencyPending.store(false, std::memory_order_relaxed);
+        }
+
+        const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - trace.start);
+
+#pragma warning(suppress : 26477 26485 26494 26482 26446 26447) // We don't control TraceLoggingWrite
+        TraceLoggingWriteActivity(g_hTerminalControlProvider,
+                                  "InputLatency",
+                                  &trace.activityId,
+                                  nullptr,
+                                  TraceLoggingInt64(elapsed.count(), "LatencyUs"),
+                                  TraceLoggingOpcode(WINEVENT_OPCODE_STOP),
+                                  TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+                                  TraceLoggingKeyword(TIL_KEYWORD_TRACE));
+    }
+
     void ControlCore::BlinkAttributeTick()
     {
+        // The blinking and the cursor are the mirrored core's to toggle.
+        if (_mirror)
+        {
+            return;
+        }
+
         auto lock = _terminal->LockForWriting();
 
         auto& renderTarget = *_renderer;
@@ -1365,6 +2249,10 @@ namespace winrt::Microsoft::Terminal::Control::implementation
 
     void ControlCore::BlinkCursor()
     {
+        if (_mirror)
+        {
+            return;
+        }
         if (!_terminal->IsCursorBlinkingAllowed() &&
             _terminal->IsCursorVisible())
         {
@@ -1381,7 +2269,10 @@ namespace winrt::Microsoft::Terminal::Control::implementation
 
     void ControlCore::CursorOn(const bool isCursorOn)
     {
-        _terminal->SetCursorOn(isCursorOn);
+        if (!_mirror)
+        {
+            _terminal->SetCursorOn(isCursorOn);
+        }
     }
 
     void ControlCore::ResumeRendering()
@@ -1389,9 +2280,46 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         _renderer->ResetErrorStateAndResume();
     }
 
+    // Method Description:
+    // - Suspends painting while this control can't be seen, because its tab
+    //   isn't selected or its window is minimized. Output that arrives in the
+    //   meantime only marks the renderer as dirty, and everything is redrawn
+    //   once the control is visible again.
+    // Arguments:
+    // - visible: whether the control can currently be seen.
+    // Return Value:
+    // - <none>
+    void ControlCore::VisibilityChanged(const bool visible)
+    {
+        auto lock = _terminal->LockForWriting();
+        _renderer->SetVisible(visible);
+    }
+
+    // Method Description:
+    // - Prioritizes the threads of the control the user is interacting with.
+    //   While unfocused, the render thread and the output thread of a ConPTY
+    //   connection run with power throttling (EcoQoS) and the renderer paints
+    //   at a reduced frame rate. See Renderer::SetFocused.
+    // Arguments:
+    // - focused: whether the control has the focus.
+    // Return Value:
+    // - <none>
+    void ControlCore::FocusChanged(const bool focused)
+    {
+        {
+            auto lock = _terminal->LockForWriting();
+            _renderer->SetFocused(focused);
+        }
+
+        if (const auto conpty = _connection.try_as<TerminalConnection::ConptyConnection>())
+        {
+            conpty.SetFocused(focused);
+        }
+    }
+
     bool ControlCore::IsVtMouseModeEnabled() const
     {
-        return _terminal != nullptr && _terminal->IsTrackingMouseInput();
+        return _terminal != nullptr && !_mirror && _terminal->IsTrackingMouseInput();
     }
 
     til::point ControlCore::CursorPosition() const
@@ -1418,6 +2346,11 @@ namespace winrt::Microsoft::Terminal::Control::implementation
                                           const bool isOnOriginalPosition,
                                           bool& selectionNeedsToBeCopied)
     {
+        if (_mirror)
+        {
+            return;
+        }
+
         auto lock = _terminal->LockForWriting();
         // handle ALT key
         _terminal->SetBlockSelection(altEnabled);
@@ -1486,17 +2419,148 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         _isReadOnly = !_isReadOnly;
     }
 
+    const TerminalConnection::ITerminalConnection& ControlCore::Connection() const noexcept
+    {
+        return _connection;
+    }
+
+    // Method Description:
+    // - Sets the connections that the input the user sends to our connection
+    //   is written to as well, for instance to type into all the panes of a
+    //   tab at once. Replies to the output's queries aren't broadcast.
+    // Arguments:
+    // - connections: the connections to broadcast to. Ours and duplicates
+    //   are skipped, as the mirrors of a pane share its connection.
+    // Return Value:
+    // - <none>
+    void ControlCore::BroadcastInputTo(std::vector<TerminalConnection::ITerminalConnection> connections)
+    {
+        std::vector<TerminalConnection::ITerminalConnection> unique;
+        unique.reserve(connections.size());
+        for (auto& connection : connections)
+        {
+            if (connection && connection != _connection && std::find(unique.begin(), unique.end(), connection) == unique.end())
+            {
+                unique.emplace_back(std::move(connection));
+            }
+        }
+
+        const std::lock_guard guard{ _broadcastMutex };
+        _broadcastConnections = std::move(unique);
+    }
+
     void ControlCore::_raiseReadOnlyWarning()
     {
         auto noticeArgs = winrt::make<NoticeEventArgs>(NoticeLevel::Info, RS_(L"TermControlReadOnly"));
         _RaiseNoticeHandlers(*this, std::move(noticeArgs));
     }
-    void ControlCore::_connectionOutputHandler(const hstring& hstr)
+    void ControlCore::_connectionOutputHandler(const std::wstring_view output)
+    {
+        // The "ConnectionOutput" region covers parsing what the connection read.
+        // See ConsolePerf.regions.xml.
+#pragma warning(suppress : 26477 26485 26494 26482 26446 26447) // We don't control TraceLoggingWrite
+        TraceLoggingWrite(g_hTerminalControlProvider,
+                          "ConnectionOutput",
+                          TraceLoggingUInt32(gsl::narrow_cast<uint32_t>(output.size()), "Length"),
+                          TraceLoggingOpcode(WINEVENT_OPCODE_START),
+                          TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+                          TraceLoggingKeyword(TIL_KEYWORD_TRACE));
+
+        _terminal->Write(output);
+
+#pragma warning(suppress : 26477 26485 26494 26482 26446 26447) // We don't control TraceLoggingWrite
+        TraceLoggingWrite(g_hTerminalControlProvider,
+                          "ConnectionOutput",
+                          TraceLoggingOpcode(WINEVENT_OPCODE_STOP),
+                          TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+                          TraceLoggingKeyword(TIL_KEYWORD_TRACE));
+
+        _traceInputLatencyOutput();
+        _updateThroughputMode(output.size());
+
+        // Start the throttled update of where our hyperlinks are. In the
+        // throughput mode, this waits until we leave it again.
+        if (!_throughputMode.load(std::memory_order_relaxed))
+        {
+            _updatePatternLocations->Run();
+        }
+    }
+
+    // Method Description:
+    // - Measures the rate of the connection's output and enters or leaves the
+    //   renderer's throughput mode accordingly. During a flood of output, the
+    //   renderer then only paints the latest state of the viewport at a
+    //   reduced frame rate, instead of invalidating what each chunk changed.
+    // - Only called on the connection's output thread.
+    // Arguments:
+    // - length: the number of characters that were just written.
+    // Return Value:
+    // - <none>
+    void ControlCore::_updateThroughputMode(const size_t length)
     {
-        _terminal->Write(hstr);
+        const auto now = std::chrono::steady_clock::now();
+        _lastOutputTime.store(now, std::memory_order_relaxed);
+        _throughputWindowChars += length;
 
-        // Start the throttled update of where our hyperlinks are.
-        _updatePatternLocations->Run();
+        const auto elapsed = now - _throughputWindowStart;
+        if (elapsed < ThroughputModeWindow)
+        {
+            return;
+        }
+
+        const auto elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+        const auto charsPerSecond = _throughputWindowChars * 1'000'000 / gsl::narrow_cast<uint64_t>(elapsedUs);
+        _throughputWindowStart = now;
+        _throughputWindowChars = 0;
+
+        const auto throughputMode = _throughputMode.load(std::memory_order_relaxed);
+        if (!throughputMode && charsPerSecond >= EnterThroughputModeRate)
+        {
+            _setThroughputMode(true, charsPerSecond);
+        }
+        else if (throughputMode && charsPerSecond < LeaveThroughputModeRate)
+        {
+            _setThroughputMode(false, charsPerSecond);
+        }
+    }
+
+    // Method Description:
+    // - Enters or leaves the renderer's throughput mode. See
+    //   Renderer::SetThroughputMode.
+    // Arguments:
+    // - enabled: true to enter the throughput mode, false to leave it.
+    // - charsPerSecond: the measured output rate, for the trace.
+    // Return Value:
+    // - <none>
+    void ControlCore::_setThroughputMode(const bool enabled, const uint64_t charsPerSecond)
+    {
+        {
+            auto lock = _terminal->LockForWriting();
+            if (_throughputMode.exchange(enabled, std::memory_order_relaxed) == enabled)
+            {
+                return;
+            }
+            _renderer->SetThroughputMode(enabled);
+        }
+
+#pragma warning(suppress : 26477 26485 26494 26482 26446 26447) // We don't control TraceLoggingWrite
+        TraceLoggingWrite(g_hTerminalControlProvider,
+                          "ThroughputMode",
+                          TraceLoggingDescription("Event emitted when the control enters or leaves the throughput mode"),
+                          TraceLoggingBool(enabled, "Enabled"),
+                          TraceLoggingUInt64(charsPerSecond, "CharsPerSecond"),
+                          TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+                          TraceLoggingKeyword(TIL_KEYWORD_TRACE));
+
+        if (enabled)
+        {
+            _leaveThroughputModeWhenIdle->Run();
+        }
+        else
+        {
+            // We skipped these while in the throughput mode.
+            _updatePatternLocations->Run();
+        }
     }
 
     hstring ControlCore::ReadEntireBuffer() const
@@ -1527,4 +2591,85 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         return hstring(ss.str());
     }
 
+    // Method Description:
+    // - Writes the text of the entire buffer to a file, as UTF-8.
+    // - The rows are copied out of the buffer while we hold the lock, and the
+    //   file is then written on a background thread. Until it's done, this
+    //   control reports the export's progress as its taskbar progress, so the
+    //   tab shows it in its progress ring.
+    // - Only one export per control can run at a time.
+    // Arguments:
+    // - path: the file to write. Environment variables in it are expanded.
+    winrt::fire_and_forget ControlCore::ExportBuffer(const winrt::hstring path)
+    {
+        if (_exporting.exchange(true))
+        {
+            co_return;
+        }
+
+        auto strongThis{ get_strong() };
+
+        std::vector<std::wstring> rows;
+        {
+            auto terminalLock = _terminal->LockForReading();
+
+            const auto& textBuffer = _terminal->GetTextBuffer();
+            const auto lastRow = textBuffer.GetLastNonSpaceCharacter().Y;
+            rows.reserve(gsl::narrow_cast<size_t>(lastRow) + 1);
+            for (auto rowIndex = 0; rowIndex <= lastRow; rowIndex++)
+            {
+                const auto& row = textBuffer.GetRowByOffset(rowIndex);
+                auto rowText = row.GetText();
+                rowText.erase(rowText.find_last_not_of(UNICODE_SPACE) + 1);
+                if (!row.WasWrapForced())
+                {
+                    rowText.push_back(UNICODE_CARRIAGERETURN);
+                    rowText.push_back(UNICODE_LINEFEED);
+                }
+                rows.emplace_back(std::move(rowText));
+            }
+        }
+
+        _exportProgress = 0;
+        _queueTabStatus(TabStatus::TaskbarProgress);
+
+        co_await winrt::resume_background();
+
+        try
+        {
+            const auto expandedPath = wil::ExpandEnvironmentStringsW<std::wstring>(path.c_str());
+            const wil::unique_hfile file{ CreateFileW(expandedPath.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr) };
+            THROW_LAST_ERROR_IF(!file);
+
+            // Write the file in large chunks instead of row by row,
+            // and update the progress after each of them.
+            constexpr size_t chunkSize = 64 * 1024;
+            std::string chunk;
+            std::string utf8;
+            for (size_t i = 0; i < rows.size(); ++i)
+            {
+                THROW_IF_FAILED(til::u16u8(rows[i], utf8));
+                chunk.append(utf8);
+
+                if (chunk.size() >= chunkSize || i + 1 == rows.size())
+                {
+                    DWORD written = 0;
+                    THROW_IF_WIN32_BOOL_FALSE(WriteFile(file.get(), chunk.data(), gsl::narrow<DWORD>(chunk.size()), &written, nullptr));
+                    chunk.clear();
+
+                    _exportProgress = (i + 1) * 100 / rows.size();
+                    _queueTabStatus(TabStatus::TaskbarProgress);
+                }
+            }
+        }
+        catch (...)
+        {
+            LOG_CAUGHT_EXCEPTION();
+            const winrt::hstring message{ fmt::format(std::wstring_view{ RS_(L"NoticeExportBufferFailed") }, path) };
+            _RaiseNoticeHandlers(*this, winrt::make<NoticeEventArgs>(NoticeLevel::Warning, message));
+        }
+
+        _exporting = false;
+        _queueTabStatus(TabStatus::TaskbarProgress);
+    }
 }
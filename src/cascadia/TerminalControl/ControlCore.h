@@ -21,6 +21,7 @@
 #include "../../renderer/dx/DxRenderer.hpp"
 #include "../../renderer/uia/UiaRenderer.hpp"
 #include "../../cascadia/TerminalCore/Terminal.hpp"
+#include "../../cascadia/TerminalCore/MirrorRenderData.hpp"
 #include "../buffer/out/search.h"
 #include "cppwinrt_utils.h"
 
@@ -37,6 +38,9 @@ namespace winrt::Microsoft::Terminal::Control::implementation
     public:
         ControlCore(IControlSettings settings,
                     TerminalConnection::ITerminalConnection connection);
+        // Creates a read-only mirror of the given core, see MirrorRenderData.
+        ControlCore(IControlSettings settings,
+                    const ControlCore& mirrored);
         ~ControlCore();
 
         bool Initialize(const double actualWidth,
@@ -48,6 +52,8 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         void UpdateAppearance(const IControlAppearance& newAppearance);
         void SizeChanged(const double width, const double height);
         void ScaleChanged(const double scale);
+        void VisibilityChanged(const bool visible);
+        void FocusChanged(const bool focused);
         uint64_t SwapChainHandle() const;
 
         void AdjustFontSize(int fontSizeDelta);
@@ -68,6 +74,8 @@ namespace winrt::Microsoft::Terminal::Control::implementation
 
         void ToggleShaderEffects();
         void AdjustOpacity(const double adjustment);
+        Control::PerformanceCounters GetPerformanceCounters() const;
+        Control::MemoryUsage GetMemoryUsage() const;
         void ResumeRendering();
 
         void UpdatePatternLocations();
@@ -130,7 +138,12 @@ namespace winrt::Microsoft::Terminal::Control::implementation
 
         void Search(const winrt::hstring& text,
                     const bool goForward,
-                    const bool caseSensitive);
+                    const bool caseSensitive,
+                    const bool regex);
+
+        void ScrollToCommand(const bool previous);
+        void SelectCommandOutput();
+        com_array<Core::Color> GetScrollbackOverview(const int32_t buckets);
 
         void LeftClickOnTerminal(const til::point terminalPosition,
                                  const int numberOfClicks,
@@ -144,7 +157,11 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         bool IsInReadOnlyMode() const;
         void ToggleReadOnlyMode();
 
+        const TerminalConnection::ITerminalConnection& Connection() const noexcept;
+        void BroadcastInputTo(std::vector<TerminalConnection::ITerminalConnection> connections);
+
         hstring ReadEntireBuffer() const;
+        winrt::fire_and_forget ExportBuffer(const winrt::hstring path);
 
         // -------------------------------- WinRT Events ---------------------------------
         // clang-format off
@@ -166,17 +183,27 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         TYPED_EVENT(RaiseNotice,               IInspectable, Control::NoticeEventArgs);
         TYPED_EVENT(TransparencyChanged,       IInspectable, Control::TransparencyChangedEventArgs);
         TYPED_EVENT(ReceivedOutput,            IInspectable, IInspectable);
+        TYPED_EVENT(ScrollbackOverviewChanged, IInspectable, IInspectable);
         // clang-format on
 
     private:
+        ControlCore(IControlSettings settings,
+                    TerminalConnection::ITerminalConnection connection,
+                    std::shared_ptr<::Microsoft::Terminal::Core::Terminal> mirroredTerminal);
+
         bool _initializedTerminal{ false };
         bool _closing{ false };
 
         TerminalConnection::ITerminalConnection _connection{ nullptr };
         event_token _connectionOutputEventToken;
+        // Set if the connection lends us its output, see ITerminalOutputView.
+        TerminalConnection::ITerminalOutputView _connectionOutputView{ nullptr };
         TerminalConnection::ITerminalConnection::StateChanged_revoker _connectionStateChangedRevoker;
 
-        std::unique_ptr<::Microsoft::Terminal::Core::Terminal> _terminal{ nullptr };
+        // The terminal is shared with the mirrors of this core, which can outlive it.
+        std::shared_ptr<::Microsoft::Terminal::Core::Terminal> _terminal{ nullptr };
+        // If this core mirrors another one, its renderer paints this instead of _terminal.
+        std::unique_ptr<::Microsoft::Terminal::Core::MirrorRenderData> _mirror{ nullptr };
 
         // NOTE: _renderEngine must be ordered before _renderer.
         //
@@ -202,6 +229,77 @@ namespace winrt::Microsoft::Terminal::Control::implementation
 
         std::optional<interval_tree::IntervalTree<til::point, size_t>::interval> _lastHoveredInterval{ std::nullopt };
 
+        // The hovered cell is hit-tested against this snapshot, so that moving
+        // the mouse doesn't contend for the lock with the output. It's
+        // published by UpdatePatternLocations and accessed with
+        // std::atomic_load/store. Once the viewport scrolled, it's stale until
+        // the next one is published.
+        std::shared_ptr<const ::Microsoft::Terminal::Core::Terminal::HyperlinkSnapshot> _hyperlinkSnapshot;
+        std::atomic<bool> _hyperlinkSnapshotStale{ true };
+
+        // The last compiled regex search, so that stepping through matches doesn't recompile it.
+        std::wstring _searchRegexPattern;
+        bool _searchRegexCaseSensitive{ false };
+        std::optional<std::wregex> _searchRegex;
+
+        // While ExportBuffer is writing a file, its progress (0-100) replaces
+        // the terminal's own taskbar progress.
+        std::atomic<bool> _exporting{ false };
+        std::atomic<size_t> _exportProgress{ 0 };
+
+        // While our provider is traced, the oldest key press that hasn't been
+        // shown yet. It's an "InputLatency" activity which ends at the first
+        // frame presented after output was received for it.
+        struct InputLatencyTrace
+        {
+            GUID activityId{};
+            std::chrono::steady_clock::time_point start;
+            bool outputReceived{ false };
+        };
+        std::mutex _inputLatencyMutex;
+        std::optional<InputLatencyTrace> _inputLatency;
+        std::atomic<bool> _inputLatencyPending{ false };
+        std::atomic<bool> _inputLatencyOutputReceived{ false };
+
+        // The rate of output is measured over windows of ThroughputModeWindow.
+        // The window is only touched by the connection's output thread.
+        std::chrono::steady_clock::time_point _throughputWindowStart{};
+        uint64_t _throughputWindowChars{ 0 };
+        std::atomic<std::chrono::steady_clock::time_point> _lastOutputTime{};
+        std::atomic<bool> _throughputMode{ false };
+
+        // The latest scroll position, stored by the terminal for every line
+        // it scrolls in and published once per ScrollBarUpdateInterval by
+        // _publishScrollPosition. The values are stored separately, so they
+        // might briefly not match up, but the last update always publishes
+        // the final state.
+        std::atomic<int> _scrollViewTop{ 0 };
+        std::atomic<int> _scrollViewHeight{ 0 };
+        std::atomic<int> _scrollBufferSize{ 0 };
+
+        // The tab statuses that changed since _publishTabStatus last raised
+        // their events, and the latest title to raise TitleChanged with.
+        enum class TabStatus : uint8_t
+        {
+            Title = 0x1,
+            TabColor = 0x2,
+            TaskbarProgress = 0x4,
+        };
+        std::atomic<uint8_t> _pendingTabStatus{ 0 };
+        std::mutex _pendingTitleMutex;
+        std::wstring _pendingTitle;
+
+        // The input the user sends to our connection is also written to these,
+        // see BroadcastInputTo. A background writer takes the input that piled
+        // up while it was writing, so each connection gets it in one batch.
+        std::mutex _broadcastMutex;
+        std::vector<TerminalConnection::ITerminalConnection> _broadcastConnections;
+        std::wstring _pendingBroadcastInput;
+        bool _writingBroadcastInput{ false };
+        // The thread that's sending the user's input. Anything else, like the
+        // replies to the output's queries, isn't broadcast.
+        std::atomic<DWORD> _userInputThreadId{ 0 };
+
         // These members represent the size of the surface that we should be
         // rendering to.
         double _panelWidth{ 0 };
@@ -211,17 +309,33 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         winrt::Windows::System::DispatcherQueue _dispatcher{ nullptr };
         std::shared_ptr<ThrottledFuncTrailing<>> _tsfTryRedrawCanvas;
         std::shared_ptr<ThrottledFuncTrailing<>> _updatePatternLocations;
-        std::shared_ptr<ThrottledFuncTrailing<Control::ScrollPositionChangedArgs>> _updateScrollBar;
+        std::shared_ptr<ThrottledFuncTrailing<>> _updateScrollBar;
+        std::shared_ptr<ThrottledFuncTrailing<>> _resizeToPanel;
+        std::shared_ptr<ThrottledFuncTrailing<>> _leaveThroughputModeWhenIdle;
+        std::shared_ptr<ThrottledFuncTrailing<>> _flushMouseMotion;
+        std::shared_ptr<ThrottledFuncTrailing<>> _updateScrollbackOverview;
+        std::shared_ptr<ThrottledFuncTrailing<>> _publishTabStatus;
 
         winrt::fire_and_forget _asyncCloseConnection();
 
         void _setFontSize(int fontSize);
         void _updateFont(const bool initialUpdate = false);
         void _refreshSizeUnderLock();
+        void _resizeToPanelSize();
         void _doResizeUnderLock(const double newWidth,
                                 const double newHeight);
 
         void _sendInputToConnection(std::wstring_view wstr);
+        void _broadcastInput(std::wstring_view wstr);
+        winrt::fire_and_forget _writeBroadcastInput();
+
+        void _traceInputLatencyStart();
+        void _traceInputLatencyOutput();
+
+        void _updateThroughputMode(const size_t length);
+        void _publishScrollPosition();
+        void _mirrorChanged();
+        void _setThroughputMode(const bool enabled, const uint64_t charsPerSecond);
 
 #pragma region TerminalCoreCallbacks
         void _terminalCopyToClipboard(std::wstring_view wstr);
@@ -234,17 +348,20 @@ namespace winrt::Microsoft::Terminal::Control::implementation
                                             const int bufferSize);
         void _terminalCursorPositionChanged();
         void _terminalTaskbarProgressChanged();
+        void _queueTabStatus(const TabStatus status);
+        void _raiseTabStatus();
 #pragma endregion
 
 #pragma region RendererCallbacks
         void _rendererWarning(const HRESULT hr);
         void _renderEngineSwapChainChanged();
+        void _renderEnginePresented();
 #pragma endregion
 
         void _raiseReadOnlyWarning();
         void _updateAntiAliasingMode(::Microsoft::Console::Render::DxEngine* const dxEngine);
-        void _connectionOutputHandler(const hstring& hstr);
-        void _updateHoveredCell(const std::optional<til::point> terminalPosition);
+        void _connectionOutputHandler(const std::wstring_view output);
+        void _updateHoveredCell(const std::optional<til::point> terminalPosition, const bool force = false);
 
         inline bool _IsClosing() const noexcept
         {
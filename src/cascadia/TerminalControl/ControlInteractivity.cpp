@@ -48,6 +48,16 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         _core = winrt::make_self<ControlCore>(settings, connection);
     }
 
+    ControlInteractivity::ControlInteractivity(IControlSettings settings,
+                                               const ControlCore& mirrored) :
+        _touchAnchor{ std::nullopt },
+        _lastMouseClickTimestamp{},
+        _lastMouseClickPos{},
+        _selectionNeedsToBeCopied{ false }
+    {
+        _core = winrt::make_self<ControlCore>(settings, mirrored);
+    }
+
     // Method Description:
     // - Updates our internal settings. These settings should be
     //   interactivity-specific. Right now, we primarily update _rowsToScroll
@@ -111,6 +121,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
             THROW_IF_FAILED(_uiaEngine->Enable());
         }
 
+        _core->FocusChanged(true);
         _updateSystemParameterSettings();
     }
 
@@ -120,6 +131,8 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         {
             THROW_IF_FAILED(_uiaEngine->Disable());
         }
+
+        _core->FocusChanged(false);
     }
 
     // Method Description
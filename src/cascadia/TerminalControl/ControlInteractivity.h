@@ -36,6 +36,9 @@ namespace winrt::Microsoft::Terminal::Control::implementation
     public:
         ControlInteractivity(IControlSettings settings,
                              TerminalConnection::ITerminalConnection connection);
+        // Creates the interactivity of a read-only mirror of the given core.
+        ControlInteractivity(IControlSettings settings,
+                             const ControlCore& mirrored);
 
         void GotFocus();
         void LostFocus();
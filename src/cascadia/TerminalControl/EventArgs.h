@@ -33,21 +33,40 @@ namespace winrt::Microsoft::Terminal::Control::implementation
             _rtf(),
             _formats(static_cast<CopyFormat>(0)) {}
 
-        CopyToClipboardEventArgs(hstring text, hstring html, hstring rtf, Windows::Foundation::IReference<CopyFormat> formats) :
+        // The HTML and RTF are only generated once somebody asks for them,
+        // which might be never. The generators may run on any thread.
+        using FormatGenerator = std::function<hstring()>;
+
+        CopyToClipboardEventArgs(hstring text, FormatGenerator html, FormatGenerator rtf, Windows::Foundation::IReference<CopyFormat> formats) :
             _text(text),
-            _html(html),
-            _rtf(rtf),
+            _html(),
+            _rtf(),
+            _generateHtml(std::move(html)),
+            _generateRtf(std::move(rtf)),
             _formats(formats) {}
 
         hstring Text() { return _text; };
-        hstring Html() { return _html; };
-        hstring Rtf() { return _rtf; };
+        hstring Html() { return _generate(_htmlOnce, _generateHtml, _html); };
+        hstring Rtf() { return _generate(_rtfOnce, _generateRtf, _rtf); };
         Windows::Foundation::IReference<CopyFormat> Formats() { return _formats; };
 
     private:
+        static hstring _generate(std::once_flag& once, const FormatGenerator& generator, hstring& result)
+        {
+            if (generator)
+            {
+                std::call_once(once, [&]() { result = generator(); });
+            }
+            return result;
+        }
+
         hstring _text;
         hstring _html;
         hstring _rtf;
+        FormatGenerator _generateHtml;
+        FormatGenerator _generateRtf;
+        std::once_flag _htmlOnce;
+        std::once_flag _rtfOnce;
         Windows::Foundation::IReference<CopyFormat> _formats;
     };
 
@@ -22,6 +22,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         _focusableElements.insert(TextBox());
         _focusableElements.insert(CloseButton());
         _focusableElements.insert(CaseSensitivityButton());
+        _focusableElements.insert(RegexButton());
         _focusableElements.insert(GoForwardButton());
         _focusableElements.insert(GoBackwardButton());
     }
@@ -50,6 +51,18 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         return CaseSensitivityButton().IsChecked().GetBoolean();
     }
 
+    // Method Description:
+    // - Check if the current search is a regular expression search
+    // Arguments:
+    // - <none>
+    // Return Value:
+    // - bool: whether the search text is a regular expression (regex button is checked)
+    //   or not
+    bool SearchBoxControl::_Regex()
+    {
+        return RegexButton().IsChecked().GetBoolean();
+    }
+
     // Method Description:
     // - Handler for pressing Enter on TextBox, trigger
     //   text search
@@ -65,11 +78,11 @@ namespace winrt::Microsoft::Terminal::Control::implementation
             auto const state = CoreWindow::GetForCurrentThread().GetKeyState(winrt::Windows::System::VirtualKey::Shift);
             if (WI_IsFlagSet(state, CoreVirtualKeyStates::Down))
             {
-                _SearchHandlers(TextBox().Text(), !_GoForward(), _CaseSensitive());
+                _SearchHandlers(TextBox().Text(), !_GoForward(), _CaseSensitive(), _Regex());
             }
             else
             {
-                _SearchHandlers(TextBox().Text(), _GoForward(), _CaseSensitive());
+                _SearchHandlers(TextBox().Text(), _GoForward(), _CaseSensitive(), _Regex());
             }
             e.Handled(true);
         }
@@ -160,7 +173,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         }
 
         // kick off search
-        _SearchHandlers(TextBox().Text(), _GoForward(), _CaseSensitive());
+        _SearchHandlers(TextBox().Text(), _GoForward(), _CaseSensitive(), _Regex());
     }
 
     // Method Description:
@@ -181,7 +194,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         }
 
         // kick off search
-        _SearchHandlers(TextBox().Text(), _GoForward(), _CaseSensitive());
+        _SearchHandlers(TextBox().Text(), _GoForward(), _CaseSensitive(), _Regex());
     }
 
     // Method Description:
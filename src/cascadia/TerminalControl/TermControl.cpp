@@ -11,6 +11,7 @@
 #include <LibraryResources.h>
 #include "../../types/inc/GlyphWidth.hpp"
 #include "../../types/inc/Utils.hpp"
+#include "../inc/ImageCache.h"
 
 #include "TermControl.g.cpp"
 #include "TermControlAutomationPeer.h"
@@ -50,6 +51,12 @@ namespace winrt::Microsoft::Terminal::Control::implementation
 {
     TermControl::TermControl(IControlSettings settings,
                              TerminalConnection::ITerminalConnection connection) :
+        TermControl(settings, winrt::make<implementation::ControlInteractivity>(settings, connection))
+    {
+    }
+
+    TermControl::TermControl(IControlSettings settings,
+                             Control::ControlInteractivity interactivity) :
         _settings{ settings },
         _isInternalScrollBarUpdate{ false },
         _autoScrollVelocity{ 0 },
@@ -62,7 +69,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
     {
         InitializeComponent();
 
-        _interactivity = winrt::make<implementation::ControlInteractivity>(settings, connection);
+        _interactivity = std::move(interactivity);
         _core = _interactivity.Core();
 
         // These events might all be triggered by the connection, but that
@@ -71,6 +78,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         _core.ScrollPositionChanged({ this, &TermControl::_ScrollPositionChanged });
         _core.WarningBell({ this, &TermControl::_coreWarningBell });
         _core.CursorPositionChanged({ this, &TermControl::_CursorPositionChanged });
+        _core.ScrollbackOverviewChanged({ this, &TermControl::_coreScrollbackOverviewChanged });
 
         // This event is specifically triggered by the renderer thread, a BG thread. Use a weak ref here.
         _core.RendererEnteredErrorState({ get_weak(), &TermControl::_RendererEnteredErrorState });
@@ -193,7 +201,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         }
         else
         {
-            _core.Search(_searchBox->TextBox().Text(), goForward, false);
+            _core.Search(_searchBox->TextBox().Text(), goForward, false, false);
         }
     }
 
@@ -204,13 +212,15 @@ namespace winrt::Microsoft::Terminal::Control::implementation
     // - text: the text to search
     // - goForward: boolean that represents if the current search direction is forward
     // - caseSensitive: boolean that represents if the current search is case sensitive
+    // - regex: boolean that represents if the text is a regular expression
     // Return Value:
     // - <none>
     void TermControl::_Search(const winrt::hstring& text,
                               const bool goForward,
-                              const bool caseSensitive)
+                              const bool caseSensitive,
+                              const bool regex)
     {
-        _core.Search(text, goForward, caseSensitive);
+        _core.Search(text, goForward, caseSensitive, regex);
     }
 
     // Method Description:
@@ -314,7 +324,11 @@ namespace winrt::Microsoft::Terminal::Control::implementation
                 // which is especially important since the image
                 // may well be both large and somewhere out on the
                 // internet.
-                Media::Imaging::BitmapImage image(imageUri);
+                // Every control showing this image shares the same
+                // BitmapImage, so it's decoded (and uploaded to the GPU) once.
+                const auto image = ImageCache<Media::Imaging::BitmapImage>::ForThread().GetOrCreate(newAppearance.BackgroundImage(), [&](const winrt::hstring&) {
+                    return Media::Imaging::BitmapImage{ imageUri };
+                });
                 BackgroundImage().Source(image);
             }
 
@@ -357,6 +371,108 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         _core.ToggleShaderEffects();
     }
 
+    // Method Description:
+    // - Shows or hides the overlay with the frame rate, paint time, parser
+    //   throughput and lock wait time of this control. While it's hidden,
+    //   nothing but the counters themselves is updated.
+    void TermControl::TogglePerformanceOverlay()
+    {
+        if (_performanceOverlayTimer && _performanceOverlayTimer.IsEnabled())
+        {
+            _performanceOverlayTimer.Stop();
+            PerformanceOverlay().Visibility(Visibility::Collapsed);
+            return;
+        }
+
+        // Lazy load the overlay, like the search box.
+        if (!FindName(L"PerformanceOverlay"))
+        {
+            return;
+        }
+
+        if (!_performanceOverlayTimer)
+        {
+            _performanceOverlayTimer = {};
+            _performanceOverlayTimer.Interval(std::chrono::seconds(1));
+            _performanceOverlayTimer.Tick({ get_weak(), &TermControl::_PerformanceOverlayTick });
+        }
+
+        _lastPerformanceCounters = _core.GetPerformanceCounters();
+        _lastPerformanceSampleTime = std::chrono::steady_clock::now();
+        PerformanceOverlayText().Text(L"...");
+        PerformanceOverlay().Visibility(Visibility::Visible);
+        _performanceOverlayTimer.Start();
+    }
+
+    // Method Description:
+    // - Samples the control's performance counters and shows what changed
+    //   since the last tick. Paint time and dirty cells are averaged over
+    //   the frames painted in that interval. Memory is shown as it is now.
+    void TermControl::_PerformanceOverlayTick(Windows::Foundation::IInspectable const& /* sender */,
+                                              Windows::Foundation::IInspectable const& /* e */)
+    {
+        if (_IsClosing())
+        {
+            return;
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        const auto counters = _core.GetPerformanceCounters();
+        const auto& last = _lastPerformanceCounters;
+        const auto seconds = std::chrono::duration<double>(now - _lastPerformanceSampleTime).count();
+
+        const auto frames = counters.Frames - last.Frames;
+        const auto perFrame = frames ? 1.0 / frames : 0.0;
+        const auto paintMs = (counters.PaintMicroseconds - last.PaintMicroseconds) / 1000.0 * perFrame;
+        const auto dirtyCells = (counters.DirtyCells - last.DirtyCells) * perFrame;
+
+        // Text arrives as UTF-16, so that's what the byte counts refer to.
+        const auto bytes = static_cast<double>((counters.ParsedChars - last.ParsedChars) * sizeof(wchar_t));
+        const auto parseUs = counters.ParseMicroseconds - last.ParseMicroseconds;
+        const auto parserMBps = parseUs ? bytes / parseUs : 0.0;
+        const auto lockWaitMs = (counters.LockWaitMicroseconds - last.LockWaitMicroseconds) / 1000.0;
+
+        const auto memory = _core.GetMemoryUsage();
+        const auto bufferBytes = memory.BufferRows + memory.BufferText + memory.BufferAttributes + memory.BufferUnicodeStorage + memory.BufferHyperlinks;
+        const auto cacheBytes = memory.PatternTree + memory.ShapedTextCache + memory.FontFallbackCache;
+
+        const auto text = fmt::format(L"{:.0f} fps, {:.2f} ms/frame, {:.0f} cells/frame\n"
+                                      L"output {:.1f} KB/s, parser {:.1f} MB/s\n"
+                                      L"lock wait {:.1f} ms/s\n"
+                                      L"buffer {:.1f} MB (text {:.1f}, attributes {:.1f}, glyphs {:.1f})\n"
+                                      L"caches {:.1f} KB (shaping {:.1f}, fallback {:.1f}, patterns {:.1f})",
+                                      frames / seconds,
+                                      paintMs,
+                                      dirtyCells,
+                                      bytes / 1024.0 / seconds,
+                                      parserMBps,
+                                      lockWaitMs / seconds,
+                                      bufferBytes / 1048576.0,
+                                      memory.BufferText / 1048576.0,
+                                      memory.BufferAttributes / 1048576.0,
+                                      memory.BufferUnicodeStorage / 1048576.0,
+                                      cacheBytes / 1024.0,
+                                      memory.ShapedTextCache / 1024.0,
+                                      memory.FontFallbackCache / 1024.0,
+                                      memory.PatternTree / 1024.0);
+        PerformanceOverlayText().Text(text);
+
+        _lastPerformanceCounters = counters;
+        _lastPerformanceSampleTime = now;
+    }
+
+    // Method Description:
+    // - Tells the control whether it can currently be seen. Painting is
+    //   suspended while it can't. See ControlCore::VisibilityChanged.
+    // Arguments:
+    // - visible: false when the control's tab isn't selected or its window is minimized.
+    // Return Value:
+    // - <none>
+    void TermControl::VisibilityChanged(const bool visible)
+    {
+        _core.VisibilityChanged(visible);
+    }
+
     // Method Description:
     // - Style our UI elements based on the values in our _settings, and set up
     //   other control-specific settings. This method will be called whenever
@@ -398,6 +514,10 @@ namespace winrt::Microsoft::Terminal::Control::implementation
             ScrollBar().Visibility(Visibility::Visible);
         }
 
+        const auto showMinimap = newSettings.ScrollState() == ScrollbarState::Minimap;
+        ScrollbackMinimap().Visibility(showMinimap ? Visibility::Visible : Visibility::Collapsed);
+        _UpdateScrollbackMinimap();
+
         _interactivity.UpdateSettings();
         if (_automationPeer)
         {
@@ -501,6 +621,38 @@ namespace winrt::Microsoft::Terminal::Control::implementation
     TermControl::~TermControl()
     {
         Close();
+
+        // Destroying the core frees the text buffer with all of its history as
+        // well as the renderer and its DX resources, which can take a while.
+        // Nothing on the UI thread needs them anymore, so a background thread
+        // does it.
+        // The UIA engine is disabled first, so that it doesn't signal the
+        // automation peer, which stays behind on the UI thread.
+        if (_interactivity)
+        {
+            try
+            {
+                _interactivity.LostFocus();
+            }
+            CATCH_LOG();
+        }
+        _DestroyInBackground(std::exchange(_interactivity, nullptr), std::exchange(_core, nullptr));
+    }
+
+    // Method Description:
+    // - Releases the given core and interactivity on a background thread.
+    //   If these were the last references, they're destroyed there.
+    // Arguments:
+    // - interactivity: the interactivity to release
+    // - core: the core to release
+    winrt::fire_and_forget TermControl::_DestroyInBackground(Control::ControlInteractivity interactivity, Control::ControlCore core)
+    {
+        co_await winrt::resume_background();
+
+        // Like in our members, the core has to go before the interactivity,
+        // which owns the UIA engine that the renderer points to.
+        core = nullptr;
+        interactivity = nullptr;
     }
 
     // Method Description:
@@ -1675,6 +1827,64 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         _updateScrollBar->Run(update);
     }
 
+    void TermControl::_coreScrollbackOverviewChanged(const IInspectable& /*sender*/,
+                                                     const IInspectable& /*args*/)
+    {
+        _UpdateScrollbackMinimap();
+    }
+
+    void TermControl::_ScrollbackMinimapSizeChanged(const IInspectable& /*sender*/,
+                                                    const SizeChangedEventArgs& /*args*/)
+    {
+        _UpdateScrollbackMinimap();
+    }
+
+    // Method Description:
+    // - Redraws the scrollback minimap behind the scroll bar, if the profile
+    //   enabled it. Every other pixel row of the minimap gets the color of the
+    //   rows it covers (see Terminal::GetScrollbackOverview). The colors are
+    //   drawn as the hard stops of a vertical gradient, which is a lot cheaper
+    //   than a bitmap we'd have to upload on every change.
+    // - The core only raises ScrollbackOverviewChanged every so often, and
+    //   only summarizes the rows that changed since the last time.
+    // Arguments:
+    // - <none>
+    // Return Value:
+    // - <none>
+    void TermControl::_UpdateScrollbackMinimap()
+    {
+        // Even with the stops, a gradient gets expensive to draw. This is more
+        // than enough to find the red errors in a long build log.
+        static constexpr int32_t MaxBuckets = 512;
+
+        auto minimap = ScrollbackMinimap();
+        if (_IsClosing() || minimap.Visibility() != Visibility::Visible)
+        {
+            return;
+        }
+
+        const auto buckets = std::clamp(static_cast<int32_t>(minimap.ActualHeight() / 2), 0, MaxBuckets);
+        const auto colors = _core.GetScrollbackOverview(buckets);
+
+        Media::LinearGradientBrush brush{};
+        brush.StartPoint({ 0, 0 });
+        brush.EndPoint({ 0, 1 });
+        auto stops = brush.GradientStops();
+        const auto count = static_cast<double>(colors.size());
+        for (uint32_t i = 0; i < colors.size(); ++i)
+        {
+            const til::color color{ colors[i] };
+            for (const auto offset : { i / count, (i + 1) / count })
+            {
+                Media::GradientStop stop{};
+                stop.Color(color);
+                stop.Offset(offset);
+                stops.Append(stop);
+            }
+        }
+        minimap.Fill(brush);
+    }
+
     // Method Description:
     // - Tells TSFInputControl to redraw the Canvas/TextBlock so it'll update
     //   to be where the current cursor position is.
@@ -1741,6 +1951,42 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         _interactivity.RequestPasteTextFromClipboard();
     }
 
+    // Method Description:
+    // - Creates a read-only control that shows the same terminal as this one,
+    //   but with a viewport of its own. The mirror doesn't parse the output
+    //   again, nor does it send any input.
+    // Return Value:
+    // - the new control
+    Control::TermControl TermControl::CreateMirror()
+    {
+        const auto core = winrt::get_self<ControlCore>(_core);
+        auto interactivity = winrt::make<implementation::ControlInteractivity>(_settings, *core);
+        return winrt::make<TermControl>(_settings, std::move(interactivity));
+    }
+
+    // Method Description:
+    // - Makes this control send the input the user types into it to the
+    //   connections of the given controls as well. The input is only encoded
+    //   by this control's terminal, the others get the same bytes.
+    // Arguments:
+    // - targets: the controls to broadcast to, or null to stop broadcasting
+    // Return Value:
+    // - <none>
+    void TermControl::BroadcastInputTo(const Windows::Foundation::Collections::IVectorView<Control::TermControl>& targets)
+    {
+        std::vector<TerminalConnection::ITerminalConnection> connections;
+        if (targets)
+        {
+            connections.reserve(targets.Size());
+            for (const auto& target : targets)
+            {
+                const auto targetCore = winrt::get_self<ControlCore>(winrt::get_self<TermControl>(target)->_core);
+                connections.emplace_back(targetCore->Connection());
+            }
+        }
+        winrt::get_self<ControlCore>(_core)->BroadcastInputTo(std::move(connections));
+    }
+
     void TermControl::Close()
     {
         if (!_IsClosing())
@@ -1752,6 +1998,10 @@ namespace winrt::Microsoft::Terminal::Control::implementation
             // Disconnect the TSF input control so it doesn't receive EditContext events.
             TSFInputControl().Close();
             _autoScrollTimer.Stop();
+            if (_performanceOverlayTimer)
+            {
+                _performanceOverlayTimer.Stop();
+            }
 
             _core.Close();
         }
@@ -1877,7 +2127,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         double width = cols * fontSize.X;
 
         // Reserve additional space if scrollbar is intended to be visible
-        if (scrollState == ScrollbarState::Visible)
+        if (scrollState != ScrollbarState::Hidden)
         {
             width += scrollbarSize;
         }
@@ -1921,7 +2171,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
             double width = fontSize.Width;
             double height = fontSize.Height;
             // Reserve additional space if scrollbar is intended to be visible
-            if (_settings.ScrollState() == ScrollbarState::Visible)
+            if (_settings.ScrollState() != ScrollbarState::Hidden)
             {
                 width += ScrollBar().ActualWidth();
             }
@@ -1970,7 +2220,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
                                                            padding.Left + padding.Right :
                                                            padding.Top + padding.Bottom);
 
-        if (widthOrHeight && _settings.ScrollState() == ScrollbarState::Visible)
+        if (widthOrHeight && _settings.ScrollState() != ScrollbarState::Hidden)
         {
             nonTerminalArea += gsl::narrow_cast<float>(ScrollBar().ActualWidth());
         }
@@ -2591,4 +2841,19 @@ namespace winrt::Microsoft::Terminal::Control::implementation
     {
         return _core.ReadEntireBuffer();
     }
+
+    void TermControl::ExportBuffer(const hstring& path)
+    {
+        _core.ExportBuffer(path);
+    }
+
+    void TermControl::ScrollToCommand(const bool previous)
+    {
+        _core.ScrollToCommand(previous);
+    }
+
+    void TermControl::SelectCommandOutput()
+    {
+        _core.SelectCommandOutput();
+    }
 }
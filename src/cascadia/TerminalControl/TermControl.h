@@ -26,6 +26,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
     struct TermControl : TermControlT<TermControl>
     {
         TermControl(IControlSettings settings, TerminalConnection::ITerminalConnection connection);
+        TermControl(IControlSettings settings, Control::ControlInteractivity interactivity);
 
         winrt::fire_and_forget UpdateSettings();
         winrt::fire_and_forget UpdateAppearance(const IControlAppearance newAppearance);
@@ -35,6 +36,8 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         bool CopySelectionToClipboard(bool singleLine, const Windows::Foundation::IReference<CopyFormat>& formats);
         void PasteTextFromClipboard();
         void Close();
+        Control::TermControl CreateMirror();
+        void BroadcastInputTo(const Windows::Foundation::Collections::IVectorView<Control::TermControl>& targets);
         Windows::Foundation::Size CharacterDimensions() const;
         Windows::Foundation::Size MinimumSize();
         float SnapDimensionToGrid(const bool widthOrHeight, const float dimension);
@@ -64,6 +67,8 @@ namespace winrt::Microsoft::Terminal::Control::implementation
 
         void SendInput(const winrt::hstring& input);
         void ToggleShaderEffects();
+        void TogglePerformanceOverlay();
+        void VisibilityChanged(const bool visible);
 
         winrt::fire_and_forget RenderEngineSwapChainChanged(IInspectable sender, IInspectable args);
         void _AttachDxgiSwapChainToXaml(HANDLE swapChainHandle);
@@ -108,6 +113,10 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         static Windows::UI::Xaml::Thickness ParseThicknessFromPadding(const hstring padding);
 
         hstring ReadEntireBuffer() const;
+        void ExportBuffer(const hstring& path);
+
+        void ScrollToCommand(const bool previous);
+        void SelectCommandOutput();
 
         // -------------------------------- WinRT Events ---------------------------------
         // clang-format off
@@ -183,6 +192,12 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         std::optional<Windows::UI::Xaml::DispatcherTimer> _cursorTimer;
         std::optional<Windows::UI::Xaml::DispatcherTimer> _blinkTimer;
 
+        // While the performance overlay is shown, this ticks once a second
+        // and the overlay shows the change since the previous sample.
+        Windows::UI::Xaml::DispatcherTimer _performanceOverlayTimer{ nullptr };
+        Control::PerformanceCounters _lastPerformanceCounters{};
+        std::chrono::steady_clock::time_point _lastPerformanceSampleTime;
+
         winrt::Windows::UI::Xaml::Controls::SwapChainPanel::LayoutUpdated_revoker _layoutUpdatedRevoker;
 
         inline bool _IsClosing() const noexcept
@@ -204,6 +219,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         void _InitializeBackgroundBrush();
         void _BackgroundColorChangedHandler(const IInspectable& sender, const IInspectable& args);
         winrt::fire_and_forget _changeBackgroundColor(const til::color bg);
+        static winrt::fire_and_forget _DestroyInBackground(Control::ControlInteractivity interactivity, Control::ControlCore core);
 
         bool _InitializeTerminal();
         void _SetFontSize(int fontSize);
@@ -229,6 +245,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         void _CursorTimerTick(Windows::Foundation::IInspectable const& sender, Windows::Foundation::IInspectable const& e);
         void _BlinkTimerTick(Windows::Foundation::IInspectable const& sender, Windows::Foundation::IInspectable const& e);
         void _BellLightOff(Windows::Foundation::IInspectable const& sender, Windows::Foundation::IInspectable const& e);
+        void _PerformanceOverlayTick(Windows::Foundation::IInspectable const& sender, Windows::Foundation::IInspectable const& e);
 
         void _SetEndSelectionPointAtCursor(Windows::Foundation::Point const& cursorPosition);
 
@@ -238,6 +255,9 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         void _TerminalTabColorChanged(const std::optional<til::color> color);
 
         void _ScrollPositionChanged(const IInspectable& sender, const Control::ScrollPositionChangedArgs& args);
+        void _coreScrollbackOverviewChanged(const IInspectable& sender, const IInspectable& args);
+        void _ScrollbackMinimapSizeChanged(const IInspectable& sender, const Windows::UI::Xaml::SizeChangedEventArgs& args);
+        void _UpdateScrollbackMinimap();
         winrt::fire_and_forget _CursorPositionChanged(const IInspectable& sender, const IInspectable& args);
 
         bool _CapturePointer(Windows::Foundation::IInspectable const& sender, Windows::UI::Xaml::Input::PointerRoutedEventArgs const& e);
@@ -256,7 +276,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         const til::point _toTerminalOrigin(winrt::Windows::Foundation::Point cursorPosition);
         double _GetAutoScrollSpeed(double cursorDistanceFromBorder) const;
 
-        void _Search(const winrt::hstring& text, const bool goForward, const bool caseSensitive);
+        void _Search(const winrt::hstring& text, const bool goForward, const bool caseSensitive, const bool regex);
         void _CloseSearchBoxControl(const winrt::Windows::Foundation::IInspectable& sender, Windows::UI::Xaml::RoutedEventArgs const& args);
 
         // TSFInputControl Handlers
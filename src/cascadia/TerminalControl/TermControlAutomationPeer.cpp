@@ -28,6 +28,11 @@ namespace XamlAutomation
     using winrt::Windows::UI::Xaml::Automation::Provider::ITextRangeProvider;
 }
 
+// The minimum delay between raising text changed events.
+// The renderer signals a text change every frame while there's output, and
+// every event makes UIA clients re-read the text.
+constexpr const auto TextChangedInterval = std::chrono::milliseconds(100);
+
 namespace winrt::Microsoft::Terminal::Control::implementation
 {
     TermControlAutomationPeer::TermControlAutomationPeer(TermControl* owner,
@@ -37,6 +42,19 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         _termControl{ owner },
         _contentAutomationPeer{ impl }
     {
+        // The throttled func is owned by us and can't outlive us,
+        // so it's safe for it to hold on to `this`.
+        _raiseTextChanged = std::make_shared<ThrottledFuncTrailing<>>(
+            winrt::Windows::System::DispatcherQueue::GetForCurrentThread(),
+            TextChangedInterval,
+            [this]() {
+                if (AutomationPeer::ListenerExists(AutomationEvents::TextPatternOnTextChanged))
+                {
+                    // The event that is raised when textual content is modified.
+                    RaiseAutomationEvent(AutomationEvents::TextPatternOnTextChanged);
+                }
+            });
+
         UpdateControlBounds();
         SetControlPadding(padding);
         // Listen for UIA signalling events from the implementation. We need to
@@ -69,6 +87,8 @@ namespace winrt::Microsoft::Terminal::Control::implementation
 
     // Method Description:
     // - Signals the ui automation client that the terminal's selection has changed and should be updated
+    // - If an event is still waiting to be raised on the UI thread, that one
+    //   already covers this change, so we don't queue another.
     // Arguments:
     // - <none>
     // Return Value:
@@ -77,21 +97,27 @@ namespace winrt::Microsoft::Terminal::Control::implementation
     {
         UiaTracing::Signal::SelectionChanged();
         auto dispatcher{ Dispatcher() };
-        if (!dispatcher)
+        if (!dispatcher || _selectionChangedPending.exchange(true))
         {
             return;
         }
         dispatcher.RunAsync(Windows::UI::Core::CoreDispatcherPriority::Normal, [weakThis{ get_weak() }]() {
             if (auto strongThis{ weakThis.get() })
             {
-                // The event that is raised when the text selection is modified.
-                strongThis->RaiseAutomationEvent(AutomationEvents::TextPatternOnTextSelectionChanged);
+                strongThis->_selectionChangedPending = false;
+                if (AutomationPeer::ListenerExists(AutomationEvents::TextPatternOnTextSelectionChanged))
+                {
+                    // The event that is raised when the text selection is modified.
+                    strongThis->RaiseAutomationEvent(AutomationEvents::TextPatternOnTextSelectionChanged);
+                }
             }
         });
     }
 
     // Method Description:
     // - Signals the ui automation client that the terminal's output has changed and should be updated
+    // - The event is raised on the UI thread at most once per TextChangedInterval,
+    //   however often the output changes in between.
     // Arguments:
     // - <none>
     // Return Value:
@@ -99,22 +125,13 @@ namespace winrt::Microsoft::Terminal::Control::implementation
     void TermControlAutomationPeer::SignalTextChanged()
     {
         UiaTracing::Signal::TextChanged();
-        auto dispatcher{ Dispatcher() };
-        if (!dispatcher)
-        {
-            return;
-        }
-        dispatcher.RunAsync(Windows::UI::Core::CoreDispatcherPriority::Normal, [weakThis{ get_weak() }]() {
-            if (auto strongThis{ weakThis.get() })
-            {
-                // The event that is raised when textual content is modified.
-                strongThis->RaiseAutomationEvent(AutomationEvents::TextPatternOnTextChanged);
-            }
-        });
+        _raiseTextChanged->Run();
     }
 
     // Method Description:
     // - Signals the ui automation client that the cursor's state has changed and should be updated
+    // - Like with selection changes, a cursor move that happens while an event
+    //   is still waiting to be raised is covered by that event.
     // Arguments:
     // - <none>
     // Return Value:
@@ -123,13 +140,19 @@ namespace winrt::Microsoft::Terminal::Control::implementation
     {
         UiaTracing::Signal::CursorChanged();
         auto dispatcher{ Dispatcher() };
-        if (!dispatcher)
+        if (!dispatcher || _cursorChangedPending.exchange(true))
         {
             return;
         }
         dispatcher.RunAsync(Windows::UI::Core::CoreDispatcherPriority::Normal, [weakThis{ get_weak() }]() {
             if (auto strongThis{ weakThis.get() })
             {
+                strongThis->_cursorChangedPending = false;
+                if (!AutomationPeer::ListenerExists(AutomationEvents::TextPatternOnTextSelectionChanged))
+                {
+                    return;
+                }
+
                 // The event that is raised when the text was changed in an edit control.
                 // Do NOT fire a TextEditTextChanged. Generally, an app on the other side
                 //    will expect more information. Though you can dispatch that event
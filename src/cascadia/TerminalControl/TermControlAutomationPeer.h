@@ -78,6 +78,9 @@ namespace winrt::Microsoft::Terminal::Control::implementation
     private:
         winrt::Microsoft::Terminal::Control::implementation::TermControl* _termControl;
         Control::InteractivityAutomationPeer _contentAutomationPeer;
+        std::shared_ptr<ThrottledFuncTrailing<>> _raiseTextChanged;
+        std::atomic<bool> _selectionChangedPending{ false };
+        std::atomic<bool> _cursorChangedPending{ false };
 
         winrt::com_array<Windows::UI::Xaml::Automation::Provider::ITextRangeProvider> WrapArrayOfTextRangeProviders(SAFEARRAY* textRanges);
     };
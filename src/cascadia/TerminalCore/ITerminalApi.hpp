@@ -4,6 +4,7 @@
 
 #include "../../terminal/adapter/DispatchTypes.hpp"
 #include "../../buffer/out/TextAttribute.hpp"
+#include "../../buffer/out/CommandTimeline.hpp"
 #include "../../types/inc/Viewport.hpp"
 
 namespace Microsoft::Terminal::Core
@@ -72,6 +73,8 @@ namespace Microsoft::Terminal::Core
         virtual bool SetWorkingDirectory(std::wstring_view uri) noexcept = 0;
         virtual std::wstring_view GetWorkingDirectory() noexcept = 0;
 
+        virtual bool AddCommandMark(const ::CommandTimeline::MarkKind kind, const std::optional<unsigned int> exitCode) noexcept = 0;
+
         virtual bool PushGraphicsRendition(const ::Microsoft::Console::VirtualTerminal::VTParameters options) noexcept = 0;
         virtual bool PopGraphicsRendition() noexcept = 0;
 
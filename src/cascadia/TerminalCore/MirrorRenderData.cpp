@@ -0,0 +1,234 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "pch.h"
+#include "MirrorRenderData.hpp"
+
+using namespace Microsoft::Terminal::Core;
+using namespace Microsoft::Console::Types;
+using namespace Microsoft::Console::Render;
+
+MirrorRenderData::MirrorRenderData(Terminal& terminal) noexcept :
+    _terminal{ terminal }
+{
+}
+
+Terminal& MirrorRenderData::GetTerminal() const noexcept
+{
+    return _terminal;
+}
+
+void MirrorRenderData::SetViewHeight(const int rows) noexcept
+{
+    _viewHeight = std::max(rows, 1);
+}
+
+void MirrorRenderData::SetFontInfo(const FontInfo& fontInfo)
+{
+    _fontInfo = fontInfo;
+}
+
+// Method Description:
+// - Sets the callback that's invoked whenever the mirrored buffer changed.
+//   It's invoked under the write lock of the mirrored Terminal.
+void MirrorRenderData::SetChangedCallback(std::function<void()> pfn) noexcept
+{
+    _pfnChanged.swap(pfn);
+}
+
+void MirrorRenderData::NotifyChanged() noexcept
+try
+{
+    if (_pfnChanged)
+    {
+        _pfnChanged();
+    }
+}
+CATCH_LOG()
+
+// Method Description:
+// - Returns the top row of the viewport, in rows of the mirrored buffer.
+//   A viewport that was scrolled up stays on the same rows until they scroll
+//   out of the buffer.
+int MirrorRenderData::ViewStartIndex() const noexcept
+{
+    const auto tailTop = _TailViewStartIndex();
+    if (!_scrolledTop)
+    {
+        return tailTop;
+    }
+
+    const auto top = *_scrolledTop - _terminal.GetTextBuffer().GetEvictedRowCount();
+    return gsl::narrow_cast<int>(std::clamp<ptrdiff_t>(top, 0, tailTop));
+}
+
+int MirrorRenderData::ViewHeight() const noexcept
+{
+    return std::min<int>(_viewHeight, _terminal.GetTextBuffer().GetSize().Height());
+}
+
+// Method Description:
+// - Scrolls the viewport so that the given row is at its top. Scrolling all
+//   the way down makes the viewport follow the output again.
+// Arguments:
+// - viewTop: the row of the mirrored buffer to scroll to
+void MirrorRenderData::UserScrollViewport(const int viewTop) noexcept
+{
+    if (viewTop >= _TailViewStartIndex())
+    {
+        _scrolledTop.reset();
+    }
+    else
+    {
+        _scrolledTop = std::max(viewTop, 0) + _terminal.GetTextBuffer().GetEvictedRowCount();
+    }
+}
+
+// Method Description:
+// - Scrolls the viewport to the prompt of the previous or next command the
+//   shell marked with OSC 133, like Terminal::ScrollToCommand.
+// Arguments:
+// - previous: true to go to the command above the current viewport
+// Return Value:
+// - true if there was a command to scroll to.
+bool MirrorRenderData::ScrollToCommand(const bool previous)
+{
+    const auto& buffer = _terminal.GetTextBuffer();
+    const auto top = ViewStartIndex();
+    const auto command = previous ? buffer.GetPreviousCommand(top) : buffer.GetNextCommand(top);
+    if (!command)
+    {
+        return false;
+    }
+
+    UserScrollViewport(gsl::narrow_cast<int>(command->promptStart.y()));
+    return true;
+}
+
+// The rows of the mirrored Terminal that end at the bottom of its mutable viewport.
+int MirrorRenderData::_TailViewStartIndex() const noexcept
+{
+    return std::max(0, _terminal.GetBufferHeight() - ViewHeight());
+}
+
+Viewport MirrorRenderData::GetViewport() noexcept
+{
+    const auto width = _terminal.GetTextBuffer().GetSize().Width();
+    return Viewport::FromDimensions({ 0, gsl::narrow_cast<short>(ViewStartIndex()) },
+                                    { width, gsl::narrow_cast<short>(ViewHeight()) });
+}
+
+COORD MirrorRenderData::GetTextBufferEndPosition() const noexcept
+{
+    return _terminal.GetTextBufferEndPosition();
+}
+
+const TextBuffer& MirrorRenderData::GetTextBuffer() noexcept
+{
+    return _terminal.GetTextBuffer();
+}
+
+const FontInfo& MirrorRenderData::GetFontInfo() noexcept
+{
+    return _fontInfo;
+}
+
+std::pair<COLORREF, COLORREF> MirrorRenderData::GetAttributeColors(const TextAttribute& attr) const noexcept
+{
+    return _terminal.GetAttributeColors(attr);
+}
+
+std::vector<Viewport> MirrorRenderData::GetSelectionRects() noexcept
+{
+    return {};
+}
+
+void MirrorRenderData::LockConsole() noexcept
+{
+    _terminal.LockConsole();
+}
+
+void MirrorRenderData::UnlockConsole() noexcept
+{
+    _terminal.UnlockConsole();
+}
+
+const TextAttribute MirrorRenderData::GetDefaultBrushColors() noexcept
+{
+    return _terminal.GetDefaultBrushColors();
+}
+
+COORD MirrorRenderData::GetCursorPosition() const noexcept
+{
+    return _terminal.GetCursorPosition();
+}
+
+bool MirrorRenderData::IsCursorVisible() const noexcept
+{
+    return _terminal.IsCursorVisible();
+}
+
+bool MirrorRenderData::IsCursorOn() const noexcept
+{
+    return _terminal.IsCursorOn();
+}
+
+ULONG MirrorRenderData::GetCursorHeight() const noexcept
+{
+    return _terminal.GetCursorHeight();
+}
+
+ULONG MirrorRenderData::GetCursorPixelWidth() const noexcept
+{
+    return _terminal.GetCursorPixelWidth();
+}
+
+CursorType MirrorRenderData::GetCursorStyle() const noexcept
+{
+    return _terminal.GetCursorStyle();
+}
+
+COLORREF MirrorRenderData::GetCursorColor() const noexcept
+{
+    return _terminal.GetCursorColor();
+}
+
+bool MirrorRenderData::IsCursorDoubleWidth() const
+{
+    return _terminal.IsCursorDoubleWidth();
+}
+
+bool MirrorRenderData::IsScreenReversed() const noexcept
+{
+    return _terminal.IsScreenReversed();
+}
+
+const std::vector<RenderOverlay> MirrorRenderData::GetOverlays() const noexcept
+{
+    return {};
+}
+
+const bool MirrorRenderData::IsGridLineDrawingAllowed() noexcept
+{
+    return _terminal.IsGridLineDrawingAllowed();
+}
+
+const std::wstring_view MirrorRenderData::GetConsoleTitle() const noexcept
+{
+    return _terminal.GetConsoleTitle();
+}
+
+const std::wstring MirrorRenderData::GetHyperlinkUri(uint16_t id) const noexcept
+{
+    return _terminal.GetHyperlinkUri(id);
+}
+
+const std::wstring MirrorRenderData::GetHyperlinkCustomId(uint16_t id) const noexcept
+{
+    return _terminal.GetHyperlinkCustomId(id);
+}
+
+const std::vector<size_t> MirrorRenderData::GetPatternId(const COORD) const noexcept
+{
+    return {};
+}
@@ -0,0 +1,83 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- MirrorRenderData.hpp
+
+Abstract:
+- The render data of a read-only mirror of a Terminal. A mirror paints the
+  buffer of the Terminal it mirrors, but with a viewport of its own, so that
+  the same output can be shown in two places without parsing it twice.
+- The viewport either follows the bottom of the Terminal's mutable viewport,
+  or stays at the row it was scrolled to, even while the buffer scrolls.
+- Selections, search results and patterns belong to the mirrored Terminal and
+  aren't shown. Everything else is forwarded to it.
+- Like the Terminal itself, this isn't thread-safe. Use it under the lock of
+  the mirrored Terminal.
+--*/
+
+#pragma once
+
+#include "Terminal.hpp"
+
+class Microsoft::Terminal::Core::MirrorRenderData final :
+    public Microsoft::Console::Render::IRenderData
+{
+public:
+    explicit MirrorRenderData(Terminal& terminal) noexcept;
+
+    Terminal& GetTerminal() const noexcept;
+
+    void SetViewHeight(const int rows) noexcept;
+    void SetFontInfo(const FontInfo& fontInfo);
+    void SetChangedCallback(std::function<void()> pfn) noexcept;
+    void NotifyChanged() noexcept;
+
+    int ViewStartIndex() const noexcept;
+    int ViewHeight() const noexcept;
+    void UserScrollViewport(const int viewTop) noexcept;
+    bool ScrollToCommand(const bool previous);
+
+#pragma region IBaseData
+    Microsoft::Console::Types::Viewport GetViewport() noexcept override;
+    COORD GetTextBufferEndPosition() const noexcept override;
+    const TextBuffer& GetTextBuffer() noexcept override;
+    const FontInfo& GetFontInfo() noexcept override;
+    std::pair<COLORREF, COLORREF> GetAttributeColors(const TextAttribute& attr) const noexcept override;
+    std::vector<Microsoft::Console::Types::Viewport> GetSelectionRects() noexcept override;
+
+    void LockConsole() noexcept override;
+    void UnlockConsole() noexcept override;
+#pragma endregion
+
+#pragma region IRenderData
+    const TextAttribute GetDefaultBrushColors() noexcept override;
+    COORD GetCursorPosition() const noexcept override;
+    bool IsCursorVisible() const noexcept override;
+    bool IsCursorOn() const noexcept override;
+    ULONG GetCursorHeight() const noexcept override;
+    ULONG GetCursorPixelWidth() const noexcept override;
+    CursorType GetCursorStyle() const noexcept override;
+    COLORREF GetCursorColor() const noexcept override;
+    bool IsCursorDoubleWidth() const override;
+    bool IsScreenReversed() const noexcept override;
+    const std::vector<Microsoft::Console::Render::RenderOverlay> GetOverlays() const noexcept override;
+    const bool IsGridLineDrawingAllowed() noexcept override;
+    const std::wstring_view GetConsoleTitle() const noexcept override;
+    const std::wstring GetHyperlinkUri(uint16_t id) const noexcept override;
+    const std::wstring GetHyperlinkCustomId(uint16_t id) const noexcept override;
+    const std::vector<size_t> GetPatternId(const COORD location) const noexcept override;
+#pragma endregion
+
+private:
+    int _TailViewStartIndex() const noexcept;
+
+    Terminal& _terminal;
+    FontInfo _fontInfo{ DEFAULT_FONT_FACE, TMPF_TRUETYPE, 10, { 0, DEFAULT_FONT_SIZE }, CP_UTF8, false };
+    int _viewHeight = 1;
+    // The absolute row (see TextBuffer::GetEvictedRowCount) at the top of the
+    // viewport, if it was scrolled up. Otherwise it follows the output.
+    std::optional<ptrdiff_t> _scrolledTop;
+    std::function<void()> _pfnChanged;
+};
@@ -5,13 +5,19 @@
 #include "Terminal.hpp"
 #include "../../terminal/parser/OutputStateMachineEngine.hpp"
 #include "TerminalDispatch.hpp"
+#include "MirrorRenderData.hpp"
 #include "../../inc/unicode.hpp"
 #include "../../inc/argb.h"
 #include "../../types/inc/utils.hpp"
 #include "../../types/inc/colorTable.hpp"
+#include "../../renderer/inc/DummyRenderTarget.hpp"
+#include "../../buffer/out/ScrollbackSpill.hpp"
 
 #include <winrt/Microsoft.Terminal.Core.h>
 
+#include <winmeta.h>
+#include <TraceLoggingProvider.h>
+
 using namespace winrt::Microsoft::Terminal::Core;
 using namespace Microsoft::Terminal::Core;
 using namespace Microsoft::Console;
@@ -21,6 +27,58 @@ using namespace Microsoft::Console::VirtualTerminal;
 
 using PointTree = interval_tree::IntervalTree<til::point, size_t>;
 
+#pragma warning(suppress : 26477) // We don't control tracelogging macros
+TRACELOGGING_DEFINE_PROVIDER(g_hTerminalCoreProvider,
+                             "Microsoft.Windows.Terminal.Core",
+                             // {ee233763-0ca2-5295-2e88-4d34b6c42630}
+                             (0xee233763, 0x0ca2, 0x5295, 0x2e, 0x88, 0x4d, 0x34, 0xb6, 0xc4, 0x26, 0x30), );
+
+// The provider is shared by all terminals in the process.
+static std::atomic<size_t> s_terminalCount{ 0 };
+
+static uint64_t _MicrosecondsSince(const std::chrono::steady_clock::time_point start) noexcept
+{
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return gsl::narrow_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+}
+
+// Acquires the terminal's lock and adds the time we waited for it to waitMicroseconds.
+// While we're being traced, the wait is bracketed with a "LockWait" region too.
+// See ConsolePerf.regions.xml.
+template<typename Lock>
+static Lock _AcquireLock(til::shared_ticket_lock& mutex, std::atomic<uint64_t>& waitMicroseconds, const char* const mode)
+{
+    const auto start = std::chrono::steady_clock::now();
+    const auto _ = wil::scope_exit([&]() noexcept {
+        waitMicroseconds.fetch_add(_MicrosecondsSince(start), std::memory_order_relaxed);
+    });
+
+    if (!TraceLoggingProviderEnabled(g_hTerminalCoreProvider, WINEVENT_LEVEL_VERBOSE, TIL_KEYWORD_TRACE))
+    {
+        return Lock{ mutex };
+    }
+
+#pragma warning(suppress : 26477 26485 26494 26482 26446 26447) // We don't control TraceLoggingWrite
+    TraceLoggingWrite(g_hTerminalCoreProvider,
+                      "LockWait",
+                      TraceLoggingString(mode, "Mode"),
+                      TraceLoggingOpcode(WINEVENT_OPCODE_START),
+                      TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+                      TraceLoggingKeyword(TIL_KEYWORD_TRACE));
+
+    Lock lock{ mutex };
+
+#pragma warning(suppress : 26477 26485 26494 26482 26446 26447) // We don't control TraceLoggingWrite
+    TraceLoggingWrite(g_hTerminalCoreProvider,
+                      "LockWait",
+                      TraceLoggingString(mode, "Mode"),
+                      TraceLoggingOpcode(WINEVENT_OPCODE_STOP),
+                      TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+                      TraceLoggingKeyword(TIL_KEYWORD_TRACE));
+
+    return lock;
+}
+
 static std::wstring _KeyEventsToText(std::deque<std::unique_ptr<IInputEvent>>& inEventsToWrite)
 {
     std::wstring wstr = L"";
@@ -72,6 +130,19 @@ Terminal::Terminal() :
     _terminalInput = std::make_unique<TerminalInput>(passAlongInput);
 
     _InitializeColorTable();
+
+    if (s_terminalCount.fetch_add(1) == 0)
+    {
+        TraceLoggingRegister(g_hTerminalCoreProvider);
+    }
+}
+
+Terminal::~Terminal()
+{
+    if (s_terminalCount.fetch_sub(1) == 1)
+    {
+        TraceLoggingUnregister(g_hTerminalCoreProvider);
+    }
 }
 
 void Terminal::Create(COORD viewportSize, SHORT scrollbackLines, IRenderTarget& renderTarget)
@@ -98,10 +169,91 @@ void Terminal::CreateFromSettings(ICoreSettings settings,
 
     // TODO:MSFT:20642297 - Support infinite scrollback here, if HistorySize is -1
     Create(viewportSize, Utils::ClampToShortMax(settings.HistorySize(), 0), renderTarget);
+    _CreateScrollbackSpill(settings.ScrollbackSpillDirectory());
 
     UpdateSettings(settings);
 }
 
+// Method Description:
+// - Sets the buffer up to spill the rows that scroll out of the history into
+//   a new file in the given directory, instead of discarding them. Every
+//   terminal gets its own file, named after the time it was created.
+//   If the file can't be created, rows are discarded as usual.
+// Arguments:
+// - directory: the directory to create the file in, with environment
+//   variables unexpanded. If it's empty, rows are discarded as usual.
+void Terminal::_CreateScrollbackSpill(const std::wstring_view directory) noexcept
+try
+{
+    if (directory.empty())
+    {
+        return;
+    }
+
+    static std::atomic<uint32_t> s_spillCount{ 0 };
+
+    const auto expanded = wil::ExpandEnvironmentStringsW<std::wstring>(std::wstring{ directory }.c_str());
+    std::filesystem::create_directories(expanded);
+
+    SYSTEMTIME now{};
+    GetLocalTime(&now);
+    const auto name = fmt::format(L"scrollback-{:04}{:02}{:02}-{:02}{:02}{:02}-{}-{}.wtspill",
+                                  now.wYear,
+                                  now.wMonth,
+                                  now.wDay,
+                                  now.wHour,
+                                  now.wMinute,
+                                  now.wSecond,
+                                  GetCurrentProcessId(),
+                                  s_spillCount.fetch_add(1, std::memory_order_relaxed));
+
+    _buffer->SetScrollbackSpill(std::make_shared<ScrollbackSpill>((std::filesystem::path{ expanded } / name).wstring()));
+}
+CATCH_LOG()
+
+// Method Description:
+// - Initializes the Terminal without a renderer. Paint invalidations are
+//   discarded, so no render engines or windows are ever needed. This is
+//   meant for running recorded output through the terminal, to inspect
+//   the results with TakeSnapshot.
+// Arguments:
+// - viewportSize: the size of the viewport, in characters
+// - scrollbackLines: the number of lines of scrollback to keep
+void Terminal::CreateHeadless(COORD viewportSize, SHORT scrollbackLines)
+{
+    _headlessRenderTarget = std::make_unique<DummyRenderTarget>();
+    Create(viewportSize, scrollbackLines, *_headlessRenderTarget);
+}
+
+// Method Description:
+// - Copies the text, attributes and cursor state of the mutable viewport.
+// Return Value:
+// - The copied state. It stays valid while the terminal keeps processing output.
+Terminal::Snapshot Terminal::TakeSnapshot()
+{
+    auto lock = LockForReading();
+
+    const auto viewport = _GetMutableViewport();
+
+    Snapshot snapshot;
+    snapshot.text.reserve(viewport.Height());
+    snapshot.attributes.reserve(viewport.Height());
+    for (auto y = viewport.Top(); y < viewport.BottomExclusive(); ++y)
+    {
+        const auto& row = _buffer->GetRowByOffset(y);
+        snapshot.text.emplace_back(row.GetText());
+        const auto& attrRow = row.GetAttrRow();
+        snapshot.attributes.emplace_back(attrRow.begin(), attrRow.end());
+    }
+
+    const auto& cursor = _buffer->GetCursor();
+    snapshot.cursorPosition = cursor.GetPosition();
+    viewport.ConvertToOrigin(&snapshot.cursorPosition);
+    snapshot.cursorVisible = cursor.IsVisible();
+
+    return snapshot;
+}
+
 // Method Description:
 // - Update our internal properties to match the new values in the provided
 //   CoreSettings object.
@@ -148,11 +300,12 @@ void Terminal::UpdateSettings(ICoreSettings settings)
     {
         // Clear the patterns first
         _buffer->ClearPatternRecognizers();
+        _patternRowGenerations.clear();
         if (settings.DetectURLs())
         {
             // Add regex pattern recognizers to the buffer
             // For now, we only add the URI regex pattern
-            _hyperlinkPatternId = _buffer->AddPatternRecognizer(linkPattern);
+            _hyperlinkPatternId = _buffer->AddPatternRecognizer(linkPattern, linkPatternLiteral);
             UpdatePatternsUnderLock();
         }
         else
@@ -267,6 +420,9 @@ void Terminal::UpdateAppearance(const ICoreAppearance& appearance)
 
         newTextBuffer->GetCursor().StartDeferDrawing();
 
+        // Rows that don't fit into the new buffer are spilled, too.
+        newTextBuffer->SetScrollbackSpill(_buffer->GetScrollbackSpill());
+
         // Build a PositionInformation to track the position of both the top of
         // the mutable viewport and the top of the visible viewport in the new
         // buffer.
@@ -417,6 +573,7 @@ void Terminal::UpdateAppearance(const ICoreAppearance& appearance)
     }
     CATCH_LOG();
     _NotifyScrollEvent();
+    _NotifyMirrors();
 
     return S_OK;
 }
@@ -425,7 +582,12 @@ void Terminal::Write(std::wstring_view stringView)
 {
     auto lock = LockForWriting();
 
+    const auto start = std::chrono::steady_clock::now();
     _stateMachine->ProcessString(stringView);
+    _NotifyMirrors();
+
+    _parseMicroseconds.fetch_add(_MicrosecondsSince(start), std::memory_order_relaxed);
+    _parsedChars.fetch_add(stringView.size(), std::memory_order_relaxed);
 }
 
 void Terminal::WritePastedText(std::wstring_view stringView)
@@ -475,6 +637,29 @@ bool Terminal::IsTrackingMouseInput() const noexcept
     return _terminalInput->IsTrackingMouseInput();
 }
 
+// Routine Description:
+// - Makes the terminal hold back mouse motion reports until FlushMouseMotion
+//   is called, so that only the latest one is sent. See TerminalInput.
+// Parameters:
+// - enable - either enable or disable.
+// Return value:
+// - <none>
+void Terminal::EnableMouseMotionCoalescing(const bool enable) noexcept
+{
+    _terminalInput->EnableMouseMotionCoalescing(enable);
+}
+
+// Routine Description:
+// - Sends the mouse motion report that was held back, if there is one.
+// Parameters:
+// - <none>
+// Return value:
+// - true, if a motion report was sent.
+bool Terminal::FlushMouseMotion()
+{
+    return _terminalInput->FlushMouseMotion();
+}
+
 // Method Description:
 // - Given a coord, get the URI at that location
 // Arguments:
@@ -702,6 +887,37 @@ void Terminal::_InvalidatePatternTree(interval_tree::IntervalTree<til::point, si
     tree.visit_all(invalidate);
 }
 
+// Method Description:
+// - Moves the patterns along with the contents of the viewport when the user
+//   scrolls it, since they're relative to the viewport. The renderer moves
+//   the already painted text the same way, so unlike ClearPatternTree this
+//   doesn't invalidate anything. Patterns that scrolled out of the viewport,
+//   even partially, are dropped. The next UpdatePatternsUnderLock rescans
+//   the viewport and finds the ones that scrolled into it.
+// Arguments:
+// - rows: how many rows the contents of the viewport moved down (negative for up)
+void Terminal::_ScrollPatternTree(const int rows)
+{
+    if (rows == 0 || (_patternIntervalTree.empty() && _patternRowGenerations.empty()))
+    {
+        return;
+    }
+
+    const ptrdiff_t height = _mutableViewport.Height();
+    PointTree::interval_vector intervals;
+    _patternIntervalTree.visit_all([&](const PointTree::interval& interval) {
+        const til::point start{ interval.start.x(), interval.start.y() + rows };
+        const til::point stop{ interval.stop.x(), interval.stop.y() + rows };
+        // A pattern that ends with the last row has its stop at the start of the row below.
+        if (start.y() >= 0 && (stop.y() < height || (stop.y() == height && stop.x() == 0)))
+        {
+            intervals.emplace_back(start, stop, interval.value);
+        }
+    });
+    _patternIntervalTree = PointTree{ std::move(intervals) };
+    _patternRowGenerations.clear();
+}
+
 // Method Description:
 // - Given start and end coords, invalidates all the regions between them
 // Arguments:
@@ -844,12 +1060,14 @@ WORD Terminal::_TakeVirtualKeyFromLastKeyEvent(const WORD scanCode) noexcept
 
 // Method Description:
 // - Acquire a read lock on the terminal.
+// - Any number of readers may hold this lock at once, so callers must not
+//      modify any state of the terminal while holding it.
 // Return Value:
 // - a shared_lock which can be used to unlock the terminal. The shared_lock
 //      will release this lock when it's destructed.
-[[nodiscard]] std::unique_lock<til::ticket_lock> Terminal::LockForReading()
+[[nodiscard]] std::shared_lock<til::shared_ticket_lock> Terminal::LockForReading()
 {
-    return std::unique_lock{ _readWriteLock };
+    return _AcquireLock<std::shared_lock<til::shared_ticket_lock>>(_readWriteLock, _lockWaitMicroseconds, "Read");
 }
 
 // Method Description:
@@ -857,9 +1075,36 @@ WORD Terminal::_TakeVirtualKeyFromLastKeyEvent(const WORD scanCode) noexcept
 // Return Value:
 // - a unique_lock which can be used to unlock the terminal. The unique_lock
 //      will release this lock when it's destructed.
-[[nodiscard]] std::unique_lock<til::ticket_lock> Terminal::LockForWriting()
+[[nodiscard]] std::unique_lock<til::shared_ticket_lock> Terminal::LockForWriting()
+{
+    return _AcquireLock<std::unique_lock<til::shared_ticket_lock>>(_readWriteLock, _lockWaitMicroseconds, "Write");
+}
+
+// Method Description:
+// - Returns the lifetime totals of how much text was parsed, how long that
+//   took and how long callers waited for the terminal's lock. The values are
+//   read without any synchronization and are only meant for diagnostics.
+// Return Value:
+// - the current counter values
+Terminal::PerformanceCounters Terminal::GetPerformanceCounters() const noexcept
+{
+    PerformanceCounters counters;
+    counters.parsedChars = _parsedChars.load(std::memory_order_relaxed);
+    counters.parseMicroseconds = _parseMicroseconds.load(std::memory_order_relaxed);
+    counters.lockWaitMicroseconds = _lockWaitMicroseconds.load(std::memory_order_relaxed);
+    return counters;
+}
+
+// Method Description:
+// - Estimates how many bytes the interval tree of the visible pattern matches
+//   (hyperlinks detected by regex) holds on to. The caller must hold the lock.
+// Return Value:
+// - the number of bytes
+size_t Terminal::GetPatternTreeMemoryUsage() const
 {
-    return std::unique_lock{ _readWriteLock };
+    size_t intervals = 0;
+    _patternIntervalTree.visit_all([&](const auto&) { ++intervals; });
+    return intervals * sizeof(interval_tree::Interval<til::point, size_t>);
 }
 
 Viewport Terminal::_GetMutableViewport() const noexcept
@@ -901,70 +1146,88 @@ Viewport Terminal::_GetVisibleViewport() const noexcept
                                     _mutableViewport.Dimensions());
 }
 
-// Writes a string of text to the buffer, then moves the cursor (and viewport)
-//      in accordance with the written text.
-// This method is our proverbial `WriteCharsLegacy`, and great care should be made to
-//      keep it minimal and orderly, lest it become WriteCharsLegacy2ElectricBoogaloo
-// TODO: MSFT 21006766
-//       This needs to become stream logic on the buffer itself sooner rather than later
-//       because it's otherwise impossible to avoid the Electric Boogaloo-ness here.
-//       I had to make a bunch of hacks to get Japanese and emoji to work-ish.
+// Method Description:
+// - Writes a run of printable text to the buffer at the cursor, like a stream.
+//   As much of the text as fits onto the cursor's row is written in one go and
+//   the cursor is moved once per row, not once per character. Printable ASCII
+//   is copied straight into the row, anything else goes through a
+//   TextCellIterator. Once a row is full, the next one is started (scrolling
+//   or cycling the buffer as needed) before any more text is written to it.
+// - This method is our proverbial `WriteCharsLegacy`, and great care should be
+//   made to keep it minimal and orderly, lest it become WriteCharsLegacy2ElectricBoogaloo.
+// Arguments:
+// - stringView - the text to write. It must not contain control characters.
+// Return Value:
+// - <none>
 void Terminal::_WriteBuffer(const std::wstring_view& stringView)
 {
     auto& cursor = _buffer->GetCursor();
+    const auto attributes = _buffer->GetCurrentAttributes();
+    const auto bufferWidth = _buffer->GetSize().Width();
 
     // Defer the cursor drawing while we are iterating the string, for a better performance.
     // We can not waste time displaying a cursor event when we know more text is coming right behind it.
     cursor.StartDeferDrawing();
 
-    for (size_t i = 0; i < stringView.size(); i++)
+    size_t i = 0;
+    while (i < stringView.size())
     {
-        const auto wch = stringView.at(i);
-        const COORD cursorPosBefore = cursor.GetPosition();
-        COORD proposedCursorPosition = cursorPosBefore;
-
-        // TODO: MSFT 21006766
-        // This is not great but I need it demoable. Fix by making a buffer stream writer.
-        //
-        // If wch is a surrogate character we need to read 2 code units
-        // from the stringView to form a single code point.
-        const auto isSurrogate = wch >= 0xD800 && wch <= 0xDFFF;
-        const auto view = stringView.substr(i, isSurrogate ? 2 : 1);
-        const OutputCellIterator it{ view, _buffer->GetCurrentAttributes() };
-        const auto end = _buffer->Write(it);
-        const auto cellDistance = end.GetCellDistance(it);
-        const auto inputDistance = end.GetInputDistance(it);
-
-        if (inputDistance > 0)
+        auto proposedCursorPosition = cursor.GetPosition();
+
+        // The previous segment filled up the row, so there's more text than
+        // fits onto it. Start writing to the next row, as if "\r\n" had been
+        // encountered.
+        // TODO: GH#780 - This should really be a _deferred_ newline. If
+        // the next character to come in is a newline or a cursor
+        // movement or anything, then we should _not_ wrap this line
+        // here.
+        if (proposedCursorPosition.X >= bufferWidth)
         {
-            // If "wch" was a surrogate character, we just consumed 2 code units above.
-            // -> Increment "i" by 1 in that case and thus by 2 in total in this iteration.
-            proposedCursorPosition.X += gsl::narrow<SHORT>(cellDistance);
-            i += inputDistance - 1;
-        }
-        else
-        {
-            // If _WriteBuffer() is called with a consecutive string longer than the viewport/buffer width
-            // the call to _buffer->Write() will refuse to write anything on the current line.
-            // GetInputDistance() thus returns 0, which would in turn cause i to be
-            // decremented by 1 below and force the outer loop to loop forever.
-            // This if() basically behaves as if "\r\n" had been encountered above and retries the write.
-            // With well behaving shells during normal operation this safeguard should normally not be encountered.
             proposedCursorPosition.X = 0;
             proposedCursorPosition.Y++;
+            _AdjustCursorPosition(proposedCursorPosition);
+            proposedCursorPosition = cursor.GetPosition();
+        }
 
-            // Try the character again.
-            i--;
+        const auto remaining = stringView.substr(i);
 
-            // If we write the last cell of the row here, TextBuffer::Write will
-            // mark this line as wrapped for us. If the next character we
-            // process is a newline, the Terminal::CursorLineFeed will unmark
-            // this line as wrapped.
+        // Most output is plain ASCII text, which can be copied into the row as is.
+        auto consumed = _buffer->WriteNarrowText(remaining, attributes, proposedCursorPosition);
+        auto cells = consumed;
+
+        if (!consumed)
+        {
+            // Everything else needs to be measured cell by cell. That's only
+            // done up to the next printable ASCII character though, which
+            // the next segment then writes the fast way again.
+            const auto end = std::find_if(remaining.begin(), remaining.end(), [](const auto wch) noexcept {
+                return wch >= L' ' && wch <= L'~';
+            });
+            const auto run = remaining.substr(0, gsl::narrow_cast<size_t>(end - remaining.begin()));
+            const TextCellIterator it{ run, attributes };
+            const auto itEnd = _buffer->WriteTextLine(it, proposedCursorPosition);
+            consumed = itEnd.GetInputDistance(it);
+            cells = itEnd.GetCellDistance(it);
+        }
 
-            // TODO: GH#780 - This should really be a _deferred_ newline. If
-            // the next character to come in is a newline or a cursor
-            // movement or anything, then we should _not_ wrap this line
-            // here.
+        if (consumed)
+        {
+            proposedCursorPosition.X += gsl::narrow<SHORT>(cells);
+            i += consumed;
+        }
+        else if (proposedCursorPosition.X == 0)
+        {
+            // Not even an empty row fits it (a wide glyph in a single column
+            // buffer). Drop it, or we'd keep trying forever.
+            const auto wch = remaining.front();
+            i += wch >= 0xD800 && wch <= 0xDBFF && remaining.size() > 1 ? 2 : 1;
+        }
+        else
+        {
+            // Nothing fit onto the rest of the row, for instance a wide glyph
+            // in its last column. WriteLine padded the row out for us and the
+            // glyph is written to the next one instead.
+            proposedCursorPosition.X = bufferWidth;
         }
 
         _AdjustCursorPosition(proposedCursorPosition);
@@ -1020,6 +1283,7 @@ void Terminal::_AdjustCursorPosition(const COORD proposedPosition)
 
         // manually erase our pattern intervals since the locations have changed now
         _patternIntervalTree = {};
+        _patternRowGenerations.clear();
     }
 
     // Update Cursor Position
@@ -1094,7 +1358,9 @@ void Terminal::UserScrollViewport(const int viewTop)
     const auto newDelta = realTop - clampedNewTop;
     // if viewTop > realTop, we want the offset to be 0.
 
+    const auto oldVisibleTop = _VisibleStartIndex();
     _scrollOffset = std::max(0, newDelta);
+    _ScrollPatternTree(oldVisibleTop - _VisibleStartIndex());
 
     // We can use the void variant of TriggerScroll here because
     // we adjusted the viewport so it can detect the difference
@@ -1102,6 +1368,143 @@ void Terminal::UserScrollViewport(const int viewTop)
     _buffer->GetRenderTarget().TriggerScroll();
 }
 
+// Method Description:
+// - Scrolls the viewport to the previous or next prompt the shell marked,
+//   relative to the top of the viewport. This is a binary search through
+//   the buffer's CommandTimeline, however much output there is in between.
+// Arguments:
+// - previous: true to go to the prompt above the top of the viewport,
+//   false to go to the one below it
+// Return Value:
+// - true if there was a prompt to go to
+bool Terminal::ScrollToCommand(const bool previous)
+{
+    const auto top = _VisibleStartIndex();
+    const auto command = previous ? _buffer->GetPreviousCommand(top) : _buffer->GetNextCommand(top);
+    if (!command)
+    {
+        return false;
+    }
+
+    // A prompt in the mutable viewport can't be scrolled further up than that.
+    _scrollOffset = std::max(0, ViewStartIndex() - gsl::narrow<int>(command->promptStart.y()));
+    _buffer->GetRenderTarget().TriggerScroll();
+    _NotifyScrollEvent();
+    return true;
+}
+
+// Method Description:
+// - Selects the output of the command at the top of the viewport, or of the
+//   one before it if that command didn't produce any output (yet).
+//   The output of a command that's still running ends at the cursor.
+// Arguments:
+// - <none>
+// Return Value:
+// - true if there was any output to select
+bool Terminal::SelectCommandOutput()
+{
+    auto command = _buffer->GetCommandAt(_VisibleStartIndex());
+    if (command && !command->outputStart)
+    {
+        command = _buffer->GetPreviousCommand(command->promptStart.y());
+    }
+    if (!command || !command->outputStart)
+    {
+        return false;
+    }
+
+    til::point end;
+    if (command->outputEnd)
+    {
+        end = *command->outputEnd;
+    }
+    else if (const auto next = _buffer->GetNextCommand(command->promptStart.y()))
+    {
+        end = next->promptStart;
+    }
+    else
+    {
+        end = til::point{ _buffer->GetCursor().GetPosition() };
+    }
+
+    // The end is exclusive, but the selection's end isn't.
+    const auto start = *command->outputStart;
+    const auto lastColumn = _buffer->GetSize().RightInclusive();
+    const auto inclusiveEnd = end.x() > 0 ? til::point{ end.x() - 1, end.y() } : til::point{ lastColumn, end.y() - 1 };
+    if (inclusiveEnd < start)
+    {
+        return false;
+    }
+
+    SetBlockSelection(false);
+    SelectNewRegion(start, inclusiveEnd);
+    return true;
+}
+
+// Method Description:
+// - Draws an overview of the buffer, down to the bottom of the mutable
+//   viewport, for the minimap next to the scroll bar. The rows are split into
+//   the given number of buckets and each bucket gets the color of the text
+//   that dominates its rows (see ScrollbackOverview). The more of the rows
+//   the text fills, the more opaque the color is.
+// - Buckets with a part of the selection (which is also how search results
+//   are highlighted) are drawn in the selection color instead, and the
+//   prompts that the shell marked with OSC 133 in the default foreground
+//   color, or bright red if their command failed.
+// - Only the rows that changed since the last call are looked at again.
+// Arguments:
+// - buckets: the number of colors to return, usually one per pixel row of the minimap.
+// - selectionColor: the color to draw the selection in.
+// Return Value:
+// - one color per bucket, from the oldest rows to the newest
+std::vector<til::color> Terminal::GetScrollbackOverview(const size_t buckets, const til::color selectionColor)
+{
+    const auto rowCount = gsl::narrow_cast<size_t>(_mutableViewport.BottomExclusive());
+    if (buckets == 0 || rowCount == 0)
+    {
+        return {};
+    }
+
+    _scrollbackOverview.Update(*_buffer);
+    const auto summaries = _scrollbackOverview.Downsample(rowCount, buckets);
+    const auto width = gsl::narrow_cast<size_t>(_buffer->GetSize().Width());
+
+    std::vector<til::color> colors;
+    colors.reserve(summaries.size());
+    for (const auto& summary : summaries)
+    {
+        const auto& attr = summary.attr;
+        const auto [fg, bg] = attr.CalculateRgbColors(_colorTable, _defaultFg, _defaultBg, _screenReversed, false, _intenseIsBright);
+
+        // Text on a background of its own is shown in the background color,
+        // which usually fills the whole row, whether there's text or not.
+        const auto hasBackground = !attr.BackgroundIsDefault() || attr.IsReverseVideo();
+        const auto filled = hasBackground ? width : std::min<size_t>(summary.textLength, width);
+        const auto alpha = filled ? gsl::narrow_cast<uint8_t>(96 + 159 * filled / width) : uint8_t{ 0 };
+        colors.emplace_back(til::color{ hasBackground ? bg : fg }.with_alpha(alpha));
+    }
+
+    const auto bucketOf = [&](const ptrdiff_t row) noexcept {
+        return std::min(gsl::narrow_cast<size_t>(std::max<ptrdiff_t>(row, 0)) * summaries.size() / rowCount, summaries.size() - 1);
+    };
+
+    if (IsSelectionActive())
+    {
+        const auto first = bucketOf(_selection->start.Y);
+        const auto last = bucketOf(_selection->end.Y);
+        std::fill(colors.begin() + first, colors.begin() + last + 1, selectionColor);
+    }
+
+    const til::color failedColor{ _colorTable.at(9) };
+    for (auto command = _buffer->GetNextCommand(-1); command; command = _buffer->GetNextCommand(command->promptStart.y()))
+    {
+        const auto failed = command->exitCode.value_or(0) != 0;
+        til::at(colors, bucketOf(command->promptStart.y())) = (failed ? failedColor : _defaultFg).with_alpha(255);
+    }
+
+    return colors;
+}
+
 int Terminal::GetScrollOffset() noexcept
 {
     return _VisibleStartIndex();
@@ -1121,6 +1524,29 @@ try
 }
 CATCH_LOG()
 
+void Terminal::AddMirror(MirrorRenderData& mirror)
+{
+    _mirrors.emplace_back(&mirror);
+}
+
+void Terminal::RemoveMirror(MirrorRenderData& mirror) noexcept
+{
+    _mirrors.erase(std::remove(_mirrors.begin(), _mirrors.end(), &mirror), _mirrors.end());
+}
+
+// Method Description:
+// - Tells the mirrors that the buffer changed, so that they can repaint.
+//   Mirrors don't know what changed, which is why they simply repaint their
+//   whole view. Their renderers only paint once per frame though, no matter
+//   how often they're notified.
+void Terminal::_NotifyMirrors() noexcept
+{
+    for (const auto mirror : _mirrors)
+    {
+        mirror->NotifyChanged();
+    }
+}
+
 void Terminal::_NotifyTerminalCursorPositionChanged() noexcept
 {
     if (_pfnCursorPositionChanged)
@@ -1227,20 +1653,128 @@ bool Terminal::IsCursorBlinkingAllowed() const noexcept
 // - INVARIANT: this function can only be called if the caller has the writing lock on the terminal
 void Terminal::UpdatePatternsUnderLock() noexcept
 {
+    const auto firstRow = _VisibleStartIndex();
+    const auto lastRow = _VisibleEndIndex();
+
+    // Rows get a new generation whenever their contents change. If every visible
+    // row still has the generation it had during the last update, the patterns
+    // in the viewport are exactly the ones we already have, so skip the rescan.
+    std::vector<uint64_t> generations;
+    generations.reserve(gsl::narrow_cast<size_t>(lastRow - firstRow + 1));
+    for (auto row = firstRow; row <= lastRow; ++row)
+    {
+        generations.push_back(_buffer->GetRowByOffset(row).GetGeneration());
+    }
+    if (generations == _patternRowGenerations)
+    {
+        return;
+    }
+
     auto oldTree = _patternIntervalTree;
-    _patternIntervalTree = _buffer->GetPatterns(_VisibleStartIndex(), _VisibleEndIndex());
+    _patternIntervalTree = _buffer->GetPatterns(firstRow, lastRow);
+    _patternRowGenerations = std::move(generations);
     _InvalidatePatternTree(oldTree);
     _InvalidatePatternTree(_patternIntervalTree);
 }
 
+// Method Description:
+// - Copies the hyperlinks and the patterns in the viewport, so that they can
+//   be looked up without holding the lock. The caller must hold the lock and
+//   should call UpdatePatternsUnderLock first, so the patterns are current.
+// Arguments:
+// - <none>
+// Return Value:
+// - the snapshot
+std::shared_ptr<const Terminal::HyperlinkSnapshot> Terminal::GetHyperlinkSnapshot() const
+{
+    auto snapshot = std::make_shared<HyperlinkSnapshot>();
+    snapshot->patterns = _patternIntervalTree;
+    snapshot->hyperlinkPatternId = _hyperlinkPatternId;
+
+    const auto firstRow = _VisibleStartIndex();
+    const auto lastRow = _VisibleEndIndex();
+    for (auto row = firstRow; row <= lastRow; ++row)
+    {
+        ptrdiff_t column = 0;
+        for (const auto& attr : _buffer->GetRowByOffset(row).GetAttrRow())
+        {
+            const auto id = attr.GetHyperlinkId();
+            auto& hyperlinks = snapshot->hyperlinks;
+            if (id != 0)
+            {
+                const til::point start{ column, row - firstRow };
+                if (!hyperlinks.empty() && hyperlinks.back().id == id && hyperlinks.back().start.y() == start.y() &&
+                    hyperlinks.back().start.x() + hyperlinks.back().length == column)
+                {
+                    ++hyperlinks.back().length;
+                }
+                else
+                {
+                    hyperlinks.push_back({ start, 1, id });
+                }
+            }
+            ++column;
+        }
+    }
+
+    return snapshot;
+}
+
+// Method Description:
+// - Gets the hyperlink ID of the text at the given position, like
+//   Terminal::GetHyperlinkIdAtPosition.
+// Arguments:
+// - The position of the text, relative to the viewport
+// Return value:
+// - The hyperlink ID, or 0 if there's no hyperlink
+uint16_t Terminal::HyperlinkSnapshot::GetHyperlinkIdAtPosition(const til::point position) const noexcept
+{
+    const auto it = std::lower_bound(hyperlinks.begin(), hyperlinks.end(), position, [](const Run& run, const til::point& pos) {
+        const auto end = run.start.x() + run.length;
+        return run.start.y() < pos.y() || (run.start.y() == pos.y() && end <= pos.x());
+    });
+    if (it != hyperlinks.end() && it->start.y() == position.y() && it->start.x() <= position.x())
+    {
+        return it->id;
+    }
+    return 0;
+}
+
+// Method description:
+// - Given a position in a URI pattern, gets the start and end coordinates of
+//   the URI, like Terminal::GetHyperlinkIntervalFromPosition.
+// Arguments:
+// - The position, relative to the viewport
+// Return value:
+// - The interval representing the start and end coordinates
+std::optional<PointTree::interval> Terminal::HyperlinkSnapshot::GetHyperlinkIntervalFromPosition(const til::point position) const
+{
+    const auto results = patterns.findOverlapping(til::point{ position.x() + 1, position.y() }, position);
+    for (const auto& result : results)
+    {
+        if (result.value == hyperlinkPatternId)
+        {
+            return result;
+        }
+    }
+    return std::nullopt;
+}
+
 // Method Description:
 // - Clears and invalidates the interval pattern tree
 // - This is called to prevent the renderer from rendering patterns while the
 //   visible region is changing
 void Terminal::ClearPatternTree() noexcept
 {
-    auto oldTree = _patternIntervalTree;
-    _patternIntervalTree = {};
+    // This is called for every line that's scrolled in during output,
+    // so don't bother with a tree that's already been cleared.
+    if (_patternIntervalTree.empty() && _patternRowGenerations.empty())
+    {
+        return;
+    }
+
+    auto oldTree = std::exchange(_patternIntervalTree, {});
+    _patternRowGenerations.clear();
     _InvalidatePatternTree(oldTree);
 }
 
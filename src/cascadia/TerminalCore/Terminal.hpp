@@ -7,6 +7,7 @@
 
 #include "../../inc/DefaultSettings.h"
 #include "../../buffer/out/textBuffer.hpp"
+#include "../../buffer/out/ScrollbackOverview.hpp"
 #include "../../types/inc/sgrStack.hpp"
 #include "../../renderer/inc/BlinkingState.hpp"
 #include "../../terminal/parser/StateMachine.hpp"
@@ -21,6 +22,8 @@
 #include <til/ticket_lock.h>
 
 static constexpr std::wstring_view linkPattern{ LR"(\b(https?|ftp|file)://[-A-Za-z0-9+&@#/%?=~_|$!:,.;]*[A-Za-z0-9+&@#/%=~_|$])" };
+// Every match of linkPattern contains this, which lets us skip the regex on text without links.
+static constexpr std::wstring_view linkPatternLiteral{ L"://" };
 static constexpr size_t TaskbarMinProgress{ 10 };
 
 // You have to forward decl the ICoreSettings here, instead of including the header.
@@ -35,6 +38,7 @@ namespace winrt::Microsoft::Terminal::Core
 namespace Microsoft::Terminal::Core
 {
     class Terminal;
+    class MirrorRenderData;
 }
 
 // fwdecl unittest classes
@@ -56,7 +60,7 @@ class Microsoft::Terminal::Core::Terminal final :
 {
 public:
     Terminal();
-    ~Terminal(){};
+    ~Terminal();
     Terminal(const Terminal&) = default;
     Terminal(Terminal&&) = default;
     Terminal& operator=(const Terminal&) = default;
@@ -69,6 +73,23 @@ public:
     void CreateFromSettings(winrt::Microsoft::Terminal::Core::ICoreSettings settings,
                             Microsoft::Console::Render::IRenderTarget& renderTarget);
 
+    // CreateHeadless sets up a Terminal that isn't connected to any renderer.
+    // Output can be written into it and its state inspected with TakeSnapshot.
+    void CreateHeadless(COORD viewportSize, SHORT scrollbackLines);
+
+    struct Snapshot
+    {
+        // The text of each row of the mutable viewport.
+        std::vector<std::wstring> text;
+        // The attributes of each cell of the mutable viewport, row by row.
+        std::vector<std::vector<TextAttribute>> attributes;
+        // The cursor position, relative to the mutable viewport.
+        COORD cursorPosition;
+        bool cursorVisible;
+    };
+
+    Snapshot TakeSnapshot();
+
     void UpdateSettings(winrt::Microsoft::Terminal::Core::ICoreSettings settings);
     void UpdateAppearance(const winrt::Microsoft::Terminal::Core::ICoreAppearance& appearance);
     void SetFontInfo(const FontInfo& fontInfo);
@@ -79,14 +100,36 @@ public:
     // WritePastedText goes directly to the connection
     void WritePastedText(std::wstring_view stringView);
 
-    [[nodiscard]] std::unique_lock<til::ticket_lock> LockForReading();
-    [[nodiscard]] std::unique_lock<til::ticket_lock> LockForWriting();
+    [[nodiscard]] std::shared_lock<til::shared_ticket_lock> LockForReading();
+    [[nodiscard]] std::unique_lock<til::shared_ticket_lock> LockForWriting();
+
+    // Running totals since the terminal was created, for the performance overlay.
+    struct PerformanceCounters
+    {
+        uint64_t parsedChars = 0;
+        uint64_t parseMicroseconds = 0;
+        uint64_t lockWaitMicroseconds = 0;
+    };
+    PerformanceCounters GetPerformanceCounters() const noexcept;
+    size_t GetPatternTreeMemoryUsage() const;
 
     short GetBufferHeight() const noexcept;
 
     int ViewStartIndex() const noexcept;
     int ViewEndIndex() const noexcept;
 
+    // These navigate the commands the shell marked with OSC 133. The caller must hold the write lock.
+    bool ScrollToCommand(const bool previous);
+    bool SelectCommandOutput();
+
+    // The caller must hold the write lock, as this updates the summaries of the rows.
+    std::vector<til::color> GetScrollbackOverview(const size_t buckets, const til::color selectionColor);
+
+    // Mirrors render this terminal's buffer with a viewport of their own (see MirrorRenderData)
+    // and are notified whenever the buffer changed. The caller must hold the write lock.
+    void AddMirror(MirrorRenderData& mirror);
+    void RemoveMirror(MirrorRenderData& mirror) noexcept;
+
 #pragma region ITerminalApi
     // These methods are defined in TerminalApi.cpp
     bool PrintString(std::wstring_view stringView) noexcept override;
@@ -136,6 +179,8 @@ public:
     bool SetWorkingDirectory(std::wstring_view uri) noexcept override;
     std::wstring_view GetWorkingDirectory() noexcept override;
 
+    bool AddCommandMark(const ::CommandTimeline::MarkKind kind, const std::optional<unsigned int> exitCode) noexcept override;
+
     bool PushGraphicsRendition(const ::Microsoft::Console::VirtualTerminal::VTParameters options) noexcept override;
     bool PopGraphicsRendition() noexcept override;
 
@@ -153,6 +198,8 @@ public:
 
     void TrySnapOnInput() override;
     bool IsTrackingMouseInput() const noexcept;
+    void EnableMouseMotionCoalescing(const bool enable) noexcept;
+    bool FlushMouseMotion();
 
     std::wstring GetHyperlinkAtPosition(const COORD position);
     uint16_t GetHyperlinkIdAtPosition(const COORD position);
@@ -217,6 +264,27 @@ public:
     void UpdatePatternsUnderLock() noexcept;
     void ClearPatternTree() noexcept;
 
+    // A copy of the hyperlinks and patterns in the viewport, so that the
+    // hovered cell can be hit-tested without holding the lock.
+    // Positions are relative to the viewport, like the pattern tree's.
+    struct HyperlinkSnapshot
+    {
+        struct Run
+        {
+            til::point start;
+            ptrdiff_t length = 0;
+            uint16_t id = 0;
+        };
+        // Sorted by row, then by column.
+        std::vector<Run> hyperlinks;
+        interval_tree::IntervalTree<til::point, size_t> patterns;
+        size_t hyperlinkPatternId = 0;
+
+        uint16_t GetHyperlinkIdAtPosition(const til::point position) const noexcept;
+        std::optional<interval_tree::IntervalTree<til::point, size_t>::interval> GetHyperlinkIntervalFromPosition(const til::point position) const;
+    };
+    std::shared_ptr<const HyperlinkSnapshot> GetHyperlinkSnapshot() const;
+
     const std::optional<til::color> GetTabColor() const noexcept;
     til::color GetDefaultBackground() const noexcept;
 
@@ -253,7 +321,12 @@ private:
     //
     // But we can abuse the fact that the surrounding members rarely change and are huge
     // (std::function is like 64 bytes) to create some natural padding without wasting space.
-    til::ticket_lock _readWriteLock;
+    til::shared_ticket_lock _readWriteLock;
+
+    // These are only ever incremented, with relaxed ordering. See GetPerformanceCounters().
+    std::atomic<uint64_t> _parsedChars{ 0 };
+    std::atomic<uint64_t> _parseMicroseconds{ 0 };
+    std::atomic<uint64_t> _lockWaitMicroseconds{ 0 };
 
     std::function<void(const int, const int, const int)> _pfnScrollPositionChanged;
     std::function<void(const til::color)> _pfnBackgroundColorChanged;
@@ -314,6 +387,7 @@ private:
     // TODO: These members are not shared by an alt-buffer. They should be
     //      encapsulated, such that a Terminal can have both a main and alt buffer.
     std::unique_ptr<TextBuffer> _buffer;
+    std::unique_ptr<Microsoft::Console::Render::IRenderTarget> _headlessRenderTarget;
     Microsoft::Console::Types::Viewport _mutableViewport;
     SHORT _scrollbackLines;
 
@@ -334,7 +408,14 @@ private:
     //      Either way, we should make this behavior controlled by a setting.
 
     interval_tree::IntervalTree<til::point, size_t> _patternIntervalTree;
+    // The generations of the visible rows the last time _patternIntervalTree was built.
+    std::vector<uint64_t> _patternRowGenerations;
     void _InvalidatePatternTree(interval_tree::IntervalTree<til::point, size_t>& tree);
+    void _ScrollPatternTree(const int rows);
+
+    ScrollbackOverview _scrollbackOverview;
+    std::vector<MirrorRenderData*> _mirrors;
+    void _NotifyMirrors() noexcept;
     void _InvalidateFromCoords(const COORD start, const COORD end);
 
     // Since virtual keys are non-zero, you assume that this field is empty/invalid if it is.
@@ -366,6 +447,7 @@ private:
     void _AdjustCursorPosition(const COORD proposedPosition);
 
     void _NotifyScrollEvent() noexcept;
+    void _CreateScrollbackSpill(const std::wstring_view directory) noexcept;
 
     void _NotifyTerminalCursorPositionChanged() noexcept;
 
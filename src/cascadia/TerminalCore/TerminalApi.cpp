@@ -684,6 +684,21 @@ std::wstring_view Terminal::GetWorkingDirectory() noexcept
     return _workingDirectory;
 }
 
+// Method Description:
+// - Records a shell integration mark at the cursor position.
+// Arguments:
+// - kind: which part of a command starts or ends here
+// - exitCode: the exit code of a finished command, if the shell sent one
+// Return Value:
+// - true
+bool Terminal::AddCommandMark(const ::CommandTimeline::MarkKind kind, const std::optional<unsigned int> exitCode) noexcept
+try
+{
+    _buffer->AddCommandMark(kind, exitCode);
+    return true;
+}
+CATCH_RETURN_FALSE()
+
 // Method Description:
 // - Saves the current text attributes to an internal stack.
 // Arguments:
@@ -561,6 +561,45 @@ bool TerminalDispatch::DoConEmuAction(const std::wstring_view string) noexcept
     return false;
 }
 
+// Method Description:
+// - Performs a FinalTerm shell integration action (OSC 133), which marks where
+//   the prompt, the command line and the output of each command start.
+// Arguments:
+// - string: the mark (A, B, C or D), followed by parameters separated by ';'.
+//   The only parameter we use is the exit code after a D.
+// Return Value:
+// - true if the mark is one we know
+bool TerminalDispatch::DoFinalTermAction(const std::wstring_view string) noexcept
+{
+    const auto parts = Utils::SplitString(string, L';');
+    if (parts.size() < 1 || til::at(parts, 0).size() != 1)
+    {
+        return false;
+    }
+
+    switch (til::at(parts, 0).front())
+    {
+    case L'A':
+        return _terminalApi.AddCommandMark(CommandTimeline::MarkKind::PromptStart, std::nullopt);
+    case L'B':
+        return _terminalApi.AddCommandMark(CommandTimeline::MarkKind::CommandStart, std::nullopt);
+    case L'C':
+        return _terminalApi.AddCommandMark(CommandTimeline::MarkKind::OutputStart, std::nullopt);
+    case L'D':
+    {
+        std::optional<unsigned int> exitCode;
+        unsigned int value = 0;
+        if (parts.size() >= 2 && Utils::StringToUint(til::at(parts, 1), value))
+        {
+            exitCode = value;
+        }
+        return _terminalApi.AddCommandMark(CommandTimeline::MarkKind::CommandFinished, exitCode);
+    }
+    default:
+        return false;
+    }
+}
+
 // Routine Description:
 // - Support routine for routing private mode parameters to be set/reset as flags
 // Arguments:
@@ -81,6 +81,8 @@ public:
 
     bool DoConEmuAction(const std::wstring_view string) noexcept override;
 
+    bool DoFinalTermAction(const std::wstring_view string) noexcept override;
+
 private:
     ::Microsoft::Terminal::Core::ITerminalApi& _terminalApi;
 
@@ -157,6 +157,29 @@ namespace winrt::Microsoft::Terminal::Settings::Editor::implementation
         _KeyBindingList = single_threaded_observable_vector(std::move(keyBindingList));
     }
 
+    // Method Description:
+    // - The list scrolls itself (see Actions.xaml), so its ScrollViewer is
+    //   hidden in its template. Hook that one up to dismiss our popups, like
+    //   the ScrollViewer of every other page does.
+    void Actions::KeyBindingsListView_Loaded(const IInspectable& /*sender*/, const RoutedEventArgs& /*eventArgs*/)
+    {
+        // The template of a ListView is a Border around its ScrollViewer.
+        const auto listView{ KeyBindingsListView() };
+        if (Media::VisualTreeHelper::GetChildrenCount(listView) == 0)
+        {
+            return;
+        }
+        const auto border{ Media::VisualTreeHelper::GetChild(listView, 0) };
+        if (Media::VisualTreeHelper::GetChildrenCount(border) == 0)
+        {
+            return;
+        }
+        if (const auto scrollViewer{ Media::VisualTreeHelper::GetChild(border, 0).try_as<ScrollViewer>() })
+        {
+            scrollViewer.ViewChanging({ this, &Actions::ViewChanging });
+        }
+    }
+
     void Actions::AddNew_Click(const IInspectable& /*sender*/, const RoutedEventArgs& /*eventArgs*/)
     {
         // Create the new key binding and register all of the event handlers.
@@ -196,8 +219,12 @@ namespace winrt::Microsoft::Terminal::Settings::Editor::implementation
                         // This is the view model entry that went into edit mode.
                         // Move focus to the edit mode controls by
                         // extracting the list view item container.
-                        const auto& container{ KeyBindingsListView().ContainerFromIndex(i).try_as<ListViewItem>() };
-                        container.Focus(FocusState::Programmatic);
+                        // The list is virtualized, so the container might not exist
+                        // if the entry was scrolled out of view in the meantime.
+                        if (const auto& container{ KeyBindingsListView().ContainerFromIndex(i).try_as<ListViewItem>() })
+                        {
+                            container.Focus(FocusState::Programmatic);
+                        }
                     }
                     else if (kbdVM.IsNewlyAdded())
                     {
@@ -217,7 +244,10 @@ namespace winrt::Microsoft::Terminal::Settings::Editor::implementation
             else
             {
                 // Focus on the list view item
-                KeyBindingsListView().ContainerFromItem(senderVM).as<Controls::Control>().Focus(FocusState::Programmatic);
+                if (const auto& container{ KeyBindingsListView().ContainerFromItem(senderVM).try_as<Controls::Control>() })
+                {
+                    container.Focus(FocusState::Programmatic);
+                }
 
                 const auto& containerBackground{ Resources().Lookup(box_value(L"ActionContainerBackground")).as<Windows::UI::Xaml::Media::Brush>() };
                 get_self<KeyBindingViewModel>(senderVM)->ContainerBackground(containerBackground);
@@ -241,7 +271,10 @@ namespace winrt::Microsoft::Terminal::Settings::Editor::implementation
             if (_KeyBindingList.Size() != 0)
             {
                 const auto newFocusedIndex{ std::clamp(index, 0u, _KeyBindingList.Size() - 1) };
-                KeyBindingsListView().ContainerFromIndex(newFocusedIndex).as<Controls::Control>().Focus(FocusState::Programmatic);
+                if (const auto& container{ KeyBindingsListView().ContainerFromIndex(newFocusedIndex).try_as<Controls::Control>() })
+                {
+                    container.Focus(FocusState::Programmatic);
+                }
             }
         }
     }
@@ -46,6 +46,22 @@ namespace winrt::Microsoft::Terminal::Settings::Editor::implementation
         return winrt::make<implementation::ProfileViewModel>(profile, appSettings);
     }
 
+    // Profile menu items are tagged with either the profile or its view model
+    // (see _ViewModelForNavItem). Returns the GUID of the profile either way,
+    // or an empty GUID if the tag doesn't point to a profile at all.
+    static winrt::guid _profileGuidForTag(const IInspectable& tag)
+    {
+        if (const auto profileVM{ tag.try_as<Editor::ProfileViewModel>() })
+        {
+            return profileVM.OriginalProfileGuid();
+        }
+        if (const auto profile{ tag.try_as<Model::Profile>() })
+        {
+            return profile.Guid();
+        }
+        return {};
+    }
+
     MainPage::MainPage(const CascadiaSettings& settings) :
         _settingsSource{ settings },
         _settingsClone{ settings.Copy() }
@@ -101,7 +117,7 @@ namespace winrt::Microsoft::Terminal::Settings::Editor::implementation
                     {
                         if (const auto& tag{ navViewItem.Tag() })
                         {
-                            if (tag.try_as<Editor::ProfileViewModel>())
+                            if (_profileGuidForTag(tag) != winrt::guid{})
                             {
                                 // remove NavViewItem pointing to a Profile
                                 return true;
@@ -151,17 +167,14 @@ namespace winrt::Microsoft::Terminal::Settings::Editor::implementation
                                 }
                             }
                         }
-                        else if (const auto& profileTag{ tag.try_as<ProfileViewModel>() })
+                        else if (const auto profileGuid{ _profileGuidForTag(tag) }; profileGuid != winrt::guid{})
                         {
-                            if (const auto& selectedItemProfileTag{ selectedItemTag.try_as<ProfileViewModel>() })
+                            if (profileGuid == _profileGuidForTag(selectedItemTag))
                             {
-                                if (profileTag->OriginalProfileGuid() == selectedItemProfileTag->OriginalProfileGuid())
-                                {
-                                    // found the one that was selected before the refresh
-                                    SettingsNav().SelectedItem(item);
-                                    _Navigate(*profileTag);
-                                    return;
-                                }
+                                // found the one that was selected before the refresh
+                                SettingsNav().SelectedItem(item);
+                                _Navigate(_ViewModelForNavItem(menuItem));
+                                return;
                             }
                         }
                     }
@@ -269,10 +282,13 @@ namespace winrt::Microsoft::Terminal::Settings::Editor::implementation
             {
                 _Navigate(*navString);
             }
-            else if (const auto profile = clickedItemContainer.Tag().try_as<Editor::ProfileViewModel>())
+            else if (const auto navItem = clickedItemContainer.try_as<MUX::Controls::NavigationViewItem>())
             {
-                // Navigate to a page with the given profile
-                _Navigate(profile);
+                if (const auto profile = _ViewModelForNavItem(navItem))
+                {
+                    // Navigate to a page with the given profile
+                    _Navigate(profile);
+                }
             }
         }
     }
@@ -389,16 +405,14 @@ namespace winrt::Microsoft::Terminal::Settings::Editor::implementation
     {
         const auto menuItems = SettingsNav().MenuItems();
 
-        // Manually create a NavigationViewItem for each profile
-        // and keep a reference to them in a map so that we
-        // can easily modify the correct one when the associated
-        // profile changes.
+        // Manually create a NavigationViewItem for each profile.
+        // Their view models are only created once they're navigated to,
+        // which keeps opening the settings cheap even with hundreds of profiles.
         for (const auto& profile : _settingsClone.AllProfiles())
         {
             if (!profile.Deleted())
             {
-                auto navItem = _CreateProfileNavViewItem(_viewModelForProfile(profile, _settingsClone));
-                menuItems.Append(navItem);
+                menuItems.Append(_CreateProfileNavViewItem(profile));
             }
         }
 
@@ -418,28 +432,57 @@ namespace winrt::Microsoft::Terminal::Settings::Editor::implementation
     void MainPage::_CreateAndNavigateToNewProfile(const uint32_t index, const Model::Profile& profile)
     {
         const auto newProfile{ profile ? profile : _settingsClone.CreateNewProfile() };
-        const auto profileViewModel{ _viewModelForProfile(newProfile, _settingsClone) };
-        const auto navItem{ _CreateProfileNavViewItem(profileViewModel) };
+        const auto navItem{ _CreateProfileNavViewItem(newProfile) };
         SettingsNav().MenuItems().InsertAt(index, navItem);
 
         // Select and navigate to the new profile
         SettingsNav().SelectedItem(navItem);
-        _Navigate(profileViewModel);
+        _Navigate(_ViewModelForNavItem(navItem));
     }
 
-    MUX::Controls::NavigationViewItem MainPage::_CreateProfileNavViewItem(const Editor::ProfileViewModel& profile)
+    MUX::Controls::NavigationViewItem MainPage::_CreateProfileNavViewItem(const Model::Profile& profile)
     {
         MUX::Controls::NavigationViewItem profileNavItem;
         profileNavItem.Content(box_value(profile.Name()));
-        profileNavItem.Tag(box_value<Editor::ProfileViewModel>(profile));
+        profileNavItem.Tag(profile);
 
         const auto iconSource{ IconPathConverter::IconSourceWUX(profile.Icon()) };
         WUX::Controls::IconSourceElement icon;
         icon.IconSource(iconSource);
         profileNavItem.Icon(icon);
 
+        return profileNavItem;
+    }
+
+    // Method Description:
+    // - Returns the view model of the profile the given menu item points to.
+    //   Profile menu items start out tagged with just the profile. The view
+    //   model is created the first time it's asked for, and then replaces the
+    //   profile as the tag, so that it (and any edits made through it) is
+    //   reused when the profile is navigated to again.
+    // Arguments:
+    // - navItem - a menu item created by _CreateProfileNavViewItem
+    // Return Value:
+    // - the view model, or null if the menu item doesn't point to a profile
+    Editor::ProfileViewModel MainPage::_ViewModelForNavItem(const MUX::Controls::NavigationViewItem& navItem)
+    {
+        const auto tag{ navItem.Tag() };
+        if (const auto profileVM{ tag.try_as<Editor::ProfileViewModel>() })
+        {
+            return profileVM;
+        }
+
+        const auto profileModel{ tag.try_as<Model::Profile>() };
+        if (!profileModel)
+        {
+            return nullptr;
+        }
+
+        const auto profile{ _viewModelForProfile(profileModel, _settingsClone) };
+        navItem.Tag(box_value<Editor::ProfileViewModel>(profile));
+
         // Update the menu item when the icon/name changes
-        auto weakMenuItem{ make_weak(profileNavItem) };
+        auto weakMenuItem{ make_weak(navItem) };
         profile.PropertyChanged([weakMenuItem](const auto&, const WUX::Data::PropertyChangedEventArgs& args) {
             if (auto menuItem{ weakMenuItem.get() })
             {
@@ -457,7 +500,7 @@ namespace winrt::Microsoft::Terminal::Settings::Editor::implementation
                 }
             }
         });
-        return profileNavItem;
+        return profile;
     }
 
     void MainPage::_DeleteProfile(const IInspectable /*sender*/, const Editor::DeleteProfileEventArgs& args)
@@ -484,7 +527,7 @@ namespace winrt::Microsoft::Terminal::Settings::Editor::implementation
         // navigate to the profile next to this one
         const auto newSelectedItem{ menuItems.GetAt(index < menuItems.Size() - 1 ? index : index - 1) };
         SettingsNav().SelectedItem(newSelectedItem);
-        _Navigate(newSelectedItem.try_as<MUX::Controls::NavigationViewItem>().Tag().try_as<Editor::ProfileViewModel>());
+        _Navigate(_ViewModelForNavItem(newSelectedItem.as<MUX::Controls::NavigationViewItem>()));
     }
 
     bool MainPage::ShowBaseLayerMenuItem() const noexcept
@@ -38,7 +38,8 @@ namespace winrt::Microsoft::Terminal::Settings::Editor::implementation
 
         void _InitializeProfilesList();
         void _CreateAndNavigateToNewProfile(const uint32_t index, const Model::Profile& profile);
-        winrt::Microsoft::UI::Xaml::Controls::NavigationViewItem _CreateProfileNavViewItem(const Editor::ProfileViewModel& profile);
+        winrt::Microsoft::UI::Xaml::Controls::NavigationViewItem _CreateProfileNavViewItem(const Model::Profile& profile);
+        Editor::ProfileViewModel _ViewModelForNavItem(const winrt::Microsoft::UI::Xaml::Controls::NavigationViewItem& navItem);
         void _DeleteProfile(const Windows::Foundation::IInspectable sender, const Editor::DeleteProfileEventArgs& args);
         void _AddProfileHandler(const winrt::guid profileGuid);
 
@@ -73,8 +73,134 @@ namespace winrt::Microsoft::Terminal::Settings::Editor::implementation
         return Model::TerminalSettings::CreateWithProfile(_appSettings, _profile, nullptr).DefaultSettings();
     }
 
+    // The font list is cached in this file next to the settings, so that we
+    // don't have to ask DirectWrite about every installed font each time the
+    // settings UI is opened. See _FontCacheKey for when it's rebuilt.
+    static constexpr std::wstring_view FontCacheFilename{ L"fonts.cache" };
+    static constexpr std::wstring_view FontCacheVersion{ L"1" };
+
+    // Function Description:
+    // - Returns a key that changes whenever the list of fonts might have.
+    //   Installing or removing a font, for everyone or for the current user,
+    //   updates the last write time of the respective Fonts registry key.
+    //   The localized names also depend on the user's locale.
+    static std::wstring _FontCacheKey()
+    {
+        std::wstring key{ FontCacheVersion };
+        for (const auto root : { HKEY_LOCAL_MACHINE, HKEY_CURRENT_USER })
+        {
+            wil::unique_hkey fonts;
+            DWORD values{};
+            FILETIME lastWrite{};
+            if (RegOpenKeyExW(root, L"SOFTWARE\\Microsoft\\Windows NT\\CurrentVersion\\Fonts", 0, KEY_QUERY_VALUE, fonts.put()) == ERROR_SUCCESS &&
+                RegQueryInfoKeyW(fonts.get(), nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, &values, nullptr, nullptr, nullptr, &lastWrite) == ERROR_SUCCESS)
+            {
+                fmt::format_to(std::back_inserter(key), FMT_STRING(L" {}:{:08x}{:08x}"), values, lastWrite.dwHighDateTime, lastWrite.dwLowDateTime);
+            }
+            else
+            {
+                key.append(L" -");
+            }
+        }
+
+        wchar_t localeName[LOCALE_NAME_MAX_LENGTH]{};
+        GetUserDefaultLocaleName(localeName, LOCALE_NAME_MAX_LENGTH);
+        key.push_back(L' ');
+        key.append(localeName);
+        return key;
+    }
+
+    static std::filesystem::path _FontCachePath()
+    {
+        std::filesystem::path settingsPath{ std::wstring_view{ CascadiaSettings::SettingsPath() } };
+        return settingsPath.parent_path() / FontCacheFilename;
+    }
+
+    // Function Description:
+    // - Reads the cached list of fonts, if it's still valid.
+    // - The cache is UTF-8 text: the key on the first line, and then a line
+    //   for every font, with its monospace flag (0 or 1), name and localized
+    //   name separated by tabs.
+    // Arguments:
+    // - key: the current key, see _FontCacheKey
+    // - fonts: receives the name, localized name and monospace flag of every font
+    // Return Value:
+    // - false, if there's no cache yet or it's outdated
+    static bool _LoadFontCache(const std::wstring_view key, std::vector<std::tuple<std::wstring, std::wstring, bool>>& fonts)
+    try
+    {
+        std::ifstream file{ _FontCachePath(), std::ios::binary };
+        if (!file)
+        {
+            return false;
+        }
+        const std::string bytes{ std::istreambuf_iterator<char>{ file }, std::istreambuf_iterator<char>{} };
+        const auto text = til::u8u16(bytes);
+        std::wstring_view remaining{ text };
+
+        const auto nextLine = [&]() {
+            const auto end = remaining.find(L'\n');
+            const auto line = remaining.substr(0, end);
+            remaining = end == std::wstring_view::npos ? std::wstring_view{} : remaining.substr(end + 1);
+            return line;
+        };
+
+        if (nextLine() != key)
+        {
+            return false;
+        }
+
+        while (!remaining.empty())
+        {
+            const auto line = nextLine();
+            const auto first = line.find(L'\t');
+            const auto second = first == std::wstring_view::npos ? first : line.find(L'\t', first + 1);
+            if (second == std::wstring_view::npos || first != 1)
+            {
+                // It's broken. We'll just enumerate the fonts again.
+                fonts.clear();
+                return false;
+            }
+            fonts.emplace_back(line.substr(2, second - 2), line.substr(second + 1), line[0] == L'1');
+        }
+        return !fonts.empty();
+    }
+    catch (...)
+    {
+        LOG_CAUGHT_EXCEPTION();
+        fonts.clear();
+        return false;
+    }
+
+    static void _SaveFontCache(const std::wstring_view key, const std::vector<std::tuple<std::wstring, std::wstring, bool>>& fonts) noexcept
+    try
+    {
+        std::wstring text{ key };
+        for (const auto& [name, localizedName, monospace] : fonts)
+        {
+            fmt::format_to(std::back_inserter(text), FMT_STRING(L"\n{}\t{}\t{}"), monospace ? L'1' : L'0', name, localizedName);
+        }
+        const auto bytes = til::u16u8(text);
+
+        // Write it to a temporary file first, so that another window reading
+        // the cache meanwhile never sees half of it.
+        const auto path = _FontCachePath();
+        auto temporaryPath = path;
+        temporaryPath += L".tmp";
+        {
+            std::ofstream file{ temporaryPath, std::ios::binary | std::ios::trunc };
+            file.write(bytes.data(), bytes.size());
+            THROW_HR_IF(E_FAIL, !file);
+        }
+        std::filesystem::rename(temporaryPath, path);
+    }
+    CATCH_LOG();
+
     // Method Description:
-    // - Updates the lists of fonts and sorts them alphabetically
+    // - Updates the lists of fonts and sorts them alphabetically.
+    // - Enumerating the fonts through DirectWrite takes a long time once there
+    //   are thousands of them, so the result is cached until the installed
+    //   fonts change (see _FontCacheKey).
     void ProfileViewModel::UpdateFontList() noexcept
     try
     {
@@ -82,6 +208,41 @@ namespace winrt::Microsoft::Terminal::Settings::Editor::implementation
         std::vector<Editor::Font> fontList;
         std::vector<Editor::Font> monospaceFontList;
 
+        const auto cacheKey = _FontCacheKey();
+        std::vector<std::tuple<std::wstring, std::wstring, bool>> fonts;
+        if (!_LoadFontCache(cacheKey, fonts))
+        {
+            _EnumerateFonts(fonts);
+            _SaveFontCache(cacheKey, fonts);
+        }
+
+        for (const auto& [name, localizedName, monospace] : fonts)
+        {
+            const auto font = make<Font>(name, localizedName);
+            if (monospace)
+            {
+                monospaceFontList.emplace_back(font);
+            }
+            fontList.emplace_back(font);
+        }
+
+        // sort and save the lists
+        std::sort(begin(fontList), end(fontList), FontComparator());
+        _FontList = single_threaded_observable_vector<Editor::Font>(std::move(fontList));
+
+        std::sort(begin(monospaceFontList), end(monospaceFontList), FontComparator());
+        _MonospaceFontList = single_threaded_observable_vector<Editor::Font>(std::move(monospaceFontList));
+    }
+    CATCH_LOG();
+
+    // Method Description:
+    // - Enumerates the system's font families through DirectWrite.
+    // Arguments:
+    // - fonts: receives the name, localized name and monospace flag of every font
+    // Return Value:
+    // - <none>
+    void ProfileViewModel::_EnumerateFonts(std::vector<std::tuple<std::wstring, std::wstring, bool>>& fonts)
+    {
         // get a DWriteFactory
         com_ptr<IDWriteFactory> factory;
         THROW_IF_FAILED(DWriteCreateFactory(
@@ -109,6 +270,7 @@ namespace winrt::Microsoft::Terminal::Settings::Editor::implementation
                 if (const auto fontEntry{ _GetFont(localizedFamilyNames) })
                 {
                     // check if the font is monospaced
+                    bool monospace = false;
                     try
                     {
                         com_ptr<IDWriteFont> font;
@@ -117,30 +279,18 @@ namespace winrt::Microsoft::Terminal::Settings::Editor::implementation
                                                                          DWRITE_FONT_STYLE::DWRITE_FONT_STYLE_NORMAL,
                                                                          font.put()));
 
-                        // add the font name to our list of monospace fonts
                         const auto castedFont{ font.try_as<IDWriteFont1>() };
-                        if (castedFont && castedFont->IsMonospacedFont())
-                        {
-                            monospaceFontList.emplace_back(fontEntry);
-                        }
+                        monospace = castedFont && castedFont->IsMonospacedFont();
                     }
                     CATCH_LOG();
 
                     // add the font name to our list of all fonts
-                    fontList.emplace_back(std::move(fontEntry));
+                    fonts.emplace_back(fontEntry.Name(), fontEntry.LocalizedName(), monospace);
                 }
             }
             CATCH_LOG();
         }
-
-        // sort and save the lists
-        std::sort(begin(fontList), end(fontList), FontComparator());
-        _FontList = single_threaded_observable_vector<Editor::Font>(std::move(fontList));
-
-        std::sort(begin(monospaceFontList), end(monospaceFontList), FontComparator());
-        _MonospaceFontList = single_threaded_observable_vector<Editor::Font>(std::move(monospaceFontList));
     }
-    CATCH_LOG();
 
     Editor::Font ProfileViewModel::_GetFont(com_ptr<IDWriteLocalizedStrings> localizedFamilyNames)
     {
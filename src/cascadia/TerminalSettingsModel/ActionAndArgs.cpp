@@ -53,6 +53,7 @@ static constexpr std::string_view TogglePaneZoomKey{ "togglePaneZoom" };
 static constexpr std::string_view ToggleSplitOrientationKey{ "toggleSplitOrientation" };
 static constexpr std::string_view LegacyToggleRetroEffectKey{ "toggleRetroEffect" };
 static constexpr std::string_view ToggleShaderEffectsKey{ "toggleShaderEffects" };
+static constexpr std::string_view TogglePerformanceOverlayKey{ "togglePerformanceOverlay" };
 static constexpr std::string_view MoveTabKey{ "moveTab" };
 static constexpr std::string_view BreakIntoDebuggerKey{ "breakIntoDebugger" };
 static constexpr std::string_view FindMatchKey{ "findMatch" };
@@ -66,6 +67,11 @@ static constexpr std::string_view GlobalSummonKey{ "globalSummon" };
 static constexpr std::string_view QuakeModeKey{ "quakeMode" };
 static constexpr std::string_view FocusPaneKey{ "focusPane" };
 static constexpr std::string_view MultipleActionsKey{ "multipleActions" };
+static constexpr std::string_view ExportBufferKey{ "exportBuffer" };
+static constexpr std::string_view ScrollToPreviousCommandKey{ "scrollToPreviousCommand" };
+static constexpr std::string_view ScrollToNextCommandKey{ "scrollToNextCommand" };
+static constexpr std::string_view SelectCommandOutputKey{ "selectCommandOutput" };
+static constexpr std::string_view ToggleBroadcastInputKey{ "toggleBroadcastInput" };
 
 static constexpr std::string_view ActionKey{ "action" };
 
@@ -355,6 +361,7 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
                 { ShortcutAction::TogglePaneZoom, RS_(L"TogglePaneZoomCommandKey") },
                 { ShortcutAction::ToggleSplitOrientation, RS_(L"ToggleSplitOrientationCommandKey") },
                 { ShortcutAction::ToggleShaderEffects, RS_(L"ToggleShaderEffectsCommandKey") },
+                { ShortcutAction::TogglePerformanceOverlay, RS_(L"TogglePerformanceOverlayCommandKey") },
                 { ShortcutAction::MoveTab, L"" }, // Intentionally omitted, must be generated by GenerateName
                 { ShortcutAction::BreakIntoDebugger, RS_(L"BreakIntoDebuggerCommandKey") },
                 { ShortcutAction::FindMatch, L"" }, // Intentionally omitted, must be generated by GenerateName
@@ -368,6 +375,11 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
                 { ShortcutAction::QuakeMode, RS_(L"QuakeModeCommandKey") },
                 { ShortcutAction::FocusPane, L"" }, // Intentionally omitted, must be generated by GenerateName
                 { ShortcutAction::MultipleActions, L"" }, // Intentionally omitted, must be generated by GenerateName
+                { ShortcutAction::ExportBuffer, RS_(L"ExportBufferCommandKey") },
+                { ShortcutAction::ScrollToPreviousCommand, RS_(L"ScrollToPreviousCommandCommandKey") },
+                { ShortcutAction::ScrollToNextCommand, RS_(L"ScrollToNextCommandCommandKey") },
+                { ShortcutAction::SelectCommandOutput, RS_(L"SelectCommandOutputCommandKey") },
+                { ShortcutAction::ToggleBroadcastInput, RS_(L"ToggleBroadcastInputCommandKey") },
             };
         }();
 
@@ -35,6 +35,7 @@
 #include "GlobalSummonArgs.g.cpp"
 #include "FocusPaneArgs.g.cpp"
 #include "MultipleActionsArgs.g.cpp"
+#include "ExportBufferArgs.g.cpp"
 
 #include <LibraryResources.h>
 
@@ -378,18 +379,23 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
     {
         // The string will be similar to the following:
         // * "Duplicate pane[, split: <direction>][, size: <size>%][, new terminal arguments...]"
+        // * "Mirror pane[, split: <direction>][, size: <size>%]"
         // * "Split pane[, split: <direction>][, size: <size>%][, new terminal arguments...]"
         //
         // Direction will only be added to the string if the split direction is
         // not "auto".
-        // If this is a "duplicate pane" action, then the new terminal arguments
-        // will be omitted (as they're unused)
+        // If this is a "duplicate pane" or "mirror pane" action, then the new
+        // terminal arguments will be omitted (as they're unused)
 
         std::wstringstream ss;
         if (SplitMode() == SplitType::Duplicate)
         {
             ss << std::wstring_view(RS_(L"DuplicatePaneCommandKey"));
         }
+        else if (SplitMode() == SplitType::Mirror)
+        {
+            ss << std::wstring_view(RS_(L"MirrorPaneCommandKey"));
+        }
         else
         {
             ss << std::wstring_view(RS_(L"SplitPaneCommandKey"));
@@ -419,7 +425,7 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
             newTerminalArgsStr = TerminalArgs().GenerateName();
         }
 
-        if (SplitMode() != SplitType::Duplicate && !newTerminalArgsStr.empty())
+        if (SplitMode() == SplitType::Manual && !newTerminalArgsStr.empty())
         {
             ss << newTerminalArgsStr.c_str();
             ss << L", ";
@@ -693,4 +699,18 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
     {
         return L"";
     }
+
+    winrt::hstring ExportBufferArgs::GenerateName() const
+    {
+        // "Export text to {_Path}"
+        // "Export text"
+        if (!Path().empty())
+        {
+            return winrt::hstring{
+                fmt::format(std::wstring_view(RS_(L"ExportBufferToPathCommandKey")),
+                            Path().c_str())
+            };
+        }
+        return RS_(L"ExportBufferCommandKey");
+    }
 }
@@ -37,6 +37,7 @@
 #include "GlobalSummonArgs.g.h"
 #include "FocusPaneArgs.g.h"
 #include "MultipleActionsArgs.g.h"
+#include "ExportBufferArgs.g.h"
 
 #include "../../cascadia/inc/cppwinrt_utils.h"
 #include "JsonUtils.h"
@@ -1802,6 +1803,54 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
             return ::Microsoft::Terminal::Settings::Model::HashUtils::HashProperty(_Actions);
         }
     };
+
+    struct ExportBufferArgs : public ExportBufferArgsT<ExportBufferArgs>
+    {
+        ExportBufferArgs() = default;
+        ACTION_ARG(winrt::hstring, Path);
+        static constexpr std::string_view PathKey{ "path" };
+
+    public:
+        hstring GenerateName() const;
+
+        bool Equals(const IActionArgs& other)
+        {
+            auto otherAsUs = other.try_as<ExportBufferArgs>();
+            if (otherAsUs)
+            {
+                return otherAsUs->_Path == _Path;
+            }
+            return false;
+        };
+        static FromJsonResult FromJson(const Json::Value& json)
+        {
+            // LOAD BEARING: Not using make_self here _will_ break you in the future!
+            auto args = winrt::make_self<ExportBufferArgs>();
+            JsonUtils::GetValueForKey(json, PathKey, args->_Path);
+            return { *args, {} };
+        }
+        static Json::Value ToJson(const IActionArgs& val)
+        {
+            if (!val)
+            {
+                return {};
+            }
+            Json::Value json{ Json::ValueType::objectValue };
+            const auto args{ get_self<ExportBufferArgs>(val) };
+            JsonUtils::SetValueForKey(json, PathKey, args->_Path);
+            return json;
+        }
+        IActionArgs Copy() const
+        {
+            auto copy{ winrt::make_self<ExportBufferArgs>() };
+            copy->_Path = _Path;
+            return *copy;
+        }
+        size_t Hash() const
+        {
+            return ::Microsoft::Terminal::Settings::Model::HashUtils::HashProperty(Path());
+        }
+    };
 }
 
 namespace winrt::Microsoft::Terminal::Settings::Model::factory_implementation
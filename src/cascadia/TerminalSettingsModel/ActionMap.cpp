@@ -366,6 +366,42 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         }
     }
 
+    // Method Description:
+    // - Populates the provided keyChordLookup with all of the key chords in our layer and our parents layers.
+    // - Key chords that were explicitly unbound map to nullptr.
+    // - This needs to be a bottom up approach to ensure that the closest layer wins.
+    // Arguments:
+    // - keyChordLookup: the map we're populating. This maps a key chord to the command it invokes.
+    void ActionMap::_PopulateKeyChordLookup(std::unordered_map<Control::KeyChord, Model::Command, KeyChordHash, KeyChordEquality>& keyChordLookup) const
+    {
+        for (const auto& [keys, actionID] : _KeyMap)
+        {
+            // emplace() leaves the entry of a closer layer alone
+            keyChordLookup.emplace(keys, _GetActionByID(actionID).value());
+        }
+
+        assert(_parents.size() <= 1);
+        for (const auto& parent : _parents)
+        {
+            parent->_PopulateKeyChordLookup(keyChordLookup);
+        }
+    }
+
+    // Method Description:
+    // - Retrieves the flattened key chord lookup table, building it if necessary.
+    // Return Value:
+    // - a map of every key chord we know about to the command it invokes (nullptr if explicitly unbound)
+    const std::unordered_map<Control::KeyChord, Model::Command, KeyChordHash, KeyChordEquality>& ActionMap::_GetKeyChordLookup() const
+    {
+        if (!_KeyChordLookupCache)
+        {
+            std::unordered_map<Control::KeyChord, Model::Command, KeyChordHash, KeyChordEquality> keyChordLookup;
+            _PopulateKeyChordLookup(keyChordLookup);
+            _KeyChordLookupCache.emplace(std::move(keyChordLookup));
+        }
+        return *_KeyChordLookupCache;
+    }
+
     com_ptr<ActionMap> ActionMap::Copy() const
     {
         auto actionMap{ make_self<ActionMap>() };
@@ -426,6 +462,7 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         _NameMapCache = nullptr;
         _GlobalHotkeysCache = nullptr;
         _KeyBindingMapCache = nullptr;
+        _KeyChordLookupCache.reset();
 
         // Handle nested commands
         const auto cmdImpl{ get_self<Command>(cmd) };
@@ -719,24 +756,12 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
     // - nullopt if it was not bound in this layer
     std::optional<Model::Command> ActionMap::_GetActionByKeyChordInternal(const Control::KeyChord& keys) const
     {
-        // Check the current layer
-        if (const auto actionIDPair = _KeyMap.find(keys); actionIDPair != _KeyMap.end())
+        // The lookup table already resolved which layer each key chord comes from
+        // (invalid commands exposed as nullptr)
+        const auto& keyChordLookup{ _GetKeyChordLookup() };
+        if (const auto it = keyChordLookup.find(keys); it != keyChordLookup.end())
         {
-            // the command was explicitly bound,
-            // return what we found (invalid commands exposed as nullptr)
-            return _GetActionByID(actionIDPair->second);
-        }
-
-        // the command was not bound in this layer,
-        // ask my parents
-        assert(_parents.size() <= 1);
-        for (const auto& parent : _parents)
-        {
-            const auto& inheritedCmd{ parent->_GetActionByKeyChordInternal(keys) };
-            if (inheritedCmd)
-            {
-                return *inheritedCmd;
-            }
+            return it->second;
         }
 
         // This action is not explicitly bound
@@ -85,6 +85,8 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         void _PopulateNameMapWithSpecialCommands(std::unordered_map<hstring, Model::Command>& nameMap) const;
         void _PopulateNameMapWithStandardCommands(std::unordered_map<hstring, Model::Command>& nameMap) const;
         void _PopulateKeyBindingMapWithStandardCommands(std::unordered_map<Control::KeyChord, Model::Command, KeyChordHash, KeyChordEquality>& keyBindingsMap, std::unordered_set<Control::KeyChord, KeyChordHash, KeyChordEquality>& unboundKeys) const;
+        void _PopulateKeyChordLookup(std::unordered_map<Control::KeyChord, Model::Command, KeyChordHash, KeyChordEquality>& keyChordLookup) const;
+        const std::unordered_map<Control::KeyChord, Model::Command, KeyChordHash, KeyChordEquality>& _GetKeyChordLookup() const;
         std::vector<Model::Command> _GetCumulativeActions() const noexcept;
 
         void _TryUpdateActionMap(const Model::Command& cmd, Model::Command& oldCmd, Model::Command& consolidatedCmd);
@@ -96,6 +98,10 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         Windows::Foundation::Collections::IMap<Control::KeyChord, Model::Command> _GlobalHotkeysCache{ nullptr };
         Windows::Foundation::Collections::IMap<Control::KeyChord, Model::Command> _KeyBindingMapCache{ nullptr };
 
+        // Every key chord bound (or explicitly unbound, as nullptr) in this layer or any of our parents.
+        // Lets GetActionByKeyChord answer with a single lookup instead of walking the layers on every key press.
+        mutable std::optional<std::unordered_map<Control::KeyChord, Model::Command, KeyChordHash, KeyChordEquality>> _KeyChordLookupCache;
+
         std::unordered_map<winrt::hstring, Model::Command> _NestedCommands;
         std::vector<Model::Command> _IterableCommands;
         std::unordered_map<Control::KeyChord, InternalActionID, KeyChordHash, KeyChordEquality> _KeyMap;
@@ -21,9 +21,11 @@ Abstract:
 // This macro generates all getters and setters for ApplicationState.
 // It provides X with the following arguments:
 //   (type, function name, JSON key, ...variadic construction arguments)
-#define MTSM_APPLICATION_STATE_FIELDS(X)                                       \
-    X(std::unordered_set<winrt::guid>, GeneratedProfiles, "generatedProfiles") \
-    X(Windows::Foundation::Collections::IVector<hstring>, RecentCommands, "recentCommands")
+#define MTSM_APPLICATION_STATE_FIELDS(X)                                                    \
+    X(std::unordered_set<winrt::guid>, GeneratedProfiles, "generatedProfiles")              \
+    X(Windows::Foundation::Collections::IVector<hstring>, RecentCommands, "recentCommands") \
+    X(std::vector<std::wstring>, WslDistroNames, "wslDistroNames")                          \
+    X(std::wstring, WslDistroNamesStamp, "wslDistroNamesStamp")
 
 namespace winrt::Microsoft::Terminal::Settings::Model::implementation
 {
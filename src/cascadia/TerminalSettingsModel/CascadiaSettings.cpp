@@ -312,6 +312,7 @@ winrt::Microsoft::Terminal::Settings::Model::Profile CascadiaSettings::Duplicate
     DUPLICATE_SETTING_MACRO(ForceFullRepaintRendering);
     DUPLICATE_SETTING_MACRO(SoftwareRendering);
     DUPLICATE_SETTING_MACRO(HistorySize);
+    DUPLICATE_SETTING_MACRO(ScrollbackSpillDirectory);
     DUPLICATE_SETTING_MACRO(SnapOnInput);
     DUPLICATE_SETTING_MACRO(AltGrAliasing);
     DUPLICATE_SETTING_MACRO(BellStyle);
@@ -107,6 +107,13 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         void CurrentDefaultTerminal(Model::DefaultTerminal terminal);
 
     private:
+        // The json files of a single fragment extension and where they came from.
+        struct FragmentFiles
+        {
+            winrt::hstring source;
+            std::unordered_set<std::string> files;
+        };
+
         com_ptr<GlobalAppSettings> _globals;
         Windows::Foundation::Collections::IObservableVector<Model::Profile> _allProfiles;
         Windows::Foundation::Collections::IObservableVector<Model::Profile> _activeProfiles;
@@ -124,13 +131,18 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         Json::Value _defaultSettings;
         winrt::com_ptr<Profile> _userDefaultProfileSettings{ nullptr };
 
+        // The indices of the profiles in _allProfiles by their GUID. See _FindMatchingProfileIndex.
+        std::unordered_map<winrt::guid, std::vector<uint32_t>> _profileIndicesByGuid;
+        uint32_t _profileIndicesByGuidSize{ 0 };
+
         winrt::com_ptr<Profile> _CreateNewProfile(const std::wstring_view& name) const;
 
         void _LayerOrCreateProfile(const Json::Value& profileJson);
         winrt::com_ptr<implementation::Profile> _FindMatchingProfile(const Json::Value& profileJson);
         std::optional<uint32_t> _FindMatchingProfileIndex(const Json::Value& profileJson);
+        void _RebuildProfileIndicesByGuid();
         void _LayerOrCreateColorScheme(const Json::Value& schemeJson);
-        Json::Value _ParseUtf8JsonString(std::string_view fileData);
+        static Json::Value _ParseUtf8JsonString(std::string_view fileData);
 
         winrt::com_ptr<implementation::ColorScheme> _FindMatchingColorScheme(const Json::Value& schemeJson);
         void _ParseJsonString(std::string_view fileData, const bool isDefaultSettings);
@@ -144,9 +156,10 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         void _ApplyDefaultsFromUserSettings();
 
         void _LoadDynamicProfiles();
-        void _LoadFragmentExtensions();
-        void _ApplyJsonStubsHelper(const std::wstring_view directory, const std::unordered_set<std::wstring>& ignoredNamespaces);
-        std::unordered_set<std::string> _AccumulateJsonFilesInDirectory(const std::wstring_view directory);
+        void _LoadFragmentExtensions(const std::vector<FragmentFiles>& fragments);
+        static std::vector<FragmentFiles> _ReadFragmentFiles();
+        static void _AccumulateFragmentDirectories(const std::wstring_view directory, std::vector<FragmentFiles>& fragments);
+        static std::unordered_set<std::string> _AccumulateJsonFilesInDirectory(const std::wstring_view directory);
         void _ParseAndLayerFragmentFiles(const std::unordered_set<std::string> files, const winrt::hstring source);
 
         static const std::filesystem::path& _SettingsPath();
@@ -5,6 +5,7 @@
 #include "CascadiaSettings.h"
 
 #include <fmt/chrono.h>
+#include <future>
 #include <shlobj.h>
 
 // defaults.h is a file containing the default json settings in a std::string_view
@@ -50,31 +51,42 @@ static constexpr std::wstring_view FragmentsPath{ L"\\Microsoft\\Windows Termina
 
 static constexpr std::string_view AppExtensionHostName{ "com.microsoft.windows.terminal.settings" };
 
-// Function Description:
-// - Extracting the value from an async task (like talking to the app catalog) when we are on the
-//   UI thread causes C++/WinRT to complain quite loudly (and halt execution!)
-//   This templated function extracts the result from a task with chicanery.
-template<typename TTask>
-static auto _extractValueFromTaskWithoutMainThreadAwait(TTask&& task) -> decltype(task.get())
+// Writes the start or stop event of a "SettingsLoadPhase" region.
+// See ConsolePerf.regions.xml. The phase must be a string literal.
+static void _TraceLoadPhase(const char* const phase, const bool start) noexcept
 {
-    using TVal = decltype(task.get());
-    std::optional<TVal> finalVal{};
-    std::condition_variable cv;
-    std::mutex mtx;
-
-    auto waitOnBackground = [&]() -> winrt::fire_and_forget {
-        co_await winrt::resume_background();
-        auto v{ co_await task };
-
-        std::unique_lock<std::mutex> lock{ mtx };
-        finalVal.emplace(std::move(v));
-        cv.notify_all();
-    };
+    if (!TraceLoggingProviderEnabled(g_hSettingsModelProvider, WINEVENT_LEVEL_VERBOSE, TIL_KEYWORD_TRACE))
+    {
+        return;
+    }
+
+    if (start)
+    {
+#pragma warning(suppress : 26477 26485 26494 26482 26446 26447) // We don't control TraceLoggingWrite
+        TraceLoggingWrite(g_hSettingsModelProvider,
+                          "SettingsLoadPhase",
+                          TraceLoggingString(phase, "Phase"),
+                          TraceLoggingOpcode(WINEVENT_OPCODE_START),
+                          TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+                          TraceLoggingKeyword(TIL_KEYWORD_TRACE));
+    }
+    else
+    {
+#pragma warning(suppress : 26477 26485 26494 26482 26446 26447) // We don't control TraceLoggingWrite
+        TraceLoggingWrite(g_hSettingsModelProvider,
+                          "SettingsLoadPhase",
+                          TraceLoggingString(phase, "Phase"),
+                          TraceLoggingOpcode(WINEVENT_OPCODE_STOP),
+                          TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+                          TraceLoggingKeyword(TIL_KEYWORD_TRACE));
+    }
+}
 
-    std::unique_lock<std::mutex> lock{ mtx };
-    waitOnBackground();
-    cv.wait(lock, [&]() { return finalVal.has_value(); });
-    return *finalVal;
+// Brackets the rest of the enclosing scope with a "SettingsLoadPhase" region.
+static auto _TraceLoadPhaseScope(const char* const phase) noexcept
+{
+    _TraceLoadPhase(phase, true);
+    return wil::scope_exit([phase]() noexcept { _TraceLoadPhase(phase, false); });
 }
 
 static std::tuple<size_t, size_t> _LineAndColumnFromPosition(const std::string_view string, ptrdiff_t position)
@@ -143,9 +155,22 @@ static void _CatchRethrowSerializationExceptionWithLocationInfo(std::string_view
 // - a unique_ptr containing a new CascadiaSettings object.
 winrt::Microsoft::Terminal::Settings::Model::CascadiaSettings CascadiaSettings::LoadAll()
 {
+    const auto loadAllTrace = _TraceLoadPhaseScope("LoadAll");
+
     try
     {
+        // Reading the fragments takes a while, mostly because we have to ask the
+        // AppExtensionCatalog for them. None of that depends on the settings,
+        // so it happens in the background while we parse and layer the rest.
+        auto fragments = std::async(std::launch::async, []() {
+            const auto coInit = wil::CoInitializeEx(COINIT_MULTITHREADED);
+            return _ReadFragmentFiles();
+        });
+
+        auto defaultsTrace = _TraceLoadPhaseScope("LoadDefaults");
         auto settings = LoadDefaults();
+        defaultsTrace.reset();
+
         auto resultPtr = winrt::get_self<CascadiaSettings>(settings);
         resultPtr->ClearWarnings();
 
@@ -154,6 +179,7 @@ winrt::Microsoft::Terminal::Settings::Model::CascadiaSettings CascadiaSettings::
         // the user's preferences are loaded and layered.
         const auto hardcodedDefaultGuid = resultPtr->GlobalSettings().DefaultProfile();
 
+        auto userSettingsTrace = _TraceLoadPhaseScope("ParseUserSettings");
         std::optional<std::string> fileData = _ReadUserSettings();
 
         // Make sure the file isn't totally empty. If it is, we'll treat the file
@@ -164,16 +190,22 @@ winrt::Microsoft::Terminal::Settings::Model::CascadiaSettings CascadiaSettings::
         {
             resultPtr->_ParseJsonString(*fileData, false);
         }
+        userSettingsTrace.reset();
 
         // Load profiles from dynamic profile generators. _userSettings should be
         // created by now, because we're going to check in there for any generators
         // that should be disabled (if the user had any settings.)
+        auto dynamicProfilesTrace = _TraceLoadPhaseScope("DynamicProfiles");
         resultPtr->_LoadDynamicProfiles();
+        dynamicProfilesTrace.reset();
+
+        auto fragmentsTrace = _TraceLoadPhaseScope("Fragments");
         try
         {
-            resultPtr->_LoadFragmentExtensions();
+            resultPtr->_LoadFragmentExtensions(fragments.get());
         }
         CATCH_LOG();
+        fragmentsTrace.reset();
 
         if (!fileHasData)
         {
@@ -185,6 +217,7 @@ winrt::Microsoft::Terminal::Settings::Model::CascadiaSettings CascadiaSettings::
             needToWriteFile = true;
         }
 
+        auto layerTrace = _TraceLoadPhaseScope("LayerUserSettings");
         try
         {
             // See microsoft/terminal#2325: find the defaultSettings from the user's
@@ -202,6 +235,7 @@ winrt::Microsoft::Terminal::Settings::Model::CascadiaSettings CascadiaSettings::
         {
             _CatchRethrowSerializationExceptionWithLocationInfo(resultPtr->_userSettingsString);
         }
+        layerTrace.reset();
 
         // Let's say a user doesn't know that they need to write `"hidden": true` in
         // order to prevent a profile from showing up (and a settings UI doesn't exist).
@@ -274,6 +308,7 @@ winrt::Microsoft::Terminal::Settings::Model::CascadiaSettings CascadiaSettings::
         }
 
         // If this throws, the app will catch it and use the default settings
+        const auto validateTrace = _TraceLoadPhaseScope("Validate");
         resultPtr->_ValidateSettings();
 
         return *resultPtr;
@@ -346,7 +381,10 @@ winrt::Microsoft::Terminal::Settings::Model::CascadiaSettings CascadiaSettings::
     // We already have the defaults in memory, because we stamp them into a
     // header as part of the build process. We don't need to bother with reading
     // them from a file (and the potential that could fail)
-    resultPtr->_ParseJsonString(DefaultJson, true);
+    // They never change while we're running either, but we need them for every
+    // (re)load of the settings. So we only parse them once and copy them afterwards.
+    static const auto defaultSettings = _ParseUtf8JsonString(DefaultJson);
+    resultPtr->_defaultSettings = defaultSettings;
     resultPtr->LayerJson(resultPtr->_defaultSettings);
     resultPtr->_ResolveDefaultProfile();
     resultPtr->_UpdateActiveProfiles();
@@ -383,38 +421,60 @@ void CascadiaSettings::_LoadDynamicProfiles()
         }
     }
 
+    // The generators spend most of their time waiting on the file system, the
+    // registry or (in case of WSL) even on another process. They don't depend
+    // on each other, so we run them all at once and only wait for the slowest one.
+    std::vector<std::pair<std::wstring, std::future<std::vector<Model::Profile>>>> pendingProfiles;
+    pendingProfiles.reserve(_profileGenerators.size());
+
     for (auto& generator : _profileGenerators)
     {
-        const std::wstring generatorNamespace{ generator->GetNamespace() };
+        std::wstring generatorNamespace{ generator->GetNamespace() };
 
         if (ignoredNamespaces.find(generatorNamespace) != ignoredNamespaces.end())
         {
             // namespace should be ignored
+            continue;
         }
-        else
+
+        try
         {
-            try
+            auto profiles = std::async(std::launch::async, [generator = generator.get()]() {
+                // The PowerShell generator asks the PackageManager for packages.
+                const auto coInit = wil::CoInitializeEx(COINIT_MULTITHREADED);
+                return generator->GenerateProfiles();
+            });
+            pendingProfiles.emplace_back(std::move(generatorNamespace), std::move(profiles));
+        }
+        CATCH_LOG_MSG("Dynamic Profile Namespace: \"%ls\"", generatorNamespace.data());
+    }
+
+    // Collect the results in the order of _profileGenerators,
+    // so that the profiles are always listed in the same order.
+    for (auto& [generatorNamespace, pending] : pendingProfiles)
+    {
+        try
+        {
+            auto profiles = pending.get();
+            for (auto& profile : profiles)
             {
-                auto profiles = generator->GenerateProfiles();
-                for (auto& profile : profiles)
-                {
-                    profile.Source(generatorNamespace);
+                profile.Source(generatorNamespace);
 
-                    _allProfiles.Append(profile);
-                }
+                _allProfiles.Append(profile);
             }
-            CATCH_LOG_MSG("Dynamic Profile Namespace: \"%ls\"", generatorNamespace.data());
         }
+        CATCH_LOG_MSG("Dynamic Profile Namespace: \"%ls\"", generatorNamespace.data());
     }
 }
 
 // Method Description:
-// - Searches the local app data folder, global app data folder and app
-//   extensions for json stubs we should use to create new profiles,
+// - Uses the json stubs found by _ReadFragmentFiles to create new profiles,
 //   modify existing profiles or add new color schemes
 // - If the user settings has any namespaces in the "disabledProfileSources"
-//   property, we'll ensure that the corresponding folders do not get searched
-void CascadiaSettings::_LoadFragmentExtensions()
+//   property, we'll ensure that the corresponding fragments do not get applied
+// Arguments:
+// - fragments: the json files of all the fragment extensions
+void CascadiaSettings::_LoadFragmentExtensions(const std::vector<FragmentFiles>& fragments)
 {
     // First, accumulate the namespaces the user wants to ignore
     std::unordered_set<std::wstring> ignoredNamespaces;
@@ -427,6 +487,28 @@ void CascadiaSettings::_LoadFragmentExtensions()
         }
     }
 
+    for (const auto& fragment : fragments)
+    {
+        // Only apply the stubs if the source is not in ignored namespaces
+        if (ignoredNamespaces.find(fragment.source.c_str()) == ignoredNamespaces.end())
+        {
+            _ParseAndLayerFragmentFiles(fragment.files, fragment.source);
+        }
+    }
+}
+
+// Method Description:
+// - Searches the local app data folder, global app data folder and app
+//   extensions for json stubs. This doesn't touch any settings, so that
+//   it can run in parallel to loading them.
+// Arguments:
+// - <none>
+// Return Value:
+// - the json files of all the fragment extensions, in the order they should be applied
+std::vector<CascadiaSettings::FragmentFiles> CascadiaSettings::_ReadFragmentFiles()
+{
+    std::vector<FragmentFiles> fragments;
+
     // Search through the local app data folder
     wil::unique_cotaskmem_string localAppDataFolder;
     THROW_IF_FAILED(SHGetKnownFolderPath(FOLDERID_LocalAppData, 0, nullptr, &localAppDataFolder));
@@ -434,7 +516,7 @@ void CascadiaSettings::_LoadFragmentExtensions()
 
     if (std::filesystem::exists(localAppDataFragments))
     {
-        _ApplyJsonStubsHelper(localAppDataFragments, ignoredNamespaces);
+        _AccumulateFragmentDirectories(localAppDataFragments, fragments);
     }
 
     // Search through the program data folder
@@ -443,66 +525,55 @@ void CascadiaSettings::_LoadFragmentExtensions()
     auto programDataFragments = std::wstring(programDataFolder.get()) + FragmentsPath.data();
     if (std::filesystem::exists(programDataFragments))
     {
-        _ApplyJsonStubsHelper(programDataFragments, ignoredNamespaces);
+        _AccumulateFragmentDirectories(programDataFragments, fragments);
     }
 
     // Search through app extensions
     // Gets the catalog of extensions with the name "com.microsoft.windows.terminal.settings"
     const auto catalog = Windows::ApplicationModel::AppExtensions::AppExtensionCatalog::Open(winrt::to_hstring(AppExtensionHostName));
 
-    auto extensions = _extractValueFromTaskWithoutMainThreadAwait(catalog.FindAllAsync());
+    // We're on a background thread, so we're allowed to simply wait for the async operations.
+    const auto extensions = catalog.FindAllAsync().get();
 
     for (const auto& ext : extensions)
     {
-        // Only apply the stubs if the package name is not in ignored namespaces
-        if (ignoredNamespaces.find(ext.Package().Id().FamilyName().c_str()) == ignoredNamespaces.end())
-        {
-            // Likewise, getting the public folder from an extension is an async operation
-            // So we use another mutex and condition variable
-            auto foundFolder = _extractValueFromTaskWithoutMainThreadAwait(ext.GetPublicFolderAsync());
+        const auto foundFolder = ext.GetPublicFolderAsync().get();
 
-            if (foundFolder)
+        if (foundFolder)
+        {
+            // the StorageFolder class has its own methods for obtaining the files within the folder
+            // however, all those methods are Async methods
+            // so for now we will just take the folder path and access the files that way
+            auto path = winrt::to_string(foundFolder.Path());
+            path.append(FragmentsSubDirectory);
+
+            // If the directory exists, use the fragments in it
+            if (std::filesystem::exists(path))
             {
-                // the StorageFolder class has its own methods for obtaining the files within the folder
-                // however, all those methods are Async methods
-                // you may have noticed that we need to resort to clunky implementations for async operations
-                // (they are in _extractValueFromTaskWithoutMainThreadAwait)
-                // so for now we will just take the folder path and access the files that way
-                auto path = winrt::to_string(foundFolder.Path());
-                path.append(FragmentsSubDirectory);
-
-                // If the directory exists, use the fragments in it
-                if (std::filesystem::exists(path))
-                {
-                    const auto jsonFiles = _AccumulateJsonFilesInDirectory(til::u8u16(path));
-
-                    // Provide the package name as the source
-                    _ParseAndLayerFragmentFiles(jsonFiles, ext.Package().Id().FamilyName().c_str());
-                }
+                // Provide the package name as the source
+                fragments.push_back({ ext.Package().Id().FamilyName(), _AccumulateJsonFilesInDirectory(til::u8u16(path)) });
             }
         }
     }
+
+    return fragments;
 }
 
 // Method Description:
-// - Helper function to apply json stubs in the local app data folder and the global program data folder
+// - Helper function to find json stubs in the local app data folder and the global program data folder
 // Arguments:
 // - The directory to find json files in
-// - The set of ignored namespaces
-void CascadiaSettings::_ApplyJsonStubsHelper(const std::wstring_view directory, const std::unordered_set<std::wstring>& ignoredNamespaces)
+// - The list of fragments to append the found files to
+void CascadiaSettings::_AccumulateFragmentDirectories(const std::wstring_view directory, std::vector<FragmentFiles>& fragments)
 {
     // The json files should be within subdirectories where the subdirectory name is the app name
     for (const auto& fragmentExtFolder : std::filesystem::directory_iterator(directory))
     {
-        // We only want the parent folder name as the source (not the full path)
-        const auto source = fragmentExtFolder.path().filename().wstring();
-
-        // Only apply the stubs if the parent folder name is not in ignored namespaces
         // (also make sure this is a directory for sanity)
-        if (std::filesystem::is_directory(fragmentExtFolder) && ignoredNamespaces.find(source) == ignoredNamespaces.end())
+        if (std::filesystem::is_directory(fragmentExtFolder))
         {
-            const auto jsonFiles = _AccumulateJsonFilesInDirectory(fragmentExtFolder.path().c_str());
-            _ParseAndLayerFragmentFiles(jsonFiles, winrt::hstring{ source });
+            // We only want the parent folder name as the source (not the full path)
+            fragments.push_back({ winrt::hstring{ fragmentExtFolder.path().filename().wstring() }, _AccumulateJsonFilesInDirectory(fragmentExtFolder.path().c_str()) });
         }
     }
 }
@@ -549,7 +620,7 @@ void CascadiaSettings::_ParseAndLayerFragmentFiles(const std::unordered_set<std:
         {
             // Now we separately get each stub that modifies/adds a profile
             // We intentionally don't use a const reference here because we modify
-            // the profile stub by giving it a guid so we can call _FindMatchingProfile
+            // the profile stub by giving it a guid so we can call _FindMatchingProfileIndex
             for (auto& profileStub : fullFile[JsonKey(ProfilesKey)])
             {
                 if (profileStub.isMember(JsonKey(UpdatesKey)))
@@ -557,19 +628,20 @@ void CascadiaSettings::_ParseAndLayerFragmentFiles(const std::unordered_set<std:
                     // This stub is meant to be a modification to an existing profile,
                     // try to find the matching profile
                     profileStub[JsonKey(GuidKey)] = profileStub[JsonKey(UpdatesKey)];
-                    auto matchingProfile = _FindMatchingProfile(profileStub);
-                    if (matchingProfile)
+                    const auto matchingIndex = _FindMatchingProfileIndex(profileStub);
+                    if (matchingIndex)
                     {
                         try
                         {
                             // We found a matching profile, create a child of it and put the modifications there
                             // (we add a new inheritance layer)
+                            const auto matchingProfile{ winrt::get_self<Profile>(_allProfiles.GetAt(*matchingIndex)) };
                             auto childImpl{ matchingProfile->CreateChild() };
                             childImpl->LayerJson(profileStub);
                             childImpl->Origin(OriginTag::Fragment);
 
                             // replace parent in _profiles with child
-                            _allProfiles.SetAt(_FindMatchingProfileIndex(matchingProfile->ToJson()).value(), *childImpl);
+                            _allProfiles.SetAt(*matchingIndex, *childImpl);
                         }
                         catch (...)
                         {
@@ -989,18 +1061,71 @@ winrt::com_ptr<Profile> CascadiaSettings::_FindMatchingProfile(const Json::Value
 // - The index for the matching Profile, iff it exists. Otherwise, nullopt.
 std::optional<uint32_t> CascadiaSettings::_FindMatchingProfileIndex(const Json::Value& profileJson)
 {
-    for (uint32_t i = 0; i < _allProfiles.Size(); ++i)
+    // A profile can only be layered upon one with the same GUID, so instead of
+    // asking every single profile, we only ask those with the GUID in question.
+    const auto guid{ Profile::GetLayeringGuidForJson(profileJson) };
+
+    for (auto retry = 0; retry < 2; ++retry)
     {
-        const auto profile{ _allProfiles.GetAt(i) };
-        const auto profileImpl = winrt::get_self<Profile>(profile);
-        if (profileImpl->ShouldBeLayered(profileJson))
+        if (retry || _profileIndicesByGuidSize != _allProfiles.Size())
+        {
+            _RebuildProfileIndicesByGuid();
+        }
+
+        const auto it{ _profileIndicesByGuid.find(guid) };
+        if (it == _profileIndicesByGuid.end())
         {
-            return i;
+            return std::nullopt;
+        }
+
+        bool stale = false;
+        for (const auto i : it->second)
+        {
+            const auto profile{ _allProfiles.GetAt(i) };
+            const auto profileImpl = winrt::get_self<Profile>(profile);
+            if (profileImpl->Guid() != guid)
+            {
+                // The profiles were rearranged since we built the index.
+                stale = true;
+                break;
+            }
+            if (profileImpl->ShouldBeLayered(profileJson))
+            {
+                return i;
+            }
+        }
+
+        if (!stale)
+        {
+            break;
         }
     }
     return std::nullopt;
 }
 
+// Method Description:
+// - Rebuilds the index of _allProfiles used by _FindMatchingProfileIndex.
+//   Profiles only ever get replaced by children of themselves while we're
+//   layering, which doesn't change their GUID. So the index only needs to be
+//   rebuilt when profiles are added or removed, or when they're reordered,
+//   which _FindMatchingProfileIndex notices.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void CascadiaSettings::_RebuildProfileIndicesByGuid()
+{
+    _profileIndicesByGuid.clear();
+
+    const auto size{ _allProfiles.Size() };
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        const auto profile{ _allProfiles.GetAt(i) };
+        _profileIndicesByGuid[profile.Guid()].emplace_back(i);
+    }
+    _profileIndicesByGuidSize = size;
+}
+
 // Method Description:
 // - Finds the "default profile settings" if they exist in the users settings,
 //   and applies them to the existing profiles. The "default profile settings"
@@ -1048,6 +1173,11 @@ void CascadiaSettings::_ApplyDefaultsFromUserSettings()
         // replace parent in _profiles with child
         _allProfiles.SetAt(profileIndex, *childImpl);
     }
+
+    // The defaults might have given a name to profiles that don't have
+    // an explicit GUID, and thus new GUIDs. Let the index be rebuilt.
+    _profileIndicesByGuidSize = 0;
+    _profileIndicesByGuid.clear();
 }
 
 // Method Description:
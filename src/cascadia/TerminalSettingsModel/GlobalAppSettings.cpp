@@ -58,6 +58,7 @@ static constexpr std::string_view ForceFullRepaintRenderingKey{ "experimental.re
 static constexpr std::string_view SoftwareRenderingKey{ "experimental.rendering.software" };
 static constexpr std::string_view ForceVTInputKey{ "experimental.input.forceVT" };
 static constexpr std::string_view DetectURLsKey{ "experimental.detectURLs" };
+static constexpr std::string_view SessionRecordingDirectoryKey{ "experimental.sessionRecordingDirectory" };
 
 #ifdef _DEBUG
 static constexpr bool debugFeaturesDefault{ true };
@@ -135,6 +136,7 @@ winrt::com_ptr<GlobalAppSettings> GlobalAppSettings::Copy() const
     globals->_DetectURLs = _DetectURLs;
     globals->_MinimizeToTray = _MinimizeToTray;
     globals->_AlwaysShowTrayIcon = _AlwaysShowTrayIcon;
+    globals->_SessionRecordingDirectory = _SessionRecordingDirectory;
 
     globals->_UnparsedDefaultProfile = _UnparsedDefaultProfile;
     globals->_validDefaultProfile = _validDefaultProfile;
@@ -331,6 +333,8 @@ void GlobalAppSettings::LayerJson(const Json::Value& json)
 
     JsonUtils::GetValueForKey(json, AlwaysShowTrayIconKey, _AlwaysShowTrayIcon);
 
+    JsonUtils::GetValueForKey(json, SessionRecordingDirectoryKey, _SessionRecordingDirectory);
+
     // This is a helper lambda to get the keybindings and commands out of both
     // and array of objects. We'll use this twice, once on the legacy
     // `keybindings` key, and again on the newer `bindings` key.
@@ -429,6 +433,7 @@ Json::Value GlobalAppSettings::ToJson() const
     JsonUtils::SetValueForKey(json, DetectURLsKey,                  _DetectURLs);
     JsonUtils::SetValueForKey(json, MinimizeToTrayKey,              _MinimizeToTray);
     JsonUtils::SetValueForKey(json, AlwaysShowTrayIconKey,          _AlwaysShowTrayIcon);
+    JsonUtils::SetValueForKey(json, SessionRecordingDirectoryKey,   _SessionRecordingDirectory);
     // clang-format on
 
     json[JsonKey(ActionsKey)] = _actionMap->ToJson();
@@ -101,6 +101,7 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         INHERITABLE_SETTING(Model::GlobalAppSettings, bool, DetectURLs, true);
         INHERITABLE_SETTING(Model::GlobalAppSettings, bool, MinimizeToTray, false);
         INHERITABLE_SETTING(Model::GlobalAppSettings, bool, AlwaysShowTrayIcon, false);
+        INHERITABLE_SETTING(Model::GlobalAppSettings, hstring, SessionRecordingDirectory, L"");
 
     private:
         guid _defaultProfile;
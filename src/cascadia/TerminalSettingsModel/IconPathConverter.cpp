@@ -3,6 +3,7 @@
 #include "IconPathConverter.g.cpp"
 
 #include "Utils.h"
+#include "../inc/ImageCache.h"
 
 using namespace winrt::Windows;
 using namespace winrt::Windows::UI::Xaml;
@@ -53,6 +54,9 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
     // - Creates an IconSource for the given path. The icon returned is a colored
     //   icon. If we couldn't create the icon for any reason, we return an empty
     //   IconElement.
+    // - IconSources can be shared between any number of icons, so every tab,
+    //   tab header and command palette item showing this path gets the same
+    //   one and the image is only decoded once. See ImageCache.
     // Template Types:
     // - <TIconSource>: The type of IconSource (MUX, WUX) to generate.
     // Arguments:
@@ -66,14 +70,16 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         {
             try
             {
-                winrt::Windows::Foundation::Uri iconUri{ path };
-                BitmapIconSource<TIconSource>::type iconSource;
-                // Make sure to set this to false, so we keep the RGB data of the
-                // image. Otherwise, the icon will be white for all the
-                // non-transparent pixels in the image.
-                iconSource.ShowAsMonochrome(false);
-                iconSource.UriSource(iconUri);
-                return iconSource;
+                return ImageCache<TIconSource>::ForThread().GetOrCreate(path, [](const winrt::hstring& uri) -> TIconSource {
+                    winrt::Windows::Foundation::Uri iconUri{ uri };
+                    BitmapIconSource<TIconSource>::type iconSource;
+                    // Make sure to set this to false, so we keep the RGB data of the
+                    // image. Otherwise, the icon will be white for all the
+                    // non-transparent pixels in the image.
+                    iconSource.ShowAsMonochrome(false);
+                    iconSource.UriSource(iconUri);
+                    return iconSource;
+                });
             }
             CATCH_LOG();
         }
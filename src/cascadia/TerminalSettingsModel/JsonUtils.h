@@ -60,6 +60,86 @@ namespace Microsoft::Terminal::Settings::Model::JsonUtils
             const std::string_view zeroCopyString{ begin, gsl::narrow_cast<size_t>(end - begin) };
             return zeroCopyString;
         }
+
+        inline constexpr uint32_t NoSeed{ UINT32_MAX };
+        inline constexpr uint8_t EmptySlot{ UINT8_MAX };
+
+        // Function Description:
+        // - FNV-1a, with the given seed mixed into the offset basis.
+        constexpr uint32_t HashEnumName(const std::string_view name, const uint32_t seed) noexcept
+        {
+            uint32_t hash{ 2166136261u ^ seed };
+            for (const auto ch : name)
+            {
+                hash ^= static_cast<uint8_t>(ch);
+                hash *= 16777619u;
+            }
+            return hash;
+        }
+
+        constexpr size_t EnumNameTableSize(const size_t count) noexcept
+        {
+            size_t size{ 4 };
+            while (size < 4 * count)
+            {
+                size *= 2;
+            }
+            return size;
+        }
+
+        // A perfect hash table from the names of an EnumMapper's mappings to
+        // their index, built at compile time (see MakeEnumNameTable). No two
+        // names share a slot, so looking up a name hashes it once and compares
+        // it to at most one of the mappings.
+        template<size_t N>
+        struct EnumNameTable
+        {
+            static_assert(N < EmptySlot, "too many mappings for an EnumNameTable");
+            static constexpr size_t Size{ EnumNameTableSize(N) };
+
+            std::array<uint8_t, Size> slots{};
+            uint32_t seed{ NoSeed };
+
+            // Returns the index of the only mapping that may be called name, or EmptySlot.
+            constexpr size_t Find(const std::string_view name) const noexcept
+            {
+                return slots[HashEnumName(name, seed) & (Size - 1)];
+            }
+        };
+
+        // Function Description:
+        // - Tries seeds until one of them hashes every name into a slot of its
+        //   own. The table is at least 4 times as large as there are names, so
+        //   this rarely needs more than a couple of tries. If there's no such
+        //   seed (for instance because a name appears twice), the seed of the
+        //   table is NoSeed.
+        template<typename Pair, size_t N>
+        constexpr EnumNameTable<N> MakeEnumNameTable(const std::array<Pair, N>& mappings) noexcept
+        {
+            EnumNameTable<N> table{};
+            for (uint32_t seed = 0; seed < 1024; ++seed)
+            {
+                for (auto& slot : table.slots)
+                {
+                    slot = EmptySlot;
+                }
+
+                auto collided{ false };
+                for (size_t i = 0; i < N && !collided; ++i)
+                {
+                    auto& slot{ table.slots[HashEnumName(mappings[i].first, seed) & (table.Size - 1)] };
+                    collided = slot != EmptySlot;
+                    slot = static_cast<uint8_t>(i);
+                }
+
+                if (!collided)
+                {
+                    table.seed = seed;
+                    break;
+                }
+            }
+            return table;
+        }
     }
 
     template<typename T>
@@ -705,13 +785,15 @@ namespace Microsoft::Terminal::Settings::Model::JsonUtils
         using pair_type = std::pair<std::string_view, T>;
         T FromJson(const Json::Value& json)
         {
+            // The table lives in a function, so that it's only built once
+            // TBase (and thus its mappings) is complete.
+            static constexpr auto table{ Detail::MakeEnumNameTable(TBase::mappings) };
+            static_assert(table.seed != Detail::NoSeed, "the names of the mappings must be unique");
+
             const auto name{ Detail::GetStringView(json) };
-            for (const auto& pair : TBase::mappings)
+            if (const auto index{ table.Find(name) }; index != Detail::EmptySlot && TBase::mappings[index].first == name)
             {
-                if (pair.first == name)
-                {
-                    return pair.second;
-                }
+                return TBase::mappings[index].second;
             }
 
             DeserializationError e{ json };
@@ -30,6 +30,7 @@ static constexpr std::string_view HiddenKey{ "hidden" };
 static constexpr std::string_view TabTitleKey{ "tabTitle" };
 static constexpr std::string_view SuppressApplicationTitleKey{ "suppressApplicationTitle" };
 static constexpr std::string_view HistorySizeKey{ "historySize" };
+static constexpr std::string_view ScrollbackSpillDirectoryKey{ "scrollbackSpillDirectory" };
 static constexpr std::string_view SnapOnInputKey{ "snapOnInput" };
 static constexpr std::string_view AltGrAliasingKey{ "altGrAliasing" };
 
@@ -104,6 +105,7 @@ winrt::com_ptr<Profile> Profile::CopySettings(winrt::com_ptr<Profile> source)
     profile->_ForceFullRepaintRendering = source->_ForceFullRepaintRendering;
     profile->_SoftwareRendering = source->_SoftwareRendering;
     profile->_HistorySize = source->_HistorySize;
+    profile->_ScrollbackSpillDirectory = source->_ScrollbackSpillDirectory;
     profile->_SnapOnInput = source->_SnapOnInput;
     profile->_AltGrAliasing = source->_AltGrAliasing;
     profile->_BellStyle = source->_BellStyle;
@@ -266,27 +268,13 @@ bool Profile::ShouldBeLayered(const Json::Value& json) const
 {
     // First, check that GUIDs match. This is easy. If they don't match, they
     // should _definitely_ not layer.
-    const auto otherGuid{ JsonUtils::GetValueForKey<std::optional<winrt::guid>>(json, GuidKey) };
-    const auto otherSource{ JsonUtils::GetValueForKey<std::optional<winrt::hstring>>(json, SourceKey) };
-    if (otherGuid)
-    {
-        if (otherGuid.value() != Guid())
-        {
-            return false;
-        }
-    }
-    else
+    if (GetLayeringGuidForJson(json) != Guid())
     {
-        // If the other json object didn't have a GUID,
-        // check if we auto-generate the same guid using the name and source.
-        const auto otherName{ JsonUtils::GetValueForKey<std::optional<winrt::hstring>>(json, NameKey) };
-        if (Guid() != _GenerateGuidForProfile(otherName ? *otherName : L"Default", otherSource ? *otherSource : L""))
-        {
-            return false;
-        }
+        return false;
     }
 
     // For profiles with a `source`, also check the `source` property.
+    const auto otherSource{ JsonUtils::GetValueForKey<std::optional<winrt::hstring>>(json, SourceKey) };
     bool sourceMatches = false;
     const auto mySource{ Source() };
     if (!mySource.empty())
@@ -319,6 +307,26 @@ bool Profile::ShouldBeLayered(const Json::Value& json) const
     return sourceMatches;
 }
 
+// Method Description:
+// - Returns the GUID of the profile that the given json object would be
+//   layered upon (see ShouldBeLayered). If the json object doesn't have a
+//   GUID, it's the one we auto-generate from its name and source.
+// Arguments:
+// - json: an object which may be a partial serialization of a Profile object.
+// Return Value:
+// - the GUID a profile needs to have for the json to be layered upon it
+winrt::guid Profile::GetLayeringGuidForJson(const Json::Value& json)
+{
+    if (const auto otherGuid{ JsonUtils::GetValueForKey<std::optional<winrt::guid>>(json, GuidKey) })
+    {
+        return *otherGuid;
+    }
+
+    const auto otherName{ JsonUtils::GetValueForKey<std::optional<winrt::hstring>>(json, NameKey) };
+    const auto otherSource{ JsonUtils::GetValueForKey<std::optional<winrt::hstring>>(json, SourceKey) };
+    return _GenerateGuidForProfile(otherName ? *otherName : L"Default", otherSource ? *otherSource : L"");
+}
+
 // Method Description:
 // - Layer values from the given json object on top of the existing properties
 //   of this object. For any keys we're expecting to be able to parse in the
@@ -349,6 +357,7 @@ void Profile::LayerJson(const Json::Value& json)
 
     // TODO:MSFT:20642297 - Use a sentinel value (-1) for "Infinite scrollback"
     JsonUtils::GetValueForKey(json, HistorySizeKey, _HistorySize);
+    JsonUtils::GetValueForKey(json, ScrollbackSpillDirectoryKey, _ScrollbackSpillDirectory);
     JsonUtils::GetValueForKey(json, SnapOnInputKey, _SnapOnInput);
     JsonUtils::GetValueForKey(json, AltGrAliasingKey, _AltGrAliasing);
     JsonUtils::GetValueForKey(json, TabTitleKey, _TabTitle);
@@ -541,6 +550,7 @@ Json::Value Profile::ToJson() const
 
     // TODO:MSFT:20642297 - Use a sentinel value (-1) for "Infinite scrollback"
     JsonUtils::SetValueForKey(json, HistorySizeKey, _HistorySize);
+    JsonUtils::SetValueForKey(json, ScrollbackSpillDirectoryKey, _ScrollbackSpillDirectory);
     JsonUtils::SetValueForKey(json, SnapOnInputKey, _SnapOnInput);
     JsonUtils::SetValueForKey(json, AltGrAliasingKey, _AltGrAliasing);
     JsonUtils::SetValueForKey(json, TabTitleKey, _TabTitle);
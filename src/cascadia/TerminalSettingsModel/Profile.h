@@ -100,6 +100,7 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
 
         hstring EvaluatedStartingDirectory() const;
         static guid GetGuidOrGenerateForJson(const Json::Value& json) noexcept;
+        static guid GetLayeringGuidForJson(const Json::Value& json);
 
         Model::IAppearanceConfig DefaultAppearance();
         Model::FontConfig FontInfo();
@@ -137,6 +138,7 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         INHERITABLE_SETTING(Model::Profile, bool, SoftwareRendering, false);
 
         INHERITABLE_SETTING(Model::Profile, int32_t, HistorySize, DEFAULT_HISTORY_SIZE);
+        INHERITABLE_SETTING(Model::Profile, hstring, ScrollbackSpillDirectory);
         INHERITABLE_SETTING(Model::Profile, bool, SnapOnInput, true);
         INHERITABLE_SETTING(Model::Profile, bool, AltGrAliasing, true);
 
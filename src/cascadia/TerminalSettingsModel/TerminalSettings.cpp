@@ -267,6 +267,7 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
     {
         // Fill in the Terminal Setting's CoreSettings from the profile
         _HistorySize = profile.HistorySize();
+        _ScrollbackSpillDirectory = profile.ScrollbackSpillDirectory();
         _SnapOnInput = profile.SnapOnInput();
         _AltGrAliasing = profile.AltGrAliasing();
 
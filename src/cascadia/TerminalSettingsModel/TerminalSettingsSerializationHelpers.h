@@ -42,9 +42,10 @@ JSON_ENUM_MAPPER(::winrt::Windows::UI::Xaml::Media::Stretch)
 
 JSON_ENUM_MAPPER(::winrt::Microsoft::Terminal::Control::ScrollbarState)
 {
-    static constexpr std::array<pair_type, 2> mappings = {
+    static constexpr std::array<pair_type, 3> mappings = {
         pair_type{ "visible", ValueType::Visible },
-        pair_type{ "hidden", ValueType::Hidden }
+        pair_type{ "hidden", ValueType::Hidden },
+        pair_type{ "minimap", ValueType::Minimap }
     };
 };
 
@@ -373,8 +374,9 @@ JSON_ENUM_MAPPER(::winrt::Microsoft::Terminal::Settings::Model::SplitState)
 // Possible SplitType values
 JSON_ENUM_MAPPER(::winrt::Microsoft::Terminal::Settings::Model::SplitType)
 {
-    JSON_MAPPINGS(1) = {
+    JSON_MAPPINGS(2) = {
         pair_type{ "duplicate", ValueType::Duplicate },
+        pair_type{ "mirror", ValueType::Mirror },
     };
 };
 
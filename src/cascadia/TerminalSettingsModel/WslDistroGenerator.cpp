@@ -12,6 +12,7 @@
 #include <io.h>
 #include <fcntl.h>
 #include "DefaultProfileUtils.h"
+#include "ApplicationState.h"
 
 static constexpr std::wstring_view DockerDistributionPrefix{ L"docker-desktop" };
 
@@ -36,15 +37,15 @@ std::wstring_view WslDistroGenerator::GetNamespace()
     return WslGeneratorNamespace;
 }
 
-// Method Description:
-// -  Enumerates all the installed WSL distros to create profiles for them.
+// Function Description:
+// - Enumerates all the installed WSL distros by asking wsl.exe to list them.
 // Arguments:
-// - <none>
+// - wslPath: the path to wsl.exe
 // Return Value:
-// - a vector with all distros for all the installed WSL distros
-static std::vector<Profile> legacyGenerate()
+// - the names of all the installed WSL distros, or nullopt if wsl.exe didn't answer in time
+static std::optional<std::vector<std::wstring>> legacyGetNames(const std::wstring& wslPath)
 {
-    std::vector<Profile> profiles;
+    std::vector<std::wstring> names;
 
     wil::unique_handle readPipe;
     wil::unique_handle writePipe;
@@ -56,10 +57,8 @@ static std::vector<Profile> legacyGenerate()
     si.hStdOutput = writePipe.get();
     si.hStdError = writePipe.get();
     wil::unique_process_information pi;
-    wil::unique_cotaskmem_string systemPath;
-    THROW_IF_FAILED(wil::GetSystemDirectoryW(systemPath));
-    std::wstring command(systemPath.get());
-    command += L"\\wsl.exe --list";
+    std::wstring command{ wslPath };
+    command += L" --list";
 
     THROW_IF_WIN32_BOOL_FALSE(CreateProcessW(nullptr,
                                              const_cast<LPWSTR>(command.c_str()),
@@ -77,7 +76,7 @@ static std::vector<Profile> legacyGenerate()
         break;
     case WAIT_ABANDONED:
     case WAIT_TIMEOUT:
-        return profiles;
+        return std::nullopt;
     case WAIT_FAILED:
         THROW_LAST_ERROR();
     default:
@@ -90,7 +89,7 @@ static std::vector<Profile> legacyGenerate()
     }
     else if (exitCode != 0)
     {
-        return profiles;
+        return names;
     }
     DWORD bytesAvailable;
     THROW_IF_WIN32_BOOL_FALSE(PeekNamedPipe(readPipe.get(), nullptr, NULL, nullptr, &bytesAvailable, nullptr));
@@ -117,13 +116,6 @@ static std::vector<Profile> legacyGenerate()
             std::wstring distName;
             std::getline(wlinestream, distName, L'\r');
 
-            if (distName.substr(0, std::min(distName.size(), DockerDistributionPrefix.size())) == DockerDistributionPrefix)
-            {
-                // Docker for Windows creates some utility distributions to handle Docker commands.
-                // Pursuant to GH#3556, because they are _not_ user-facing we want to hide them.
-                continue;
-            }
-
             const size_t firstChar = distName.find_first_of(L"( ");
             // Some localizations don't have a space between the name and "(Default)"
             // https://github.com/microsoft/terminal/issues/1168#issuecomment-500187109
@@ -131,17 +123,67 @@ static std::vector<Profile> legacyGenerate()
             {
                 distName.resize(firstChar);
             }
-            auto WSLDistro{ CreateDefaultProfile(distName) };
-
-            WSLDistro.Commandline(L"wsl.exe -d " + distName);
-            WSLDistro.DefaultAppearance().ColorSchemeName(L"Campbell");
-            WSLDistro.StartingDirectory(DEFAULT_STARTING_DIRECTORY);
-            WSLDistro.Icon(L"ms-appx:///ProfileIcons/{9acb9455-ca41-5af7-950f-6bca1bc9722f}.png");
-            profiles.emplace_back(WSLDistro);
+            names.emplace_back(std::move(distName));
         }
     }
 
-    return profiles;
+    return names;
+}
+
+// Function Description:
+// - Identifies the installed wsl.exe by its size and modification time. If WSL
+//   gets installed, updated or removed, this changes, and so might the output
+//   of "wsl.exe --list".
+// Arguments:
+// - wslPath: the path to wsl.exe
+// Return Value:
+// - a string that changes along with wsl.exe, or nullopt if it doesn't exist
+static std::optional<std::wstring> getWslStamp(const std::wstring& wslPath)
+{
+    WIN32_FILE_ATTRIBUTE_DATA data{};
+    if (!GetFileAttributesExW(wslPath.c_str(), GetFileExInfoStandard, &data))
+    {
+        return std::nullopt;
+    }
+    return fmt::format(L"{:08x}{:08x}-{:x}-{:x}", data.ftLastWriteTime.dwHighDateTime, data.ftLastWriteTime.dwLowDateTime, data.nFileSizeHigh, data.nFileSizeLow);
+}
+
+// Function Description:
+// - Gets the names of the installed WSL distros from wsl.exe. Launching it
+//   takes a good while, and we end up here on every launch when WSL isn't set
+//   up at all (the registry key is missing then). So we remember its answer in
+//   the ApplicationState, until wsl.exe itself changes.
+// Arguments:
+// - <none>
+// Return Value:
+// - the names of all the installed WSL distros
+static std::vector<std::wstring> legacyGetCachedNames()
+{
+    wil::unique_cotaskmem_string systemPath;
+    THROW_IF_FAILED(wil::GetSystemDirectoryW(systemPath));
+    std::wstring wslPath(systemPath.get());
+    wslPath += L"\\wsl.exe";
+
+    const auto state = winrt::get_self<implementation::ApplicationState>(ApplicationState::SharedInstance());
+    const auto stamp = getWslStamp(wslPath);
+    if (stamp && state->WslDistroNamesStamp() == *stamp)
+    {
+        return state->WslDistroNames();
+    }
+
+    auto names = legacyGetNames(wslPath);
+    if (!names)
+    {
+        // wsl.exe timed out. That's not an answer worth remembering.
+        return {};
+    }
+
+    if (stamp)
+    {
+        state->WslDistroNames(*names);
+        state->WslDistroNamesStamp(*stamp);
+    }
+    return std::move(*names);
 }
 
 // Function Description:
@@ -298,7 +340,7 @@ static bool getWslNames(const wil::unique_hkey& wslRootKey,
 // - Generate a list of profiles for each on the installed WSL distros. This
 //   will first try to read the installed distros from the registry. If that
 //   fails, we'll fall back to the legacy way of launching WSL.exe to read the
-//   distros from the commandline. Reading the registry is slightly more stable
+//   distros from the commandline (or to its answer from the last time). Reading the registry is slightly more stable
 //   (see GH#7199, GH#9905), but it is certainly BODGY
 // Arguments:
 // - <none>
@@ -321,5 +363,5 @@ std::vector<Profile> WslDistroGenerator::GenerateProfiles()
         }
     }
 
-    return legacyGenerate();
+    return namesToProfiles(legacyGetCachedNames());
 }
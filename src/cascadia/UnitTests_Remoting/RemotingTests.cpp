@@ -112,6 +112,7 @@ namespace RemotingUnitTests
         TEST_METHOD(MostRecentIsQuake);
 
         TEST_METHOD(GetPeasantsByName);
+        TEST_METHOD(GetPeasantsByNameAfterSwappingNames);
         TEST_METHOD(AddNamedPeasantsToNewMonarch);
         TEST_METHOD(LookupNamedPeasantWhenOthersDied);
         TEST_METHOD(LookupNamedPeasantWhenItDied);
@@ -1064,6 +1065,41 @@ namespace RemotingUnitTests
         VERIFY_ARE_EQUAL(p2->GetID(), m0->_lookupPeasantIdForName(L"foo"));
     }
 
+    void RemotingTests::GetPeasantsByNameAfterSwappingNames()
+    {
+        Log::Comment(L"Test that a name lookup doesn't return the window that had the name during the previous lookup");
+
+        const auto monarch0PID = 12345u;
+        const auto peasant1PID = 23456u;
+        const auto peasant2PID = 34567u;
+
+        auto m0 = make_private<Remoting::implementation::Monarch>(monarch0PID);
+        auto p1 = make_private<Remoting::implementation::Peasant>(peasant1PID);
+        auto p2 = make_private<Remoting::implementation::Peasant>(peasant2PID);
+
+        p1->WindowName(L"one");
+        p2->WindowName(L"two");
+
+        m0->AddPeasant(*p1);
+        m0->AddPeasant(*p2);
+
+        VERIFY_ARE_EQUAL(p1->GetID(), m0->_lookupPeasantIdForName(L"one"));
+        VERIFY_ARE_EQUAL(p2->GetID(), m0->_lookupPeasantIdForName(L"two"));
+
+        Log::Comment(L"Swap the names of the two windows");
+
+        p1->WindowName(L"two");
+        p2->WindowName(L"one");
+
+        VERIFY_ARE_EQUAL(p2->GetID(), m0->_lookupPeasantIdForName(L"one"));
+        VERIFY_ARE_EQUAL(p1->GetID(), m0->_lookupPeasantIdForName(L"two"));
+
+        Log::Comment(L"Repeated lookups still find the same windows");
+
+        VERIFY_ARE_EQUAL(p2->GetID(), m0->_lookupPeasantIdForName(L"one"));
+        VERIFY_ARE_EQUAL(p1->GetID(), m0->_lookupPeasantIdForName(L"two"));
+    }
+
     void RemotingTests::AddNamedPeasantsToNewMonarch()
     {
         Log::Comment(L"Test that moving peasants to a new monarch persists their original names");
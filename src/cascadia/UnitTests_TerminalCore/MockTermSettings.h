@@ -34,6 +34,7 @@ namespace TerminalCoreUnitTests
         CursorStyle CursorShape() const noexcept { return CursorStyle::Vintage; }
         uint32_t CursorHeight() { return 42UL; }
         winrt::hstring WordDelimiters() { return winrt::hstring(DEFAULT_WORD_DELIMITERS); }
+        winrt::hstring ScrollbackSpillDirectory() { return {}; }
         bool CopyOnSelect() { return _copyOnSelect; }
         bool FocusFollowMouse() { return _focusFollowMouse; }
         winrt::hstring StartingTitle() { return _startingTitle; }
@@ -61,6 +62,7 @@ namespace TerminalCoreUnitTests
         void CursorShape(CursorStyle const&) noexcept {}
         void CursorHeight(uint32_t) {}
         void WordDelimiters(winrt::hstring) {}
+        void ScrollbackSpillDirectory(winrt::hstring) {}
         void CopyOnSelect(bool copyOnSelect) { _copyOnSelect = copyOnSelect; }
         void FocusFollowMouse(bool focusFollowMouse) { _focusFollowMouse = focusFollowMouse; }
         void StartingTitle(winrt::hstring const& value) { _startingTitle = value; }
@@ -12,6 +12,7 @@
 #include "../renderer/dx/DxRenderer.hpp"
 
 #include "../cascadia/TerminalCore/Terminal.hpp"
+#include "../cascadia/TerminalCore/MirrorRenderData.hpp"
 #include "MockTermSettings.h"
 #include "consoletaeftemplates.hpp"
 #include "TestUtils.h"
@@ -87,6 +88,7 @@ class TerminalCoreUnitTests::ScrollTest final
     TEST_CLASS(ScrollTest);
 
     TEST_METHOD(TestNotifyScrolling);
+    TEST_METHOD(TestMirrorViewport);
 
     TEST_METHOD_SETUP(MethodSetup)
     {
@@ -215,3 +217,46 @@ void ScrollTest::TestNotifyScrolling()
         }
     }
 }
+
+void ScrollTest::TestMirrorViewport()
+{
+    // A 4 row viewport above 6 rows of history, so that the buffer circles
+    // after 10 lines.
+    MockScrollRenderTarget renderTarget;
+    Terminal term;
+    term.Create({ 10, 4 }, 6, renderTarget);
+
+    MirrorRenderData mirror{ term };
+    mirror.SetViewHeight(2);
+    auto notifications = 0;
+    mirror.SetChangedCallback([&]() { ++notifications; });
+    term.AddMirror(mirror);
+
+    Log::Comment(L"The mirror follows the bottom of the mutable viewport.");
+    term.Write(L"1\r\n2\r\n3");
+    VERIFY_ARE_EQUAL(1, notifications);
+    VERIFY_ARE_EQUAL(2, mirror.ViewStartIndex());
+    VERIFY_ARE_EQUAL(2, mirror.ViewHeight());
+    VERIFY_ARE_EQUAL(2, mirror.GetViewport().Top());
+
+    Log::Comment(L"Once scrolled up, it stays on the same rows while the output continues.");
+    mirror.UserScrollViewport(1);
+    term.Write(L"\r\n4\r\n5\r\n6\r\n7\r\n8\r\n9\r\n10");
+    VERIFY_ARE_EQUAL(1, mirror.ViewStartIndex());
+    VERIFY_ARE_EQUAL(L'2', term.GetTextBuffer().GetRowByOffset(mirror.ViewStartIndex()).GetText().front());
+    // The terminal's own viewport mustn't move along with the mirror.
+    VERIFY_ARE_EQUAL(6, term.GetViewport().Top());
+
+    Log::Comment(L"Even when those rows move up because the buffer circled.");
+    term.Write(L"\r\n11");
+    VERIFY_ARE_EQUAL(0, mirror.ViewStartIndex());
+    VERIFY_ARE_EQUAL(L'2', term.GetTextBuffer().GetRowByOffset(mirror.ViewStartIndex()).GetText().front());
+
+    Log::Comment(L"Scrolling back down makes it follow the output again.");
+    mirror.UserScrollViewport(100);
+    VERIFY_ARE_EQUAL(8, mirror.ViewStartIndex());
+
+    term.RemoveMirror(mirror);
+    term.Write(L"\r\n12");
+    VERIFY_ARE_EQUAL(3, notifications);
+}
@@ -34,13 +34,19 @@ namespace TerminalCoreUnitTests
         // PrintString() is called with more code units than the buffer width.
         TEST_METHOD(PrintStringOfSurrogatePairs);
         TEST_METHOD(CheckDoubleWidthCursor);
+        TEST_METHOD(PrintWideGlyphAtEndOfRow);
+        TEST_METHOD(PrintMixedTextAcrossRows);
 
         TEST_METHOD(AddHyperlink);
         TEST_METHOD(AddHyperlinkCustomId);
         TEST_METHOD(AddHyperlinkCustomIdDifferentUri);
+        TEST_METHOD(HyperlinkSnapshot);
 
         TEST_METHOD(SetTaskbarProgress);
         TEST_METHOD(SetWorkingDirectory);
+        TEST_METHOD(CommandMarks);
+
+        TEST_METHOD(HeadlessSnapshot);
     };
 };
 
@@ -259,6 +265,51 @@ void TerminalApiTest::CheckDoubleWidthCursor()
     VERIFY_IS_TRUE(term.IsCursorDoubleWidth());
 }
 
+void TerminalApiTest::PrintWideGlyphAtEndOfRow()
+{
+    DummyRenderTarget renderTarget;
+    Terminal term;
+    term.Create({ 10, 10 }, 0, renderTarget);
+
+    auto& tbi = *(term._buffer);
+    auto& stateMachine = *(term._stateMachine);
+    auto& cursor = tbi.GetCursor();
+
+    // Leave a single column for a double width character.
+    stateMachine.ProcessString(L"AAAAAAAAA");
+    VERIFY_ARE_EQUAL(9, cursor.GetPosition().X);
+
+    Log::Comment(L"The glyph doesn't fit into the last column and has to move to the next row.");
+    stateMachine.ProcessString(L"\x6211B");
+    VERIFY_ARE_EQUAL((COORD{ 3, 1 }), cursor.GetPosition());
+    VERIFY_ARE_EQUAL(L"AAAAAAAAA ", tbi.GetRowByOffset(0).GetText());
+    VERIFY_IS_TRUE(tbi.GetRowByOffset(0).WasDoubleBytePadded());
+    VERIFY_ARE_EQUAL(L"\x6211B", tbi.GetRowByOffset(1).GetText().substr(0, 2));
+    VERIFY_IS_TRUE(tbi.GetCellDataAt({ 1, 1 })->DbcsAttr().IsTrailing());
+    VERIFY_ARE_EQUAL(L"B", tbi.GetCellDataAt({ 2, 1 })->Chars());
+}
+
+void TerminalApiTest::PrintMixedTextAcrossRows()
+{
+    DummyRenderTarget renderTarget;
+    Terminal term;
+    term.Create({ 10, 3 }, 0, renderTarget);
+
+    auto& tbi = *(term._buffer);
+    auto& stateMachine = *(term._stateMachine);
+    auto& cursor = tbi.GetCursor();
+
+    // 4 rows worth of text, alternating between plain ASCII, which is copied
+    // into the rows as is, and other text, which is measured cell by cell.
+    stateMachine.ProcessString(L"abcde\xe9\xe9\xe9\xe9\xe9fghij\xD801\xDC0C\xD801\xDC0C\xD801\xDC0C\xD801\xDC0C\xD801\xDC0Cklmnopqrstuvw");
+
+    Log::Comment(L"The buffer only has 3 rows, so the first one was cycled out.");
+    VERIFY_ARE_EQUAL((COORD{ 3, 2 }), cursor.GetPosition());
+    VERIFY_ARE_EQUAL(L"fghij\xD801\xDC0C\xD801\xDC0C\xD801\xDC0C\xD801\xDC0C\xD801\xDC0C", tbi.GetRowByOffset(0).GetText());
+    VERIFY_ARE_EQUAL(L"klmnopqrst", tbi.GetRowByOffset(1).GetText());
+    VERIFY_ARE_EQUAL(L"uvw       ", tbi.GetRowByOffset(2).GetText());
+}
+
 void TerminalCoreUnitTests::TerminalApiTest::AddHyperlink()
 {
     // This is a nearly literal copy-paste of ScreenBufferTests::TestAddHyperlink, adapted for the Terminal
@@ -343,6 +394,39 @@ void TerminalCoreUnitTests::TerminalApiTest::AddHyperlinkCustomIdDifferentUri()
     VERIFY_ARE_NOT_EQUAL(oldAttributes.GetHyperlinkId(), tbi.GetCurrentAttributes().GetHyperlinkId());
 }
 
+void TerminalCoreUnitTests::TerminalApiTest::HyperlinkSnapshot()
+{
+    Terminal term;
+    DummyRenderTarget emptyRT;
+    term.Create({ 100, 100 }, 0, emptyRT);
+
+    auto& stateMachine = *(term._stateMachine);
+
+    // "abc" on the first row and "xy" on the second are links, the rest isn't.
+    stateMachine.ProcessString(L"12\x1b]8;;test.url\x9c"
+                               L"abc"
+                               L"\x1b]8;;\x9c"
+                               L"3\r\n"
+                               L"\x1b]8;;other.url\x9c"
+                               L"xy"
+                               L"\x1b]8;;\x9c");
+
+    const auto snapshot = term.GetHyperlinkSnapshot();
+    for (auto x = 0; x < 10; ++x)
+    {
+        VERIFY_ARE_EQUAL(term.GetHyperlinkIdAtPosition(COORD{ gsl::narrow_cast<short>(x), 0 }), snapshot->GetHyperlinkIdAtPosition(til::point{ x, 0 }));
+        VERIFY_ARE_EQUAL(term.GetHyperlinkIdAtPosition(COORD{ gsl::narrow_cast<short>(x), 1 }), snapshot->GetHyperlinkIdAtPosition(til::point{ x, 1 }));
+    }
+
+    const auto& tbi = *(term._buffer);
+    VERIFY_ARE_EQUAL(L"test.url", tbi.GetHyperlinkUriFromId(snapshot->GetHyperlinkIdAtPosition(til::point{ 2, 0 })));
+    VERIFY_ARE_EQUAL(L"test.url", tbi.GetHyperlinkUriFromId(snapshot->GetHyperlinkIdAtPosition(til::point{ 4, 0 })));
+    VERIFY_ARE_EQUAL(0, snapshot->GetHyperlinkIdAtPosition(til::point{ 5, 0 }));
+    VERIFY_ARE_EQUAL(L"other.url", tbi.GetHyperlinkUriFromId(snapshot->GetHyperlinkIdAtPosition(til::point{ 1, 1 })));
+    VERIFY_ARE_EQUAL(0, snapshot->GetHyperlinkIdAtPosition(til::point{ 2, 1 }));
+    VERIFY_ARE_EQUAL(0, snapshot->GetHyperlinkIdAtPosition(til::point{ 0, 50 }));
+}
+
 void TerminalCoreUnitTests::TerminalApiTest::SetTaskbarProgress()
 {
     Terminal term;
@@ -469,3 +553,93 @@ void TerminalCoreUnitTests::TerminalApiTest::SetWorkingDirectory()
     stateMachine.ProcessString(L"\x1b]9;9;\"\"\"\"\x9c");
     VERIFY_ARE_EQUAL(term.GetWorkingDirectory(), L"\"\"");
 }
+
+void TerminalApiTest::CommandMarks()
+{
+    Terminal term;
+    DummyRenderTarget emptyRT;
+    term.Create({ 20, 5 }, 20, emptyRT);
+
+    auto& stateMachine = *(term._stateMachine);
+
+    // Command N prints N + 1 rows of output and exits with N.
+    for (auto i = 0; i < 3; ++i)
+    {
+        stateMachine.ProcessString(fmt::format(L"\x1b]133;A\x9c$ \x1b]133;B\x9c" L"cmd{}\r\n\x1b]133;C\x9c", i));
+        for (auto j = 0; j <= i; ++j)
+        {
+            stateMachine.ProcessString(L"out\r\n");
+        }
+        stateMachine.ProcessString(fmt::format(L"\x1b]133;D;{}\x9c", i));
+    }
+    stateMachine.ProcessString(L"\x1b]133;A\x9c$ ");
+
+    // The prompts are on rows 0, 2, 5 and 9.
+    const auto& tbi = *(term._buffer);
+    VERIFY_ARE_EQUAL(4u, tbi.GetCommandCount());
+
+    const auto second = tbi.GetCommandAt(4);
+    VERIFY_IS_TRUE(second.has_value());
+    VERIFY_ARE_EQUAL(til::point(0, 2), second->promptStart);
+    VERIFY_ARE_EQUAL(til::point(2, 2), second->commandStart.value());
+    VERIFY_ARE_EQUAL(til::point(0, 3), second->outputStart.value());
+    VERIFY_ARE_EQUAL(2, second->OutputRowCount().value());
+    VERIFY_ARE_EQUAL(1u, second->exitCode.value());
+
+    VERIFY_ARE_EQUAL(til::point(0, 2), tbi.GetPreviousCommand(5)->promptStart);
+    VERIFY_ARE_EQUAL(til::point(0, 9), tbi.GetNextCommand(5)->promptStart);
+    VERIFY_IS_FALSE(tbi.GetNextCommand(9).has_value());
+    VERIFY_IS_FALSE(tbi.GetCommandAt(9)->outputStart.has_value());
+
+    Log::Comment(L"Jump from the viewport (rows 5 to 9) up to the prompts above it.");
+    VERIFY_ARE_EQUAL(5, term.GetScrollOffset());
+    VERIFY_IS_TRUE(term.ScrollToCommand(true));
+    VERIFY_ARE_EQUAL(2, term.GetScrollOffset());
+    VERIFY_IS_TRUE(term.ScrollToCommand(true));
+    VERIFY_ARE_EQUAL(0, term.GetScrollOffset());
+    VERIFY_IS_FALSE(term.ScrollToCommand(true));
+    VERIFY_IS_TRUE(term.ScrollToCommand(false));
+    VERIFY_ARE_EQUAL(2, term.GetScrollOffset());
+
+    Log::Comment(L"Select the output of the command at the top of the viewport.");
+    VERIFY_IS_TRUE(term.SelectCommandOutput());
+    VERIFY_ARE_EQUAL((COORD{ 0, 3 }), term.GetSelectionAnchor());
+    VERIFY_ARE_EQUAL((COORD{ 19, 4 }), term.GetSelectionEnd());
+
+    Log::Comment(L"A D without a C doesn't give the last prompt any output.");
+    stateMachine.ProcessString(L"\x1b]133;D;0\x9c");
+    VERIFY_IS_FALSE(tbi.GetCommandAt(9)->outputEnd.has_value());
+
+    Log::Comment(L"The marks move along with the text when the buffer is reflowed.");
+    VERIFY_SUCCEEDED(term.UserResize({ 10, 5 }));
+    VERIFY_ARE_EQUAL(4u, term._buffer->GetCommandCount());
+    VERIFY_ARE_EQUAL(til::point(0, 5), term._buffer->GetPreviousCommand(9)->promptStart);
+}
+
+void TerminalApiTest::HeadlessSnapshot()
+{
+    Terminal term;
+    term.CreateHeadless({ 10, 3 }, 0);
+
+    term.Write(L"\x1b[1mab\x1b[m\r\ncd");
+
+    auto snapshot = term.TakeSnapshot();
+    VERIFY_ARE_EQUAL(3u, snapshot.text.size());
+    VERIFY_ARE_EQUAL(L"ab        ", snapshot.text[0]);
+    VERIFY_ARE_EQUAL(L"cd        ", snapshot.text[1]);
+    VERIFY_ARE_EQUAL(L"          ", snapshot.text[2]);
+
+    VERIFY_ARE_EQUAL(3u, snapshot.attributes.size());
+    VERIFY_ARE_EQUAL(10u, snapshot.attributes[0].size());
+    VERIFY_IS_TRUE(snapshot.attributes[0][0].IsBold());
+    VERIFY_IS_TRUE(snapshot.attributes[0][1].IsBold());
+    VERIFY_IS_FALSE(snapshot.attributes[0][2].IsBold());
+    VERIFY_IS_FALSE(snapshot.attributes[1][0].IsBold());
+
+    VERIFY_ARE_EQUAL((COORD{ 2, 1 }), snapshot.cursorPosition);
+    VERIFY_IS_TRUE(snapshot.cursorVisible);
+
+    term.Write(L"\x1b[?25l");
+    snapshot = term.TakeSnapshot();
+    VERIFY_IS_FALSE(snapshot.cursorVisible);
+}
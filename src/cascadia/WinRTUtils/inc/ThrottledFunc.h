@@ -29,7 +29,8 @@ public:
         function func) :
         _dispatcher{ std::move(dispatcher) },
         _func{ std::move(func) },
-        _timer{ _create_timer() }
+        _timer{ _create_timer() },
+        _window{ til::details::throttled_func_window(delay) }
     {
         const auto d = -delay.count();
         if (d >= 0)
@@ -90,13 +91,13 @@ private:
                     }
                     CATCH_LOG();
 
-                    SetThreadpoolTimerEx(self->_timer.get(), &self->_delay, 0, 0);
+                    SetThreadpoolTimerEx(self->_timer.get(), &self->_delay, 0, self->_window);
                 }
             });
         }
         else
         {
-            SetThreadpoolTimerEx(_timer.get(), &_delay, 0, 0);
+            SetThreadpoolTimerEx(_timer.get(), &_delay, 0, _window);
         }
     }
 
@@ -133,6 +134,7 @@ private:
     function _func;
 
     wil::unique_threadpool_timer _timer;
+    DWORD _window;
     til::details::throttled_func_storage<Args...> _storage;
 };
 
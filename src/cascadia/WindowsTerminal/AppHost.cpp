@@ -251,6 +251,9 @@ void AppHost::Initialize()
     // tabs opened, this is consistent with Alt+F4 closing
     _window->WindowCloseButtonClicked([this]() { _logic.WindowCloseButtonClicked(); });
 
+    // Don't paint the terminals while the window is minimized.
+    _window->WindowVisibilityChanged([this](bool showOrHide) { _logic.WindowVisibilityChanged(showOrHide); });
+
     // Add an event handler to plumb clicks in the titlebar area down to the
     // application layer.
     _window->DragRegionClicked([this]() { _logic.TitlebarClicked(); });
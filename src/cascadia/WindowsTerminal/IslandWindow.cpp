@@ -454,6 +454,13 @@ long IslandWindow::_calculateTotalSize(const bool isWidth, const long clientSize
     }
     case WM_SIZE:
     {
+        // Only tell the app when we go from or to being minimized, not on every resize.
+        if (const auto minimized = wparam == SIZE_MINIMIZED; minimized != _minimized)
+        {
+            _minimized = minimized;
+            _WindowVisibilityChangedHandlers(!minimized);
+        }
+
         if (wparam == SIZE_MINIMIZED && _isQuakeWindow)
         {
             ShowWindow(GetHandle(), SW_HIDE);
@@ -63,6 +63,7 @@ public:
     WINRT_CALLBACK(NotifyReAddTrayIcon, winrt::delegate<void()>);
 
     WINRT_CALLBACK(WindowMoved, winrt::delegate<void()>);
+    WINRT_CALLBACK(WindowVisibilityChanged, winrt::delegate<void(bool)>);
 
 protected:
     void ForceResize()
@@ -119,6 +120,7 @@ protected:
     void _moveToMonitor(const MONITORINFO activeMonitor);
 
     bool _isQuakeWindow{ false };
+    bool _minimized{ false };
 
     void _enterQuakeMode();
     til::rectangle _getQuakeModeSize(HMONITOR hmon);
@@ -185,6 +185,9 @@ namespace Microsoft.Terminal.Wpf
         [DllImport("PublicTerminalCore.dll", CharSet = CharSet.Unicode, CallingConvention = CallingConvention.StdCall)]
         public static extern void TerminalSendOutput(IntPtr terminal, string lpdata);
 
+        [DllImport("PublicTerminalCore.dll", CallingConvention = CallingConvention.StdCall)]
+        public static extern void TerminalSendOutputUtf8(IntPtr terminal, byte[] data, UIntPtr length);
+
         [DllImport("PublicTerminalCore.dll", CharSet = CharSet.Unicode, CallingConvention = CallingConvention.StdCall)]
         public static extern uint TerminalTriggerResize(IntPtr terminal, short width, short height, out COORD dimensions);
 
@@ -0,0 +1,101 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+/*++
+Module Name:
+- ImageCache.h
+
+Abstract:
+- A cache of XAML image objects (BitmapImage, BitmapIconSource, ...), so that
+  every tab, tab header, command palette item and control showing the same
+  image shares a single decoded copy of it, instead of decoding its own.
+- Images are keyed by their path and, for files on disk, the last time the
+  file was written. Changing the file thus makes it decode again.
+- Only weak references are held: an image is freed as soon as nothing shows it
+  anymore, like before.
+- XAML objects belong to the thread they were created on, so every thread
+  gets a cache of its own. See ImageCache::ForThread.
+--*/
+
+#pragma once
+
+template<typename T>
+class ImageCache
+{
+public:
+    // Returns the cache of the calling thread.
+    static ImageCache& ForThread()
+    {
+        static thread_local ImageCache cache;
+        return cache;
+    }
+
+    // Method Description:
+    // - Returns the cached image for the given path, or creates one with
+    //   `create` if there's none, the file changed in the meantime or
+    //   nothing holds on to the previous one anymore.
+    // Arguments:
+    // - path: the full, expanded path to the image.
+    // - create: called with the path to create a new image.
+    // Return Value:
+    // - The image. `create` may return nullptr, which isn't cached.
+    template<typename F>
+    T GetOrCreate(const winrt::hstring& path, F&& create)
+    {
+        const auto lastWriteTime = _lastWriteTime(path);
+        if (const auto it = _entries.find(path); it != _entries.end() && it->second.lastWriteTime == lastWriteTime)
+        {
+            if (auto image = it->second.image.get())
+            {
+                return image;
+            }
+        }
+
+        T image = create(path);
+        if (image)
+        {
+            _prune();
+            _entries.insert_or_assign(path, Entry{ lastWriteTime, winrt::make_weak(image) });
+        }
+        return image;
+    }
+
+private:
+    struct Entry
+    {
+        uint64_t lastWriteTime;
+        winrt::weak_ref<T> image;
+    };
+
+    // URIs like ms-appx:///... or https://... aren't files on disk, so they
+    // count as unchanged for as long as the process lives.
+    static uint64_t _lastWriteTime(const winrt::hstring& path) noexcept
+    {
+        WIN32_FILE_ATTRIBUTE_DATA data{};
+        if (!GetFileAttributesExW(path.c_str(), GetFileExInfoStandard, &data))
+        {
+            return 0;
+        }
+        return (static_cast<uint64_t>(data.ftLastWriteTime.dwHighDateTime) << 32) | data.ftLastWriteTime.dwLowDateTime;
+    }
+
+    // Drops the entries of images that were freed already. This runs before
+    // every insertion, which keeps the map as small as the number of images
+    // that are actually shown.
+    void _prune()
+    {
+        for (auto it = _entries.begin(); it != _entries.end();)
+        {
+            if (it->second.image.get())
+            {
+                ++it;
+            }
+            else
+            {
+                it = _entries.erase(it);
+            }
+        }
+    }
+
+    std::unordered_map<winrt::hstring, Entry> _entries;
+};
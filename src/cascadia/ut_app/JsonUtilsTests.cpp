@@ -420,6 +420,13 @@ namespace TerminalAppUnitTests
         Json::Value stringUnknown{ "unknown" };
         VERIFY_THROWS_SPECIFIC(GetValue<JsonTestEnum>(stringUnknown), DeserializationError, _ReturnTrueForException);
 
+        // Names are matched exactly, even if they hash into the slot of a mapping.
+        for (const auto name : { "firs", "firstt", "First", "" })
+        {
+            Json::Value almostFirst{ name };
+            VERIFY_THROWS_SPECIFIC(GetValue<JsonTestEnum>(almostFirst), DeserializationError, _ReturnTrueForException);
+        }
+
         // SetValueForKey
         {
             const std::string key{ "myKey" };
@@ -28,7 +28,6 @@ VtInputThread::VtInputThread(_In_ wil::unique_hfile hPipe,
                              const bool inheritCursor) :
     _hFile{ std::move(hPipe) },
     _hThread{},
-    _u8State{},
     _dwThreadId{ 0 },
     _exitRequested{ false },
     _exitResult{ S_OK }
@@ -54,8 +53,7 @@ VtInputThread::VtInputThread(_In_ wil::unique_hfile hPipe,
 
 // Method Description:
 // - Processes a string of input characters. The characters should be UTF-8
-//      encoded, and will get converted to wstring to be processed by the
-//      input state machine.
+//      encoded, and will be processed by the input state machine directly.
 // Arguments:
 // - u8Str - the UTF-8 string received.
 // Return Value:
@@ -70,16 +68,17 @@ VtInputThread::VtInputThread(_In_ wil::unique_hfile hPipe,
     LockConsole();
     auto Unlock = wil::scope_exit([&] { UnlockConsole(); });
 
+    // Everything decoded from this read is written before any waiting
+    // client read is completed, so that a large paste isn't handed to
+    // the client a handful of keys at a time.
+    const auto inputBuffer = ServiceLocator::LocateGlobals().getConsoleInformation().GetActiveInputBuffer();
+    inputBuffer->BeginBatchedWrites();
+    auto endBatch = wil::scope_exit([&]() noexcept { inputBuffer->EndBatchedWrites(); });
+
     try
     {
-        std::wstring wstr{};
-        auto hr = til::u8u16(u8Str, wstr, _u8State);
-        // If we hit a parsing error, eat it. It's bad utf-8, we can't do anything with it.
-        if (FAILED(hr))
-        {
-            return S_FALSE;
-        }
-        _pInputStateMachine->ProcessString(wstr);
+        // The state machine takes care of partial UTF-8 sequences across reads.
+        _pInputStateMachine->ProcessString(u8Str);
     }
     CATCH_RETURN();
 
@@ -108,7 +107,7 @@ DWORD WINAPI VtInputThread::StaticVtInputThreadProc(_In_ LPVOID lpParameter)
 // - <none>
 void VtInputThread::DoReadInput(const bool throwOnFail)
 {
-    char buffer[256];
+    char buffer[4096];
     DWORD dwRead = 0;
     bool fSuccess = !!ReadFile(_hFile.get(), buffer, ARRAYSIZE(buffer), &dwRead, nullptr);
 
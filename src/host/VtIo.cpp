@@ -70,6 +70,7 @@ VtIo::VtIo() :
     _lookingForCursorPosition = pArgs->GetInheritCursor();
     _resizeQuirk = pArgs->IsResizeQuirkEnabled();
     _win32InputMode = pArgs->IsWin32InputModeEnabled();
+    _passthroughMode = pArgs->IsPassthroughModeEnabled();
 
     // If we were already given VT handles, set up the VT IO engine to use those.
     if (pArgs->InConptyMode())
@@ -456,6 +457,64 @@ bool VtIo::IsResizeQuirkEnabled() const
     return _resizeQuirk;
 }
 
+// Method Description:
+// - Returns true if we were started with the `--passthrough` flag. In that mode
+//   VT written by clients using ENABLE_VIRTUAL_TERMINAL_PROCESSING is sent to the
+//   terminal as-is, rather than being parsed into the buffer and rendered back
+//   out of it. See BeginPassthrough.
+// Arguments:
+// - <none>
+// Return Value:
+// - true iff we were started with the `--passthrough` flag enabled.
+bool VtIo::IsPassthroughModeEnabled() const noexcept
+{
+    return _passthroughMode && _pVtRenderEngine;
+}
+
+// Method Description:
+// - Sends a client's VT output straight to the terminal. The caller must then
+//   parse the same output into the active buffer, to keep it in sync for the
+//   console APIs, and call EndPassthrough once it's done.
+// - Anything that was drawn before this output but not rendered yet is
+//   rendered first, so that the terminal receives everything in order.
+// - The console lock must be held for the duration.
+// Arguments:
+// - str: The client's output.
+// Return Value:
+// - S_OK if we wrote the output successfully, otherwise an appropriate HRESULT
+[[nodiscard]] HRESULT VtIo::BeginPassthrough(const std::wstring_view str) noexcept
+{
+    RETURN_HR_IF(E_NOT_VALID_STATE, !IsPassthroughModeEnabled());
+
+    _pVtRenderEngine->ForceNextFrame();
+    LOG_IF_FAILED(ServiceLocator::LocateGlobals().pRender->PaintFrame());
+    return _pVtRenderEngine->BeginPassthrough(str);
+}
+
+// Method Description:
+// - Lets the renderer know that the output given to BeginPassthrough has been
+//   parsed into the buffer, and that the terminal already shows the result.
+// Arguments:
+// - <none>
+// Return Value:
+// - S_OK, or an appropriate HRESULT if we weren't passing anything through.
+[[nodiscard]] HRESULT VtIo::EndPassthrough() noexcept
+try
+{
+    RETURN_HR_IF(E_NOT_VALID_STATE, !IsPassthroughModeEnabled());
+
+    const auto& screenInfo = ServiceLocator::LocateGlobals().getConsoleInformation().GetActiveOutputBuffer();
+    const auto& cursor = screenInfo.GetTextBuffer().GetCursor();
+    const auto viewport = screenInfo.GetViewport();
+
+    auto position = cursor.GetPosition();
+    position.X -= viewport.Left();
+    position.Y -= viewport.Top();
+
+    return _pVtRenderEngine->EndPassthrough(position, cursor.IsDelayedEOLWrap(), screenInfo.GetAttributes());
+}
+CATCH_RETURN()
+
 // Method Description:
 // - Manually tell the renderer that it should emit a "Erase Scrollback"
 //   sequence to the connected terminal. We need to do this in certain cases
@@ -44,6 +44,10 @@ namespace Microsoft::Console::VirtualTerminal
 #endif
 
         bool IsResizeQuirkEnabled() const;
+        bool IsPassthroughModeEnabled() const noexcept;
+
+        [[nodiscard]] HRESULT BeginPassthrough(const std::wstring_view str) noexcept;
+        [[nodiscard]] HRESULT EndPassthrough() noexcept;
 
         [[nodiscard]] HRESULT ManuallyClearScrollback() const noexcept;
 
@@ -63,6 +67,7 @@ namespace Microsoft::Console::VirtualTerminal
 
         bool _resizeQuirk{ false };
         bool _win32InputMode{ false };
+        bool _passthroughMode{ false };
 
         std::unique_ptr<Microsoft::Console::Render::VtEngine> _pVtRenderEngine;
         std::unique_ptr<Microsoft::Console::VtInputThread> _pVtInputThread;
@@ -218,11 +218,9 @@ void WriteToScreen(SCREEN_INFORMATION& screenInfo, const Viewport& region)
 
     try
     {
-        TextAttribute useThisAttr(attribute);
-        const OutputCellIterator it(useThisAttr, lengthToWrite);
-        const auto done = screenBuffer.Write(it, startingCoordinate);
-
-        cellsModified = done.GetCellDistance(it);
+        // Set whole spans of each row at once instead of cell by cell.
+        const TextAttribute useThisAttr(attribute);
+        cellsModified = screenBuffer.GetTextBuffer().FillAttributes(useThisAttr, lengthToWrite, startingCoordinate);
 
         if (screenBuffer.HasAccessibilityEventing())
         {
@@ -279,12 +277,20 @@ void WriteToScreen(SCREEN_INFORMATION& screenInfo, const Viewport& region)
     HRESULT hr = S_OK;
     try
     {
-        const OutputCellIterator it(character, lengthToWrite);
-
         // when writing to the buffer, specifically unset wrap if we get to the last column.
         // a fill operation should UNSET wrap in that scenario. See GH #1126 for more details.
-        const auto done = screenInfo.Write(it, startingCoordinate, false);
-        cellsModified = done.GetInputDistance(it);
+        if (character >= L' ' && character <= L'~')
+        {
+            // Printable ASCII is always narrow, so whole spans of each row can be filled at once.
+            // This is the common case, since cls and most legacy apps fill with spaces.
+            cellsModified = screenInfo.GetTextBuffer().FillNarrowText(character, lengthToWrite, startingCoordinate, false);
+        }
+        else
+        {
+            const OutputCellIterator it(character, lengthToWrite);
+            const auto done = screenInfo.Write(it, startingCoordinate, false);
+            cellsModified = done.GetInputDistance(it);
+        }
 
         // Notify accessibility
         if (screenInfo.HasAccessibilityEventing())
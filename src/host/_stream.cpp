@@ -390,6 +390,27 @@ using Microsoft::Console::VirtualTerminal::StateMachine;
         wchar_t* LocalBufPtr = LocalBuffer;
         while (*pcb < BufferSize && i < LOCAL_BUFFER_SIZE && XPosition < coordScreenBufferSize.X)
         {
+            // Printable ASCII is always a narrow glyph, so a run of it can be copied
+            // at once without going through any of the per-character checks below.
+            const auto asciiLimit = std::min<size_t>({ (BufferSize - *pcb) / sizeof(WCHAR),
+                                                       LOCAL_BUFFER_SIZE - i,
+                                                       gsl::narrow_cast<size_t>(coordScreenBufferSize.X - XPosition) });
+            const auto asciiEnd = std::find_if(lpString, lpString + asciiLimit, [](const wchar_t wch) noexcept {
+                return wch < L' ' || wch > L'~';
+            });
+            if (const auto asciiCount = gsl::narrow_cast<size_t>(asciiEnd - lpString))
+            {
+                std::copy_n(lpString, asciiCount, LocalBufPtr);
+                LocalBufPtr += asciiCount;
+                XPosition += gsl::narrow_cast<SHORT>(asciiCount);
+                i += asciiCount;
+                pwchBuffer += asciiCount;
+                lpString += asciiCount;
+                pwchRealUnicode += asciiCount;
+                *pcb += asciiCount * sizeof(WCHAR);
+                continue;
+            }
+
 #pragma prefast(suppress : 26019, "Buffer is taken in multiples of 2. Validation is ok.")
             const wchar_t Char = *lpString;
             // WCL-NOTE: We believe RealUnicodeChar to be identical to Char, because we believe pwchRealUnicode
@@ -553,18 +574,28 @@ using Microsoft::Console::VirtualTerminal::StateMachine;
             }
 
             // line was wrapped if we're writing up to the end of the current row
-            OutputCellIterator it(std::wstring_view(LocalBuffer, i), Attributes);
-            const auto itEnd = screenInfo.Write(it);
+            const std::wstring_view text{ LocalBuffer, i };
+
+            // Write any leading plain ASCII text at once. Whatever isn't
+            // (if anything) goes through the regular cell by cell path.
+            // The number of "spaces" or "cells" we have consumed needs to be reported and stored for later
+            // when/if we need to erase the command line.
+            const auto narrowWritten = screenInfo.GetTextBuffer().WriteNarrowText(text, Attributes, CursorPosition);
+            TempNumSpaces += narrowWritten;
+
+            if (narrowWritten < text.size())
+            {
+                const COORD target{ gsl::narrow_cast<SHORT>(CursorPosition.X + narrowWritten), CursorPosition.Y };
+                const TextCellIterator it{ text.substr(narrowWritten), Attributes };
+                const auto itEnd = screenInfo.GetTextBuffer().WriteText(it, target);
+                TempNumSpaces += itEnd.GetCellDistance(it);
+            }
 
             // Notify accessibility
             if (screenInfo.HasAccessibilityEventing())
             {
                 screenInfo.NotifyAccessibilityEventing(CursorPosition.X, CursorPosition.Y, CursorPosition.X + gsl::narrow<SHORT>(i - 1), CursorPosition.Y);
             }
-
-            // The number of "spaces" or "cells" we have consumed needs to be reported and stored for later
-            // when/if we need to erase the command line.
-            TempNumSpaces += itEnd.GetCellDistance(it);
             // WCL-NOTE: We are using the "estimated" X position delta instead of the actual delta from
             // WCL-NOTE: the iterator. It is not clear why. If they differ, the cursor ends up in the
             // WCL-NOTE: wrong place (typically inside another character).
@@ -971,8 +1002,25 @@ using Microsoft::Console::VirtualTerminal::StateMachine;
 
                 StateMachine& machine = screenInfo.GetStateMachine();
                 size_t const cch = BufferSize / sizeof(WCHAR);
-
-                machine.ProcessString({ pwchRealUnicode, cch });
+                const std::wstring_view str{ pwchRealUnicode, cch };
+
+                // In passthrough mode the terminal gets the client's VT as-is. We still parse it,
+                // so that the buffer is ready for the console APIs, but we don't render it again.
+                // That's only equivalent if the client expects the same line feed behavior as a
+                // terminal, and writes to the buffer that's being shown.
+                auto& vtIo = *ServiceLocator::LocateGlobals().getConsoleInformation().GetVtIo();
+                if (vtIo.IsPassthroughModeEnabled() &&
+                    WI_IsFlagSet(screenInfo.OutputMode, DISABLE_NEWLINE_AUTO_RETURN) &&
+                    screenInfo.GetActiveBuffer().IsActiveScreenBuffer() &&
+                    SUCCEEDED_LOG(vtIo.BeginPassthrough(str)))
+                {
+                    machine.ProcessString(str);
+                    LOG_IF_FAILED(vtIo.EndPassthrough());
+                }
+                else
+                {
+                    machine.ProcessString(str);
+                }
                 *pcb += BufferSize;
             }
         }
@@ -1136,7 +1184,9 @@ using Microsoft::Console::VirtualTerminal::StateMachine;
         const auto codepage{ consoleInfo.OutputCP };
         auto leadByteCaptured{ false };
         auto leadByteConsumed{ false };
-        std::wstring wstr{};
+        // The converted text is only needed for the duration of this call (a waiter makes its own copy),
+        // so we keep the buffer around to avoid allocating it anew for every write. The console lock protects it.
+        static std::wstring wstr{};
         static til::u8state u8State{};
 
         // Convert our input parameters to Unicode
@@ -1214,8 +1264,15 @@ using Microsoft::Console::VirtualTerminal::StateMachine;
 
             if (mbPtrLength != 0)
             {
-                // convert the remaining bytes in mbPtr to wide chars
-                mbPtrLength = sizeof(wchar_t) * MultiByteToWideChar(codepage, 0, mbPtr, mbPtrLength, wcPtr, mbPtrLength);
+                // convert the remaining bytes in mbPtr to wide chars,
+                // widening any leading ASCII directly if the codepage permits it.
+                const auto ascii{ IsAsciiCompatibleCodepage(codepage) ? gsl::narrow_cast<int>(til::details::u8u16ascii(mbPtr, mbPtrLength, wcPtr)) : 0 };
+                auto converted{ ascii };
+                if (ascii != mbPtrLength)
+                {
+                    converted += MultiByteToWideChar(codepage, 0, mbPtr + ascii, mbPtrLength - ascii, wcPtr + ascii, mbPtrLength - ascii);
+                }
+                mbPtrLength = sizeof(wchar_t) * converted;
             }
 
             wstr.resize((dbcsLength + mbPtrLength) / sizeof(wchar_t));
@@ -1162,7 +1162,9 @@ std::wstring Alias::s_MatchAndCopyAlias(const std::wstring& sourceText,
         return std::wstring();
     }
 
-    auto exeList = exeIter->second;
+    // Look at the exe's aliases in place. Copying the map would cost
+    // an allocation per alias on every line that's read.
+    const auto& exeList = exeIter->second;
     if (exeList.size() == 0)
     {
         // If there's no match, give back an empty string.
@@ -1179,7 +1181,7 @@ std::wstring Alias::s_MatchAndCopyAlias(const std::wstring& sourceText,
     }
 
     // Find alias. If there isn't one, return an empty string
-    const auto alias = tokens.front();
+    const auto& alias = tokens.front();
     const auto aliasIter = exeList.find(alias);
     if (aliasIter == exeList.end())
     {
@@ -1187,12 +1189,21 @@ std::wstring Alias::s_MatchAndCopyAlias(const std::wstring& sourceText,
         return std::wstring();
     }
 
-    const auto target = aliasIter->second;
+    const auto& target = aliasIter->second;
     if (target.size() == 0)
     {
         return std::wstring();
     }
 
+    // Without any macros, the target is used as is.
+    if (target.find(L'$') == std::wstring::npos)
+    {
+        std::wstring finalText(target);
+        lineCount = 0;
+        s_AppendCrLf(finalText, lineCount);
+        return finalText;
+    }
+
     // Get the string of all parameters as a shorthand for $* later.
     const auto allParams = s_GetArgString(sourceCopy);
 
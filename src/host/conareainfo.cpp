@@ -52,7 +52,8 @@ ConversionAreaInfo::ConversionAreaInfo(const COORD bufferSize,
 ConversionAreaInfo::ConversionAreaInfo(ConversionAreaInfo&& other) :
     _caInfo(other._caInfo),
     _isHidden(other._isHidden),
-    _screenBuffer(nullptr)
+    _screenBuffer(nullptr),
+    _cells(std::move(other._cells))
 {
     std::swap(_screenBuffer, other._screenBuffer);
 }
@@ -116,6 +117,64 @@ void ConversionAreaInfo::WriteText(const std::vector<OutputCell>& text,
     _screenBuffer->Write(view, { column, 0 });
 }
 
+// Routine Description:
+// - Shows the given text in the conversion area, replacing what it showed
+//   before. While the composition is typed, most of it stays the same between
+//   two calls, so if the area didn't move, only the cells from the first one
+//   that changed on are repainted.
+// Arguments:
+// - text - Text to show in the conversion area
+// - column - Column to start at (X position)
+// - viewPos - The position of the area's buffer relative to the viewport
+void ConversionAreaInfo::Update(std::vector<OutputCell> text, const SHORT column, const COORD viewPos)
+{
+    const SMALL_RECT window{ column, 0, gsl::narrow<SHORT>(column + text.size() - 1), 0 };
+    const bool moved = IsHidden() ||
+                       viewPos.X != _caInfo.coordConView.X ||
+                       viewPos.Y != _caInfo.coordConView.Y ||
+                       window.Left != _caInfo.rcViewCaWindow.Left;
+
+    if (moved && !IsHidden())
+    {
+        // Repaint where it used to be.
+        SetHidden(true);
+        Paint();
+    }
+
+    size_t unchanged = 0;
+    if (!moved)
+    {
+        const auto sameCell = [](const OutputCell& a, const OutputCell& b) {
+            return a.Chars() == b.Chars() && a.TextAttr() == b.TextAttr() && a.DbcsAttr() == b.DbcsAttr();
+        };
+        const auto mismatch = std::mismatch(_cells.begin(), _cells.end(), text.begin(), text.end(), sameCell);
+        unchanged = mismatch.first - _cells.begin();
+    }
+    const auto oldRight = _caInfo.rcViewCaWindow.Right;
+
+    _screenBuffer->ClearTextData();
+    WriteText(text, column);
+    _caInfo.rcViewCaWindow = window;
+    _caInfo.coordConView = viewPos;
+    _cells = std::move(text);
+
+    if (moved)
+    {
+        SetHidden(false);
+        Paint();
+    }
+    else
+    {
+        // If the text got shorter, the cells it vacated need a repaint too.
+        const auto left = gsl::narrow<SHORT>(column + unchanged);
+        const auto right = std::max(oldRight, window.Right);
+        if (left <= right)
+        {
+            _PaintColumns(left, right);
+        }
+    }
+}
+
 // Routine Description:
 // - Clears out a conversion area
 void ConversionAreaInfo::ClearArea() noexcept
@@ -125,6 +184,7 @@ void ConversionAreaInfo::ClearArea() noexcept
     try
     {
         _screenBuffer->ClearTextData();
+        _cells.clear();
     }
     CATCH_LOG();
 
@@ -200,6 +260,25 @@ void ConversionAreaInfo::SetViewPos(const COORD pos) noexcept
     }
 }
 
+// Routine Description:
+// - Repaints the given columns of the conversion area, relative to its buffer.
+//   The area itself doesn't need to cover them, which is how the cells it
+//   vacated get painted over with the screen buffer again.
+void ConversionAreaInfo::_PaintColumns(const SHORT left, const SHORT right) const noexcept
+{
+    CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+    SCREEN_INFORMATION& ScreenInfo = gci.GetActiveOutputBuffer();
+    const auto viewport = ScreenInfo.GetViewport();
+
+    SMALL_RECT WriteRegion;
+    WriteRegion.Left = viewport.Left() + _caInfo.coordConView.X + left;
+    WriteRegion.Right = viewport.Left() + _caInfo.coordConView.X + right;
+    WriteRegion.Top = viewport.Top() + _caInfo.coordConView.Y + _caInfo.rcViewCaWindow.Top;
+    WriteRegion.Bottom = WriteRegion.Top;
+
+    WriteToScreen(ScreenInfo, Viewport::FromInclusive(WriteRegion));
+}
+
 void ConversionAreaInfo::Paint() const noexcept
 {
     CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
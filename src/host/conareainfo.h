@@ -62,13 +62,18 @@ public:
     void Paint() const noexcept;
 
     void WriteText(const std::vector<OutputCell>& text, const SHORT column);
+    void Update(std::vector<OutputCell> text, const SHORT column, const COORD viewPos);
     void SetAttributes(const TextAttribute& attr);
 
     const TextBuffer& GetTextBuffer() const noexcept;
     const ConversionAreaBufferInfo& GetAreaBufferInfo() const noexcept;
 
 private:
+    void _PaintColumns(const SHORT left, const SHORT right) const noexcept;
+
     ConversionAreaBufferInfo _caInfo;
     std::unique_ptr<SCREEN_INFORMATION> _screenBuffer;
     bool _isHidden;
+    // The cells shown by Update, to find out which of them changed next time.
+    std::vector<OutputCell> _cells;
 };
@@ -43,7 +43,6 @@ void ConsoleImeInfo::RedrawCompMessage()
 {
     if (!_text.empty())
     {
-        ClearAllAreas();
         _WriteUndeterminedChars(_text, _attributes, _colorArray);
     }
 }
@@ -60,7 +59,8 @@ void ConsoleImeInfo::WriteCompMessage(const std::wstring_view text,
                                       const gsl::span<const BYTE> attributes,
                                       const gsl::span<const WORD> colorArray)
 {
-    ClearAllAreas();
+    // The conversion areas aren't cleared first. They're updated in place,
+    // which only repaints the cells of the composition that changed.
 
     // MSFT:29219348 only hide the cursor after the IME produces a string.
     // See notes in convarea.cpp ImeStartComposition().
@@ -228,9 +228,8 @@ std::vector<OutputCell> ConsoleImeInfo::s_ConvertToCells(const std::wstring_view
 
     // - Walk through all of the grouped up text, match up the correct attribute to it, and make a new cell.
     size_t attributesUsed = 0;
-    for (const auto& parsedGlyph : glyphs)
+    for (const auto glyph : glyphs)
     {
-        const std::wstring_view glyph{ parsedGlyph.data(), parsedGlyph.size() };
         // Collect up attributes that apply to this glyph range.
         auto drawingAttr = s_RetrieveAttributeAt(attributesUsed, attributes, colorArray);
         attributesUsed++;
@@ -303,6 +302,7 @@ std::vector<OutputCell> ConsoleImeInfo::s_ConvertToCells(const std::wstring_view
 //       - Updated to set up the next conversion area down a line (and to the left viewport edge)
 // - view - The rectangle representing the viewable area of the screen right now to let us know how many cells can fit.
 // - screenInfo - A reference to the screen information we will use for accessibility notifications
+// - areaIndex - The index of the conversion area to hold this line. It's created if it doesn't exist yet.
 // Return Value:
 // - Updated begin position for the next call. It will normally be >begin and <= end.
 //   However, if text couldn't fit in our line (full-width character starting at the very last cell)
@@ -312,7 +312,8 @@ std::vector<OutputCell>::const_iterator ConsoleImeInfo::_WriteConversionArea(con
                                                                              const std::vector<OutputCell>::const_iterator end,
                                                                              COORD& pos,
                                                                              const Microsoft::Console::Types::Viewport view,
-                                                                             SCREEN_INFORMATION& screenInfo)
+                                                                             SCREEN_INFORMATION& screenInfo,
+                                                                             const size_t areaIndex)
 {
     // The position in the viewport where we will start inserting cells for this conversion area
     // NOTE: We might exit early if there's not enough space to fit here, so we take a copy of
@@ -354,31 +355,25 @@ std::vector<OutputCell>::const_iterator ConsoleImeInfo::_WriteConversionArea(con
     }
 
     // Copy out the substring into a vector.
-    const std::vector<OutputCell> lineVec(lineBegin, lineEnd);
-
-    // Add a conversion area to the internal state to hold this line.
-    THROW_IF_FAILED(_AddConversionArea());
-
-    // Get the added conversion area.
-    auto& area = ConvAreaCompStr.back();
+    std::vector<OutputCell> lineVec(lineBegin, lineEnd);
+    const auto lineLength = lineVec.size();
 
-    // Write our text into the conversion area.
-    area.WriteText(lineVec, insertionPos.X);
-
-    // Set the viewport and positioning parameters for the conversion area to describe to the renderer
-    // the appropriate location to overlay this conversion area on top of the main screen buffer inside the viewport.
-    const SMALL_RECT region{ insertionPos.X, 0, gsl::narrow<SHORT>(insertionPos.X + lineVec.size() - 1), 0 };
-    area.SetWindowInfo(region);
-    area.SetViewPos({ 0 - view.Left(), insertionPos.Y - view.Top() });
+    // Reuse the conversion area that held this line during the last write, if
+    // there's one. Creating one allocates an entire screen buffer.
+    if (areaIndex >= ConvAreaCompStr.size())
+    {
+        THROW_IF_FAILED(_AddConversionArea());
+    }
+    auto& area = til::at(ConvAreaCompStr, areaIndex);
 
-    // Make it visible and paint it.
-    area.SetHidden(false);
-    area.Paint();
+    // Write our text into the conversion area and position it, such that the renderer overlays
+    // it on top of the main screen buffer inside the viewport. This makes it visible and repaints it.
+    area.Update(std::move(lineVec), insertionPos.X, { 0 - view.Left(), insertionPos.Y - view.Top() });
 
     // Notify accessibility that we have updated the text in this display region within the viewport.
     if (screenInfo.HasAccessibilityEventing())
     {
-        screenInfo.NotifyAccessibilityEventing(insertionPos.X, insertionPos.Y, gsl::narrow<SHORT>(insertionPos.X + lineVec.size() - 1), insertionPos.Y);
+        screenInfo.NotifyAccessibilityEventing(insertionPos.X, insertionPos.Y, gsl::narrow<SHORT>(insertionPos.X + lineLength - 1), insertionPos.Y);
     }
 
     // Hand back the iterator representing the end of what we used to be fed into the beginning of the next call.
@@ -405,14 +400,25 @@ void ConsoleImeInfo::_WriteUndeterminedChars(const std::wstring_view text,
     // Ensure cursor is visible for prompt line
     screenInfo.MakeCurrentCursorVisible();
 
-    // Clear out existing conversion areas.
-    ConvAreaCompStr.clear();
-
     // If the text length and attribute length don't match,
     // it's a programming error on our part. We control the sizes here.
     FAIL_FAST_IF(text.size() != attributes.size());
 
-    // If we have no text, return. We've already cleared above.
+    // The conversion areas that the text doesn't need anymore are hidden
+    // below, but kept around to be reused by the next write.
+    size_t areasUsed = 0;
+    auto hideUnusedAreas = wil::scope_exit([&]() {
+        for (auto i = areasUsed; i < ConvAreaCompStr.size(); ++i)
+        {
+            auto& area = til::at(ConvAreaCompStr, i);
+            if (!area.IsHidden())
+            {
+                area.ClearArea();
+            }
+        }
+    });
+
+    // If we have no text, return.
     if (text.empty())
     {
         return;
@@ -441,7 +447,8 @@ void ConsoleImeInfo::_WriteUndeterminedChars(const std::wstring_view text,
     // Write over and over updating the beginning iterator until we reach the end.
     do
     {
-        begin = _WriteConversionArea(begin, end, pos, view, screenInfo);
+        begin = _WriteConversionArea(begin, end, pos, view, screenInfo, areasUsed);
+        ++areasUsed;
     } while (begin < end);
 }
 
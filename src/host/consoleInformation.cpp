@@ -44,7 +44,11 @@ CONSOLE_INFORMATION::CONSOLE_INFORMATION() :
 {
     ZeroMemory((void*)&CPInfo, sizeof(CPInfo));
     ZeroMemory((void*)&OutputCPInfo, sizeof(OutputCPInfo));
-    InitializeCriticalSection(&_csConsoleLock);
+    // The I/O thread takes the lock once for every API call it services, so
+    // a client making thousands of tiny calls contends with the render thread
+    // a lot. Those threads only hold it briefly, so spinning for a bit is far
+    // cheaper than going to sleep in the kernel and being woken up again.
+    InitializeCriticalSectionAndSpinCount(&_csConsoleLock, s_consoleLockSpinCount);
 }
 
 CONSOLE_INFORMATION::~CONSOLE_INFORMATION()
@@ -162,13 +162,7 @@ _Ret_range_(0, cbAnsi)
                                 _Out_ std::unique_ptr<IInputEvent>& partialEvent)
 {
     const CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
-    PWCHAR const TmpUni = new (std::nothrow) WCHAR[cchUnicode];
-    if (TmpUni == nullptr)
-    {
-        return 0;
-    }
-
-    memcpy(TmpUni, pwchUnicode, cchUnicode * sizeof(WCHAR));
+    const auto asciiCompatible = IsAsciiCompatibleCodepage(gci.CP);
 
     BYTE AsciiDbcs[2];
     AsciiDbcs[1] = 0;
@@ -176,10 +170,17 @@ _Ret_range_(0, cbAnsi)
     ULONG i, j;
     for (i = 0, j = 0; i < cchUnicode && j < cbAnsi; i++, j++)
     {
-        if (IsGlyphFullWidth(TmpUni[i]))
+        if (asciiCompatible && pwchUnicode[i] < 0x80)
+        {
+            // Runs of ASCII are narrowed directly instead of converting them one character at a time.
+            const auto ascii = gsl::narrow_cast<ULONG>(til::details::u16u8ascii(&pwchUnicode[i], std::min(cchUnicode - i, cbAnsi - j), &pchAnsi[j]));
+            i += ascii - 1;
+            j += ascii - 1;
+        }
+        else if (IsGlyphFullWidth(pwchUnicode[i]))
         {
             ULONG const NumBytes = sizeof(AsciiDbcs);
-            ConvertToOem(gci.CP, &TmpUni[i], 1, (LPSTR)&AsciiDbcs[0], NumBytes);
+            ConvertToOem(gci.CP, &pwchUnicode[i], 1, (LPSTR)&AsciiDbcs[0], NumBytes);
             if (IsDBCSLeadByteConsole(AsciiDbcs[0], &gci.CPInfo))
             {
                 if (j < cbAnsi - 1)
@@ -203,7 +204,7 @@ _Ret_range_(0, cbAnsi)
         }
         else
         {
-            ConvertToOem(gci.CP, &TmpUni[i], 1, &pchAnsi[j], 1);
+            ConvertToOem(gci.CP, &pwchUnicode[i], 1, &pchAnsi[j], 1);
         }
     }
 
@@ -224,6 +225,5 @@ _Ret_range_(0, cbAnsi)
         }
     }
 
-    delete[] TmpUni;
     return j;
 }
@@ -786,7 +786,6 @@ void EventsToUnicode(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents,
 {
     try
     {
-        const auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
         const auto& storageBuffer = context.GetActiveBuffer();
         const auto storageSize = storageBuffer.GetBufferSize().Dimensions();
 
@@ -822,43 +821,23 @@ void EventsToUnicode(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents,
         // The final "request rectangle" or the area inside the buffer we want to read, is the clipped dimensions.
         const auto clippedRequestRectangle = Viewport::FromExclusive(clip);
 
-        // We will start reading the buffer at the point of the top left corner (origin) of the (potentially adjusted) request
-        const auto sourcePoint = clippedRequestRectangle.Origin();
-
-        // Get an iterator to the beginning of the return buffer
-        // We might have to seek this forward or skip around if we clipped the request.
-        auto targetIter = targetBuffer.begin();
-        COORD targetPos = { 0 };
-        const auto targetLimit = Viewport::FromDimensions(targetPoint, clippedRequestRectangle.Dimensions());
-
-        // Get an iterator to the beginning of the request inside the screen buffer
-        // This should walk exactly along every cell of the clipped request.
-        auto sourceIter = storageBuffer.GetCellDataAt(sourcePoint, clippedRequestRectangle);
-
-        // Walk through every cell of the target, advancing the buffer.
-        // Validate that we always still have a valid iterator to the backing store,
-        // that we always are writing inside the user's buffer (before the end)
-        // and we're always targeting the user's buffer inside its original bounds.
-        while (sourceIter && targetIter < targetBuffer.end())
+        // Read the clipped request a row at a time into the matching part of the user's buffer.
+        // Cells of the user's buffer that were clipped away are left untouched.
+        if (clippedRequestRectangle.Width() > 0 && clippedRequestRectangle.Height() > 0)
         {
-            // If the point we're trying to write is inside the limited buffer write zone...
-            if (targetLimit.IsInBounds(targetPos))
-            {
-                // Copy the data into position...
-                *targetIter = gci.AsCharInfo(*sourceIter);
-                // ... and advance the read iterator.
-                sourceIter++;
-            }
+            const auto& textBuffer = storageBuffer.GetTextBuffer();
+            const auto width = gsl::narrow_cast<size_t>(clippedRequestRectangle.Width());
 
-            // Always advance the write iterator, we might have skipped it due to clipping.
-            targetIter++;
-
-            // Increment the target
-            targetPos.X++;
-            if (targetPos.X >= targetSize.X)
+            for (SHORT row = 0; row < clippedRequestRectangle.Height(); ++row)
             {
-                targetPos.X = 0;
-                targetPos.Y++;
+                const auto targetOffset = gsl::narrow_cast<size_t>(targetPoint.Y + row) * targetSize.X + targetPoint.X;
+                if (targetOffset >= targetBuffer.size())
+                {
+                    break;
+                }
+
+                const auto target = targetBuffer.subspan(targetOffset, std::min(width, targetBuffer.size() - targetOffset));
+                textBuffer.GetRowByOffset(clippedRequestRectangle.Top() + row).ReadCharInfos(clippedRequestRectangle.Left(), target);
             }
         }
 
@@ -1006,12 +985,9 @@ void EventsToUnicode(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents,
             // Now we make a subspan starting from that offset for as much of the original request as would fit
             const auto subspan = buffer.subspan(totalOffset, writeRectangle.Width());
 
-            // Convert to a CHAR_INFO view to fit into the iterator
+            // Write the whole line of cells to the target position at once.
             const auto charInfos = gsl::span<const CHAR_INFO>(subspan.data(), subspan.size());
-
-            // Make the iterator and write to the target position.
-            OutputCellIterator it(charInfos);
-            storageBuffer.Write(it, target);
+            storageBuffer.GetTextBuffer().WriteCharInfos(charInfos, target);
         }
 
         // Since we've managed to write part of the request, return the clamped part that we actually used.
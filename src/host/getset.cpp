@@ -108,6 +108,15 @@ void ApiRoutines::GetConsoleScreenBufferInfoExImpl(const SCREEN_INFORMATION& con
 {
     try
     {
+        // Finding the largest window size takes several calls into the window manager,
+        // none of which need the console lock. Callers that poll this frequently
+        // would otherwise hold up everyone else waiting on the lock while they run.
+        std::optional<RECT> maxClientRectInPixels;
+        if (!ServiceLocator::LocateGlobals().IsHeadless())
+        {
+            maxClientRectInPixels = ServiceLocator::LocateWindowMetrics()->GetMaxClientRectInPixels();
+        }
+
         LockConsole();
         auto Unlock = wil::scope_exit([&] { UnlockConsole(); });
 
@@ -126,7 +135,8 @@ void ApiRoutines::GetConsoleScreenBufferInfoExImpl(const SCREEN_INFORMATION& con
                                                              &data.wAttributes,
                                                              &data.dwMaximumWindowSize,
                                                              &data.wPopupAttributes,
-                                                             data.ColorTable);
+                                                             data.ColorTable,
+                                                             maxClientRectInPixels);
 
         // Callers of this function expect to receive an exclusive rect, not an
         // inclusive one. The driver will mangle this value for us
@@ -2226,14 +2236,36 @@ void DoSrvPrivateMoveToBottom(SCREEN_INFORMATION& screenInfo)
             fillAttrs.SetStandardErase();
         }
 
-        const auto fillData = OutputCellIterator{ fillChar, fillAttrs, fillLength };
-        screenInfo.Write(fillData, startPosition, false);
+        const auto bufferSize = screenInfo.GetBufferSize();
+        auto fillPosition = startPosition;
+        auto remainingLength = fillLength;
+
+        // Erasing whole lines, which is what most ED and EL operations amount to,
+        // can be done by resetting the rows instead of writing spaces cell by cell.
+        if (fillChar == UNICODE_SPACE && fillPosition.X == 0 && bufferSize.IsInBounds(fillPosition))
+        {
+            const auto width = gsl::narrow_cast<size_t>(bufferSize.Width());
+            const auto rowsAvailable = gsl::narrow_cast<size_t>(bufferSize.BottomExclusive() - fillPosition.Y);
+            const auto rowCount = std::min(remainingLength / width, rowsAvailable);
+            if (rowCount > 0)
+            {
+                const auto lastRow = gsl::narrow_cast<SHORT>(fillPosition.Y + rowCount);
+                screenInfo.GetTextBuffer().EraseRows(fillPosition.Y, lastRow, fillAttrs);
+                fillPosition.Y = lastRow;
+                remainingLength -= rowCount * width;
+            }
+        }
+
+        if (remainingLength > 0 && bufferSize.IsInBounds(fillPosition))
+        {
+            const auto fillData = OutputCellIterator{ fillChar, fillAttrs, remainingLength };
+            screenInfo.Write(fillData, fillPosition, false);
+        }
 
         // Notify accessibility
         if (screenInfo.HasAccessibilityEventing())
         {
             auto endPosition = startPosition;
-            const auto bufferSize = screenInfo.GetBufferSize();
             bufferSize.MoveInBounds(fillLength - 1, endPosition);
             screenInfo.NotifyAccessibilityEventing(startPosition.X, startPosition.Y, endPosition.X, endPosition.Y);
         }
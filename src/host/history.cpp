@@ -32,15 +32,17 @@ using Microsoft::Console::Interactivity::ServiceLocator;
 // for maintaining LRU, then this datatype can be changed.
 std::list<CommandHistory> CommandHistory::s_historyLists;
 
+// The allocated histories in s_historyLists, by the process they belong to.
+// Elements are only ever spliced around within the list, so the pointers stay valid.
+std::unordered_map<HANDLE, CommandHistory*> CommandHistory::s_historiesByProcess;
+
 CommandHistory* CommandHistory::s_Find(const HANDLE processHandle)
 {
-    for (auto& historyList : s_historyLists)
+    const auto found = s_historiesByProcess.find(processHandle);
+    if (found != s_historiesByProcess.end())
     {
-        if (historyList._processHandle == processHandle)
-        {
-            FAIL_FAST_IF(WI_IsFlagClear(historyList.Flags, CLE_ALLOCATED));
-            return &historyList;
-        }
+        FAIL_FAST_IF(WI_IsFlagClear(found->second->Flags, CLE_ALLOCATED));
+        return found->second;
     }
 
     return nullptr;
@@ -55,6 +57,7 @@ void CommandHistory::s_Free(const HANDLE processHandle)
     CommandHistory* const History = CommandHistory::s_Find(processHandle);
     if (History)
     {
+        s_historiesByProcess.erase(processHandle);
         WI_ClearFlag(History->Flags, CLE_ALLOCATED);
         History->_processHandle = nullptr;
     }
@@ -82,6 +85,38 @@ bool CommandHistory::IsAppNameMatch(const std::wstring_view other) const
     return std::equal(_appName.cbegin(), _appName.cend(), other.cbegin(), other.cend(), CaseInsensitiveEquality);
 }
 
+static std::wstring FoldCase(const std::wstring_view command)
+{
+    std::wstring folded{ command };
+    std::transform(folded.begin(), folded.end(), folded.begin(), ::towlower);
+    return folded;
+}
+
+// Routine Description:
+// - Records that a command was stored in _commands.
+void CommandHistory::_TrackCommand(const std::wstring_view command)
+{
+    ++_commandCounts[FoldCase(command)];
+}
+
+// Routine Description:
+// - Records that a command was removed from _commands.
+void CommandHistory::_UntrackCommand(const std::wstring_view command)
+{
+    const auto found = _commandCounts.find(FoldCase(command));
+    if (found != _commandCounts.end() && --found->second == 0)
+    {
+        _commandCounts.erase(found);
+    }
+}
+
+// Routine Description:
+// - Returns true if a command case-insensitively equal to the given one is stored.
+bool CommandHistory::_ContainsCommand(const std::wstring_view command) const
+{
+    return _commandCounts.find(FoldCase(command)) != _commandCounts.end();
+}
+
 // Routine Description:
 // - This routine is called when escape is entered or a command is added.
 void CommandHistory::_Reset()
@@ -112,7 +147,7 @@ void CommandHistory::_Reset()
         {
             std::wstring reuse{};
 
-            if (suppressDuplicates)
+            if (suppressDuplicates && _ContainsCommand(newCommand))
             {
                 SHORT index;
                 if (FindMatchingCommand(newCommand, LastDisplayed, index, CommandHistory::MatchOptions::ExactMatch))
@@ -124,6 +159,7 @@ void CommandHistory::_Reset()
             // find free record.  if all records are used, free the lru one.
             if ((SHORT)_commands.size() == _maxCommands)
             {
+                _UntrackCommand(_commands.front());
                 _commands.erase(_commands.cbegin());
                 // move LastDisplayed back one in order to stay synced with the
                 // command it referred to before erasing the lru one
@@ -139,6 +175,7 @@ void CommandHistory::_Reset()
             {
                 _commands.emplace_back(newCommand);
             }
+            _TrackCommand(_commands.back());
 
             if (LastDisplayed == -1 ||
                 _commands.at(LastDisplayed).size() != newCommand.size() ||
@@ -249,6 +286,7 @@ std::wstring_view CommandHistory::GetLastCommand() const
 void CommandHistory::Empty()
 {
     _commands.clear();
+    _commandCounts.clear();
     LastDisplayed = -1;
     WI_SetFlag(Flags, CLE_RESET);
 }
@@ -286,9 +324,11 @@ void CommandHistory::Realloc(const size_t commands)
     const auto newNumberOfCommands = gsl::narrow<SHORT>(std::min(_commands.size(), commands));
 
     _commands.clear();
+    _commandCounts.clear();
     for (SHORT i = 0; i < newNumberOfCommands; i++)
     {
         _commands.emplace_back(oldCommands[i]);
+        _TrackCommand(_commands.back());
     }
 
     WI_SetFlag(Flags, CLE_RESET);
@@ -302,11 +342,8 @@ void CommandHistory::s_ReallocExeToFront(const std::wstring_view appName, const
     {
         if (WI_IsFlagSet(it->Flags, CLE_ALLOCATED) && it->IsAppNameMatch(appName))
         {
-            CommandHistory backup = *it;
-            backup.Realloc(commands);
-
-            s_historyLists.erase(it);
-            s_historyLists.push_front(backup);
+            it->Realloc(commands);
+            s_historyLists.splice(s_historyLists.begin(), s_historyLists, it);
 
             return;
         }
@@ -341,19 +378,18 @@ CommandHistory* CommandHistory::s_Allocate(const std::wstring_view appName, cons
     CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
     // Reuse a history buffer.  The buffer must be !CLE_ALLOCATED.
     // If possible, the buffer should have the same app name.
-    std::optional<CommandHistory> BestCandidate;
+    auto BestCandidate = s_historyLists.end();
     bool SameApp = false;
 
-    for (auto it = s_historyLists.cbegin(); it != s_historyLists.cend(); it++)
+    for (auto it = s_historyLists.begin(); it != s_historyLists.end(); it++)
     {
         if (WI_IsFlagClear(it->Flags, CLE_ALLOCATED))
         {
             // use LRU history buffer with same app name
             if (it->IsAppNameMatch(appName))
             {
-                BestCandidate = *it;
+                BestCandidate = it;
                 SameApp = true;
-                s_historyLists.erase(it);
                 break;
             }
         }
@@ -370,28 +406,30 @@ CommandHistory* CommandHistory::s_Allocate(const std::wstring_view appName, cons
         History.LastDisplayed = -1;
         History._maxCommands = gsl::narrow<SHORT>(gci.GetHistoryBufferSize());
         History._processHandle = processHandle;
-        return &s_historyLists.emplace_front(History);
+        auto& allocated = s_historyLists.emplace_front(std::move(History));
+        s_historiesByProcess.insert_or_assign(processHandle, &allocated);
+        return &allocated;
     }
-    else if (!BestCandidate.has_value() && s_historyLists.size() > 0)
+    else if (BestCandidate == s_historyLists.end() && s_historyLists.size() > 0)
     {
         // If we have no candidate already and we need one, take the LRU (which is the back/last one) which isn't allocated.
-        for (auto it = s_historyLists.crbegin(); it != s_historyLists.crend(); it++)
+        for (auto it = s_historyLists.rbegin(); it != s_historyLists.rend(); it++)
         {
             if (WI_IsFlagClear(it->Flags, CLE_ALLOCATED))
             {
-                BestCandidate = *it;
-                s_historyLists.erase(std::next(it).base()); // trickery to turn reverse iterator into forward iterator for erase.
+                BestCandidate = std::next(it).base(); // trickery to turn reverse iterator into forward iterator.
                 break;
             }
         }
     }
 
     // If the app name doesn't match, copy in the new app name and free the old commands.
-    if (BestCandidate.has_value())
+    if (BestCandidate != s_historyLists.end())
     {
         if (!SameApp)
         {
             BestCandidate->_commands.clear();
+            BestCandidate->_commandCounts.clear();
             BestCandidate->LastDisplayed = -1;
             BestCandidate->_appName = appName;
         }
@@ -399,7 +437,10 @@ CommandHistory* CommandHistory::s_Allocate(const std::wstring_view appName, cons
         BestCandidate->_processHandle = processHandle;
         WI_SetFlag(BestCandidate->Flags, CLE_ALLOCATED);
 
-        return &s_historyLists.emplace_front(BestCandidate.value());
+        // move it to the front without copying its commands around.
+        s_historyLists.splice(s_historyLists.begin(), s_historyLists, BestCandidate);
+        s_historiesByProcess.insert_or_assign(processHandle, &*BestCandidate);
+        return &*BestCandidate;
     }
 
     return nullptr;
@@ -471,6 +512,7 @@ std::wstring CommandHistory::Remove(const SHORT iDel)
     try
     {
         const auto str = _commands.at(iDel);
+        _UntrackCommand(str);
 
         if (iDel < iLast)
         {
@@ -556,6 +598,7 @@ std::wstring CommandHistory::Remove(const SHORT iDel)
 void CommandHistory::s_ClearHistoryListStorage()
 {
     s_historyLists.clear();
+    s_historiesByProcess.clear();
 }
 #endif
 
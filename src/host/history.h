@@ -83,13 +83,22 @@ private:
     void _Dec(SHORT& ind) const;
     void _Inc(SHORT& ind) const;
 
+    void _TrackCommand(const std::wstring_view command);
+    void _UntrackCommand(const std::wstring_view command);
+    bool _ContainsCommand(const std::wstring_view command) const;
+
     std::vector<std::wstring> _commands;
     SHORT _maxCommands;
 
+    // Case-folded commands mapped to the number of times they're in _commands.
+    // Lets Add skip the duplicate search for commands that aren't stored yet.
+    std::unordered_map<std::wstring, size_t> _commandCounts;
+
     std::wstring _appName;
     HANDLE _processHandle;
 
     static std::list<CommandHistory> s_historyLists;
+    static std::unordered_map<HANDLE, CommandHistory*> s_historiesByProcess;
 
 public:
     DWORD Flags;
@@ -157,13 +157,18 @@ void InputBuffer::ReinitializeInputBuffer()
 
 // Routine Description:
 // - Wakes up readers waiting for data to read.
+// - Only the oldest waiter is notified, since it's the one that gets the data.
+//   If it completes and leaves data behind, the next one is notified, and so on.
+//   Waiters that can't make progress because the buffer ran dry aren't re-entered.
 // Arguments:
 // - None
 // Return Value:
 // - None
 void InputBuffer::WakeUpReadersWaitingForData()
 {
-    WaitQueue.NotifyWaiters(false);
+    while (WaitQueue.NotifyWaiters(false) && GetNumberOfReadyEvents() != 0)
+    {
+    }
 }
 
 // Routine Description:
@@ -599,7 +604,14 @@ size_t InputBuffer::Write(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEv
         }
 
         // Alert any writers waiting for space.
-        WakeUpReadersWaitingForData();
+        if (_batchingWrites)
+        {
+            _wakeUpPending = true;
+        }
+        else
+        {
+            WakeUpReadersWaitingForData();
+        }
         return EventsWritten;
     }
     catch (...)
@@ -609,6 +621,41 @@ size_t InputBuffer::Write(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEv
     }
 }
 
+// Routine Description:
+// - Starts a batch of writes. Until EndBatchedWrites is called, writing
+//   events won't wake up readers that are waiting for data.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+// Note:
+// - The console lock must be held from here until EndBatchedWrites.
+void InputBuffer::BeginBatchedWrites() noexcept
+{
+    _batchingWrites = true;
+}
+
+// Routine Description:
+// - Ends a batch of writes, waking up waiting readers once if anything was written.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+// Note:
+// - The console lock must be held when calling this routine.
+void InputBuffer::EndBatchedWrites() noexcept
+{
+    _batchingWrites = false;
+    if (std::exchange(_wakeUpPending, false))
+    {
+        try
+        {
+            WakeUpReadersWaitingForData();
+        }
+        CATCH_LOG();
+    }
+}
+
 // Routine Description:
 // - Coalesces input events and transfers them to storage queue.
 // Arguments:
@@ -656,40 +703,18 @@ void InputBuffer::_WriteBuffer(_Inout_ std::deque<std::unique_ptr<IInputEvent>>&
         // that was depending on it.
         if (initialInEventsSize == 1 && !_storage.empty())
         {
-            // coalescing requires a deque of events, so push it back onto the front.
-            inEvents.push_front(std::move(inEvent));
-
-            bool coalesced = false;
-            // this looks kinda weird but we don't want to coalesce a
-            // mouse event and then try to coalesce a key event right after.
-            //
-            // we also pass the whole deque to the coalescing methods
-            // even though they only want one event because it should
-            // be their responsibility to maintain the correct state
-            // of the deque if they process any records in it.
-            if (_CoalesceMouseMovedEvents(inEvents))
-            {
-                coalesced = true;
-            }
-            else if (_CoalesceRepeatedKeyPressEvents(inEvents))
-            {
-                coalesced = true;
-            }
-            if (coalesced)
+            // we don't want to coalesce a mouse event and then try
+            // to coalesce a key event right after.
+            if (_CoalesceMouseMovedEvents(*inEvent) ||
+                _CoalesceRepeatedKeyPressEvents(*inEvent))
             {
                 eventsWritten = 1;
                 return;
             }
-            else
-            {
-                // We didn't coalesce the event. pull it from the queue again,
-                //  to keep the state consistent with the start of this block.
-                inEvent = std::move(inEvents.front());
-                inEvents.pop_front();
-            }
         }
         // At this point, the event was neither coalesced, nor processed by VT.
         _storage.push_back(std::move(inEvent));
+        _coalescedMouseMoves = 0;
         ++eventsWritten;
     }
     if (initiallyEmptyQueue && !_storage.empty())
@@ -699,42 +724,48 @@ void InputBuffer::_WriteBuffer(_Inout_ std::deque<std::unique_ptr<IInputEvent>>&
 }
 
 // Routine Description:
-// - Checks if the last saved event and the first event of inRecords are
-// both MOUSE_MOVED events. If they are, the last saved event is
-// updated with the new mouse position and the first event of inRecords is
-// dropped.
+// - Sets how many MOUSE_MOVED events may be folded into a single stored
+// event before a new one is stored. Applications that need to see every
+// movement can pass 0 to turn mouse move coalescing off.
+// Arguments:
+// - limit - the maximum number of coalesced mouse moves per stored event
+// Return Value:
+// - <none>
+void InputBuffer::SetMouseMoveCoalescingLimit(const size_t limit) noexcept
+{
+    _mouseMoveCoalescingLimit = limit;
+}
+
+// Routine Description:
+// - Checks if the last saved event and inEvent are both MOUSE_MOVED
+// events. If they are, the last saved event is updated in place with the
+// new mouse position.
 // Arguments:
-// - inRecords - The incoming records to process.
+// - inEvent - The incoming event to process.
 // Return Value:
-// true if events were coalesced, false if they were not.
+// true if the event was coalesced, false if it was not.
 // Note:
-// - The size of inRecords must be 1.
 // - Coalescing here means updating a record that already exists in
 // the buffer with updated values from an incoming event, instead of
 // storing the incoming event (which would make the original one
 // redundant/out of date with the most current state).
-bool InputBuffer::_CoalesceMouseMovedEvents(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents)
+bool InputBuffer::_CoalesceMouseMovedEvents(const IInputEvent& inEvent) noexcept
 {
-    FAIL_FAST_IF(!(inEvents.size() == 1));
     FAIL_FAST_IF(_storage.empty());
-    const IInputEvent* const pFirstInEvent = inEvents.front().get();
-    const IInputEvent* const pLastStoredEvent = _storage.back().get();
-    if (pFirstInEvent->EventType() == InputEventType::MouseEvent &&
+    IInputEvent* const pLastStoredEvent = _storage.back().get();
+    if (_coalescedMouseMoves < _mouseMoveCoalescingLimit &&
+        inEvent.EventType() == InputEventType::MouseEvent &&
         pLastStoredEvent->EventType() == InputEventType::MouseEvent)
     {
-        const MouseEvent* const pInMouseEvent = static_cast<const MouseEvent* const>(pFirstInEvent);
-        const MouseEvent* const pLastMouseEvent = static_cast<const MouseEvent* const>(pLastStoredEvent);
+        const auto& inMouseEvent = static_cast<const MouseEvent&>(inEvent);
+        auto& lastMouseEvent = static_cast<MouseEvent&>(*pLastStoredEvent);
 
-        if (pInMouseEvent->IsMouseMoveEvent() &&
-            pLastMouseEvent->IsMouseMoveEvent())
+        if (inMouseEvent.IsMouseMoveEvent() &&
+            lastMouseEvent.IsMouseMoveEvent())
         {
             // update mouse moved position
-            MouseEvent* const pMouseEvent = static_cast<MouseEvent* const>(_storage.back().release());
-            pMouseEvent->SetPosition(pInMouseEvent->GetPosition());
-            std::unique_ptr<IInputEvent> tempPtr(pMouseEvent);
-            tempPtr.swap(_storage.back());
-
-            inEvents.pop_front();
+            lastMouseEvent.SetPosition(inMouseEvent.GetPosition());
+            ++_coalescedMouseMoves;
             return true;
         }
     }
@@ -767,44 +798,34 @@ bool InputBuffer::_CanCoalesce(const KeyEvent& a, const KeyEvent& b) const noexc
 }
 
 // Routine Description::
-// - If the last input event saved and the first input event in inRecords
-// are both a keypress down event for the same key, update the repeat
-// count of the saved event and drop the first from inRecords.
+// - If the last input event saved and inEvent are both a keypress down
+// event for the same key, update the repeat count of the saved event.
 // Arguments:
-// - inRecords - The incoming records to process.
+// - inEvent - The incoming event to process.
 // Return Value:
-// true if events were coalesced, false if they were not.
+// true if the event was coalesced, false if it was not.
 // Note:
-// - The size of inRecords must be 1.
 // - Coalescing here means updating a record that already exists in
 // the buffer with updated values from an incoming event, instead of
 // storing the incoming event (which would make the original one
 // redundant/out of date with the most current state).
-bool InputBuffer::_CoalesceRepeatedKeyPressEvents(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents)
+bool InputBuffer::_CoalesceRepeatedKeyPressEvents(const IInputEvent& inEvent)
 {
-    FAIL_FAST_IF(!(inEvents.size() == 1));
     FAIL_FAST_IF(_storage.empty());
-    const IInputEvent* const pFirstInEvent = inEvents.front().get();
-    const IInputEvent* const pLastStoredEvent = _storage.back().get();
-    if (pFirstInEvent->EventType() == InputEventType::KeyEvent &&
+    IInputEvent* const pLastStoredEvent = _storage.back().get();
+    if (inEvent.EventType() == InputEventType::KeyEvent &&
         pLastStoredEvent->EventType() == InputEventType::KeyEvent)
     {
-        const KeyEvent* const pInKeyEvent = static_cast<const KeyEvent* const>(pFirstInEvent);
-        const KeyEvent* const pLastKeyEvent = static_cast<const KeyEvent* const>(pLastStoredEvent);
+        const auto& inKeyEvent = static_cast<const KeyEvent&>(inEvent);
+        auto& lastKeyEvent = static_cast<KeyEvent&>(*pLastStoredEvent);
 
-        if (pInKeyEvent->IsKeyDown() &&
-            pLastKeyEvent->IsKeyDown() &&
-            !IsGlyphFullWidth(pInKeyEvent->GetCharData()) &&
-            _CanCoalesce(*pInKeyEvent, *pLastKeyEvent))
+        if (inKeyEvent.IsKeyDown() &&
+            lastKeyEvent.IsKeyDown() &&
+            !IsGlyphFullWidth(inKeyEvent.GetCharData()) &&
+            _CanCoalesce(inKeyEvent, lastKeyEvent))
         {
             // increment repeat count
-            KeyEvent* const pKeyEvent = static_cast<KeyEvent* const>(_storage.back().release());
-            WORD repeatCount = pKeyEvent->GetRepeatCount() + pInKeyEvent->GetRepeatCount();
-            pKeyEvent->SetRepeatCount(repeatCount);
-            std::unique_ptr<IInputEvent> tempPtr(pKeyEvent);
-            tempPtr.swap(_storage.back());
-
-            inEvents.pop_front();
+            lastKeyEvent.SetRepeatCount(lastKeyEvent.GetRepeatCount() + inKeyEvent.GetRepeatCount());
             return true;
         }
     }
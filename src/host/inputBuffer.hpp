@@ -75,6 +75,11 @@ public:
     size_t Write(_Inout_ std::unique_ptr<IInputEvent> inEvent);
     size_t Write(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents);
 
+    void BeginBatchedWrites() noexcept;
+    void EndBatchedWrites() noexcept;
+
+    void SetMouseMoveCoalescingLimit(const size_t limit) noexcept;
+
     bool IsInVirtualTerminalInputMode() const;
     Microsoft::Console::VirtualTerminal::TerminalInput& GetTerminalInput();
     void SetTerminalConnection(_In_ Microsoft::Console::ITerminalOutputConnection* const pTtyConnection);
@@ -93,6 +98,16 @@ private:
     // Otherwise, we should be calling them.
     bool _vtInputShouldSuppress{ false };
 
+    // While writes are batched, waiting readers are only woken up once
+    // the batch ends, so that they don't wake up for every single write.
+    bool _batchingWrites{ false };
+    bool _wakeUpPending{ false };
+
+    // How many mouse moves have been folded into the last stored event,
+    // and how many are allowed to be before a new event is stored.
+    size_t _coalescedMouseMoves{ 0 };
+    size_t _mouseMoveCoalescingLimit{ SIZE_MAX };
+
     void _ReadBuffer(_Out_ std::deque<std::unique_ptr<IInputEvent>>& outEvents,
                      const size_t readCount,
                      _Out_ size_t& eventsRead,
@@ -106,8 +121,8 @@ private:
                       _Out_ bool& setWaitEvent);
 
     bool _CanCoalesce(const KeyEvent& a, const KeyEvent& b) const noexcept;
-    bool _CoalesceMouseMovedEvents(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents);
-    bool _CoalesceRepeatedKeyPressEvents(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents);
+    bool _CoalesceMouseMovedEvents(const IInputEvent& inEvent) noexcept;
+    bool _CoalesceRepeatedKeyPressEvents(const IInputEvent& inEvent);
     void _HandleConsoleSuspensionEvents(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents);
 
     void _HandleTerminalInputCallback(_In_ std::deque<std::unique_ptr<IInputEvent>>& inEvents);
@@ -95,20 +95,40 @@ static void _CopyRectangle(SCREEN_INFORMATION& screenInfo,
     // 2. We can move any other scenario in-place without copying. We just have to carefully
     //    choose which direction we walk through filling up the target so it doesn't accidentally
     //    erase the source material before it can be copied/moved to the new location.
+    //    Walking row by row, most rows can copy their whole span at once like memmove does.
+    //    Only the rows the ROW can't copy that way are copied cell by cell.
     {
         const auto target = Viewport::FromDimensions(targetOrigin, source.Dimensions());
         const auto walkDirection = Viewport::DetermineWalkDirection(source, target);
+        const auto width = gsl::narrow_cast<size_t>(source.Width());
+        auto& textBuffer = screenInfo.GetTextBuffer();
 
-        auto sourcePos = source.GetWalkOrigin(walkDirection);
-        auto targetPos = target.GetWalkOrigin(walkDirection);
-
-        do
+        for (SHORT i = 0; i < source.Height(); ++i)
         {
-            const auto data = OutputCell(*screenInfo.GetCellDataAt(sourcePos));
-            screenInfo.Write(OutputCellIterator({ &data, 1 }), targetPos);
+            const auto y = walkDirection.y == Viewport::YWalk::TopToBottom ? i : gsl::narrow_cast<SHORT>(source.Height() - 1 - i);
+            const auto sourceY = gsl::narrow_cast<SHORT>(source.Top() + y);
+            const auto targetY = gsl::narrow_cast<SHORT>(target.Top() + y);
+
+            const auto& sourceRow = textBuffer.GetRowByOffset(sourceY);
+            auto& targetRow = textBuffer.GetRowByOffset(targetY);
+            if (targetRow.CopyCells(sourceRow, source.Left(), target.Left(), width))
+            {
+                continue;
+            }
 
-            source.WalkInBounds(sourcePos, walkDirection);
-        } while (target.WalkInBounds(targetPos, walkDirection));
+            const auto sourceLine = Viewport::FromDimensions({ source.Left(), sourceY }, { source.Width(), 1 });
+            const auto targetLine = Viewport::FromDimensions({ target.Left(), targetY }, { target.Width(), 1 });
+            auto sourcePos = sourceLine.GetWalkOrigin(walkDirection);
+            auto targetPos = targetLine.GetWalkOrigin(walkDirection);
+
+            do
+            {
+                const auto data = OutputCell(*screenInfo.GetCellDataAt(sourcePos));
+                screenInfo.Write(OutputCellIterator({ &data, 1 }), targetPos);
+
+                sourceLine.WalkInBounds(sourcePos, walkDirection);
+            } while (targetLine.WalkInBounds(targetPos, walkDirection));
+        }
     }
 }
 
@@ -382,15 +402,19 @@ void ScrollRegion(SCREEN_INFORMATION& screenInfo,
 
     // Determine the cell we will use to fill in any revealed/uncovered space.
     // We generally use exactly what was given to us.
-    OutputCellIterator fillData(fillCharGiven, fillAttrsGiven);
+    auto fillChar = fillCharGiven;
+    auto fillAttrs = fillAttrsGiven;
 
     // However, if the character is null and we were given a null attribute (represented as legacy 0),
     // then we'll just fill with spaces and whatever the buffer's default colors are.
     if (fillCharGiven == UNICODE_NULL && fillAttrsGiven == TextAttribute{ 0 })
     {
-        fillData = OutputCellIterator(UNICODE_SPACE, screenInfo.GetAttributes());
+        fillChar = UNICODE_SPACE;
+        fillAttrs = screenInfo.GetAttributes();
     }
 
+    const OutputCellIterator fillData(fillChar, fillAttrs);
+
     // ------ 4. PREP TARGET ------
     // Now it's time to think about the target. We're only given the origin of the target
     // because it is assumed that it will have the same relative dimensions as the original source.
@@ -450,7 +474,17 @@ void ScrollRegion(SCREEN_INFORMATION& screenInfo,
     for (size_t i = 0; i < remaining.size(); i++)
     {
         const auto& view = remaining.at(i);
-        screenInfo.WriteRect(fillData, view);
+
+        // Rows that are blanked across the full buffer width (the usual case when
+        // scrolling within the margins) can be erased as a whole, not cell by cell.
+        if (view.Width() == buffer.Width() && fillChar == UNICODE_SPACE)
+        {
+            screenInfo.GetTextBuffer().EraseRows(view.Top(), view.BottomExclusive(), fillAttrs);
+        }
+        else
+        {
+            screenInfo.WriteRect(fillData, view);
+        }
 
         // If we're scrolling an area that encompasses the full buffer width,
         // then the filled rows should also have their line rendition reset.
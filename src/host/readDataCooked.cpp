@@ -707,29 +707,36 @@ bool COOKED_READ_DATA::ProcessInput(const wchar_t wchOrig,
             CursorPosition = _screenInfo.GetTextBuffer().GetCursor().GetPosition();
             CursorPosition.X = (SHORT)(CursorPosition.X + NumSpaces);
 
-            // clear the current command line from the screen
-            // clang-format off
-#pragma prefast(suppress: __WARNING_BUFFER_OVERFLOW, "Not sure why prefast doesn't like this call.")
-            // clang-format on
-            DeleteCommandLine(*this, FALSE);
-
-            // write the new command line to the screen
-            NumToWrite = _bytesRead;
-
             DWORD dwFlags = WC_DESTRUCTIVE_BACKSPACE | WC_PRINTABLE_CONTROL_CHARS;
             if (wch == UNICODE_CARRIAGERETURN)
             {
                 dwFlags |= WC_KEEP_CURSOR_VISIBLE;
+
+                // clear the current command line from the screen
+                // clang-format off
+#pragma prefast(suppress: __WARNING_BUFFER_OVERFLOW, "Not sure why prefast doesn't like this call.")
+                // clang-format on
+                DeleteCommandLine(*this, FALSE);
+
+                // write the new command line to the screen
+                NumToWrite = _bytesRead;
+                status = WriteCharsLegacy(_screenInfo,
+                                          _backupLimit,
+                                          _backupLimit,
+                                          _backupLimit,
+                                          &NumToWrite,
+                                          &_visibleCharCount,
+                                          _originalCursorPosition.X,
+                                          dwFlags,
+                                          &ScrollY);
+            }
+            else
+            {
+                // After a backspace, the cursor moved back onto the character that took
+                // the deleted one's place. Otherwise, it's still on the one we just stored.
+                const auto start = wch == UNICODE_BACKSPACE ? _currentPosition : _currentPosition - 1;
+                status = _redrawFromCursor(start, dwFlags, ScrollY);
             }
-            status = WriteCharsLegacy(_screenInfo,
-                                      _backupLimit,
-                                      _backupLimit,
-                                      _backupLimit,
-                                      &NumToWrite,
-                                      &_visibleCharCount,
-                                      _originalCursorPosition.X,
-                                      dwFlags,
-                                      &ScrollY);
             if (!NT_SUCCESS(status))
             {
                 RIPMSG1(RIP_WARNING, "WriteCharsLegacy failed 0x%x", status);
@@ -815,6 +822,53 @@ bool COOKED_READ_DATA::ProcessInput(const wchar_t wchOrig,
     return false;
 }
 
+// Routine Description:
+// - Redraws the command line after a character in its middle was inserted,
+//   overwritten or deleted. The characters in front of the edit didn't
+//   change, so only the rest of the line is written, starting at the cursor,
+//   which sits on the first changed character. If the line got shorter,
+//   the cells it vacated are blanked. This saves rewriting (and, in conpty,
+//   sending) all of a long, wrapped line for every key.
+// Arguments:
+// - start - the index of the first changed character, which the cursor is on
+// - dwFlags - the flags for WriteCharsLegacy
+// - ScrollY - receives how far the screen scrolled while writing
+// Return Value:
+// - the status of WriteCharsLegacy
+[[nodiscard]] NTSTATUS COOKED_READ_DATA::_redrawFromCursor(const size_t start, const DWORD dwFlags, SHORT& ScrollY)
+{
+    const auto oldVisibleCharCount = _visibleCharCount;
+    const auto prefixCharCount = RetrieveTotalNumberOfSpaces(_originalCursorPosition.X, _backupLimit, start);
+
+    size_t NumToWrite = _bytesRead - (start * sizeof(WCHAR));
+    size_t suffixCharCount = 0;
+    const auto status = WriteCharsLegacy(_screenInfo,
+                                         _backupLimit,
+                                         _backupLimit + start,
+                                         _backupLimit + start,
+                                         &NumToWrite,
+                                         &suffixCharCount,
+                                         _originalCursorPosition.X,
+                                         dwFlags,
+                                         &ScrollY);
+    if (!NT_SUCCESS(status))
+    {
+        return status;
+    }
+
+    _visibleCharCount = prefixCharCount + suffixCharCount;
+    if (oldVisibleCharCount > _visibleCharCount)
+    {
+        try
+        {
+            _screenInfo.Write(OutputCellIterator(UNICODE_SPACE, oldVisibleCharCount - _visibleCharCount),
+                              _screenInfo.GetTextBuffer().GetCursor().GetPosition());
+        }
+        CATCH_LOG();
+    }
+    return status;
+}
+
 // Routine Description:
 // - Writes string to current position in prompt line. can overwrite text to the right of the cursor.
 // Arguments:
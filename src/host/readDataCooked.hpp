@@ -159,4 +159,5 @@ private:
     [[nodiscard]] NTSTATUS _readCharInputLoop(const bool isUnicode, size_t& numBytes) noexcept;
 
     [[nodiscard]] NTSTATUS _handlePostCharInputLoop(const bool isUnicode, size_t& numBytes, ULONG& controlKeyState) noexcept;
+    [[nodiscard]] NTSTATUS _redrawFromCursor(const size_t start, const DWORD dwFlags, SHORT& ScrollY);
 };
@@ -45,14 +45,26 @@ void Registry::GetEditKeys(_In_opt_ HKEY hConsoleKey) const
         }
     }
 
+    std::shared_ptr<const RegistrySerialization::ValueSnapshot> values;
+    Status = RegistrySerialization::s_SnapshotValues(hConsoleKey, L"", values);
+    if (!NT_SUCCESS(Status))
+    {
+        LOG_NTSTATUS(Status);
+        if (hCurrentUserKey)
+        {
+            RegCloseKey((HKEY)hConsoleKey);
+            RegCloseKey((HKEY)hCurrentUserKey);
+        }
+        return;
+    }
+
     // determine whether the user wants to allow alt-f4 to close the console (global setting)
     DWORD dwValue;
-    Status = RegistrySerialization::s_QueryValue(hConsoleKey,
-                                                 CONSOLE_REGISTRY_ALLOW_ALTF4_CLOSE,
-                                                 sizeof(dwValue),
-                                                 REG_DWORD,
-                                                 (PBYTE)&dwValue,
-                                                 nullptr);
+    Status = values->QueryValue(CONSOLE_REGISTRY_ALLOW_ALTF4_CLOSE,
+                                sizeof(dwValue),
+                                REG_DWORD,
+                                (PBYTE)&dwValue,
+                                nullptr);
     if (NT_SUCCESS(Status) && dwValue <= 1)
     {
         gci.SetAltF4CloseAllowed(!!dwValue);
@@ -77,24 +89,22 @@ void Registry::GetEditKeys(_In_opt_ HKEY hConsoleKey) const
     // Read word delimiters from registry
     auto& delimiters = ServiceLocator::LocateGlobals().WordDelimiters;
     delimiters.clear();
-    Status = RegistrySerialization::s_QueryValue(hConsoleKey,
-                                                 CONSOLE_REGISTRY_WORD_DELIM,
-                                                 sizeof(dwValue),
-                                                 REG_DWORD,
-                                                 reinterpret_cast<BYTE*>(&dwValue),
-                                                 nullptr);
+    Status = values->QueryValue(CONSOLE_REGISTRY_WORD_DELIM,
+                                sizeof(dwValue),
+                                REG_DWORD,
+                                reinterpret_cast<BYTE*>(&dwValue),
+                                nullptr);
     if (!NT_SUCCESS(Status))
     {
         // the key isn't a REG_DWORD, try to read it as a REG_SZ
         const size_t bufferSize = 64;
         WCHAR awchBuffer[bufferSize];
         DWORD cbWritten = 0;
-        Status = RegistrySerialization::s_QueryValue(hConsoleKey,
-                                                     CONSOLE_REGISTRY_WORD_DELIM,
-                                                     bufferSize * sizeof(WCHAR),
-                                                     REG_SZ,
-                                                     reinterpret_cast<BYTE*>(awchBuffer),
-                                                     &cbWritten);
+        Status = values->QueryValue(CONSOLE_REGISTRY_WORD_DELIM,
+                                    bufferSize * sizeof(WCHAR),
+                                    REG_SZ,
+                                    reinterpret_cast<BYTE*>(awchBuffer),
+                                    &cbWritten);
         if (NT_SUCCESS(Status))
         {
             // we read something, set it as the word delimiters
@@ -125,7 +135,7 @@ void Registry::GetEditKeys(_In_opt_ HKEY hConsoleKey) const
 
 void Registry::_LoadMappedProperties(_In_reads_(cPropertyMappings) const RegistrySerialization::RegPropertyMap* const rgPropertyMappings,
                                      const size_t cPropertyMappings,
-                                     const HKEY hKey)
+                                     const RegistrySerialization::ValueSnapshot& values)
 {
     // Iterate through properties table and load each setting for common property types
     for (UINT iMapping = 0; iMapping < cPropertyMappings; iMapping++)
@@ -142,12 +152,12 @@ void Registry::_LoadMappedProperties(_In_reads_(cPropertyMappings) const Registr
         case RegistrySerialization::_RegPropertyType::Byte:
         case RegistrySerialization::_RegPropertyType::Coordinate:
         {
-            Status = RegistrySerialization::s_LoadRegDword(hKey, pPropMap, _pSettings);
+            Status = RegistrySerialization::s_LoadRegDword(values, pPropMap, _pSettings);
             break;
         }
         case RegistrySerialization::_RegPropertyType::String:
         {
-            Status = RegistrySerialization::s_LoadRegString(hKey, pPropMap, _pSettings);
+            Status = RegistrySerialization::s_LoadRegString(values, pPropMap, _pSettings);
             break;
         }
         }
@@ -174,7 +184,16 @@ void Registry::LoadGlobalsFromRegistry()
 
     if (NT_SUCCESS(status))
     {
-        _LoadMappedProperties(RegistrySerialization::s_GlobalPropMappings, RegistrySerialization::s_GlobalPropMappingsSize, hConsoleKey);
+        std::shared_ptr<const RegistrySerialization::ValueSnapshot> values;
+        status = RegistrySerialization::s_SnapshotValues(hConsoleKey, L"", values);
+        if (NT_SUCCESS(status))
+        {
+            _LoadMappedProperties(RegistrySerialization::s_GlobalPropMappings, RegistrySerialization::s_GlobalPropMappingsSize, *values);
+        }
+        else
+        {
+            LOG_NTSTATUS(status);
+        }
 
         RegCloseKey((HKEY)hConsoleKey);
         RegCloseKey((HKEY)hCurrentUserKey);
@@ -217,6 +236,8 @@ void Registry::LoadFromRegistry(_In_ PCWSTR const pwszConsoleTitle)
         return;
     }
 
+    // The name of the subkey also identifies its values in the snapshot cache.
+    std::wstring titleKeyName{ TranslatedConsoleTitle };
     HKEY hTitleKey;
     Status = RegistrySerialization::s_OpenKey(hConsoleKey, TranslatedConsoleTitle, &hTitleKey);
     delete[] TranslatedConsoleTitle;
@@ -233,6 +254,7 @@ void Registry::LoadFromRegistry(_In_ PCWSTR const pwszConsoleTitle)
             return;
         }
 
+        titleKeyName = TranslatedConsoleTitle;
         Status = RegistrySerialization::s_OpenKey(hConsoleKey, TranslatedConsoleTitle, &hTitleKey);
         delete[] TranslatedConsoleTitle;
         TranslatedConsoleTitle = nullptr;
@@ -245,20 +267,35 @@ void Registry::LoadFromRegistry(_In_ PCWSTR const pwszConsoleTitle)
         return;
     }
 
+    // Read all the values of the subkey at once. Most of the properties below usually don't exist,
+    // and looking them up in the snapshot is a lot cheaper than asking the registry for each.
+    std::shared_ptr<const RegistrySerialization::ValueSnapshot> values;
+    Status = RegistrySerialization::s_SnapshotValues(hTitleKey, titleKeyName, values);
+    if (!NT_SUCCESS(Status))
+    {
+        LOG_NTSTATUS(Status);
+        if (hTitleKey != hConsoleKey)
+        {
+            RegCloseKey(hTitleKey);
+        }
+        RegCloseKey(hConsoleKey);
+        RegCloseKey(hCurrentUserKey);
+        return;
+    }
+
     // Iterate through properties table and load each setting for common property types
-    _LoadMappedProperties(RegistrySerialization::s_PropertyMappings, RegistrySerialization::s_PropertyMappingsSize, hTitleKey);
+    _LoadMappedProperties(RegistrySerialization::s_PropertyMappings, RegistrySerialization::s_PropertyMappingsSize, *values);
 
     // Now load complex properties
     // Some properties shouldn't be filled by the registry if a copy already exists from the process start information.
     DWORD dwValue;
 
     // Window Origin Autopositioning Setting
-    Status = RegistrySerialization::s_QueryValue(hTitleKey,
-                                                 CONSOLE_REGISTRY_WINDOWPOS,
-                                                 sizeof(dwValue),
-                                                 REG_DWORD,
-                                                 (PBYTE)&dwValue,
-                                                 nullptr);
+    Status = values->QueryValue(CONSOLE_REGISTRY_WINDOWPOS,
+                                sizeof(dwValue),
+                                REG_DWORD,
+                                (PBYTE)&dwValue,
+                                nullptr);
 
     if (NT_SUCCESS(Status))
     {
@@ -269,12 +306,11 @@ void Registry::LoadFromRegistry(_In_ PCWSTR const pwszConsoleTitle)
     //      HOWEVER, the defaults might not have been auto-pos, so don't assume that they are.
 
     // Code Page
-    Status = RegistrySerialization::s_QueryValue(hTitleKey,
-                                                 CONSOLE_REGISTRY_CODEPAGE,
-                                                 sizeof(dwValue),
-                                                 REG_DWORD,
-                                                 (PBYTE)&dwValue,
-                                                 nullptr);
+    Status = values->QueryValue(CONSOLE_REGISTRY_CODEPAGE,
+                                sizeof(dwValue),
+                                REG_DWORD,
+                                (PBYTE)&dwValue,
+                                nullptr);
     if (NT_SUCCESS(Status))
     {
         _pSettings->SetCodePage(dwValue);
@@ -302,12 +338,11 @@ void Registry::LoadFromRegistry(_In_ PCWSTR const pwszConsoleTitle)
     {
         WCHAR awchBuffer[64];
         StringCchPrintfW(awchBuffer, ARRAYSIZE(awchBuffer), CONSOLE_REGISTRY_COLORTABLE, i);
-        Status = RegistrySerialization::s_QueryValue(hTitleKey,
-                                                     awchBuffer,
-                                                     sizeof(dwValue),
-                                                     REG_DWORD,
-                                                     (PBYTE)&dwValue,
-                                                     nullptr);
+        Status = values->QueryValue(awchBuffer,
+                                    sizeof(dwValue),
+                                    REG_DWORD,
+                                    (PBYTE)&dwValue,
+                                    nullptr);
         if (NT_SUCCESS(Status))
         {
             _pSettings->SetColorTableEntry(i, dwValue);
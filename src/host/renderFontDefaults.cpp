@@ -7,20 +7,27 @@
 
 #pragma hdrstop
 
-RenderFontDefaults::RenderFontDefaults()
-{
-    LOG_IF_NTSTATUS_FAILED(TrueTypeFontList::s_Initialize());
-}
+// The list of TrueType fonts is only read from the registry once somebody actually asks for a
+// default font. A conpty session never renders with a font of its own, so it never pays for it.
+RenderFontDefaults::RenderFontDefaults() = default;
 
 RenderFontDefaults::~RenderFontDefaults()
 {
-    LOG_IF_FAILED(TrueTypeFontList::s_Destroy());
+    if (_initialized)
+    {
+        LOG_IF_FAILED(TrueTypeFontList::s_Destroy());
+    }
 }
 
 [[nodiscard]] HRESULT RenderFontDefaults::RetrieveDefaultFontNameForCodepage(const unsigned int codePage,
                                                                              std::wstring& outFaceName)
 try
 {
+    std::call_once(_initializeOnce, [this]() {
+        LOG_IF_NTSTATUS_FAILED(TrueTypeFontList::s_Initialize());
+        _initialized = true;
+    });
+
     // GH#3123: Propagate font length changes up through Settings and propsheet
     wchar_t faceName[LF_FACESIZE]{ 0 };
     NTSTATUS status = TrueTypeFontList::s_SearchByCodePage(codePage, faceName, ARRAYSIZE(faceName));
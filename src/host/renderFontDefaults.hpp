@@ -24,4 +24,8 @@ public:
 
     [[nodiscard]] HRESULT RetrieveDefaultFontNameForCodepage(const unsigned int codePage,
                                                              std::wstring& outFaceName);
+
+private:
+    std::once_flag _initializeOnce;
+    bool _initialized = false;
 };
@@ -96,7 +96,8 @@ SCREEN_INFORMATION::~SCREEN_INFORMATION()
                                                           const TextAttribute defaultAttributes,
                                                           const TextAttribute popupAttributes,
                                                           const UINT uiCursorSize,
-                                                          _Outptr_ SCREEN_INFORMATION** const ppScreen)
+                                                          _Outptr_ SCREEN_INFORMATION** const ppScreen,
+                                                          std::unique_ptr<TextBuffer> recycledTextBuffer)
 {
     *ppScreen = nullptr;
 
@@ -116,11 +117,22 @@ SCREEN_INFORMATION::~SCREEN_INFORMATION()
                                                       pScreen->_IsInPtyMode() ? coordScreenBufferSize : coordWindowSize);
         pScreen->UpdateBottom();
 
-        // Set up text buffer
-        pScreen->_textBuffer = std::make_unique<TextBuffer>(coordScreenBufferSize,
-                                                            defaultAttributes,
-                                                            uiCursorSize,
-                                                            pScreen->_renderTarget);
+        // Set up text buffer, reusing the given one if possible
+        if (recycledTextBuffer)
+        {
+            recycledTextBuffer->Recycle(coordScreenBufferSize,
+                                        defaultAttributes,
+                                        uiCursorSize,
+                                        pScreen->_renderTarget);
+            pScreen->_textBuffer = std::move(recycledTextBuffer);
+        }
+        else
+        {
+            pScreen->_textBuffer = std::make_unique<TextBuffer>(coordScreenBufferSize,
+                                                                defaultAttributes,
+                                                                uiCursorSize,
+                                                                pScreen->_renderTarget);
+        }
 
         const auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
         pScreen->_textBuffer->GetCursor().SetColor(gci.GetCursorColor());
@@ -341,6 +353,7 @@ bool SCREEN_INFORMATION::IsActiveScreenBuffer() const
 // - Attributes - Pointer to location in which to store the default attributes.
 // - CurrentWindowSize - Pointer to location in which to store current window size.
 // - MaximumWindowSize - Pointer to location in which to store maximum window size.
+// - maxClientRectInPixels - The largest client area the window could have, if the caller already knows it.
 // Return Value:
 // - None
 void SCREEN_INFORMATION::GetScreenBufferInformation(_Out_ PCOORD pcoordSize,
@@ -349,7 +362,8 @@ void SCREEN_INFORMATION::GetScreenBufferInformation(_Out_ PCOORD pcoordSize,
                                                     _Out_ PWORD pwAttributes,
                                                     _Out_ PCOORD pcoordMaximumWindowSize,
                                                     _Out_ PWORD pwPopupAttributes,
-                                                    _Out_writes_(COLOR_TABLE_SIZE) LPCOLORREF lpColorTable) const
+                                                    _Out_writes_(COLOR_TABLE_SIZE) LPCOLORREF lpColorTable,
+                                                    const std::optional<RECT>& maxClientRectInPixels) const
 {
     const CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
     *pcoordSize = GetBufferSize().Dimensions();
@@ -367,7 +381,7 @@ void SCREEN_INFORMATION::GetScreenBufferInformation(_Out_ PCOORD pcoordSize,
         lpColorTable[i] = gci.GetColorTableEntry(i);
     }
 
-    *pcoordMaximumWindowSize = GetMaxWindowSizeInCharacters();
+    *pcoordMaximumWindowSize = GetMaxWindowSizeInCharacters({ 1, 1 }, maxClientRectInPixels);
 }
 
 // Routine Description:
@@ -412,10 +426,12 @@ COORD SCREEN_INFORMATION::GetMinWindowSizeInCharacters(const COORD coordFontSize
 //   Takes the monitor work area and divides by the active font dimensions then limits by buffer size.
 // Arguments:
 // - coordFontSize - The font size to use for calculation if a screen buffer is not yet attached.
+// - maxClientRectInPixels - The largest client area the window could have, if the caller already knows it.
 // Return Value:
 // - COORD containing the width and height representing the largest character
 //      grid that can be rendered on the current monitor and/or from the current buffer size.
-COORD SCREEN_INFORMATION::GetMaxWindowSizeInCharacters(const COORD coordFontSize /*= { 1, 1 }*/) const
+COORD SCREEN_INFORMATION::GetMaxWindowSizeInCharacters(const COORD coordFontSize /*= { 1, 1 }*/,
+                                                       const std::optional<RECT>& maxClientRectInPixels /*= std::nullopt*/) const
 {
     FAIL_FAST_IF(coordFontSize.X == 0);
     FAIL_FAST_IF(coordFontSize.Y == 0);
@@ -429,7 +445,7 @@ COORD SCREEN_INFORMATION::GetMaxWindowSizeInCharacters(const COORD coordFontSize
     // In that case, we'll just return the buffer size as the "max" window size.
     if (!ServiceLocator::LocateGlobals().IsHeadless())
     {
-        const COORD coordWindowRestrictedSize = GetLargestWindowSizeInCharacters(coordFontSize);
+        const COORD coordWindowRestrictedSize = GetLargestWindowSizeInCharacters(coordFontSize, maxClientRectInPixels);
         // If the buffer is smaller than what the max window would allow, then the max client area can only be as big as the
         // buffer we have.
         coordClientAreaSize.X = std::min(coordScreenBufferSize.X, coordWindowRestrictedSize.X);
@@ -444,15 +460,17 @@ COORD SCREEN_INFORMATION::GetMaxWindowSizeInCharacters(const COORD coordFontSize
 // - Takes the window client area and divides by the active font dimensions.
 // Arguments:
 // - coordFontSize - The font size to use for calculation if a screen buffer is not yet attached.
+// - maxClientRectInPixels - The largest client area the window could have, if the caller already knows it.
 // Return Value:
 // - COORD containing the width and height representing the largest character
 //      grid that can be rendered on the current monitor with the maximum size window.
-COORD SCREEN_INFORMATION::GetLargestWindowSizeInCharacters(const COORD coordFontSize /*= { 1, 1 }*/) const
+COORD SCREEN_INFORMATION::GetLargestWindowSizeInCharacters(const COORD coordFontSize /*= { 1, 1 }*/,
+                                                           const std::optional<RECT>& maxClientRectInPixels /*= std::nullopt*/) const
 {
     FAIL_FAST_IF(coordFontSize.X == 0);
     FAIL_FAST_IF(coordFontSize.Y == 0);
 
-    RECT const rcClientInPixels = _pConsoleWindowMetrics->GetMaxClientRectInPixels();
+    RECT const rcClientInPixels = maxClientRectInPixels ? *maxClientRectInPixels : _pConsoleWindowMetrics->GetMaxClientRectInPixels();
 
     // first assign the pixel widths and heights to the final output
     COORD coordClientAreaSize;
@@ -1431,7 +1449,32 @@ bool SCREEN_INFORMATION::IsMaximizedY() const
         return STATUS_INVALID_PARAMETER;
     }
 
-    // First allocate a new text buffer to take the place of the current one.
+    // Save cursor's relative height versus the viewport
+    SHORT const sCursorHeightInViewportBefore = _textBuffer->GetCursor().GetPosition().Y - _viewport.Top();
+
+    // Most resizes (every one that only changes the height and those that don't wrap or
+    // unwrap any rows) can keep the rows of the current buffer. Reflowing a large buffer
+    // into a new one on every step of a window resize is slow.
+    {
+        _textBuffer->GetCursor().StartDeferDrawing();
+        auto endDefer = wil::scope_exit([&]() noexcept { _textBuffer->GetCursor().EndDeferDrawing(); });
+
+        const auto hr = _textBuffer->TryReflowInPlace(coordNewScreenSize);
+        if (hr != S_FALSE)
+        {
+            if (SUCCEEDED(hr))
+            {
+                // Adjust the viewport so the cursor doesn't wildly fly off up or down.
+                SHORT const sCursorHeightInViewportAfter = _textBuffer->GetCursor().GetPosition().Y - _viewport.Top();
+                COORD coordCursorHeightDiff = { 0 };
+                coordCursorHeightDiff.Y = sCursorHeightInViewportAfter - sCursorHeightInViewportBefore;
+                LOG_IF_FAILED(SetViewportOrigin(false, coordCursorHeightDiff, true));
+            }
+            return NTSTATUS_FROM_HRESULT(hr);
+        }
+    }
+
+    // Otherwise allocate a new text buffer to take the place of the current one.
     std::unique_ptr<TextBuffer> newTextBuffer;
 
     // GH#3848 - Stash away the current attributes the old text buffer is using.
@@ -1451,9 +1494,6 @@ bool SCREEN_INFORMATION::IsMaximizedY() const
         return NTSTATUS_FROM_HRESULT(wil::ResultFromCaughtException());
     }
 
-    // Save cursor's relative height versus the viewport
-    SHORT const sCursorHeightInViewportBefore = _textBuffer->GetCursor().GetPosition().Y - _viewport.Top();
-
     // skip any drawing updates that might occur until we swap _textBuffer with the new buffer or we exit early.
     newTextBuffer->GetCursor().StartDeferDrawing();
     _textBuffer->GetCursor().StartDeferDrawing();
@@ -1901,7 +1941,8 @@ const SCREEN_INFORMATION& SCREEN_INFORMATION::GetMainBuffer() const
                                                          initAttributes,
                                                          GetPopupAttributes(),
                                                          Cursor::CURSOR_SMALL_SIZE,
-                                                         ppsiNewScreenBuffer);
+                                                         ppsiNewScreenBuffer,
+                                                         std::move(GetMainBuffer()._pooledAltTextBuffer));
     if (NT_SUCCESS(Status))
     {
         // Update the alt buffer's cursor style, visibility, and position to match our own.
@@ -2010,6 +2051,10 @@ void SCREEN_INFORMATION::UseMainScreenBuffer()
         mainCursor.SetIsVisible(altCursor.IsVisible());
         mainCursor.SetBlinkingAllowed(altCursor.IsBlinkingAllowed());
 
+        // Applications like less or vim toggle the alt buffer all the time.
+        // Keep its text buffer around to recycle it for the next one.
+        psiMain->_pooledAltTextBuffer = std::move(psiAlt->_textBuffer);
+
         s_RemoveScreenBuffer(psiAlt); // this will also delete the alt buffer
         // deleting the alt buffer will give the GetSet back to its main
 
@@ -67,7 +67,8 @@ public:
                                                  const TextAttribute defaultAttributes,
                                                  const TextAttribute popupAttributes,
                                                  const UINT uiCursorSize,
-                                                 _Outptr_ SCREEN_INFORMATION** const ppScreen);
+                                                 _Outptr_ SCREEN_INFORMATION** const ppScreen,
+                                                 std::unique_ptr<TextBuffer> recycledTextBuffer = nullptr);
 
     ~SCREEN_INFORMATION();
 
@@ -77,7 +78,8 @@ public:
                                     _Out_ PWORD pwAttributes,
                                     _Out_ PCOORD pcoordMaximumWindowSize,
                                     _Out_ PWORD pwPopupAttributes,
-                                    _Out_writes_(COLOR_TABLE_SIZE) LPCOLORREF lpColorTable) const;
+                                    _Out_writes_(COLOR_TABLE_SIZE) LPCOLORREF lpColorTable,
+                                    const std::optional<RECT>& maxClientRectInPixels = std::nullopt) const;
 
     void GetRequiredConsoleSizeInPixels(_Out_ PSIZE const pRequiredSize) const;
 
@@ -86,8 +88,10 @@ public:
     void ClipToScreenBuffer(_Inout_ SMALL_RECT* const psrClip) const;
 
     COORD GetMinWindowSizeInCharacters(const COORD coordFontSize = { 1, 1 }) const;
-    COORD GetMaxWindowSizeInCharacters(const COORD coordFontSize = { 1, 1 }) const;
-    COORD GetLargestWindowSizeInCharacters(const COORD coordFontSize = { 1, 1 }) const;
+    COORD GetMaxWindowSizeInCharacters(const COORD coordFontSize = { 1, 1 },
+                                       const std::optional<RECT>& maxClientRectInPixels = std::nullopt) const;
+    COORD GetLargestWindowSizeInCharacters(const COORD coordFontSize = { 1, 1 },
+                                           const std::optional<RECT>& maxClientRectInPixels = std::nullopt) const;
     COORD GetScrollBarSizesInCharacters() const;
 
     Microsoft::Console::Types::Viewport GetBufferSize() const;
@@ -286,6 +290,9 @@ private:
 
     SCREEN_INFORMATION* _psiAlternateBuffer; // The VT "Alternate" screen buffer.
     SCREEN_INFORMATION* _psiMainBuffer; // A pointer to the main buffer, if this is the alternate buffer.
+    // The text buffer of the last alternate buffer, kept by the main buffer so that
+    // the next alternate buffer can recycle it instead of allocating one.
+    std::unique_ptr<TextBuffer> _pooledAltTextBuffer;
 
     RECT _rcAltSavedClientNew;
     RECT _rcAltSavedClientOld;
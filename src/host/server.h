@@ -150,6 +150,7 @@ public:
     RenderData renderData;
 
 private:
+    static constexpr DWORD s_consoleLockSpinCount = 4000;
     CRITICAL_SECTION _csConsoleLock; // serialize input and output using this
     std::wstring _Title;
     std::wstring _Prefix; // Eg Select, Mark - things that we manually prepend to the title.
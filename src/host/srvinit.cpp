@@ -62,8 +62,10 @@ try
 
     // Check if this conhost is allowed to delegate its activities to another.
     // If so, look up the registered default console handler.
+    // A PTY session never hands off (see _shouldAttemptHandoff), so it can skip
+    // the policy check and the registry lookups entirely.
     bool isEnabled = false;
-    if (SUCCEEDED(Microsoft::Console::Internal::DefaultApp::CheckDefaultAppPolicy(isEnabled)) && isEnabled)
+    if (!args->IsHeadless() && SUCCEEDED(Microsoft::Console::Internal::DefaultApp::CheckDefaultAppPolicy(isEnabled)) && isEnabled)
     {
         IID delegationClsid;
         if (SUCCEEDED(DelegationConfig::s_GetDefaultConsoleId(delegationClsid)))
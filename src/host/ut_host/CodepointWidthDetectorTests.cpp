@@ -62,6 +62,44 @@ class CodepointWidthDetectorTests
         }
     }
 
+    TEST_METHOD(BmpTableMatchesRangeTable)
+    {
+        CodepointWidthDetector widthDetector;
+        for (unsigned int codepoint = 0; codepoint <= 0xffff; ++codepoint)
+        {
+            const auto wch = static_cast<wchar_t>(codepoint);
+            const std::wstring_view glyph{ &wch, 1 };
+            if (widthDetector.GetWidth(glyph) != widthDetector._lookupGlyphWidth(glyph))
+            {
+                VERIFY_FAIL(WEX::Common::NoThrowString().Format(L"width mismatch for U+%04X", codepoint));
+            }
+        }
+    }
+
+    TEST_METHOD(CanGetWidthsOfText)
+    {
+        CodepointWidthDetector widthDetector;
+
+        std::wstring text;
+        std::vector<CodepointWidth> expected;
+        for (const auto& data : testData)
+        {
+            text.append(std::get<1>(data));
+            expected.emplace_back(std::get<2>(data));
+        }
+
+        // An unpaired surrogate is measured on its own.
+        text.push_back(L'\xD83D');
+        expected.emplace_back(widthDetector.GetWidth(L"\xD83D"));
+
+        const auto widths = widthDetector.GetWidths(text);
+        VERIFY_ARE_EQUAL(expected.size(), widths.size());
+        for (size_t i = 0; i < expected.size(); ++i)
+        {
+            VERIFY_ARE_EQUAL(expected[i], widths[i]);
+        }
+    }
+
     static bool FallbackMethod(const std::wstring_view glyph)
     {
         if (glyph.size() < 1)
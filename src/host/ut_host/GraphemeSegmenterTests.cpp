@@ -0,0 +1,96 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "WexTestClass.h"
+#include "../../inc/consoletaeftemplates.hpp"
+
+#include "../types/inc/GraphemeSegmenter.hpp"
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+
+// Text and the lengths (in code units) of its grapheme clusters.
+static const std::vector<std::pair<std::wstring, std::vector<size_t>>> testData = {
+    { L"abc", { 1, 1, 1 } },
+    { L"a\r\nb\n\r", { 1, 2, 1, 1, 1 } }, // CR LF is one cluster, LF CR isn't
+    { L"e\x0301x", { 2, 1 } }, // e + U+0301 combining acute accent
+    { L"\x0915\x093F", { 2 } }, // U+0915 devanagari ka + U+093F sign i (a spacing mark)
+    { L"\x0600" L"1", { 2 } }, // U+0600 arabic number sign prepends the number
+    { L"\xD83D\xDC68\x200D\xD83D\xDC69\x200D\xD83D\xDC67!", { 8, 1 } }, // man ZWJ woman ZWJ girl
+    { L"a\x200D\xD83D\xDC69", { 2, 2 } }, // ZWJ only joins pictographs
+    { L"\xD83C\xDDFA\xD83C\xDDF8\xD83C\xDDE9\xD83C\xDDEA\xD83C\xDDEB", { 4, 4, 2 } }, // flags are pairs of regional indicators
+    { L"\x1100\x1161\x11A8\xAC00\x11A8\xAC01\x11A8", { 3, 2, 2 } }, // L V T, LV T, LVT T
+    { L"a\xD800" L"b\xDC00\x0301", { 1, 1, 1, 1, 1 } }, // unpaired surrogates stand alone
+};
+
+class GraphemeSegmenterTests
+{
+    TEST_CLASS(GraphemeSegmenterTests);
+
+    static void _verifyBreakProperty(const GraphemeClusterBreak expected, const char32_t codepoint)
+    {
+        VERIFY_ARE_EQUAL(static_cast<int>(expected), static_cast<int>(GraphemeSegmenter::GetBreakProperty(codepoint)));
+    }
+
+    static void _verifyLengths(const std::vector<size_t>& expected, const std::vector<size_t>& actual)
+    {
+        VERIFY_ARE_EQUAL(expected.size(), actual.size());
+        for (size_t i = 0; i < expected.size(); ++i)
+        {
+            VERIFY_ARE_EQUAL(til::at(expected, i), til::at(actual, i));
+        }
+    }
+
+    TEST_METHOD(CanGetBreakProperties)
+    {
+        _verifyBreakProperty(GraphemeClusterBreak::Other, U'a');
+        _verifyBreakProperty(GraphemeClusterBreak::CR, U'\r');
+        _verifyBreakProperty(GraphemeClusterBreak::LF, U'\n');
+        _verifyBreakProperty(GraphemeClusterBreak::Control, 0x1B);
+        _verifyBreakProperty(GraphemeClusterBreak::Control, 0xAD);
+        _verifyBreakProperty(GraphemeClusterBreak::ExtendedPictographic, 0xA9);
+        _verifyBreakProperty(GraphemeClusterBreak::Extend, 0x301);
+        _verifyBreakProperty(GraphemeClusterBreak::ZWJ, 0x200D);
+        _verifyBreakProperty(GraphemeClusterBreak::RegionalIndicator, 0x1F1FA);
+        _verifyBreakProperty(GraphemeClusterBreak::L, 0x1100);
+        _verifyBreakProperty(GraphemeClusterBreak::LV, 0xAC00);
+        _verifyBreakProperty(GraphemeClusterBreak::LVT, 0xAC01);
+        _verifyBreakProperty(GraphemeClusterBreak::ExtendedPictographic, 0x1F600);
+        _verifyBreakProperty(GraphemeClusterBreak::Other, 0x10FFFF);
+    }
+
+    TEST_METHOD(CanFindBoundaries)
+    {
+        for (const auto& [text, expected] : testData)
+        {
+            Log::Comment(NoThrowString().Format(L"%s", text.c_str()));
+            std::vector<size_t> actual;
+            for (size_t offset = 0; offset < text.size();)
+            {
+                const auto end = GraphemeSegmenter::NextBoundary(text, offset);
+                actual.emplace_back(end - offset);
+                offset = end;
+            }
+            _verifyLengths(expected, actual);
+            VERIFY_ARE_EQUAL(expected.front(), GraphemeSegmenter::NextCluster(text).size());
+        }
+        VERIFY_ARE_EQUAL(size_t{ 0 }, GraphemeSegmenter::NextBoundary(L"", 0));
+    }
+
+    TEST_METHOD(SegmentMatchesNextBoundary)
+    {
+        // Segment() takes shortcuts for ASCII, which must not change the result.
+        for (const auto& [text, expected] : testData)
+        {
+            Log::Comment(NoThrowString().Format(L"%s", text.c_str()));
+            const auto clusters = GraphemeSegmenter::Segment(text);
+            std::vector<size_t> actual;
+            for (const auto& cluster : clusters)
+            {
+                actual.emplace_back(cluster.size());
+            }
+            _verifyLengths(expected, actual);
+        }
+    }
+};
@@ -242,6 +242,48 @@ class HistoryTests
         VERIFY_ARE_EQUAL(2ul, history->GetNumberOfCommands());
     }
 
+    TEST_METHOD(AddNoDuplicatesTracksRemovedCommands)
+    {
+        auto history = CommandHistory::s_Allocate(_manyApps[0], _MakeHandle(0));
+        VERIFY_IS_NOT_NULL(history);
+
+        // Duplicates are matched case insensitively.
+        VERIFY_SUCCEEDED(history->Add(L"dir", true));
+        VERIFY_SUCCEEDED(history->Add(L"cd", true));
+        VERIFY_SUCCEEDED(history->Add(L"DIR", true));
+        VERIFY_ARE_EQUAL(2ul, history->GetNumberOfCommands());
+        VERIFY_ARE_EQUAL(String(L"cd"), String(history->GetNth(0).data()));
+
+        // Once removed, a command isn't considered a duplicate anymore.
+        history->Remove(0);
+        VERIFY_SUCCEEDED(history->Add(L"echo", true));
+        VERIFY_SUCCEEDED(history->Add(L"cd", true));
+        VERIFY_ARE_EQUAL(3ul, history->GetNumberOfCommands());
+
+        history->Empty();
+        VERIFY_SUCCEEDED(history->Add(L"dir", true));
+        VERIFY_SUCCEEDED(history->Add(L"cd", true));
+        VERIFY_ARE_EQUAL(2ul, history->GetNumberOfCommands());
+    }
+
+    TEST_METHOD(FindByProcessHandle)
+    {
+        const auto first = CommandHistory::s_Allocate(_manyApps[0], _MakeHandle(0));
+        const auto second = CommandHistory::s_Allocate(_manyApps[1], _MakeHandle(1));
+        VERIFY_IS_NOT_NULL(first);
+        VERIFY_IS_NOT_NULL(second);
+
+        VERIFY_ARE_EQUAL(first, CommandHistory::s_Find(_MakeHandle(0)));
+        VERIFY_ARE_EQUAL(second, CommandHistory::s_Find(_MakeHandle(1)));
+
+        CommandHistory::s_Free(_MakeHandle(0));
+        VERIFY_IS_NULL(CommandHistory::s_Find(_MakeHandle(0)));
+
+        // Reattaching reuses the same history object.
+        VERIFY_ARE_EQUAL(first, CommandHistory::s_Allocate(_manyApps[0], _MakeHandle(2)));
+        VERIFY_ARE_EQUAL(first, CommandHistory::s_Find(_MakeHandle(2)));
+    }
+
 private:
     const std::array<std::wstring, 5> _manyApps = {
         L"foo.exe",
@@ -137,6 +137,37 @@ class InputBufferTests
         VERIFY_ARE_EQUAL(inputBuffer.GetNumberOfReadyEvents(), 3u);
     }
 
+    TEST_METHOD(InputBufferLimitsMouseEventCoalescing)
+    {
+        Log::Comment(L"The input buffer should store a new mouse event once the coalescing limit is reached");
+
+        InputBuffer inputBuffer;
+        inputBuffer.SetMouseMoveCoalescingLimit(4);
+
+        INPUT_RECORD mouseRecord;
+        mouseRecord.EventType = MOUSE_EVENT;
+        mouseRecord.Event.MouseEvent.dwEventFlags = MOUSE_MOVED;
+
+        // the first event is stored and the next 4 fold into it, so every 5 writes store one event.
+        for (size_t i = 0; i < 10; ++i)
+        {
+            mouseRecord.Event.MouseEvent.dwMousePosition.X = static_cast<SHORT>(i);
+            VERIFY_IS_GREATER_THAN(inputBuffer.Write(IInputEvent::Create(mouseRecord)), 0u);
+        }
+        VERIFY_ARE_EQUAL(inputBuffer.GetNumberOfReadyEvents(), 2u);
+        VERIFY_ARE_EQUAL(static_cast<const MouseEvent*>(inputBuffer._storage[0].get())->GetPosition().X, 4);
+        VERIFY_ARE_EQUAL(static_cast<const MouseEvent*>(inputBuffer._storage[1].get())->GetPosition().X, 9);
+
+        Log::Comment(L"A limit of 0 turns mouse move coalescing off");
+        inputBuffer.Flush();
+        inputBuffer.SetMouseMoveCoalescingLimit(0);
+        for (size_t i = 0; i < RECORD_INSERT_COUNT; ++i)
+        {
+            VERIFY_IS_GREATER_THAN(inputBuffer.Write(IInputEvent::Create(mouseRecord)), 0u);
+        }
+        VERIFY_ARE_EQUAL(inputBuffer.GetNumberOfReadyEvents(), RECORD_INSERT_COUNT);
+    }
+
     TEST_METHOD(InputBufferDoesNotCoalesceBulkMouseEvents)
     {
         Log::Comment(L"The input buffer should not coalesce mouse events if more than one event is sent at a time");
@@ -609,6 +640,27 @@ class InputBufferTests
         VERIFY_IS_FALSE(waitEvent);
     }
 
+    TEST_METHOD(BatchedWritesDeferWakingReaders)
+    {
+        InputBuffer inputBuffer;
+        INPUT_RECORD record = MakeKeyEvent(true, 1, L'a', 0, L'a', 0);
+
+        inputBuffer.BeginBatchedWrites();
+        VERIFY_IS_FALSE(inputBuffer._wakeUpPending);
+        VERIFY_ARE_EQUAL(inputBuffer.Write(IInputEvent::Create(record)), 1u);
+        VERIFY_ARE_EQUAL(inputBuffer.Write(IInputEvent::Create(record)), 1u);
+        VERIFY_IS_TRUE(inputBuffer._wakeUpPending);
+
+        inputBuffer.EndBatchedWrites();
+        VERIFY_IS_FALSE(inputBuffer._batchingWrites);
+        VERIFY_IS_FALSE(inputBuffer._wakeUpPending);
+        VERIFY_ARE_EQUAL(inputBuffer.GetNumberOfReadyEvents(), 1u);
+
+        // outside of a batch, writes wake readers up right away
+        VERIFY_ARE_EQUAL(inputBuffer.Write(IInputEvent::Create(record)), 1u);
+        VERIFY_IS_FALSE(inputBuffer._wakeUpPending);
+    }
+
     TEST_METHOD(StreamReadingDeCoalesces)
     {
         InputBuffer inputBuffer;
@@ -6,6 +6,7 @@
 #include "../../inc/consoletaeftemplates.hpp"
 
 #include "../buffer/out/outputCellIterator.hpp"
+#include "../buffer/out/TextCellIterator.hpp"
 
 using namespace WEX::Common;
 using namespace WEX::Logging;
@@ -511,4 +512,31 @@ class OutputCellIteratorTests
         VERIFY_ARE_EQUAL(cellsExpected, it.GetCellDistance(original));
         VERIFY_ARE_EQUAL(inputExpected, it.GetInputDistance(original));
     }
+
+    TEST_METHOD(TextCellIteratorMatchesStringDataWithColor)
+    {
+        SetVerifyOutput settings(VerifyOutputSettings::LogOnlyFailures);
+
+        // Narrow and wide glyphs, a surrogate pair and a lone surrogate.
+        const std::wstring testText(L"QW\x30a2\x30a3E\xD83D\xDE00R\xD800T");
+        const TextAttribute color(FOREGROUND_GREEN | FOREGROUND_INTENSITY);
+
+        OutputCellIterator expected(testText, color);
+        TextCellIterator it(testText, color);
+
+        const auto expectedOriginal = expected;
+        const auto original = it;
+
+        while (expected)
+        {
+            VERIFY_IS_TRUE(static_cast<bool>(it));
+            VERIFY_ARE_EQUAL(*expected, *it);
+            ++expected;
+            ++it;
+        }
+
+        VERIFY_IS_FALSE(static_cast<bool>(it));
+        VERIFY_ARE_EQUAL(expected.GetCellDistance(expectedOriginal), it.GetCellDistance(original));
+        VERIFY_ARE_EQUAL(expected.GetInputDistance(expectedOriginal), it.GetInputDistance(original));
+    }
 };
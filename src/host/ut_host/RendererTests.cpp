@@ -4,6 +4,7 @@
 #include "precomp.h"
 #include "WexTestClass.h"
 
+#include "../../inc/consoletaeftemplates.hpp"
 #include "CommonState.hpp"
 
 #include "../../host/renderData.hpp"
@@ -68,4 +69,36 @@ class RendererTests
     {
         m_renderer->TriggerTitleChange();
     }
+
+    TEST_METHOD(SelectionDeltaOnlyContainsChangedCells)
+    {
+        Log::Comment(L"An unchanged selection doesn't need to be redrawn at all.");
+        const std::vector<SMALL_RECT> selection{ { 2, 0, 10, 1 }, { 0, 1, 10, 2 } };
+        VERIFY_ARE_EQUAL(0u, Renderer::_GetSelectionDelta(selection, selection).size());
+
+        Log::Comment(L"Extending the selection only redraws the newly selected cells.");
+        const std::vector<SMALL_RECT> extended{ { 2, 0, 10, 1 }, { 0, 1, 10, 2 }, { 0, 2, 4, 3 } };
+        auto delta = Renderer::_GetSelectionDelta(selection, extended);
+        VERIFY_ARE_EQUAL(1u, delta.size());
+        VERIFY_ARE_EQUAL((SMALL_RECT{ 0, 2, 4, 3 }), delta.at(0));
+
+        Log::Comment(L"Moving the edges of a row only redraws the cells between the old and new edges.");
+        const std::vector<SMALL_RECT> moved{ { 3, 0, 10, 1 }, { 0, 1, 12, 2 } };
+        delta = Renderer::_GetSelectionDelta(selection, moved);
+        VERIFY_ARE_EQUAL(2u, delta.size());
+        VERIFY_ARE_EQUAL((SMALL_RECT{ 2, 0, 3, 1 }), delta.at(0));
+        VERIFY_ARE_EQUAL((SMALL_RECT{ 10, 1, 12, 2 }), delta.at(1));
+
+        Log::Comment(L"Rows whose old and new selection don't overlap are redrawn in full.");
+        const std::vector<SMALL_RECT> before{ { 0, 0, 2, 1 } };
+        const std::vector<SMALL_RECT> after{ { 5, 0, 8, 1 } };
+        delta = Renderer::_GetSelectionDelta(before, after);
+        VERIFY_ARE_EQUAL(2u, delta.size());
+        VERIFY_ARE_EQUAL(before.at(0), delta.at(0));
+        VERIFY_ARE_EQUAL(after.at(0), delta.at(1));
+
+        Log::Comment(L"Clearing the selection redraws all of it.");
+        delta = Renderer::_GetSelectionDelta(selection, {});
+        VERIFY_ARE_EQUAL(selection.size(), delta.size());
+    }
 };
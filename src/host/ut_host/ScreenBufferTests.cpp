@@ -91,6 +91,8 @@ class ScreenBufferTests
 
     TEST_METHOD(AlternateBufferCursorInheritanceTest);
 
+    TEST_METHOD(AlternateBufferIsRecycled);
+
     TEST_METHOD(TestReverseLineFeed);
 
     TEST_METHOD(TestResetClearTabStops);
@@ -346,6 +348,42 @@ void ScreenBufferTests::MultipleAlternateBuffersFromMainCreationTest()
     }
 }
 
+void ScreenBufferTests::AlternateBufferIsRecycled()
+{
+    auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+    gci.LockConsole(); // Lock must be taken to manipulate buffer.
+    auto unlock = wil::scope_exit([&] { gci.UnlockConsole(); });
+
+    auto& mainBuffer = gci.GetActiveOutputBuffer();
+    mainBuffer.GetTextBuffer().GetCursor().SetPosition({ 2, 3 });
+
+    Log::Comment(L"Switch to the alternate buffer, write to it and switch back.");
+    VERIFY_SUCCEEDED(mainBuffer.UseAlternateScreenBuffer());
+    auto& firstAltBuffer = gci.GetActiveOutputBuffer();
+    const auto firstAltTextBuffer = &firstAltBuffer.GetTextBuffer();
+    firstAltBuffer.GetStateMachine().ProcessString(L"\x1b[44mHello\r\n\x1b#6Wide");
+    firstAltBuffer.UseMainScreenBuffer();
+    VERIFY_ARE_EQUAL(&mainBuffer, &gci.GetActiveOutputBuffer());
+
+    Log::Comment(L"Switch to the alternate buffer again.");
+    VERIFY_SUCCEEDED(mainBuffer.UseAlternateScreenBuffer());
+    auto& secondAltBuffer = gci.GetActiveOutputBuffer();
+    auto useMain = wil::scope_exit([&] { secondAltBuffer.UseMainScreenBuffer(); });
+    const auto& textBuffer = secondAltBuffer.GetTextBuffer();
+
+    Log::Comment(L"Confirm the text buffer was recycled, but is as good as new.");
+    VERIFY_IS_TRUE(firstAltTextBuffer == &textBuffer);
+    VERIFY_ARE_EQUAL(mainBuffer.GetViewport().Dimensions(), textBuffer.GetSize().Dimensions());
+    VERIFY_ARE_EQUAL((COORD{ 2, 3 }), textBuffer.GetCursor().GetPosition());
+    for (SHORT y = 0; y < textBuffer.GetSize().Height(); y++)
+    {
+        const auto& row = textBuffer.GetRowByOffset(y);
+        VERIFY_IS_FALSE(row.GetCharRow().ContainsText());
+        VERIFY_ARE_EQUAL(static_cast<int>(LineRendition::SingleWidth), static_cast<int>(row.GetLineRendition()));
+        VERIFY_IS_TRUE(mainBuffer.GetAttributes().GetBackground() == row.GetAttrRow().GetAttrByColumn(0).GetBackground());
+    }
+}
+
 void ScreenBufferTests::AlternateBufferCursorInheritanceTest()
 {
     auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
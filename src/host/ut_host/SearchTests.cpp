@@ -156,4 +156,37 @@ class SearchTests
         Search s(gci.renderData, L"\x304b", Search::Direction::Backward, Search::Sensitivity::CaseInsensitive);
         DoFoundChecks(s, coordStartExpected, -1);
     }
+
+    TEST_METHOD(ForwardRegex)
+    {
+        auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+
+        const std::wregex regex{ L"C\x304d" };
+        Search s(gci.renderData, regex, Search::Direction::Forward);
+        for (SHORT row = 0; row < 4; ++row)
+        {
+            VERIFY_IS_TRUE(s.FindNext());
+            VERIFY_ARE_EQUAL((COORD{ 4, row }), s._coordSelStart);
+            VERIFY_ARE_EQUAL((COORD{ 6, row }), s._coordSelEnd);
+        }
+
+        Log::Comment(L"The search wraps around to the top of the buffer");
+        VERIFY_IS_TRUE(s.FindNext());
+        VERIFY_ARE_EQUAL((COORD{ 4, 0 }), s._coordSelStart);
+    }
+
+    TEST_METHOD(RegexMatchesAcrossWrappedRows)
+    {
+        auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+
+        // Only row 1 wraps into a filled row, so this is the only match.
+        const std::wregex regex{ L"E +A" };
+        Search s(gci.renderData, regex, Search::Direction::Backward);
+        VERIFY_IS_TRUE(s.FindNext());
+        VERIFY_ARE_EQUAL((COORD{ 8, 1 }), s._coordSelStart);
+        VERIFY_ARE_EQUAL((COORD{ 0, 2 }), s._coordSelEnd);
+
+        VERIFY_IS_TRUE(s.FindNext());
+        VERIFY_ARE_EQUAL((COORD{ 8, 1 }), s._coordSelStart);
+    }
 };
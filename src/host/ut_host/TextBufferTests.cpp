@@ -91,9 +91,24 @@ class TextBufferTests
 
     TEST_METHOD(TestBoundaryMeasuresFloatingString);
 
+    TEST_METHOD(TestMeasureRightFollowsWrites);
+    TEST_METHOD(TestResetRowReadsAsBlank);
+
     TEST_METHOD(TestCopyProperties);
 
     TEST_METHOD(TestInsertCharacter);
+    TEST_METHOD(TestWriteNarrowText);
+    TEST_METHOD(TestWriteCharInfos);
+    TEST_METHOD(TestFillNarrowTextAndAttributes);
+    TEST_METHOD(TestCopyCells);
+    TEST_METHOD(TestReadCharInfos);
+
+    TEST_METHOD(TestRowGeneration);
+
+    TEST_METHOD(TestPatternRequiredLiteral);
+
+    TEST_METHOD(TestGetTextColorRuns);
+    TEST_METHOD(TestGetTextBlockSelection);
 
     TEST_METHOD(TestIncrementCursor);
 
@@ -140,15 +155,20 @@ class TextBufferTests
 
     TEST_METHOD(ResizeTraditionalRotationPreservesHighUnicode);
     TEST_METHOD(ScrollBufferRotationPreservesHighUnicode);
+    TEST_METHOD(TestEraseRows);
+    TEST_METHOD(TestScrollRowsCircular);
 
     TEST_METHOD(ResizeTraditionalHighUnicodeRowRemoval);
     TEST_METHOD(ResizeTraditionalHighUnicodeColumnRemoval);
 
+    TEST_METHOD(MemoryUsage);
+
     TEST_METHOD(TestBurrito);
 
     void WriteLinesToBuffer(const std::vector<std::wstring>& text, TextBuffer& buffer);
     TEST_METHOD(GetWordBoundaries);
     TEST_METHOD(MoveByWord);
+    TEST_METHOD(ClassifyDelimiters);
     TEST_METHOD(GetGlyphBoundaries);
 
     TEST_METHOD(GetTextRects);
@@ -156,6 +176,7 @@ class TextBufferTests
 
     TEST_METHOD(HyperlinkTrim);
     TEST_METHOD(NoHyperlinkTrim);
+    TEST_METHOD(HyperlinkIdsAreRecycled);
 };
 
 void TextBufferTests::TestBufferCreate()
@@ -349,6 +370,78 @@ void TextBufferTests::TestBoundaryMeasuresFloatingString()
     DoBoundaryTest(pwszOffsets, 14, csBufferWidth, 5, 9);
 }
 
+void TextBufferTests::TestMeasureRightFollowsWrites()
+{
+    TextBuffer buffer({ 40, 2 }, TextAttribute{ 0x7 }, 12, _renderTarget);
+    auto& row = buffer.GetRowByOffset(0);
+
+    const auto verifyRight = [&](const size_t expected) {
+        VERIFY_ARE_EQUAL(expected, row.GetCharRow().MeasureRight());
+        // Handing out a mutable DbcsAttribute makes the row be measured from scratch.
+        row.GetCharRow().DbcsAttrAt(0);
+        VERIFY_ARE_EQUAL(expected, row.GetCharRow().MeasureRight());
+    };
+
+    verifyRight(0);
+
+    Log::Comment(L"Writes past the right edge move it.");
+    row.WriteNarrowText(L"hello", 0, TextAttribute{ 0x7 });
+    verifyRight(5);
+    row.WriteCells(OutputCellIterator{ L"\x6771" }, 20);
+    verifyRight(22);
+
+    Log::Comment(L"Clearing the end of the text moves the edge back to the text before it.");
+    row.ClearColumn(21);
+    row.ClearColumn(20);
+    verifyRight(5);
+    row.FillNarrowText(UNICODE_SPACE, 3, 10);
+    verifyRight(3);
+
+    Log::Comment(L"Changes left of the edge don't move it.");
+    row.WriteNarrowText(L"abc", 30, TextAttribute{ 0x7 });
+    row.FillNarrowText(UNICODE_SPACE, 0, 3);
+    row.GetCharRow().GlyphAt(10) = L"x";
+    verifyRight(33);
+
+    Log::Comment(L"Copies are writes, too.");
+    VERIFY_IS_TRUE(row.CopyCells(row, 30, 37, 3));
+    verifyRight(40);
+
+    row.Reset(TextAttribute{ 0x7 });
+    verifyRight(0);
+}
+
+void TextBufferTests::TestResetRowReadsAsBlank()
+{
+    TextBuffer buffer({ 10, 2 }, TextAttribute{ 0x7 }, 12, _renderTarget);
+    auto& row = buffer.GetRowByOffset(0);
+    auto& other = buffer.GetRowByOffset(1);
+    const auto blank = std::wstring(10, UNICODE_SPACE);
+
+    row.WriteNarrowText(L"0123456789", 0, TextAttribute{ 0x7 });
+    other.WriteNarrowText(L"abcdefghij", 0, TextAttribute{ 0x7 });
+
+    Log::Comment(L"A reset row must read as blank before it's written to.");
+    row.Reset(TextAttribute{ 0x7 });
+    VERIFY_ARE_EQUAL(blank, row.GetText());
+    VERIFY_ARE_EQUAL(L" ", static_cast<std::wstring_view>(std::as_const(row).GetCharRow().GlyphAt(3)));
+    VERIFY_IS_TRUE(std::as_const(row).GetCharRow().DbcsAttrAt(3).IsSingle());
+    VERIFY_IS_FALSE(row.GetCharRow().ContainsText());
+
+    Log::Comment(L"Writing to part of it mustn't bring the old text back.");
+    row.WriteNarrowText(L"x", 5, TextAttribute{ 0x7 });
+    VERIFY_ARE_EQUAL(L"     x    ", row.GetText());
+
+    Log::Comment(L"Copying out of a reset row copies spaces.");
+    row.Reset(TextAttribute{ 0x7 });
+    VERIFY_IS_TRUE(other.CopyCells(row, 2, 2, 3));
+    VERIFY_ARE_EQUAL(L"ab   fghij", other.GetText());
+
+    Log::Comment(L"A write covering the entire row doesn't need it to be cleared first.");
+    row.WriteNarrowText(L"ABCDEFGHIJ", 0, TextAttribute{ 0x7 });
+    VERIFY_ARE_EQUAL(L"ABCDEFGHIJ", row.GetText());
+}
+
 void TextBufferTests::TestCopyProperties()
 {
     TextBuffer& otherTbi = GetTbi();
@@ -430,6 +523,297 @@ void TextBufferTests::TestInsertCharacter()
     // the proper advancement of the cursor (e.g. which position it goes to) is validated in other tests
 }
 
+void TextBufferTests::TestWriteNarrowText()
+{
+    const COORD bufferSize{ 10, 3 };
+    TextBuffer buffer(bufferSize, TextAttribute{ 0x7 }, 12, _renderTarget);
+    const TextAttribute attr{ 0x1e };
+
+    Log::Comment(L"Writing stops at the first character that isn't printable ASCII");
+    buffer.GetRowByOffset(0).GetCharRow().DbcsAttrAt(2).SetLeading();
+    VERIFY_ARE_EQUAL(3u, buffer.WriteNarrowText(L"abc\x6771d", attr, { 1, 0 }));
+
+    const auto& row0 = buffer.GetRowByOffset(0);
+    VERIFY_ARE_EQUAL(L" abc", row0.GetText().substr(0, 4));
+    VERIFY_IS_TRUE(row0.GetCharRow().DbcsAttrAt(2).IsSingle());
+    VERIFY_ARE_EQUAL(TextAttribute{ 0x7 }, row0.GetAttrRow().GetAttrByColumn(0));
+    VERIFY_ARE_EQUAL(attr, row0.GetAttrRow().GetAttrByColumn(1));
+    VERIFY_ARE_EQUAL(attr, row0.GetAttrRow().GetAttrByColumn(3));
+    VERIFY_ARE_EQUAL(TextAttribute{ 0x7 }, row0.GetAttrRow().GetAttrByColumn(4));
+    VERIFY_IS_FALSE(row0.WasWrapForced());
+
+    Log::Comment(L"Writing stops at the end of the row and marks it as wrapped");
+    VERIFY_ARE_EQUAL(4u, buffer.WriteNarrowText(L"wxyz0123", attr, { 6, 1 }));
+    const auto& row1 = buffer.GetRowByOffset(1);
+    VERIFY_ARE_EQUAL(L"      wxyz", row1.GetText());
+    VERIFY_IS_TRUE(row1.WasWrapForced());
+    VERIFY_IS_FALSE(buffer.GetRowByOffset(2).GetCharRow().ContainsText());
+
+    Log::Comment(L"Nothing is written for control characters or out of bounds targets");
+    VERIFY_ARE_EQUAL(0u, buffer.WriteNarrowText(L"\r\n", attr, { 0, 2 }));
+    VERIFY_ARE_EQUAL(0u, buffer.WriteNarrowText(L"abc", attr, { 10, 2 }));
+    VERIFY_IS_FALSE(buffer.GetRowByOffset(2).GetCharRow().ContainsText());
+}
+
+void TextBufferTests::TestFillNarrowTextAndAttributes()
+{
+    const COORD bufferSize{ 6, 3 };
+    TextBuffer buffer(bufferSize, TextAttribute{ 0x7 }, 12, _renderTarget);
+    buffer.GetRowByOffset(0).SetWrapForced(true);
+    buffer.GetRowByOffset(1).GetCharRow().DbcsAttrAt(0).SetTrailing();
+
+    Log::Comment(L"Filling text continues onto the next rows, unwraps them and keeps their attributes");
+    VERIFY_ARE_EQUAL(8u, buffer.FillNarrowText(L'x', 8, { 2, 0 }, false));
+    const auto& row0 = buffer.GetRowByOffset(0);
+    const auto& row1 = buffer.GetRowByOffset(1);
+    VERIFY_ARE_EQUAL(L"  xxxx", row0.GetText());
+    VERIFY_ARE_EQUAL(L"xxxx  ", row1.GetText());
+    VERIFY_IS_FALSE(row0.WasWrapForced());
+    VERIFY_IS_TRUE(row1.GetCharRow().DbcsAttrAt(0).IsSingle());
+    VERIFY_ARE_EQUAL(TextAttribute{ 0x7 }, row1.GetAttrRow().GetAttrByColumn(0));
+
+    Log::Comment(L"Filling attributes keeps the text");
+    VERIFY_ARE_EQUAL(5u, buffer.FillAttributes(TextAttribute{ 0x1e }, 5, { 4, 0 }));
+    VERIFY_ARE_EQUAL(L"  xxxx", row0.GetText());
+    VERIFY_ARE_EQUAL(TextAttribute{ 0x7 }, row0.GetAttrRow().GetAttrByColumn(3));
+    VERIFY_ARE_EQUAL(TextAttribute{ 0x1e }, row0.GetAttrRow().GetAttrByColumn(4));
+    VERIFY_ARE_EQUAL(TextAttribute{ 0x1e }, row1.GetAttrRow().GetAttrByColumn(2));
+    VERIFY_ARE_EQUAL(TextAttribute{ 0x7 }, row1.GetAttrRow().GetAttrByColumn(3));
+
+    Log::Comment(L"Both stop at the end of the buffer");
+    VERIFY_ARE_EQUAL(4u, buffer.FillNarrowText(L' ', 100, { 2, 2 }, false));
+    VERIFY_ARE_EQUAL(6u, buffer.FillAttributes(TextAttribute{ 0x2f }, 100, { 0, 2 }));
+    VERIFY_ARE_EQUAL(0u, buffer.FillAttributes(TextAttribute{ 0x2f }, 100, { 0, 3 }));
+}
+
+void TextBufferTests::TestCopyCells()
+{
+    const COORD bufferSize{ 6, 2 };
+    TextBuffer buffer(bufferSize, TextAttribute{ 0x7 }, 12, _renderTarget);
+    auto& row0 = buffer.GetRowByOffset(0);
+    auto& row1 = buffer.GetRowByOffset(1);
+    row0.WriteCells(OutputCellIterator{ L"ab", TextAttribute{ 0x1e } }, 0);
+    row0.WriteCells(OutputCellIterator{ L"cd", TextAttribute{ 0x2f } }, 2);
+
+    Log::Comment(L"Copying within a row works like memmove, for the text and the attributes");
+    VERIFY_IS_TRUE(row0.CopyCells(row0, 0, 1, 4));
+    VERIFY_ARE_EQUAL(L"aabcd ", row0.GetText());
+    VERIFY_ARE_EQUAL(TextAttribute{ 0x1e }, row0.GetAttrRow().GetAttrByColumn(2));
+    VERIFY_ARE_EQUAL(TextAttribute{ 0x2f }, row0.GetAttrRow().GetAttrByColumn(3));
+    VERIFY_ARE_EQUAL(TextAttribute{ 0x2f }, row0.GetAttrRow().GetAttrByColumn(4));
+    VERIFY_ARE_EQUAL(TextAttribute{ 0x7 }, row0.GetAttrRow().GetAttrByColumn(5));
+    VERIFY_IS_TRUE(row0.CopyCells(row0, 2, 0, 3));
+    VERIFY_ARE_EQUAL(L"bcdcd ", row0.GetText());
+
+    Log::Comment(L"Copying into the end of another row marks it as wrapped, like writing the cells would");
+    VERIFY_IS_TRUE(row1.CopyCells(row0, 0, 3, 3));
+    VERIFY_ARE_EQUAL(L"   bcd", row1.GetText());
+    VERIFY_IS_TRUE(row1.WasWrapForced());
+
+    Log::Comment(L"Halves of wide glyphs that would need padding are left to the caller");
+    row0.WriteCells(OutputCellIterator{ L"\x6771", TextAttribute{ 0x7 } }, 0);
+    VERIFY_IS_TRUE(row0.GetCharRow().DbcsAttrAt(1).IsTrailing());
+    VERIFY_IS_FALSE(row1.CopyCells(row0, 1, 0, 2));
+    VERIFY_IS_FALSE(row1.CopyCells(row0, 0, 5, 1));
+    VERIFY_ARE_EQUAL(L"   bcd", row1.GetText());
+}
+
+void TextBufferTests::TestWriteCharInfos()
+{
+    const COORD bufferSize{ 6, 3 };
+    TextBuffer buffer(bufferSize, TextAttribute{ 0x7 }, 12, _renderTarget);
+
+    Log::Comment(L"Cells are written with their own attributes");
+    const CHAR_INFO cells[] = {
+        { L'a', 0x1e },
+        { L'b', 0x1e },
+        { L'c', 0x2f },
+        { L'\x6771', 0x2f | COMMON_LVB_LEADING_BYTE },
+        { L'\x6771', 0x2f | COMMON_LVB_TRAILING_BYTE },
+    };
+    buffer.WriteCharInfos(cells, { 1, 0 });
+
+    const auto& row0 = buffer.GetRowByOffset(0);
+    VERIFY_ARE_EQUAL(L" abc\x6771\x6771", row0.GetText());
+    VERIFY_ARE_EQUAL(TextAttribute{ 0x7 }, row0.GetAttrRow().GetAttrByColumn(0));
+    VERIFY_ARE_EQUAL(TextAttribute{ 0x1e }, row0.GetAttrRow().GetAttrByColumn(2));
+    VERIFY_ARE_EQUAL(TextAttribute{ 0x2f }, row0.GetAttrRow().GetAttrByColumn(3));
+    VERIFY_ARE_EQUAL(TextAttribute{ 0x2f }, row0.GetAttrRow().GetAttrByColumn(5));
+    VERIFY_IS_TRUE(row0.GetCharRow().DbcsAttrAt(4).IsLeading());
+    VERIFY_IS_TRUE(row0.GetCharRow().DbcsAttrAt(5).IsTrailing());
+
+    Log::Comment(L"A leading byte in the last column is padded and continues on the next row");
+    buffer.WriteCharInfos(gsl::make_span(cells).subspan(3), { 5, 1 });
+    const auto& row1 = buffer.GetRowByOffset(1);
+    VERIFY_IS_TRUE(row1.WasDoubleBytePadded());
+    VERIFY_IS_TRUE(row1.GetCharRow().DbcsAttrAt(5).IsSingle());
+    const auto& row2 = buffer.GetRowByOffset(2);
+    VERIFY_IS_TRUE(row2.GetCharRow().DbcsAttrAt(0).IsLeading());
+    VERIFY_IS_TRUE(row2.GetCharRow().DbcsAttrAt(1).IsTrailing());
+}
+
+void TextBufferTests::TestReadCharInfos()
+{
+    const COORD bufferSize{ 6, 1 };
+    TextBuffer buffer(bufferSize, TextAttribute{ 0x7 }, 12, _renderTarget);
+
+    const CHAR_INFO cells[] = {
+        { L'a', 0x1e },
+        { L'b', 0x2f },
+        { L'\x6771', 0x2f | COMMON_LVB_LEADING_BYTE },
+        { L'\x6771', 0x2f | COMMON_LVB_TRAILING_BYTE },
+    };
+    buffer.WriteCharInfos(cells, { 1, 0 });
+
+    Log::Comment(L"Cells read back the same as they were written");
+    std::array<CHAR_INFO, 4> read{};
+    VERIFY_ARE_EQUAL(4u, buffer.GetRowByOffset(0).ReadCharInfos(1, read));
+    for (size_t i = 0; i < read.size(); ++i)
+    {
+        VERIFY_ARE_EQUAL(cells[i].Char.UnicodeChar, read[i].Char.UnicodeChar);
+        VERIFY_ARE_EQUAL(cells[i].Attributes, read[i].Attributes);
+    }
+
+    Log::Comment(L"Reading stops at the end of the row");
+    std::array<CHAR_INFO, 4> tail{};
+    VERIFY_ARE_EQUAL(2u, buffer.GetRowByOffset(0).ReadCharInfos(4, tail));
+    VERIFY_ARE_EQUAL(cells[3].Attributes, tail[1].Attributes);
+    VERIFY_ARE_EQUAL(0, tail[2].Attributes);
+}
+
+void TextBufferTests::TestRowGeneration()
+{
+    const COORD bufferSize{ 10, 3 };
+    TextBuffer buffer(bufferSize, TextAttribute{ 0x7 }, 12, _renderTarget);
+    const auto& constBuffer = buffer;
+
+    const auto generation0 = constBuffer.GetRowByOffset(0).GetGeneration();
+    const auto generation1 = constBuffer.GetRowByOffset(1).GetGeneration();
+    VERIFY_ARE_NOT_EQUAL(0u, generation0);
+    VERIFY_ARE_NOT_EQUAL(generation0, generation1);
+
+    Log::Comment(L"Reading a row keeps its generation");
+    VERIFY_ARE_EQUAL(std::wstring(10, L' '), constBuffer.GetRowByOffset(0).GetText());
+    VERIFY_ARE_EQUAL(generation0, constBuffer.GetRowByOffset(0).GetGeneration());
+
+    Log::Comment(L"Writing to a row gives it a new generation, leaving the others alone");
+    buffer.WriteNarrowText(L"abc", TextAttribute{ 0x1e }, { 0, 0 });
+    const auto written = constBuffer.GetRowByOffset(0).GetGeneration();
+    VERIFY_ARE_NOT_EQUAL(generation0, written);
+    VERIFY_ARE_EQUAL(generation1, constBuffer.GetRowByOffset(1).GetGeneration());
+
+    Log::Comment(L"Changing the line rendition gives it a new generation too");
+    buffer.GetRowByOffset(0).SetLineRendition(LineRendition::DoubleWidth);
+    VERIFY_ARE_NOT_EQUAL(written, constBuffer.GetRowByOffset(0).GetGeneration());
+
+    Log::Comment(L"Rows keep their generation when the buffer circles");
+    const auto generation2 = constBuffer.GetRowByOffset(2).GetGeneration();
+    buffer.IncrementCircularBuffer();
+    VERIFY_ARE_EQUAL(generation1, constBuffer.GetRowByOffset(0).GetGeneration());
+    VERIFY_ARE_EQUAL(generation2, constBuffer.GetRowByOffset(1).GetGeneration());
+}
+
+void TextBufferTests::TestPatternRequiredLiteral()
+{
+    const COORD bufferSize{ 20, 2 };
+    TextBuffer buffer(bufferSize, TextAttribute{ 0x7 }, 12, _renderTarget);
+
+    // The literal is deliberately not something the regex needs, so that we
+    // can tell whether the regex ran at all.
+    const auto id = buffer.AddPatternRecognizer(LR"(ab+c)", L"!");
+    buffer.WriteNarrowText(L"xx abbc", TextAttribute{ 0x7 }, { 0, 0 });
+
+    Log::Comment(L"Without the literal, the regex isn't run");
+    VERIFY_IS_TRUE(buffer.GetPatterns(0, 1).empty());
+
+    Log::Comment(L"With the literal anywhere in the text, matches are found as before");
+    buffer.WriteNarrowText(L"!", TextAttribute{ 0x7 }, { 5, 1 });
+    const auto tree = buffer.GetPatterns(0, 1);
+    const auto results = tree.findOverlapping(til::point{ 0, 0 }, til::point{ 19, 1 });
+    VERIFY_ARE_EQUAL(1u, results.size());
+    VERIFY_ARE_EQUAL(id, results[0].value);
+    VERIFY_ARE_EQUAL(til::point(3, 0), results[0].start);
+    VERIFY_ARE_EQUAL(til::point(7, 0), results[0].stop);
+}
+
+void TextBufferTests::TestGetTextColorRuns()
+{
+    const COORD bufferSize{ 8, 2 };
+    TextBuffer buffer(bufferSize, TextAttribute{ 0x7 }, 12, _renderTarget);
+
+    buffer.WriteNarrowText(L"aab", TextAttribute{ 0x1e }, { 0, 0 });
+    buffer.WriteNarrowText(L"cd", TextAttribute{ 0x2f }, { 3, 0 });
+    buffer.WriteNarrowText(L"e", TextAttribute{ 0x1e }, { 0, 1 });
+
+    size_t colorLookups = 0;
+    const auto getColors = [&](const TextAttribute& attr) {
+        ++colorLookups;
+        const auto legacy = attr.GetLegacyAttributes();
+        return std::pair<COLORREF, COLORREF>{ RGB(legacy & 0xf, 0, 0), RGB((legacy >> 4) & 0xf, 0, 0) };
+    };
+
+    const std::vector<SMALL_RECT> selection{ { 0, 0, 7, 0 }, { 0, 1, 7, 1 } };
+    const auto data = buffer.GetText(true, true, selection, getColors);
+
+    Log::Comment(L"Colors are looked up once per attribute run, including the trimmed spaces, not per character");
+    VERIFY_ARE_EQUAL(5u, colorLookups);
+
+    VERIFY_ARE_EQUAL(L"aabcd\r\n", data.text.at(0));
+    VERIFY_ARE_EQUAL(L"e", data.text.at(1));
+
+    Log::Comment(L"Runs cover the trimmed text and the CRLF");
+    const auto& row0 = data.ColorRuns.at(0);
+    VERIFY_ARE_EQUAL(3u, row0.size());
+    VERIFY_ARE_EQUAL(3u, row0.at(0).length);
+    VERIFY_ARE_EQUAL(RGB(0xe, 0, 0), row0.at(0).fg);
+    VERIFY_ARE_EQUAL(RGB(0x1, 0, 0), row0.at(0).bk);
+    VERIFY_ARE_EQUAL(2u, row0.at(1).length);
+    VERIFY_ARE_EQUAL(RGB(0xf, 0, 0), row0.at(1).fg);
+    VERIFY_ARE_EQUAL(2u, row0.at(2).length);
+    VERIFY_ARE_EQUAL(RGB(0, 0, 0), row0.at(2).fg);
+
+    const auto& row1 = data.ColorRuns.at(1);
+    VERIFY_ARE_EQUAL(1u, row1.size());
+    VERIFY_ARE_EQUAL(1u, row1.at(0).length);
+
+    Log::Comment(L"The HTML has one span per color change");
+    const auto html = TextBuffer::GenHTML(data, 12, L"Consolas", RGB(0, 0, 0));
+    VERIFY_IS_TRUE(html.find("aab</SPAN><SPAN STYLE=\"color:#0F0000;background-color:#020000;\">cd<BR></SPAN>") != std::string::npos);
+    VERIFY_IS_TRUE(html.find(">e</SPAN></DIV>") != std::string::npos);
+}
+
+void TextBufferTests::TestGetTextBlockSelection()
+{
+    const COORD bufferSize{ 8, 2 };
+    TextBuffer buffer(bufferSize, TextAttribute{ 0x7 }, 12, _renderTarget);
+
+    // The wide glyph takes up columns 2 and 3.
+    buffer.GetRowByOffset(0).WriteCells(OutputCellIterator{ L"ab\x3042" L"cd", TextAttribute{ 0x7 } }, 0);
+    buffer.GetRowByOffset(1).WriteCells(OutputCellIterator{ L"efghijkl", TextAttribute{ 0x7 } }, 0);
+
+    Log::Comment(L"A block selection starting on the trailing half of a wide glyph includes all of it");
+    const auto rects = buffer.GetTextRects({ 3, 0 }, { 4, 1 }, true, true);
+    VERIFY_ARE_EQUAL(2u, rects.size());
+    VERIFY_ARE_EQUAL(2, rects.at(0).Left);
+    VERIFY_ARE_EQUAL(4, rects.at(0).Right);
+    VERIFY_ARE_EQUAL(3, rects.at(1).Left);
+    VERIFY_ARE_EQUAL(4, rects.at(1).Right);
+
+    const auto data = buffer.GetText(true, false, rects);
+    VERIFY_ARE_EQUAL(L"\x3042" L"c\r\n", data.text.at(0));
+    VERIFY_ARE_EQUAL(L"hi", data.text.at(1));
+
+    Log::Comment(L"The trailing half of a wide glyph at the left edge of a slice is skipped, like the glyph iterator does");
+    const auto trailing = buffer.GetText(false, false, { { 3, 0, 5, 0 } });
+    VERIFY_ARE_EQUAL(L"cd", trailing.text.at(0));
+
+    Log::Comment(L"The text is the same with and without colors");
+    const auto colored = buffer.GetText(true, false, rects, [](const TextAttribute&) {
+        return std::pair<COLORREF, COLORREF>{ RGB(0, 0, 0), RGB(0, 0, 0) };
+    });
+    VERIFY_ARE_EQUAL(data.text, colored.text);
+}
+
 void TextBufferTests::TestIncrementCursor()
 {
     TextBuffer& textBuffer = GetTbi();
@@ -1863,6 +2247,72 @@ void TextBufferTests::ResizeTraditionalRotationPreservesHighUnicode()
     VERIFY_ARE_EQUAL(String(bButton), String(shouldBeEmojiText.data(), gsl::narrow<int>(shouldBeEmojiText.size())));
 }
 
+void TextBufferTests::TestEraseRows()
+{
+    const COORD bufferSize{ 10, 4 };
+    const UINT cursorSize = 12;
+    const TextAttribute attr{ 0x7f };
+    auto _buffer = std::make_unique<TextBuffer>(bufferSize, attr, cursorSize, _renderTarget);
+
+    for (SHORT y = 0; y < bufferSize.Y; y++)
+    {
+        _buffer->Write(OutputCellIterator{ L"0123456789" }, { 0, y });
+        _buffer->GetRowByOffset(y).SetWrapForced(true);
+    }
+    _buffer->GetRowByOffset(1).SetLineRendition(LineRendition::DoubleWidth);
+
+    const TextAttribute eraseAttr{ 0x1e };
+    _buffer->EraseRows(1, 3, eraseAttr);
+
+    for (SHORT y = 0; y < bufferSize.Y; y++)
+    {
+        const auto& row = _buffer->GetRowByOffset(y);
+        const auto erased = y == 1 || y == 2;
+        Log::Comment(NoThrowString().Format(L"Row %d", y));
+        VERIFY_ARE_EQUAL(std::wstring{ erased ? L"          " : L"0123456789" }, row.GetText());
+        VERIFY_ARE_EQUAL(erased ? eraseAttr : attr, row.GetAttrRow().GetAttrByColumn(9));
+        VERIFY_ARE_EQUAL(!erased, row.WasWrapForced());
+    }
+
+    Log::Comment(L"Erasing must not change the line rendition.");
+    VERIFY_IS_TRUE(_buffer->IsDoubleWidthLine(1));
+}
+
+void TextBufferTests::TestScrollRowsCircular()
+{
+    const COORD bufferSize{ 4, 6 };
+    const UINT cursorSize = 12;
+    const TextAttribute attr{ 0x7f };
+    auto _buffer = std::make_unique<TextBuffer>(bufferSize, attr, cursorSize, _renderTarget);
+
+    // Start the circular buffer in the middle of the storage, like it will be after scrolling.
+    _buffer->_SetFirstRowIndex(4);
+    for (SHORT y = 0; y < bufferSize.Y; y++)
+    {
+        _buffer->Write(OutputCellIterator{ std::wstring(4, gsl::narrow_cast<wchar_t>(L'A' + y)) }, { 0, y });
+    }
+
+    const auto verifyRows = [&](const std::wstring_view expected) {
+        for (SHORT y = 0; y < bufferSize.Y; y++)
+        {
+            VERIFY_ARE_EQUAL(std::wstring(4, expected.at(y)), _buffer->GetRowByOffset(y).GetText());
+        }
+        for (size_t i = 0; i < _buffer->_storage.size(); i++)
+        {
+            VERIFY_ARE_EQUAL(gsl::narrow_cast<SHORT>(i), _buffer->_storage.at(i).GetId());
+        }
+    };
+
+    Log::Comment(L"Scrolling rows that are stored contiguously rotates them in place.");
+    _buffer->ScrollRows(3, 2, 1);
+    verifyRows(L"ABCFDE");
+    VERIFY_ARE_EQUAL(4, static_cast<int>(_buffer->GetFirstRowIndex()));
+
+    Log::Comment(L"Scrolling rows that wrap around the end of the storage still works.");
+    _buffer->ScrollRows(1, 3, -1);
+    verifyRows(L"BCFADE");
+}
+
 // This tests that when buffer storage rows are rotated around during a scroll buffer operation,
 // that the Unicode Storage-held high unicode items like emoji rotate properly with it.
 void TextBufferTests::ScrollBufferRotationPreservesHighUnicode()
@@ -1928,14 +2378,17 @@ void TextBufferTests::ResizeTraditionalHighUnicodeRowRemoval()
     const auto readBackText = *readBack;
     VERIFY_ARE_EQUAL(String(emoji), String(readBackText.data(), gsl::narrow<int>(readBackText.size())));
 
-    VERIFY_ARE_EQUAL(1u, _buffer->GetUnicodeStorage()._map.size(), L"There should be one item in the map.");
+    VERIFY_ARE_EQUAL(1u, _buffer->_storage[pos.Y].GetUnicodeStorage()._entries.size(), L"There should be one item in the row's storage.");
 
     // Perform resize to trim off the row of the buffer that included the emoji
     COORD trimmedBufferSize{ bufferSize.X, bufferSize.Y - 1 };
 
     VERIFY_NT_SUCCESS(_buffer->ResizeTraditional(trimmedBufferSize));
 
-    VERIFY_IS_TRUE(_buffer->GetUnicodeStorage()._map.empty(), L"The map should now be empty.");
+    for (const auto& row : _buffer->_storage)
+    {
+        VERIFY_IS_TRUE(row.GetUnicodeStorage()._entries.empty(), L"The storage of every remaining row should be empty.");
+    }
 }
 
 // This tests that columns removed from the buffer while resizing traditionally will also drop the high unicode
@@ -1963,14 +2416,45 @@ void TextBufferTests::ResizeTraditionalHighUnicodeColumnRemoval()
     const auto readBackText = *readBack;
     VERIFY_ARE_EQUAL(String(emoji), String(readBackText.data(), gsl::narrow<int>(readBackText.size())));
 
-    VERIFY_ARE_EQUAL(1u, _buffer->GetUnicodeStorage()._map.size(), L"There should be one item in the map.");
+    VERIFY_ARE_EQUAL(1u, _buffer->_storage[pos.Y].GetUnicodeStorage()._entries.size(), L"There should be one item in the row's storage.");
 
     // Perform resize to trim off the column of the buffer that included the emoji
     COORD trimmedBufferSize{ bufferSize.X - 1, bufferSize.Y };
 
     VERIFY_NT_SUCCESS(_buffer->ResizeTraditional(trimmedBufferSize));
 
-    VERIFY_IS_TRUE(_buffer->GetUnicodeStorage()._map.empty(), L"The map should now be empty.");
+    VERIFY_IS_TRUE(_buffer->_storage[pos.Y].GetUnicodeStorage()._entries.empty(), L"The row's storage should now be empty.");
+}
+
+void TextBufferTests::MemoryUsage()
+{
+    const COORD bufferSize{ 80, 10 };
+    const UINT cursorSize = 12;
+    const TextAttribute attr{ 0x7f };
+    auto _buffer = std::make_unique<TextBuffer>(bufferSize, attr, cursorSize, _renderTarget);
+
+    const auto before = _buffer->GetMemoryUsage();
+    VERIFY_ARE_EQUAL(80u * 10u * (sizeof(wchar_t) + sizeof(DbcsAttribute)), before.text);
+    VERIFY_IS_GREATER_THAN_OR_EQUAL(before.rows, 10u * sizeof(ROW));
+    VERIFY_ARE_EQUAL(0u, before.unicodeStorage);
+    VERIFY_ARE_EQUAL(0u, before.hyperlinks);
+
+    Log::Comment(L"Glyphs that don't fit into a wchar_t are accounted for as unicode storage.");
+    auto position = _buffer->_storage[0].GetCharRow().GlyphAt(0);
+    position = L"\xD83C\xDF46";
+    VERIFY_IS_GREATER_THAN(_buffer->GetMemoryUsage().unicodeStorage, 0u);
+
+    Log::Comment(L"Attribute runs that differ from the row's fill are accounted for as attributes.");
+    const auto attributesBefore = _buffer->GetMemoryUsage().attributes;
+    for (uint16_t i = 0; i < 40; ++i)
+    {
+        _buffer->GetRowByOffset(1).GetAttrRow().Replace(i, gsl::narrow_cast<uint16_t>(i + 1), TextAttribute{ gsl::narrow_cast<WORD>(i % 2 ? 0x1f : 0x2f) });
+    }
+    VERIFY_IS_GREATER_THAN(_buffer->GetMemoryUsage().attributes, attributesBefore);
+
+    Log::Comment(L"Hyperlinks are accounted for.");
+    _buffer->AddHyperlinkToMap(L"https://example.com/a/fairly/long/uri/that/isnt/stored/inline", 1);
+    VERIFY_IS_GREATER_THAN(_buffer->GetMemoryUsage().hyperlinks, 0u);
 }
 
 void TextBufferTests::TestBurrito()
@@ -2207,6 +2691,32 @@ void TextBufferTests::MoveByWord()
     }
 }
 
+void TextBufferTests::ClassifyDelimiters()
+{
+    // "\u2502" (box drawing vertical) is a delimiter outside of the ASCII range,
+    // which the classifier can't keep in its lookup table.
+    const std::wstring_view wordDelimiters{ L" /\\()\"'-:,.;<>~!@#$%^&*|+=[]{}~?\u2502" };
+    const DelimiterClassifier classifier{ wordDelimiters };
+
+    VERIFY_IS_TRUE(DelimiterClass::ControlChar == classifier.Classify(L'\0'));
+    VERIFY_IS_TRUE(DelimiterClass::ControlChar == classifier.Classify(L'\t'));
+    VERIFY_IS_TRUE(DelimiterClass::ControlChar == classifier.Classify(L' '));
+
+    VERIFY_IS_TRUE(DelimiterClass::DelimiterChar == classifier.Classify(L'/'));
+    VERIFY_IS_TRUE(DelimiterClass::DelimiterChar == classifier.Classify(L'?'));
+    VERIFY_IS_TRUE(DelimiterClass::DelimiterChar == classifier.Classify(L'\u2502'));
+
+    VERIFY_IS_TRUE(DelimiterClass::RegularChar == classifier.Classify(L'a'));
+    VERIFY_IS_TRUE(DelimiterClass::RegularChar == classifier.Classify(L'_'));
+    VERIFY_IS_TRUE(DelimiterClass::RegularChar == classifier.Classify(L'\x7f'));
+    VERIFY_IS_TRUE(DelimiterClass::RegularChar == classifier.Classify(L'\u00e9'));
+
+    // Without any non-ASCII delimiters, non-ASCII characters are always regular.
+    const DelimiterClassifier asciiOnly{ L" /" };
+    VERIFY_IS_TRUE(DelimiterClass::DelimiterChar == asciiOnly.Classify(L'/'));
+    VERIFY_IS_TRUE(DelimiterClass::RegularChar == asciiOnly.Classify(L'\u2502'));
+}
+
 void TextBufferTests::GetGlyphBoundaries()
 {
     struct ExpectedResult
@@ -2653,3 +3163,41 @@ void TextBufferTests::NoHyperlinkTrim()
     VERIFY_ARE_EQUAL(_buffer->GetHyperlinkUriFromId(id), url);
     VERIFY_ARE_EQUAL(_buffer->_hyperlinkCustomIdMap[finalCustomId], id);
 }
+
+// This tests that the hyperlink map doesn't grow without bound when every line
+// gets its own link, whether the lines scroll away or are overwritten in place
+void TextBufferTests::HyperlinkIdsAreRecycled()
+{
+    const COORD bufferSize{ 80, 10 };
+    const UINT cursorSize = 12;
+    const TextAttribute attr{ 0x7f };
+    auto _buffer = std::make_unique<TextBuffer>(bufferSize, attr, cursorSize, _renderTarget);
+
+    const auto addLink = [&](const SHORT row, const std::wstring& url) {
+        const auto id = _buffer->GetHyperlinkId(url, {});
+        TextAttribute newAttr{ 0x7f };
+        newAttr.SetHyperlinkId(id);
+        _buffer->GetRowByOffset(row).GetAttrRow().SetAttrToEnd(0, newAttr);
+        _buffer->AddHyperlinkToMap(url, id);
+        return id;
+    };
+
+    Log::Comment(L"Links that scroll away must free their IDs for the next ones.");
+    for (auto i = 0; i < 70000; ++i)
+    {
+        addLink(bufferSize.Y - 1, fmt::format(L"file.{}", i));
+        _buffer->IncrementCircularBuffer();
+    }
+    VERIFY_IS_LESS_THAN_OR_EQUAL(_buffer->_hyperlinkMap.size(), static_cast<size_t>(bufferSize.Y));
+    VERIFY_IS_LESS_THAN_OR_EQUAL(static_cast<size_t>(_buffer->_currentHyperlinkId), static_cast<size_t>(bufferSize.Y + 1));
+
+    Log::Comment(L"Links that are overwritten in place must be swept up eventually.");
+    uint16_t id = 0;
+    for (auto i = 0; i < 5000; ++i)
+    {
+        id = addLink(0, fmt::format(L"line.{}", i));
+    }
+    VERIFY_IS_LESS_THAN_OR_EQUAL(_buffer->_hyperlinkMap.size(), TextBuffer::MinimumHyperlinkSweep);
+    VERIFY_IS_LESS_THAN_OR_EQUAL(static_cast<size_t>(_buffer->_currentHyperlinkId), TextBuffer::MinimumHyperlinkSweep + bufferSize.Y + 1);
+    VERIFY_ARE_EQUAL(L"line.4999", _buffer->GetHyperlinkUriFromId(id));
+}
@@ -32,20 +32,20 @@ class Utf16ParserTests
             wstr.push_back(charData.at(0));
         }
 
-        const std::vector<std::vector<wchar_t>> result = Utf16Parser::Parse(wstr);
+        const std::vector<std::wstring_view> result = Utf16Parser::Parse(wstr);
 
         VERIFY_ARE_EQUAL(expected.size(), result.size());
         for (size_t i = 0; i < result.size(); ++i)
         {
-            const auto& sequence = result.at(i);
-            VERIFY_ARE_EQUAL(sequence, expected.at(i));
+            const auto sequence = result.at(i);
+            VERIFY_ARE_EQUAL(std::wstring_view(expected.at(i).data(), expected.at(i).size()), sequence);
         }
     }
 
     TEST_METHOD(CanParseSurrogatePairs)
     {
         const std::wstring wstr{ SunglassesEmoji.begin(), SunglassesEmoji.end() };
-        const std::vector<std::vector<wchar_t>> result = Utf16Parser::Parse(wstr);
+        const std::vector<std::wstring_view> result = Utf16Parser::Parse(wstr);
 
         VERIFY_ARE_EQUAL(result.size(), 1u);
         VERIFY_ARE_EQUAL(result.at(0).size(), SunglassesEmoji.size());
@@ -62,7 +62,7 @@ class Utf16ParserTests
         wstr += wstr;
         wstr.at(1) = SunglassesEmoji.at(0); // wstr contains 3 leading, 1 trailing surrogate sequence
 
-        std::vector<std::vector<wchar_t>> result = Utf16Parser::Parse(wstr);
+        std::vector<std::wstring_view> result = Utf16Parser::Parse(wstr);
 
         VERIFY_ARE_EQUAL(result.size(), 1u);
         VERIFY_ARE_EQUAL(result.at(0).size(), SunglassesEmoji.size());
@@ -84,6 +84,14 @@ class Utf16ParserTests
         {
             VERIFY_ARE_EQUAL(result.at(0).at(i), SunglassesEmoji.at(i));
         }
+
+        // test dropping of a leading surrogate that isn't directly followed by its trailing one
+        wstr = { SunglassesEmoji.at(0), LatinChar.at(0), SunglassesEmoji.at(1) };
+
+        result = Utf16Parser::Parse(wstr);
+
+        VERIFY_ARE_EQUAL(result.size(), 1u);
+        VERIFY_ARE_EQUAL(std::wstring_view(LatinChar.data(), LatinChar.size()), result.at(0));
     }
 
     const std::wstring_view Replacement{ &UNICODE_REPLACEMENT, 1 };
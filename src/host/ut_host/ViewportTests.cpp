@@ -729,6 +729,42 @@ class ViewportTests
         }
     }
 
+    TEST_METHOD(MoveInBoundsBackwards)
+    {
+        SMALL_RECT edges;
+        edges.Left = 10;
+        edges.Right = 19;
+        edges.Top = 20;
+        edges.Bottom = 29;
+
+        const auto v = Viewport::FromInclusive(edges);
+
+        Log::Comment(L"Move back within the same row.");
+        COORD pos{ 15, 24 };
+        VERIFY_IS_TRUE(v.MoveInBounds(-3, pos));
+        VERIFY_ARE_EQUAL(COORD({ 12, 24 }), pos);
+
+        Log::Comment(L"Move back across a row boundary.");
+        VERIFY_IS_TRUE(v.MoveInBounds(-3, pos));
+        VERIFY_ARE_EQUAL(COORD({ 19, 23 }), pos);
+
+        Log::Comment(L"Move back to the very first position.");
+        VERIFY_IS_TRUE(v.MoveInBounds(-39, pos));
+        VERIFY_ARE_EQUAL(COORD({ 10, 20 }), pos);
+
+        Log::Comment(L"Moving before the first position fails and leaves the position alone.");
+        VERIFY_IS_FALSE(v.MoveInBounds(-1, pos));
+        VERIFY_ARE_EQUAL(COORD({ 10, 20 }), pos);
+
+        Log::Comment(L"Move forward to the very last position.");
+        VERIFY_IS_TRUE(v.MoveInBounds(99, pos));
+        VERIFY_ARE_EQUAL(COORD({ 19, 29 }), pos);
+
+        Log::Comment(L"Moving past the last position fails and leaves the position alone.");
+        VERIFY_IS_FALSE(v.MoveInBounds(1, pos));
+        VERIFY_ARE_EQUAL(COORD({ 19, 29 }), pos);
+    }
+
     TEST_METHOD(CompareInBounds)
     {
         SMALL_RECT edges;
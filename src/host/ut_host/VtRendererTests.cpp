@@ -83,6 +83,16 @@ class Microsoft::Console::Render::VtRendererTest
 
     TEST_METHOD(TestCursorVisibility);
 
+    TEST_METHOD(TestPassthrough);
+
+    TEST_METHOD(TestMergeGraphicsRendition);
+
+    TEST_METHOD(TestResizeQuirkSkipsReflowInvalidation);
+
+    TEST_METHOD(TestSkipFramesWhileTerminalIsBehind);
+
+    TEST_METHOD(TestShadowFrameSkipsUnchangedCells);
+
     void Test16Colors(VtEngine* engine);
 
     std::deque<std::string> qExpectedInput;
@@ -1611,3 +1621,195 @@ void VtRendererTest::FormattedString()
     qExpectedInput.push_back("\x1b[28;3;500;500;500m");
     VERIFY_SUCCEEDED(engine->_WriteFormatted(bigFormat, bigValue, bigValue, bigValue));
 }
+
+void VtRendererTest::TestPassthrough()
+{
+    Viewport view = SetUpViewport();
+    wil::unique_hfile hFile = wil::unique_hfile(INVALID_HANDLE_VALUE);
+    auto engine = std::make_unique<Xterm256Engine>(std::move(hFile), view);
+    auto pfn = std::bind(&VtRendererTest::WriteCallback, this, std::placeholders::_1, std::placeholders::_2);
+    engine->SetTestCallback(pfn);
+
+    // Verify the first paint emits a clear
+    qExpectedInput.push_back("\x1b[2J");
+    VERIFY_IS_TRUE(engine->_firstPaint);
+    TestPaint(*engine, [&]() {
+        VERIFY_IS_FALSE(engine->_firstPaint);
+    });
+
+    Log::Comment(L"The client's output is written to the terminal as-is.");
+    qExpectedInput.push_back("\x1b[31mhello");
+    VERIFY_SUCCEEDED(engine->BeginPassthrough(L"\x1b[31mhello"));
+
+    Log::Comment(L"Strings the state machine passes through while parsing it aren't written again.");
+    VERIFY_SUCCEEDED(engine->WriteTerminalW(L"\x1b]4;1;rgb:ff/00/00\x1b\\"));
+
+    Log::Comment(L"Circling doesn't start a frame, because the terminal circles by itself.");
+    bool forcePaint = true;
+    VERIFY_SUCCEEDED(engine->InvalidateCircling(&forcePaint));
+    VERIFY_IS_FALSE(forcePaint);
+
+    const SMALL_RECT invalid = { 0, 0, 4, 0 };
+    VERIFY_SUCCEEDED(engine->Invalidate(&invalid));
+    VERIFY_IS_FALSE(engine->_invalidMap.none());
+
+    Log::Comment(L"Once it's been parsed, nothing it invalidated is left to paint.");
+    const TextAttribute attributes{ FOREGROUND_RED };
+    VERIFY_SUCCEEDED(engine->EndPassthrough({ 5, 0 }, false, attributes));
+    VERIFY_IS_TRUE(engine->_invalidMap.none());
+    VERIFY_IS_FALSE(engine->_circled);
+    VERIFY_ARE_EQUAL((COORD{ 5, 0 }), engine->_lastText);
+    VERIFY_IS_TRUE(attributes == engine->_lastTextAttributes);
+
+    Log::Comment(L"The terminal's cursor is unknown while it's waiting to wrap.");
+    qExpectedInput.push_back("x");
+    VERIFY_SUCCEEDED(engine->BeginPassthrough(L"x"));
+    VERIFY_SUCCEEDED(engine->EndPassthrough({ 79, 0 }, true, attributes));
+    VERIFY_ARE_EQUAL(VtEngine::INVALID_COORDS, engine->_lastText);
+
+    VerifyExpectedInputsDrained();
+}
+
+void VtRendererTest::TestMergeGraphicsRendition()
+{
+    // Without a test callback the output stays in the engine's buffer,
+    // which is where sequences get merged.
+    wil::unique_hfile hFile = wil::unique_hfile(INVALID_HANDLE_VALUE);
+    auto engine = std::make_unique<Xterm256Engine>(std::move(hFile), SetUpViewport());
+
+    Log::Comment(L"Consecutive SGR sequences are combined into one.");
+    VERIFY_SUCCEEDED(engine->_SetGraphicsRenditionRGBColor(RGB(1, 2, 3), true));
+    VERIFY_SUCCEEDED(engine->_SetGraphicsRenditionRGBColor(RGB(4, 5, 6), false));
+    VERIFY_SUCCEEDED(engine->_SetBold(true));
+    VERIFY_ARE_EQUAL(std::string{ "\x1b[38;2;1;2;3;48;2;4;5;6;1m" }, engine->_buffer);
+
+    Log::Comment(L"Anything in between starts a new one.");
+    VERIFY_SUCCEEDED(engine->_Write("a"));
+    VERIFY_SUCCEEDED(engine->_SetBold(false));
+    VERIFY_ARE_EQUAL(std::string{ "\x1b[38;2;1;2;3;48;2;4;5;6;1ma\x1b[22m" }, engine->_buffer);
+
+    Log::Comment(L"An empty parameter list is spelled out as 0 once merged.");
+    engine->_buffer.clear();
+    engine->_lastGraphicsRenditionEnd = std::string::npos;
+    VERIFY_SUCCEEDED(engine->_SetGraphicsDefault());
+    VERIFY_SUCCEEDED(engine->_SetBold(true));
+    VERIFY_SUCCEEDED(engine->_SetGraphicsDefault());
+    VERIFY_ARE_EQUAL(std::string{ "\x1b[0;1;0m" }, engine->_buffer);
+}
+
+void VtRendererTest::TestResizeQuirkSkipsReflowInvalidation()
+{
+    wil::unique_hfile hFile = wil::unique_hfile(INVALID_HANDLE_VALUE);
+    auto engine = std::make_unique<Xterm256Engine>(std::move(hFile), SetUpViewport());
+    const SMALL_RECT invalid = { 0, 0, 4, 1 };
+
+    Log::Comment(L"Without the quirk, whatever the reflow rewrites is repainted.");
+    engine->BeginResizeRequest();
+    VERIFY_SUCCEEDED(engine->Invalidate(&invalid));
+    engine->EndResizeRequest();
+    VERIFY_IS_FALSE(engine->_invalidMap.none());
+    engine->_invalidMap.reset_all();
+
+    Log::Comment(L"With the quirk, the terminal reflows by itself and nothing is repainted.");
+    engine->SetResizeQuirk(true);
+    engine->BeginResizeRequest();
+    VERIFY_SUCCEEDED(engine->Invalidate(&invalid));
+    engine->EndResizeRequest();
+    VERIFY_IS_TRUE(engine->_invalidMap.none());
+
+    Log::Comment(L"Changes after the resize are painted as usual.");
+    VERIFY_SUCCEEDED(engine->Invalidate(&invalid));
+    VERIFY_IS_FALSE(engine->_invalidMap.none());
+}
+
+void VtRendererTest::TestSkipFramesWhileTerminalIsBehind()
+{
+    wil::unique_hfile hFile = wil::unique_hfile(INVALID_HANDLE_VALUE);
+    auto engine = std::make_unique<Xterm256Engine>(std::move(hFile), SetUpViewport());
+    const SMALL_RECT invalid = { 0, 0, 4, 1 };
+    VERIFY_SUCCEEDED(engine->Invalidate(&invalid));
+
+    Log::Comment(L"A frame is still waiting to be written, so this one is held back.");
+    engine->_pendingBuffer = "\x1b[H";
+    VERIFY_ARE_EQUAL(S_FALSE, engine->StartPaint());
+    VERIFY_IS_TRUE(engine->RequiresContinuousRedraw());
+    VERIFY_IS_FALSE(engine->_invalidMap.none());
+
+    Log::Comment(L"Frames that are needed right away are painted regardless.");
+    engine->ForceNextFrame();
+    VERIFY_ARE_EQUAL(S_OK, engine->StartPaint());
+    VERIFY_IS_FALSE(engine->RequiresContinuousRedraw());
+    VERIFY_SUCCEEDED(engine->EndPaint());
+
+    Log::Comment(L"Once the terminal caught up, frames are painted as usual.");
+    engine->_pendingBuffer.clear();
+    VERIFY_SUCCEEDED(engine->Invalidate(&invalid));
+    VERIFY_ARE_EQUAL(S_OK, engine->StartPaint());
+    VERIFY_IS_FALSE(engine->RequiresContinuousRedraw());
+    VERIFY_SUCCEEDED(engine->EndPaint());
+}
+
+void VtRendererTest::TestShadowFrameSkipsUnchangedCells()
+{
+    wil::unique_hfile hFile = wil::unique_hfile(INVALID_HANDLE_VALUE);
+    auto engine = std::make_unique<Xterm256Engine>(std::move(hFile), SetUpViewport());
+    auto pfn = std::bind(&VtRendererTest::WriteCallback, this, std::placeholders::_1, std::placeholders::_2);
+    engine->SetTestCallback(pfn);
+
+    qExpectedInput.push_back("\x1b[2J");
+    TestPaint(*engine, [&]() {});
+
+    const auto makeClusters = [](const std::wstring_view line) {
+        std::vector<Cluster> clusters;
+        for (size_t i = 0; i < line.size(); i++)
+        {
+            clusters.emplace_back(line.substr(i, 1), 1);
+        }
+        return clusters;
+    };
+
+    const std::wstring first{ L"progress: 10%" };
+    const auto firstClusters = makeClusters(first);
+    TestPaint(*engine, [&]() {
+        Log::Comment(L"Text the terminal hasn't seen yet is painted as usual.");
+        qExpectedInput.push_back("\x1b[2;1H");
+        qExpectedInput.push_back("progress: 10%");
+        VERIFY_SUCCEEDED(engine->PaintBufferLine({ firstClusters.data(), firstClusters.size() }, { 0, 1 }, false, false));
+    });
+
+    TestPaint(*engine, [&]() {
+        Log::Comment(L"Painting the same text again doesn't send anything.");
+        qExpectedInput.push_back(EMPTY_CALLBACK_SENTINEL);
+        VERIFY_SUCCEEDED(engine->PaintBufferLine({ firstClusters.data(), firstClusters.size() }, { 0, 1 }, false, false));
+        WriteCallback(EMPTY_CALLBACK_SENTINEL, 1);
+    });
+
+    const std::wstring second{ L"progress: 20%" };
+    const auto secondClusters = makeClusters(second);
+    TestPaint(*engine, [&]() {
+        Log::Comment(L"Only the cells that changed are sent.");
+        qExpectedInput.push_back("\x1b[2;11H");
+        qExpectedInput.push_back("2");
+        VERIFY_SUCCEEDED(engine->PaintBufferLine({ secondClusters.data(), secondClusters.size() }, { 0, 1 }, false, false));
+    });
+
+    TestPaint(*engine, [&]() {
+        Log::Comment(L"The same text with different attributes has to be sent again.");
+        engine->_lastTextAttributes.SetIndexedForeground(TextColor::DARK_RED);
+        qExpectedInput.push_back("\r");
+        qExpectedInput.push_back("progress: 20%");
+        VERIFY_SUCCEEDED(engine->PaintBufferLine({ secondClusters.data(), secondClusters.size() }, { 0, 1 }, false, false));
+    });
+
+    Log::Comment(L"Strings passed through to the terminal make us forget everything.");
+    qExpectedInput.push_back("\x1b[?1049h");
+    VERIFY_SUCCEEDED(engine->WriteTerminalW(L"\x1b[?1049h"));
+    TestPaint(*engine, [&]() {
+        qExpectedInput.push_back("\r");
+        qExpectedInput.push_back("progress: 20%");
+        VERIFY_SUCCEEDED(engine->PaintBufferLine({ secondClusters.data(), secondClusters.size() }, { 0, 1 }, false, false));
+    });
+
+    VerifyExpectedInputsDrained();
+}
+
@@ -25,7 +25,8 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
                 _values(values),
                 _rc(rc),
                 _pos(pos),
-                _end(rc.size().area())
+                _end(rc.size().area()),
+                _all(values.all())
             {
                 _calculateArea();
             }
@@ -80,6 +81,9 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
             ptrdiff_t _pos;
             ptrdiff_t _nextPos;
             const ptrdiff_t _end;
+            // all() is computed a word at a time, so checking it once up front spares
+            // a fully invalidated bitmap from walking each of its rows bit by bit.
+            const bool _all;
             til::rectangle _run;
 
             // Update _run to contain the next rectangle of consecutively set bits within this bitmap.
@@ -110,13 +114,22 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
                     // Find the length for the rectangle.
                     ptrdiff_t runLength = 0;
 
-                    // We have at least 1 so start with a do/while.
-                    do
+                    if (_all)
                     {
-                        ++_nextPos;
-                        ++runLength;
-                    } while (_nextPos < rowEndIndex && _values[_nextPos]);
-                    // Keep going until we reach end of row, end of the buffer, or the next bit is off.
+                        // Every bit is set, so the run is the rest of this row.
+                        runLength = rowEndIndex - _nextPos;
+                        _nextPos = rowEndIndex;
+                    }
+                    else
+                    {
+                        // We have at least 1 so start with a do/while.
+                        do
+                        {
+                            ++_nextPos;
+                            ++runLength;
+                        } while (_nextPos < rowEndIndex && _values.test(_nextPos));
+                        // Keep going until we reach end of row, end of the buffer, or the next bit is off.
+                    }
 
                     // Assemble and store that run.
                     _run = til::rectangle{ runStart, til::size{ runLength, static_cast<ptrdiff_t>(1) } };
@@ -367,6 +380,46 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
                 }
             }
 
+            void reset(const til::point pt)
+            {
+                THROW_HR_IF(E_INVALIDARG, !_rc.contains(pt));
+                _runs.reset(); // reset cached runs on any non-const method
+
+                _bits.reset(_rc.index_of(pt));
+            }
+
+            void reset(const til::rectangle rc)
+            {
+                THROW_HR_IF(E_INVALIDARG, !_rc.contains(rc));
+                _runs.reset(); // reset cached runs on any non-const method
+
+                for (auto row = rc.top(); row < rc.bottom(); ++row)
+                {
+                    _bits.reset(_rc.index_of(til::point{ rc.left(), row }), rc.width());
+                }
+            }
+
+            // Merges the set bits of another bitmap of the same size into this one.
+            // Both bitmaps share the same layout, so this is a plain OR of their words.
+            bitmap& operator|=(const bitmap& other)
+            {
+                THROW_HR_IF(E_INVALIDARG, _sz != other._sz);
+                _runs.reset(); // reset cached runs on any non-const method
+
+                _bits |= other._bits;
+                return *this;
+            }
+
+            // Keeps only the bits that are also set in another bitmap of the same size.
+            bitmap& operator&=(const bitmap& other)
+            {
+                THROW_HR_IF(E_INVALIDARG, _sz != other._sz);
+                _runs.reset(); // reset cached runs on any non-const method
+
+                _bits &= other._bits;
+                return *this;
+            }
+
             void set_all() noexcept
             {
                 _runs.reset(); // reset cached runs on any non-const method
@@ -0,0 +1,108 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include "spsc.h"
+#include "ticket_lock.h"
+
+// til: Terminal Implementation Library. Also: "Today I Learned".
+// mpsc: Multi Producer Single Consumer. A MPSC queue/channel sends data from any number of senders to one receiver.
+//
+// The channel is built on top of til::spsc: producers take turns writing into the spsc ring buffer
+// by holding a fair ticket_lock for the duration of a single emplace/push/push_n call.
+// The benefits of that are:
+// * The consumer side stays exactly as lock-free as the spsc one and blocks the same way.
+// * A batch written by push()/push_n() is never interleaved with the items of another producer.
+// * Once the last producer is gone the consumer is notified just like with spsc.
+namespace til::mpsc
+{
+    using size_type = til::spsc::size_type;
+
+    // Block until at least one item has been written into the sender / read from the receiver.
+    using til::spsc::block_initially;
+
+    // Block until all items have been written into the sender / read from the receiver.
+    using til::spsc::block_forever;
+
+    namespace details
+    {
+        template<typename T>
+        struct shared_producer
+        {
+            explicit shared_producer(til::spsc::producer<T>&& producer) noexcept :
+                producer(std::move(producer)) {}
+
+            til::ticket_lock lock;
+            til::spsc::producer<T> producer;
+        };
+    }
+
+    // Unlike til::spsc::producer this producer is copyable.
+    // All copies write into the same channel and the consumer is only
+    // told that the producers are gone once the last copy has been destroyed.
+    template<typename T>
+    struct producer
+    {
+        explicit producer(std::shared_ptr<details::shared_producer<T>> shared) noexcept :
+            _shared(std::move(shared)) {}
+
+        // emplace constructs an item in-place at the end of the queue.
+        // It returns true, if the item was successfully placed within the queue.
+        // The return value will be false, if the consumer is gone.
+        template<typename... Args>
+        bool emplace(Args&&... args) const
+        {
+            const std::scoped_lock lock{ _shared->lock };
+            return _shared->producer.emplace(std::forward<Args>(args)...);
+        }
+
+        template<typename InputIt>
+        std::pair<size_t, bool> push(InputIt first, InputIt last) const
+        {
+            return push_n(block_forever, first, std::distance(first, last));
+        }
+
+        // push writes the items between first and last into the queue.
+        // The amount of successfully written items is returned as the first pair field.
+        // The second pair field will be false if the consumer is gone.
+        template<typename WaitPolicy, typename InputIt, til::spsc::details::enable_if_wait_policy_t<WaitPolicy> = 0>
+        std::pair<size_t, bool> push(WaitPolicy&& policy, InputIt first, InputIt last) const
+        {
+            return push_n(std::forward<WaitPolicy>(policy), first, std::distance(first, last));
+        }
+
+        template<typename InputIt>
+        std::pair<size_t, bool> push_n(InputIt first, size_t count) const
+        {
+            return push_n(block_forever, first, count);
+        }
+
+        // push_n writes count items from first into the queue.
+        // The amount of successfully written items is returned as the first pair field.
+        // The second pair field will be false if the consumer is gone.
+        template<typename WaitPolicy, typename InputIt, til::spsc::details::enable_if_wait_policy_t<WaitPolicy> = 0>
+        std::pair<size_t, bool> push_n(WaitPolicy&& policy, InputIt first, size_t count) const
+        {
+            const std::scoped_lock lock{ _shared->lock };
+            return _shared->producer.push_n(std::forward<WaitPolicy>(policy), first, count);
+        }
+
+    private:
+        std::shared_ptr<details::shared_producer<T>> _shared;
+    };
+
+    // There's only ever one consumer, so it's identical to the spsc one.
+    template<typename T>
+    using consumer = til::spsc::consumer<T>;
+
+    // channel returns a bounded, multi-producer, single-consumer
+    // FIFO queue ("channel") with the given maximum capacity.
+    template<typename T>
+    std::pair<producer<T>, consumer<T>> channel(uint32_t capacity)
+    {
+        auto [tx, rx] = til::spsc::channel<T>(capacity);
+        auto shared = std::make_shared<details::shared_producer<T>>(std::move(tx));
+        return { producer<T>{ std::move(shared) }, std::move(rx) };
+    }
+}
@@ -70,4 +70,54 @@ namespace til::pmr
         return std::pmr::get_default_resource();
     }
 #endif
+
+    // A memory_resource that passes all requests on to its upstream resource
+    // and keeps count of how much memory is currently allocated through it.
+    // Put one underneath the pool of a subsystem to find out how much memory
+    // that subsystem is holding on to. The counters may be read from any thread.
+    class counting_resource final : public std::pmr::memory_resource
+    {
+    public:
+        explicit counting_resource(std::pmr::memory_resource* upstream = get_default_resource()) noexcept :
+            _upstream{ upstream }
+        {
+        }
+
+        // The number of bytes that are currently allocated.
+        [[nodiscard]] size_t bytes() const noexcept
+        {
+            return _bytes.load(std::memory_order_relaxed);
+        }
+
+        // The number of allocations that haven't been deallocated yet.
+        [[nodiscard]] size_t allocations() const noexcept
+        {
+            return _allocations.load(std::memory_order_relaxed);
+        }
+
+    private:
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+
+        void* do_allocate(const size_t bytes, const size_t align) override
+        {
+            const auto ptr = _upstream->allocate(bytes, align);
+            _bytes.fetch_add(bytes, std::memory_order_relaxed);
+            _allocations.fetch_add(1, std::memory_order_relaxed);
+            return ptr;
+        }
+
+        void do_deallocate(void* const ptr, const size_t bytes, const size_t align) noexcept override
+        {
+            _upstream->deallocate(ptr, bytes, align);
+            _bytes.fetch_sub(bytes, std::memory_order_relaxed);
+            _allocations.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        std::pmr::memory_resource* _upstream;
+        std::atomic<size_t> _bytes{ 0 };
+        std::atomic<size_t> _allocations{ 0 };
+    };
 }
@@ -79,6 +79,17 @@ namespace til
         private:
             std::atomic<bool> _isPending;
         };
+
+        // Returns the msWindowLength for SetThreadpoolTimerEx, which is how
+        // much later than `delay` the threadpool may run the timer callback.
+        // A window allows the OS to batch the expiry of the timers of all throttled
+        // functions (for instance those of every pane) into a single wakeup.
+        // An eighth of the delay keeps the added latency small for short delays.
+        inline DWORD throttled_func_window(std::chrono::duration<int64_t, std::ratio<1, 10000000>> delay) noexcept
+        {
+            const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(delay).count() / 8;
+            return static_cast<DWORD>(std::clamp<int64_t>(ms, 0, MAXDWORD));
+        }
     } // namespace details
 
     template<bool leading, typename... Args>
@@ -99,7 +110,8 @@ namespace til
         // After `func` was invoked the state is reset and this cycle is repeated again.
         throttled_func(filetime_duration delay, function func) :
             _func{ std::move(func) },
-            _timer{ _createTimer() }
+            _timer{ _createTimer() },
+            _window{ details::throttled_func_window(delay) }
         {
             const auto d = -delay.count();
             if (d >= 0)
@@ -172,7 +184,7 @@ namespace til
                 _func();
             }
 
-            SetThreadpoolTimerEx(_timer.get(), &_delay, 0, 0);
+            SetThreadpoolTimerEx(_timer.get(), &_delay, 0, _window);
         }
 
         void _trailing_edge()
@@ -197,6 +209,7 @@ namespace til
         FILETIME _delay;
         function _func;
         wil::unique_threadpool_timer _timer;
+        DWORD _window;
         details::throttled_func_storage<Args...> _storage;
     };
 
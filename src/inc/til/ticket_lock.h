@@ -53,4 +53,80 @@ namespace til
         std::atomic<uint32_t> _next_ticket{ 0 };
         std::atomic<uint32_t> _now_serving{ 0 };
     };
+
+    // shared_ticket_lock is a ticket_lock that additionally allows any number of
+    // readers to hold it at the same time, while staying just as fair:
+    // Readers and writers draw tickets from the same queue and are served in order.
+    // A reader that's being served passes the turn on immediately, so a run of consecutive
+    // readers all get in together. A writer waits its turn and then for all readers to leave.
+    //
+    // The same caveats as for ticket_lock apply. Use std::unique_lock and std::shared_lock.
+    struct shared_ticket_lock
+    {
+        void lock() noexcept
+        {
+            _wait_for_turn();
+
+            for (;;)
+            {
+                const auto readers = _readers.load(std::memory_order_acquire);
+                if (readers == 0)
+                {
+                    break;
+                }
+
+                til::atomic_wait(_readers, readers);
+            }
+        }
+
+        void unlock() noexcept
+        {
+            _pass_turn();
+        }
+
+        void lock_shared() noexcept
+        {
+            _wait_for_turn();
+
+            // The reader count must be raised before passing the turn on, so that
+            // a writer that's served right after us is guaranteed to see it.
+            _readers.fetch_add(1, std::memory_order_relaxed);
+            _pass_turn();
+        }
+
+        void unlock_shared() noexcept
+        {
+            if (_readers.fetch_sub(1, std::memory_order_release) == 1)
+            {
+                til::atomic_notify_all(_readers);
+            }
+        }
+
+    private:
+        void _wait_for_turn() noexcept
+        {
+            const auto ticket = _next_ticket.fetch_add(1, std::memory_order_relaxed);
+
+            for (;;)
+            {
+                const auto current = _now_serving.load(std::memory_order_acquire);
+                if (current == ticket)
+                {
+                    break;
+                }
+
+                til::atomic_wait(_now_serving, current);
+            }
+        }
+
+        void _pass_turn() noexcept
+        {
+            _now_serving.fetch_add(1, std::memory_order_release);
+            til::atomic_notify_all(_now_serving);
+        }
+
+        std::atomic<uint32_t> _next_ticket{ 0 };
+        std::atomic<uint32_t> _now_serving{ 0 };
+        std::atomic<uint32_t> _readers{ 0 };
+    };
 }
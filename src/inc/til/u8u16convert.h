@@ -13,7 +13,9 @@ Tests have been made in order to investigate whether or not own algorithms
 could overcome disadvantages of syscalls. Test results can be read up
 in PR #4093 and the test algorithms are available in src\tools\U8U16Test.
 Based on the results the decision was made to keep using the platform
-functions MultiByteToWideChar and WideCharToMultiByte.
+functions MultiByteToWideChar and WideCharToMultiByte. Only leading runs of
+ASCII characters, which make up most of the text and all of the VT sequences
+in a terminal's output, are converted without calling them.
 
 Author(s):
 - Steffen Illhardt (german-one), Leonard Hecker (lhecker) 2020-2021
@@ -47,6 +49,76 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
         }
     };
 
+    namespace details
+    {
+#pragma warning(push)
+#pragma warning(disable : 26429 26481) // use not_null, pointer arithmetic
+        // Routine Description:
+        // - Widens the leading run of ASCII characters of a UTF-8 string to UTF-16.
+        // Arguments:
+        // - in - UTF-8 string
+        // - len - length of in
+        // - out - buffer for at least len UTF-16 code units
+        // Return Value:
+        // - the number of leading ASCII characters that have been written to out
+        inline size_t u8u16ascii(const char* in, const size_t len, wchar_t* out) noexcept
+        {
+            size_t i = 0;
+            // Test 8 code units at once for a set high bit.
+            for (; i + 8 <= len; i += 8)
+            {
+                uint64_t chunk;
+                memcpy(&chunk, in + i, sizeof(chunk));
+                if (chunk & 0x8080808080808080)
+                {
+                    break;
+                }
+                for (size_t j = 0; j < 8; ++j)
+                {
+                    out[i + j] = static_cast<wchar_t>(in[i + j]);
+                }
+            }
+            for (; i < len && static_cast<uint8_t>(in[i]) < 0x80; ++i)
+            {
+                out[i] = static_cast<wchar_t>(in[i]);
+            }
+            return i;
+        }
+
+        // Routine Description:
+        // - Narrows the leading run of ASCII characters of a UTF-16 string to UTF-8.
+        // Arguments:
+        // - in - UTF-16 string
+        // - len - length of in
+        // - out - buffer for at least len UTF-8 code units
+        // Return Value:
+        // - the number of leading ASCII characters that have been written to out
+        inline size_t u16u8ascii(const wchar_t* in, const size_t len, char* out) noexcept
+        {
+            size_t i = 0;
+            // Test 4 code units at once for any bit above the lowest 7.
+            for (; i + 4 <= len; i += 4)
+            {
+                uint64_t chunk;
+                memcpy(&chunk, in + i, sizeof(chunk));
+                if (chunk & 0xFF80FF80FF80FF80)
+                {
+                    break;
+                }
+                for (size_t j = 0; j < 4; ++j)
+                {
+                    out[i + j] = static_cast<char>(in[i + j]);
+                }
+            }
+            for (; i < len && in[i] < 0x80; ++i)
+            {
+                out[i] = static_cast<char>(in[i]);
+            }
+            return i;
+        }
+#pragma warning(pop)
+    }
+
     // Routine Description:
     // - Takes a UTF-8 string and performs the conversion to UTF-16. NOTE: The function relies on getting complete UTF-8 characters at the string boundaries.
     // Arguments:
@@ -70,8 +142,11 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
             // The worst ratio of UTF-8 code units to UTF-16 code units is 1 to 1 if UTF-8 consists of ASCII only.
             RETURN_HR_IF(E_ABORT, !base::MakeCheckedNum(in.length()).AssignIfValid(&lengthRequired));
             out.resize(in.length()); // avoid to call MultiByteToWideChar twice only to get the required size
-            const int lengthOut = MultiByteToWideChar(CP_UTF8, 0ul, in.data(), lengthRequired, out.data(), lengthRequired);
-            out.resize(gsl::narrow_cast<size_t>(lengthOut));
+            const auto ascii{ gsl::narrow_cast<int>(details::u8u16ascii(in.data(), in.length(), out.data())) };
+            RETURN_HR_IF(S_OK, ascii == lengthRequired);
+
+            const int lengthOut = MultiByteToWideChar(CP_UTF8, 0ul, in.data() + ascii, lengthRequired - ascii, out.data() + ascii, lengthRequired - ascii);
+            out.resize(gsl::narrow_cast<size_t>(ascii) + gsl::narrow_cast<size_t>(lengthOut));
 
             return lengthOut == 0 ? E_UNEXPECTED : S_OK;
         }
@@ -156,6 +231,15 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
                 }
             }
 
+            if (len8)
+            {
+                const auto ascii{ gsl::narrow_cast<int>(details::u8u16ascii(cursor8, gsl::narrow_cast<size_t>(len8), out.data() + len16)) };
+                len16 += ascii;
+                capa16 -= ascii;
+                len8 -= ascii;
+                cursor8 += ascii;
+            }
+
             if (len8)
             {
                 const auto convLen{ MultiByteToWideChar(CP_UTF8, 0UL, cursor8, len8, out.data() + len16, capa16) };
@@ -197,8 +281,15 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
             // Thus, the worst ratio of UTF-16 code units to UTF-8 code units is 1 to 3.
             RETURN_HR_IF(E_ABORT, !base::MakeCheckedNum(in.length()).AssignIfValid(&lengthIn) || !base::CheckMul(lengthIn, 3).AssignIfValid(&lengthRequired));
             out.resize(gsl::narrow_cast<size_t>(lengthRequired)); // avoid to call WideCharToMultiByte twice only to get the required size
-            const int lengthOut = WideCharToMultiByte(CP_UTF8, 0ul, in.data(), lengthIn, out.data(), lengthRequired, nullptr, nullptr);
-            out.resize(gsl::narrow_cast<size_t>(lengthOut));
+            const auto ascii{ gsl::narrow_cast<int>(details::u16u8ascii(in.data(), in.length(), out.data())) };
+            if (ascii == lengthIn)
+            {
+                out.resize(in.length());
+                return S_OK;
+            }
+
+            const int lengthOut = WideCharToMultiByte(CP_UTF8, 0ul, in.data() + ascii, lengthIn - ascii, out.data() + ascii, lengthRequired - ascii, nullptr, nullptr);
+            out.resize(gsl::narrow_cast<size_t>(ascii) + gsl::narrow_cast<size_t>(lengthOut));
 
             return lengthOut == 0 ? E_UNEXPECTED : S_OK;
         }
@@ -257,6 +348,15 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
                 }
             }
 
+            if (len16)
+            {
+                const auto ascii{ gsl::narrow_cast<int>(details::u16u8ascii(cursor16, gsl::narrow_cast<size_t>(len16), out.data() + len8)) };
+                len8 += ascii;
+                capa8 -= ascii;
+                len16 -= ascii;
+                cursor16 += ascii;
+            }
+
             if (len16)
             {
                 const auto convLen{ WideCharToMultiByte(CP_UTF8, 0UL, cursor16, len16, out.data() + len8, capa8, nullptr, nullptr) };
@@ -25,41 +25,82 @@ BgfxEngine::BgfxEngine(PVOID SharedViewBase, LONG DisplayHeight, LONG DisplayWid
     _sharedViewBase((ULONG_PTR)SharedViewBase),
     _displayHeight(DisplayHeight),
     _displayWidth(DisplayWidth),
+    _dirtyRows(gsl::narrow_cast<size_t>(std::max(DisplayHeight, 0L)), true),
     _currentLegacyColorAttribute(DEFAULT_COLOR_ATTRIBUTE)
 {
     _runLength = sizeof(CD_IO_CHARACTER) * DisplayWidth;
 
+    // At most every other row can start a new dirty range,
+    // so GetDirtyArea never has to allocate while painting.
+    _dirtyAreas.reserve(_dirtyRows.size() / 2 + 1);
+
     _fontSize.X = FontWidth > SHORT_MAX ? SHORT_MAX : (SHORT)FontWidth;
     _fontSize.Y = FontHeight > SHORT_MAX ? SHORT_MAX : (SHORT)FontHeight;
 }
 
-[[nodiscard]] HRESULT BgfxEngine::Invalidate(const SMALL_RECT* const /*psrRegion*/) noexcept
+// Routine Description:
+// - Marks the rows in the given range as dirty. ConIoSrv is sent whole rows,
+//   so a row is the smallest unit we track.
+// Arguments:
+// - top - the first row to invalidate
+// - bottom - the row after the last one to invalidate
+// Return Value:
+// - <none>
+void BgfxEngine::_InvalidateRows(const LONG top, const LONG bottom) noexcept
 {
-    return S_OK;
+    const auto begin = std::clamp<LONG>(top, 0, _displayHeight);
+    const auto end = std::clamp<LONG>(bottom, 0, _displayHeight);
+    for (auto row = begin; row < end; ++row)
+    {
+        _dirtyRows[row] = true;
+    }
 }
 
-[[nodiscard]] HRESULT BgfxEngine::InvalidateCursor(const SMALL_RECT* const /*psrRegion*/) noexcept
+[[nodiscard]] HRESULT BgfxEngine::Invalidate(const SMALL_RECT* const psrRegion) noexcept
 {
+    RETURN_HR_IF_NULL(E_INVALIDARG, psrRegion);
+    _InvalidateRows(psrRegion->Top, psrRegion->Bottom);
     return S_OK;
 }
 
+[[nodiscard]] HRESULT BgfxEngine::InvalidateCursor(const SMALL_RECT* const psrRegion) noexcept
+{
+    return Invalidate(psrRegion);
+}
+
 [[nodiscard]] HRESULT BgfxEngine::InvalidateSystem(const RECT* const /*prcDirtyClient*/) noexcept
 {
-    return S_OK;
+    return InvalidateAll();
 }
 
-[[nodiscard]] HRESULT BgfxEngine::InvalidateSelection(const std::vector<SMALL_RECT>& /*rectangles*/) noexcept
+[[nodiscard]] HRESULT BgfxEngine::InvalidateSelection(const std::vector<SMALL_RECT>& rectangles) noexcept
 {
+    for (const auto& rect : rectangles)
+    {
+        RETURN_IF_FAILED(Invalidate(&rect));
+    }
     return S_OK;
 }
 
-[[nodiscard]] HRESULT BgfxEngine::InvalidateScroll(const COORD* const /*pcoordDelta*/) noexcept
+// Routine Description:
+// - BGFX can't move the contents of the display, so a scroll repaints everything.
+// Arguments:
+// - pcoordDelta - The number of characters the contents moved by.
+// Return Value:
+// - S_OK
+[[nodiscard]] HRESULT BgfxEngine::InvalidateScroll(const COORD* const pcoordDelta) noexcept
 {
+    RETURN_HR_IF_NULL(E_INVALIDARG, pcoordDelta);
+    if (pcoordDelta->X != 0 || pcoordDelta->Y != 0)
+    {
+        RETURN_IF_FAILED(InvalidateAll());
+    }
     return S_OK;
 }
 
 [[nodiscard]] HRESULT BgfxEngine::InvalidateAll() noexcept
 {
+    _InvalidateRows(0, _displayHeight);
     return S_OK;
 }
 
@@ -75,27 +116,68 @@ BgfxEngine::BgfxEngine(PVOID SharedViewBase, LONG DisplayHeight, LONG DisplayWid
     return S_FALSE;
 }
 
+// Routine Description:
+// - Prepares to paint a frame. Skips the frame when no row was invalidated.
+// Arguments:
+// - <none>
+// Return Value:
+// - S_OK if there's something to paint, S_FALSE otherwise.
 [[nodiscard]] HRESULT BgfxEngine::StartPaint() noexcept
 {
-    return S_OK;
+    const auto anyDirty = std::find(_dirtyRows.cbegin(), _dirtyRows.cend(), true) != _dirtyRows.cend();
+    return anyDirty ? S_OK : S_FALSE;
 }
 
+// Routine Description:
+// - Hands the painted frame to ConIoSrv. The shared section holds the old and
+//   the new contents of each row, so rows we didn't touch already match their
+//   old run. We only ask ConIoSrv to update the display when one of the rows
+//   we painted actually changed, and only copy those rows back afterwards.
+// Arguments:
+// - <none>
+// Return Value:
+// - S_OK, or a suitable HRESULT if the update request failed.
 [[nodiscard]] HRESULT BgfxEngine::EndPaint() noexcept
 {
-    NTSTATUS Status;
+    NTSTATUS Status = STATUS_SUCCESS;
 
     PVOID OldRunBase;
     PVOID NewRunBase;
 
-    Status = ServiceLocator::LocateInputServices<ConIoSrvComm>()->RequestUpdateDisplay(0);
-
-    if (NT_SUCCESS(Status))
+    bool anyChanged = false;
+    for (LONG i = 0; i < _displayHeight; i++)
     {
-        for (SHORT i = 0; i < _displayHeight; i++)
+        if (_dirtyRows[i])
         {
             OldRunBase = (PVOID)(_sharedViewBase + (i * 2 * _runLength));
             NewRunBase = (PVOID)(_sharedViewBase + (i * 2 * _runLength) + _runLength);
-            memcpy_s(OldRunBase, _runLength, NewRunBase, _runLength);
+            if (memcmp(OldRunBase, NewRunBase, _runLength) != 0)
+            {
+                anyChanged = true;
+            }
+            else
+            {
+                _dirtyRows[i] = false;
+            }
+        }
+    }
+
+    if (anyChanged)
+    {
+        Status = ServiceLocator::LocateInputServices<ConIoSrvComm>()->RequestUpdateDisplay(0);
+    }
+
+    if (NT_SUCCESS(Status))
+    {
+        for (LONG i = 0; i < _displayHeight; i++)
+        {
+            if (_dirtyRows[i])
+            {
+                OldRunBase = (PVOID)(_sharedViewBase + (i * 2 * _runLength));
+                NewRunBase = (PVOID)(_sharedViewBase + (i * 2 * _runLength) + _runLength);
+                memcpy_s(OldRunBase, _runLength, NewRunBase, _runLength);
+                _dirtyRows[i] = false;
+            }
         }
     }
 
@@ -127,8 +209,13 @@ BgfxEngine::BgfxEngine(PVOID SharedViewBase, LONG DisplayHeight, LONG DisplayWid
     PCD_IO_CHARACTER OldRun;
     PCD_IO_CHARACTER NewRun;
 
-    for (SHORT i = 0; i < _displayHeight; i++)
+    for (LONG i = 0; i < _displayHeight; i++)
     {
+        if (!_dirtyRows[i])
+        {
+            continue;
+        }
+
         OldRunBase = (PVOID)(_sharedViewBase + (i * 2 * _runLength));
         NewRunBase = (PVOID)(_sharedViewBase + (i * 2 * _runLength) + _runLength);
 
@@ -231,21 +318,38 @@ BgfxEngine::BgfxEngine(PVOID SharedViewBase, LONG DisplayHeight, LONG DisplayWid
     return S_OK;
 }
 
+// Routine Description:
+// - Reports the dirty rows as full width rectangles, one per run of consecutive rows.
+// Arguments:
+// - area - receives the rectangles that need to be repainted
+// Return Value:
+// - S_OK, or a suitable HRESULT if we fail to build the list.
 [[nodiscard]] HRESULT BgfxEngine::GetDirtyArea(gsl::span<const til::rectangle>& area) noexcept
+try
 {
-    SMALL_RECT r;
-    r.Bottom = _displayHeight > 0 ? (SHORT)(_displayHeight - 1) : 0;
-    r.Top = 0;
-    r.Left = 0;
-    r.Right = _displayWidth > 0 ? (SHORT)(_displayWidth - 1) : 0;
+    _dirtyAreas.clear();
 
-    _dirtyArea = r;
+    for (LONG row = 0; row < _displayHeight;)
+    {
+        if (!_dirtyRows[row])
+        {
+            ++row;
+            continue;
+        }
+
+        const auto top = row;
+        while (row < _displayHeight && _dirtyRows[row])
+        {
+            ++row;
+        }
+        _dirtyAreas.emplace_back(ptrdiff_t{ 0 }, ptrdiff_t{ top }, ptrdiff_t{ _displayWidth }, ptrdiff_t{ row });
+    }
 
-    area = { &_dirtyArea,
-             1 };
+    area = { _dirtyAreas.data(), _dirtyAreas.size() };
 
     return S_OK;
 }
+CATCH_RETURN()
 
 [[nodiscard]] HRESULT BgfxEngine::GetFontSize(_Out_ COORD* const pFontSize) noexcept
 {
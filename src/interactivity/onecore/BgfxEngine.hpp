@@ -81,7 +81,13 @@ namespace Microsoft::Console::Render
 
         LONG _displayHeight;
         LONG _displayWidth;
-        til::rectangle _dirtyArea;
+
+        // Rows that have to be repainted in the next frame and the
+        // row ranges reported to the renderer through GetDirtyArea.
+        std::vector<bool> _dirtyRows;
+        std::vector<til::rectangle> _dirtyAreas;
+
+        void _InvalidateRows(const LONG top, const LONG bottom) noexcept;
 
         COORD _fontSize;
 
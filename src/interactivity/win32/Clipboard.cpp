@@ -270,17 +270,24 @@ void Clipboard::CopyTextToSystemClipboard(const TextBuffer::TextAndColor& rows,
         THROW_LAST_ERROR_IF(!EmptyClipboard());
         THROW_LAST_ERROR_IF_NULL(SetClipboardData(CF_UNICODETEXT, globalHandle.get()));
 
+        // EmptyClipboard sent us WM_DESTROYCLIPBOARD, if we owned the clipboard
+        // before, which discarded the formats of the previous copy.
         if (fAlsoCopyFormatting)
         {
             const auto& fontData = ServiceLocator::LocateGlobals().getConsoleInformation().GetActiveOutputBuffer().GetCurrentFont();
             int const iFontHeightPoints = fontData.GetUnscaledSize().Y * 72 / ServiceLocator::LocateGlobals().dpi;
             const COLORREF bgColor = ServiceLocator::LocateGlobals().getConsoleInformation().GetDefaultBackground();
 
-            std::string HTMLToPlaceOnClip = TextBuffer::GenHTML(rows, iFontHeightPoints, fontData.GetFaceName(), bgColor);
-            CopyToSystemClipboard(HTMLToPlaceOnClip, L"HTML Format");
-
-            std::string RTFToPlaceOnClip = TextBuffer::GenRTF(rows, iFontHeightPoints, fontData.GetFaceName(), bgColor);
-            CopyToSystemClipboard(RTFToPlaceOnClip, L"Rich Text Format");
+            // The HTML and RTF are rendered on demand (WM_RENDERFORMAT), since
+            // most pastes only ever ask for the text.
+            _delayedFormats.emplace(DelayedFormats{ rows, iFontHeightPoints, std::wstring{ fontData.GetFaceName() }, bgColor });
+            for (const auto format : { L"HTML Format", L"Rich Text Format" })
+            {
+                UINT const CF_FORMAT = RegisterClipboardFormatW(format);
+                THROW_LAST_ERROR_IF(0 == CF_FORMAT);
+                // Without data, this returns nullptr either way.
+                SetClipboardData(CF_FORMAT, nullptr);
+            }
         }
     }
 
@@ -324,6 +331,62 @@ void Clipboard::CopyToSystemClipboard(std::string stringToCopy, LPCWSTR lpszForm
     }
 }
 
+// Routine Description:
+// - Handles WM_RENDERFORMAT: generates one of the formats we deferred in
+//   CopyTextToSystemClipboard and places it on the clipboard, which is
+//   already open for us.
+// Arguments:
+// - format - the requested clipboard format
+void Clipboard::RenderFormat(const UINT format)
+{
+    if (!_delayedFormats)
+    {
+        return;
+    }
+
+    const auto& pending = *_delayedFormats;
+    if (format == RegisterClipboardFormatW(L"HTML Format"))
+    {
+        CopyToSystemClipboard(TextBuffer::GenHTML(pending.rows, pending.fontHeightPoints, pending.fontFaceName, pending.backgroundColor), L"HTML Format");
+    }
+    else if (format == RegisterClipboardFormatW(L"Rich Text Format"))
+    {
+        CopyToSystemClipboard(TextBuffer::GenRTF(pending.rows, pending.fontHeightPoints, pending.fontFaceName, pending.backgroundColor), L"Rich Text Format");
+    }
+}
+
+// Routine Description:
+// - Handles WM_RENDERALLFORMATS: our window is going away, so the deferred
+//   formats need to be generated now if the clipboard still holds our copy.
+// Arguments:
+// - hwnd - our window, the clipboard's owner
+void Clipboard::RenderAllFormats(const HWND hwnd)
+{
+    if (!_delayedFormats || !OpenClipboard(hwnd))
+    {
+        return;
+    }
+
+    auto clipboardCloser = wil::scope_exit([]() {
+        CloseClipboard();
+    });
+
+    if (GetClipboardOwner() == hwnd)
+    {
+        RenderFormat(RegisterClipboardFormatW(L"HTML Format"));
+        RenderFormat(RegisterClipboardFormatW(L"Rich Text Format"));
+    }
+    _delayedFormats.reset();
+}
+
+// Routine Description:
+// - Handles WM_DESTROYCLIPBOARD: the clipboard got emptied, so we'll never be
+//   asked for the deferred formats anymore.
+void Clipboard::DiscardDelayedFormats() noexcept
+{
+    _delayedFormats.reset();
+}
+
 // Returns true if the character should be emitted to the paste stream
 // -- in some cases, we will change what character should be emitted, as in the case of "smart quotes"
 // Returns false if the character should not be emitted (e.g. <TAB>)
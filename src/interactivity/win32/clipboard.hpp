@@ -34,7 +34,21 @@ namespace Microsoft::Console::Interactivity::Win32
                          const size_t cchData);
         void Paste();
 
+        void RenderFormat(const UINT format);
+        void RenderAllFormats(const HWND hwnd);
+        void DiscardDelayedFormats() noexcept;
+
     private:
+        // What we need to generate the HTML and RTF once someone asks for them.
+        struct DelayedFormats
+        {
+            TextBuffer::TextAndColor rows;
+            int fontHeightPoints;
+            std::wstring fontFaceName;
+            COLORREF backgroundColor;
+        };
+        std::optional<DelayedFormats> _delayedFormats;
+
         std::deque<std::unique_ptr<IInputEvent>> TextToKeyEvents(_In_reads_(cchData) const wchar_t* const pData,
                                                                  const size_t cchData);
 
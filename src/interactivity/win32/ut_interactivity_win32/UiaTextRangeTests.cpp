@@ -354,9 +354,9 @@ class UiaTextRangeTests
         {
             ROW& row = _pTextBuffer->GetRowByOffset(i);
             auto& charRow = row.GetCharRow();
-            for (auto& cell : charRow)
+            for (size_t col = 0; col < charRow.size(); ++col)
             {
-                cell.Char() = L' ';
+                charRow.GlyphAt(col) = L" ";
             }
         }
 
@@ -1408,6 +1408,30 @@ class UiaTextRangeTests
         VERIFY_ARE_EQUAL(L"M", std::wstring_view{ text });
     }
 
+    TEST_METHOD(GetTextWithMaxLength)
+    {
+        _pTextBuffer->Write({ L"My name is Carlos" }, origin);
+
+        Microsoft::WRL::ComPtr<UiaTextRange> utr;
+        THROW_IF_FAILED(Microsoft::WRL::MakeAndInitialize<UiaTextRange>(&utr, _pUiaData, &_dummyProvider, origin, COORD{ 0, 3 }));
+
+        BSTR text;
+        THROW_IF_FAILED(utr->GetText(-1, &text));
+        const std::wstring fullText{ text };
+        VERIFY_ARE_EQUAL(L"My name is Carlos", std::wstring_view{ fullText }.substr(0, 17));
+
+        Log::Comment(L"A short maxLength only returns the start of the range");
+        THROW_IF_FAILED(utr->GetText(7, &text));
+        VERIFY_ARE_EQUAL(L"My name", std::wstring_view{ text });
+
+        THROW_IF_FAILED(utr->GetText(0, &text));
+        VERIFY_ARE_EQUAL(L"", std::wstring_view{ text });
+
+        Log::Comment(L"A maxLength past the end of the range returns the whole range, unpadded");
+        THROW_IF_FAILED(utr->GetText(gsl::narrow<int>(fullText.size()) + 100, &text));
+        VERIFY_ARE_EQUAL(std::wstring_view{ fullText }, std::wstring_view{ text });
+    }
+
     TEST_METHOD(ScrollIntoView)
     {
         const auto viewportSize{ _pUiaData->GetViewport() };
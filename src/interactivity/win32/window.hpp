@@ -16,6 +16,8 @@ Author(s):
 
 #include "../inc/IConsoleWindow.hpp"
 
+#include <til/throttled_func.h>
+
 namespace Microsoft::Console::Interactivity::Win32
 {
     class WindowUiaProvider;
@@ -112,6 +114,11 @@ namespace Microsoft::Console::Interactivity::Win32
 
         void _UpdateSystemMetrics() const;
 
+        // Output floods ask for the scroll bars to be updated all the time. They're updated
+        // at most once per frame, which keeps the message queue free for dragging and resizing.
+        static constexpr auto s_scrollBarUpdateDelay = std::chrono::milliseconds(16);
+        mutable std::unique_ptr<til::throttled_func_trailing<>> _scrollBarUpdater;
+
         // Wndproc
         [[nodiscard]] static LRESULT CALLBACK s_ConsoleWindowProc(_In_ HWND hwnd,
                                                                   _In_ UINT uMsg,
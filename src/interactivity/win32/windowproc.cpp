@@ -151,6 +151,32 @@ using namespace Microsoft::Console::Types;
         break;
     }
 
+    case WM_RENDERFORMAT:
+    {
+        try
+        {
+            Clipboard::Instance().RenderFormat(gsl::narrow_cast<UINT>(wParam));
+        }
+        CATCH_LOG();
+        break;
+    }
+
+    case WM_RENDERALLFORMATS:
+    {
+        try
+        {
+            Clipboard::Instance().RenderAllFormats(hWnd);
+        }
+        CATCH_LOG();
+        break;
+    }
+
+    case WM_DESTROYCLIPBOARD:
+    {
+        Clipboard::Instance().DiscardDelayedFormats();
+        break;
+    }
+
     case WM_DESTROY:
     {
         // signal to uia that they can disconnect our uia provider
@@ -932,6 +958,21 @@ BOOL Window::SendNotifyBeep() const
 
 BOOL Window::PostUpdateScrollBars() const
 {
+    // CONSOLE_UPDATING_SCROLL_BARS stays set until the message is handled, so the scroll
+    // bars are updated with whatever the state of the buffer is once the delay has passed.
+    try
+    {
+        if (!_scrollBarUpdater)
+        {
+            _scrollBarUpdater = std::make_unique<til::throttled_func_trailing<>>(s_scrollBarUpdateDelay, [this]() {
+                LOG_IF_WIN32_BOOL_FALSE(PostMessageW(GetWindowHandle(), CM_UPDATE_SCROLL_BARS, (WPARAM)&GetScreenInfo(), 0));
+            });
+        }
+        (*_scrollBarUpdater)();
+        return TRUE;
+    }
+    CATCH_LOG();
+
     return PostMessageW(GetWindowHandle(), CM_UPDATE_SCROLL_BARS, (WPARAM)&GetScreenInfo(), 0);
 }
 
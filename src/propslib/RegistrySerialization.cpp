@@ -84,12 +84,12 @@ const size_t RegistrySerialization::s_GlobalPropMappingsSize = ARRAYSIZE(s_Globa
 // - Reads number from the registry and applies it to the given property if the value exists
 //   Supports: Dword, Word, Byte, Boolean, and Coordinate
 // Arguments:
-// - hKey - Registry key to read from
+// - values - Snapshot of the registry key to read from
 // - pPropMap - Contains property information to use in looking up/storing value data
 // Return Value:
 // - STATUS_SUCCESSFUL or appropriate NTSTATUS reply for registry operations.
 [[nodiscard]]
-NTSTATUS RegistrySerialization::s_LoadRegDword(const HKEY hKey, const _RegPropertyMap* const pPropMap, _In_ Settings* const pSettings)
+NTSTATUS RegistrySerialization::s_LoadRegDword(const ValueSnapshot& values, const _RegPropertyMap* const pPropMap, _In_ Settings* const pSettings)
 {
     // find offset into destination structure for this numerical value
     PBYTE const pbField = (PBYTE)pSettings + pPropMap->dwFieldOffset;
@@ -97,12 +97,11 @@ NTSTATUS RegistrySerialization::s_LoadRegDword(const HKEY hKey, const _RegProper
     // attempt to load number into this field
     // If we're not successful, it's ok. Just don't fill it.
     DWORD dwValue;
-    NTSTATUS Status = s_QueryValue(hKey,
-                                   pPropMap->pwszValueName,
-                                   sizeof(dwValue),
-                                   ToWin32RegistryType(pPropMap->propertyType),
-                                   (PBYTE)& dwValue,
-                                   nullptr);
+    NTSTATUS Status = values.QueryValue(pPropMap->pwszValueName,
+                                        sizeof(dwValue),
+                                        ToWin32RegistryType(pPropMap->propertyType),
+                                        (PBYTE)& dwValue,
+                                        nullptr);
     if (NT_SUCCESS(Status))
     {
         switch (pPropMap->propertyType)
@@ -145,12 +144,12 @@ NTSTATUS RegistrySerialization::s_LoadRegDword(const HKEY hKey, const _RegProper
 // Routine Description:
 // - Reads string from the registry and applies it to the given property if the value exists
 // Arguments:
-// - hKey - Registry key to read from
+// - values - Snapshot of the registry key to read from
 // - pPropMap - Contains property information to use in looking up/storing value data
 // Return Value:
 // - STATUS_SUCCESSFUL or appropriate NTSTATUS reply for registry operations.
 [[nodiscard]]
-NTSTATUS RegistrySerialization::s_LoadRegString(const HKEY hKey, const _RegPropertyMap* const pPropMap, _In_ Settings* const pSettings)
+NTSTATUS RegistrySerialization::s_LoadRegString(const ValueSnapshot& values, const _RegPropertyMap* const pPropMap, _In_ Settings* const pSettings)
 {
     // find offset into destination structure for this numerical value
     PBYTE const pbField = (PBYTE)pSettings + pPropMap->dwFieldOffset;
@@ -162,12 +161,11 @@ NTSTATUS RegistrySerialization::s_LoadRegString(const HKEY hKey, const _RegPrope
     NTSTATUS Status = NT_TESTNULL(pwchString);
     if (NT_SUCCESS(Status))
     {
-        Status = s_QueryValue(hKey,
-                              pPropMap->pwszValueName,
-                              (DWORD)(cchField) * sizeof(WCHAR),
-                              ToWin32RegistryType(pPropMap->propertyType),
-                              (PBYTE)pwchString,
-                              nullptr);
+        Status = values.QueryValue(pPropMap->pwszValueName,
+                                   (DWORD)(cchField) * sizeof(WCHAR),
+                                   ToWin32RegistryType(pPropMap->propertyType),
+                                   (PBYTE)pwchString,
+                                   nullptr);
         if (NT_SUCCESS(Status))
         {
             // ensure pwchString is null terminated
@@ -337,6 +335,146 @@ NTSTATUS RegistrySerialization::s_QueryValue(const HKEY hKey,
     return NTSTATUS_FROM_WIN32(Result);
 }
 
+// Routine Description:
+// - Reads all the values of the given key at once.
+// - Loading the console settings queries dozens of values, most of which usually don't exist,
+//   several times over. Enumerating the ones that do exist once and looking the rest up in memory
+//   is a lot cheaper. Snapshots are cached for the lifetime of the process and reused as long as
+//   the last write time of the key (which every change to its values updates) stays the same,
+//   as checked by a single RegQueryInfoKeyW call.
+// Arguments:
+// - hKey - Handle to a registry key
+// - keyName - Identifies the key in the cache, for instance the name of its console subkey.
+// - snapshot - Receives the values of the key
+// Return Value:
+// - STATUS_SUCCESSFUL or appropriate NTSTATUS reply for registry operations.
+[[nodiscard]]
+NTSTATUS RegistrySerialization::s_SnapshotValues(const HKEY hKey,
+                                                 const std::wstring_view keyName,
+                                                 _Out_ std::shared_ptr<const ValueSnapshot>& snapshot)
+try
+{
+    static wil::srwlock lock;
+    static std::map<std::wstring, std::shared_ptr<const ValueSnapshot>, ValueSnapshot::NameLess> cache;
+
+    snapshot.reset();
+
+    DWORD valueCount = 0;
+    DWORD cchMaxValueName = 0;
+    DWORD cbMaxValueData = 0;
+    FILETIME lastWriteTime{};
+    auto Status = NTSTATUS_FROM_WIN32(RegQueryInfoKeyW(hKey, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, &valueCount, &cchMaxValueName, &cbMaxValueData, nullptr, &lastWriteTime));
+    if (!NT_SUCCESS(Status))
+    {
+        return Status;
+    }
+
+    const std::wstring name{ keyName };
+    {
+        const auto shared = lock.lock_shared();
+        const auto it = cache.find(name);
+        if (it != cache.end() &&
+            it->second->_valueCount == valueCount &&
+            CompareFileTime(&it->second->_lastWriteTime, &lastWriteTime) == 0)
+        {
+            snapshot = it->second;
+            return STATUS_SUCCESS;
+        }
+    }
+
+    auto values = std::make_shared<ValueSnapshot>();
+    values->_lastWriteTime = lastWriteTime;
+    values->_valueCount = valueCount;
+
+    // The maximum name length doesn't include the terminating null.
+    std::wstring valueName(cchMaxValueName + 1, UNICODE_NULL);
+    std::vector<BYTE> data(cbMaxValueData);
+    for (DWORD i = 0; i < valueCount; ++i)
+    {
+        auto cchValueName = gsl::narrow_cast<DWORD>(valueName.size());
+        auto cbData = gsl::narrow_cast<DWORD>(data.size());
+        DWORD type = 0;
+        const auto result = RegEnumValueW(hKey, i, valueName.data(), &cchValueName, nullptr, &type, data.data(), &cbData);
+        if (result == ERROR_NO_MORE_ITEMS)
+        {
+            break;
+        }
+        // The key changed while we were reading it. That's fine, it'll be read again next time.
+        if (result == ERROR_MORE_DATA)
+        {
+            values->_lastWriteTime = {};
+            continue;
+        }
+        Status = NTSTATUS_FROM_WIN32(result);
+        if (!NT_SUCCESS(Status))
+        {
+            return Status;
+        }
+
+        auto& value = values->_values[valueName.substr(0, cchValueName)];
+        value.type = type;
+        value.data.assign(data.begin(), data.begin() + cbData);
+    }
+
+    {
+        const auto exclusive = lock.lock_exclusive();
+        cache[name] = values;
+    }
+    snapshot = std::move(values);
+    return STATUS_SUCCESS;
+}
+NT_CATCH_RETURN()
+
+bool RegistrySerialization::ValueSnapshot::NameLess::operator()(const std::wstring& lhs, const std::wstring& rhs) const noexcept
+{
+    return CompareStringOrdinal(lhs.data(), gsl::narrow_cast<int>(lhs.size()), rhs.data(), gsl::narrow_cast<int>(rhs.size()), TRUE) == CSTR_LESS_THAN;
+}
+
+// Routine Description:
+// - Reads a value from the snapshot, just like s_QueryValue would read it from the registry key.
+// Arguments:
+// - pwszValueName - Name of the value to query
+// - cbValueLength - Length of the provided data buffer.
+// - regType - the type of the registry key.
+// - pbData - Pointer to byte stream of data to fill with the registry value data.
+// - pcbDataLength - Number of bytes filled in the given data buffer
+// Return Value:
+// - STATUS_SUCCESSFUL or appropriate NTSTATUS reply for registry operations.
+[[nodiscard]]
+NTSTATUS RegistrySerialization::ValueSnapshot::QueryValue(_In_ PCWSTR const pwszValueName,
+                                                          const DWORD cbValueLength,
+                                                          const DWORD regType,
+                                                          _Out_writes_bytes_(cbValueLength) BYTE* const pbData,
+                                                          _Out_opt_ _Out_range_(0, cbValueLength) DWORD* const pcbDataLength) const
+try
+{
+    const auto it = _values.find(pwszValueName);
+    if (it == _values.end())
+    {
+        return NTSTATUS_FROM_WIN32(ERROR_FILE_NOT_FOUND);
+    }
+
+    const auto& value = it->second;
+    if (value.type != regType)
+    {
+        return STATUS_OBJECT_TYPE_MISMATCH;
+    }
+
+    const auto cbData = gsl::narrow_cast<DWORD>(value.data.size());
+    if (nullptr != pcbDataLength)
+    {
+        *pcbDataLength = cbData;
+    }
+    if (cbData > cbValueLength)
+    {
+        return NTSTATUS_FROM_WIN32(ERROR_MORE_DATA);
+    }
+
+    std::copy(value.data.begin(), value.data.end(), pbData);
+    return STATUS_SUCCESS;
+}
+NT_CATCH_RETURN()
+
 // Routine Description:
 // - Enumerates the values for the given key
 // Arguments:
@@ -25,6 +25,40 @@ class Settings;
 class RegistrySerialization
 {
 public:
+    // A copy of all the values of a registry key, see s_SnapshotValues.
+    class ValueSnapshot final
+    {
+    public:
+        [[nodiscard]] NTSTATUS QueryValue(_In_ PCWSTR const pwszValueName,
+                                          const DWORD cbValueLength,
+                                          const DWORD regType,
+                                          _Out_writes_bytes_(cbValueLength) BYTE* const pbData,
+                                          _Out_opt_ _Out_range_(0, cbValueLength) DWORD* const pcbDataLength) const;
+
+    private:
+        struct Value
+        {
+            DWORD type;
+            std::vector<BYTE> data;
+        };
+
+        // Like the registry, value names are compared case insensitively.
+        struct NameLess
+        {
+            bool operator()(const std::wstring& lhs, const std::wstring& rhs) const noexcept;
+        };
+
+        std::map<std::wstring, Value, NameLess> _values;
+        FILETIME _lastWriteTime{};
+        DWORD _valueCount = 0;
+
+        friend class RegistrySerialization;
+    };
+
+    [[nodiscard]] static NTSTATUS s_SnapshotValues(const HKEY hKey,
+                                                   const std::wstring_view keyName,
+                                                   _Out_ std::shared_ptr<const ValueSnapshot>& snapshot);
+
     // The following registry methods remain public for DBCS and EUDC lookups.
     [[nodiscard]] static NTSTATUS s_OpenKey(_In_opt_ HKEY const hKey, _In_ PCWSTR const pwszSubKey, _Out_ HKEY* const phResult);
 
@@ -94,6 +128,6 @@ public:
     static const RegPropertyMap s_GlobalPropMappings[];
     static const size_t s_GlobalPropMappingsSize;
 
-    [[nodiscard]] static NTSTATUS s_LoadRegDword(const HKEY hKey, const _RegPropertyMap* const pPropMap, _In_ Settings* const pSettings);
-    [[nodiscard]] static NTSTATUS s_LoadRegString(const HKEY hKey, const _RegPropertyMap* const pPropMap, _In_ Settings* const pSettings);
+    [[nodiscard]] static NTSTATUS s_LoadRegDword(const ValueSnapshot& values, const _RegPropertyMap* const pPropMap, _In_ Settings* const pSettings);
+    [[nodiscard]] static NTSTATUS s_LoadRegString(const ValueSnapshot& values, const _RegPropertyMap* const pPropMap, _In_ Settings* const pSettings);
 };
@@ -96,6 +96,25 @@ void FontResource::SetTargetSize(const til::size targetSize)
     }
 }
 
+// Routine Description:
+// - Checks whether this resource was constructed with the given font definition.
+//   The generated font is only a function of these and the target size, so if they
+//   match, there's no need to replace the resource.
+// Arguments:
+// - bitPattern - An array of scanlines representing all the glyphs in the font.
+// - sourceSize - The cell size for an individual glyph.
+// - centeringHint - The horizontal extent that glyphs are offset from center.
+// Return Value:
+// - true if the resource was constructed from the same font definition.
+bool FontResource::IsCreatedFrom(const gsl::span<const uint16_t> bitPattern,
+                                 const til::size sourceSize,
+                                 const size_t centeringHint) const noexcept
+{
+    return _sourceSize == sourceSize &&
+           _centeringHint == centeringHint &&
+           std::equal(_bitPattern.begin(), _bitPattern.end(), bitPattern.begin(), bitPattern.end());
+}
+
 FontResource::operator HFONT()
 {
     if (!_fontHandle && !_bitPattern.empty())
@@ -5,6 +5,11 @@
 
 #include "renderer.hpp"
 
+#include <execution>
+
+#include <winmeta.h>
+#include <TraceLoggingProvider.h>
+
 #pragma hdrstop
 
 using namespace Microsoft::Console::Render;
@@ -12,6 +17,69 @@ using namespace Microsoft::Console::Types;
 
 using PointTree = interval_tree::IntervalTree<til::point, size_t>;
 
+#pragma warning(suppress : 26477) // We don't control tracelogging macros
+TRACELOGGING_DEFINE_PROVIDER(g_hRendererProvider,
+                             "Microsoft.Windows.Console.Render",
+                             // {41a35baf-cd55-5e23-782b-7323338b5283}
+                             (0x41a35baf, 0xcd55, 0x5e23, 0x78, 0x2b, 0x73, 0x23, 0x33, 0x8b, 0x52, 0x83), );
+
+namespace
+{
+    // The provider is shared by all renderers in the process.
+    std::atomic<size_t> s_rendererCount{ 0 };
+
+    // Writes a "RenderPhase" start event when constructed and the matching stop
+    // event when destroyed or stopped, so that each phase of painting a frame
+    // shows up as a region in WPA. See ConsolePerf.regions.xml.
+    // The phase must be a string literal, as only the pointer is kept.
+    class RenderPhaseTrace
+    {
+    public:
+        explicit RenderPhaseTrace(const char* const phase) noexcept :
+            _phase{ phase },
+            _enabled{ TraceLoggingProviderEnabled(g_hRendererProvider, WINEVENT_LEVEL_VERBOSE, TIL_KEYWORD_TRACE) }
+        {
+            if (_enabled)
+            {
+#pragma warning(suppress : 26477 26485 26494 26482 26446 26447) // We don't control TraceLoggingWrite
+                TraceLoggingWrite(g_hRendererProvider,
+                                  "RenderPhase",
+                                  TraceLoggingString(_phase, "Phase"),
+                                  TraceLoggingOpcode(WINEVENT_OPCODE_START),
+                                  TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+                                  TraceLoggingKeyword(TIL_KEYWORD_TRACE));
+            }
+        }
+
+        ~RenderPhaseTrace()
+        {
+            Stop();
+        }
+
+        RenderPhaseTrace(const RenderPhaseTrace&) = delete;
+        RenderPhaseTrace& operator=(const RenderPhaseTrace&) = delete;
+
+        void Stop() noexcept
+        {
+            if (_enabled)
+            {
+                _enabled = false;
+#pragma warning(suppress : 26477 26485 26494 26482 26446 26447) // We don't control TraceLoggingWrite
+                TraceLoggingWrite(g_hRendererProvider,
+                                  "RenderPhase",
+                                  TraceLoggingString(_phase, "Phase"),
+                                  TraceLoggingOpcode(WINEVENT_OPCODE_STOP),
+                                  TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+                                  TraceLoggingKeyword(TIL_KEYWORD_TRACE));
+            }
+        }
+
+    private:
+        const char* _phase;
+        bool _enabled;
+    };
+}
+
 static constexpr auto maxRetriesForRenderEngine = 3;
 // The renderer will wait this number of milliseconds * how many tries have elapsed before trying again.
 static constexpr auto renderBackoffBaseTimeMilliseconds{ 150 };
@@ -37,6 +105,11 @@ Renderer::Renderer(IRenderData* pData,
     _pThread{ std::move(thread) },
     _viewport{ pData->GetViewport() }
 {
+    if (s_rendererCount.fetch_add(1) == 0)
+    {
+        TraceLoggingRegister(g_hRendererProvider);
+    }
+
     for (size_t i = 0; i < cEngines; i++)
     {
         AddRenderEngine(rgpEngines[i]);
@@ -54,6 +127,11 @@ Renderer::~Renderer()
     // IRenderThread blocks until it has shut down.
     _destructing = true;
     _pThread.reset();
+
+    if (s_rendererCount.fetch_sub(1) == 1)
+    {
+        TraceLoggingUnregister(g_hRendererProvider);
+    }
 }
 
 // Routine Description:
@@ -64,6 +142,28 @@ Renderer::~Renderer()
 // - HRESULT S_OK, GDI error, Safe Math error, or state/argument errors.
 [[nodiscard]] HRESULT Renderer::PaintFrame()
 {
+    // A frame might have been requested right before we got hidden. The engines
+    // keep what's invalid until then and SetVisible requests a frame for it.
+    if (_hidden.load(std::memory_order_relaxed))
+    {
+        return S_FALSE;
+    }
+
+    const auto frameStart = std::chrono::steady_clock::now();
+    _paintedThisFrame = false;
+    // Anything invalidated after this point is picked up by the next frame.
+    _invalidateAllThisFrame = _invalidatedInThroughputMode.exchange(false, std::memory_order_relaxed);
+
+    auto countFrame = wil::scope_exit([&]() noexcept {
+        if (_paintedThisFrame)
+        {
+            const auto elapsed = std::chrono::steady_clock::now() - frameStart;
+            const auto us = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+            _paintMicroseconds.fetch_add(gsl::narrow_cast<uint64_t>(us), std::memory_order_relaxed);
+            _frames.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+
     FOREACH_ENGINE(pEngine)
     {
         auto tries = maxRetriesForRenderEngine;
@@ -104,19 +204,49 @@ Renderer::~Renderer()
     return S_OK;
 }
 
+// Routine Description:
+// - Returns the lifetime totals of frames painted, the time spent painting
+//   them and the number of dirty cells that were redrawn. The counters are
+//   read without synchronizing with the render thread, so they're only good
+//   for diagnostics like TermControl's performance overlay.
+// Arguments:
+// - <none>
+// Return Value:
+// - the current counter values
+Renderer::FrameCounters Renderer::GetFrameCounters() const noexcept
+{
+    FrameCounters counters;
+    counters.frames = _frames.load(std::memory_order_relaxed);
+    counters.paintMicroseconds = _paintMicroseconds.load(std::memory_order_relaxed);
+    counters.dirtyCells = _dirtyCells.load(std::memory_order_relaxed);
+    return counters;
+}
+
 [[nodiscard]] HRESULT Renderer::_PaintFrameForEngine(_In_ IRenderEngine* const pEngine) noexcept
 try
 {
     FAIL_FAST_IF_NULL(pEngine); // This is a programming error. Fail fast.
 
+    RenderPhaseTrace frameTrace{ "PaintFrame" };
+
+    RenderPhaseTrace lockWaitTrace{ "LockWait" };
     _pData->LockConsole();
+    lockWaitTrace.Stop();
+
+    RenderPhaseTrace lockHeldTrace{ "LockHeld" };
     auto unlock = wil::scope_exit([&]() {
         _pData->UnlockConsole();
+        lockHeldTrace.Stop();
     });
 
     // Last chance check if anything scrolled without an explicit invalidate notification since the last frame.
     _CheckViewportAndScroll();
 
+    if (_invalidateAllThisFrame)
+    {
+        LOG_IF_FAILED(pEngine->InvalidateAll());
+    }
+
     // Try to start painting a frame
     HRESULT const hr = pEngine->StartPaint();
     RETURN_IF_FAILED(hr);
@@ -126,9 +256,16 @@ try
     //      engine won't know that.
     if (S_FALSE == hr)
     {
+        // The engine might have put off painting this frame; make sure we come back to it.
+        if (pEngine->RequiresContinuousRedraw())
+        {
+            _NotifyPaintFrame();
+        }
         return S_OK;
     }
 
+    _paintedThisFrame = true;
+
     auto endPaint = wil::scope_exit([&]() {
         LOG_IF_FAILED(pEngine->EndPaint());
 
@@ -175,6 +312,7 @@ try
     unlock.reset();
 
     // Trigger out-of-lock presentation for renderers that can support it
+    RenderPhaseTrace presentTrace{ "Present" };
     RETURN_IF_FAILED(pEngine->Present());
 
     // As we leave the scope, EndPaint will be called (declared above)
@@ -192,6 +330,104 @@ void Renderer::_NotifyPaintFrame()
     }
 }
 
+// Routine Description:
+// - Remembers that something changed while we're hidden, instead of passing
+//   the invalidation on to the engines. See SetVisible.
+// Arguments:
+// - <none>
+// Return Value:
+// - true if we're hidden and the caller should skip invalidating the engines.
+bool Renderer::_CollapseInvalidationWhileHidden() noexcept
+{
+    if (_hidden.load(std::memory_order_relaxed))
+    {
+        _invalidatedWhileHidden.store(true, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+// Routine Description:
+// - Like _CollapseInvalidationWhileHidden, but remembers the region that
+//   changed, so that only it needs to be redrawn once we're visible again.
+// Arguments:
+// - region: the buffer-space region that changed.
+// Return Value:
+// - true if we're hidden and the caller should skip invalidating the engines.
+bool Renderer::_CollapseRegionWhileHidden(const Viewport& region)
+{
+    if (!_hidden.load(std::memory_order_relaxed))
+    {
+        return false;
+    }
+
+    if (!_invalidatedWhileHidden.load(std::memory_order_relaxed))
+    {
+        if (_regionsInvalidatedWhileHidden.size() + _cursorsInvalidatedWhileHidden.size() >= s_maxRegionsInvalidatedWhileHidden)
+        {
+            _invalidatedWhileHidden.store(true, std::memory_order_relaxed);
+        }
+        // The same region usually changes over and over, like a line that's being typed.
+        else if (_regionsInvalidatedWhileHidden.empty() || _regionsInvalidatedWhileHidden.back() != region)
+        {
+            _regionsInvalidatedWhileHidden.emplace_back(region);
+        }
+    }
+    return true;
+}
+
+// Routine Description:
+// - Like _CollapseRegionWhileHidden, but for the cursor, which TriggerRedrawCursor
+//   invalidates differently than other regions.
+// Arguments:
+// - coord: the buffer-space position of the cursor.
+// Return Value:
+// - true if we're hidden and the caller should skip invalidating the engines.
+bool Renderer::_CollapseCursorWhileHidden(const COORD coord)
+{
+    if (!_hidden.load(std::memory_order_relaxed))
+    {
+        return false;
+    }
+
+    if (!_invalidatedWhileHidden.load(std::memory_order_relaxed))
+    {
+        if (_regionsInvalidatedWhileHidden.size() + _cursorsInvalidatedWhileHidden.size() >= s_maxRegionsInvalidatedWhileHidden)
+        {
+            _invalidatedWhileHidden.store(true, std::memory_order_relaxed);
+        }
+        // A blinking cursor invalidates the same two cells over and over.
+        else if (std::none_of(_cursorsInvalidatedWhileHidden.begin(), _cursorsInvalidatedWhileHidden.end(), [&](const COORD& c) { return c.X == coord.X && c.Y == coord.Y; }))
+        {
+            _cursorsInvalidatedWhileHidden.emplace_back(coord);
+        }
+    }
+    return true;
+}
+
+// Routine Description:
+// - Decides whether an invalidation should be passed on to the engines.
+//   While hidden, it's only remembered, see SetVisible. In throughput mode,
+//   it's collapsed into a full redraw with the next frame, see SetThroughputMode.
+// Arguments:
+// - <none>
+// Return Value:
+// - true if the caller should skip invalidating the engines.
+bool Renderer::_CollapseInvalidation()
+{
+    if (_CollapseInvalidationWhileHidden())
+    {
+        return true;
+    }
+    if (_throughputMode.load(std::memory_order_relaxed))
+    {
+        _invalidatedInThroughputMode.store(true, std::memory_order_relaxed);
+        _NotifyPaintFrame();
+        return true;
+    }
+    return false;
+}
+
 // Routine Description:
 // - Called when the system has requested we redraw a portion of the console.
 // Arguments:
@@ -200,6 +436,11 @@ void Renderer::_NotifyPaintFrame()
 // - <none>
 void Renderer::TriggerSystemRedraw(const RECT* const prcDirtyClient)
 {
+    if (_CollapseInvalidation())
+    {
+        return;
+    }
+
     FOREACH_ENGINE(pEngine)
     {
         LOG_IF_FAILED(pEngine->InvalidateSystem(prcDirtyClient));
@@ -216,6 +457,11 @@ void Renderer::TriggerSystemRedraw(const RECT* const prcDirtyClient)
 // - <none>
 void Renderer::TriggerRedraw(const Viewport& region)
 {
+    if (_CollapseRegionWhileHidden(region) || _CollapseInvalidation())
+    {
+        return;
+    }
+
     Viewport view = _viewport;
     SMALL_RECT srUpdateRegion = region.ToExclusive();
 
@@ -265,6 +511,11 @@ void Renderer::TriggerRedraw(const COORD* const pcoord)
 // - <none>
 void Renderer::TriggerRedrawCursor(const COORD* const pcoord)
 {
+    if (_CollapseCursorWhileHidden(*pcoord) || _CollapseInvalidation())
+    {
+        return;
+    }
+
     // We first need to make sure the cursor position is within the buffer,
     // otherwise testing for a double width character can throw an exception.
     const auto& buffer = _pData->GetTextBuffer();
@@ -305,6 +556,11 @@ void Renderer::TriggerRedrawCursor(const COORD* const pcoord)
 // - <none>
 void Renderer::TriggerRedrawAll()
 {
+    if (_CollapseInvalidation())
+    {
+        return;
+    }
+
     FOREACH_ENGINE(pEngine)
     {
         LOG_IF_FAILED(pEngine->InvalidateAll());
@@ -339,6 +595,21 @@ void Renderer::TriggerTeardown() noexcept
     }
 }
 
+// Method Description:
+// - Called when the host is about to get rid of the renderer, to stop the paint
+//      thread without waiting for it and without painting another frame.
+//      Unlike TriggerTeardown, this returns right away, so that the caller
+//      isn't blocked by a paint that's underway. Destroying the renderer
+//      then still waits for the paint thread to exit.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void Renderer::TriggerShutdown() noexcept
+{
+    _pThread->TriggerShutdown();
+}
+
 // Routine Description:
 // - Called when the selected area in the console has changed.
 // Arguments:
@@ -347,36 +618,36 @@ void Renderer::TriggerTeardown() noexcept
 // - <none>
 void Renderer::TriggerSelection()
 {
+    if (_CollapseInvalidation())
+    {
+        return;
+    }
+
     try
     {
         // Get selection rectangles
         auto rects = _GetSelectionRects();
 
-        // Restrict all previous selection rectangles to inside the current viewport bounds
-        for (auto& sr : _previousSelection)
-        {
-            // Make the exclusive SMALL_RECT into a til::rectangle.
-            til::rectangle rc{ Viewport::FromExclusive(sr).ToInclusive() };
-
-            // Make a viewport representing the coordinates that are currently presentable.
-            const til::rectangle viewport{ til::size{ _pData->GetViewport().Dimensions() } };
-
-            // Intersect them so we only invalidate things that are still visible.
-            rc &= viewport;
+        // Restrict both selections to inside the current viewport bounds,
+        // so we only compare (and invalidate) things that are still visible.
+        _ClipSelectionToViewport(_previousSelection);
+        _ClipSelectionToViewport(rects);
 
-            // Convert back into the exclusive SMALL_RECT and store in the vector.
-            sr = Viewport::FromInclusive(rc).ToExclusive();
-        }
+        // Only the cells that got selected or deselected need to be redrawn.
+        // While dragging, that's usually a few cells at the end of the selection,
+        // even if the selection itself covers the whole screen.
+        const auto delta = _GetSelectionDelta(_previousSelection, rects);
+        _previousSelection = std::move(rects);
 
-        FOREACH_ENGINE(pEngine)
+        if (!delta.empty())
         {
-            LOG_IF_FAILED(pEngine->InvalidateSelection(_previousSelection));
-            LOG_IF_FAILED(pEngine->InvalidateSelection(rects));
-        }
-
-        _previousSelection = std::move(rects);
+            FOREACH_ENGINE(pEngine)
+            {
+                LOG_IF_FAILED(pEngine->InvalidateSelection(delta));
+            }
 
-        _NotifyPaintFrame();
+            _NotifyPaintFrame();
+        }
     }
     CATCH_LOG();
 }
@@ -422,6 +693,12 @@ bool Renderer::_CheckViewportAndScroll()
 // - <none>
 void Renderer::TriggerScroll()
 {
+    // The viewport change is picked up by _CheckViewportAndScroll once we're painting again.
+    if (_CollapseInvalidation())
+    {
+        return;
+    }
+
     if (_CheckViewportAndScroll())
     {
         _NotifyPaintFrame();
@@ -439,6 +716,11 @@ void Renderer::TriggerScroll()
 // - <none>
 void Renderer::TriggerScroll(const COORD* const pcoordDelta)
 {
+    if (_CollapseInvalidation())
+    {
+        return;
+    }
+
     FOREACH_ENGINE(pEngine)
     {
         LOG_IF_FAILED(pEngine->InvalidateScroll(pcoordDelta));
@@ -458,6 +740,12 @@ void Renderer::TriggerScroll(const COORD* const pcoordDelta)
 // - <none>
 void Renderer::TriggerCircling()
 {
+    // The rows moved, so the regions we remembered while hidden are stale.
+    if (_CollapseInvalidationWhileHidden())
+    {
+        return;
+    }
+
     const auto rects = _GetSelectionRects();
 
     FOREACH_ENGINE(pEngine)
@@ -466,7 +754,11 @@ void Renderer::TriggerCircling()
         HRESULT hr = pEngine->InvalidateCircling(&fEngineRequestsRepaint);
         LOG_IF_FAILED(hr);
 
-        LOG_IF_FAILED(pEngine->InvalidateSelection(rects));
+        // The selection didn't change, but the text under it moved.
+        for (const auto& rect : rects)
+        {
+            LOG_IF_FAILED(pEngine->Invalidate(&rect));
+        }
 
         if (SUCCEEDED(hr) && fEngineRequestsRepaint)
         {
@@ -674,6 +966,20 @@ void Renderer::_PaintBufferOutput(_In_ IRenderEngine* const pEngine)
         LOG_IF_FAILED(pEngine->ResetLineTransform());
     });
 
+    // Retrieve the text buffer so we can read information out of it.
+    const auto& buffer = _pData->GetTextBuffer();
+    const auto globalInvert = _pData->IsScreenReversed();
+
+    // First collect all the lines we need to paint, and which of them we need
+    // to (re)build, before we build them all at once and paint them in order.
+    _paintLines.clear();
+    _scratchBufferLines.clear();
+
+    // Which rows of the line cache have been used for a line of this frame already.
+    // A row might be painted twice, for instance if two dirty areas overlap it,
+    // in which case the second one can't reuse that row's cache entry.
+    _bufferLineCacheUsed.assign(_bufferLineCache.size(), false);
+
     for (const auto& dirtyRect : dirtyAreas)
     {
         // Shortcut: don't bother redrawing if the width is 0.
@@ -692,9 +998,7 @@ void Renderer::_PaintBufferOutput(_In_ IRenderEngine* const pEngine)
         // and what is supposed to be visible on the screen (the viewport) is what
         // we need to walk through line-by-line and repaint onto the screen.
         const auto redraw = Viewport::Intersect(dirty, view);
-
-        // Retrieve the text buffer so we can read information out of it.
-        const auto& buffer = _pData->GetTextBuffer();
+        _dirtyCells.fetch_add(gsl::narrow_cast<uint64_t>(redraw.Width()) * redraw.Height(), std::memory_order_relaxed);
 
         // Now walk through each row of text that we need to redraw.
         for (auto row = redraw.Top(); row < redraw.BottomExclusive(); row++)
@@ -703,35 +1007,112 @@ void Renderer::_PaintBufferOutput(_In_ IRenderEngine* const pEngine)
             // area in width and exactly 1 tall.
             const auto screenLine = SMALL_RECT{ redraw.Left(), row, redraw.RightInclusive(), row };
 
+            PaintLine paintLine;
+
             // Convert the screen coordinates of the line to an equivalent
             // range of buffer cells, taking line rendition into account.
-            const auto lineRendition = buffer.GetLineRendition(row);
-            const auto bufferLine = Viewport::FromInclusive(ScreenToBufferLine(screenLine, lineRendition));
+            paintLine.lineRendition = buffer.GetLineRendition(row);
+            paintLine.bufferLine = Viewport::FromInclusive(ScreenToBufferLine(screenLine, paintLine.lineRendition));
 
             // Find where on the screen we should place this line information. This requires us to re-map
             // the buffer-based origin of the line back onto the screen-based origin of the line.
             // For example, the screen might say we need to paint line 1 because it is dirty but the viewport
             // is actually looking at line 26 relative to the buffer. This means that we need line 27 out
             // of the backing buffer to fill in line 1 of the screen.
-            const auto screenPosition = bufferLine.Origin() - COORD{ 0, view.Top() };
+            paintLine.screenPosition = paintLine.bufferLine.Origin() - COORD{ 0, view.Top() };
 
-            // Retrieve the cell information iterator limited to just this line we want to redraw.
-            auto it = buffer.GetCellDataAt(bufferLine.Origin(), bufferLine);
+            const auto& bufferRow = buffer.GetRowByOffset(paintLine.bufferLine.Origin().Y);
+            paintLine.row = &bufferRow;
 
             // Calculate if two things are true:
             // 1. this row wrapped
             // 2. We're painting the last col of the row.
-            // In that case, set lineWrapped=true for the _PaintBufferOutputHelper call.
-            const auto lineWrapped = (buffer.GetRowByOffset(bufferLine.Origin().Y).WasWrapForced()) &&
-                                     (bufferLine.RightExclusive() == buffer.GetSize().Width());
+            // In that case, set lineWrapped=true for the _PaintBufferLine call.
+            paintLine.lineWrapped = bufferRow.WasWrapForced() &&
+                                    (paintLine.bufferLine.RightExclusive() == buffer.GetSize().Width());
+
+            // Find out if we've already got this line split into runs from painting it
+            // before, unchanged. A blinking cursor, a spinner or a clock in a TUI will
+            // invalidate whole lines of which only a single cell actually changed.
+            // Hovering a pattern changes the grid lines this depends on, so skip the cache then.
+            const auto cacheIndex = gsl::narrow_cast<size_t>(paintLine.screenPosition.Y);
+            if (_bufferLineCache.size() <= cacheIndex)
+            {
+                _bufferLineCache.resize(cacheIndex + 1);
+                _bufferLineCacheUsed.resize(cacheIndex + 1);
+            }
 
-            // Prepare the appropriate line transform for the current row and viewport offset.
-            LOG_IF_FAILED(pEngine->PrepareLineTransform(lineRendition, screenPosition.Y, view.Left()));
+            const auto cacheable = !_hoveredInterval.has_value() && !_bufferLineCacheUsed.at(cacheIndex);
+            if (cacheable)
+            {
+                _bufferLineCacheUsed.at(cacheIndex) = true;
+            }
+
+            auto& line = cacheable ? _bufferLineCache.at(cacheIndex) : _scratchBufferLines.emplace_back();
+            paintLine.line = &line;
+            paintLine.needsBuild = line.generation != bufferRow.GetGeneration() ||
+                                   line.bufferLine != paintLine.bufferLine.ToInclusive() ||
+                                   line.screenX != paintLine.screenPosition.X ||
+                                   line.globalInvert != globalInvert;
+            if (paintLine.needsBuild)
+            {
+                line.generation = cacheable ? bufferRow.GetGeneration() : 0;
+                line.bufferLine = paintLine.bufferLine.ToInclusive();
+                line.screenX = paintLine.screenPosition.X;
+                line.globalInvert = globalInvert;
+            }
 
-            // Ask the helper to paint through this specific line.
-            _PaintBufferOutputHelper(pEngine, it, screenPosition, lineWrapped);
+            _paintLines.push_back(paintLine);
         }
     }
+
+    // Building lines reads the buffer, but doesn't depend on any other line or on
+    // the engine, so the lines can be built independently of each other. For a
+    // full redraw of a dense screen that's most of the work of painting it.
+    // Exceptions mustn't escape a parallel algorithm, so a line that fails
+    // to build is logged and left empty instead.
+    const auto build = [&](const PaintLine& paintLine) noexcept {
+        if (paintLine.needsBuild)
+        {
+            try
+            {
+                // Build the line from just the part of its row that we want to redraw.
+                _BuildBufferLine(*paintLine.row,
+                                 gsl::narrow_cast<size_t>(paintLine.bufferLine.Left()),
+                                 gsl::narrow_cast<size_t>(paintLine.bufferLine.RightExclusive()),
+                                 paintLine.screenPosition,
+                                 *paintLine.line);
+            }
+            catch (...)
+            {
+                LOG_CAUGHT_EXCEPTION();
+                paintLine.line->generation = 0;
+                paintLine.line->runs.clear();
+            }
+        }
+    };
+
+    RenderPhaseTrace buildTrace{ "BuildLines" };
+    const auto buildCount = std::count_if(_paintLines.begin(), _paintLines.end(), [](const auto& paintLine) { return paintLine.needsBuild; });
+    if (gsl::narrow_cast<size_t>(buildCount) >= s_parallelBuildThreshold)
+    {
+        std::for_each(std::execution::par, _paintLines.begin(), _paintLines.end(), build);
+    }
+    else
+    {
+        std::for_each(_paintLines.begin(), _paintLines.end(), build);
+    }
+    buildTrace.Stop();
+
+    RenderPhaseTrace paintTrace{ "PaintLines" };
+    for (const auto& paintLine : _paintLines)
+    {
+        // Prepare the appropriate line transform for the current row and viewport offset.
+        LOG_IF_FAILED(pEngine->PrepareLineTransform(paintLine.lineRendition, paintLine.screenPosition.Y, view.Left()));
+
+        // Paint through this specific line.
+        _PaintBufferLine(pEngine, *paintLine.line, paintLine.screenPosition.Y, paintLine.lineWrapped);
+    }
 }
 
 static bool _IsAllSpaces(const std::wstring_view v)
@@ -741,83 +1122,108 @@ static bool _IsAllSpaces(const std::wstring_view v)
 }
 
 void Renderer::_PaintBufferOutputHelper(_In_ IRenderEngine* const pEngine,
-                                        TextBufferCellIterator it,
+                                        const ROW& row,
+                                        const size_t left,
+                                        const size_t right,
                                         const COORD target,
                                         const bool lineWrapped)
 {
+    _BuildBufferLine(row, left, right, target, _scratchBufferLine);
+    _scratchBufferLine.generation = 0;
+    _PaintBufferLine(pEngine, _scratchBufferLine, target.Y, lineWrapped);
+}
+
+// Routine Description:
+// - Walks through the cells of one line and splits them into the runs of
+//   clusters that will be painted together. A new run starts wherever the
+//   color, the pattern or the use of the soft font changes.
+// - The cells are read straight from the row: the attributes one ATTR_ROW
+//   run at a time and the glyphs from its CharRow.
+// Arguments:
+// - row - the row of the buffer the line is part of
+// - left - the first column of the line
+// - right - the column past the last one of the line
+// - target - the screen position the line is painted at
+// - line - receives the runs and clusters of the line
+// Return Value:
+// - <none>
+void Renderer::_BuildBufferLine(const ROW& row, const size_t left, const size_t right, const COORD target, BufferLine& line) const
+{
+    line.text.clear();
+    line.clusters.clear();
+    line.runs.clear();
+    line.cellAttrs.clear();
+
     auto globalInvert{ _pData->IsScreenReversed() };
 
+    const auto& charRow = row.GetCharRow();
+    const auto end = std::min(right, row.size());
+
     // If we have valid data, let's figure out how to draw it.
-    if (it)
+    if (left < end)
     {
-        // TODO: MSFT: 20961091 -  This is a perf issue. Instead of rebuilding this and allocing memory to hold the reinterpretation,
-        // we should have an iterator/view adapter for the rendering.
-        // That would probably also eliminate the RenderData needing to give us the entire TextBuffer as well...
-        // Retrieve the iterator for one line of information.
         size_t cols = 0;
+        auto column = left;
+        TextBufferRunIterator attrRun{ row, left, end };
 
         // Retrieve the first color.
-        auto color = it->TextAttr();
+        auto color = attrRun.TextAttr();
         // Retrieve the first pattern id
         auto patternIds = _pData->GetPatternId(target);
         // Determine whether we're using a soft font.
-        auto usingSoftFont = s_IsSoftFontChar(it->Chars(), _firstSoftFontChar, _lastSoftFontChar);
+        auto usingSoftFont = s_IsSoftFontChar(charRow.GlyphAt(column), _firstSoftFontChar, _lastSoftFontChar);
 
         // And hold the point where we should start drawing.
         auto screenPoint = target;
 
         // This outer loop will continue until we reach the end of the text we are trying to draw.
-        while (it)
+        while (column < end)
         {
+            BufferLineRun run;
+
             // Hold onto the current run color right here for the length of the outer loop.
             // We'll be changing the persistent one as we run through the inner loops to detect
-            // when a run changes, but we will still need to know this color at the bottom
-            // when we go to draw gridlines for the length of the run.
-            const auto currentRunColor = color;
-
-            // Hold onto the current pattern id as well
-            const auto currentPatternId = patternIds;
-
-            // Update the drawing brushes with our color and font usage.
-            THROW_IF_FAILED(_UpdateDrawingBrushes(pEngine, currentRunColor, usingSoftFont, false));
+            // when a run changes, but we will still need to know this color when we go
+            // to draw gridlines for the length of the run.
+            run.attr = color;
+            run.usingSoftFont = usingSoftFont;
 
             // Advance the point by however many columns we've just outputted and reset the accumulator.
             screenPoint.X += gsl::narrow<SHORT>(cols);
             cols = 0;
 
-            // Hold onto the start of this run iterator and the target location where we started
+            // Hold onto the column this run starts at and the target location where we started
             // in case we need to do some special work to paint the line drawing characters.
-            const auto currentRunItStart = it;
-            const auto currentRunTargetStart = screenPoint;
-
-            // Ensure that our cluster vector is clear.
-            _clusterBuffer.clear();
-
-            // Reset our flag to know when we're in the special circumstance
-            // of attempting to draw only the right-half of a two-column character
-            // as the first item in our run.
-            bool trimLeft = false;
+            const auto runStartColumn = column;
+            run.cellX = screenPoint.X;
 
-            // Run contains wide character (>1 columns)
-            bool containsWideCharacter = false;
+            const auto clustersBegin = line.clusters.size();
 
             // This inner loop will accumulate clusters until the color changes.
             // When the color changes, it will save the new color off and break.
             // We also accumulate clusters according to regex patterns
             do
             {
+                // The attribute only needs to be fetched again once we leave its run.
+                while (column >= attrRun.Right())
+                {
+                    ++attrRun;
+                }
+                const auto& attr = attrRun.TextAttr();
+                const std::wstring_view chars = charRow.GlyphAt(column);
+                const auto& dbcsAttr = charRow.DbcsAttrAt(column);
+
                 COORD thisPoint{ screenPoint.X + gsl::narrow<SHORT>(cols), screenPoint.Y };
                 const auto thisPointPatterns = _pData->GetPatternId(thisPoint);
-                const auto thisUsingSoftFont = s_IsSoftFontChar(it->Chars(), _firstSoftFontChar, _lastSoftFontChar);
+                const auto thisUsingSoftFont = s_IsSoftFontChar(chars, _firstSoftFontChar, _lastSoftFontChar);
                 const auto changedPatternOrFont = patternIds != thisPointPatterns || usingSoftFont != thisUsingSoftFont;
-                if (color != it->TextAttr() || changedPatternOrFont)
+                if (color != attr || changedPatternOrFont)
                 {
-                    auto newAttr{ it->TextAttr() };
                     // foreground doesn't matter for runs of spaces (!)
                     // if we trick it . . . we call Paint far fewer times for cmatrix
-                    if (!_IsAllSpaces(it->Chars()) || !newAttr.HasIdenticalVisualRepresentationForBlankSpace(color, globalInvert) || changedPatternOrFont)
+                    if (!_IsAllSpaces(chars) || !attr.HasIdenticalVisualRepresentationForBlankSpace(color, globalInvert) || changedPatternOrFont)
                     {
-                        color = newAttr;
+                        color = attr;
                         patternIds = thisPointPatterns;
                         usingSoftFont = thisUsingSoftFont;
                         break; // vend this run
@@ -826,68 +1232,112 @@ void Renderer::_PaintBufferOutputHelper(_In_ IRenderEngine* const pEngine,
 
                 // Walk through the text data and turn it into rendering clusters.
                 // Keep the columnCount as we go to improve performance over digging it out of the vector at the end.
-                size_t columnCount = it->Columns();
+                const size_t cellColumns = dbcsAttr.IsLeading() ? 2 : 1;
+                auto columnCount = cellColumns;
 
                 // If we're on the first cluster to be added and it's marked as "trailing"
                 // (a.k.a. the right half of a two column character), then we need some special handling.
-                if (_clusterBuffer.empty() && it->DbcsAttr().IsTrailing())
+                if (line.clusters.size() == clustersBegin && dbcsAttr.IsTrailing())
                 {
                     // Move left to the one so the whole character can be struck correctly.
                     --screenPoint.X;
                     // And tell the next function to trim off the left half of it.
-                    trimLeft = true;
+                    run.trimLeft = true;
                     // And add one to the number of columns we expect it to take as we insert it.
                     ++columnCount;
                 }
 
                 if (columnCount > 1)
                 {
-                    containsWideCharacter = true;
+                    run.containsWideCharacter = true;
                 }
 
                 // Advance the cluster and column counts.
-                _clusterBuffer.emplace_back(it->Chars(), columnCount);
-                it += std::max<size_t>(it->Columns(), 1); // prevent infinite loop for no visible columns
+                line.clusters.push_back({ line.text.size(), chars.size(), columnCount });
+                line.text.append(chars);
+                column += cellColumns;
                 cols += columnCount;
 
-            } while (it);
-
-            // Do the painting.
-            THROW_IF_FAILED(pEngine->PaintBufferLine({ _clusterBuffer.data(), _clusterBuffer.size() }, screenPoint, trimLeft, lineWrapped));
-
-            // If we're allowed to do grid drawing, draw that now too (since it will be coupled with the color data)
-            // We're only allowed to draw the grid lines under certain circumstances.
-            if (_pData->IsGridLineDrawingAllowed())
+            } while (column < end);
+
+            run.x = screenPoint.X;
+            run.cols = cols;
+            run.clustersEnd = line.clusters.size();
+            run.cellAttrsBegin = line.cellAttrs.size();
+
+            // See GH: 803
+            // If we found a wide character while we looped above, it's possible we skipped over the right half
+            // attribute that could have contained different line information than the left half.
+            // We need to go through the attributes again to ensure we get the lines associated with each
+            // exact column. The code above will condense two-column characters into one, but it is possible
+            // (like with the IME) that the line drawing characters will vary from the left to right half
+            // of a wider character.
+            if (run.containsWideCharacter)
             {
-                // See GH: 803
-                // If we found a wide character while we looped above, it's possible we skipped over the right half
-                // attribute that could have contained different line information than the left half.
-                if (containsWideCharacter)
+                for (TextBufferRunIterator cellRun{ row, runStartColumn, std::min(runStartColumn + cols, end) }; cellRun; ++cellRun)
                 {
-                    // Start from the original position in this run.
-                    auto lineIt = currentRunItStart;
-                    // Start from the original target in this run.
-                    auto lineTarget = currentRunTargetStart;
-
-                    // We need to go through the iterators again to ensure we get the lines associated with each
-                    // exact column. The code above will condense two-column characters into one, but it is possible
-                    // (like with the IME) that the line drawing characters will vary from the left to right half
-                    // of a wider character.
-                    // We could theoretically pre-pass for this in the loop above to be more efficient about walking
-                    // the iterator, but I fear it would make the code even more confusing than it already is.
-                    // Do that in the future if some WPR trace points you to this spot as super bad.
-                    for (auto colsPainted = 0u; colsPainted < cols; ++colsPainted, ++lineIt, ++lineTarget.X)
-                    {
-                        auto lines = lineIt->TextAttr();
-                        _PaintBufferOutputGridLineHelper(pEngine, lines, 1, lineTarget);
-                    }
+                    line.cellAttrs.insert(line.cellAttrs.end(), cellRun.Right() - cellRun.Left(), cellRun.TextAttr());
                 }
-                else
+            }
+
+            line.runs.push_back(run);
+        }
+    }
+}
+
+// Routine Description:
+// - Paints the runs of a line that was split up by _BuildBufferLine.
+// Arguments:
+// - pEngine - the engine to paint with
+// - line - the line to paint
+// - y - the screen row to paint the line at
+// - lineWrapped - whether the line wrapped and we're painting its last column
+// Return Value:
+// - <none>
+void Renderer::_PaintBufferLine(_In_ IRenderEngine* const pEngine,
+                                const BufferLine& line,
+                                const SHORT y,
+                                const bool lineWrapped)
+{
+    auto clustersBegin = line.clusters.begin();
+
+    for (const auto& run : line.runs)
+    {
+        // Update the drawing brushes with our color and font usage.
+        THROW_IF_FAILED(_UpdateDrawingBrushes(pEngine, run.attr, run.usingSoftFont, false));
+
+        // Ensure that our cluster vector only holds this run's clusters.
+        _clusterBuffer.clear();
+
+        const auto clustersEnd = line.clusters.begin() + run.clustersEnd;
+        for (auto cluster = clustersBegin; cluster != clustersEnd; ++cluster)
+        {
+            _clusterBuffer.emplace_back(std::wstring_view{ line.text }.substr(cluster->textOffset, cluster->textLength), cluster->columns);
+        }
+        clustersBegin = clustersEnd;
+
+        // Do the painting.
+        THROW_IF_FAILED(pEngine->PaintBufferLine({ _clusterBuffer.data(), _clusterBuffer.size() }, { run.x, y }, run.trimLeft, lineWrapped));
+
+        // If we're allowed to do grid drawing, draw that now too (since it will be coupled with the color data)
+        // We're only allowed to draw the grid lines under certain circumstances.
+        if (_pData->IsGridLineDrawingAllowed())
+        {
+            if (run.containsWideCharacter)
+            {
+                // Draw the lines of each column on its own, see _BuildBufferLine.
+                COORD lineTarget{ run.cellX, y };
+                const auto cellAttrs = gsl::make_span(line.cellAttrs).subspan(run.cellAttrsBegin);
+                for (auto colsPainted = 0u; colsPainted < run.cols && colsPainted < cellAttrs.size(); ++colsPainted, ++lineTarget.X)
                 {
-                    // If nothing exciting is going on, draw the lines in bulk.
-                    _PaintBufferOutputGridLineHelper(pEngine, currentRunColor, cols, screenPoint);
+                    _PaintBufferOutputGridLineHelper(pEngine, cellAttrs[colsPainted], 1, lineTarget);
                 }
             }
+            else
+            {
+                // If nothing exciting is going on, draw the lines in bulk.
+                _PaintBufferOutputGridLineHelper(pEngine, run.attr, run.cols, { run.x, y });
+            }
         }
     }
 }
@@ -1132,9 +1582,11 @@ void Renderer::_PaintOverlay(IRenderEngine& engine,
                     const COORD target{ viewDirty.Left(), iRow };
                     const auto source = target - overlay.origin;
 
-                    auto it = overlay.buffer.GetCellLineDataAt(source);
+                    // Paint from the source position to the end of its row.
+                    THROW_HR_IF(E_INVALIDARG, !overlay.buffer.GetSize().IsInBounds(source));
+                    const auto& row = overlay.buffer.GetRowByOffset(source.Y);
 
-                    _PaintBufferOutputHelper(&engine, it, target, false);
+                    _PaintBufferOutputHelper(&engine, row, gsl::narrow_cast<size_t>(source.X), row.size(), target, false);
                 }
             }
         }
@@ -1292,6 +1744,109 @@ void Renderer::_ScrollPreviousSelection(const til::point delta)
     }
 }
 
+// Method Description:
+// - Restricts the given selection rectangles to the area that's currently
+//   presentable. Rectangles that end up empty are removed.
+// Arguments:
+// - rects - The exclusive selection rectangles, in viewport coordinates
+// Return Value:
+// - <none> - Updates the rectangles in place.
+void Renderer::_ClipSelectionToViewport(std::vector<SMALL_RECT>& rects) const
+{
+    // Make a viewport representing the coordinates that are currently presentable.
+    const til::rectangle viewport{ til::size{ _pData->GetViewport().Dimensions() } };
+
+    auto out = rects.begin();
+    for (const auto& sr : rects)
+    {
+        // Make the exclusive SMALL_RECT into a til::rectangle and intersect them.
+        til::rectangle rc{ Viewport::FromExclusive(sr).ToInclusive() };
+        rc &= viewport;
+
+        if (!rc.empty())
+        {
+            // Convert back into the exclusive SMALL_RECT and store in the vector.
+            *out++ = Viewport::FromInclusive(rc).ToExclusive();
+        }
+    }
+    rects.erase(out, rects.end());
+}
+
+// Method Description:
+// - Computes the cells that differ between two selections, as exclusive
+//   rectangles. Both selections are expected to be like the ones returned by
+//   _GetSelectionRects: one rectangle per row, sorted from top to bottom.
+//   If they aren't, both selections are returned in full.
+// Arguments:
+// - previous - The selection that was painted last
+// - current - The selection that is about to be painted
+// Return Value:
+// - The rectangles that need to be invalidated.
+std::vector<SMALL_RECT> Renderer::_GetSelectionDelta(const std::vector<SMALL_RECT>& previous, const std::vector<SMALL_RECT>& current)
+{
+    const auto isOneRowPerRect = [](const std::vector<SMALL_RECT>& rects) {
+        for (size_t i = 0; i < rects.size(); ++i)
+        {
+            const auto& rect = til::at(rects, i);
+            if (rect.Bottom != rect.Top + 1 || (i != 0 && til::at(rects, i - 1).Top >= rect.Top))
+            {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    std::vector<SMALL_RECT> delta;
+    if (!isOneRowPerRect(previous) || !isOneRowPerRect(current))
+    {
+        delta.reserve(previous.size() + current.size());
+        delta.insert(delta.end(), previous.begin(), previous.end());
+        delta.insert(delta.end(), current.begin(), current.end());
+        return delta;
+    }
+
+    auto prev = previous.begin();
+    auto curr = current.begin();
+    while (prev != previous.end() || curr != current.end())
+    {
+        // Rows that are only selected in one of the two changed in full.
+        if (curr == current.end() || (prev != previous.end() && prev->Top < curr->Top))
+        {
+            delta.emplace_back(*prev++);
+            continue;
+        }
+        if (prev == previous.end() || curr->Top < prev->Top)
+        {
+            delta.emplace_back(*curr++);
+            continue;
+        }
+
+        // The row is selected in both. What changed are the cells between
+        // the two left edges and between the two right edges.
+        const auto top = curr->Top;
+        const auto bottom = curr->Bottom;
+        if (prev->Right <= curr->Left || curr->Right <= prev->Left)
+        {
+            delta.emplace_back(*prev);
+            delta.emplace_back(*curr);
+        }
+        else
+        {
+            if (prev->Left != curr->Left)
+            {
+                delta.emplace_back(SMALL_RECT{ std::min(prev->Left, curr->Left), top, std::max(prev->Left, curr->Left), bottom });
+            }
+            if (prev->Right != curr->Right)
+            {
+                delta.emplace_back(SMALL_RECT{ std::min(prev->Right, curr->Right), top, std::max(prev->Right, curr->Right), bottom });
+            }
+        }
+        ++prev;
+        ++curr;
+    }
+    return delta;
+}
+
 // Method Description:
 // - Adds another Render engine to this renderer. Future rendering calls will
 //      also be sent to the new renderer.
@@ -1337,6 +1892,127 @@ void Renderer::ResetErrorStateAndResume()
     EnablePainting();
 }
 
+// Method Description:
+// - Tells the renderer whether what it draws can currently be seen at all,
+//   for instance because its tab isn't selected or its window is minimized.
+// - While hidden, no frames are painted and invalidations aren't passed on
+//   to the engines. The engines keep their swap chains and with them the
+//   last frame, so that it can be shown again right away. Once we're
+//   visible again, only the regions that changed in the meantime are
+//   redrawn on top of it. Everything is redrawn only if something changed
+//   that isn't a region of the buffer, like the viewport or the selection.
+// - The caller must hold the console lock, like for any of the Trigger* calls.
+// Arguments:
+// - visible: false to suspend painting, true to resume.
+// Return Value:
+// - <none>
+void Renderer::SetVisible(const bool visible)
+{
+    _hidden.store(!visible, std::memory_order_relaxed);
+
+    if (!visible)
+    {
+        return;
+    }
+
+    auto regions = std::exchange(_regionsInvalidatedWhileHidden, {});
+    auto cursors = std::exchange(_cursorsInvalidatedWhileHidden, {});
+
+    if (_invalidatedWhileHidden.exchange(false, std::memory_order_relaxed))
+    {
+        // The selection may have changed or scrolled while we weren't
+        // tracking it. This brings _previousSelection up to date.
+        TriggerSelection();
+        TriggerRedrawAll();
+    }
+    else
+    {
+        for (const auto& region : regions)
+        {
+            TriggerRedraw(region);
+        }
+        for (const auto& cursor : cursors)
+        {
+            TriggerRedrawCursor(&cursor);
+        }
+    }
+
+    // A frame may have been skipped while we were hidden, see PaintFrame.
+    _NotifyPaintFrame();
+}
+
+// Routine Description:
+// - Enters or leaves the throughput mode, which is meant for floods of
+//   output, where computing the invalid regions chunk by chunk costs more
+//   than just redrawing the screen. In this mode, invalidations aren't passed
+//   on to the engines. Instead, a frame is requested and it redraws the
+//   whole viewport, at a reduced frame rate. This way the text is parsed as
+//   fast as it arrives and only the latest state of the viewport gets painted.
+// - The caller must hold the console lock, like for any of the Trigger* calls.
+// Arguments:
+// - enabled: true to enter the throughput mode, false to leave it.
+// Return Value:
+// - <none>
+void Renderer::SetThroughputMode(const bool enabled)
+{
+    if (_throughputMode.exchange(enabled, std::memory_order_relaxed) == enabled)
+    {
+        return;
+    }
+
+    _UpdateFrameRate();
+
+    if (!enabled)
+    {
+        // Like after being hidden, the selection may have changed or
+        // scrolled while we weren't tracking it.
+        TriggerSelection();
+        TriggerRedrawAll();
+    }
+}
+
+// Routine Description:
+// - Tells the renderer whether the user is interacting with what it draws.
+//   An unfocused renderer paints at a reduced frame rate and its thread runs
+//   at a lower priority with power throttling (EcoQoS), so that a busy
+//   background pane doesn't compete with the focused one for the fast cores.
+//   A focused renderer gets a higher priority instead.
+// Arguments:
+// - focused: true if the user is interacting with what we draw.
+// Return Value:
+// - <none>
+void Renderer::SetFocused(const bool focused)
+{
+    if (_focused.exchange(focused, std::memory_order_relaxed) == focused)
+    {
+        return;
+    }
+
+    _pThread->SetSchedulingPolicy(focused ? Microsoft::Console::Utils::ThreadSchedulingPolicy::Foreground : Microsoft::Console::Utils::ThreadSchedulingPolicy::Background);
+    _UpdateFrameRate();
+}
+
+// Routine Description:
+// - Applies the lowest of the frame rates that the throughput mode and
+//   the focus call for, or the refresh rate of the display if neither does.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void Renderer::_UpdateFrameRate()
+{
+    auto frameRate = 0u;
+    if (_throughputMode.load(std::memory_order_relaxed))
+    {
+        frameRate = s_throughputModeFrameRate;
+    }
+    if (!_focused.load(std::memory_order_relaxed))
+    {
+        frameRate = frameRate ? std::min(frameRate, s_unfocusedFrameRate) : s_unfocusedFrameRate;
+    }
+    _pThread->SetFrameRate(frameRate);
+}
+
 void Renderer::UpdateLastHoveredInterval(const std::optional<PointTree::interval>& newInterval)
 {
     _hoveredInterval = newInterval;
@@ -53,6 +53,7 @@ namespace Microsoft::Console::Render
         void TriggerRedrawCursor(const COORD* const pcoord) override;
         void TriggerRedrawAll() override;
         void TriggerTeardown() noexcept override;
+        void TriggerShutdown() noexcept override;
 
         void TriggerSelection() override;
         void TriggerScroll() override;
@@ -86,16 +87,100 @@ namespace Microsoft::Console::Render
 
         void UpdateLastHoveredInterval(const std::optional<interval_tree::IntervalTree<til::point, size_t>::interval>& newInterval);
 
+        void SetVisible(const bool visible);
+        void SetThroughputMode(const bool enabled);
+        void SetFocused(const bool focused);
+
+        // A frame counts once, no matter how many engines painted it.
+        // The dirty cells are summed over all engines.
+        struct FrameCounters
+        {
+            uint64_t frames = 0;
+            uint64_t paintMicroseconds = 0;
+            uint64_t dirtyCells = 0;
+        };
+        FrameCounters GetFrameCounters() const noexcept;
+
     private:
+        // A run of clusters within a BufferLine that is painted with the same attributes.
+        struct BufferLineRun
+        {
+            TextAttribute attr;
+            bool usingSoftFont = false;
+            bool trimLeft = false;
+            bool containsWideCharacter = false;
+            // The column the run's clusters are painted at and the column its
+            // cells start at. These differ if it starts with a trailing half.
+            SHORT x = 0;
+            SHORT cellX = 0;
+            size_t cols = 0;
+            size_t clustersEnd = 0;
+            size_t cellAttrsBegin = 0;
+        };
+
+        struct BufferLineCluster
+        {
+            size_t textOffset;
+            size_t textLength;
+            size_t columns;
+        };
+
+        // One line of the text buffer, split into runs and clusters, ready to be painted.
+        // It owns a copy of the text, so that it may be kept around after painting.
+        struct BufferLine
+        {
+            // What the line was built from. A generation of 0 means it wasn't built from a row.
+            uint64_t generation = 0;
+            SMALL_RECT bufferLine{};
+            SHORT screenX = 0;
+            bool globalInvert = false;
+
+            std::wstring text;
+            std::vector<BufferLineCluster> clusters;
+            std::vector<BufferLineRun> runs;
+            // The attributes of every cell of runs that contain wide characters, for grid lines.
+            std::vector<TextAttribute> cellAttrs;
+        };
+
+        // A line of the dirty area, as collected by _PaintBufferOutput.
+        struct PaintLine
+        {
+            Microsoft::Console::Types::Viewport bufferLine;
+            COORD screenPosition{};
+            LineRendition lineRendition = LineRendition::SingleWidth;
+            bool lineWrapped = false;
+            bool needsBuild = false;
+            const ROW* row = nullptr;
+            BufferLine* line = nullptr;
+        };
+
+        // The frame rate we paint at in throughput mode, see SetThroughputMode.
+        static constexpr unsigned int s_throughputModeFrameRate = 30;
+        // The most regions we remember while hidden, before we give up and
+        // redraw everything once we're visible again, see SetVisible.
+        static constexpr size_t s_maxRegionsInvalidatedWhileHidden = 256;
+        // The frame rate we paint at while unfocused, see SetFocused.
+        static constexpr unsigned int s_unfocusedFrameRate = 30;
+
+        // The number of lines that need to be built in a frame, from which on we build them in parallel.
+        static constexpr size_t s_parallelBuildThreshold = 4;
+
         static IRenderEngine::GridLines s_GetGridlines(const TextAttribute& textAttribute) noexcept;
         static bool s_IsSoftFontChar(const std::wstring_view& v, const size_t firstSoftFontChar, const size_t lastSoftFontChar);
 
         void _NotifyPaintFrame();
+        void _UpdateFrameRate();
+        bool _CollapseInvalidationWhileHidden() noexcept;
+        bool _CollapseRegionWhileHidden(const Microsoft::Console::Types::Viewport& region);
+        bool _CollapseCursorWhileHidden(const COORD coord);
+        bool _CollapseInvalidation();
         [[nodiscard]] HRESULT _PaintFrameForEngine(_In_ IRenderEngine* const pEngine) noexcept;
         bool _CheckViewportAndScroll();
         [[nodiscard]] HRESULT _PaintBackground(_In_ IRenderEngine* const pEngine);
         void _PaintBufferOutput(_In_ IRenderEngine* const pEngine);
-        void _PaintBufferOutputHelper(_In_ IRenderEngine* const pEngine, TextBufferCellIterator it, const COORD target, const bool lineWrapped);
+        void _PaintBufferOutputHelper(_In_ IRenderEngine* const pEngine, const ROW& row, const size_t left, const size_t right, const COORD target, const bool lineWrapped);
+        void _BuildBufferLine(const ROW& row, const size_t left, const size_t right, const COORD target, BufferLine& line) const;
+        void _PaintBufferLine(_In_ IRenderEngine* const pEngine, const BufferLine& line, const SHORT y, const bool lineWrapped);
         void _PaintBufferOutputGridLineHelper(_In_ IRenderEngine* const pEngine, const TextAttribute textAttribute, const size_t cchLine, const COORD coordTarget);
         void _PaintSelection(_In_ IRenderEngine* const pEngine);
         void _PaintCursor(_In_ IRenderEngine* const pEngine);
@@ -105,6 +190,8 @@ namespace Microsoft::Console::Render
         [[nodiscard]] HRESULT _PerformScrolling(_In_ IRenderEngine* const pEngine);
         std::vector<SMALL_RECT> _GetSelectionRects() const;
         void _ScrollPreviousSelection(const til::point delta);
+        void _ClipSelectionToViewport(std::vector<SMALL_RECT>& rects) const;
+        static std::vector<SMALL_RECT> _GetSelectionDelta(const std::vector<SMALL_RECT>& previous, const std::vector<SMALL_RECT>& current);
         [[nodiscard]] HRESULT _PaintTitle(IRenderEngine* const pEngine);
         [[nodiscard]] std::optional<CursorOptions> _GetCursorInfo();
         [[nodiscard]] HRESULT _PrepareRenderInfo(_In_ IRenderEngine* const pEngine);
@@ -117,12 +204,43 @@ namespace Microsoft::Console::Render
         std::optional<interval_tree::IntervalTree<til::point, size_t>::interval> _hoveredInterval;
         Microsoft::Console::Types::Viewport _viewport;
         std::vector<Cluster> _clusterBuffer;
+        // The lines last painted at each row of the screen. A row only needs to be
+        // walked cell by cell again if its ROW's generation changed since then.
+        std::vector<BufferLine> _bufferLineCache;
+        std::vector<bool> _bufferLineCacheUsed;
+        std::deque<BufferLine> _scratchBufferLines;
+        BufferLine _scratchBufferLine;
+        std::vector<PaintLine> _paintLines;
         std::vector<SMALL_RECT> _previousSelection;
         std::function<void()> _pfnRendererEnteredErrorState;
         bool _destructing = false;
+        // While hidden, the regions that got invalidated are only remembered.
+        // Anything that can't be expressed as a region of the buffer (or too
+        // many of them) sets _invalidatedWhileHidden instead, see SetVisible.
+        // The vectors are protected by the console lock, like the Trigger* calls.
+        std::atomic<bool> _hidden{ false };
+        std::atomic<bool> _invalidatedWhileHidden{ false };
+        std::vector<Microsoft::Console::Types::Viewport> _regionsInvalidatedWhileHidden;
+        std::vector<COORD> _cursorsInvalidatedWhileHidden;
+        // In throughput mode, invalidations only set _invalidatedInThroughputMode
+        // and the next frame redraws everything, see SetThroughputMode.
+        std::atomic<bool> _throughputMode{ false };
+        std::atomic<bool> _invalidatedInThroughputMode{ false };
+        // Whether the user is interacting with what we draw, see SetFocused.
+        // Starts out true, so that a renderer nobody tells about focus,
+        // like the one of conhost, keeps painting at the full rate.
+        std::atomic<bool> _focused{ true };
+        // Only used by the render thread.
+        bool _invalidateAllThisFrame = false;
+        // Only written by the render thread, with relaxed ordering. See GetFrameCounters.
+        bool _paintedThisFrame = false;
+        std::atomic<uint64_t> _frames{ 0 };
+        std::atomic<uint64_t> _paintMicroseconds{ 0 };
+        std::atomic<uint64_t> _dirtyCells{ 0 };
 
 #ifdef UNIT_TESTING
         friend class ConptyOutputTests;
+        friend class RendererTests;
 #endif
     };
 }
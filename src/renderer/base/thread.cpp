@@ -17,7 +17,9 @@ RenderThread::RenderThread() :
     _fKeepRunning(true),
     _hPaintEnabledEvent(nullptr),
     _fNextFrameRequested(false),
-    _fWaiting(false)
+    _fWaiting(false),
+    _fShutdown(false),
+    _frameRate(s_GetDisplayFrameRate())
 {
 }
 
@@ -25,9 +27,17 @@ RenderThread::~RenderThread()
 {
     if (_hThread)
     {
-        _fKeepRunning = false; // stop loop after final run
-        EnablePainting(); // if we want to get the last frame out, we need to make sure it's enabled
-        SignalObjectAndWait(_hEvent, _hThread, INFINITE, FALSE); // signal final paint and wait for thread to finish.
+        if (_fShutdown.load(std::memory_order_acquire))
+        {
+            // TriggerShutdown already told the thread to stop, without a final paint.
+            WaitForSingleObject(_hThread, INFINITE);
+        }
+        else
+        {
+            _fKeepRunning = false; // stop loop after final run
+            EnablePainting(); // if we want to get the last frame out, we need to make sure it's enabled
+            SignalObjectAndWait(_hEvent, _hThread, INFINITE, FALSE); // signal final paint and wait for thread to finish.
+        }
 
         CloseHandle(_hThread);
         _hThread = nullptr;
@@ -207,17 +217,32 @@ DWORD WINAPI RenderThread::_ThreadProc()
             ResetEvent(_hEvent);
         }
 
+        if (_fShutdown.load(std::memory_order_acquire))
+        {
+            break;
+        }
+
+        const auto frameStart = std::chrono::steady_clock::now();
+
         ResetEvent(_hPaintCompletedEvent);
 
+        // Engines that present to a swap chain block here until it's ready
+        // for another frame, which already paces us to the display.
         _pRenderer->WaitUntilCanRender();
         LOG_IF_FAILED(_pRenderer->PaintFrame());
 
         SetEvent(_hPaintCompletedEvent);
 
+        // Sleep for whatever is left of this frame's time slot, so that we don't
+        // paint faster than the display can show it. Any time spent waiting
+        // and painting above already counts towards it.
+        const auto frameInterval = std::chrono::microseconds{ 1'000'000 / _frameRate.load(std::memory_order_relaxed) };
+        const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(frameInterval - (std::chrono::steady_clock::now() - frameStart));
+
         // extra check before we sleep since it's a "long" activity, relatively speaking.
-        if (_fKeepRunning)
+        if (_fKeepRunning && remaining.count() > 0)
         {
-            Sleep(s_FrameLimitMilliseconds);
+            Sleep(gsl::narrow_cast<DWORD>(remaining.count()));
         }
     }
 
@@ -236,6 +261,79 @@ void RenderThread::NotifyPaint()
     }
 }
 
+// Method Description:
+// - Sets the highest rate at which frames will be painted, to match the
+//   refresh rate of the display (60, 120, 144, 240 Hz, ...).
+//   Nothing is painted while nothing is invalid, regardless of this rate.
+// Arguments:
+// - framesPerSecond: the frame rate to paint at, or 0 to go back to
+//      the refresh rate of the display.
+// Return Value:
+// - <none>
+void RenderThread::SetFrameRate(const unsigned int framesPerSecond) noexcept
+{
+    _frameRate.store(framesPerSecond ? framesPerSecond : s_GetDisplayFrameRate(), std::memory_order_relaxed);
+}
+
+// Method Description:
+// - Sets the priority and power throttling of the render thread, so that the
+//   frames of the control the user is typing into are painted first and
+//   the ones of the others are painted efficiently. See
+//   Utils::SetThreadSchedulingPolicy.
+// Arguments:
+// - policy: the policy to apply to the render thread.
+// Return Value:
+// - <none>
+void RenderThread::SetSchedulingPolicy(const Microsoft::Console::Utils::ThreadSchedulingPolicy policy) noexcept
+{
+    if (_hThread)
+    {
+        Microsoft::Console::Utils::SetThreadSchedulingPolicy(_hThread, policy);
+    }
+}
+
+// Method Description:
+// - Gets the refresh rate of the primary display.
+// Arguments:
+// - <none>
+// Return Value:
+// - The refresh rate in Hz, or s_DefaultFrameRate if it can't be determined.
+unsigned int RenderThread::s_GetDisplayFrameRate() noexcept
+{
+    DEVMODEW mode{};
+    mode.dmSize = sizeof(mode);
+
+    // A frequency of 0 or 1 stands for the hardware's default rate.
+    if (EnumDisplaySettingsW(nullptr, ENUM_CURRENT_SETTINGS, &mode) && mode.dmDisplayFrequency > 1)
+    {
+        return mode.dmDisplayFrequency;
+    }
+
+    return s_DefaultFrameRate;
+}
+
+// Method Description:
+// - Tells the thread to exit without painting another frame, but unlike the
+//   destructor doesn't wait for it to do so. A frame that's being painted
+//   right now is still finished. The destructor then only has to wait for
+//   the thread to exit, which it will by then most likely have done already.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void RenderThread::TriggerShutdown() noexcept
+{
+    if (!_hThread || _fShutdown.exchange(true, std::memory_order_acq_rel))
+    {
+        return;
+    }
+
+    _fKeepRunning = false;
+    // Wake the thread up, wherever it's waiting.
+    SetEvent(_hPaintEnabledEvent);
+    SetEvent(_hEvent);
+}
+
 void RenderThread::EnablePainting()
 {
     SetEvent(_hPaintEnabledEvent);
@@ -33,11 +33,18 @@ namespace Microsoft::Console::Render
         void DisablePainting() override;
         void WaitForPaintCompletionAndDisable(const DWORD dwTimeoutMs) override;
 
+        void SetFrameRate(const unsigned int framesPerSecond) noexcept override;
+        void SetSchedulingPolicy(const Microsoft::Console::Utils::ThreadSchedulingPolicy policy) noexcept override;
+        void TriggerShutdown() noexcept override;
+
     private:
         static DWORD WINAPI s_ThreadProc(_In_ LPVOID lpParameter);
         DWORD WINAPI _ThreadProc();
 
-        static DWORD const s_FrameLimitMilliseconds = 8;
+        static unsigned int s_GetDisplayFrameRate() noexcept;
+
+        // Used when the refresh rate of the display can't be determined.
+        static constexpr unsigned int s_DefaultFrameRate = 120;
 
         HANDLE _hThread;
         HANDLE _hEvent;
@@ -50,5 +57,7 @@ namespace Microsoft::Console::Render
         bool _fKeepRunning;
         std::atomic<bool> _fNextFrameRequested;
         std::atomic<bool> _fWaiting;
+        std::atomic<bool> _fShutdown;
+        std::atomic<unsigned int> _frameRate;
     };
 }
@@ -162,14 +162,21 @@ try
     _formatInUse = _fontRenderData->TextFormatWithAttribute(weight, style, stretch).Get();
     _fontInUse = _fontRenderData->FontFaceWithAttribute(weight, style, stretch).Get();
 
-    RETURN_IF_FAILED(_AnalyzeTextComplexity());
-    RETURN_IF_FAILED(_AnalyzeRuns());
-    RETURN_IF_FAILED(_ShapeGlyphRuns());
-    RETURN_IF_FAILED(_CorrectGlyphRuns());
-    // Correcting box drawing has to come after both font fallback and
-    // the glyph run advance correction (which will apply a font size scaling factor).
-    // We need to know all the proposed X and Y dimension metrics to get this right.
-    RETURN_IF_FAILED(_CorrectBoxDrawing());
+    // If we've drawn this exact text with this font before, reuse those results
+    // instead of going through analysis and shaping all over again.
+    if (!_RestoreShapedText())
+    {
+        RETURN_IF_FAILED(_AnalyzeTextComplexity());
+        RETURN_IF_FAILED(_AnalyzeRuns());
+        RETURN_IF_FAILED(_ShapeGlyphRuns());
+        RETURN_IF_FAILED(_CorrectGlyphRuns());
+        // Correcting box drawing has to come after both font fallback and
+        // the glyph run advance correction (which will apply a font size scaling factor).
+        // We need to know all the proposed X and Y dimension metrics to get this right.
+        RETURN_IF_FAILED(_CorrectBoxDrawing());
+
+        _StoreShapedText();
+    }
 
     RETURN_IF_FAILED(_DrawGlyphRuns(clientDrawingContext, renderer, { originX, originY }));
 
@@ -986,6 +993,93 @@ CATCH_RETURN();
     return S_OK;
 }
 
+// Routine Description:
+// - Looks up the current text and font in the cache of previously shaped text.
+//   If found, the glyph runs are restored from it, just as if the text had
+//   been analyzed and shaped right now.
+// Arguments:
+// - <none> - Uses internal state
+// Return Value:
+// - true if the glyph runs were restored from the cache.
+bool CustomTextLayout::_RestoreShapedText()
+{
+    const auto it = _shapedTextMap.find({ _text, _textClusterColumns, _fontInUse });
+    if (it == _shapedTextMap.end())
+    {
+        return false;
+    }
+
+    // Move the entry to the front, as it's now the most recently used one.
+    _shapedTexts.splice(_shapedTexts.begin(), _shapedTexts, it->second);
+
+    const auto& shaped = *it->second;
+    _runs = shaped.runs;
+    _glyphOffsets = shaped.glyphOffsets;
+    _glyphClusters = shaped.glyphClusters;
+    _glyphIndices = shaped.glyphIndices;
+    _glyphAdvances = shaped.glyphAdvances;
+    return true;
+}
+
+// Routine Description:
+// - Stores the glyph runs of the current text and font in the cache of
+//   previously shaped text, evicting the least recently used entry if it's full.
+// Arguments:
+// - <none> - Uses internal state
+// Return Value:
+// - <none>
+void CustomTextLayout::_StoreShapedText()
+{
+    if (_shapedTexts.size() >= s_shapedTextCacheSize)
+    {
+        _shapedTextMap.erase(_shapedTexts.back().Key());
+        _shapedTexts.pop_back();
+    }
+
+    _shapedTexts.push_front({ _text, _textClusterColumns, _fontInUse, _runs, _glyphOffsets, _glyphClusters, _glyphIndices, _glyphAdvances });
+
+    try
+    {
+        _shapedTextMap.emplace(_shapedTexts.front().Key(), _shapedTexts.begin());
+    }
+    catch (...)
+    {
+        _shapedTexts.pop_front();
+        throw;
+    }
+}
+
+// Routine Description:
+// - Adds up the memory held by the cache of previously shaped text. The nodes
+//   of the list and the map are estimated as the value plus two pointers.
+// Arguments:
+// - <none> - Uses internal state
+// Return Value:
+// - The number of bytes
+size_t CustomTextLayout::ShapedTextCacheMemoryUsage() const noexcept
+{
+    const auto vectorBytes = [](const auto& vector) noexcept {
+        return vector.capacity() * sizeof(vector[0]);
+    };
+
+    size_t bytes = 0;
+    for (const auto& shaped : _shapedTexts)
+    {
+        bytes += sizeof(shaped) + 2 * sizeof(void*);
+        bytes += (shaped.text.capacity() + 1) * sizeof(wchar_t);
+        bytes += vectorBytes(shaped.textClusterColumns);
+        bytes += vectorBytes(shaped.runs);
+        bytes += vectorBytes(shaped.glyphOffsets);
+        bytes += vectorBytes(shaped.glyphClusters);
+        bytes += vectorBytes(shaped.glyphIndices);
+        bytes += vectorBytes(shaped.glyphAdvances);
+    }
+
+    bytes += _shapedTextMap.size() * (sizeof(decltype(_shapedTextMap)::value_type) + 2 * sizeof(void*));
+    bytes += _shapedTextMap.bucket_count() * sizeof(void*);
+    return bytes;
+}
+
 // Routine Description:
 // - Estimates the maximum number of glyph indices needed to hold a string of
 //   a given length.  This is the formula given in the Uniscribe SDK and should
@@ -1251,42 +1345,41 @@ CATCH_RETURN();
 {
     try
     {
-        // Get the font fallback first
-        ::Microsoft::WRL::ComPtr<IDWriteTextFormat1> format1;
-        if (FAILED(_formatInUse->QueryInterface(IID_PPV_ARGS(&format1))))
+        const auto fontFallback = _fontRenderData->FontFallbackForFormat(_formatInUse);
+        if (!fontFallback)
         {
             // If IDWriteTextFormat1 does not exist, return directly as this OS version doesn't have font fallback.
             return S_FALSE;
         }
-        RETURN_HR_IF_NULL(E_NOINTERFACE, format1);
-
-        ::Microsoft::WRL::ComPtr<IDWriteFontFallback> fallback;
-        RETURN_IF_FAILED(format1->GetFontFallback(&fallback));
-
-        ::Microsoft::WRL::ComPtr<IDWriteFontCollection> collection;
-        RETURN_IF_FAILED(format1->GetFontCollection(&collection));
-
-        std::wstring familyName;
-        familyName.resize(gsl::narrow_cast<size_t>(format1->GetFontFamilyNameLength()) + 1);
-        RETURN_IF_FAILED(format1->GetFontFamilyName(familyName.data(), gsl::narrow<UINT32>(familyName.size())));
 
-        const auto weight = format1->GetFontWeight();
-        const auto style = format1->GetFontStyle();
-        const auto stretch = format1->GetFontStretch();
-
-        if (!fallback)
+        // If every codepoint of the text was mapped before, we can skip MapCharacters.
+        const WCHAR* text = nullptr;
+        UINT32 textAvailable = 0;
+        RETURN_IF_FAILED(source->GetTextAtPosition(textPosition, &text, &textAvailable));
+        if (!text || textAvailable < textLength)
+        {
+            text = nullptr;
+        }
+        else if (fontFallback->cache->Lookup({ text, textLength }, _fallbackRuns))
         {
-            fallback = _fontRenderData->SystemFontFallback();
+            for (const auto& run : _fallbackRuns)
+            {
+                RETURN_IF_FAILED(_SetMappedFontFace(textPosition, run.length, run.fontFace, run.scale));
+                textPosition += run.length;
+            }
+            return S_OK;
         }
 
-        ::Microsoft::WRL::ComPtr<IDWriteFontFallback1> fallback1;
-        ::Microsoft::WRL::ComPtr<IDWriteTextFormat3> format3;
+        const auto textStart = textPosition;
+        const auto rememberMapping = [&](const UINT32 mappedLength, const ::Microsoft::WRL::ComPtr<IDWriteFontFace>& face, const FLOAT scale) {
+            if (text)
+            {
+                fontFallback->cache->Insert({ text + (textPosition - textStart), mappedLength }, face, scale);
+            }
+        };
 
-        // If the OS supports IDWriteFontFallback1 and IDWriteTextFormat3, we can use the
-        // newer MapCharacters to apply axes of variation to the font
-        if (!FAILED(_formatInUse->QueryInterface(IID_PPV_ARGS(&format3))) && !FAILED(fallback->QueryInterface(IID_PPV_ARGS(&fallback1))))
+        if (fontFallback->fallback1)
         {
-            const auto axesVector = _fontRenderData->GetAxisVector(weight, stretch, style, format3.Get());
             // Walk through and analyze the entire string
             while (textLength > 0)
             {
@@ -1294,18 +1387,20 @@ CATCH_RETURN();
                 ::Microsoft::WRL::ComPtr<IDWriteFontFace5> mappedFont;
                 FLOAT scale = 0.0f;
 
-                fallback1->MapCharacters(source,
-                                         textPosition,
-                                         textLength,
-                                         collection.Get(),
-                                         familyName.data(),
-                                         axesVector.data(),
-                                         gsl::narrow<uint32_t>(axesVector.size()),
-                                         &mappedLength,
-                                         &scale,
-                                         &mappedFont);
-
-                RETURN_IF_FAILED(_SetMappedFontFace(textPosition, mappedLength, mappedFont, scale));
+                fontFallback->fallback1->MapCharacters(source,
+                                                       textPosition,
+                                                       textLength,
+                                                       fontFallback->collection.Get(),
+                                                       fontFallback->familyName.data(),
+                                                       fontFallback->axes.data(),
+                                                       gsl::narrow<uint32_t>(fontFallback->axes.size()),
+                                                       &mappedLength,
+                                                       &scale,
+                                                       &mappedFont);
+
+                const ::Microsoft::WRL::ComPtr<IDWriteFontFace> face{ mappedFont };
+                RETURN_IF_FAILED(_SetMappedFontFace(textPosition, mappedLength, face, scale));
+                rememberMapping(mappedLength, face, scale);
 
                 textPosition += mappedLength;
                 textLength -= mappedLength;
@@ -1324,22 +1419,23 @@ CATCH_RETURN();
                 ::Microsoft::WRL::ComPtr<IDWriteFont> mappedFont;
                 FLOAT scale = 0.0f;
 
-                fallback->MapCharacters(source,
-                                        textPosition,
-                                        textLength,
-                                        collection.Get(),
-                                        familyName.data(),
-                                        weight,
-                                        style,
-                                        stretch,
-                                        &mappedLength,
-                                        &mappedFont,
-                                        &scale);
+                fontFallback->fallback->MapCharacters(source,
+                                                      textPosition,
+                                                      textLength,
+                                                      fontFallback->collection.Get(),
+                                                      fontFallback->familyName.data(),
+                                                      fontFallback->weight,
+                                                      fontFallback->style,
+                                                      fontFallback->stretch,
+                                                      &mappedLength,
+                                                      &mappedFont,
+                                                      &scale);
 
                 RETURN_LAST_ERROR_IF(!mappedFont);
                 ::Microsoft::WRL::ComPtr<IDWriteFontFace> face;
                 RETURN_IF_FAILED(mappedFont->CreateFontFace(&face));
                 RETURN_IF_FAILED(_SetMappedFontFace(textPosition, mappedLength, face, scale));
+                rememberMapping(mappedLength, face, scale);
 
                 textPosition += mappedLength;
                 textLength -= mappedLength;
@@ -29,6 +29,9 @@ namespace Microsoft::Console::Render
 
         [[nodiscard]] HRESULT STDMETHODCALLTYPE GetColumns(_Out_ UINT32* columns);
 
+        // The number of bytes held by the cache of shaped text.
+        size_t ShapedTextCacheMemoryUsage() const noexcept;
+
         // IDWriteTextLayout methods (but we don't actually want to implement them all, so just this one matching the existing interface)
         [[nodiscard]] HRESULT STDMETHODCALLTYPE Draw(_In_opt_ void* clientDrawingContext,
                                                      _In_ IDWriteTextRenderer* renderer,
@@ -148,6 +151,13 @@ namespace Microsoft::Console::Render
 
         [[nodiscard]] static constexpr UINT32 _EstimateGlyphCount(const UINT32 textLength) noexcept;
 
+        bool _RestoreShapedText();
+        void _StoreShapedText();
+
+        // The number of shaped lines (or rather attribute runs of lines) we keep around.
+        // This needs to cover a few full viewports, as every line is made of one or more runs.
+        static constexpr size_t s_shapedTextCacheSize = 1024;
+
     private:
         // DirectWrite font render data
         DxFontRenderData* _fontRenderData;
@@ -172,6 +182,9 @@ namespace Microsoft::Console::Render
         std::vector<LinkedRun> _runs;
         std::vector<DWRITE_LINE_BREAKPOINT> _breakpoints;
 
+        // Scratch space for the runs font fallback results are restored from.
+        std::vector<FontFallbackCache::Run> _fallbackRuns;
+
         // Text analysis interim status variable (to assist the Analyzer Sink in operations involving _runs)
         UINT32 _runIndex;
 
@@ -206,6 +219,56 @@ namespace Microsoft::Console::Render
         // These are used to further break the runs apart and adjust the font size so glyphs fit inside the cells.
         std::vector<ScaleCorrection> _glyphScaleCorrections;
 
+        // Text and font face a layout was computed for.
+        struct ShapedTextKey
+        {
+            std::wstring_view text;
+            gsl::span<const UINT16> textClusterColumns;
+            IDWriteFontFace1* fontFace;
+
+            bool operator==(const ShapedTextKey& other) const noexcept
+            {
+                return fontFace == other.fontFace &&
+                       text == other.text &&
+                       std::equal(textClusterColumns.begin(), textClusterColumns.end(), other.textClusterColumns.begin(), other.textClusterColumns.end());
+            }
+        };
+
+        struct ShapedTextKeyHash
+        {
+            size_t operator()(const ShapedTextKey& key) const noexcept
+            {
+                const auto hash = std::hash<std::wstring_view>{}(key.text);
+                return hash ^ (std::hash<const void*>{}(key.fontFace) + 0x9e3779b9 + (hash << 6) + (hash >> 2));
+            }
+        };
+
+        // The results of analyzing and shaping a line of text, everything that's needed to draw it again.
+        struct ShapedText
+        {
+            std::wstring text;
+            std::vector<UINT16> textClusterColumns;
+            IDWriteFontFace1* fontFace;
+
+            std::vector<LinkedRun> runs;
+            std::vector<DWRITE_GLYPH_OFFSET> glyphOffsets;
+            std::vector<UINT16> glyphClusters;
+            std::vector<UINT16> glyphIndices;
+            std::vector<float> glyphAdvances;
+
+            ShapedTextKey Key() const noexcept
+            {
+                return { text, textClusterColumns, fontFace };
+            }
+        };
+
+        // A cache of the most recently drawn lines, as repainting a line that hasn't changed
+        // (during scrolling, cursor blinking, selection, ...) is a lot more common than not.
+        // The list is ordered from most to least recently used. It's cleared whenever the
+        // font changes, as the engine creates a new layout object then.
+        std::list<ShapedText> _shapedTexts;
+        std::unordered_map<ShapedTextKey, std::list<ShapedText>::iterator, ShapedTextKeyHash> _shapedTextMap;
+
 #ifdef UNIT_TESTING
     public:
         CustomTextLayout() = default;
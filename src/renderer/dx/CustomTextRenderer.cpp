@@ -13,6 +13,183 @@
 
 using namespace Microsoft::Console::Render;
 
+// The lines that make up the box drawing characters U+2500 to U+257F that consist
+// of nothing but straight light and heavy lines from the center of the cell outwards.
+// There are 2 bits per direction: left, up, right and down, from the lowest bits up.
+// Each is 0 for no line, 1 for a light and 2 for a heavy line. Characters with dashed,
+// double, arc or diagonal lines are 0 and left to the font.
+static constexpr std::array<uint8_t, 0x80> s_boxDrawingLines{
+        0x11, 0x22, 0x44, 0x88, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x50, 0x60, 0x90, 0xa0, // U+2500
+        0x41, 0x42, 0x81, 0x82, 0x14, 0x24, 0x18, 0x28, 0x05, 0x06, 0x09, 0x0a, 0x54, 0x64, 0x58, 0x94, // U+2510
+        0x98, 0x68, 0xa4, 0xa8, 0x45, 0x46, 0x49, 0x85, 0x89, 0x4a, 0x86, 0x8a, 0x51, 0x52, 0x61, 0x62, // U+2520
+        0x91, 0x92, 0xa1, 0xa2, 0x15, 0x16, 0x25, 0x26, 0x19, 0x1a, 0x29, 0x2a, 0x55, 0x56, 0x65, 0x66, // U+2530
+        0x59, 0x95, 0x99, 0x5a, 0x69, 0x96, 0xa5, 0x6a, 0xa6, 0x9a, 0xa9, 0xaa, 0x00, 0x00, 0x00, 0x00, // U+2540
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // U+2550
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // U+2560
+        0x00, 0x00, 0x00, 0x00, 0x01, 0x04, 0x10, 0x40, 0x02, 0x08, 0x20, 0x80, 0x21, 0x84, 0x12, 0x48, // U+2570
+};
+
+// Returns true if we draw the given character ourselves instead of using its glyph.
+static constexpr bool s_IsProceduralBoxCharacter(const wchar_t wch) noexcept
+{
+    if (wch >= 0x2500 && wch <= 0x257F)
+    {
+        return s_boxDrawingLines.at(wch - 0x2500) != 0;
+    }
+
+    // All of the block elements are made of rectangles and shades.
+    return wch >= 0x2580 && wch <= 0x259F;
+}
+
+// Routine Description:
+// - Draws a box drawing character or block element made of rectangles into the given
+//   cell, snapped to whole pixels so that adjacent cells line up seamlessly.
+// Arguments:
+// - target - the render target to draw on
+// - brush - the brush to fill with
+// - wch - the character to draw. Must satisfy s_IsProceduralBoxCharacter.
+// - cell - the area of the cell in pixels
+// Return Value:
+// - <none>
+static void s_DrawProceduralBoxCharacter(ID2D1RenderTarget* target, ID2D1SolidColorBrush* brush, const wchar_t wch, const D2D1_RECT_F cell) noexcept
+{
+    const auto left = std::round(cell.left);
+    const auto top = std::round(cell.top);
+    const auto right = std::round(cell.right);
+    const auto bottom = std::round(cell.bottom);
+    const auto width = right - left;
+    const auto height = bottom - top;
+
+    // Positions at a fraction of the width or height of the cell.
+    const auto atX = [&](const float fraction) noexcept { return left + std::round(width * fraction); };
+    const auto atY = [&](const float fraction) noexcept { return top + std::round(height * fraction); };
+
+    const auto fill = [&](const float l, const float t, const float r, const float b) noexcept {
+        target->FillRectangle(D2D1::RectF(l, t, r, b), brush);
+    };
+
+    if (wch <= 0x257F)
+    {
+        const auto lines = s_boxDrawingLines.at(wch - 0x2500);
+        const auto lineLeft = lines & 3u;
+        const auto lineUp = (lines >> 2) & 3u;
+        const auto lineRight = (lines >> 4) & 3u;
+        const auto lineDown = (lines >> 6) & 3u;
+
+        const auto light = std::max(1.0f, std::round(height / 16.0f));
+        const auto thickness = [&](const unsigned int line) noexcept {
+            return line == 0 ? 0.0f : line == 1 ? light : 2.0f * light;
+        };
+
+        // Lines of the given thickness, centered in the cell.
+        const auto centerX = [&](const float t) noexcept { return left + std::floor((width - t) / 2.0f); };
+        const auto centerY = [&](const float t) noexcept { return top + std::floor((height - t) / 2.0f); };
+
+        // Each line reaches up to the far side of the thickest line crossing
+        // its way, so that corners and junctions are filled in completely.
+        const auto horizontal = thickness(std::max(lineLeft, lineRight));
+        const auto vertical = thickness(std::max(lineUp, lineDown));
+        const auto midX = centerX(0.0f);
+        const auto midY = centerY(0.0f);
+
+        if (lineLeft)
+        {
+            const auto t = thickness(lineLeft);
+            fill(left, centerY(t), vertical ? centerX(vertical) + vertical : midX, centerY(t) + t);
+        }
+        if (lineRight)
+        {
+            const auto t = thickness(lineRight);
+            fill(vertical ? centerX(vertical) : midX, centerY(t), right, centerY(t) + t);
+        }
+        if (lineUp)
+        {
+            const auto t = thickness(lineUp);
+            fill(centerX(t), top, centerX(t) + t, horizontal ? centerY(horizontal) + horizontal : midY);
+        }
+        if (lineDown)
+        {
+            const auto t = thickness(lineDown);
+            fill(centerX(t), horizontal ? centerY(horizontal) : midY, centerX(t) + t, bottom);
+        }
+        return;
+    }
+
+    switch (wch)
+    {
+    case 0x2580: // upper half block
+        fill(left, top, right, atY(0.5f));
+        break;
+    case 0x2581: // lower one eighth block, up to
+    case 0x2582:
+    case 0x2583:
+    case 0x2584:
+    case 0x2585:
+    case 0x2586:
+    case 0x2587: // lower seven eighths block
+        fill(left, atY(1.0f - (wch - 0x2580) / 8.0f), right, bottom);
+        break;
+    case 0x2588: // full block
+        fill(left, top, right, bottom);
+        break;
+    case 0x2589: // left seven eighths block, down to
+    case 0x258A:
+    case 0x258B:
+    case 0x258C:
+    case 0x258D:
+    case 0x258E:
+    case 0x258F: // left one eighth block
+        fill(left, top, atX((0x2590 - wch) / 8.0f), bottom);
+        break;
+    case 0x2590: // right half block
+        fill(atX(0.5f), top, right, bottom);
+        break;
+    case 0x2591: // light shade
+    case 0x2592: // medium shade
+    case 0x2593: // dark shade
+    {
+        const auto opacity = brush->GetOpacity();
+        brush->SetOpacity(opacity * (wch - 0x2590) / 4.0f);
+        fill(left, top, right, bottom);
+        brush->SetOpacity(opacity);
+        break;
+    }
+    case 0x2594: // upper one eighth block
+        fill(left, top, right, atY(1.0f / 8.0f));
+        break;
+    case 0x2595: // right one eighth block
+        fill(atX(7.0f / 8.0f), top, right, bottom);
+        break;
+    default:
+    {
+        // The quadrants U+2596 to U+259F, as a set of upper left (1),
+        // upper right (2), lower left (4) and lower right (8) quadrants.
+        static constexpr std::array<uint8_t, 10> quadrants{ 4, 8, 1, 13, 9, 7, 11, 2, 6, 14 };
+        const auto set = quadrants.at(wch - 0x2596);
+        const auto midX = atX(0.5f);
+        const auto midY = atY(0.5f);
+
+        if (set & 1)
+        {
+            fill(left, top, midX, midY);
+        }
+        if (set & 2)
+        {
+            fill(midX, top, right, midY);
+        }
+        if (set & 4)
+        {
+            fill(left, midY, midX, bottom);
+        }
+        if (set & 8)
+        {
+            fill(midX, midY, right, bottom);
+        }
+        break;
+    }
+    }
+}
+
 #pragma region IDWritePixelSnapping methods
 // Routine Description:
 // - Implementation of IDWritePixelSnapping::IsPixelSnappingDisabled
@@ -534,8 +711,14 @@ CATCH_RETURN()
         _clipRect = clipRect;
     }
 
-    // Draw the background
-    // The rectangle needs to be deduced based on the origin and the BidiDirection
+    // Draw the background for the entire layout at once, instead of once per glyph run.
+    if (drawingContext->backgroundRect.has_value())
+    {
+        d2dContext->FillRectangle(drawingContext->backgroundRect.value(), drawingContext->backgroundBrush);
+        drawingContext->backgroundRect.reset();
+    }
+
+    // The rectangle of this glyph run needs to be deduced based on the origin and the BidiDirection
     const auto advancesSpan = gsl::make_span(glyphRun->glyphAdvances, glyphRun->glyphCount);
     const auto totalSpan = std::accumulate(advancesSpan.begin(), advancesSpan.end(), 0.0f);
 
@@ -550,8 +733,6 @@ CATCH_RETURN()
     }
     rect.right = rect.left + totalSpan;
 
-    d2dContext->FillRectangle(rect, drawingContext->backgroundBrush);
-
     RETURN_IF_FAILED(_drawCursor(d2dContext.Get(), rect, *drawingContext, true));
 
     // GH#5098: If we're rendering with cleartype text, we need to always render
@@ -785,6 +966,15 @@ CATCH_RETURN()
         ::Microsoft::WRL::ComPtr<IBoxDrawingEffect> boxEffect;
         if (SUCCEEDED(clientDrawingEffect->QueryInterface<IBoxDrawingEffect>(&boxEffect)))
         {
+            // Most box drawing characters are simple enough to draw as a few rectangles.
+            // That's far cheaper than filling their outlines and they line up perfectly.
+            const auto hr = _DrawBoxRunProcedurally(clientDrawingContext, baselineOrigin, glyphRun, glyphRunDescription);
+            RETURN_IF_FAILED(hr);
+            if (hr == S_OK)
+            {
+                return S_OK;
+            }
+
             return _DrawBoxRunManually(clientDrawingContext, baselineOrigin, measuringMode, glyphRun, glyphRunDescription, boxEffect.Get());
         }
 
@@ -918,6 +1108,57 @@ try
 }
 CATCH_RETURN();
 
+// Routine Description:
+// - Draws a run of box drawing characters and block elements as pixel-snapped
+//   rectangles, one per line or block, instead of filling their glyph outlines.
+// Arguments:
+// - clientDrawingContext - Pointer to structure of information required to draw
+// - baselineOrigin - The starting point of the run, on the baseline
+// - glyphRun - Information on the glyphs
+// - glyphRunDescription - Information on the text the glyphs were made from
+// Return Value:
+// - S_OK if the run was drawn, S_FALSE if it contains characters we
+//   can't draw this way, in which case nothing was drawn.
+[[nodiscard]] HRESULT CustomTextRenderer::_DrawBoxRunProcedurally(DrawingContext* clientDrawingContext,
+                                                                  D2D1_POINT_2F baselineOrigin,
+                                                                  _In_ const DWRITE_GLYPH_RUN* glyphRun,
+                                                                  _In_opt_ const DWRITE_GLYPH_RUN_DESCRIPTION* glyphRunDescription) noexcept
+try
+{
+    RETURN_HR_IF_NULL(E_INVALIDARG, clientDrawingContext);
+    RETURN_HR_IF_NULL(E_INVALIDARG, glyphRun);
+
+    // We need to map every glyph to exactly one character to know what to draw.
+    if (!glyphRunDescription || !glyphRunDescription->string ||
+        glyphRunDescription->stringLength != glyphRun->glyphCount ||
+        WI_IsFlagSet(glyphRun->bidiLevel, 1))
+    {
+        return S_FALSE;
+    }
+
+    // CustomTextLayout gives us its entire text, with the run starting at the text position.
+    const std::wstring_view text{ glyphRunDescription->string + glyphRunDescription->textPosition, glyphRunDescription->stringLength };
+    if (!std::all_of(text.begin(), text.end(), s_IsProceduralBoxCharacter))
+    {
+        return S_FALSE;
+    }
+
+    // The baseline origin is part way down the cell. The cell's top is where the ascent begins.
+    const auto top = baselineOrigin.y - clientDrawingContext->spacing.baseline;
+    const auto bottom = top + clientDrawingContext->cellSize.height;
+    auto x = baselineOrigin.x;
+
+    for (size_t i = 0; i < text.size(); ++i)
+    {
+        const auto advance = glyphRun->glyphAdvances[i];
+        s_DrawProceduralBoxCharacter(clientDrawingContext->renderTarget, clientDrawingContext->foregroundBrush, text[i], { x, top, x + advance, bottom });
+        x += advance;
+    }
+
+    return S_OK;
+}
+CATCH_RETURN();
+
 [[nodiscard]] HRESULT CustomTextRenderer::_DrawGlowGlyphRun(DrawingContext* clientDrawingContext,
                                                             D2D1_POINT_2F baselineOrigin,
                                                             DWRITE_MEASURING_MODE /*measuringMode*/,
@@ -48,6 +48,10 @@ namespace Microsoft::Console::Render
         D2D_SIZE_F targetSize;
         std::optional<CursorOptions> cursorInfo;
         D2D1_DRAW_TEXT_OPTIONS options;
+
+        // The background of all the glyph runs of the layout being drawn.
+        // It's filled in one go by the first glyph run and then reset.
+        std::optional<D2D1_RECT_F> backgroundRect;
     };
 
     // Helper to choose which Direct2D method to use when drawing the cursor rectangle
@@ -133,6 +137,11 @@ namespace Microsoft::Console::Render
                                                   _In_opt_ const DWRITE_GLYPH_RUN_DESCRIPTION* glyphRunDescription,
                                                   _In_ IBoxDrawingEffect* clientDrawingEffect) noexcept;
 
+        [[nodiscard]] HRESULT _DrawBoxRunProcedurally(DrawingContext* clientDrawingContext,
+                                                      D2D1_POINT_2F baselineOrigin,
+                                                      _In_ const DWRITE_GLYPH_RUN* glyphRun,
+                                                      _In_opt_ const DWRITE_GLYPH_RUN_DESCRIPTION* glyphRunDescription) noexcept;
+
         [[nodiscard]] HRESULT _DrawGlowGlyphRun(DrawingContext* clientDrawingContext,
                                                 D2D1_POINT_2F baselineOrigin,
                                                 DWRITE_MEASURING_MODE measuringMode,
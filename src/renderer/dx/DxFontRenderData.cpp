@@ -49,6 +49,61 @@ DxFontRenderData::DxFontRenderData(::Microsoft::WRL::ComPtr<IDWriteFactory1> dwr
     return _systemFontFallback;
 }
 
+// Routine Description:
+// - Gets the font fallback, font collection, family name, attributes and axes
+//   of a text format, along with the shared cache of the faces that fallback
+//   picked for them. They're computed once per format.
+// Arguments:
+// - format - One of the text formats returned by TextFormatWithAttribute.
+// Return Value:
+// - The font fallback setup, or nullptr if the OS version doesn't have font fallback.
+[[nodiscard]] const DxFontRenderData::FontFallback* DxFontRenderData::FontFallbackForFormat(IDWriteTextFormat* format)
+{
+    auto it = _fontFallbackMap.find(format);
+    if (it == _fontFallbackMap.end())
+    {
+        std::optional<FontFallback> fontFallback;
+
+        // If IDWriteTextFormat1 does not exist, this OS version doesn't have font fallback.
+        ::Microsoft::WRL::ComPtr<IDWriteTextFormat1> format1;
+        if (SUCCEEDED(format->QueryInterface(IID_PPV_ARGS(&format1))) && format1)
+        {
+            auto& ff = fontFallback.emplace();
+
+            THROW_IF_FAILED(format1->GetFontFallback(&ff.fallback));
+            if (!ff.fallback)
+            {
+                ff.fallback = SystemFontFallback();
+            }
+
+            THROW_IF_FAILED(format1->GetFontCollection(&ff.collection));
+
+            const auto familyNameLength = format1->GetFontFamilyNameLength();
+            ff.familyName.resize(gsl::narrow_cast<size_t>(familyNameLength) + 1);
+            THROW_IF_FAILED(format1->GetFontFamilyName(ff.familyName.data(), gsl::narrow<UINT32>(ff.familyName.size())));
+            ff.familyName.resize(familyNameLength);
+
+            ff.weight = format1->GetFontWeight();
+            ff.style = format1->GetFontStyle();
+            ff.stretch = format1->GetFontStretch();
+
+            // If the OS supports IDWriteFontFallback1 and IDWriteTextFormat3, we can use the
+            // newer MapCharacters to apply axes of variation to the font
+            ::Microsoft::WRL::ComPtr<IDWriteTextFormat3> format3;
+            if (SUCCEEDED(format->QueryInterface(IID_PPV_ARGS(&format3))) && SUCCEEDED(ff.fallback.As(&ff.fallback1)))
+            {
+                ff.axes = GetAxisVector(ff.weight, ff.stretch, ff.style, format3.Get());
+            }
+
+            ff.cache = FontFallbackCache::s_Get(ff.fallback.Get(), ff.collection.Get(), ff.familyName, ff.weight, ff.style, ff.stretch, ff.axes);
+        }
+
+        it = _fontFallbackMap.emplace(format, std::move(fontFallback)).first;
+    }
+
+    return it->second ? &*it->second : nullptr;
+}
+
 [[nodiscard]] std::wstring DxFontRenderData::UserLocaleName()
 {
     if (_userLocaleName.empty())
@@ -189,6 +244,7 @@ DxFontRenderData::DxFontRenderData(::Microsoft::WRL::ComPtr<IDWriteFactory1> dwr
     try
     {
         _userLocaleName.clear();
+        _fontFallbackMap.clear();
         _textFormatMap.clear();
         _fontFaceMap.clear();
         _boxDrawingEffect.Reset();
@@ -450,6 +506,28 @@ try
 }
 CATCH_RETURN()
 
+// Routine Description:
+// - Adds up the memory of the font fallback caches used by our text formats.
+//   Different formats may share a cache, which is only counted once.
+// Arguments:
+// - <none>
+// Return Value:
+// - The number of bytes
+size_t DxFontRenderData::FontFallbackCacheMemoryUsage() const
+{
+    std::vector<const FontFallbackCache*> counted;
+    size_t bytes = 0;
+    for (const auto& [format, fallback] : _fontFallbackMap)
+    {
+        if (fallback && fallback->cache && std::find(counted.begin(), counted.end(), fallback->cache.get()) == counted.end())
+        {
+            counted.emplace_back(fallback->cache.get());
+            bytes += fallback->cache->MemoryUsage();
+        }
+    }
+    return bytes;
+}
+
 // Routine Description:
 // - Returns whether the user set or updated any of the font features to be applied
 bool DxFontRenderData::DidUserSetFeatures() const noexcept
@@ -922,3 +1000,226 @@ Microsoft::WRL::ComPtr<IDWriteTextFormat> DxFontRenderData::_BuildTextFormat(con
 
     return format;
 }
+
+namespace
+{
+    // The caches of all DxFontRenderData instances, so that engines drawing the
+    // same font share what font fallback picked. The keys hold references to the
+    // fallback and collection, so that their pointers can't be reused.
+    struct FontFallbackCacheSlot
+    {
+        ::Microsoft::WRL::ComPtr<IDWriteFontFallback> fallback;
+        ::Microsoft::WRL::ComPtr<IDWriteFontCollection> collection;
+        std::wstring familyName;
+        DWRITE_FONT_WEIGHT weight;
+        DWRITE_FONT_STYLE style;
+        DWRITE_FONT_STRETCH stretch;
+        std::vector<DWRITE_FONT_AXIS_VALUE> axes;
+        std::shared_ptr<FontFallbackCache> cache;
+    };
+
+    std::mutex fontFallbackCacheSlotsMutex;
+    std::vector<FontFallbackCacheSlot> fontFallbackCacheSlots;
+}
+
+// Routine Description:
+// - Gets the cache shared by everyone who uses font fallback with the given parameters.
+// Arguments:
+// - fallback - The font fallback that's used for mapping.
+// - collection - The font collection the base family is taken from.
+// - familyName, weight, style, stretch, axes - The base font, as given to MapCharacters.
+// Return Value:
+// - The shared cache. Slots nobody else holds on to anymore are freed.
+[[nodiscard]] std::shared_ptr<FontFallbackCache> FontFallbackCache::s_Get(IDWriteFontFallback* fallback,
+                                                                          IDWriteFontCollection* collection,
+                                                                          const std::wstring_view familyName,
+                                                                          const DWRITE_FONT_WEIGHT weight,
+                                                                          const DWRITE_FONT_STYLE style,
+                                                                          const DWRITE_FONT_STRETCH stretch,
+                                                                          const gsl::span<const DWRITE_FONT_AXIS_VALUE> axes)
+{
+    const std::scoped_lock lock{ fontFallbackCacheSlotsMutex };
+
+    const auto sameAxes = [&](const std::vector<DWRITE_FONT_AXIS_VALUE>& other) {
+        return std::equal(axes.begin(), axes.end(), other.begin(), other.end(), [](const auto& a, const auto& b) {
+            return a.axisTag == b.axisTag && a.value == b.value;
+        });
+    };
+
+    for (const auto& slot : fontFallbackCacheSlots)
+    {
+        if (slot.fallback.Get() == fallback && slot.collection.Get() == collection && slot.familyName == familyName &&
+            slot.weight == weight && slot.style == style && slot.stretch == stretch && sameAxes(slot.axes))
+        {
+            return slot.cache;
+        }
+    }
+
+    fontFallbackCacheSlots.erase(std::remove_if(fontFallbackCacheSlots.begin(), fontFallbackCacheSlots.end(), [](const auto& slot) {
+                                     return slot.cache.use_count() == 1;
+                                 }),
+                                 fontFallbackCacheSlots.end());
+
+    auto& slot = fontFallbackCacheSlots.emplace_back();
+    slot.fallback = fallback;
+    slot.collection = collection;
+    slot.familyName = familyName;
+    slot.weight = weight;
+    slot.style = style;
+    slot.stretch = stretch;
+    slot.axes.assign(axes.begin(), axes.end());
+    slot.cache = std::make_shared<FontFallbackCache>();
+    return slot.cache;
+}
+
+// Routine Description:
+// - Looks up the faces font fallback picked before for each codepoint of the given text.
+// Arguments:
+// - text - The text to map to font faces.
+// - runs - Receives the runs of text that map to the same face, covering the whole text.
+// Return Value:
+// - true if every codepoint of the text was found. If false, runs are left in an unspecified state.
+bool FontFallbackCache::Lookup(const std::wstring_view text, std::vector<Run>& runs) const
+{
+    runs.clear();
+
+    const std::scoped_lock lock{ _mutex };
+
+    for (size_t pos = 0; pos < text.size();)
+    {
+        char32_t codepoint = 0;
+        const auto length = s_NextCodepoint(text, pos, codepoint);
+        pos += length;
+
+        if (!s_IsCacheable(codepoint))
+        {
+            return false;
+        }
+
+        const auto it = _entries.find(codepoint);
+        if (it == _entries.end())
+        {
+            return false;
+        }
+
+        const auto& entry = it->second;
+        if (!runs.empty() && runs.back().fontFace == entry.fontFace && runs.back().scale == entry.scale)
+        {
+            runs.back().length += gsl::narrow_cast<UINT32>(length);
+        }
+        else
+        {
+            runs.push_back({ gsl::narrow_cast<UINT32>(length), entry.fontFace, entry.scale });
+        }
+    }
+
+    return true;
+}
+
+// Routine Description:
+// - Remembers that font fallback mapped the given text to a face.
+// - Text containing codepoints that combine with others isn't remembered,
+//   as fallback may have picked the face for the cluster as a whole.
+// Arguments:
+// - text - A range of text that MapCharacters mapped to a single face.
+// - fontFace - The face it picked, or nullptr if no font supports the text.
+// - scale - The scale it picked for the face.
+// Return Value:
+// - <none>
+void FontFallbackCache::Insert(const std::wstring_view text, const ::Microsoft::WRL::ComPtr<IDWriteFontFace>& fontFace, const float scale)
+{
+    for (size_t pos = 0; pos < text.size();)
+    {
+        char32_t codepoint = 0;
+        pos += s_NextCodepoint(text, pos, codepoint);
+        if (!s_IsCacheable(codepoint))
+        {
+            return;
+        }
+    }
+
+    const std::scoped_lock lock{ _mutex };
+
+    // The cache only ever holds what was drawn recently enough,
+    // without a need for any bookkeeping during lookups.
+    if (_entries.size() + text.size() > s_maxEntries)
+    {
+        _entries.clear();
+    }
+
+    for (size_t pos = 0; pos < text.size();)
+    {
+        char32_t codepoint = 0;
+        pos += s_NextCodepoint(text, pos, codepoint);
+        _entries.emplace(codepoint, Entry{ fontFace, scale });
+    }
+}
+
+// Routine Description:
+// - Estimates how many bytes the cache holds on to. Every node of the map is
+//   counted as the entry plus a pointer to the next node.
+// Arguments:
+// - <none>
+// Return Value:
+// - The number of bytes
+size_t FontFallbackCache::MemoryUsage() const
+{
+    const std::scoped_lock lock{ _mutex };
+    return _entries.size() * (sizeof(decltype(_entries)::value_type) + sizeof(void*)) +
+           _entries.bucket_count() * sizeof(void*);
+}
+
+// Routine Description:
+// - Decodes the codepoint at the given position of UTF-16 text.
+// Arguments:
+// - text - The text to decode.
+// - pos - The position of the codepoint in text. Must be less than its size.
+// - codepoint - Receives the codepoint. Unpaired surrogates are returned as is.
+// Return Value:
+// - The number of code units the codepoint takes up.
+size_t FontFallbackCache::s_NextCodepoint(const std::wstring_view text, const size_t pos, char32_t& codepoint) noexcept
+{
+    const auto wch = til::at(text, pos);
+    if (IS_HIGH_SURROGATE(wch) && pos + 1 < text.size() && IS_LOW_SURROGATE(til::at(text, pos + 1)))
+    {
+        codepoint = 0x10000 + ((static_cast<char32_t>(wch) - 0xD800) << 10) + (static_cast<char32_t>(til::at(text, pos + 1)) - 0xDC00);
+        return 2;
+    }
+
+    codepoint = wch;
+    return 1;
+}
+
+// Routine Description:
+// - Checks if a codepoint maps to a font face on its own. Marks, joiners,
+//   variation selectors, emoji modifiers and the like form clusters with
+//   their neighbors, which fallback has to look at as a whole.
+// Arguments:
+// - codepoint - The codepoint to check.
+// Return Value:
+// - true if the face fallback picks for the codepoint can be reused for it anywhere.
+bool FontFallbackCache::s_IsCacheable(const char32_t codepoint) noexcept
+{
+    if (codepoint >= 0x10000)
+    {
+        return !(codepoint >= 0x1F1E6 && codepoint <= 0x1F1FF) && // regional indicators
+               !(codepoint >= 0x1F3FB && codepoint <= 0x1F3FF) && // emoji modifiers
+               codepoint < 0xE0000; // tags and variation selectors
+    }
+
+    if ((codepoint >= 0xD800 && codepoint <= 0xDFFF) || // unpaired surrogates
+        (codepoint >= 0x1100 && codepoint <= 0x11FF) || // conjoining Hangul jamo
+        (codepoint >= 0xA960 && codepoint <= 0xA97F) ||
+        (codepoint >= 0xD7B0 && codepoint <= 0xD7FF) ||
+        (codepoint >= 0x200B && codepoint <= 0x200F) || // zero width joiners and marks
+        (codepoint >= 0x2060 && codepoint <= 0x206F) ||
+        (codepoint >= 0xFE00 && codepoint <= 0xFE0F) || // variation selectors
+        codepoint == 0x20E3) // combining keycap
+    {
+        return false;
+    }
+
+    const auto wch = gsl::narrow_cast<wchar_t>(codepoint);
+    WORD type = 0;
+    return GetStringTypeW(CT_CTYPE3, &wch, 1, &type) && WI_AreAllFlagsClear(type, C3_NONSPACING | C3_DIACRITIC | C3_VOWELMARK);
+}
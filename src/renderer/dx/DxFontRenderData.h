@@ -26,6 +26,49 @@ namespace Microsoft::Console::Render
     };
     DEFINE_ENUM_FLAG_OPERATORS(AxisTagPresence);
 
+    // Remembers the font faces that font fallback picked for the codepoints of
+    // text drawn with a given font family and attributes. MapCharacters is
+    // expensive and CJK or emoji text needs fallback for almost every run.
+    // Instances are shared by all engines in the process and are thread-safe.
+    class FontFallbackCache
+    {
+    public:
+        struct Run
+        {
+            UINT32 length;
+            ::Microsoft::WRL::ComPtr<IDWriteFontFace> fontFace; // nullptr if no font supports the text
+            float scale;
+        };
+
+        [[nodiscard]] static std::shared_ptr<FontFallbackCache> s_Get(IDWriteFontFallback* fallback,
+                                                                      IDWriteFontCollection* collection,
+                                                                      const std::wstring_view familyName,
+                                                                      const DWRITE_FONT_WEIGHT weight,
+                                                                      const DWRITE_FONT_STYLE style,
+                                                                      const DWRITE_FONT_STRETCH stretch,
+                                                                      const gsl::span<const DWRITE_FONT_AXIS_VALUE> axes);
+
+        bool Lookup(const std::wstring_view text, std::vector<Run>& runs) const;
+        void Insert(const std::wstring_view text, const ::Microsoft::WRL::ComPtr<IDWriteFontFace>& fontFace, const float scale);
+        size_t MemoryUsage() const;
+
+        // The number of codepoints we remember before starting over.
+        static constexpr size_t s_maxEntries = 4096;
+
+    private:
+        struct Entry
+        {
+            ::Microsoft::WRL::ComPtr<IDWriteFontFace> fontFace;
+            float scale;
+        };
+
+        static size_t s_NextCodepoint(const std::wstring_view text, const size_t pos, char32_t& codepoint) noexcept;
+        static bool s_IsCacheable(const char32_t codepoint) noexcept;
+
+        mutable std::mutex _mutex;
+        std::unordered_map<char32_t, Entry> _entries;
+    };
+
     class DxFontRenderData
     {
     public:
@@ -39,6 +82,22 @@ namespace Microsoft::Console::Render
             float strikethroughWidth;
         };
 
+        // Everything font fallback needs to know about a text format, so
+        // that it doesn't need to be queried again for every run of text.
+        struct FontFallback
+        {
+            ::Microsoft::WRL::ComPtr<IDWriteFontFallback> fallback;
+            // Set if the OS supports applying the axes of variation during fallback.
+            ::Microsoft::WRL::ComPtr<IDWriteFontFallback1> fallback1;
+            ::Microsoft::WRL::ComPtr<IDWriteFontCollection> collection;
+            std::wstring familyName;
+            DWRITE_FONT_WEIGHT weight;
+            DWRITE_FONT_STYLE style;
+            DWRITE_FONT_STRETCH stretch;
+            std::vector<DWRITE_FONT_AXIS_VALUE> axes;
+            std::shared_ptr<FontFallbackCache> cache;
+        };
+
         DxFontRenderData(::Microsoft::WRL::ComPtr<IDWriteFactory1> dwriteFactory) noexcept;
 
         // DirectWrite text analyzer from the factory
@@ -46,6 +105,9 @@ namespace Microsoft::Console::Render
 
         [[nodiscard]] Microsoft::WRL::ComPtr<IDWriteFontFallback> SystemFontFallback();
 
+        // The font fallback setup for one of our text formats, or nullptr if this OS doesn't have font fallback.
+        [[nodiscard]] const FontFallback* FontFallbackForFormat(IDWriteTextFormat* format);
+
         // A locale that can be used on construction of assorted DX objects that want to know one.
         [[nodiscard]] std::wstring UserLocaleName();
 
@@ -87,6 +149,10 @@ namespace Microsoft::Console::Render
 
         [[nodiscard]] static HRESULT STDMETHODCALLTYPE s_CalculateBoxEffect(IDWriteTextFormat* format, size_t widthPixels, IDWriteFontFace1* face, float fontScale, IBoxDrawingEffect** effect) noexcept;
 
+        // The number of bytes held by the font fallback caches of our text formats.
+        // The caches are shared with every other engine that uses the same font.
+        size_t FontFallbackCacheMemoryUsage() const;
+
         bool DidUserSetFeatures() const noexcept;
         bool DidUserSetAxes() const noexcept;
         void InhibitUserWeight(bool inhibitUserWeight) noexcept;
@@ -126,6 +192,8 @@ namespace Microsoft::Console::Render
 
         std::unordered_map<FontAttributeMapKey, ::Microsoft::WRL::ComPtr<IDWriteTextFormat>> _textFormatMap;
         std::unordered_map<FontAttributeMapKey, ::Microsoft::WRL::ComPtr<IDWriteFontFace1>> _fontFaceMap;
+        // Keyed by the formats in _textFormatMap and the default one, which stay alive until UpdateFont.
+        std::unordered_map<IDWriteTextFormat*, std::optional<FontFallback>> _fontFallbackMap;
 
         ::Microsoft::WRL::ComPtr<IBoxDrawingEffect> _boxDrawingEffect;
         ::Microsoft::WRL::ComPtr<IDWriteFontFallback> _systemFontFallback;
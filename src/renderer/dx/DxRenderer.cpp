@@ -17,9 +17,109 @@
 #include <DirectXMath.h>
 #include <d3dcompiler.h>
 #include <DirectXColors.h>
+#include <d3d11_4.h>
 
 using namespace DirectX;
 
+namespace
+{
+    // The device created ahead of time by DxEngine::s_PrewarmDevice.
+    struct PrewarmedDeviceSlot
+    {
+        std::mutex lock;
+        bool creating = false;
+        ::Microsoft::WRL::ComPtr<ID3D11Device> device;
+        ::Microsoft::WRL::ComPtr<ID3D11DeviceContext> deviceContext;
+    };
+
+    PrewarmedDeviceSlot& prewarmedDeviceSlot()
+    {
+        // Intentionally leaked: we don't want to release a D3D device while the process is shutting down.
+        static auto& slot = *new PrewarmedDeviceSlot{};
+        return slot;
+    }
+
+    // Routine Description:
+    // - Hands out the prewarmed device, if there is one and it's still usable.
+    // Arguments:
+    // - device - Receives the device.
+    // - deviceContext - Receives the immediate context of the device.
+    // Return Value:
+    // - true if a device was handed out.
+    bool takePrewarmedDevice(::Microsoft::WRL::ComPtr<ID3D11Device>& device,
+                             ::Microsoft::WRL::ComPtr<ID3D11DeviceContext>& deviceContext)
+    {
+        auto& slot = prewarmedDeviceSlot();
+        const std::lock_guard guard{ slot.lock };
+        if (!slot.device)
+        {
+            return false;
+        }
+
+        device = std::move(slot.device);
+        deviceContext = std::move(slot.deviceContext);
+
+        // The adapter may have gone away (driver update, remote session reconnect, ...) since it was created.
+        if (FAILED(device->GetDeviceRemovedReason()))
+        {
+            device.Reset();
+            deviceContext.Reset();
+            return false;
+        }
+        return true;
+    }
+
+    // The devices shared by all DxEngines that render with hardware, so that each
+    // pane doesn't hold its own copy of them. The engines only create their own
+    // swap chain, device context and the resources that belong to those.
+    struct SharedDeviceSlot
+    {
+        std::mutex lock;
+        size_t users = 0;
+        ::Microsoft::WRL::ComPtr<ID2D1Factory1> d2dFactory;
+        ::Microsoft::WRL::ComPtr<ID3D11Device> d3dDevice;
+        ::Microsoft::WRL::ComPtr<ID3D11DeviceContext> d3dDeviceContext;
+        ::Microsoft::WRL::ComPtr<ID2D1Device> d2dDevice;
+    };
+
+    SharedDeviceSlot& sharedDeviceSlot()
+    {
+        // Intentionally leaked, just like the prewarmed device slot.
+        static auto& slot = *new SharedDeviceSlot{};
+        return slot;
+    }
+
+    // Holds the Direct2D lock of a multithreaded factory for its lifetime.
+    // Direct2D takes it whenever it uses the D3D device context itself,
+    // so our own calls into a shared device context have to do the same.
+    class D2DLock
+    {
+    public:
+        explicit D2DLock(ID2D1Multithread* multithread) noexcept :
+            _multithread{ multithread }
+        {
+            if (_multithread)
+            {
+                _multithread->Enter();
+            }
+        }
+
+        ~D2DLock()
+        {
+            if (_multithread)
+            {
+                _multithread->Leave();
+            }
+        }
+
+        D2DLock(const D2DLock&) = delete;
+        D2DLock& operator=(const D2DLock&) = delete;
+
+    private:
+        ID2D1Multithread* _multithread;
+    };
+}
+
 std::atomic<size_t> Microsoft::Console::Render::DxEngine::_tracelogCount{ 0 };
 #pragma warning(suppress : 26477) // We don't control tracelogging macros
 TRACELOGGING_DEFINE_PROVIDER(g_hDxRenderProvider,
@@ -68,6 +168,8 @@ DxEngine::DxEngine() :
     _firstFrame{ true },
     _presentParams{ 0 },
     _presentReady{ false },
+    _backBufferOutdated{ false },
+    _endDrawPending{ false },
     _presentScroll{ 0 },
     _presentDirty{ 0 },
     _presentOffset{ 0 },
@@ -76,6 +178,7 @@ DxEngine::DxEngine() :
     _displaySizePixels{},
     _foregroundColor{ 0 },
     _backgroundColor{ 0 },
+    _clearColor{ 0 },
     _selectionBackground{},
     _haveDeviceResources{ false },
     _swapChainHandle{ INVALID_HANDLE_VALUE },
@@ -229,6 +332,73 @@ _CompileShader(
 #endif
 }
 
+// Routine Description:
+// - Checks whether a compiled pixel shader reads the Time member of our settings,
+//   meaning that its output may change from one frame to the next on its own.
+// Arguments:
+// - blob - The compiled pixel shader
+// Return Value:
+// - False if the shader is known not to use the time. True otherwise.
+static bool _ShaderUsesTime(ID3DBlob* blob) noexcept
+{
+#if !TIL_FEATURE_DXENGINESHADERSUPPORT_ENABLED
+    UNREFERENCED_PARAMETER(blob);
+    return true;
+#else
+    ::Microsoft::WRL::ComPtr<ID3D11ShaderReflection> reflection;
+    if (FAILED_LOG(D3DReflect(blob->GetBufferPointer(), blob->GetBufferSize(), IID_PPV_ARGS(&reflection))))
+    {
+        return true;
+    }
+
+    D3D11_SHADER_DESC shaderDesc{};
+    if (FAILED_LOG(reflection->GetDesc(&shaderDesc)))
+    {
+        return true;
+    }
+
+    // Our settings are bound to constant buffer slot 0. Look for whichever
+    // buffer the shader declared there, no matter what it's called.
+    for (UINT i = 0; i < shaderDesc.BoundResources; ++i)
+    {
+        D3D11_SHADER_INPUT_BIND_DESC bindDesc{};
+        if (FAILED(reflection->GetResourceBindingDesc(i, &bindDesc)) ||
+            bindDesc.Type != D3D_SIT_CBUFFER ||
+            bindDesc.BindPoint != 0)
+        {
+            continue;
+        }
+
+        const auto buffer = reflection->GetConstantBufferByName(bindDesc.Name);
+        D3D11_SHADER_BUFFER_DESC bufferDesc{};
+        if (FAILED(buffer->GetDesc(&bufferDesc)))
+        {
+            return true;
+        }
+
+        // Time is the very first member. Any variable overlapping it counts, in case it's been renamed.
+        for (UINT j = 0; j < bufferDesc.Variables; ++j)
+        {
+            D3D11_SHADER_VARIABLE_DESC variableDesc{};
+            if (FAILED(buffer->GetVariableByIndex(j)->GetDesc(&variableDesc)))
+            {
+                return true;
+            }
+
+            if (variableDesc.StartOffset < sizeof(float) && WI_IsFlagSet(variableDesc.uFlags, D3D_SVF_USED))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // The shader doesn't read any of our settings at all.
+    return false;
+#endif
+}
+
 // Routine Description:
 // - Checks if terminal effects are enabled.
 // Arguments:
@@ -247,6 +417,8 @@ bool DxEngine::_HasTerminalEffects() const noexcept
 void DxEngine::ToggleShaderEffects()
 {
     _terminalEffectsEnabled = !_terminalEffectsEnabled;
+    // The effects change what we draw into, so the resources need to be recreated.
+    _recreateDeviceRequested = true;
     LOG_IF_FAILED(InvalidateAll());
 }
 
@@ -334,12 +506,24 @@ HRESULT DxEngine::_SetupTerminalEffects()
     // Setup render target.
     RETURN_IF_FAILED(_d3dDevice->CreateRenderTargetView(swapBuffer.Get(), nullptr, &_renderTargetView));
 
-    // Setup _framebufferCapture, to where we'll copy current frame when rendering effects.
+    // Setup _framebufferCapture, which we'll draw the frame into with Direct2D
+    // and then read from in the shader, which draws into the swap chain.
+    // The capture keeps its contents from frame to frame, so we don't need to
+    // copy anything into it, nor repaint the parts of the frame that didn't change.
     D3D11_TEXTURE2D_DESC framebufferCaptureDesc{};
     swapBuffer->GetDesc(&framebufferCaptureDesc);
-    WI_SetFlag(framebufferCaptureDesc.BindFlags, D3D11_BIND_SHADER_RESOURCE);
+    WI_SetAllFlags(framebufferCaptureDesc.BindFlags, D3D11_BIND_RENDER_TARGET | D3D11_BIND_SHADER_RESOURCE);
+    framebufferCaptureDesc.MiscFlags = 0;
     RETURN_IF_FAILED(_d3dDevice->CreateTexture2D(&framebufferCaptureDesc, nullptr, &_framebufferCapture));
 
+    // Prepare the capture as input resource to the shader program.
+    D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc{};
+    srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
+    srvDesc.Texture2D.MostDetailedMip = 0;
+    srvDesc.Texture2D.MipLevels = framebufferCaptureDesc.MipLevels;
+    srvDesc.Format = framebufferCaptureDesc.Format;
+    RETURN_IF_FAILED(_d3dDevice->CreateShaderResourceView(_framebufferCapture.Get(), &srvDesc, &_framebufferCaptureView));
+
     // Setup the viewport.
     D3D11_VIEWPORT vp;
     vp.Width = _displaySizePixels.width<float>();
@@ -348,7 +532,10 @@ HRESULT DxEngine::_SetupTerminalEffects()
     vp.MaxDepth = 1.0f;
     vp.TopLeftX = 0;
     vp.TopLeftY = 0;
-    _d3dDeviceContext->RSSetViewports(1, &vp);
+    {
+        const D2DLock lock{ _d2dMultithread.Get() };
+        _d3dDeviceContext->RSSetViewports(1, &vp);
+    }
 
     // Prepare shaders.
     auto vertexBlob = _CompileShader(screenVertexShaderString, "vs_5_0");
@@ -373,6 +560,9 @@ HRESULT DxEngine::_SetupTerminalEffects()
         return exceptionHr;
     }
 
+    // Shaders that don't animate only need to run when the frame changed.
+    _pixelShaderUsesTime = _ShaderUsesTime(pixelBlob.Get());
+
     RETURN_IF_FAILED(_d3dDevice->CreateVertexShader(
         vertexBlob->GetBufferPointer(),
         vertexBlob->GetBufferSize(),
@@ -473,6 +663,7 @@ void DxEngine::_ComputePixelShaderSettings() noexcept
             background.w = _backgroundColor.a;
             _pixelShaderSettings.Background = background;
 
+            const D2DLock lock{ _d2dMultithread.Get() };
             _d3dDeviceContext->UpdateSubresource(_pixelShaderSettingsBuffer.Get(), 0, nullptr, &_pixelShaderSettings, 0, 0);
         }
         CATCH_LOG();
@@ -502,30 +693,20 @@ void DxEngine::_ComputePixelShaderSettings() noexcept
     return fn(GENERIC_ALL, nullptr, &_swapChainHandle);
 }
 
-// Routine Description;
-// - Creates device-specific resources required for drawing
-//   which generally means those that are represented on the GPU and can
-//   vary based on the monitor, display adapter, etc.
-// - These may need to be recreated during the course of painting a frame
-//   should something about that hardware pipeline change.
-// - Will free device resources that already existed as first operation.
+// Routine Description:
+// - Creates the Direct3D device and its immediate context, with the same
+//   flags and feature levels for every DxEngine.
 // Arguments:
-// - createSwapChain - If true, we create the entire rendering pipeline
-//                   - If false, we just set up the adapter.
+// - softwareRendering - If true, skip hardware and create a WARP device.
+// - device - Receives the device.
+// - deviceContext - Receives the immediate context of the device.
 // Return Value:
-// - Could be any DirectX/D3D/D2D/DXGI/DWrite error or memory issue.
-[[nodiscard]] HRESULT DxEngine::_CreateDeviceResources(const bool createSwapChain) noexcept
+// - S_OK or a D3D error.
+[[nodiscard]] HRESULT DxEngine::s_CreateD3DDevice(const bool softwareRendering,
+                                                  ::Microsoft::WRL::ComPtr<ID3D11Device>& device,
+                                                  ::Microsoft::WRL::ComPtr<ID3D11DeviceContext>& deviceContext) noexcept
 try
 {
-    if (_haveDeviceResources)
-    {
-        _ReleaseDeviceResources();
-    }
-
-    auto freeOnFail = wil::scope_exit([&]() noexcept { _ReleaseDeviceResources(); });
-
-    RETURN_IF_FAILED(CreateDXGIFactory1(IID_PPV_ARGS(&_dxgiFactory2)));
-
     const DWORD DeviceFlags = D3D11_CREATE_DEVICE_BGRA_SUPPORT |
                               // clang-format off
 // This causes problems for folks who do not have the whole DirectX SDK installed
@@ -538,7 +719,8 @@ try
 // https://docs.microsoft.com/en-us/windows/uwp/gaming/use-the-directx-runtime-and-visual-studio-graphics-diagnostic-features
                               // clang-format on
                               // D3D11_CREATE_DEVICE_DEBUG |
-                              D3D11_CREATE_DEVICE_SINGLETHREADED;
+                              // Hardware devices are shared by engines on different render threads.
+                              (softwareRendering ? D3D11_CREATE_DEVICE_SINGLETHREADED : 0);
 
     const std::array<D3D_FEATURE_LEVEL, 5> FeatureLevels{ D3D_FEATURE_LEVEL_11_1,
                                                           D3D_FEATURE_LEVEL_11_0,
@@ -553,7 +735,7 @@ try
 
     // If we're not forcing software rendering, try hardware first.
     // Otherwise, let the error state fall down and create with the software renderer directly.
-    if (!_softwareRendering)
+    if (!softwareRendering)
     {
         hardwareResult = D3D11CreateDevice(nullptr,
                                            D3D_DRIVER_TYPE_HARDWARE,
@@ -562,9 +744,9 @@ try
                                            FeatureLevels.data(),
                                            gsl::narrow_cast<UINT>(FeatureLevels.size()),
                                            D3D11_SDK_VERSION,
-                                           &_d3dDevice,
+                                           &device,
                                            nullptr,
-                                           &_d3dDeviceContext);
+                                           &deviceContext);
     }
 
     if (FAILED(hardwareResult))
@@ -576,9 +758,188 @@ try
                                            FeatureLevels.data(),
                                            gsl::narrow_cast<UINT>(FeatureLevels.size()),
                                            D3D11_SDK_VERSION,
-                                           &_d3dDevice,
+                                           &device,
                                            nullptr,
-                                           &_d3dDeviceContext));
+                                           &deviceContext));
+    }
+
+    return S_OK;
+}
+CATCH_RETURN();
+
+// Routine Description:
+// - Creates a hardware (or WARP, if that fails) device on the thread pool
+//   and keeps it until the next DxEngine creates its device resources.
+// - Does nothing if there's already a device waiting or being created.
+// - Device creation can take a noticeable amount of time on machines with
+//   slow GPU initialization (VMs, VDI), so the terminal calls this after each
+//   control's renderer is set up to have a device ready for the next one.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void DxEngine::s_PrewarmDevice() noexcept
+try
+{
+    auto& slot = prewarmedDeviceSlot();
+    {
+        const std::lock_guard guard{ slot.lock };
+        if (slot.creating || slot.device)
+        {
+            return;
+        }
+        slot.creating = true;
+    }
+
+    const auto submitted = TrySubmitThreadpoolCallback(
+        [](PTP_CALLBACK_INSTANCE, void*) noexcept {
+            ::Microsoft::WRL::ComPtr<ID3D11Device> device;
+            ::Microsoft::WRL::ComPtr<ID3D11DeviceContext> deviceContext;
+            LOG_IF_FAILED(s_CreateD3DDevice(false, device, deviceContext));
+
+            auto& slot = prewarmedDeviceSlot();
+            const std::lock_guard guard{ slot.lock };
+            slot.device = std::move(device);
+            slot.deviceContext = std::move(deviceContext);
+            slot.creating = false;
+        },
+        nullptr,
+        nullptr);
+
+    if (!submitted)
+    {
+        LOG_LAST_ERROR();
+        const std::lock_guard guard{ slot.lock };
+        slot.creating = false;
+    }
+}
+CATCH_LOG()
+
+// Routine Description:
+// - Makes this engine use the devices shared by all hardware engines,
+//   creating them if this is the first one (or if they were removed).
+// Arguments:
+// - <none>
+// Return Value:
+// - S_OK or the error from creating the devices.
+[[nodiscard]] HRESULT DxEngine::_AcquireSharedDevice() noexcept
+try
+{
+    auto& slot = sharedDeviceSlot();
+    const std::lock_guard guard{ slot.lock };
+
+    // A removed device can't be handed out anymore. The engines still using
+    // it will notice on their next frame and come back for the new one.
+    if (slot.d3dDevice && FAILED(slot.d3dDevice->GetDeviceRemovedReason()))
+    {
+        slot.users = 0;
+        slot.d2dDevice.Reset();
+        slot.d3dDeviceContext.Reset();
+        slot.d3dDevice.Reset();
+    }
+
+    if (!slot.d3dDevice)
+    {
+        if (!slot.d2dFactory)
+        {
+            // Direct2D only serializes access to the device with a multithreaded factory.
+            RETURN_IF_FAILED(D2D1CreateFactory(D2D1_FACTORY_TYPE_MULTI_THREADED, IID_PPV_ARGS(&slot.d2dFactory)));
+        }
+
+        ::Microsoft::WRL::ComPtr<ID3D11Device> device;
+        ::Microsoft::WRL::ComPtr<ID3D11DeviceContext> deviceContext;
+        if (!takePrewarmedDevice(device, deviceContext))
+        {
+            RETURN_IF_FAILED(s_CreateD3DDevice(false, device, deviceContext));
+        }
+
+        ::Microsoft::WRL::ComPtr<ID3D11Multithread> multithread;
+        RETURN_IF_FAILED(deviceContext.As(&multithread));
+        multithread->SetMultithreadProtected(TRUE);
+
+        ::Microsoft::WRL::ComPtr<IDXGIDevice> dxgiDevice;
+        RETURN_IF_FAILED(device.As(&dxgiDevice));
+        ::Microsoft::WRL::ComPtr<ID2D1Device> d2dDevice;
+        RETURN_IF_FAILED(slot.d2dFactory->CreateDevice(dxgiDevice.Get(), &d2dDevice));
+
+        slot.d3dDevice = std::move(device);
+        slot.d3dDeviceContext = std::move(deviceContext);
+        slot.d2dDevice = std::move(d2dDevice);
+    }
+
+    RETURN_IF_FAILED(slot.d2dFactory.As(&_d2dMultithread));
+
+    // The stroke styles are created from _d2dFactory in _PrepareRenderTarget,
+    // so it has to be the factory the shared device belongs to.
+    _d2dFactory = slot.d2dFactory;
+    _d3dDevice = slot.d3dDevice;
+    _d3dDeviceContext = slot.d3dDeviceContext;
+    _d2dDevice = slot.d2dDevice;
+    _usingSharedDevice = true;
+    ++slot.users;
+
+    return S_OK;
+}
+CATCH_RETURN()
+
+// Routine Description:
+// - Stops using the shared devices. They're released once no engine uses them anymore.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void DxEngine::_ReleaseSharedDevice() noexcept
+{
+    if (!std::exchange(_usingSharedDevice, false))
+    {
+        return;
+    }
+
+    auto& slot = sharedDeviceSlot();
+    const std::lock_guard guard{ slot.lock };
+
+    // If the device was replaced after it got removed, the slot doesn't count us anymore.
+    if (slot.d3dDevice == _d3dDevice && slot.users > 0 && --slot.users == 0)
+    {
+        slot.d2dDevice.Reset();
+        slot.d3dDeviceContext.Reset();
+        slot.d3dDevice.Reset();
+    }
+}
+
+// Routine Description;
+// - Creates device-specific resources required for drawing
+//   which generally means those that are represented on the GPU and can
+//   vary based on the monitor, display adapter, etc.
+// - These may need to be recreated during the course of painting a frame
+//   should something about that hardware pipeline change.
+// - Will free device resources that already existed as first operation.
+// Arguments:
+// - createSwapChain - If true, we create the entire rendering pipeline
+//                   - If false, we just set up the adapter.
+// Return Value:
+// - Could be any DirectX/D3D/D2D/DXGI/DWrite error or memory issue.
+[[nodiscard]] HRESULT DxEngine::_CreateDeviceResources(const bool createSwapChain) noexcept
+try
+{
+    if (_haveDeviceResources)
+    {
+        _ReleaseDeviceResources();
+    }
+
+    auto freeOnFail = wil::scope_exit([&]() noexcept { _ReleaseDeviceResources(); });
+
+    RETURN_IF_FAILED(CreateDXGIFactory1(IID_PPV_ARGS(&_dxgiFactory2)));
+
+    // Hardware engines share their devices. Software rendering is meant as a
+    // fallback for when the hardware misbehaves, so it always gets its own.
+    if (_softwareRendering || FAILED_LOG(_AcquireSharedDevice()))
+    {
+        // Take the device that was created ahead of time if we can, to save creating one right now.
+        if (_softwareRendering || !takePrewarmedDevice(_d3dDevice, _d3dDeviceContext))
+        {
+            RETURN_IF_FAILED(s_CreateD3DDevice(_softwareRendering, _d3dDevice, _d3dDeviceContext));
+        }
     }
 
     _displaySizePixels = _GetClientSize();
@@ -587,7 +948,10 @@ try
     // in our pipeline than by just walking straight from the D3D device.
 
     RETURN_IF_FAILED(_d3dDevice.As(&_dxgiDevice));
-    RETURN_IF_FAILED(_d2dFactory->CreateDevice(_dxgiDevice.Get(), _d2dDevice.ReleaseAndGetAddressOf()));
+    if (!_usingSharedDevice)
+    {
+        RETURN_IF_FAILED(_d2dFactory->CreateDevice(_dxgiDevice.Get(), _d2dDevice.ReleaseAndGetAddressOf()));
+    }
 
     // Create a device context out of it (supercedes render targets)
     RETURN_IF_FAILED(_d2dDevice->CreateDeviceContext(D2D1_DEVICE_CONTEXT_OPTIONS_NONE, &_d2dDeviceContext));
@@ -608,6 +972,8 @@ try
         _swapChainDesc.AlphaMode = DXGI_ALPHA_MODE_UNSPECIFIED;
         _swapChainDesc.Scaling = DXGI_SCALING_NONE;
 
+        _tearingSupported = false;
+
         switch (_chainMode)
         {
         case SwapChainMode::ForHwnd:
@@ -616,6 +982,19 @@ try
             RECT rect = { 0 };
             RETURN_IF_WIN32_BOOL_FALSE(GetClientRect(_hwndTarget, &rect));
 
+            // Presenting with tearing allowed doesn't wait for the vertical blank, which
+            // lowers the latency when typing and lets variable refresh rate displays
+            // refresh as soon as we're done. See _UpdateAllowTearing for when we use it.
+            // It requires DXGI 1.5, which was introduced in Windows 10.
+            ::Microsoft::WRL::ComPtr<IDXGIFactory5> factory5;
+            BOOL allowTearing = FALSE;
+            if (SUCCEEDED(_dxgiFactory2.As(&factory5)) &&
+                SUCCEEDED(factory5->CheckFeatureSupport(DXGI_FEATURE_PRESENT_ALLOW_TEARING, &allowTearing, sizeof(allowTearing))))
+            {
+                _tearingSupported = allowTearing != FALSE;
+            }
+            WI_SetFlagIf(_swapChainDesc.Flags, DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING, _tearingSupported);
+
             _swapChainDesc.Width = rect.right - rect.left;
             _swapChainDesc.Height = rect.bottom - rect.top;
 
@@ -669,6 +1048,8 @@ try
             THROW_HR(E_NOTIMPL);
         }
 
+        _UpdateAllowTearing();
+
         if (IsWindows8Point1OrGreater())
         {
             ::Microsoft::WRL::ComPtr<IDXGISwapChain2> swapChain2;
@@ -750,10 +1131,18 @@ static constexpr D2D1_ALPHA_MODE _dxgiAlphaToD2d1Alpha(DXGI_ALPHA_MODE mode) noe
 {
     try
     {
-        // Pull surface out of swap chain.
-        RETURN_IF_FAILED(_dxgiSwapChain->GetBuffer(0, IID_PPV_ARGS(&_dxgiSurface)));
+        if (_DrawingToFramebufferCapture())
+        {
+            // With terminal effects only the pixel shader draws into the swap chain.
+            RETURN_IF_FAILED(_framebufferCapture.As(&_dxgiSurface));
+        }
+        else
+        {
+            // Pull surface out of swap chain.
+            RETURN_IF_FAILED(_dxgiSwapChain->GetBuffer(0, IID_PPV_ARGS(&_dxgiSurface)));
+        }
 
-        // Make a bitmap and bind it to the swap chain surface
+        // Make a bitmap and bind it to the surface
         const auto bitmapProperties = D2D1::BitmapProperties1(
             D2D1_BITMAP_OPTIONS_TARGET | D2D1_BITMAP_OPTIONS_CANNOT_DRAW,
             D2D1::PixelFormat(_swapChainDesc.Format, _dxgiAlphaToD2d1Alpha(_swapChainDesc.AlphaMode)));
@@ -838,6 +1227,9 @@ void DxEngine::_ReleaseDeviceResources() noexcept
     try
     {
         _haveDeviceResources = false;
+        _backBufferOutdated = false;
+        _endDrawPending = false;
+        _presentOccluded = false;
 
         // Destroy Terminal Effect resources
         _renderTargetView.Reset();
@@ -847,7 +1239,10 @@ void DxEngine::_ReleaseDeviceResources() noexcept
         _screenQuadVertexBuffer.Reset();
         _pixelShaderSettingsBuffer.Reset();
         _samplerState.Reset();
+        _framebufferCaptureView.Reset();
         _framebufferCapture.Reset();
+        _pixelShaderLoaded = false;
+        _terminalEffectsInvalid = false;
 
         _d2dBrushForeground.Reset();
         _d2dBrushBackground.Reset();
@@ -872,8 +1267,12 @@ void DxEngine::_ReleaseDeviceResources() noexcept
         {
             // To ensure the swap chain goes away we must unbind any views from the
             // D3D pipeline
+            const D2DLock lock{ _d2dMultithread.Get() };
             _d3dDeviceContext->OMSetRenderTargets(0, nullptr, nullptr);
         }
+
+        _ReleaseSharedDevice();
+        _d2dMultithread.Reset();
         _d3dDeviceContext.Reset();
 
         _d3dDevice.Reset();
@@ -921,6 +1320,29 @@ void DxEngine::_ReleaseDeviceResources() noexcept
     return forceGrayscaleAA;
 }
 
+// Routine Description:
+// - Checks whether filling the given background color over the area cleared by
+//   PaintBackground this frame would change anything.
+// Arguments:
+// - color - The background color to fill with
+// Return Value:
+// - True if the fill can be skipped. False otherwise.
+[[nodiscard]] bool DxEngine::_IsBackgroundCleared(const D2D1_COLOR_F& color) const noexcept
+{
+    // Fully transparent fills leave the target untouched.
+    if (color.a == 0.0f)
+    {
+        return true;
+    }
+
+    // Opaque fills replace the target, so they only need to differ from what it was cleared to.
+    return color.a == 1.0f &&
+           color.r == _clearColor.r &&
+           color.g == _clearColor.g &&
+           color.b == _clearColor.b &&
+           color.a == _clearColor.a;
+}
+
 // Routine Description:
 // - Helper to create a DirectWrite text layout object
 //   out of a string.
@@ -977,11 +1399,45 @@ void DxEngine::SetWarningCallback(std::function<void(const HRESULT)> pfn)
     _pfnWarningCallback = pfn;
 }
 
+// Routine Description:
+// - Sets a callback that's called on the render thread after each frame was
+//   successfully presented. It's called outside of the console lock.
+// Arguments:
+// - pfn - the function to call after presenting
+// Return Value:
+// - <none>
+void DxEngine::SetPresentCallback(std::function<void()> pfn)
+{
+    _pfnPresentCallback = pfn;
+}
+
 bool DxEngine::GetRetroTerminalEffect() const noexcept
 {
     return _retroTerminalEffect;
 }
 
+// Routine Description:
+// - Adds up the memory of the caches that we keep between frames.
+// - The caches are only changed while painting, so the caller has to make
+//   sure we aren't, for instance by holding the console lock.
+// Arguments:
+// - <none>
+// Return Value:
+// - The number of bytes in each of the caches.
+DxEngine::MemoryUsage DxEngine::GetMemoryUsage() const
+{
+    MemoryUsage usage{};
+    if (_customLayout)
+    {
+        usage.shapedTextCache = _customLayout->ShapedTextCacheMemoryUsage();
+    }
+    if (_fontRenderData)
+    {
+        usage.fontFallbackCache = _fontRenderData->FontFallbackCacheMemoryUsage();
+    }
+    return usage;
+}
+
 void DxEngine::SetRetroTerminalEffect(bool enable) noexcept
 try
 {
@@ -1078,6 +1534,8 @@ try
 {
     RETURN_HR_IF_NULL(E_INVALIDARG, psrRegion);
 
+    _cursorOnlyArea.reset();
+
     if (!_allInvalid)
     {
         _InvalidateRectangle(Viewport::FromExclusive(*psrRegion).ToInclusive());
@@ -1089,14 +1547,40 @@ CATCH_RETURN()
 
 // Routine Description:
 // - Invalidates the cells of the cursor
+// - The whole rows are invalidated like for any other change, because the
+//   glyphs of the neighboring cells may reach into the cursor's cells. If
+//   nothing but the cursor changed since the last frame, we also remember
+//   its cells, so that the frame can be clipped to them and only they
+//   have to be composed when presenting. See StartPaint.
 // Arguments:
 // - psrRegion - the region covered by the cursor
 // Return Value:
 // - S_OK
 [[nodiscard]] HRESULT DxEngine::InvalidateCursor(const SMALL_RECT* const psrRegion) noexcept
+try
 {
-    return Invalidate(psrRegion);
+    RETURN_HR_IF_NULL(E_INVALIDARG, psrRegion);
+
+    if (!_allInvalid)
+    {
+        const til::rectangle cursorArea{ Viewport::FromExclusive(*psrRegion).ToInclusive() };
+
+        if (!_invalidMap.any() && _invalidScroll == til::point{ 0, 0 })
+        {
+            _cursorOnlyArea = cursorArea;
+        }
+        else if (_cursorOnlyArea)
+        {
+            // The cursor moved, so both its old and new cells need to be drawn.
+            _cursorOnlyArea = *_cursorOnlyArea | cursorArea;
+        }
+
+        _InvalidateRectangle(cursorArea);
+    }
+
+    return S_OK;
 }
+CATCH_RETURN()
 
 // Routine Description:
 // - Invalidates a rectangle describing a pixel area on the display
@@ -1109,6 +1593,8 @@ try
 {
     RETURN_HR_IF_NULL(E_INVALIDARG, prcDirtyClient);
 
+    _cursorOnlyArea.reset();
+
     if (!_allInvalid)
     {
         // Dirty client is in pixels. Use divide specialization against glyph factor to make conversion
@@ -1153,6 +1639,11 @@ try
 
     const til::point deltaCells{ *pcoordDelta };
 
+    if (deltaCells != til::point{ 0, 0 })
+    {
+        _cursorOnlyArea.reset();
+    }
+
     if (!_allInvalid)
     {
         if (deltaCells != til::point{ 0, 0 })
@@ -1179,6 +1670,7 @@ try
 {
     _invalidMap.set_all();
     _allInvalid = true;
+    _cursorOnlyArea.reset();
 
     // Since everything is invalidated here, mark this as a "first frame", so
     // that we won't use incremental drawing on it. The caller of this intended
@@ -1274,6 +1766,27 @@ try
 {
     RETURN_HR_IF(E_NOT_VALID_STATE, _isPainting); // invalid to start a paint while painting.
 
+    // Nothing we draw can be seen while the swap chain is occluded, for instance
+    // because its window is minimized. Skip the frame and let the invalid
+    // regions accumulate until a test present says it's visible again.
+    if (_presentOccluded && _dxgiSwapChain)
+    {
+        HRESULT hr = S_OK;
+        {
+            const D2DLock lock{ _d2dMultithread.Get() };
+            hr = _dxgiSwapChain->Present(0, DXGI_PRESENT_TEST);
+        }
+
+        if (hr == DXGI_STATUS_OCCLUDED)
+        {
+            return S_FALSE;
+        }
+        _presentOccluded = false;
+    }
+
+    // The colors an attribute resolves to may have changed since the last frame.
+    _brushAttributes.reset();
+
     // If full repaints are needed then we need to invalidate everything
     // so the entire frame is repainted.
     if (_FullRepaintNeeded())
@@ -1281,6 +1794,13 @@ try
         RETURN_IF_FAILED(InvalidateAll());
     }
 
+    // The framebuffer capture can't be scrolled by Present1 like the swap chain.
+    // Scrolling is rare enough that it's fine to just draw everything again.
+    if (_DrawingToFramebufferCapture() && _invalidScroll != til::point{ 0, 0 })
+    {
+        RETURN_IF_FAILED(InvalidateAll());
+    }
+
     if (TraceLoggingProviderEnabled(g_hDxRenderProvider, WINEVENT_LEVEL_VERBOSE, TIL_KEYWORD_TRACE))
     {
         const auto invalidatedStr = _invalidMap.to_string();
@@ -1296,6 +1816,14 @@ try
 
     if (_isEnabled)
     {
+        // If the last frame never made it to Present, because painting it failed
+        // somewhere along the way, we still need to finish drawing it.
+        if (_endDrawPending)
+        {
+            _endDrawPending = false;
+            LOG_IF_FAILED(_d2dDeviceContext->EndDraw());
+        }
+
         const auto clientSize = _GetClientSize();
         const auto glyphCellSize = _fontRenderData->GlyphCell();
 
@@ -1305,6 +1833,12 @@ try
         {
             RETURN_IF_FAILED(_CreateDeviceResources(true));
         }
+        else if (_DrawingToFramebufferCapture() && _displaySizePixels != clientSize)
+        {
+            // The shader's views hold on to the swap chain buffers, which keeps us from
+            // resizing them, and the framebuffer capture has to be resized as well.
+            RETURN_IF_FAILED(_CreateDeviceResources(true));
+        }
         else if (_displaySizePixels != clientSize || _prevScale != _scale)
         {
             // OK, we're going to play a dangerous game here for the sake of optimizing resize
@@ -1318,6 +1852,12 @@ try
             _d2dDeviceContext->SetTarget(nullptr);
             _d2dBitmap.Reset();
 
+            // Resizing discards the contents of both buffers, so there's nothing left to copy.
+            _backBufferOutdated = false;
+
+            // The window might have entered or left fullscreen.
+            _UpdateAllowTearing();
+
             // Change the buffer size and recreate the render target (and surface)
             RETURN_IF_FAILED(_dxgiSwapChain->ResizeBuffers(2, clientSize.width<UINT>(), clientSize.height<UINT>(), _swapChainDesc.Format, _swapChainDesc.Flags));
             RETURN_IF_FAILED(_PrepareRenderTarget());
@@ -1335,9 +1875,33 @@ try
             RETURN_IF_FAILED(InvalidateAll());
         }
 
+        // The framebuffer capture has to run the shader over the whole frame anyway.
+        if (_DrawingToFramebufferCapture())
+        {
+            _cursorOnlyArea.reset();
+        }
+
+        // Bring the back buffer up to date with the last presented frame, moving it by
+        // any pending scroll, so that we only need to draw the invalid regions on top.
+        // If everything is going to be drawn anyway, we can skip the copy entirely.
+        if (_backBufferOutdated && !_invalidMap.all())
+        {
+            RETURN_IF_FAILED(_CopyFrontToBack());
+        }
+        _backBufferOutdated = false;
+
         _d2dDeviceContext->BeginDraw();
         _isPainting = true;
 
+        // Everything outside of the cursor is still what the last frame
+        // presented, so nothing but the cursor's cells needs to be rasterized.
+        // The text of the invalid rows is still laid out as usual, which
+        // makes sure that glyphs extending into those cells are drawn.
+        if (_cursorOnlyArea)
+        {
+            _d2dDeviceContext->PushAxisAlignedClip(_cursorOnlyArea->scale_up(glyphCellSize), D2D1_ANTIALIAS_MODE_ALIASED);
+        }
+
         {
             // Get the baseline for this font as that's where we draw from
             DWRITE_LINE_SPACING spacing;
@@ -1381,62 +1945,82 @@ try
         // If there's still a clip hanging around, remove it. We're all done.
         LOG_IF_FAILED(_customRenderer->EndClip(_drawingContext.get()));
 
-        hr = _d2dDeviceContext->EndDraw();
+        if (_cursorOnlyArea)
+        {
+            _d2dDeviceContext->PopAxisAlignedClip();
+        }
 
-        if (SUCCEEDED(hr))
+        // So far the drawing commands have only been batched up. Rasterizing them
+        // is left to EndDraw in Present, which runs outside of the console lock.
+        _endDrawPending = true;
+
+        // The pixel shader needs to run again to show what we drew.
+        if (_invalidMap.any())
         {
-            if (_invalidScroll != til::point{ 0, 0 })
-            {
-                // Copy `til::rectangles` into RECT map.
-                _presentDirty.assign(_invalidMap.begin(), _invalidMap.end());
+            _terminalEffectsInvalid = true;
+        }
 
-                // Scale all dirty rectangles into pixels
-                std::transform(_presentDirty.begin(), _presentDirty.end(), _presentDirty.begin(), [&](til::rectangle rc) {
-                    return rc.scale_up(_fontRenderData->GlyphCell());
-                });
+        // Tell Present1 exactly which parts of the frame changed, so that only those
+        // need to be composed. If everything changed, there's nothing to gain from it.
+        // Shaders may move pixels around arbitrarily, so with terminal effects
+        // the entire swap chain is presented and nothing is scrolled.
+        if (_cursorOnlyArea)
+        {
+            // Only the cursor's cells were drawn. The rest of its rows is unchanged.
+            _presentDirty.assign(1, _cursorOnlyArea->scale_up(_fontRenderData->GlyphCell()));
+            _presentParams.DirtyRectsCount = 1;
+            _presentParams.pDirtyRects = _presentDirty.data();
+        }
+        else if (!_invalidMap.all() && !_DrawingToFramebufferCapture())
+        {
+            // Copy `til::rectangles` into RECT map.
+            _presentDirty.assign(_invalidMap.begin(), _invalidMap.end());
 
-                // Invalid scroll is in characters, convert it to pixels.
-                const auto scrollPixels = (_invalidScroll * _fontRenderData->GlyphCell());
+            // Scale all dirty rectangles into pixels
+            std::transform(_presentDirty.begin(), _presentDirty.end(), _presentDirty.begin(), [&](til::rectangle rc) {
+                return rc.scale_up(_fontRenderData->GlyphCell());
+            });
 
-                // The scroll rect is the entire field of cells, but in pixels.
-                til::rectangle scrollArea{ _invalidMap.size() * _fontRenderData->GlyphCell() };
+            // Now fill up the parameters structure from the member variables.
+            _presentParams.DirtyRectsCount = gsl::narrow<UINT>(_presentDirty.size());
+            _presentParams.pDirtyRects = _presentDirty.data();
+        }
 
-                // Reduce the size of the rectangle by the scroll.
-                scrollArea -= til::size{} - scrollPixels;
+        if (_invalidScroll != til::point{ 0, 0 } && !_invalidMap.all() && !_DrawingToFramebufferCapture())
+        {
+            // Invalid scroll is in characters, convert it to pixels.
+            const auto scrollPixels = (_invalidScroll * _fontRenderData->GlyphCell());
 
-                // Assign the area to the present storage
-                _presentScroll = scrollArea;
+            // The scroll rect is the entire field of cells, but in pixels.
+            til::rectangle scrollArea{ _invalidMap.size() * _fontRenderData->GlyphCell() };
 
-                // Pass the offset.
-                _presentOffset = scrollPixels;
+            // Reduce the size of the rectangle by the scroll.
+            scrollArea -= til::size{} - scrollPixels;
 
-                // Now fill up the parameters structure from the member variables.
-                _presentParams.DirtyRectsCount = gsl::narrow<UINT>(_presentDirty.size());
-                _presentParams.pDirtyRects = _presentDirty.data();
+            // Assign the area to the present storage
+            _presentScroll = scrollArea;
 
-                _presentParams.pScrollOffset = &_presentOffset;
-                _presentParams.pScrollRect = &_presentScroll;
+            // Pass the offset.
+            _presentOffset = scrollPixels;
 
-                // The scroll rect will be empty if we scrolled >= 1 full screen size.
-                // Present1 doesn't like that. So clear it out. Everything will be dirty anyway.
-                if (IsRectEmpty(&_presentScroll))
-                {
-                    _presentParams.pScrollRect = nullptr;
-                    _presentParams.pScrollOffset = nullptr;
-                }
-            }
+            _presentParams.pScrollOffset = &_presentOffset;
+            _presentParams.pScrollRect = &_presentScroll;
 
-            _presentReady = true;
-        }
-        else
-        {
-            _presentReady = false;
-            _ReleaseDeviceResources();
+            // The scroll rect will be empty if we scrolled >= 1 full screen size.
+            // Present1 doesn't like that. So clear it out. Everything will be dirty anyway.
+            if (IsRectEmpty(&_presentScroll))
+            {
+                _presentParams.pScrollRect = nullptr;
+                _presentParams.pScrollOffset = nullptr;
+            }
         }
+
+        _presentReady = true;
     }
 
     _invalidMap.reset_all();
     _allInvalid = false;
+    _cursorOnlyArea.reset();
 
     _invalidScroll = {};
 
@@ -1448,6 +2032,10 @@ CATCH_RETURN()
 // - Copies the front surface of the swap chain (the one being displayed)
 //   to the back surface of the swap chain (the one we draw on next)
 //   so we can draw on top of what's already there.
+// - If the frame we're about to draw has been scrolled, the field of cells
+//   is copied shifted by the scroll offset instead. The area it uncovers is
+//   invalid and will be drawn over, so scrolling only costs us a blit
+//   and the newly revealed rows, not a redraw of the whole viewport.
 // Arguments:
 // - <none>
 // Return Value:
@@ -1456,13 +2044,51 @@ CATCH_RETURN()
 {
     try
     {
-        Microsoft::WRL::ComPtr<ID3D11Resource> backBuffer;
-        Microsoft::WRL::ComPtr<ID3D11Resource> frontBuffer;
+        Microsoft::WRL::ComPtr<ID3D11Texture2D> backBuffer;
+        Microsoft::WRL::ComPtr<ID3D11Texture2D> frontBuffer;
 
         RETURN_IF_FAILED(_dxgiSwapChain->GetBuffer(0, IID_PPV_ARGS(&backBuffer)));
         RETURN_IF_FAILED(_dxgiSwapChain->GetBuffer(1, IID_PPV_ARGS(&frontBuffer)));
 
-        _d3dDeviceContext->CopyResource(backBuffer.Get(), frontBuffer.Get());
+        const D2DLock lock{ _d2dMultithread.Get() };
+
+        if (_invalidScroll == til::point{ 0, 0 })
+        {
+            _d3dDeviceContext->CopyResource(backBuffer.Get(), frontBuffer.Get());
+            return S_OK;
+        }
+
+        D3D11_TEXTURE2D_DESC desc{};
+        backBuffer->GetDesc(&desc);
+
+        const til::rectangle surface{ til::size{ static_cast<ptrdiff_t>(desc.Width), static_cast<ptrdiff_t>(desc.Height) } };
+        const til::rectangle cells{ _invalidMap.size() * _fontRenderData->GlyphCell() };
+        const auto scrollPixels = _invalidScroll * _fontRenderData->GlyphCell();
+
+        const auto copyRegion = [&](const til::rectangle& destination, const til::point offset) {
+            if (destination.empty())
+            {
+                return;
+            }
+
+            const auto source = destination - offset;
+            const D3D11_BOX box{
+                source.left<UINT>(),
+                source.top<UINT>(),
+                0,
+                source.right<UINT>(),
+                source.bottom<UINT>(),
+                1,
+            };
+            _d3dDeviceContext->CopySubresourceRegion(backBuffer.Get(), 0, destination.left<UINT>(), destination.top<UINT>(), 0, frontBuffer.Get(), 0, &box);
+        };
+
+        // The field of cells moves by the scroll offset...
+        copyRegion(cells & (cells + scrollPixels) & surface, scrollPixels);
+
+        // ...while the padding to the right and below it stays where it was.
+        copyRegion(til::rectangle{ cells.right(), ptrdiff_t{ 0 }, surface.right(), surface.bottom() } & surface, {});
+        copyRegion(til::rectangle{ ptrdiff_t{ 0 }, cells.bottom(), cells.right(), surface.bottom() } & surface, {});
     }
     CATCH_RETURN();
 
@@ -1478,9 +2104,8 @@ CATCH_RETURN()
 [[nodiscard]] bool DxEngine::RequiresContinuousRedraw() noexcept
 {
     // We're only going to request continuous redraw if someone is using
-    // a pixel shader from a path because we cannot tell if those are using the
-    // time parameter or not.
-    // And if they are using time, they probably need it to tick continuously.
+    // a pixel shader that reads the time parameter, which we find out when
+    // compiling it. If they are using time, they probably need it to tick continuously.
     //
     // By contrast, the in-built retro effect does NOT need it,
     // so let's not tick for it and save some amount of performance.
@@ -1488,7 +2113,7 @@ CATCH_RETURN()
     // Finally... if we're not using effects at all... let the render thread
     // go to sleep. It deserves it. That thread works hard. Also it sleeping
     // saves battery power and all sorts of related perf things.
-    return _terminalEffectsEnabled && !_pixelShaderPath.empty();
+    return _HasTerminalEffects() && _pixelShaderLoaded && _pixelShaderUsesTime;
 }
 
 // Method Description:
@@ -1520,16 +2145,42 @@ void DxEngine::WaitUntilCanRender() noexcept
 // - S_OK on success, E_PENDING to indicate a retry or a relevant DirectX error
 [[nodiscard]] HRESULT DxEngine::Present() noexcept
 {
+    if (_endDrawPending)
+    {
+        _endDrawPending = false;
+
+        const auto hr = _d2dDeviceContext->EndDraw();
+        if (FAILED(hr))
+        {
+            _presentReady = false;
+            _ReleaseDeviceResources();
+            return hr;
+        }
+    }
+
     if (_presentReady)
     {
-        if (_HasTerminalEffects() && _pixelShaderLoaded)
+        if (_DrawingToFramebufferCapture())
         {
+            // The swap chain only ever receives the shader's output. If nothing was drawn
+            // and the shader doesn't animate, what's on the screen is still up to date.
+            if (!_terminalEffectsInvalid && !_pixelShaderUsesTime)
+            {
+                _presentReady = false;
+                return S_OK;
+            }
+
             const HRESULT hr2 = _PaintTerminalEffects();
             if (FAILED(hr2))
             {
-                _pixelShaderLoaded = false;
+                // Go back to drawing into the swap chain directly.
+                _terminalEffectsEnabled = false;
+                _recreateDeviceRequested = true;
+                LOG_IF_FAILED(InvalidateAll());
                 LOG_HR_MSG(hr2, "Failed to paint terminal effects. Disabling.");
             }
+
+            _terminalEffectsInvalid = false;
         }
 
         try
@@ -1538,11 +2189,22 @@ void DxEngine::WaitUntilCanRender() noexcept
 
             bool recreate = false;
 
+            // With tearing allowed, the frame is shown right away instead of on the next vertical blank.
+            const UINT syncInterval = _allowTearing ? 0 : 1;
+            const UINT presentFlags = _allowTearing ? DXGI_PRESENT_ALLOW_TEARING : 0;
+
+            // Presenting uses the device context, which may be shared with other engines.
+            // The lock is only held while presenting, because releasing the device
+            // resources further below needs the shared device slot.
+            //
             // On anything but the first frame, try partial presentation.
             // We'll do it first because if it fails, we'll try again with full presentation.
             if (!_firstFrame)
             {
-                hr = _dxgiSwapChain->Present1(1, 0, &_presentParams);
+                {
+                    const D2DLock lock{ _d2dMultithread.Get() };
+                    hr = _dxgiSwapChain->Present1(syncInterval, presentFlags, &_presentParams);
+                }
 
                 // These two error codes are indicated for destroy-and-recreate
                 // If we were told to destroy-and-recreate, we're going to skip straight into doing that
@@ -1563,13 +2225,19 @@ void DxEngine::WaitUntilCanRender() noexcept
             // In both of these circumstances, do a full presentation.
             if (_firstFrame || (FAILED(hr) && !recreate))
             {
-                hr = _dxgiSwapChain->Present(1, 0);
+                {
+                    const D2DLock lock{ _d2dMultithread.Get() };
+                    hr = _dxgiSwapChain->Present(syncInterval, presentFlags);
+                }
                 _firstFrame = false;
 
                 // These two error codes are indicated for destroy-and-recreate
                 recreate = hr == DXGI_ERROR_DEVICE_REMOVED || hr == DXGI_ERROR_DEVICE_RESET;
             }
 
+            // This is a success code. StartPaint holds off on further frames until it clears.
+            _presentOccluded = hr == DXGI_STATUS_OCCLUDED;
+
             // Now check for failure cases from either presentation mode.
             if (FAILED(hr))
             {
@@ -1588,14 +2256,12 @@ void DxEngine::WaitUntilCanRender() noexcept
                 }
             }
 
-            // If we are doing full repaints we don't need to copy front buffer to back buffer
-            if (!_FullRepaintNeeded())
-            {
-                // Finally copy the front image (being presented now) onto the backing buffer
-                // (where we are about to draw the next frame) so we can draw only the differences
-                // next frame.
-                RETURN_IF_FAILED(_CopyFrontToBack());
-            }
+            // The back buffer (where we are about to draw the next frame) now holds
+            // an older frame than the one being presented. We'll copy the front image
+            // onto it at the start of the next frame, once we know how far it scrolled,
+            // so that we can draw only the differences.
+            // With terminal effects we draw into the framebuffer capture instead, which is never outdated.
+            _backBufferOutdated = !_FullRepaintNeeded() && !_DrawingToFramebufferCapture();
 
             _presentReady = false;
 
@@ -1603,6 +2269,15 @@ void DxEngine::WaitUntilCanRender() noexcept
             _presentOffset = { 0 };
             _presentScroll = { 0 };
             _presentParams = { 0 };
+
+            if (_pfnPresentCallback)
+            {
+                try
+                {
+                    _pfnPresentCallback();
+                }
+                CATCH_LOG(); // A failure in the notification function isn't a failure to present.
+            }
         }
         CATCH_RETURN();
     }
@@ -1637,6 +2312,9 @@ try
         nothing = _backgroundColor;
     }
 
+    // Remember what we cleared to, so that PaintBufferLine can skip painting the same color over it.
+    _clearColor = nothing;
+
     // If the entire thing is invalid, just use one big clear operation.
     if (_invalidMap.all())
     {
@@ -1687,8 +2365,26 @@ try
     RETURN_IF_FAILED(_customLayout->Reset());
     RETURN_IF_FAILED(_customLayout->AppendClusters(clusters));
 
+    // The background of the whole line is filled by the first glyph run that's drawn.
+    // Colorful output mostly changes the foreground color, so most of the time the
+    // background is just what PaintBackground already cleared this area to. Skip it then.
+    _drawingContext->backgroundRect.reset();
+    if (!_IsBackgroundCleared(_backgroundColor))
+    {
+        const auto columns = std::accumulate(clusters.begin(), clusters.end(), size_t{ 0 }, [](const size_t sum, const Cluster& cluster) noexcept {
+            return sum + cluster.GetColumns();
+        });
+        const auto cellSize = _fontRenderData->GlyphCell();
+        _drawingContext->backgroundRect = D2D1::RectF(origin.x,
+                                                      origin.y,
+                                                      origin.x + static_cast<float>(columns) * cellSize.width<float>(),
+                                                      origin.y + cellSize.height<float>());
+    }
+
     // Layout then render the text
-    RETURN_IF_FAILED(_customLayout->Draw(_drawingContext.get(), _customRenderer.Get(), origin.x, origin.y));
+    const auto hr = _customLayout->Draw(_drawingContext.get(), _customRenderer.Get(), origin.x, origin.y);
+    _drawingContext->backgroundRect.reset();
+    RETURN_IF_FAILED(hr);
 
     return S_OK;
 }
@@ -1863,37 +2559,29 @@ CATCH_RETURN()
 try
 {
     // Should have been initialized.
-    RETURN_HR_IF(E_NOT_VALID_STATE, !_framebufferCapture);
-
-    // Capture current frame in swap chain to a texture.
-    ::Microsoft::WRL::ComPtr<ID3D11Texture2D> swapBuffer;
-    RETURN_IF_FAILED(_dxgiSwapChain->GetBuffer(0, IID_PPV_ARGS(&swapBuffer)));
-    _d3dDeviceContext->CopyResource(_framebufferCapture.Get(), swapBuffer.Get());
-
-    // Prepare captured texture as input resource to shader program.
-    D3D11_TEXTURE2D_DESC desc;
-    _framebufferCapture->GetDesc(&desc);
-
-    D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc;
-    srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
-    srvDesc.Texture2D.MostDetailedMip = 0;
-    srvDesc.Texture2D.MipLevels = desc.MipLevels;
-    srvDesc.Format = desc.Format;
-
-    ::Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> shaderResource;
-    RETURN_IF_FAILED(_d3dDevice->CreateShaderResourceView(_framebufferCapture.Get(), &srvDesc, &shaderResource));
+    // The frame has already been drawn into the capture by Direct2D.
+    RETURN_HR_IF(E_NOT_VALID_STATE, !_framebufferCaptureView);
 
     // Render the screen quad with shader effects.
     const UINT stride = sizeof(ShaderInput);
     const UINT offset = 0;
 
+    // The device context may be shared with other engines (and Direct2D),
+    // so we can't rely on any state we set up earlier still being there.
+    D3D11_VIEWPORT vp{};
+    vp.Width = _displaySizePixels.width<float>();
+    vp.Height = _displaySizePixels.height<float>();
+    vp.MaxDepth = 1.0f;
+
+    const D2DLock lock{ _d2dMultithread.Get() };
+    _d3dDeviceContext->RSSetViewports(1, &vp);
     _d3dDeviceContext->OMSetRenderTargets(1, _renderTargetView.GetAddressOf(), nullptr);
     _d3dDeviceContext->IASetVertexBuffers(0, 1, _screenQuadVertexBuffer.GetAddressOf(), &stride, &offset);
     _d3dDeviceContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP);
     _d3dDeviceContext->IASetInputLayout(_vertexLayout.Get());
     _d3dDeviceContext->VSSetShader(_vertexShader.Get(), nullptr, 0);
     _d3dDeviceContext->PSSetShader(_pixelShader.Get(), nullptr, 0);
-    _d3dDeviceContext->PSSetShaderResources(0, 1, shaderResource.GetAddressOf());
+    _d3dDeviceContext->PSSetShaderResources(0, 1, _framebufferCaptureView.GetAddressOf());
     _d3dDeviceContext->PSSetSamplers(0, 1, _samplerState.GetAddressOf());
     _d3dDeviceContext->PSSetConstantBuffers(0, 1, _pixelShaderSettingsBuffer.GetAddressOf());
     _d3dDeviceContext->Draw(ARRAYSIZE(_screenQuadVertices), 0);
@@ -1907,11 +2595,48 @@ CATCH_RETURN()
     // If someone explicitly requested differential rendering off, then we need to invalidate everything
     // so the entire frame is repainted.
     //
-    // If terminal effects are on, we must invalidate everything for them to draw correctly.
-    // Yes, this will further impact the performance of terminal effects.
-    // But we're talking about running the entire display pipeline through a shader for
-    // cosmetic effect, so performance isn't likely the top concern with this feature.
-    return _forceFullRepaintRendering || _HasTerminalEffects();
+    // Terminal effects don't need this. We draw into the framebuffer capture, which
+    // keeps its contents, and the shader always redraws the whole swap chain from it.
+    return _forceFullRepaintRendering;
+}
+
+// Routine Description:
+// - Decides whether to present with tearing allowed. We only do that while our
+//   window covers its entire monitor, as otherwise DWM composes it with the
+//   rest of the desktop anyway and tearing can't take effect.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void DxEngine::_UpdateAllowTearing() noexcept
+{
+    _allowTearing = false;
+
+    if (_tearingSupported && _chainMode == SwapChainMode::ForHwnd)
+    {
+        RECT windowRect{};
+        MONITORINFO monitorInfo{};
+        monitorInfo.cbSize = sizeof(monitorInfo);
+        if (GetWindowRect(_hwndTarget, &windowRect) &&
+            GetMonitorInfoW(MonitorFromWindow(_hwndTarget, MONITOR_DEFAULTTONEAREST), &monitorInfo))
+        {
+            const auto& monitorRect = monitorInfo.rcMonitor;
+            _allowTearing = windowRect.left <= monitorRect.left && windowRect.top <= monitorRect.top &&
+                            windowRect.right >= monitorRect.right && windowRect.bottom >= monitorRect.bottom;
+        }
+    }
+}
+
+// Routine Description:
+// - Checks whether Direct2D is drawing into the framebuffer capture for the
+//   pixel shader, rather than straight into the swap chain.
+// Arguments:
+// - <none>
+// Return Value:
+// - True if the pixel shader is set up and draws the swap chain's contents.
+[[nodiscard]] bool DxEngine::_DrawingToFramebufferCapture() const noexcept
+{
+    return _pixelShaderLoaded && _framebufferCapture != nullptr;
 }
 
 // Routine Description:
@@ -1928,6 +2653,15 @@ CATCH_RETURN()
                                                      const bool /*usingSoftFont*/,
                                                      const bool isSettingDefaultBrushes) noexcept
 {
+    // Consecutive runs, for instance the last one of a row and the first one of the next,
+    // commonly share their attributes. Everything below only depends on the attributes and
+    // on state that can't change in the middle of a frame, so there's nothing to update then.
+    if (!isSettingDefaultBrushes && _brushAttributes == textAttributes)
+    {
+        return S_OK;
+    }
+    _brushAttributes = textAttributes;
+
     // GH#5098: If we're rendering with cleartype text, we need to always render
     // onto an opaque background. If our background's opacity is 1.0f, that's
     // great, we can actually use cleartype in that case. In that scenario
@@ -10,6 +10,7 @@
 #include <dxgi.h>
 #include <dxgi1_2.h>
 #include <dxgi1_3.h>
+#include <dxgi1_5.h>
 
 #include <d3d11.h>
 #include <d2d1.h>
@@ -52,18 +53,31 @@ namespace Microsoft::Console::Render
         [[nodiscard]] HRESULT Enable() noexcept;
         [[nodiscard]] HRESULT Disable() noexcept;
 
+        // Creates a Direct3D device on the thread pool for the next DxEngine in this process to pick up,
+        // so that opening another terminal doesn't have to wait on device creation.
+        static void s_PrewarmDevice() noexcept;
+
         [[nodiscard]] HRESULT SetHwnd(const HWND hwnd) noexcept;
 
         [[nodiscard]] HRESULT SetWindowSize(const SIZE pixels) noexcept;
 
         void SetCallback(std::function<void()> pfn);
         void SetWarningCallback(std::function<void(const HRESULT)> pfn);
+        void SetPresentCallback(std::function<void()> pfn);
 
         void ToggleShaderEffects();
 
         bool GetRetroTerminalEffect() const noexcept;
         void SetRetroTerminalEffect(bool enable) noexcept;
 
+        // How many bytes the engine's caches hold on to. Must not be called while painting.
+        struct MemoryUsage
+        {
+            size_t shapedTextCache;
+            size_t fontFallbackCache;
+        };
+        MemoryUsage GetMemoryUsage() const;
+
         void SetPixelShaderPath(std::wstring_view value) noexcept;
 
         void SetForceFullRepaintRendering(bool enable) noexcept;
@@ -137,6 +151,7 @@ namespace Microsoft::Console::Render
         [[nodiscard]] HRESULT _DoUpdateTitle(_In_ const std::wstring_view newTitle) noexcept override;
         [[nodiscard]] HRESULT _PaintTerminalEffects() noexcept;
         [[nodiscard]] bool _FullRepaintNeeded() const noexcept;
+        void _UpdateAllowTearing() noexcept;
 
     private:
         enum class SwapChainMode
@@ -155,6 +170,7 @@ namespace Microsoft::Console::Render
 
         std::function<void()> _pfn;
         std::function<void(const HRESULT)> _pfnWarningCallback;
+        std::function<void()> _pfnPresentCallback;
 
         bool _isEnabled;
         bool _isPainting;
@@ -166,6 +182,9 @@ namespace Microsoft::Console::Render
 
         D2D1_COLOR_F _foregroundColor;
         D2D1_COLOR_F _backgroundColor;
+        // The attributes the brushes were last updated for during the current frame.
+        std::optional<TextAttribute> _brushAttributes;
+        D2D1_COLOR_F _clearColor;
         D2D1_COLOR_F _selectionBackground;
 
         uint16_t _hyperlinkHoveredId;
@@ -175,8 +194,20 @@ namespace Microsoft::Console::Render
         til::pmr::bitmap _invalidMap;
         til::point _invalidScroll;
         bool _allInvalid;
+        // Set while the cursor is the only thing that was invalidated since the
+        // last frame, for instance when it blinks. Such a frame is clipped to the
+        // cells of the cursor and only those are presented.
+        std::optional<til::rectangle> _cursorOnlyArea;
 
         bool _presentReady;
+        bool _backBufferOutdated;
+        bool _endDrawPending;
+        // Set when the last Present returned DXGI_STATUS_OCCLUDED.
+        bool _presentOccluded{ false };
+        // Whether the swap chain was created with DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING,
+        // and whether we present with DXGI_PRESENT_ALLOW_TEARING right now.
+        bool _tearingSupported{ false };
+        bool _allowTearing{ false };
         std::vector<RECT> _presentDirty;
         RECT _presentScroll;
         POINT _presentOffset;
@@ -204,6 +235,10 @@ namespace Microsoft::Console::Render
         // Device-Dependent Resources
         bool _recreateDeviceRequested;
         bool _haveDeviceResources;
+        // True if the devices below are the ones shared by all hardware engines.
+        // _d2dMultithread is then the lock that guards the shared D3D device context.
+        bool _usingSharedDevice{ false };
+        ::Microsoft::WRL::ComPtr<ID2D1Multithread> _d2dMultithread;
         ::Microsoft::WRL::ComPtr<ID3D11Device> _d3dDevice;
         ::Microsoft::WRL::ComPtr<ID3D11DeviceContext> _d3dDeviceContext;
 
@@ -238,6 +273,8 @@ namespace Microsoft::Console::Render
         //  Allows user to load a pixel shader from a few presets or from a file path
         std::wstring _pixelShaderPath;
         bool _pixelShaderLoaded{ false };
+        bool _pixelShaderUsesTime{ false };
+        bool _terminalEffectsInvalid{ false };
 
         std::chrono::steady_clock::time_point _shaderStartTime;
 
@@ -250,6 +287,7 @@ namespace Microsoft::Console::Render
         ::Microsoft::WRL::ComPtr<ID3D11Buffer> _pixelShaderSettingsBuffer;
         ::Microsoft::WRL::ComPtr<ID3D11SamplerState> _samplerState;
         ::Microsoft::WRL::ComPtr<ID3D11Texture2D> _framebufferCapture;
+        ::Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> _framebufferCaptureView;
 
         // Preferences and overrides
         bool _softwareRendering;
@@ -274,9 +312,15 @@ namespace Microsoft::Console::Render
         } _pixelShaderSettings;
 
         [[nodiscard]] HRESULT _CreateDeviceResources(const bool createSwapChain) noexcept;
+        [[nodiscard]] static HRESULT s_CreateD3DDevice(const bool softwareRendering,
+                                                       ::Microsoft::WRL::ComPtr<ID3D11Device>& device,
+                                                       ::Microsoft::WRL::ComPtr<ID3D11DeviceContext>& deviceContext) noexcept;
+        [[nodiscard]] HRESULT _AcquireSharedDevice() noexcept;
+        void _ReleaseSharedDevice() noexcept;
         [[nodiscard]] HRESULT _CreateSurfaceHandle() noexcept;
 
         bool _HasTerminalEffects() const noexcept;
+        [[nodiscard]] bool _DrawingToFramebufferCapture() const noexcept;
         std::string _LoadPixelShaderFile() const;
         HRESULT _SetupTerminalEffects();
         void _ComputePixelShaderSettings() noexcept;
@@ -286,6 +330,7 @@ namespace Microsoft::Console::Render
         void _ReleaseDeviceResources() noexcept;
 
         bool _ShouldForceGrayscaleAA() noexcept;
+        [[nodiscard]] bool _IsBackgroundCleared(const D2D1_COLOR_F& color) const noexcept;
 
         [[nodiscard]] HRESULT _CreateTextLayout(
             _In_reads_(StringLength) PCWCHAR String,
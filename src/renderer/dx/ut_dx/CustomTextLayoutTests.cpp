@@ -97,4 +97,98 @@ class Microsoft::Console::Render::CustomTextLayoutTests
         VERIFY_ARE_EQUAL(1u, layout._runs.at(1).glyphStart);
         VERIFY_ARE_EQUAL(3u, layout._runs.at(1).glyphCount);
     }
+
+    TEST_METHOD(RestoreShapedText)
+    {
+        CustomTextLayout layout;
+        layout._fontInUse = nullptr;
+
+        layout._text = L"fi";
+        layout._textClusterColumns = { 1, 1 };
+        layout._glyphIndices = { 19, 81 };
+        layout._glyphClusters = { 0, 1 };
+        layout._glyphAdvances = { 8.f, 8.f };
+        layout._glyphOffsets.resize(2);
+
+        CustomTextLayout::LinkedRun run;
+        run.textStart = 0;
+        run.textLength = 2;
+        run.glyphStart = 0;
+        run.glyphCount = 2;
+        layout._runs.push_back(run);
+
+        layout._StoreShapedText();
+
+        // Different spacing of the same text must not be mistaken for it.
+        layout._textClusterColumns = { 2, 2 };
+        VERIFY_IS_FALSE(layout._RestoreShapedText());
+
+        layout._runs.clear();
+        layout._glyphIndices.clear();
+        layout._textClusterColumns = { 1, 1 };
+        VERIFY_IS_TRUE(layout._RestoreShapedText());
+
+        VERIFY_ARE_EQUAL(1u, layout._runs.size());
+        VERIFY_ARE_EQUAL(2u, layout._runs.at(0).glyphCount);
+        VERIFY_ARE_EQUAL(2u, layout._glyphIndices.size());
+        VERIFY_ARE_EQUAL(81u, layout._glyphIndices.at(1));
+    }
+
+    TEST_METHOD(ShapedTextCacheEvictsLeastRecentlyUsed)
+    {
+        CustomTextLayout layout;
+        layout._fontInUse = nullptr;
+        layout._textClusterColumns = { 1 };
+
+        layout._text = L"a";
+        layout._StoreShapedText();
+
+        // Fill up the rest of the cache, touching "a" halfway through so it's kept.
+        for (size_t i = 1; i <= CustomTextLayout::s_shapedTextCacheSize; ++i)
+        {
+            layout._text = std::to_wstring(i);
+            if (i == CustomTextLayout::s_shapedTextCacheSize / 2)
+            {
+                layout._text = L"a";
+                VERIFY_IS_TRUE(layout._RestoreShapedText());
+                layout._text = std::to_wstring(i);
+            }
+            layout._StoreShapedText();
+        }
+
+        VERIFY_ARE_EQUAL(CustomTextLayout::s_shapedTextCacheSize, layout._shapedTexts.size());
+        VERIFY_ARE_EQUAL(CustomTextLayout::s_shapedTextCacheSize, layout._shapedTextMap.size());
+
+        layout._text = L"a";
+        VERIFY_IS_TRUE(layout._RestoreShapedText());
+        layout._text = L"1";
+        VERIFY_IS_FALSE(layout._RestoreShapedText());
+    }
+
+    TEST_METHOD(FontFallbackCacheMapsKnownCodepoints)
+    {
+        FontFallbackCache cache;
+        std::vector<FontFallbackCache::Run> runs;
+
+        cache.Insert(L"\u4F60\u597D", nullptr, 1.0f);
+        cache.Insert(L"\U0001F600", nullptr, 0.5f);
+
+        Log::Comment(L"Text made of known codepoints is split into runs of the same face and scale.");
+        VERIFY_IS_TRUE(cache.Lookup(L"\u597D\u4F60\U0001F600\u4F60", runs));
+        VERIFY_ARE_EQUAL(3u, runs.size());
+        VERIFY_ARE_EQUAL(2u, runs.at(0).length);
+        VERIFY_ARE_EQUAL(1.0f, runs.at(0).scale);
+        VERIFY_ARE_EQUAL(2u, runs.at(1).length);
+        VERIFY_ARE_EQUAL(0.5f, runs.at(1).scale);
+        VERIFY_ARE_EQUAL(1u, runs.at(2).length);
+
+        Log::Comment(L"Any unknown codepoint means that the text needs to be mapped.");
+        VERIFY_IS_FALSE(cache.Lookup(L"\u4F60a", runs));
+
+        Log::Comment(L"Text that contains combining codepoints is never remembered.");
+        cache.Insert(L"e\u0301", nullptr, 1.0f);
+        VERIFY_IS_FALSE(cache.Lookup(L"e", runs));
+        cache.Insert(L"\U0001F44D\U0001F3FD", nullptr, 1.0f);
+        VERIFY_IS_FALSE(cache.Lookup(L"\U0001F44D", runs));
+    }
 };
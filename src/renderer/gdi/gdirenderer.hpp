@@ -107,6 +107,10 @@ namespace Microsoft::Console::Render
         size_t _cPolyText;
         [[nodiscard]] HRESULT _FlushBufferLines() noexcept;
 
+        // Gridlines are queued alongside the lines above and drawn on top of them when
+        // they're flushed. All queued gridlines share the same color.
+        COLORREF _gridlineColor;
+
         std::vector<RECT> cursorInvertRects;
         XFORM cursorInvertTransform;
 
@@ -148,12 +152,48 @@ namespace Microsoft::Console::Render
         XFORM _currentLineTransform;
         LineRendition _currentLineRendition;
 
+        // Lines with a double width or height are drawn with a scaled font, which is
+        // slow to rasterize. What their runs looked like is kept as bitmaps, so that
+        // painting the same run at the same place again (for instance because the
+        // cursor blinked on an unchanged banner) is only a blit.
+        struct ScaledLineKey
+        {
+            std::wstring text;
+            std::basic_string<int> widths;
+            RECT rect; // where the run is drawn, in device coordinates
+            POINT origin; // where its text starts, in device coordinates
+            COLORREF fg;
+            COLORREF bg;
+            FontType fontType;
+            LineRendition lineRendition;
+
+            bool operator==(const ScaledLineKey& other) const noexcept;
+        };
+
+        struct ScaledLineBitmap
+        {
+            ScaledLineKey key;
+            wil::unique_hbitmap bitmap;
+            uint64_t lastUsed;
+        };
+
+        static constexpr size_t s_scaledLineCacheSize = 64;
+        std::vector<ScaledLineBitmap> _scaledLineCache;
+        uint64_t _scaledLineCacheClock = 0;
+        wil::unique_hdc _hdcScaledLineCache;
+
+        ScaledLineBitmap* _FindScaledLine(const ScaledLineKey& key) noexcept;
+        [[nodiscard]] HRESULT _CacheScaledLine(ScaledLineKey&& key) noexcept;
+        [[nodiscard]] HRESULT _CopyScaledLine(const ScaledLineBitmap& entry, const bool toSurface) noexcept;
+        void _ClearScaledLineCache() noexcept;
+
         // Memory pooling to save alloc/free work to the OS for things
         // frequently created and dropped.
         // It's important the pool is first so it can be given to the others on construction.
         std::pmr::unsynchronized_pool_resource _pool;
         std::pmr::vector<std::pmr::wstring> _polyStrings;
         std::pmr::vector<std::pmr::basic_string<int>> _polyWidths;
+        std::pmr::vector<RECT> _gridlineRects;
 
         [[nodiscard]] HRESULT _InvalidCombine(const RECT* const prc) noexcept;
         [[nodiscard]] HRESULT _InvalidOffset(const POINT* const ppt) noexcept;
@@ -180,12 +180,23 @@ HRESULT GdiEngine::_InvalidOffset(const POINT* const ppt) noexcept
         RETURN_IF_FAILED(LongAdd(_rcInvalid.top, ppt->y, &rcInvalidNew.top));
         RETURN_IF_FAILED(LongAdd(_rcInvalid.bottom, ppt->y, &rcInvalidNew.bottom));
 
-        // Add the scrolled invalid rectangle to what was left behind to get the new invalid area.
-        // This is the equivalent of adding in the "update rectangle" that we would get out of ScrollWindowEx/ScrollDC.
-        UnionRect(&_rcInvalid, &_rcInvalid, &rcInvalidNew);
+        // The stale contents of the invalid area move along with the scroll, so only their new
+        // position needs repainting. What's left behind is either filled with valid contents
+        // from elsewhere on the screen, or it's part of the "update rectangle" that
+        // ScrollFrame gets out of ScrollDC and adds in when the scroll is actually performed.
+        _rcInvalid = rcInvalidNew;
 
         // Ensure invalid areas remain within bounds of window.
         RETURN_IF_FAILED(_InvalidRestrict());
+
+        // If the invalid area was scrolled out of the window entirely, there's nothing left to
+        // repaint. We mustn't keep the empty rectangle around, or combining it with the next
+        // invalid area would stretch that to the edge of the window.
+        if (IsRectEmpty(&_rcInvalid))
+        {
+            _rcInvalid = { 0 };
+            _fInvalidRectUsed = false;
+        }
     }
 
     return S_OK;
@@ -114,6 +114,15 @@ using namespace Microsoft::Console::Render;
     RETURN_IF_FAILED(LongSub(_szMemorySurface.cx, szGutter.cx, &rcScrollLimit.right));
     RETURN_IF_FAILED(LongSub(_szMemorySurface.cy, szGutter.cy, &rcScrollLimit.bottom));
 
+    // If we scrolled by at least a whole screen, nothing we have can be reused.
+    // Skip the blits and repaint the scrollable area instead.
+    if (std::abs(_szInvalidScroll.cx) >= rcScrollLimit.right || std::abs(_szInvalidScroll.cy) >= rcScrollLimit.bottom)
+    {
+        LOG_IF_FAILED(_InvalidCombine(&rcScrollLimit));
+        _psInvalidData.rcPaint = _rcInvalid;
+        return S_OK;
+    }
+
     // Scroll real window and memory buffer in-sync.
     LOG_LAST_ERROR_IF(!ScrollWindowEx(_hwndTargetWindow,
                                       _szInvalidScroll.cx,
@@ -401,6 +410,69 @@ using namespace Microsoft::Console::Render;
         const auto topOffset = _currentLineRendition == LineRendition::DoubleHeightBottom ? halfHeight : 0;
         const auto bottomOffset = _currentLineRendition == LineRendition::DoubleHeightTop ? halfHeight : 0;
 
+        // Runs of lines with a double width or height are painted from the cache if
+        // they were painted at the same place before (see _scaledLineCache).
+        std::optional<ScaledLineKey> scaledLineKey;
+        if (_currentLineRendition != LineRendition::SingleWidth)
+        {
+            POINT points[]{
+                { ptDraw.x + (trimLeft ? coordFontSize.X : 0), ptDraw.y + topOffset },
+                { ptDraw.x + gsl::narrow<LONG>(cchCharWidths), ptDraw.y + coordFontSize.Y - bottomOffset },
+                ptDraw,
+            };
+            RETURN_HR_IF(E_FAIL, !LPtoDP(_hdcMemoryContext, &points[0], gsl::narrow_cast<int>(std::size(points))));
+
+            auto& key = scaledLineKey.emplace();
+            key.text.assign(polyString.data(), polyString.size());
+            key.widths.assign(polyWidth.data(), polyWidth.size());
+            key.rect = { points[0].x, points[0].y, points[1].x, points[1].y };
+            key.origin = points[2];
+            key.fg = _lastFg;
+            key.bg = _lastBg;
+            key.fontType = _lastFontType;
+            key.lineRendition = _currentLineRendition;
+
+            if (const auto entry = _FindScaledLine(key))
+            {
+                _polyStrings.pop_back();
+                _polyWidths.pop_back();
+                // The queued lines were meant to be drawn underneath this one.
+                RETURN_IF_FAILED(_FlushBufferLines());
+                return _CopyScaledLine(*entry, true);
+            }
+        }
+
+        // If this run continues the previously queued one on the same line, we append
+        // it to that one instead, so that they're drawn with a single ExtTextOut call.
+        // That's only possible if every character still has its own width entry
+        // (which isn't the case after a raster font code page conversion).
+        // Scaled runs aren't combined, because they're cached one by one.
+        if (_cPolyText > 0 && !trimLeft && !scaledLineKey && polyString.size() == polyWidth.size() && _polyStrings.size() >= 2)
+        {
+            auto& prevPolyTextLine = _pPolyText[_cPolyText - 1];
+            auto& prevPolyString = _polyStrings[_polyStrings.size() - 2];
+            auto& prevPolyWidth = _polyWidths[_polyWidths.size() - 2];
+
+            if (prevPolyTextLine.lpstr == prevPolyString.data() &&
+                prevPolyTextLine.n == prevPolyWidth.size() &&
+                prevPolyTextLine.y == ptDraw.y &&
+                prevPolyTextLine.rcl.right == ptDraw.x &&
+                prevPolyTextLine.rcl.top == ptDraw.y + topOffset &&
+                prevPolyTextLine.rcl.bottom == ptDraw.y + coordFontSize.Y - bottomOffset)
+            {
+                prevPolyString += polyString;
+                prevPolyWidth += polyWidth;
+                _polyStrings.pop_back();
+                _polyWidths.pop_back();
+
+                prevPolyTextLine.lpstr = prevPolyString.data();
+                prevPolyTextLine.n = gsl::narrow<UINT>(prevPolyString.size());
+                prevPolyTextLine.rcl.right += (SHORT)cchCharWidths;
+                prevPolyTextLine.pdx = prevPolyWidth.data();
+                return S_OK;
+            }
+        }
+
         pPolyTextLine->lpstr = polyString.data();
         pPolyTextLine->n = gsl::narrow<UINT>(polyString.size());
         pPolyTextLine->x = ptDraw.x;
@@ -419,7 +491,13 @@ using namespace Microsoft::Console::Render;
 
         _cPolyText++;
 
-        if (_cPolyText >= s_cPolyTextCache)
+        if (scaledLineKey)
+        {
+            // Draw the run right away, so that it can be copied into the cache.
+            RETURN_IF_FAILED(_FlushBufferLines());
+            LOG_IF_FAILED(_CacheScaledLine(std::move(*scaledLineKey)));
+        }
+        else if (_cPolyText >= s_cPolyTextCache)
         {
             LOG_IF_FAILED(_FlushBufferLines());
         }
@@ -429,9 +507,141 @@ using namespace Microsoft::Console::Render;
     CATCH_RETURN();
 }
 
+bool GdiEngine::ScaledLineKey::operator==(const ScaledLineKey& other) const noexcept
+{
+    return rect.left == other.rect.left &&
+           rect.top == other.rect.top &&
+           rect.right == other.rect.right &&
+           rect.bottom == other.rect.bottom &&
+           origin.x == other.origin.x &&
+           origin.y == other.origin.y &&
+           fg == other.fg &&
+           bg == other.bg &&
+           fontType == other.fontType &&
+           lineRendition == other.lineRendition &&
+           text == other.text &&
+           widths == other.widths;
+}
+
+// Routine Description:
+// - Looks for the bitmap of a scaled run that was painted exactly like this before.
+// Arguments:
+// - key - the run that's about to be painted
+// Return Value:
+// - the cache entry of the run, or nullptr if it isn't cached
+GdiEngine::ScaledLineBitmap* GdiEngine::_FindScaledLine(const ScaledLineKey& key) noexcept
+{
+    for (auto& entry : _scaledLineCache)
+    {
+        if (entry.key == key)
+        {
+            entry.lastUsed = ++_scaledLineCacheClock;
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+// Routine Description:
+// - Copies a scaled run that was just drawn on the memory surface into the cache.
+//   It replaces an earlier run at the same place or, if the cache is full, the run
+//   that was used the longest time ago.
+// Arguments:
+// - key - the run that was just drawn
+// Return Value:
+// - S_OK or suitable GDI HRESULT error.
+[[nodiscard]] HRESULT GdiEngine::_CacheScaledLine(ScaledLineKey&& key) noexcept
+try
+{
+    const auto width = key.rect.right - key.rect.left;
+    const auto height = key.rect.bottom - key.rect.top;
+    RETURN_HR_IF(S_FALSE, width <= 0 || height <= 0);
+
+    if (!_hdcScaledLineCache)
+    {
+        _hdcScaledLineCache.reset(CreateCompatibleDC(_hdcMemoryContext));
+        RETURN_HR_IF_NULL(E_FAIL, _hdcScaledLineCache);
+    }
+
+    auto entry = std::find_if(_scaledLineCache.begin(), _scaledLineCache.end(), [&](const auto& e) {
+        return EqualRect(&e.key.rect, &key.rect);
+    });
+    if (entry == _scaledLineCache.end())
+    {
+        if (_scaledLineCache.size() < s_scaledLineCacheSize)
+        {
+            entry = _scaledLineCache.emplace(_scaledLineCache.end());
+        }
+        else
+        {
+            entry = std::min_element(_scaledLineCache.begin(), _scaledLineCache.end(), [](const auto& a, const auto& b) {
+                return a.lastUsed < b.lastUsed;
+            });
+        }
+    }
+
+    // A bitmap that's compatible with the memory context has the format of the surface selected into it.
+    entry->bitmap.reset(CreateCompatibleBitmap(_hdcMemoryContext, width, height));
+    if (!entry->bitmap)
+    {
+        _scaledLineCache.erase(entry);
+        return E_FAIL;
+    }
+    entry->key = std::move(key);
+    entry->lastUsed = ++_scaledLineCacheClock;
+
+    const auto hr = _CopyScaledLine(*entry, false);
+    if (FAILED(hr))
+    {
+        _scaledLineCache.erase(entry);
+    }
+    return hr;
+}
+CATCH_RETURN();
+
+// Routine Description:
+// - Copies a cached scaled run from or to the memory surface. The copy is done in
+//   device coordinates, so the line transform is suspended while it's made.
+// Arguments:
+// - entry - the cached run
+// - toSurface - true to paint the run from the cache, false to fill the cache
+// Return Value:
+// - S_OK or E_FAIL if GDI failed.
+[[nodiscard]] HRESULT GdiEngine::_CopyScaledLine(const ScaledLineBitmap& entry, const bool toSurface) noexcept
+{
+    const auto& rect = entry.key.rect;
+    const auto width = rect.right - rect.left;
+    const auto height = rect.bottom - rect.top;
+
+    RETURN_HR_IF(E_FAIL, !ModifyWorldTransform(_hdcMemoryContext, nullptr, MWT_IDENTITY));
+    const auto restoreTransform = wil::scope_exit([&]() noexcept {
+        LOG_HR_IF(E_FAIL, !SetWorldTransform(_hdcMemoryContext, &_currentLineTransform));
+    });
+
+    const auto previousBitmap = SelectBitmap(_hdcScaledLineCache.get(), entry.bitmap.get());
+    RETURN_HR_IF_NULL(E_FAIL, previousBitmap);
+    const auto restoreBitmap = wil::scope_exit([&]() noexcept {
+        SelectBitmap(_hdcScaledLineCache.get(), previousBitmap);
+    });
+
+    const auto copied = toSurface ?
+                            BitBlt(_hdcMemoryContext, rect.left, rect.top, width, height, _hdcScaledLineCache.get(), 0, 0, SRCCOPY) :
+                            BitBlt(_hdcScaledLineCache.get(), 0, 0, width, height, _hdcMemoryContext, rect.left, rect.top, SRCCOPY);
+    RETURN_HR_IF(E_FAIL, !copied);
+    return S_OK;
+}
+
+// Routine Description:
+// - Forgets all cached scaled runs, for instance because the font changed.
+void GdiEngine::_ClearScaledLineCache() noexcept
+{
+    _scaledLineCache.clear();
+}
+
 // Routine Description:
 // - Flushes any buffer lines in the PolyTextOut cache by drawing them and freeing the strings.
-// - See also: PaintBufferLine
+// - Any queued gridlines are drawn on top of them afterwards.
+// - See also: PaintBufferLine, PaintBufferGridLines
 // Arguments:
 // - <none>
 // Return Value:
@@ -460,11 +670,42 @@ using namespace Microsoft::Console::Render;
         _cPolyText = 0;
     }
 
+    // The gridlines belong on top of the text we just drew.
+    if (!_gridlineRects.empty())
+    {
+        // Set the brush color for the gridlines and save the previous brush to restore at the end.
+        wil::unique_hbrush hbr(CreateSolidBrush(_gridlineColor));
+        wil::unique_hbrush hbrPrev(hbr ? SelectBrush(_hdcMemoryContext, hbr.get()) : nullptr);
+        if (hbrPrev)
+        {
+            hbr.release(); // If SelectBrush was successful, GDI owns the brush. Release for now.
+
+            for (const auto& r : _gridlineRects)
+            {
+                if (!PatBlt(_hdcMemoryContext, r.left, r.top, r.right - r.left, r.bottom - r.top, PATCOPY))
+                {
+                    hr = E_FAIL;
+                    break;
+                }
+            }
+
+            // Put the brush back how it was originally.
+            hbr.reset(SelectBrush(_hdcMemoryContext, hbrPrev.get()));
+        }
+        else
+        {
+            hr = E_FAIL;
+        }
+
+        _gridlineRects.clear();
+    }
+
     RETURN_HR(hr);
 }
 
 // Routine Description:
 // - Draws up to one line worth of grid lines on top of characters.
+// - The lines are queued and drawn together with the buffer lines in _FlushBufferLines.
 // Arguments:
 // - lines - Enum defining which edges of the rectangle to draw
 // - color - The color to use for drawing the edges.
@@ -474,29 +715,49 @@ using namespace Microsoft::Console::Render;
 // - S_OK or suitable GDI HRESULT error or E_FAIL for GDI errors in functions that don't reliably return a specific error code.
 [[nodiscard]] HRESULT GdiEngine::PaintBufferGridLines(const GridLines lines, const COLORREF color, const size_t cchLine, const COORD coordTarget) noexcept
 {
-    LOG_IF_FAILED(_FlushBufferLines());
+    // All queued gridlines are drawn with the same brush. If the color
+    // changes, the ones we already have need to be drawn first.
+    if (color != _gridlineColor)
+    {
+        if (!_gridlineRects.empty())
+        {
+            LOG_IF_FAILED(_FlushBufferLines());
+        }
+        _gridlineColor = color;
+    }
 
     // Convert the target from characters to pixels.
     POINT ptTarget;
     RETURN_IF_FAILED(_ScaleByFont(&coordTarget, &ptTarget));
-    // Set the brush color as requested and save the previous brush to restore at the end.
-    wil::unique_hbrush hbr(CreateSolidBrush(color));
-    RETURN_HR_IF_NULL(E_FAIL, hbr.get());
-
-    wil::unique_hbrush hbrPrev(SelectBrush(_hdcMemoryContext, hbr.get()));
-    RETURN_HR_IF_NULL(E_FAIL, hbrPrev.get());
-    hbr.release(); // If SelectBrush was successful, GDI owns the brush. Release for now.
-
-    // On exit, be sure we try to put the brush back how it was originally.
-    auto restoreBrushOnExit = wil::scope_exit([&] { hbr.reset(SelectBrush(_hdcMemoryContext, hbrPrev.get())); });
 
     // Get the font size so we know the size of the rectangle lines we'll be inscribing.
     const auto fontWidth = _GetFontSize().X;
     const auto fontHeight = _GetFontSize().Y;
     const auto widthOfAllCells = fontWidth * gsl::narrow_cast<unsigned>(cchLine);
 
-    const auto DrawLine = [=](const auto x, const auto y, const auto w, const auto h) {
-        return PatBlt(_hdcMemoryContext, x, y, w, h, PATCOPY);
+    const auto DrawLine = [&](const LONG x, const LONG y, const LONG w, const LONG h) noexcept {
+        try
+        {
+            // A line that continues the previous one (like an underline
+            // spanning several runs) is merged into a single rectangle.
+            if (!_gridlineRects.empty())
+            {
+                auto& last = _gridlineRects.back();
+                if (last.top == y && last.bottom == y + h && last.right == x)
+                {
+                    last.right = x + w;
+                    return true;
+                }
+            }
+
+            _gridlineRects.push_back({ x, y, x + w, y + h });
+            return true;
+        }
+        catch (...)
+        {
+            LOG_CAUGHT_EXCEPTION();
+            return false;
+        }
     };
 
     if (lines & GridLines::Left)
@@ -27,6 +27,7 @@ GdiEngine::GdiEngine() :
     _hbitmapMemorySurface(nullptr),
     _cPolyText(0),
     _fInvalidRectUsed(false),
+    _gridlineColor(INVALID_COLOR),
     _lastFg(INVALID_COLOR),
     _lastBg(INVALID_COLOR),
     _lastFontType(FontType::Default),
@@ -38,9 +39,13 @@ GdiEngine::GdiEngine() :
     _hfontItalic(nullptr),
     _pool{ til::pmr::get_default_resource() }, // It's important the pool is first so it can be given to the others on construction.
     _polyStrings{ &_pool },
-    _polyWidths{ &_pool }
+    _polyWidths{ &_pool },
+    _gridlineRects{ &_pool }
 {
     ZeroMemory(_pPolyText, sizeof(POLYTEXTW) * s_cPolyTextCache);
+    // The POLYTEXTW entries point into these strings, so they must not be moved by a reallocation.
+    _polyStrings.reserve(s_cPolyTextCache);
+    _polyWidths.reserve(s_cPolyTextCache);
     _rcInvalid = { 0 };
     _szInvalidScroll = { 0 };
     _szMemorySurface = { 0 };
@@ -142,6 +147,10 @@ GdiEngine::~GdiEngine()
     _hwndTargetWindow = hwnd;
     _hdcMemoryContext = hdcNewMemoryContext;
 
+    // The cached scaled lines were made for the previous context.
+    _ClearScaledLineCache();
+    _hdcScaledLineCache.reset();
+
     // If we have a font, apply it to the context.
     if (nullptr != _hfont)
     {
@@ -279,13 +288,23 @@ GdiEngine::~GdiEngine()
                                                       const bool usingSoftFont,
                                                       const bool isSettingDefaultBrushes) noexcept
 {
-    RETURN_IF_FAILED(_FlushBufferLines());
-
     RETURN_HR_IF_NULL(HRESULT_FROM_WIN32(ERROR_INVALID_STATE), _hdcMemoryContext);
 
     // Set the colors for painting text
     const auto [colorForeground, colorBackground] = pData->GetAttributeColors(textAttributes);
 
+    const auto usingItalicFont = textAttributes.IsItalic();
+    const auto fontType = usingSoftFont ? FontType::Soft : usingItalicFont ? FontType::Italic : FontType::Default;
+
+    // The queued lines are drawn with whatever colors and font are selected when they're
+    // flushed, so we only need to flush them if one of those is about to change. Runs that
+    // differ in attributes we don't draw differently (hyperlinks, gridlines, etc.) keep
+    // accumulating and end up in the same ExtTextOut call.
+    if (colorForeground != _lastFg || colorBackground != _lastBg || fontType != _lastFontType)
+    {
+        RETURN_IF_FAILED(_FlushBufferLines());
+    }
+
     if (colorForeground != _lastFg)
     {
         RETURN_HR_IF(E_FAIL, CLR_INVALID == SetTextColor(_hdcMemoryContext, colorForeground));
@@ -307,8 +326,6 @@ GdiEngine::~GdiEngine()
     }
 
     // If the font type has changed, select an appropriate font variant or soft font.
-    const auto usingItalicFont = textAttributes.IsItalic();
-    const auto fontType = usingSoftFont ? FontType::Soft : usingItalicFont ? FontType::Italic : FontType::Default;
     if (fontType != _lastFontType)
     {
         switch (fontType)
@@ -349,6 +366,9 @@ GdiEngine::~GdiEngine()
     // Record the fact that the selected font is the default.
     _lastFontType = FontType::Default;
 
+    // Scaled lines that were drawn with the previous font mustn't be reused.
+    _ClearScaledLineCache();
+
     // Save off the font metrics for various other calculations
     RETURN_HR_IF(E_FAIL, !(GetTextMetricsW(_hdcMemoryContext, &_tmFontMetrics)));
 
@@ -454,6 +474,14 @@ GdiEngine::~GdiEngine()
                                                 const SIZE cellSize,
                                                 const size_t centeringHint) noexcept
 {
+    // Applications tend to send the same DECDLD definition whenever they start.
+    // In that case the existing font (already scaled to the current cell size)
+    // can be kept, instead of regenerating and reregistering it.
+    if (_softFont.IsCreatedFrom(bitPattern, cellSize, centeringHint))
+    {
+        return S_OK;
+    }
+
     // If the soft font is currently selected, replace it with the default font.
     if (_lastFontType == FontType::Soft)
     {
@@ -463,6 +491,7 @@ GdiEngine::~GdiEngine()
 
     // Create a new font resource with the updated pattern, or delete if empty.
     _softFont = { bitPattern, cellSize, _GetFontSize(), centeringHint };
+    _ClearScaledLineCache();
 
     return S_OK;
 }
@@ -29,6 +29,9 @@ namespace Microsoft::Console::Render
         ~FontResource() = default;
         FontResource& operator=(FontResource&&) = default;
         void SetTargetSize(const til::size targetSize);
+        bool IsCreatedFrom(const gsl::span<const uint16_t> bitPattern,
+                           const til::size sourceSize,
+                           const size_t centeringHint) const noexcept;
         operator HFONT();
 
     private:
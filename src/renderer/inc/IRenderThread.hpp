@@ -13,6 +13,9 @@ Author(s):
 --*/
 
 #pragma once
+
+#include "../../types/inc/utils.hpp"
+
 namespace Microsoft::Console::Render
 {
     class IRenderThread
@@ -28,6 +31,9 @@ namespace Microsoft::Console::Render
         virtual void EnablePainting() = 0;
         virtual void DisablePainting() = 0;
         virtual void WaitForPaintCompletionAndDisable(const DWORD dwTimeoutMs) = 0;
+        virtual void SetFrameRate(const unsigned int framesPerSecond) noexcept = 0;
+        virtual void SetSchedulingPolicy(const Microsoft::Console::Utils::ThreadSchedulingPolicy policy) noexcept = 0;
+        virtual void TriggerShutdown() noexcept = 0;
 
     protected:
         IRenderThread() = default;
@@ -40,6 +40,7 @@ namespace Microsoft::Console::Render
 
         virtual void TriggerRedrawAll() = 0;
         virtual void TriggerTeardown() noexcept = 0;
+        virtual void TriggerShutdown() noexcept = 0;
 
         virtual void TriggerSelection() = 0;
         virtual void TriggerScroll() = 0;
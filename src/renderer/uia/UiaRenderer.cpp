@@ -20,7 +20,6 @@ UiaEngine::UiaEngine(IUiaEventDispatcher* dispatcher) :
     _textBufferChanged{ false },
     _cursorChanged{ false },
     _isEnabled{ true },
-    _prevSelection{},
     _prevCursorRegion{},
     RenderEngineBase()
 {
@@ -101,43 +100,18 @@ CATCH_RETURN();
 // - Notifies us that the console has changed the selection region and would
 //      like it updated
 // Arguments:
-// - rectangles - One or more rectangles describing character positions on the grid
+// - rectangles - The character positions on the grid that got selected or
+//      deselected. The renderer only calls this if there are any.
 // Return Value:
 // - S_OK
 [[nodiscard]] HRESULT UiaEngine::InvalidateSelection(const std::vector<SMALL_RECT>& rectangles) noexcept
 {
-    // early exit: different number of rows
-    if (_prevSelection.size() != rectangles.size())
+    // Don't clear _selectionChanged if there's nothing new though:
+    // a change earlier in this frame still needs to be signaled.
+    if (!rectangles.empty())
     {
-        try
-        {
-            _selectionChanged = true;
-            _prevSelection = rectangles;
-        }
-        CATCH_LOG_RETURN_HR(E_FAIL);
-        return S_OK;
+        _selectionChanged = true;
     }
-
-    for (size_t i = 0; i < rectangles.size(); i++)
-    {
-        try
-        {
-            const auto prevRect = _prevSelection.at(i);
-            const auto newRect = rectangles.at(i);
-
-            // if any value is different, selection has changed
-            if (prevRect.Top != newRect.Top || prevRect.Right != newRect.Right || prevRect.Left != newRect.Left || prevRect.Bottom != newRect.Bottom)
-            {
-                _selectionChanged = true;
-                _prevSelection = rectangles;
-                return S_OK;
-            }
-        }
-        CATCH_LOG_RETURN_HR(E_FAIL);
-    }
-
-    // assume selection has not changed
-    _selectionChanged = false;
     return S_OK;
 }
 
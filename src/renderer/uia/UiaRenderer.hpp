@@ -86,7 +86,6 @@ namespace Microsoft::Console::Render
 
         Microsoft::Console::Types::IUiaEventDispatcher* _dispatcher;
 
-        std::vector<SMALL_RECT> _prevSelection;
         SMALL_RECT _prevCursorRegion;
     };
 }
@@ -0,0 +1,277 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "VtShadowFrame.hpp"
+
+#pragma hdrstop
+
+using namespace Microsoft::Console::Render;
+
+#pragma warning(push)
+#pragma warning(disable : 26481) // Don't use pointer arithmetic. Use span instead (bounds.1).
+#pragma warning(disable : 26490) // Don't use reinterpret_cast (type.1).
+
+// Returns the number of leading cells that are equal in both arrays.
+static size_t _countEqualPrefix(const uint64_t* const a, const uint64_t* const b, const size_t count) noexcept
+{
+    size_t i = 0;
+#if defined(_M_AMD64) || defined(_M_IX86)
+    // Most rows of a redrawn frame are entirely unchanged, so we compare two
+    // cells at once. Both halves of a cell must match for all 16 bytes to be set.
+    for (; i + 2 <= count; i += 2)
+    {
+        const auto va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        const auto vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(va, vb)) != 0xFFFF)
+        {
+            break;
+        }
+    }
+#endif
+    for (; i < count && a[i] == b[i]; ++i)
+    {
+    }
+    return i;
+}
+
+// Returns the number of cells up to and including the last one that
+// differs between both arrays, or 0 if they're all equal.
+static size_t _countUpToLastDifference(const uint64_t* const a, const uint64_t* const b, const size_t count) noexcept
+{
+    auto end = count;
+#if defined(_M_AMD64) || defined(_M_IX86)
+    for (; end >= 2; end -= 2)
+    {
+        const auto va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + end - 2));
+        const auto vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + end - 2));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(va, vb)) != 0xFFFF)
+        {
+            break;
+        }
+    }
+#endif
+    for (; end > 0 && a[end - 1] == b[end - 1]; --end)
+    {
+    }
+    return end;
+}
+
+#pragma warning(pop)
+
+// Routine Description:
+// - Sets the size of the terminal's screen. Everything is forgotten.
+// Arguments:
+// - size - the width and height of the viewport, in cells
+// Return Value:
+// - <none>
+void VtShadowFrame::Resize(const til::size size)
+{
+    _size = size;
+    _cells.assign(size.area<size_t>(), s_unknownCell);
+    _attributes.clear();
+}
+
+// Routine Description:
+// - Forgets everything the terminal shows, so that it's all painted again.
+//   Call this whenever something other than PaintBufferLine might have
+//   changed the terminal's screen.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void VtShadowFrame::Reset() noexcept
+{
+    std::fill(_cells.begin(), _cells.end(), s_unknownCell);
+    _attributes.clear();
+}
+
+// Routine Description:
+// - Moves the rows along with the terminal's screen when it's scrolled.
+//   The rows scrolled into view are unknown.
+// Arguments:
+// - delta - the number of rows the contents moved down (negative for up)
+// Return Value:
+// - <none>
+void VtShadowFrame::Scroll(const ptrdiff_t delta) noexcept
+{
+    const auto width = gsl::narrow_cast<size_t>(_size.width());
+    const auto height = gsl::narrow_cast<size_t>(_size.height());
+    const auto rows = gsl::narrow_cast<size_t>(std::abs(delta));
+    if (rows >= height)
+    {
+        Reset();
+        return;
+    }
+
+    const auto moved = (height - rows) * width;
+    if (delta < 0)
+    {
+        std::copy_n(_cells.begin() + rows * width, moved, _cells.begin());
+        std::fill(_cells.begin() + moved, _cells.end(), s_unknownCell);
+    }
+    else if (delta > 0)
+    {
+        std::copy_backward(_cells.begin(), _cells.begin() + moved, _cells.end());
+        std::fill_n(_cells.begin(), rows * width, s_unknownCell);
+    }
+}
+
+// Routine Description:
+// - Compares a run of clusters that's about to be painted with what the
+//   terminal shows. Call Remember() with the part of the run that's then
+//   actually written to the terminal.
+// Arguments:
+// - clusters - the text of the run
+// - coord - where the run starts
+// - attributes - the attributes the run is painted with, as far as the
+//   terminal knows them
+// Return Value:
+// - the clusters that need to be painted
+VtShadowFrame::Difference VtShadowFrame::Compare(const gsl::span<const Cluster> clusters, const COORD coord, const TextAttribute& attributes)
+{
+    const auto attributesId = static_cast<uint64_t>(_GetAttributesId(attributes)) << 32;
+
+    _runCoord = coord;
+    _runCells.clear();
+    _runColumns.clear();
+    for (const auto& cluster : clusters)
+    {
+        _runColumns.emplace_back(_runCells.size());
+
+        const auto text = cluster.GetText();
+        const auto columns = cluster.GetColumns();
+        uint32_t glyph = s_complexGlyph;
+        if (text.size() == 1 && !IS_HIGH_SURROGATE(til::at(text, 0)) && !IS_LOW_SURROGATE(til::at(text, 0)))
+        {
+            glyph = til::at(text, 0);
+        }
+        else if (text.size() == 2 && IS_HIGH_SURROGATE(til::at(text, 0)) && IS_LOW_SURROGATE(til::at(text, 1)))
+        {
+            glyph = 0x10000 + ((til::at(text, 0) - 0xD800) << 10) + (til::at(text, 1) - 0xDC00);
+        }
+
+        if (columns == 1 && glyph != s_complexGlyph)
+        {
+            _runCells.emplace_back(attributesId | glyph);
+        }
+        else if (columns == 2 && glyph != s_complexGlyph)
+        {
+            _runCells.emplace_back(attributesId | glyph | s_wideGlyph);
+            _runCells.emplace_back(attributesId | s_trailingGlyph);
+        }
+        else
+        {
+            _runCells.insert(_runCells.end(), columns, attributesId | s_complexGlyph);
+        }
+    }
+    _runColumns.emplace_back(_runCells.size());
+
+    const auto cells = _GetCells(coord, _runCells.size());
+    if (!cells)
+    {
+        return { 0, clusters.size() };
+    }
+
+    const auto equalPrefix = _countEqualPrefix(_runCells.data(), cells, _runCells.size());
+    if (equalPrefix == _runCells.size())
+    {
+        return { clusters.size(), clusters.size() };
+    }
+    const auto lastDifference = _countUpToLastDifference(_runCells.data(), cells, _runCells.size());
+
+    // Map the columns back to the clusters that contain them.
+    const auto begin = std::upper_bound(_runColumns.begin(), _runColumns.end() - 1, equalPrefix) - _runColumns.begin() - 1;
+    const auto end = std::lower_bound(_runColumns.begin(), _runColumns.end() - 1, lastDifference) - _runColumns.begin();
+    return { gsl::narrow_cast<size_t>(begin), gsl::narrow_cast<size_t>(end) };
+}
+
+// Routine Description:
+// - Returns the column within the last compared run that the given cluster starts at.
+// Arguments:
+// - cluster - the index of the cluster, up to the number of clusters in the run
+// Return Value:
+// - the column, relative to the start of the run
+size_t VtShadowFrame::ColumnOf(const size_t cluster) const noexcept
+{
+    return cluster < _runColumns.size() ? til::at(_runColumns, cluster) : _runCells.size();
+}
+
+// Routine Description:
+// - Remembers that a part of the last compared run was written to the terminal.
+// Arguments:
+// - coord - where the written part starts. It must be within the run.
+// - columns - the number of cells written
+// Return Value:
+// - <none>
+void VtShadowFrame::Remember(const COORD coord, const size_t columns) noexcept
+{
+    if (coord.Y != _runCoord.Y || coord.X < _runCoord.X)
+    {
+        return;
+    }
+
+    const auto offset = gsl::narrow_cast<size_t>(coord.X - _runCoord.X);
+    const auto count = std::min(columns, _runCells.size() - std::min(offset, _runCells.size()));
+    if (const auto cells = _GetCells(coord, count))
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            const auto cell = til::at(_runCells, offset + i);
+            // Clusters we can't store have to be painted every time.
+            cells[i] = (cell & s_complexGlyph) ? s_unknownCell : cell;
+        }
+    }
+}
+
+// Routine Description:
+// - Forgets the contents of some cells, for instance because they were
+//   erased with a VT sequence instead of being painted.
+// Arguments:
+// - coord - the first cell
+// - columns - the number of cells. It's clamped to the end of the row.
+// Return Value:
+// - <none>
+void VtShadowFrame::Forget(const COORD coord, const size_t columns) noexcept
+{
+    if (coord.X < 0 || coord.X >= _size.width())
+    {
+        return;
+    }
+
+    const auto count = std::min(columns, gsl::narrow_cast<size_t>(_size.width() - coord.X));
+    if (const auto cells = _GetCells(coord, count))
+    {
+        std::fill_n(cells, count, s_unknownCell);
+    }
+}
+
+// Returns a small number for the given attributes, which is the same for
+// equal attributes for as long as nothing is forgotten. Once there are too many
+// different ones, everything is forgotten.
+uint32_t VtShadowFrame::_GetAttributesId(const TextAttribute& attributes)
+{
+    const auto it = std::find(_attributes.begin(), _attributes.end(), attributes);
+    if (it != _attributes.end())
+    {
+        return gsl::narrow_cast<uint32_t>(it - _attributes.begin());
+    }
+
+    if (_attributes.size() >= s_maxAttributes)
+    {
+        Reset();
+    }
+    _attributes.emplace_back(attributes);
+    return gsl::narrow_cast<uint32_t>(_attributes.size() - 1);
+}
+
+// Returns the given cells of a row, or nullptr if they aren't all on the screen.
+uint64_t* VtShadowFrame::_GetCells(const COORD coord, const size_t columns) noexcept
+{
+    const auto width = gsl::narrow_cast<size_t>(_size.width());
+    if (coord.X < 0 || coord.Y < 0 || coord.Y >= _size.height() || gsl::narrow_cast<size_t>(coord.X) + columns > width)
+    {
+        return nullptr;
+    }
+    return _cells.data() + gsl::narrow_cast<size_t>(coord.Y) * width + coord.X;
+}
@@ -0,0 +1,69 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- VtShadowFrame.hpp
+
+Abstract:
+- A copy of what the VtEngine last sent to the terminal, cell by cell, so that
+  it can leave out everything the terminal already shows. Apps that redraw
+  their whole screen every tick (progress bars, full-screen TUIs) invalidate
+  much more than actually changes.
+- Every cell is a 64-bit value: the glyph in the low half and the ID of its
+  attributes in the high half. This way a row can be compared with SSE2,
+  two cells at a time.
+- Cells the shadow doesn't know the contents of (because they were erased
+  with a VT sequence, or the terminal changed them on its own) are Unknown
+  and never match anything.
+--*/
+
+#pragma once
+
+#include "../inc/Cluster.hpp"
+#include "../../buffer/out/TextAttribute.hpp"
+
+namespace Microsoft::Console::Render
+{
+    class VtShadowFrame final
+    {
+    public:
+        // The range of clusters [begin, end) of a run that differ from
+        // what the terminal shows. begin == end if nothing does.
+        struct Difference
+        {
+            size_t begin;
+            size_t end;
+        };
+
+        void Resize(const til::size size);
+        void Reset() noexcept;
+        void Scroll(const ptrdiff_t delta) noexcept;
+
+        Difference Compare(const gsl::span<const Cluster> clusters, const COORD coord, const TextAttribute& attributes);
+        size_t ColumnOf(const size_t cluster) const noexcept;
+        void Remember(const COORD coord, const size_t columns) noexcept;
+        void Forget(const COORD coord, const size_t columns) noexcept;
+
+    private:
+        static constexpr uint64_t s_unknownCell = UINT64_MAX;
+        static constexpr uint32_t s_wideGlyph = 0x01000000;
+        static constexpr uint32_t s_trailingGlyph = 0x02000000;
+        // Clusters of more than one code point aren't stored and always differ.
+        static constexpr uint32_t s_complexGlyph = 0x04000000;
+        static constexpr size_t s_maxAttributes = 256;
+
+        uint32_t _GetAttributesId(const TextAttribute& attributes);
+        uint64_t* _GetCells(const COORD coord, const size_t columns) noexcept;
+
+        til::size _size;
+        std::vector<uint64_t> _cells;
+        std::vector<TextAttribute> _attributes;
+
+        // The cells of the run that was compared last, which may then be
+        // remembered once they're painted.
+        std::vector<uint64_t> _runCells;
+        std::vector<size_t> _runColumns;
+        COORD _runCoord{};
+    };
+}
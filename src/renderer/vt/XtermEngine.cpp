@@ -37,6 +37,12 @@ XtermEngine::XtermEngine(_In_ wil::unique_hfile hPipe,
 {
     RETURN_IF_FAILED(VtEngine::StartPaint());
 
+    // Nothing should be painted while the terminal is behind, see VtEngine::StartPaint.
+    if (_frameSkipped)
+    {
+        return S_FALSE;
+    }
+
     _trace.TraceLastText(_lastText);
 
     // Prep us to think that the cursor is not visible this frame. If it _is_
@@ -52,6 +58,7 @@ XtermEngine::XtermEngine(_In_ wil::unique_hfile hPipe,
         //      the screen on the first paint, just to make sure that the
         //      terminal's state is consistent with what we'll be rendering.
         RETURN_IF_FAILED(_ClearScreen());
+        _shadowFrame.Reset();
         _clearedAllThisFrame = true;
         _firstPaint = false;
     }
@@ -395,6 +402,9 @@ try
         RETURN_IF_FAILED(_InsertLine(absDy));
     }
 
+    // The terminal's screen moved along.
+    _shadowFrame.Scroll(dy);
+
     // Restore our wrap state.
     _wrappedRow = oldWrappedRow;
     _delayedEolWrap = oldDelayedEolWrap;
@@ -520,6 +530,16 @@ CATCH_RETURN();
 // - S_OK or suitable HRESULT error from either conversion or writing pipe.
 [[nodiscard]] HRESULT XtermEngine::WriteTerminalW(const std::wstring_view wstr) noexcept
 {
+    // During passthrough the terminal has already received
+    // any strings the state machine would pass through to it.
+    if (_passthrough)
+    {
+        return S_OK;
+    }
+
+    // We don't know what the string does to the terminal's screen.
+    _shadowFrame.Reset();
+
     RETURN_IF_FAILED(_fUseAsciiOnly ?
                          VtEngine::_WriteTerminalAscii(wstr) :
                          VtEngine::_WriteTerminalUtf8(wstr));
@@ -49,6 +49,14 @@ using namespace Microsoft::Console::Render;
 [[nodiscard]] HRESULT VtEngine::Invalidate(const SMALL_RECT* const psrRegion) noexcept
 try
 {
+    // With the resize quirk, the terminal reflows its own copy of the buffer.
+    // The rows we rewrite while reflowing ours would come out the same way
+    // there, so they aren't repainted. Only what changes after the resize is.
+    if (_inResizeRequest && _resizeQuirk)
+    {
+        return S_OK;
+    }
+
     const til::rectangle rect{ Viewport::FromExclusive(*psrRegion).ToInclusive() };
     _trace.TraceInvalidate(rect);
     _invalidMap.set(rect);
@@ -108,7 +116,8 @@ CATCH_RETURN();
 [[nodiscard]] HRESULT VtEngine::InvalidateCircling(_Out_ bool* const pForcePaint) noexcept
 {
     // If we're in the middle of a resize request, don't try to immediately start a frame.
-    if (_inResizeRequest)
+    // The same goes for passthrough; the terminal is already circling by itself.
+    if (_inResizeRequest || _passthrough)
     {
         *pForcePaint = false;
     }
@@ -137,5 +146,10 @@ CATCH_RETURN();
 [[nodiscard]] HRESULT VtEngine::PrepareForTeardown(_Out_ bool* const pForcePaint) noexcept
 {
     *pForcePaint = true;
+
+    // The host exits right after this last frame, so make sure it's
+    // actually written out before we return from painting it.
+    _flushSynchronously = true;
+
     return S_OK;
 }
@@ -31,7 +31,16 @@ using namespace Microsoft::Console::Types;
                          _cursorMoved ||
                          _titleChanged;
 
-    _quickReturn = !somethingToDo;
+    // If the terminal hasn't even started reading the frames we sent before,
+    // another one would only queue up behind them, to be parsed and painted
+    // over right away. Instead we hold on to everything that's invalid and
+    // paint it in one frame once the terminal has caught up. Frames that
+    // have to go out right now, like before circling, are never held back.
+    const auto mustPaint = _circled || _forceNextFrame || _flushSynchronously;
+    _forceNextFrame = false;
+    _frameSkipped = somethingToDo && !mustPaint && _IsWriterBehind();
+
+    _quickReturn = !somethingToDo || _frameSkipped;
     _trace.TraceStartPaint(_quickReturn,
                            _invalidMap,
                            _lastViewport.ToInclusive(),
@@ -367,20 +376,51 @@ using namespace Microsoft::Console::Types;
 // Routine Description:
 // - Draws one line of the buffer to the screen. Writes the characters to the
 //      pipe, encoded in UTF-8.
+// - Only the part of the line that differs from what the terminal already
+//      shows is written, see VtShadowFrame.
 // Arguments:
-// - clusters - text and column widths to be written
-// - coord - character coordinate target to render within viewport
+// - givenClusters - text and column widths to be written
+// - givenCoord - character coordinate target to render within viewport
 // Return Value:
 // - S_OK or suitable HRESULT error from writing pipe.
-[[nodiscard]] HRESULT VtEngine::_PaintUtf8BufferLine(gsl::span<const Cluster> const clusters,
-                                                     const COORD coord,
+[[nodiscard]] HRESULT VtEngine::_PaintUtf8BufferLine(gsl::span<const Cluster> const givenClusters,
+                                                     const COORD givenCoord,
                                                      const bool lineWrapped) noexcept
 {
-    if (coord.Y < _virtualTop)
+    if (givenCoord.Y < _virtualTop || givenClusters.empty())
     {
         return S_OK;
     }
 
+    auto clusters = givenClusters;
+    auto coord = givenCoord;
+    try
+    {
+        const auto difference = _shadowFrame.Compare(givenClusters, givenCoord, _lastTextAttributes);
+
+        // Writing the first text of the row after a wrapped one is what makes
+        // the terminal actually wrap that row, so it's never left out.
+        const bool continuesWrappedRow = _wrappedRow.has_value() &&
+                                         givenCoord.X == 0 &&
+                                         givenCoord.Y == _wrappedRow.value() + 1;
+        if (!continuesWrappedRow)
+        {
+            // Likewise, we need to write the last cell of a wrapped row to get
+            // the terminal into the wrapped state. See GH#5291 below.
+            const auto begin = lineWrapped ? std::min(difference.begin, givenClusters.size() - 1) : difference.begin;
+            const auto end = lineWrapped ? givenClusters.size() : difference.end;
+            if (begin >= end)
+            {
+                // The terminal already shows all of it.
+                return S_OK;
+            }
+
+            clusters = givenClusters.subspan(begin, end - begin);
+            coord.X += gsl::narrow<short>(_shadowFrame.ColumnOf(begin));
+        }
+    }
+    CATCH_RETURN();
+
     _bufferLine.clear();
     _bufferLine.reserve(clusters.size());
     short totalWidth = 0;
@@ -491,6 +531,11 @@ using namespace Microsoft::Console::Types;
     // Write the actual text string
     RETURN_IF_FAILED(VtEngine::_WriteTerminalUtf8({ _bufferLine.data(), cchActual }));
 
+    // The spaces we didn't write are either erased below, or were blank
+    // already. Either way, we can't be sure what the terminal shows there.
+    _shadowFrame.Remember(coord, columnsActual);
+    _shadowFrame.Forget({ gsl::narrow_cast<short>(coord.X + columnsActual), coord.Y }, useEraseChar ? SIZE_MAX : gsl::narrow_cast<size_t>(totalWidth) - columnsActual);
+
     // GH#4415, GH#5181
     // If the renderer told us that this was a wrapped line, then mark
     // that we've wrapped this line. The next time we attempt to move the
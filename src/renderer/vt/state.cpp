@@ -56,6 +56,8 @@ VtEngine::VtEngine(_In_ wil::unique_hfile pipe,
     _formatBuffer{},
     _conversionBuffer{}
 {
+    _shadowFrame.Resize(initialViewport.Dimensions());
+
 #ifndef UNIT_TESTING
     // When unit testing, we can instantiate a VtEngine without a pipe.
     THROW_HR_IF(E_HANDLE, _hFile.get() == INVALID_HANDLE_VALUE);
@@ -63,6 +65,24 @@ VtEngine::VtEngine(_In_ wil::unique_hfile pipe,
     // member is only defined when UNIT_TESTING is.
     _usingTestCallback = false;
 #endif
+
+    // Most frames fit into this, so that we rarely need to grow the buffer while painting.
+    _buffer.reserve(s_initialBufferSize);
+}
+
+// Routine Description:
+// - Destroys the engine, after waiting for everything we've painted to be written.
+VtEngine::~VtEngine()
+{
+    if (_writerThread.joinable())
+    {
+        {
+            const std::lock_guard guard{ _writerLock };
+            _writerExit = true;
+        }
+        _writerCondition.notify_all();
+        _writerThread.join();
+    }
 }
 
 // Method Description:
@@ -96,7 +116,9 @@ VtEngine::VtEngine(_In_ wil::unique_hfile pipe,
 
     try
     {
+        const auto start = _buffer.size();
         _buffer.append(str);
+        _MergeGraphicsRendition(start);
 
         return S_OK;
     }
@@ -113,13 +135,65 @@ VtEngine::VtEngine(_In_ wil::unique_hfile pipe,
     }
 #endif
 
-    if (!_pipeBroken)
+    if (!_pipeBroken && !_buffer.empty())
     {
-        bool fSuccess = !!WriteFile(_hFile.get(), _buffer.data(), gsl::narrow_cast<DWORD>(_buffer.size()), nullptr, nullptr);
+        HRESULT hr = S_OK;
+
+        if (_flushSynchronously)
+        {
+            // Wait for the writer thread to finish with everything before this,
+            // then write it ourselves, so it's out before we return.
+            {
+                std::unique_lock lock{ _writerLock };
+                _writerCondition.wait(lock, [&]() noexcept { return _pendingBuffer.empty() && !_writerBusy; });
+                hr = _writerResult;
+            }
+
+            if (SUCCEEDED(hr))
+            {
+                hr = _WritePipe(_buffer);
+            }
+        }
+        else
+        {
+            try
+            {
+                if (!_writerThread.joinable())
+                {
+                    _writerThread = std::thread{ &VtEngine::_WriterThread, this };
+                }
+
+                {
+                    const std::lock_guard guard{ _writerLock };
+                    hr = _writerResult;
+
+                    // If the writer thread is still busy with the previous frames, this one joins
+                    // the ones waiting. Otherwise, swapping the buffers saves us from copying it.
+                    if (_pendingBuffer.empty())
+                    {
+                        _pendingBuffer.swap(_buffer);
+                    }
+                    else
+                    {
+                        _pendingBuffer.append(_buffer);
+                    }
+                }
+                _writerCondition.notify_all();
+            }
+            catch (...)
+            {
+                // If we can't hand it off, fall back to writing it ourselves.
+                LOG_CAUGHT_EXCEPTION();
+                hr = _WritePipe(_buffer);
+            }
+        }
+
         _buffer.clear();
-        if (!fSuccess)
+        _lastGraphicsRenditionEnd = std::string::npos;
+
+        if (FAILED(hr))
         {
-            _exitResult = HRESULT_FROM_WIN32(GetLastError());
+            _exitResult = hr;
             _pipeBroken = true;
             if (_terminalOwner)
             {
@@ -132,10 +206,151 @@ VtEngine::VtEngine(_In_ wil::unique_hfile pipe,
     return S_OK;
 }
 
+// Routine Description:
+// - Checks whether the given string is a single SGR sequence, with nothing
+//   but numeric parameters.
+// Arguments:
+// - str: the string to check.
+// Return Value:
+// - true iff str is a SGR sequence.
+static bool s_IsGraphicsRendition(const std::string_view str) noexcept
+{
+    if (str.size() < 3 || str[0] != '\x1b' || str[1] != '[' || str.back() != 'm')
+    {
+        return false;
+    }
+
+    const auto parameters = str.substr(2, str.size() - 3);
+    return std::all_of(parameters.begin(), parameters.end(), [](const char ch) noexcept {
+        return (ch >= '0' && ch <= '9') || ch == ';';
+    });
+}
+
+// Method Description:
+// - Called after a sequence was appended to _buffer at the given offset.
+//   If it's a SGR sequence that directly follows another one, the two are
+//   combined into one with the parameters of both, as in CSI 1;38;5;123 m.
+//   Changing several attributes at once then costs just one sequence.
+// Arguments:
+// - start: the offset into _buffer where the sequence begins.
+// Return Value:
+// - <none>
+void VtEngine::_MergeGraphicsRendition(const size_t start)
+{
+    const std::string_view appended{ _buffer.data() + start, _buffer.size() - start };
+    if (!s_IsGraphicsRendition(appended))
+    {
+        return;
+    }
+
+    // Terminals only accept a limited number of parameters per sequence.
+    const auto mergeable = _lastGraphicsRenditionEnd == start &&
+                           std::count(_buffer.begin() + _lastGraphicsRenditionStart, _buffer.end(), ';') < s_maxGraphicsRenditionParameters;
+    if (!mergeable)
+    {
+        _lastGraphicsRenditionStart = start;
+        _lastGraphicsRenditionEnd = _buffer.size();
+        return;
+    }
+
+    // An empty parameter list means 0 (reset), which has to be spelled out once there are others.
+    const auto previousIsEmpty = start - _lastGraphicsRenditionStart == 3;
+    const auto appendedIsEmpty = appended.size() == 3;
+
+    // Turn "CSI a m CSI b m" into "CSI a ; b m".
+    _buffer[start - 1] = ';';
+    _buffer.erase(start, 2);
+    if (appendedIsEmpty)
+    {
+        _buffer.insert(start, 1, '0');
+    }
+    if (previousIsEmpty)
+    {
+        _buffer.insert(start - 1, 1, '0');
+    }
+
+    _lastGraphicsRenditionEnd = _buffer.size();
+}
+
+// Method Description:
+// - Writes the given string to the pipe, returning once it's been written.
+// Arguments:
+// - str: the string to write.
+// Return Value:
+// - S_OK, or the error that writing failed with.
+[[nodiscard]] HRESULT VtEngine::_WritePipe(std::string_view const str) noexcept
+{
+    RETURN_IF_WIN32_BOOL_FALSE_EXPECTED(WriteFile(_hFile.get(), str.data(), gsl::narrow_cast<DWORD>(str.size()), nullptr, nullptr));
+    return S_OK;
+}
+
+// Method Description:
+// - The writer thread. Writes whatever _Flush handed it to the pipe, in as few
+//   writes as possible, until the engine is destroyed or writing fails.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void VtEngine::_WriterThread() noexcept
+{
+    std::string writing;
+
+    for (;;)
+    {
+        {
+            std::unique_lock lock{ _writerLock };
+            _writerBusy = false;
+            _writerCondition.notify_all();
+
+            _writerCondition.wait(lock, [&]() noexcept { return !_pendingBuffer.empty() || _writerExit; });
+
+            // We write out everything that's left before exiting.
+            if (_pendingBuffer.empty())
+            {
+                return;
+            }
+
+            // Swapping keeps the memory of both buffers around for the following frames.
+            writing.swap(_pendingBuffer);
+            _writerBusy = true;
+        }
+
+        const auto hr = _WritePipe(writing);
+        writing.clear();
+
+        if (FAILED(hr))
+        {
+            // _Flush reports the failure the next time it's called. There's no point trying to write anything else.
+            const std::lock_guard guard{ _writerLock };
+            _writerResult = hr;
+            _pendingBuffer.clear();
+            _writerBusy = false;
+            _writerCondition.notify_all();
+            return;
+        }
+    }
+}
+
+// Method Description:
+// - Checks whether the terminal is falling behind on reading our output,
+//   which is the case once a frame is waiting for the writer thread to
+//   finish the ones before it.
+// Arguments:
+// - <none>
+// Return Value:
+// - true if there's a frame that the writer thread hasn't started writing yet.
+[[nodiscard]] bool VtEngine::_IsWriterBehind() noexcept
+{
+    const std::lock_guard guard{ _writerLock };
+    return !_pendingBuffer.empty();
+}
+
 // Method Description:
 // - Wrapper for ITerminalOutputConnection. See _Write.
 [[nodiscard]] HRESULT VtEngine::WriteTerminalUtf8(const std::string_view str) noexcept
 {
+    // We don't know what the string does to the terminal's screen.
+    _shadowFrame.Reset();
     return _Write(str);
 }
 
@@ -227,6 +442,13 @@ VtEngine::VtEngine(_In_ wil::unique_hfile pipe,
             hr = _ResizeWindow(newView.Width(), newView.Height());
         }
         _resized = true;
+
+        // The terminal may reflow its contents, too.
+        try
+        {
+            _shadowFrame.Resize(newView.Dimensions());
+        }
+        CATCH_RETURN();
     }
 
     // See MSFT:19408543
@@ -423,6 +645,84 @@ void VtEngine::SetResizeQuirk(const bool resizeQuirk)
     _resizeQuirk = resizeQuirk;
 }
 
+// Method Description:
+// - Makes sure the next frame is painted, even if the terminal is behind on
+//   reading our output. For when the caller needs it out before continuing.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void VtEngine::ForceNextFrame() noexcept
+{
+    _forceNextFrame = true;
+}
+
+// Method Description:
+// - Tells the renderer to keep trying to paint while we're holding back
+//   frames, so that what we held back is painted once the terminal caught up.
+// Arguments:
+// - <none>
+// Return Value:
+// - true if the last frame was skipped.
+[[nodiscard]] bool VtEngine::RequiresContinuousRedraw() noexcept
+{
+    return _frameSkipped;
+}
+
+// Method Description:
+// - Sends VT written by a client straight to the terminal, instead of rendering
+//   the buffer once the client's output has been parsed into it. Until
+//   EndPassthrough is called, we won't start any frames or pass through any
+//   strings from the state machine, because the terminal already has them.
+// Arguments:
+// - str: The client's output.
+// Return Value:
+// - S_OK if we succeeded, else an appropriate HRESULT for failing to write.
+[[nodiscard]] HRESULT VtEngine::BeginPassthrough(const std::wstring_view str) noexcept
+{
+    RETURN_IF_FAILED(WriteTerminalW(str));
+    _passthrough = true;
+    _shadowFrame.Reset();
+    return S_OK;
+}
+
+// Method Description:
+// - Called once the output given to BeginPassthrough has been parsed into the
+//   buffer. Everything that was invalidated as it was parsed is already on the
+//   terminal, so it's all forgotten instead of being painted again.
+// Arguments:
+// - cursor: The position of the cursor in the buffer now, relative to the viewport.
+//   The client's output left the terminal's cursor there as well.
+// - cursorInDeferredWrap: True if the cursor is waiting to wrap onto the next line.
+// - attributes: The attributes the client's output left the buffer writing with.
+// Return Value:
+// - S_OK
+[[nodiscard]] HRESULT VtEngine::EndPassthrough(const COORD cursor,
+                                               const bool cursorInDeferredWrap,
+                                               const TextAttribute& attributes) noexcept
+{
+    _passthrough = false;
+
+    // Whatever the client's output did, we haven't seen it.
+    _shadowFrame.Reset();
+    _invalidMap.reset_all();
+    _scrollDelta = { 0, 0 };
+    _circled = false;
+    _cursorMoved = false;
+    _newBottomLine = false;
+    _newBottomLineBG = std::nullopt;
+    _wrappedRow = std::nullopt;
+    _delayedEolWrap = false;
+    _deferredCursorPos = INVALID_COORDS;
+
+    // We can't tell where a terminal is going to put the next character when it's
+    // waiting to wrap, so in that case we'll make sure to move the cursor explicitly.
+    _lastText = cursorInDeferredWrap ? INVALID_COORDS : cursor;
+    _lastTextAttributes = attributes;
+
+    return S_OK;
+}
+
 // Method Description:
 // - Manually emit a "Erase Scrollback" sequence to the connected terminal. We
 //   need to do this in certain cases that we've identified where we believe the
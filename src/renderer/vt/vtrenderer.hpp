@@ -20,8 +20,10 @@ Author(s):
 #include "../../inc/ITerminalOwner.hpp"
 #include "../../types/inc/Viewport.hpp"
 #include "tracing.hpp"
+#include "VtShadowFrame.hpp"
 #include <string>
 #include <functional>
+#include <condition_variable>
 
 // fwdecl unittest classes
 #ifdef UNIT_TESTING
@@ -39,11 +41,13 @@ namespace Microsoft::Console::Render
         // See _PaintUtf8BufferLine for explanation of this value.
         static const size_t ERASE_CHARACTER_STRING_LENGTH = 8;
         static const COORD INVALID_COORDS;
+        static constexpr size_t s_initialBufferSize = 16 * 1024;
+        static constexpr ptrdiff_t s_maxGraphicsRenditionParameters = 16;
 
         VtEngine(_In_ wil::unique_hfile hPipe,
                  const Microsoft::Console::Types::Viewport initialViewport);
 
-        virtual ~VtEngine() override = default;
+        virtual ~VtEngine() override;
 
         [[nodiscard]] HRESULT InvalidateSelection(const std::vector<SMALL_RECT>& rectangles) noexcept override;
         [[nodiscard]] virtual HRESULT InvalidateScroll(const COORD* const pcoordDelta) noexcept = 0;
@@ -55,6 +59,7 @@ namespace Microsoft::Console::Render
         [[nodiscard]] HRESULT PrepareForTeardown(_Out_ bool* const pForcePaint) noexcept override;
 
         [[nodiscard]] virtual HRESULT StartPaint() noexcept override;
+        [[nodiscard]] bool RequiresContinuousRedraw() noexcept override;
         [[nodiscard]] virtual HRESULT EndPaint() noexcept override;
         [[nodiscard]] virtual HRESULT Present() noexcept override;
 
@@ -104,6 +109,12 @@ namespace Microsoft::Console::Render
         void EndResizeRequest();
 
         void SetResizeQuirk(const bool resizeQuirk);
+        void ForceNextFrame() noexcept;
+
+        [[nodiscard]] HRESULT BeginPassthrough(const std::wstring_view str) noexcept;
+        [[nodiscard]] HRESULT EndPassthrough(const COORD cursor,
+                                             const bool cursorInDeferredWrap,
+                                             const TextAttribute& attributes) noexcept;
 
         [[nodiscard]] virtual HRESULT ManuallyClearScrollback() noexcept;
 
@@ -113,6 +124,27 @@ namespace Microsoft::Console::Render
         wil::unique_hfile _hFile;
         std::string _buffer;
 
+        // Frames are written to the pipe by a separate thread, so that painting
+        // (with the console lock held) doesn't wait for the terminal to read them.
+        // While it's still writing, the frames that follow are collected in
+        // _pendingBuffer and then written in one go.
+        std::thread _writerThread;
+        std::mutex _writerLock;
+        std::condition_variable _writerCondition;
+        std::string _pendingBuffer;
+        HRESULT _writerResult{ S_OK };
+        bool _writerBusy{ false };
+        bool _writerExit{ false };
+        bool _flushSynchronously{ false };
+
+        // Set when StartPaint held back a frame because the terminal is behind.
+        bool _frameSkipped{ false };
+        bool _forceNextFrame{ false };
+
+        // Where the last SGR sequence in _buffer is, so that the next one can be merged into it.
+        size_t _lastGraphicsRenditionStart{ 0 };
+        size_t _lastGraphicsRenditionEnd{ std::string::npos };
+
         std::string _formatBuffer;
         std::string _conversionBuffer;
 
@@ -152,18 +184,38 @@ namespace Microsoft::Console::Render
         bool _delayedEolWrap{ false };
 
         bool _resizeQuirk{ false };
+        bool _passthrough{ false };
         std::optional<TextColor> _newBottomLineBG{ std::nullopt };
 
+        // What we last sent to the terminal, so that we don't send it again.
+        VtShadowFrame _shadowFrame;
+
         [[nodiscard]] HRESULT _Write(std::string_view const str) noexcept;
         [[nodiscard]] HRESULT _Flush() noexcept;
+        [[nodiscard]] HRESULT _WritePipe(std::string_view const str) noexcept;
+        void _WriterThread() noexcept;
+        [[nodiscard]] bool _IsWriterBehind() noexcept;
+        void _MergeGraphicsRendition(const size_t start);
 
         template<typename S, typename... Args>
         [[nodiscard]] HRESULT _WriteFormatted(S&& format, Args&&... args)
         try
         {
-            fmt::basic_memory_buffer<char, 64> buf;
-            fmt::format_to(std::back_inserter(buf), std::forward<S>(format), std::forward<Args>(args)...);
-            return _Write({ buf.data(), buf.size() });
+#ifdef UNIT_TESTING
+            if (_usingTestCallback)
+            {
+                fmt::basic_memory_buffer<char, 64> buf;
+                fmt::format_to(std::back_inserter(buf), std::forward<S>(format), std::forward<Args>(args)...);
+                return _Write({ buf.data(), buf.size() });
+            }
+#endif
+
+            // Format straight into the output buffer, rather than into a temporary that's then copied.
+            const auto start = _buffer.size();
+            fmt::format_to(std::back_inserter(_buffer), std::forward<S>(format), std::forward<Args>(args)...);
+            _trace.TraceString({ _buffer.data() + start, _buffer.size() - start });
+            _MergeGraphicsRendition(start);
+            return S_OK;
         }
         CATCH_RETURN()
 
@@ -113,6 +113,22 @@ WddmConEngine::~WddmConEngine()
                         }
                     }
 
+                    if (SUCCEEDED(hr))
+                    {
+                        // The first frame has to paint the whole display. At most every
+                        // other row can start a new dirty range, so GetDirtyArea never
+                        // has to allocate while painting.
+                        try
+                        {
+                            _dirtyRows.assign(gsl::narrow_cast<size_t>(DisplaySize.bottom), true);
+                            _dirtyAreas.reserve(_dirtyRows.size() / 2 + 1);
+                        }
+                        catch (...)
+                        {
+                            hr = E_OUTOFMEMORY;
+                        }
+                    }
+
                     if (SUCCEEDED(hr))
                     {
                         _displayHeight = DisplaySize.bottom;
@@ -161,33 +177,70 @@ bool WddmConEngine::IsInitialized()
     return WDDMConEnableDisplayAccess((PHANDLE)_hWddmConCtx, FALSE);
 }
 
-[[nodiscard]] HRESULT WddmConEngine::Invalidate(const SMALL_RECT* const /*psrRegion*/) noexcept
+// Routine Description:
+// - Marks the rows in the given range as dirty. WddmCon is sent whole rows,
+//   so a row is the smallest unit we track.
+// Arguments:
+// - top - the first row to invalidate
+// - bottom - the row after the last one to invalidate
+// Return Value:
+// - <none>
+void WddmConEngine::_InvalidateRows(const LONG top, const LONG bottom) noexcept
 {
-    return S_OK;
+    const auto rows = gsl::narrow_cast<LONG>(_dirtyRows.size());
+    const auto begin = std::clamp<LONG>(top, 0, rows);
+    const auto end = std::clamp<LONG>(bottom, 0, rows);
+    for (auto row = begin; row < end; ++row)
+    {
+        _dirtyRows[row] = true;
+    }
 }
 
-[[nodiscard]] HRESULT WddmConEngine::InvalidateCursor(const SMALL_RECT* const /*psrRegion*/) noexcept
+[[nodiscard]] HRESULT WddmConEngine::Invalidate(const SMALL_RECT* const psrRegion) noexcept
 {
+    RETURN_HR_IF_NULL(E_INVALIDARG, psrRegion);
+    _InvalidateRows(psrRegion->Top, psrRegion->Bottom);
     return S_OK;
 }
 
+[[nodiscard]] HRESULT WddmConEngine::InvalidateCursor(const SMALL_RECT* const psrRegion) noexcept
+{
+    return Invalidate(psrRegion);
+}
+
 [[nodiscard]] HRESULT WddmConEngine::InvalidateSystem(const RECT* const /*prcDirtyClient*/) noexcept
 {
-    return S_OK;
+    return InvalidateAll();
 }
 
-[[nodiscard]] HRESULT WddmConEngine::InvalidateSelection(const std::vector<SMALL_RECT>& /*rectangles*/) noexcept
+[[nodiscard]] HRESULT WddmConEngine::InvalidateSelection(const std::vector<SMALL_RECT>& rectangles) noexcept
 {
+    for (const auto& rect : rectangles)
+    {
+        RETURN_IF_FAILED(Invalidate(&rect));
+    }
     return S_OK;
 }
 
-[[nodiscard]] HRESULT WddmConEngine::InvalidateScroll(const COORD* const /*pcoordDelta*/) noexcept
+// Routine Description:
+// - WddmCon can't move the contents of the display, so a scroll repaints everything.
+// Arguments:
+// - pcoordDelta - The number of characters the contents moved by.
+// Return Value:
+// - S_OK
+[[nodiscard]] HRESULT WddmConEngine::InvalidateScroll(const COORD* const pcoordDelta) noexcept
 {
+    RETURN_HR_IF_NULL(E_INVALIDARG, pcoordDelta);
+    if (pcoordDelta->X != 0 || pcoordDelta->Y != 0)
+    {
+        RETURN_IF_FAILED(InvalidateAll());
+    }
     return S_OK;
 }
 
 [[nodiscard]] HRESULT WddmConEngine::InvalidateAll() noexcept
 {
+    _InvalidateRows(0, _displayHeight);
     return S_OK;
 }
 
@@ -203,16 +256,60 @@ bool WddmConEngine::IsInitialized()
     return S_FALSE;
 }
 
+// Routine Description:
+// - Starts an update batch, unless no row was invalidated since the last frame.
+// Arguments:
+// - <none>
+// Return Value:
+// - S_OK if there's something to paint, S_FALSE if not, or a suitable HRESULT on failure.
 [[nodiscard]] HRESULT WddmConEngine::StartPaint() noexcept
 {
     RETURN_IF_HANDLE_INVALID(_hWddmConCtx);
+
+    if (std::find(_dirtyRows.cbegin(), _dirtyRows.cend(), true) == _dirtyRows.cend())
+    {
+        return S_FALSE;
+    }
+
     return WDDMConBeginUpdateDisplayBatch(_hWddmConCtx);
 }
 
+// Routine Description:
+// - Submits each repainted row whose contents actually changed, once, and
+//   then ends the update batch. Rows that were repainted with the same
+//   contents they had before aren't sent at all.
+// Arguments:
+// - <none>
+// Return Value:
+// - S_OK, or a suitable HRESULT if a row couldn't be submitted.
 [[nodiscard]] HRESULT WddmConEngine::EndPaint() noexcept
 {
     RETURN_IF_HANDLE_INVALID(_hWddmConCtx);
-    return WDDMConEndUpdateDisplayBatch(_hWddmConCtx);
+
+    HRESULT hr = S_OK;
+
+    for (LONG rowIndex = 0; rowIndex < _displayHeight; rowIndex++)
+    {
+        if (!_dirtyRows[rowIndex])
+        {
+            continue;
+        }
+
+        const auto row = _displayState[rowIndex];
+        if (memcmp(row->Old, row->New, sizeof(CD_IO_CHARACTER) * _displayWidth) != 0)
+        {
+            hr = WDDMConUpdateDisplay(_hWddmConCtx, row, FALSE);
+            if (FAILED(hr))
+            {
+                break;
+            }
+        }
+
+        _dirtyRows[rowIndex] = false;
+    }
+
+    const auto hrEnd = WDDMConEndUpdateDisplayBatch(_hWddmConCtx);
+    return FAILED(hr) ? hr : hrEnd;
 }
 
 // Routine Description:
@@ -242,6 +339,11 @@ bool WddmConEngine::IsInitialized()
 
     for (LONG rowIndex = 0; rowIndex < _displayHeight; rowIndex++)
     {
+        if (!_dirtyRows[rowIndex])
+        {
+            continue;
+        }
+
         for (LONG colIndex = 0; colIndex < _displayWidth; colIndex++)
         {
             OldChar = &_displayState[rowIndex]->Old[colIndex];
@@ -267,22 +369,19 @@ bool WddmConEngine::IsInitialized()
     {
         RETURN_IF_HANDLE_INVALID(_hWddmConCtx);
 
-        PCD_IO_CHARACTER OldChar;
         PCD_IO_CHARACTER NewChar;
 
+        // PaintBackground already moved the previous contents of the row into Old.
+        // The row is submitted once in EndPaint, not once per run of text.
         for (size_t i = 0; i < clusters.size() && i < (size_t)_displayWidth; i++)
         {
-            OldChar = &_displayState[coord.Y]->Old[coord.X + i];
             NewChar = &_displayState[coord.Y]->New[coord.X + i];
 
-            OldChar->Character = NewChar->Character;
-            OldChar->Attribute = NewChar->Attribute;
-
             NewChar->Character = til::at(clusters, i).GetTextAsSingle();
             NewChar->Attribute = _currentLegacyColorAttribute;
         }
 
-        return WDDMConUpdateDisplay(_hWddmConCtx, _displayState[coord.Y], FALSE);
+        return S_OK;
     }
     CATCH_RETURN();
 }
@@ -354,21 +453,39 @@ bool WddmConEngine::IsInitialized()
     return S_OK;
 }
 
+// Routine Description:
+// - Reports the dirty rows as full width rectangles, one per run of consecutive rows.
+// Arguments:
+// - area - receives the rectangles that need to be repainted
+// Return Value:
+// - S_OK, or a suitable HRESULT if we fail to build the list.
 [[nodiscard]] HRESULT WddmConEngine::GetDirtyArea(gsl::span<const til::rectangle>& area) noexcept
+try
 {
-    SMALL_RECT r;
-    r.Bottom = _displayHeight > 0 ? (SHORT)(_displayHeight - 1) : 0;
-    r.Top = 0;
-    r.Left = 0;
-    r.Right = _displayWidth > 0 ? (SHORT)(_displayWidth - 1) : 0;
+    _dirtyAreas.clear();
+
+    const auto rows = gsl::narrow_cast<LONG>(_dirtyRows.size());
+    for (LONG row = 0; row < rows;)
+    {
+        if (!_dirtyRows[row])
+        {
+            ++row;
+            continue;
+        }
 
-    _dirtyArea = r;
+        const auto top = row;
+        while (row < rows && _dirtyRows[row])
+        {
+            ++row;
+        }
+        _dirtyAreas.emplace_back(ptrdiff_t{ 0 }, ptrdiff_t{ top }, ptrdiff_t{ _displayWidth }, ptrdiff_t{ row });
+    }
 
-    area = { &_dirtyArea,
-             1 };
+    area = { _dirtyAreas.data(), _dirtyAreas.size() };
 
     return S_OK;
 }
+CATCH_RETURN()
 
 RECT WddmConEngine::GetDisplaySize()
 {
@@ -389,8 +506,8 @@ RECT WddmConEngine::GetDisplaySize()
     // building in the OneCore 'depot' including DirectX headers and libs is
     // resolved. The font size has no bearing on the behavior of the console
     // since it is used to determine the invalid rectangle whenever the console
-    // buffer changes. However, given that no invalidation logic exists for this
-    // renderer, the value returned by this function is irrelevant.
+    // buffer changes. However, given that this renderer invalidates whole rows
+    // of characters, the value returned by this function is irrelevant.
     //
     // TODO: MSFT 11851921 - Subsume WddmCon into ConhostV2 and remove the API
     //       set extension.
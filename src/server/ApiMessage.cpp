@@ -106,14 +106,8 @@ try
 
         const ULONG cbReadSize = Descriptor.InputSize - State.ReadOffset;
 
-        // If we were previously called with a huge buffer we have an equally large _inputBuffer.
-        // We shouldn't just keep this huge buffer around, if no one needs it anymore.
-        if (_inputBuffer.capacity() > 16 * 1024 && (_inputBuffer.capacity() >> 1) > cbReadSize)
-        {
-            _inputBuffer.shrink_to_fit();
-        }
-
-        _inputBuffer.resize(cbReadSize);
+        // The buffer comes from the pool of this thread and is overwritten right away.
+        _inputBuffer.Resize(cbReadSize);
 
         RETURN_IF_FAILED(ReadMessageInput(0, _inputBuffer.data(), cbReadSize));
 
@@ -152,14 +146,7 @@ try
         ULONG cbWriteSize = Descriptor.OutputSize - State.WriteOffset;
         RETURN_IF_FAILED(ULongMult(cbWriteSize, cbFactor, &cbWriteSize));
 
-        // If we were previously called with a huge buffer we have an equally large _outputBuffer.
-        // We shouldn't just keep this huge buffer around, if no one needs it anymore.
-        if (_outputBuffer.capacity() > 16 * 1024 && (_outputBuffer.capacity() >> 1) > cbWriteSize)
-        {
-            _outputBuffer.shrink_to_fit();
-        }
-
-        _outputBuffer.resize(cbWriteSize);
+        _outputBuffer.Resize(cbWriteSize);
 
         // 0 it out.
         std::fill_n(_outputBuffer.data(), _outputBuffer.size(), BYTE(0));
@@ -206,7 +193,8 @@ CATCH_RETURN();
 
     if (State.InputBuffer != nullptr)
     {
-        _inputBuffer.clear();
+        // Hand the buffer back to the pool, so that the next message can use it.
+        _inputBuffer.Release();
         State.InputBuffer = nullptr;
         State.InputBufferSize = 0;
     }
@@ -224,7 +212,7 @@ CATCH_RETURN();
             LOG_IF_FAILED(_pDeviceComm->WriteOutput(&IoOperation));
         }
 
-        _outputBuffer.clear();
+        _outputBuffer.Release();
         State.OutputBuffer = nullptr;
         State.OutputBufferSize = 0;
     }
@@ -19,6 +19,7 @@ Revision History:
 
 #include "ApiMessageState.h"
 #include "IApiRoutines.h"
+#include "MessageBuffer.h"
 
 class ConsoleProcessHandle;
 class ConsoleHandleData;
@@ -62,8 +63,8 @@ typedef struct _CONSOLE_API_MSG
     IDeviceComm* _pDeviceComm{ nullptr };
     IApiRoutines* _pApiRoutines{ nullptr };
 
-    boost::container::small_vector<BYTE, 128> _inputBuffer;
-    boost::container::small_vector<BYTE, 128> _outputBuffer;
+    MessageBuffer _inputBuffer;
+    MessageBuffer _outputBuffer;
 
     // From here down is the actual packet data sent/received.
     CD_IO_DESCRIPTOR Descriptor;
@@ -0,0 +1,197 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+
+#include "MessageBuffer.h"
+
+// The pool of a thread is destroyed when the thread exits. Buffers released after
+// that (for instance by globals that are torn down on the main thread) are just freed.
+static thread_local bool s_poolDestroyed = false;
+
+MessageBufferPool::~MessageBufferPool()
+{
+    s_poolDestroyed = true;
+}
+
+// Routine Description:
+// - Returns the pool of the calling thread.
+// Arguments:
+// - <none>
+// Return Value:
+// - The pool, or nullptr if the thread is exiting and its pool is gone already.
+MessageBufferPool* MessageBufferPool::ForThread() noexcept
+{
+    if (s_poolDestroyed)
+    {
+        return nullptr;
+    }
+
+    static thread_local MessageBufferPool pool;
+    return &pool;
+}
+
+// Routine Description:
+// - Returns the capacity of the buffer that's handed out for the given size.
+// Arguments:
+// - size - The number of bytes needed.
+// Return Value:
+// - The size rounded up to the next size class, or the size itself if it's too large to be pooled.
+size_t MessageBufferPool::GetCapacity(const size_t size) noexcept
+{
+    if (size > MaximumPooledCapacity)
+    {
+        return size;
+    }
+
+    size_t capacity = MinimumCapacity;
+    while (capacity < size)
+    {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+size_t MessageBufferPool::_GetClass(const size_t capacity) noexcept
+{
+    size_t index = 0;
+    while ((MinimumCapacity << index) < capacity)
+    {
+        ++index;
+    }
+    return index;
+}
+
+// Routine Description:
+// - Hands out a buffer of the given capacity, reusing a free one if possible.
+// Arguments:
+// - capacity - The capacity of the buffer, as returned by GetCapacity.
+// Return Value:
+// - The buffer. Its contents are uninitialized.
+std::unique_ptr<BYTE[]> MessageBufferPool::Acquire(const size_t capacity)
+{
+    if (capacity <= MaximumPooledCapacity)
+    {
+        auto& free = til::at(_free, _GetClass(capacity));
+        if (!free.empty())
+        {
+            auto buffer = std::move(free.back());
+            free.pop_back();
+            _retainedBytes -= capacity;
+            return buffer;
+        }
+    }
+
+    // Unlike std::make_unique this doesn't zero the buffer.
+    return std::unique_ptr<BYTE[]>{ new BYTE[capacity] };
+}
+
+// Routine Description:
+// - Takes back a buffer handed out by Acquire, freeing it if the pool is full.
+// Arguments:
+// - buffer - The buffer.
+// - capacity - The capacity it was acquired with.
+// Return Value:
+// - <none>
+void MessageBufferPool::Release(std::unique_ptr<BYTE[]> buffer, const size_t capacity) noexcept
+{
+    if (capacity > MaximumPooledCapacity || _retainedBytes + capacity > MaximumRetainedBytes)
+    {
+        return;
+    }
+
+    auto& free = til::at(_free, _GetClass(capacity));
+    if (free.size() >= MaximumFreePerClass)
+    {
+        return;
+    }
+
+    try
+    {
+        // If this fails, the buffer stays ours and is freed.
+        free.emplace_back(std::move(buffer));
+        _retainedBytes += capacity;
+    }
+    CATCH_LOG();
+}
+
+MessageBuffer::~MessageBuffer()
+{
+    Release();
+}
+
+MessageBuffer::MessageBuffer(const MessageBuffer& other)
+{
+    *this = other;
+}
+
+// Routine Description:
+// - Copies the contents of another buffer into a buffer of our own.
+//   Messages are copied like this when they're parked in a ConsoleWaitBlock.
+MessageBuffer& MessageBuffer::operator=(const MessageBuffer& other)
+{
+    if (this != &other)
+    {
+        if (other._buffer)
+        {
+            Resize(other._size);
+            std::copy_n(other._buffer.get(), other._size, _buffer.get());
+        }
+        else
+        {
+            Release();
+        }
+    }
+    return *this;
+}
+
+BYTE* MessageBuffer::data() const noexcept
+{
+    return _buffer.get();
+}
+
+size_t MessageBuffer::size() const noexcept
+{
+    return _size;
+}
+
+// Routine Description:
+// - Resizes the buffer, taking a larger one from the pool if necessary.
+//   Afterwards data() is never null, even if size is 0.
+// Arguments:
+// - size - The new size in bytes.
+// Return Value:
+// - <none>
+void MessageBuffer::Resize(const size_t size)
+{
+    if (!_buffer || size > _capacity)
+    {
+        const auto capacity = MessageBufferPool::GetCapacity(size);
+        const auto pool = MessageBufferPool::ForThread();
+        auto buffer = pool ? pool->Acquire(capacity) : std::unique_ptr<BYTE[]>{ new BYTE[capacity] };
+        Release();
+        _buffer = std::move(buffer);
+        _capacity = capacity;
+    }
+    _size = size;
+}
+
+// Routine Description:
+// - Hands the buffer back to the pool of the calling thread.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void MessageBuffer::Release() noexcept
+{
+    if (_buffer)
+    {
+        if (const auto pool = MessageBufferPool::ForThread())
+        {
+            pool->Release(std::move(_buffer), _capacity);
+        }
+        _buffer.reset();
+        _capacity = 0;
+        _size = 0;
+    }
+}
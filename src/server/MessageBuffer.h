@@ -0,0 +1,72 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- MessageBuffer.h
+
+Abstract:
+- This file defines the buffers holding the input and output payload of an API message,
+  and the per-thread pool they're allocated from.
+- Buffers are handed out in power of two size classes and go back to the pool of the
+  thread that releases them when their message completes. This includes messages that
+  were copied into a ConsoleWaitBlock and complete later on.
+--*/
+
+#pragma once
+
+class MessageBufferPool final
+{
+public:
+    static constexpr size_t MinimumCapacity = 256;
+    // Larger buffers are rare and are allocated (and freed) as needed.
+    static constexpr size_t MaximumPooledCapacity = 1024 * 1024;
+    // The pool of each thread keeps at most this many buffers per size class...
+    static constexpr size_t MaximumFreePerClass = 4;
+    // ...and at most this many bytes in total.
+    static constexpr size_t MaximumRetainedBytes = 4 * 1024 * 1024;
+
+    MessageBufferPool() = default;
+    ~MessageBufferPool();
+
+    MessageBufferPool(const MessageBufferPool&) = delete;
+    MessageBufferPool& operator=(const MessageBufferPool&) = delete;
+
+    static MessageBufferPool* ForThread() noexcept;
+    static size_t GetCapacity(const size_t size) noexcept;
+
+    std::unique_ptr<BYTE[]> Acquire(const size_t capacity);
+    void Release(std::unique_ptr<BYTE[]> buffer, const size_t capacity) noexcept;
+
+private:
+    static size_t _GetClass(const size_t capacity) noexcept;
+
+    static constexpr size_t ClassCount = 13; // MinimumCapacity << 12 == MaximumPooledCapacity
+    std::array<std::vector<std::unique_ptr<BYTE[]>>, ClassCount> _free;
+    size_t _retainedBytes = 0;
+};
+
+// A byte buffer taken from the MessageBufferPool of the current thread.
+// Unlike a std::vector, resizing it doesn't initialize its contents.
+class MessageBuffer final
+{
+public:
+    MessageBuffer() = default;
+    ~MessageBuffer();
+
+    MessageBuffer(const MessageBuffer& other);
+    MessageBuffer& operator=(const MessageBuffer& other);
+    MessageBuffer(MessageBuffer&&) = delete;
+    MessageBuffer& operator=(MessageBuffer&&) = delete;
+
+    BYTE* data() const noexcept;
+    size_t size() const noexcept;
+
+    void Resize(const size_t size);
+    void Release() noexcept;
+
+private:
+    std::unique_ptr<BYTE[]> _buffer;
+    size_t _capacity = 0;
+    size_t _size = 0;
+};
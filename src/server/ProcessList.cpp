@@ -61,11 +61,28 @@ using namespace Microsoft::Console::Interactivity;
         pProcessData = new ConsoleProcessHandle(dwProcessId,
                                                 dwThreadId,
                                                 ulProcessGroupId);
+        auto DeleteProcessData = wil::scope_exit([&] { delete pProcessData; });
+
+        // Allocate everything up front, so that a failure leaves the list and its indices as they were.
+        auto& group = _processesByGroupId[ulProcessGroupId];
+        auto RemoveEmptyGroup = wil::scope_exit([&] {
+            if (group.empty())
+            {
+                _processesByGroupId.erase(ulProcessGroupId);
+            }
+        });
+        std::list<ConsoleProcessHandle*> processNode{ pProcessData };
+        std::list<ConsoleProcessHandle*> groupNode{ pProcessData };
+        const auto entry = _processesById.emplace(dwProcessId, IndexEntry{}).first;
 
         // Some applications, when reading the process list through the GetConsoleProcessList API, are expecting
         // the returned list of attached process IDs to be from newest to oldest.
         // As such, we have to put the newest process into the head of the list.
-        _processes.push_front(pProcessData);
+        // The same goes for its process group, which then stays in the same order.
+        _processes.splice(_processes.begin(), processNode);
+        group.splice(group.begin(), groupNode);
+        entry->second = IndexEntry{ _processes.begin(), group.begin() };
+        DeleteProcessData.release();
 
         if (nullptr != ppProcessData)
         {
@@ -87,10 +104,18 @@ void ConsoleProcessList::FreeProcessData(_In_ ConsoleProcessHandle* const pProce
 {
     FAIL_FAST_IF(!(ServiceLocator::LocateGlobals().getConsoleInformation().IsConsoleLocked()));
 
-    // Assert that the item exists in the list. If it doesn't exist, the end/last will be returned.
-    FAIL_FAST_IF(!(_processes.cend() != std::find(_processes.cbegin(), _processes.cend(), pProcessData)));
+    // Assert that the item exists in the list.
+    const auto entry = _processesById.find(pProcessData->dwProcessId);
+    FAIL_FAST_IF(!(entry != _processesById.end() && *entry->second.process == pProcessData));
 
-    _processes.remove(pProcessData);
+    const auto group = _processesByGroupId.find(pProcessData->_ulProcessGroupId);
+    group->second.erase(entry->second.group);
+    if (group->second.empty())
+    {
+        _processesByGroupId.erase(group);
+    }
+    _processes.erase(entry->second.process);
+    _processesById.erase(entry);
 
     delete pProcessData;
 }
@@ -104,31 +129,18 @@ void ConsoleProcessList::FreeProcessData(_In_ ConsoleProcessHandle* const pProce
 // - Pointer to the process handle information or nullptr if no match was found.
 ConsoleProcessHandle* ConsoleProcessList::FindProcessInList(const DWORD dwProcessId) const
 {
-    auto it = _processes.cbegin();
-
-    while (it != _processes.cend())
+    if (ROOT_PROCESS_ID != dwProcessId)
     {
-        ConsoleProcessHandle* const pProcessHandleRecord = *it;
-
-        if (ROOT_PROCESS_ID != dwProcessId)
-        {
-            if (pProcessHandleRecord->dwProcessId == dwProcessId)
-            {
-                return pProcessHandleRecord;
-            }
-        }
-        else
-        {
-            if (pProcessHandleRecord->fRootProcess)
-            {
-                return pProcessHandleRecord;
-            }
-        }
-
-        it = std::next(it);
+        const auto entry = _processesById.find(dwProcessId);
+        return entry != _processesById.end() ? *entry->second.process : nullptr;
     }
 
-    return nullptr;
+    // The root process is reassigned from the outside (see fRootProcess), so
+    // there's no index for it. It's rarely looked up, though.
+    const auto it = std::find_if(_processes.cbegin(), _processes.cend(), [](const ConsoleProcessHandle* const pProcessHandleRecord) {
+        return pProcessHandleRecord->fRootProcess;
+    });
+    return it != _processes.cend() ? *it : nullptr;
 }
 
 // Routine Description:
@@ -139,20 +151,9 @@ ConsoleProcessHandle* ConsoleProcessList::FindProcessInList(const DWORD dwProces
 // - Pointer to first matching process handle with given group ID. nullptr if no match was found.
 ConsoleProcessHandle* ConsoleProcessList::FindProcessByGroupId(_In_ ULONG ulProcessGroupId) const
 {
-    auto it = _processes.cbegin();
-
-    while (it != _processes.cend())
-    {
-        ConsoleProcessHandle* const pProcessHandleRecord = *it;
-        if (pProcessHandleRecord->_ulProcessGroupId == ulProcessGroupId)
-        {
-            return pProcessHandleRecord;
-        }
-
-        it = std::next(it);
-    }
-
-    return nullptr;
+    // Groups are removed once their last process is, so they're never empty.
+    const auto group = _processesByGroupId.find(ulProcessGroupId);
+    return group != _processesByGroupId.end() ? group->second.front() : nullptr;
 }
 
 // Routine Description:
@@ -217,55 +218,48 @@ ConsoleProcessHandle* ConsoleProcessList::FindProcessByGroupId(_In_ ULONG ulProc
 
     try
     {
-        std::deque<std::unique_ptr<ConsoleProcessTerminationRecord>> TermRecords;
-
-        // Dig through known processes looking for a match
-        auto it = _processes.cbegin();
-        while (it != _processes.cend())
+        // If no limit was specified, every process gets a termination record.
+        // Otherwise only the ones in the given process group do.
+        static const std::list<ConsoleProcessHandle*> noProcesses;
+        const std::list<ConsoleProcessHandle*>* pMatches = &_processes;
+        if (0 != dwLimitingProcessId)
         {
-            ConsoleProcessHandle* const pProcessHandleRecord = *it;
-
-            // If no limit was specified OR if we have a match, generate a new termination record.
-            if (0 == dwLimitingProcessId ||
-                pProcessHandleRecord->_ulProcessGroupId == dwLimitingProcessId)
-            {
-                std::unique_ptr<ConsoleProcessTerminationRecord> pNewRecord = std::make_unique<ConsoleProcessTerminationRecord>();
-
-                // If the duplicate failed, the best we can do is to skip including the process in the list and hope it goes away.
-                LOG_IF_WIN32_BOOL_FALSE(DuplicateHandle(GetCurrentProcess(),
-                                                        pProcessHandleRecord->_hProcess.get(),
-                                                        GetCurrentProcess(),
-                                                        &pNewRecord->hProcess,
-                                                        0,
-                                                        0,
-                                                        DUPLICATE_SAME_ACCESS));
-
-                pNewRecord->dwProcessID = pProcessHandleRecord->dwProcessId;
-
-                // If we're hard closing the window, increment the counter.
-                if (fCtrlClose)
-                {
-                    pProcessHandleRecord->_ulTerminateCount++;
-                }
-
-                pNewRecord->ulTerminateCount = pProcessHandleRecord->_ulTerminateCount;
-
-                TermRecords.push_back(std::move(pNewRecord));
-            }
-
-            it = std::next(it);
+            const auto group = _processesByGroupId.find(dwLimitingProcessId);
+            pMatches = group != _processesByGroupId.end() ? &group->second : &noProcesses;
         }
 
-        // From all found matches, convert to C-style array to return
-        size_t const cchRetVal = TermRecords.size();
-        ConsoleProcessTerminationRecord* pRetVal = new ConsoleProcessTerminationRecord[cchRetVal];
+        // Convert all matches to a C-style array to return. Both lists are
+        // in the same order, newest process first.
+        size_t const cchRetVal = pMatches->size();
+        std::unique_ptr<ConsoleProcessTerminationRecord[]> pRetVal{ new ConsoleProcessTerminationRecord[cchRetVal] };
 
-        for (size_t i = 0; i < cchRetVal; i++)
+        size_t i = 0;
+        for (ConsoleProcessHandle* const pProcessHandleRecord : *pMatches)
         {
-            pRetVal[i] = *TermRecords.at(i);
+            ConsoleProcessTerminationRecord& record = pRetVal[i++];
+            record.hProcess = nullptr;
+
+            // If the duplicate failed, the best we can do is to skip including the process in the list and hope it goes away.
+            LOG_IF_WIN32_BOOL_FALSE(DuplicateHandle(GetCurrentProcess(),
+                                                    pProcessHandleRecord->_hProcess.get(),
+                                                    GetCurrentProcess(),
+                                                    &record.hProcess,
+                                                    0,
+                                                    0,
+                                                    DUPLICATE_SAME_ACCESS));
+
+            record.dwProcessID = pProcessHandleRecord->dwProcessId;
+
+            // If we're hard closing the window, increment the counter.
+            if (fCtrlClose)
+            {
+                pProcessHandleRecord->_ulTerminateCount++;
+            }
+
+            record.ulTerminateCount = pProcessHandleRecord->_ulTerminateCount;
         }
 
-        *prgRecords = pRetVal;
+        *prgRecords = pRetVal.release();
         *pcRecords = cchRetVal;
     }
     CATCH_RETURN();
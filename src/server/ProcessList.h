@@ -59,7 +59,21 @@ public:
     bool IsEmpty() const;
 
 private:
+    // Newest process first. GetConsoleProcessList callers and the ctrl event
+    // delivery rely on this order.
     std::list<ConsoleProcessHandle*> _processes;
 
+    // The processes of every process group, in the same order as _processes.
+    std::unordered_map<ULONG, std::list<ConsoleProcessHandle*>> _processesByGroupId;
+
+    // Where each process is stored in _processes and in its process group,
+    // so that it can be found and removed without walking either of them.
+    struct IndexEntry
+    {
+        std::list<ConsoleProcessHandle*>::iterator process;
+        std::list<ConsoleProcessHandle*>::iterator group;
+    };
+    std::unordered_map<DWORD, IndexEntry> _processesById;
+
     void _ModifyProcessForegroundRights(const HANDLE hProcess, const bool fForeground) const;
 };
@@ -133,6 +133,8 @@ public:
 
     virtual bool DoConEmuAction(const std::wstring_view string) = 0;
 
+    virtual bool DoFinalTermAction(const std::wstring_view string) = 0;
+
     virtual StringHandler DownloadDRCS(const size_t fontNumber,
                                        const VTParameter startChar,
                                        const DispatchTypes::DrcsEraseControl eraseControl,
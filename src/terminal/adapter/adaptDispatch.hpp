@@ -131,6 +131,8 @@ namespace Microsoft::Console::VirtualTerminal
 
         bool DoConEmuAction(const std::wstring_view string) noexcept override;
 
+        bool DoFinalTermAction(const std::wstring_view string) noexcept override;
+
         StringHandler DownloadDRCS(const size_t fontNumber,
                                    const VTParameter startChar,
                                    const DispatchTypes::DrcsEraseControl eraseControl,
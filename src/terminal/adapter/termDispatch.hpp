@@ -124,6 +124,8 @@ public:
 
     bool DoConEmuAction(const std::wstring_view /*string*/) noexcept override { return false; }
 
+    bool DoFinalTermAction(const std::wstring_view /*string*/) noexcept override { return false; }
+
     StringHandler DownloadDRCS(const size_t /*fontNumber*/,
                                const VTParameter /*startChar*/,
                                const DispatchTypes::DrcsEraseControl /*eraseControl*/,
@@ -651,4 +651,48 @@ public:
         mouseInput->EnableAlternateScroll(true);
         VERIFY_IS_FALSE(mouseInput->HandleMouse({ 0, 0 }, WM_MOUSEWHEEL, noModifierKeys, WHEEL_DELTA, {}));
     }
+
+    TEST_METHOD(MotionCoalescingTests)
+    {
+        std::vector<std::wstring> sent;
+        auto mouseInput = std::make_unique<TerminalInput>([&](std::deque<std::unique_ptr<IInputEvent>>& events) {
+            std::wstring sequence;
+            for (const auto& event : events)
+            {
+                sequence.push_back(static_cast<const KeyEvent*>(event.get())->GetCharData());
+            }
+            sent.emplace_back(std::move(sequence));
+        });
+        const short noModifierKeys = 0;
+
+        mouseInput->EnableAnyEventTracking(true);
+        mouseInput->SetSGRExtendedMode(true);
+        mouseInput->EnableMouseMotionCoalescing(true);
+
+        Log::Comment(L"Motion is held back and only the latest report is sent.");
+        VERIFY_IS_TRUE(mouseInput->HandleMouse({ 1, 1 }, WM_MOUSEMOVE, noModifierKeys, 0, {}));
+        VERIFY_IS_TRUE(mouseInput->HandleMouse({ 2, 2 }, WM_MOUSEMOVE, noModifierKeys, 0, {}));
+        VERIFY_IS_TRUE(mouseInput->HandleMouse({ 3, 3 }, WM_MOUSEMOVE, noModifierKeys, 0, {}));
+        VERIFY_ARE_EQUAL(0u, sent.size());
+        VERIFY_IS_TRUE(mouseInput->FlushMouseMotion());
+        VERIFY_ARE_EQUAL(1u, sent.size());
+        VERIFY_ARE_EQUAL(L"\x1b[<35;4;4m", sent.at(0));
+        VERIFY_IS_FALSE(mouseInput->FlushMouseMotion());
+
+        Log::Comment(L"Button presses are sent right away, after the motion before them.");
+        sent.clear();
+        VERIFY_IS_TRUE(mouseInput->HandleMouse({ 4, 4 }, WM_MOUSEMOVE, noModifierKeys, 0, {}));
+        VERIFY_IS_TRUE(mouseInput->HandleMouse({ 4, 4 }, WM_LBUTTONDOWN, noModifierKeys, 0, {}));
+        VERIFY_ARE_EQUAL(2u, sent.size());
+        VERIFY_ARE_EQUAL(L"\x1b[<35;5;5m", sent.at(0));
+        VERIFY_ARE_EQUAL(L"\x1b[<0;5;5M", sent.at(1));
+        VERIFY_IS_FALSE(mouseInput->FlushMouseMotion());
+
+        Log::Comment(L"Held back motion is dropped when the application changes the mouse mode.");
+        sent.clear();
+        VERIFY_IS_TRUE(mouseInput->HandleMouse({ 5, 5 }, WM_MOUSEMOVE, noModifierKeys, 0, {}));
+        mouseInput->EnableAnyEventTracking(false);
+        VERIFY_IS_FALSE(mouseInput->FlushMouseMotion());
+        VERIFY_ARE_EQUAL(0u, sent.size());
+    }
 };
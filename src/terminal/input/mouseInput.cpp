@@ -369,34 +369,37 @@ bool TerminalInput::HandleMouse(const COORD position,
 
             if (success)
             {
-                std::wstring sequence;
+                MouseSequence sequence;
                 switch (_mouseInputState.extendedMode)
                 {
                 case ExtendedMode::None:
-                    sequence = _GenerateDefaultSequence(position,
-                                                        realButton,
-                                                        isHover,
-                                                        modifierKeyState,
-                                                        delta);
+                    _GenerateDefaultSequence(position,
+                                             realButton,
+                                             isHover,
+                                             modifierKeyState,
+                                             delta,
+                                             sequence);
                     break;
                 case ExtendedMode::Utf8:
-                    sequence = _GenerateUtf8Sequence(position,
-                                                     realButton,
-                                                     isHover,
-                                                     modifierKeyState,
-                                                     delta);
+                    _GenerateUtf8Sequence(position,
+                                          realButton,
+                                          isHover,
+                                          modifierKeyState,
+                                          delta,
+                                          sequence);
                     break;
                 case ExtendedMode::Sgr:
                     // For SGR encoding, if no physical buttons were pressed,
                     // then we want to handle hovers with WM_MOUSEMOVE.
                     // However, if we're dragging (WM_MOUSEMOVE with a button pressed),
                     //      then use that pressed button instead.
-                    sequence = _GenerateSGRSequence(position,
-                                                    physicalButtonPressed ? realButton : button,
-                                                    _isButtonDown(realButton), // Use realButton here, to properly get the up/down state
-                                                    isHover,
-                                                    modifierKeyState,
-                                                    delta);
+                    _GenerateSGRSequence(position,
+                                         physicalButtonPressed ? realButton : button,
+                                         _isButtonDown(realButton), // Use realButton here, to properly get the up/down state
+                                         isHover,
+                                         modifierKeyState,
+                                         delta,
+                                         sequence);
                     break;
                 case ExtendedMode::Urxvt:
                 default:
@@ -404,12 +407,23 @@ bool TerminalInput::HandleMouse(const COORD position,
                     break;
                 }
 
-                success = !sequence.empty();
+                success = sequence.size() != 0;
 
                 if (success)
                 {
-                    _SendInputSequence(sequence);
-                    success = true;
+                    const std::wstring_view view{ sequence.data(), sequence.size() };
+                    if (isHover && _mouseInputState.coalesceMotion)
+                    {
+                        // Only the latest motion matters to the application. It's sent
+                        // once the host calls FlushMouseMotion, or before the next button report.
+                        _mouseInputState.pendingMotion.assign(view);
+                    }
+                    else
+                    {
+                        // Button reports are never coalesced, but they mustn't overtake the motion before them.
+                        FlushMouseMotion();
+                        _SendInputSequence(view);
+                    }
                 }
                 if (_mouseInputState.trackingMode == TrackingMode::ButtonEvent || _mouseInputState.trackingMode == TrackingMode::AnyEvent)
                 {
@@ -423,6 +437,27 @@ bool TerminalInput::HandleMouse(const COORD position,
     return success;
 }
 
+// Routine Description:
+// - Sends the motion report that was held back by the motion coalescing mode
+//     (see EnableMouseMotionCoalescing), if there is one. Hosts that enable that
+//     mode should call this about once per frame.
+// Parameters:
+// - <none>
+// Return value:
+// - true if a motion report was sent.
+bool TerminalInput::FlushMouseMotion()
+{
+    if (_mouseInputState.pendingMotion.empty())
+    {
+        return false;
+    }
+
+    _SendInputSequence(_mouseInputState.pendingMotion);
+    // clear() keeps the capacity, so the next motion report doesn't allocate either.
+    _mouseInputState.pendingMotion.clear();
+    return true;
+}
+
 // Routine Description:
 // - Generates a sequence encoding the mouse event according to the default scheme.
 //     see http://invisible-island.net/xterm/ctlseqs/ctlseqs.html#h2-Mouse-Tracking
@@ -432,13 +467,15 @@ bool TerminalInput::HandleMouse(const COORD position,
 // - isHover - true if the sequence is generated in response to a mouse hover
 // - modifierKeyState - the modifier keys pressed with this button
 // - delta - the amount that the scroll wheel changed (should be 0 unless button is a WM_MOUSE*WHEEL)
+// - sequence - receives the generated sequence. Stays empty if we couldn't generate.
 // Return value:
-// - The generated sequence. Will be empty if we couldn't generate.
-std::wstring TerminalInput::_GenerateDefaultSequence(const COORD position,
-                                                     const unsigned int button,
-                                                     const bool isHover,
-                                                     const short modifierKeyState,
-                                                     const short delta)
+// - <none>
+void TerminalInput::_GenerateDefaultSequence(const COORD position,
+                                             const unsigned int button,
+                                             const bool isHover,
+                                             const short modifierKeyState,
+                                             const short delta,
+                                             MouseSequence& sequence)
 {
     // In the default, non-extended encoding scheme, coordinates above 94 shouldn't be supported,
     //   because (95+32+1)=128, which is not an ASCII character.
@@ -450,14 +487,10 @@ std::wstring TerminalInput::_GenerateDefaultSequence(const COORD position,
         const short encodedX = _encodeDefaultCoordinate(vtCoords.X);
         const short encodedY = _encodeDefaultCoordinate(vtCoords.Y);
 
-        std::wstring format{ L"\x1b[Mbxy" };
-        format.at(3) = ' ' + gsl::narrow_cast<short>(_windowsButtonToXEncoding(button, isHover, modifierKeyState, delta));
-        format.at(4) = encodedX;
-        format.at(5) = encodedY;
-        return format;
+        const wchar_t encodedButton = ' ' + gsl::narrow_cast<short>(_windowsButtonToXEncoding(button, isHover, modifierKeyState, delta));
+        const std::array<wchar_t, 6> format{ L'\x1b', L'[', L'M', encodedButton, static_cast<wchar_t>(encodedX), static_cast<wchar_t>(encodedY) };
+        sequence.append(format.data(), format.data() + format.size());
     }
-
-    return {};
 }
 
 // Routine Description:
@@ -469,13 +502,15 @@ std::wstring TerminalInput::_GenerateDefaultSequence(const COORD position,
 // - isHover - true if the sequence is generated in response to a mouse hover
 // - modifierKeyState - the modifier keys pressed with this button
 // - delta - the amount that the scroll wheel changed (should be 0 unless button is a WM_MOUSE*WHEEL)
+// - sequence - receives the generated sequence. Stays empty if we couldn't generate.
 // Return value:
-// - The generated sequence. Will be empty if we couldn't generate.
-std::wstring TerminalInput::_GenerateUtf8Sequence(const COORD position,
-                                                  const unsigned int button,
-                                                  const bool isHover,
-                                                  const short modifierKeyState,
-                                                  const short delta)
+// - <none>
+void TerminalInput::_GenerateUtf8Sequence(const COORD position,
+                                          const unsigned int button,
+                                          const bool isHover,
+                                          const short modifierKeyState,
+                                          const short delta,
+                                          MouseSequence& sequence)
 {
     // So we have some complications here.
     // The windows input stream is typically encoded as UTF16.
@@ -496,15 +531,11 @@ std::wstring TerminalInput::_GenerateUtf8Sequence(const COORD position,
         const COORD vtCoords = _winToVTCoord(position);
         const short encodedX = _encodeDefaultCoordinate(vtCoords.X);
         const short encodedY = _encodeDefaultCoordinate(vtCoords.Y);
-        std::wstring format{ L"\x1b[Mbxy" };
         // The short cast is safe because we know s_WindowsButtonToXEncoding  never returns more than xff
-        format.at(3) = ' ' + gsl::narrow_cast<short>(_windowsButtonToXEncoding(button, isHover, modifierKeyState, delta));
-        format.at(4) = encodedX;
-        format.at(5) = encodedY;
-        return format;
+        const wchar_t encodedButton = ' ' + gsl::narrow_cast<short>(_windowsButtonToXEncoding(button, isHover, modifierKeyState, delta));
+        const std::array<wchar_t, 6> format{ L'\x1b', L'[', L'M', encodedButton, static_cast<wchar_t>(encodedX), static_cast<wchar_t>(encodedY) };
+        sequence.append(format.data(), format.data() + format.size());
     }
-
-    return {};
 }
 
 // Routine Description:
@@ -517,25 +548,22 @@ std::wstring TerminalInput::_GenerateUtf8Sequence(const COORD position,
 // - isHover - true if the sequence is generated in response to a mouse hover
 // - modifierKeyState - the modifier keys pressed with this button
 // - delta - the amount that the scroll wheel changed (should be 0 unless button is a WM_MOUSE*WHEEL)
-// - ppwchSequence - On success, where to put the pointer to the generated sequence
-// - pcchLength - On success, where to put the length of the generated sequence
+// - sequence - receives the generated sequence.
 // Return value:
-// - true if we were able to successfully generate a sequence.
-// On success, caller is responsible for delete[]ing *ppwchSequence.
-std::wstring TerminalInput::_GenerateSGRSequence(const COORD position,
-                                                 const unsigned int button,
-                                                 const bool isDown,
-                                                 const bool isHover,
-                                                 const short modifierKeyState,
-                                                 const short delta)
+// - <none>
+void TerminalInput::_GenerateSGRSequence(const COORD position,
+                                         const unsigned int button,
+                                         const bool isDown,
+                                         const bool isHover,
+                                         const short modifierKeyState,
+                                         const short delta,
+                                         MouseSequence& sequence)
 {
     // Format for SGR events is:
     // "\x1b[<%d;%d;%d;%c", xButton, x+1, y+1, fButtonDown? 'M' : 'm'
     const int xbutton = _windowsButtonToSGREncoding(button, isHover, modifierKeyState, delta);
 
-    auto format = wil::str_printf<std::wstring>(L"\x1b[<%d;%d;%d%c", xbutton, position.X + 1, position.Y + 1, isDown ? L'M' : L'm');
-
-    return format;
+    fmt::format_to(std::back_inserter(sequence), FMT_COMPILE(L"\x1b[<{};{};{}{}"), xbutton, position.X + 1, position.Y + 1, isDown ? L'M' : L'm');
 }
 
 // Routine Description:
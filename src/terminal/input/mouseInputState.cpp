@@ -47,6 +47,7 @@ void TerminalInput::EnableDefaultTracking(const bool enable) noexcept
     _mouseInputState.trackingMode = enable ? TrackingMode::Default : TrackingMode::None;
     _mouseInputState.lastPos = { -1, -1 }; // Clear out the last saved mouse position & button.
     _mouseInputState.lastButton = 0;
+    _mouseInputState.pendingMotion.clear(); // It was meant for the previous mode.
 }
 
 // Routine Description:
@@ -63,6 +64,7 @@ void TerminalInput::EnableButtonEventTracking(const bool enable) noexcept
     _mouseInputState.trackingMode = enable ? TrackingMode::ButtonEvent : TrackingMode::None;
     _mouseInputState.lastPos = { -1, -1 }; // Clear out the last saved mouse position & button.
     _mouseInputState.lastButton = 0;
+    _mouseInputState.pendingMotion.clear(); // It was meant for the previous mode.
 }
 
 // Routine Description:
@@ -79,6 +81,7 @@ void TerminalInput::EnableAnyEventTracking(const bool enable) noexcept
     _mouseInputState.trackingMode = enable ? TrackingMode::AnyEvent : TrackingMode::None;
     _mouseInputState.lastPos = { -1, -1 }; // Clear out the last saved mouse position & button.
     _mouseInputState.lastButton = 0;
+    _mouseInputState.pendingMotion.clear(); // It was meant for the previous mode.
 }
 
 // Routine Description:
@@ -92,6 +95,21 @@ void TerminalInput::EnableAlternateScroll(const bool enable) noexcept
     _mouseInputState.alternateScroll = enable;
 }
 
+// Routine Description:
+// - Enables or disables motion coalescing. While it's enabled, motion reports
+//      aren't sent right away. Instead only the latest one is kept, until the
+//      host calls FlushMouseMotion or a button report needs to be sent. This way
+//      a high polling rate mouse can't flood the input of a mouse mode application.
+//      Button presses and releases are still reported exactly as they happened.
+// Parameters:
+// - enable - either enable or disable.
+// Return value:
+// <none>
+void TerminalInput::EnableMouseMotionCoalescing(const bool enable) noexcept
+{
+    _mouseInputState.coalesceMotion = enable;
+}
+
 // Routine Description:
 // - Notify the MouseInput handler that the screen buffer has been swapped to the alternate buffer
 // Parameters:
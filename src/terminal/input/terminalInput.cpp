@@ -245,6 +245,59 @@ static constexpr std::array<TermKeyMap, 14> s_simpleModifiedKeyMapping{
     // TermKeyMap{ VK_ESCAPE, ALT_PRESSED, L""}, This is another Windows system shortcut for switching windows.
 };
 
+// For every virtual key, the index of its first entry in a key mapping table,
+// or UINT8_MAX if there is none. This way finding the entries for a key takes
+// a single lookup instead of a scan through the table.
+using TermKeyIndex = std::array<uint8_t, 256>;
+
+// Builds the TermKeyIndex of a key mapping table at compile time.
+// All the entries for a key need to be next to each other.
+template<size_t N>
+static constexpr TermKeyIndex _makeKeyIndex(const std::array<TermKeyMap, N>& mapping)
+{
+    static_assert(N < UINT8_MAX);
+
+    TermKeyIndex index{};
+    for (auto& first : index)
+    {
+        first = UINT8_MAX;
+    }
+    for (auto i = N; i-- > 0;)
+    {
+        const auto vkey = mapping[i].vkey;
+        if (vkey >= index.size() || (index[vkey] != UINT8_MAX && mapping[i + 1].vkey != vkey))
+        {
+            // Throwing here fails the compilation, since this only ever runs in constant evaluation.
+            throw std::logic_error("key mapping entries must be grouped by virtual key");
+        }
+        index[vkey] = static_cast<uint8_t>(i);
+    }
+    return index;
+}
+
+static constexpr auto s_cursorKeysNormalIndex = _makeKeyIndex(s_cursorKeysNormalMapping);
+static constexpr auto s_cursorKeysApplicationIndex = _makeKeyIndex(s_cursorKeysApplicationMapping);
+static constexpr auto s_cursorKeysVt52Index = _makeKeyIndex(s_cursorKeysVt52Mapping);
+static constexpr auto s_keypadNumericIndex = _makeKeyIndex(s_keypadNumericMapping);
+static constexpr auto s_keypadApplicationIndex = _makeKeyIndex(s_keypadApplicationMapping);
+static constexpr auto s_keypadVt52Index = _makeKeyIndex(s_keypadVt52Mapping);
+static constexpr auto s_modifierKeyIndex = _makeKeyIndex(s_modifierKeyMapping);
+static constexpr auto s_simpleModifiedKeyIndex = _makeKeyIndex(s_simpleModifiedKeyMapping);
+
+// A key mapping table along with its TermKeyIndex.
+struct TermKeyTable
+{
+    gsl::span<const TermKeyMap> mapping;
+    const TermKeyIndex& index;
+
+    template<size_t N>
+    TermKeyTable(const std::array<TermKeyMap, N>& mapping, const TermKeyIndex& index) noexcept :
+        mapping{ mapping.data(), mapping.size() },
+        index{ index }
+    {
+    }
+};
+
 const wchar_t* const CTRL_SLASH_SEQUENCE = L"\x1f";
 const wchar_t* const CTRL_QUESTIONMARK_SEQUENCE = L"\x7F";
 const wchar_t* const CTRL_ALT_SLASH_SEQUENCE = L"\x1b\x1f";
@@ -274,10 +327,10 @@ void TerminalInput::ForceDisableWin32InputMode(const bool win32InputMode) noexce
     _forceDisableWin32InputMode = win32InputMode;
 }
 
-static const gsl::span<const TermKeyMap> _getKeyMapping(const KeyEvent& keyEvent,
-                                                        const bool ansiMode,
-                                                        const bool cursorApplicationMode,
-                                                        const bool keypadApplicationMode) noexcept
+static TermKeyTable _getKeyMapping(const KeyEvent& keyEvent,
+                                   const bool ansiMode,
+                                   const bool cursorApplicationMode,
+                                   const bool keypadApplicationMode) noexcept
 {
     if (ansiMode)
     {
@@ -285,22 +338,22 @@ static const gsl::span<const TermKeyMap> _getKeyMapping(const KeyEvent& keyEvent
         {
             if (cursorApplicationMode)
             {
-                return { s_cursorKeysApplicationMapping.data(), s_cursorKeysApplicationMapping.size() };
+                return { s_cursorKeysApplicationMapping, s_cursorKeysApplicationIndex };
             }
             else
             {
-                return { s_cursorKeysNormalMapping.data(), s_cursorKeysNormalMapping.size() };
+                return { s_cursorKeysNormalMapping, s_cursorKeysNormalIndex };
             }
         }
         else
         {
             if (keypadApplicationMode)
             {
-                return { s_keypadApplicationMapping.data(), s_keypadApplicationMapping.size() };
+                return { s_keypadApplicationMapping, s_keypadApplicationIndex };
             }
             else
             {
-                return { s_keypadNumericMapping.data(), s_keypadNumericMapping.size() };
+                return { s_keypadNumericMapping, s_keypadNumericIndex };
             }
         }
     }
@@ -308,11 +361,11 @@ static const gsl::span<const TermKeyMap> _getKeyMapping(const KeyEvent& keyEvent
     {
         if (keyEvent.IsCursorKey())
         {
-            return { s_cursorKeysVt52Mapping.data(), s_cursorKeysVt52Mapping.size() };
+            return { s_cursorKeysVt52Mapping, s_cursorKeysVt52Index };
         }
         else
         {
-            return { s_keypadVt52Mapping.data(), s_keypadVt52Mapping.size() };
+            return { s_keypadVt52Mapping, s_keypadVt52Index };
         }
     }
 }
@@ -321,37 +374,52 @@ static const gsl::span<const TermKeyMap> _getKeyMapping(const KeyEvent& keyEvent
 // - Searches the keyMapping for a entry corresponding to this key event, and returns it.
 // Arguments:
 // - keyEvent - Key event to translate
-// - keyMapping - Array of key mappings to search
+// - keyMapping - Table of key mappings to search
 // Return Value:
 // - Has value if there was a match to a key translation.
 static std::optional<const TermKeyMap> _searchKeyMapping(const KeyEvent& keyEvent,
-                                                         gsl::span<const TermKeyMap> keyMapping) noexcept
+                                                         const TermKeyTable& keyMapping) noexcept
 {
-    for (auto& map : keyMapping)
+    const auto vkey = keyEvent.GetVirtualKeyCode();
+    if (vkey >= keyMapping.index.size())
     {
-        if (map.vkey == keyEvent.GetVirtualKeyCode())
+        return std::nullopt;
+    }
+
+    const auto first = til::at(keyMapping.index, vkey);
+    if (first == UINT8_MAX)
+    {
+        return std::nullopt;
+    }
+
+    for (auto& map : keyMapping.mapping.subspan(first))
+    {
+        // The entries for a key are next to each other, see _makeKeyIndex.
+        if (map.vkey != vkey)
         {
-            // If the mapping has no modifiers set, then it doesn't really care
-            //      what the modifiers are on the key. The caller will likely do
-            //      something with them.
-            // However, if there are modifiers set, then we only want to match
-            //      if the key's modifiers are the same as the modifiers in the
-            //      mapping.
-            bool modifiersMatch = WI_AreAllFlagsClear(map.modifiers, MOD_PRESSED);
-            if (!modifiersMatch)
-            {
-                // The modifier mapping expects certain modifier keys to be
-                //      pressed. Check those as well.
-                modifiersMatch =
-                    (WI_IsFlagSet(map.modifiers, SHIFT_PRESSED) == keyEvent.IsShiftPressed()) &&
-                    (WI_IsAnyFlagSet(map.modifiers, ALT_PRESSED) == keyEvent.IsAltPressed()) &&
-                    (WI_IsAnyFlagSet(map.modifiers, CTRL_PRESSED) == keyEvent.IsCtrlPressed());
-            }
+            break;
+        }
 
-            if (modifiersMatch)
-            {
-                return map;
-            }
+        // If the mapping has no modifiers set, then it doesn't really care
+        //      what the modifiers are on the key. The caller will likely do
+        //      something with them.
+        // However, if there are modifiers set, then we only want to match
+        //      if the key's modifiers are the same as the modifiers in the
+        //      mapping.
+        bool modifiersMatch = WI_AreAllFlagsClear(map.modifiers, MOD_PRESSED);
+        if (!modifiersMatch)
+        {
+            // The modifier mapping expects certain modifier keys to be
+            //      pressed. Check those as well.
+            modifiersMatch =
+                (WI_IsFlagSet(map.modifiers, SHIFT_PRESSED) == keyEvent.IsShiftPressed()) &&
+                (WI_IsAnyFlagSet(map.modifiers, ALT_PRESSED) == keyEvent.IsAltPressed()) &&
+                (WI_IsAnyFlagSet(map.modifiers, CTRL_PRESSED) == keyEvent.IsCtrlPressed());
+        }
+
+        if (modifiersMatch)
+        {
+            return map;
         }
     }
     return std::nullopt;
@@ -372,19 +440,21 @@ static bool _searchWithModifier(const KeyEvent& keyEvent, InputSender sender)
 {
     bool success = false;
 
-    const auto match = _searchKeyMapping(keyEvent,
-                                         { s_modifierKeyMapping.data(), s_modifierKeyMapping.size() });
+    const auto match = _searchKeyMapping(keyEvent, { s_modifierKeyMapping, s_modifierKeyIndex });
     if (match)
     {
         const auto& v = match.value();
         if (!v.sequence.empty())
         {
-            std::wstring modified{ v.sequence }; // Make a copy so we can modify it.
+            // Make a copy so we can modify it. None of the sequences is longer than "\x1b[24;m~".
+            std::array<wchar_t, 8> modified;
+            FAIL_FAST_IF(v.sequence.size() > modified.size());
+            std::copy(v.sequence.begin(), v.sequence.end(), modified.begin());
             const bool shift = keyEvent.IsShiftPressed();
             const bool alt = keyEvent.IsAltPressed();
             const bool ctrl = keyEvent.IsCtrlPressed();
-            modified.at(modified.size() - 2) = L'1' + (shift ? 1 : 0) + (alt ? 2 : 0) + (ctrl ? 4 : 0);
-            sender(modified);
+            til::at(modified, v.sequence.size() - 2) = L'1' + (shift ? 1 : 0) + (alt ? 2 : 0) + (ctrl ? 4 : 0);
+            sender({ modified.data(), v.sequence.size() });
             success = true;
         }
     }
@@ -393,8 +463,7 @@ static bool _searchWithModifier(const KeyEvent& keyEvent, InputSender sender)
         // We didn't find the key in the map of modified keys that need editing,
         //      maybe it's in the other map of modified keys with sequences that
         //      don't need editing before sending.
-        const auto match2 = _searchKeyMapping(keyEvent,
-                                              { s_simpleModifiedKeyMapping.data(), s_simpleModifiedKeyMapping.size() });
+        const auto match2 = _searchKeyMapping(keyEvent, { s_simpleModifiedKeyMapping, s_simpleModifiedKeyIndex });
         if (match2)
         {
             // This mapping doesn't need to be changed at all.
@@ -483,12 +552,12 @@ static bool _searchWithModifier(const KeyEvent& keyEvent, InputSender sender)
 // - Searches the input array of mappings, and sends it to the input if a match was found.
 // Arguments:
 // - keyEvent - Key event to translate
-// - keyMapping - Array of key mappings to search
+// - keyMapping - Table of key mappings to search
 // - sender - Function to use to dispatch translated event
 // Return Value:
 // - True if there was a match to a key translation, and we successfully sent it to the input
 static bool _translateDefaultMapping(const KeyEvent& keyEvent,
-                                     const gsl::span<const TermKeyMap> keyMapping,
+                                     const TermKeyTable& keyMapping,
                                      InputSender sender)
 {
     const auto match = _searchKeyMapping(keyEvent, keyMapping);
@@ -532,8 +601,9 @@ bool TerminalInput::HandleKey(const IInputEvent* const pInEvent)
     // Only do this if win32-input-mode support isn't manually disabled.
     if (_win32InputMode && !_forceDisableWin32InputMode)
     {
-        const auto seq = _GenerateWin32KeySequence(keyEvent);
-        _SendInputSequence(seq);
+        fmt::basic_memory_buffer<wchar_t, 64> seq;
+        _GenerateWin32KeySequence(keyEvent, seq);
+        _SendInputSequence({ seq.data(), seq.size() });
         return true;
     }
 
@@ -767,9 +837,11 @@ void TerminalInput::_SendInputSequence(const std::wstring_view sequence) const n
 // - Synthesize a win32-input-mode sequence for the given keyevent.
 // Arguments:
 // - key: the KeyEvent to serialize.
+// - out: receives the formatted string representation of this key. It's
+//   formatted into the caller's buffer, since this runs for every keystroke.
 // Return Value:
-// - the formatted string representation of this key
-std::wstring TerminalInput::_GenerateWin32KeySequence(const KeyEvent& key)
+// - <none>
+void TerminalInput::_GenerateWin32KeySequence(const KeyEvent& key, fmt::basic_memory_buffer<wchar_t, 64>& out)
 {
     // Sequences are formatted as follows:
     //
@@ -782,11 +854,12 @@ std::wstring TerminalInput::_GenerateWin32KeySequence(const KeyEvent& key)
     //      Kd: the value of bKeyDown - either a '0' or '1'. If omitted, defaults to '0'.
     //      Cs: the value of dwControlKeyState - any number. If omitted, defaults to '0'.
     //      Rc: the value of wRepeatCount - any number. If omitted, defaults to '1'.
-    return fmt::format(FMT_COMPILE(L"\x1b[{};{};{};{};{};{}_"),
-                       key.GetVirtualKeyCode(),
-                       key.GetVirtualScanCode(),
-                       static_cast<int>(key.GetCharData()),
-                       key.IsKeyDown() ? 1 : 0,
-                       key.GetActiveModifierKeys(),
-                       key.GetRepeatCount());
+    fmt::format_to(std::back_inserter(out),
+                   FMT_COMPILE(L"\x1b[{};{};{};{};{};{}_"),
+                   key.GetVirtualKeyCode(),
+                   key.GetVirtualScanCode(),
+                   static_cast<int>(key.GetCharData()),
+                   key.IsKeyDown() ? 1 : 0,
+                   key.GetActiveModifierKeys(),
+                   key.GetRepeatCount());
 }
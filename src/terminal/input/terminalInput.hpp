@@ -56,6 +56,7 @@ namespace Microsoft::Console::VirtualTerminal
                          const short modifierKeyState,
                          const short delta,
                          const MouseButtonState state);
+        bool FlushMouseMotion();
 
         bool IsTrackingMouseInput() const noexcept;
 #pragma endregion
@@ -70,6 +71,7 @@ namespace Microsoft::Console::VirtualTerminal
         void EnableAnyEventTracking(const bool enable) noexcept;
 
         void EnableAlternateScroll(const bool enable) noexcept;
+        void EnableMouseMotionCoalescing(const bool enable) noexcept;
         void UseAlternateScreenBuffer() noexcept;
         void UseMainScreenBuffer() noexcept;
 #pragma endregion
@@ -90,7 +92,7 @@ namespace Microsoft::Console::VirtualTerminal
         void _SendNullInputSequence(const DWORD dwControlKeyState) const;
         void _SendInputSequence(const std::wstring_view sequence) const noexcept;
         void _SendEscapedInputSequence(const wchar_t wch) const;
-        static std::wstring _GenerateWin32KeySequence(const KeyEvent& key);
+        static void _GenerateWin32KeySequence(const KeyEvent& key, fmt::basic_memory_buffer<wchar_t, 64>& out);
 
 #pragma region MouseInputState Management
         // These methods are defined in mouseInputState.cpp
@@ -116,31 +118,40 @@ namespace Microsoft::Console::VirtualTerminal
             TrackingMode trackingMode{ TrackingMode::None };
             bool alternateScroll{ false };
             bool inAlternateBuffer{ false };
+            bool coalesceMotion{ false };
             COORD lastPos{ -1, -1 };
             unsigned int lastButton{ 0 };
             int accumulatedDelta{ 0 };
+            // The latest motion report that wasn't sent yet, if coalesceMotion is set.
+            std::wstring pendingMotion;
         };
 
         MouseInputState _mouseInputState;
 #pragma endregion
 
 #pragma region MouseInput
-        static std::wstring _GenerateDefaultSequence(const COORD position,
-                                                     const unsigned int button,
-                                                     const bool isHover,
-                                                     const short modifierKeyState,
-                                                     const short delta);
-        static std::wstring _GenerateUtf8Sequence(const COORD position,
-                                                  const unsigned int button,
-                                                  const bool isHover,
-                                                  const short modifierKeyState,
-                                                  const short delta);
-        static std::wstring _GenerateSGRSequence(const COORD position,
-                                                 const unsigned int button,
-                                                 const bool isDown,
-                                                 const bool isHover,
-                                                 const short modifierKeyState,
-                                                 const short delta);
+        // Large enough for any mouse report, so encoding one doesn't allocate.
+        using MouseSequence = fmt::basic_memory_buffer<wchar_t, 32>;
+
+        static void _GenerateDefaultSequence(const COORD position,
+                                             const unsigned int button,
+                                             const bool isHover,
+                                             const short modifierKeyState,
+                                             const short delta,
+                                             MouseSequence& sequence);
+        static void _GenerateUtf8Sequence(const COORD position,
+                                          const unsigned int button,
+                                          const bool isHover,
+                                          const short modifierKeyState,
+                                          const short delta,
+                                          MouseSequence& sequence);
+        static void _GenerateSGRSequence(const COORD position,
+                                         const unsigned int button,
+                                         const bool isDown,
+                                         const bool isHover,
+                                         const short modifierKeyState,
+                                         const short delta,
+                                         MouseSequence& sequence);
 
         bool _ShouldSendAlternateScroll(const unsigned int button, const short delta) const noexcept;
         bool _SendAlternateScroll(const short delta) const noexcept;
@@ -52,6 +52,7 @@ namespace Microsoft::Console::VirtualTerminal
 
         virtual bool ParseControlSequenceAfterSs3() const = 0;
         virtual bool FlushAtEndOfString() const = 0;
+        virtual bool CanFlushToTerminal() const = 0;
         virtual bool DispatchControlCharsFromEscape() const = 0;
         virtual bool DispatchIntermediatesFromEscape() const = 0;
 
@@ -695,9 +695,9 @@ void InputStateMachineEngine::_GetSingleKeypress(const wchar_t wch,
 bool InputStateMachineEngine::_WriteSingleKey(const wchar_t wch, const short vkey, const DWORD modifierState)
 {
     // At most 8 records - 2 for each of shift,ctrl,alt up and down, and 2 for the actual key up and down.
-    std::vector<INPUT_RECORD> input;
-    _GenerateWrappedSequence(wch, vkey, modifierState, input);
-    std::deque<std::unique_ptr<IInputEvent>> inputEvents = IInputEvent::Create(gsl::make_span(input));
+    _keyRecords.clear();
+    _GenerateWrappedSequence(wch, vkey, modifierState, _keyRecords);
+    std::deque<std::unique_ptr<IInputEvent>> inputEvents = IInputEvent::Create(gsl::make_span(_keyRecords));
 
     return _pDispatch->WriteInput(inputEvents);
 }
@@ -1086,6 +1086,16 @@ bool InputStateMachineEngine::FlushAtEndOfString() const noexcept
     return true;
 }
 
+// Method Description:
+// - Returns true if the engine may ask the state machine to pass the current
+//      sequence through to the input queue (with FlushToTerminal).
+// Return Value:
+// - True iff a callback has been set up to flush to.
+bool InputStateMachineEngine::CanFlushToTerminal() const noexcept
+{
+    return _pfnFlushToInputQueue != nullptr;
+}
+
 // Routine Description:
 // - Returns true if the engine should dispatch control characters in the Escape
 //      state. Typically, control characters are immediately executed in the
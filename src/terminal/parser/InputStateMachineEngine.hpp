@@ -160,6 +160,7 @@ namespace Microsoft::Console::VirtualTerminal
 
         bool ParseControlSequenceAfterSs3() const noexcept override;
         bool FlushAtEndOfString() const noexcept override;
+        bool CanFlushToTerminal() const noexcept override;
         bool DispatchControlCharsFromEscape() const noexcept override;
         bool DispatchIntermediatesFromEscape() const noexcept override;
 
@@ -175,6 +176,10 @@ namespace Microsoft::Console::VirtualTerminal
         std::optional<std::chrono::steady_clock::time_point> _lastMouseClickTime{};
         std::optional<size_t> _lastMouseClickButton{};
 
+        // Scratch space for the records of a single keypress, reused so
+        // that writing a key doesn't allocate a new buffer every time.
+        std::vector<INPUT_RECORD> _keyRecords;
+
         DWORD _GetCursorKeysModifierState(const VTParameters parameters, const VTID id) noexcept;
         DWORD _GetGenericKeysModifierState(const VTParameters parameters) noexcept;
         DWORD _GetSGRMouseModifierState(const size_t modifierParam) noexcept;
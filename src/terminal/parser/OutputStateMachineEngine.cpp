@@ -825,6 +825,11 @@ bool OutputStateMachineEngine::ActionOscDispatch(const wchar_t /*wch*/,
         success = _dispatch->DoConEmuAction(string);
         break;
     }
+    case OscActionCodes::FinalTermAction:
+    {
+        success = _dispatch->DoFinalTermAction(string);
+        break;
+    }
     default:
         // If no functions to call, overall dispatch was a failure.
         success = false;
@@ -898,6 +903,18 @@ bool OutputStateMachineEngine::FlushAtEndOfString() const noexcept
     return false;
 }
 
+// Routine Description:
+// - Returns true if the engine may ask the state machine to pass the current
+//      sequence through to the terminal (with FlushToTerminal). Only then
+//      does the state machine need to keep a copy of sequences that are
+//      split across calls to ProcessString.
+// Return Value:
+// - True iff a terminal connection has been set up to flush to.
+bool OutputStateMachineEngine::CanFlushToTerminal() const noexcept
+{
+    return _pfnFlushToTerminal != nullptr;
+}
+
 // Routine Description:
 // - Returns true if the engine should dispatch control characters in the Escape
 //      state. Typically, control characters are immediately executed in the
@@ -53,6 +53,7 @@ namespace Microsoft::Console::VirtualTerminal
 
         bool ParseControlSequenceAfterSs3() const noexcept override;
         bool FlushAtEndOfString() const noexcept override;
+        bool CanFlushToTerminal() const noexcept override;
         bool DispatchControlCharsFromEscape() const noexcept override;
         bool DispatchIntermediatesFromEscape() const noexcept override;
 
@@ -181,6 +182,7 @@ namespace Microsoft::Console::VirtualTerminal
             SetBackgroundColor = 11,
             SetCursorColor = 12,
             SetClipboard = 52,
+            FinalTermAction = 133,
             ResetForegroundColor = 110, // Not implemented
             ResetBackgroundColor = 111, // Not implemented
             ResetCursorColor = 112
@@ -6,8 +6,23 @@
 
 using namespace Microsoft::Console::VirtualTerminal;
 
-static const char base64Chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-static const char padChar = '=';
+static constexpr char base64Chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+static constexpr char padChar = '=';
+static constexpr uint8_t invalidValue = 0xff;
+
+// Maps each ASCII character to its value in base64Chars, or to invalidValue if it isn't part of it.
+static constexpr auto base64Values = []() {
+    std::array<uint8_t, 128> values{};
+    for (auto& value : values)
+    {
+        value = invalidValue;
+    }
+    for (uint8_t i = 0; i < 64; ++i)
+    {
+        values[base64Chars[i]] = i;
+    }
+    return values;
+}();
 
 #pragma warning(disable : 26446 26447 26482 26485 26493 26494)
 
@@ -77,7 +92,7 @@ bool Base64::s_Decode(const std::wstring_view src, std::wstring& dst) noexcept
 {
     std::string mbStr;
     int state = 0;
-    char tmp;
+    char tmp = 0;
 
     const auto len = src.size() / 4 * 3;
     if (len == 0)
@@ -89,6 +104,33 @@ bool Base64::s_Decode(const std::wstring_view src, std::wstring& dst) noexcept
     auto iter = src.cbegin();
     while (iter < src.cend())
     {
+        // Fast path: Decode whole quanta at once for as long as they consist of base64 characters only.
+        // Whitespace, padding and invalid characters are left for the character by character decoding below.
+        if (state == 0)
+        {
+            while (src.cend() - iter >= 4)
+            {
+                const auto a = s_DecodeValue(iter[0]);
+                const auto b = s_DecodeValue(iter[1]);
+                const auto c = s_DecodeValue(iter[2]);
+                const auto d = s_DecodeValue(iter[3]);
+                if ((a | b | c | d) == invalidValue)
+                {
+                    break;
+                }
+
+                mbStr += static_cast<char>(a << 2 | b >> 4);
+                mbStr += static_cast<char>((b & 0x0f) << 4 | c >> 2);
+                mbStr += static_cast<char>((c & 0x03) << 6 | d);
+                iter += 4;
+            }
+
+            if (iter == src.cend())
+            {
+                break;
+            }
+        }
+
         if (s_IsSpace(*iter)) // Skip whitespace anywhere.
         {
             iter++;
@@ -100,8 +142,8 @@ bool Base64::s_Decode(const std::wstring_view src, std::wstring& dst) noexcept
             break;
         }
 
-        auto pos = strchr(base64Chars, *iter);
-        if (!pos) // A non-base64 character found.
+        const auto value = s_DecodeValue(*iter);
+        if (value == invalidValue) // A non-base64 character found.
         {
             return false;
         }
@@ -109,23 +151,23 @@ bool Base64::s_Decode(const std::wstring_view src, std::wstring& dst) noexcept
         switch (state)
         {
         case 0:
-            tmp = (char)(pos - base64Chars) << 2;
+            tmp = (char)value << 2;
             state = 1;
             break;
         case 1:
-            tmp |= (char)(pos - base64Chars) >> 4;
+            tmp |= (char)value >> 4;
             mbStr += tmp;
-            tmp = (char)((pos - base64Chars) & 0x0f) << 4;
+            tmp = (char)(value & 0x0f) << 4;
             state = 2;
             break;
         case 2:
-            tmp |= (char)(pos - base64Chars) >> 2;
+            tmp |= (char)value >> 2;
             mbStr += tmp;
-            tmp = (char)((pos - base64Chars) & 0x03) << 6;
+            tmp = (char)(value & 0x03) << 6;
             state = 3;
             break;
         case 3:
-            tmp |= pos - base64Chars;
+            tmp |= value;
             mbStr += tmp;
             state = 0;
             break;
@@ -191,3 +233,14 @@ constexpr bool Base64::s_IsSpace(const wchar_t ch) noexcept
 {
     return ch == L'\r' || ch == L'\n';
 }
+
+// Routine Description:
+// - Look up the 6-bit value of a base64 character.
+// Arguments:
+// - ch - Character to look up.
+// Return Value:
+// - The value of ch, or 0xff if ch isn't a base64 character.
+constexpr uint8_t Base64::s_DecodeValue(const wchar_t ch) noexcept
+{
+    return ch < base64Values.size() ? base64Values[ch] : invalidValue;
+}
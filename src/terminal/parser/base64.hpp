@@ -21,5 +21,6 @@ namespace Microsoft::Console::VirtualTerminal
 
     private:
         static constexpr bool s_IsSpace(const wchar_t ch) noexcept;
+        static constexpr uint8_t s_DecodeValue(const wchar_t ch) noexcept;
     };
 }
@@ -18,7 +18,9 @@ StateMachine::StateMachine(std::unique_ptr<IStateMachineEngine> engine) :
     _parameters{},
     _parameterLimitReached(false),
     _oscString{},
+    _oscStringView{},
     _cachedSequence{ std::nullopt },
+    _utf8State{},
     _processingIndividually(false)
 {
     _ActionClear();
@@ -374,6 +376,67 @@ static constexpr bool _isActionableFromGround(const wchar_t wch) noexcept
 
 #pragma warning(pop)
 
+// Routine Description:
+// - Finds the next character in the given string, starting at the given offset,
+//   for which _isActionableFromGround() returns true. Everything in between
+//   is printable text that can be passed to ActionPrintString() as one run.
+// Arguments:
+// - string - The string to scan.
+// - offset - The index at which to start scanning.
+// Return Value:
+// - The index of the next actionable character, or string.size() if there is none.
+static size_t _findActionableFromGround(const std::wstring_view string, size_t offset) noexcept
+{
+    static_assert(sizeof(wchar_t) == 2, "The vectorized code assumes UTF-16 code units.");
+
+#pragma warning(push)
+#pragma warning(disable : 26481) // Don't use pointer arithmetic. Use span instead (bounds.1).
+#pragma warning(disable : 26490) // Don't use reinterpret_cast (type.1).
+#if defined(_M_AMD64) || defined(_M_IX86)
+    // Build logs and most other output consist of long runs of printable text
+    // that are only occasionally interrupted by a control character or an
+    // escape sequence. Instead of testing one character at a time, we test 8 at once.
+    //
+    // There are no unsigned 16-bit comparisons in SSE2, but saturating subtraction
+    // gives us the same result: subs_epu16(x, n) is 0 if and only if x <= n.
+    // 1. x <= US (0x1F) catches all C0 control characters, including ESC.
+    // 2. (x - DEL) <= 0x20 (with wrap-around) catches DEL (0x7F) and the C1 range (0x80-0x9F).
+    // 3. Merge both results and extract one bit per byte with _mm_movemask_epi8.
+    //    --> the index returned by _BitScanForward must be divided by 2.
+    const auto data = string.data();
+    const auto size = string.size();
+    const auto zero = _mm_setzero_si128();
+    const auto c0Max = _mm_set1_epi16(AsciiChars::US);
+    const auto del = _mm_set1_epi16(AsciiChars::DEL);
+    const auto delToC1Max = _mm_set1_epi16(L'\x9F' - AsciiChars::DEL);
+
+    for (; offset + 8 <= size; offset += 8)
+    {
+        const auto chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset));
+        const auto isC0 = _mm_cmpeq_epi16(_mm_subs_epu16(chars, c0Max), zero); // 1.
+        const auto isDelOrC1 = _mm_cmpeq_epi16(_mm_subs_epu16(_mm_sub_epi16(chars, del), delToC1Max), zero); // 2.
+        const auto mask = _mm_movemask_epi8(_mm_or_si128(isC0, isDelOrC1)); // 3.
+        unsigned long index;
+        if (_BitScanForward(&index, mask))
+        {
+            return offset + index / 2;
+        }
+    }
+#endif
+#pragma warning(pop)
+
+    // Scalar fallback for the remaining (up to 7) characters,
+    // or for the whole string on platforms without SSE2.
+    for (; offset < string.size(); ++offset)
+    {
+        if (_isActionableFromGround(til::at(string, offset)))
+        {
+            break;
+        }
+    }
+    return offset;
+}
+
 // Routine Description:
 // - Triggers the Execute action to indicate that the listener should immediately respond to a C0 control character.
 // Arguments:
@@ -574,6 +637,7 @@ void StateMachine::_ActionClear()
     _parameterLimitReached = false;
 
     _oscString.clear();
+    _oscStringView = {};
     _oscParameter = 0;
 
     _dcsStringHandler = nullptr;
@@ -634,9 +698,50 @@ void StateMachine::_ActionOscPut(const wchar_t wch)
 {
     _trace.TraceOnAction(L"OscPut");
 
+    _MaterializeOscString();
     _oscString.push_back(wch);
 }
 
+// Routine Description:
+// - Stores a run of characters as part of the OSC string. If the string is still
+//   empty, the run isn't copied, but referenced right where it is in the current input.
+//   The reference is only valid until the end of the current ProcessString call.
+// Arguments:
+// - string - Characters to store. Must point into _currentString.
+// Return Value:
+// - <none>
+void StateMachine::_ActionOscPut(const std::wstring_view string)
+{
+    _trace.TraceOnAction(L"OscPut");
+
+    if (_oscString.empty() && _oscStringView.empty())
+    {
+        _oscStringView = string;
+    }
+    else
+    {
+        _MaterializeOscString();
+        _oscString.append(string);
+    }
+}
+
+// Routine Description:
+// - Copies an OSC string that is only referenced by _oscStringView into _oscString.
+//   This needs to happen before more characters are appended to it and before
+//   the input that _oscStringView points into goes away.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void StateMachine::_MaterializeOscString()
+{
+    if (!_oscStringView.empty())
+    {
+        _oscString.assign(_oscStringView);
+        _oscStringView = {};
+    }
+}
+
 // Routine Description:
 // - Triggers the CsiDispatch action to indicate that the listener should handle a control sequence.
 //   These sequences perform various API-type commands that can include many parameters.
@@ -648,7 +753,8 @@ void StateMachine::_ActionOscDispatch(const wchar_t wch)
 {
     _trace.TraceOnAction(L"OscDispatch");
 
-    const bool success = _engine->ActionOscDispatch(wch, _oscParameter, _oscString);
+    const auto string = _oscStringView.empty() ? std::wstring_view{ _oscString } : _oscStringView;
+    const bool success = _engine->ActionOscDispatch(wch, _oscParameter, string);
 
     // Trace the result.
     _trace.DispatchSequenceTrace(success);
@@ -1824,6 +1930,65 @@ bool StateMachine::FlushToTerminal()
     return success;
 }
 
+// Routine Description:
+// - Fast path for the CsiParam state. Stores every parameter character (digits and
+//   delimiters) starting at the given offset, which is exactly what _EventCsiParam
+//   would do for each of them, but without the per-character event dispatch.
+// Arguments:
+// - string - Characters to operate upon
+// - offset - Index of the first character to look at
+// Return Value:
+// - The index of the first character that isn't a parameter character,
+//   or the size of the string if all remaining characters were consumed.
+size_t StateMachine::_ProcessCsiParameters(const std::wstring_view string, size_t offset)
+{
+    for (; offset < string.size(); ++offset)
+    {
+        const auto wch = til::at(string, offset);
+        if (!_isNumericParamValue(wch) && !_isParameterDelimiter(wch))
+        {
+            break;
+        }
+
+        _trace.TraceCharInput(wch);
+        _ActionParam(wch);
+    }
+    return offset;
+}
+
+// Routine Description:
+// - Fast path for the OscString state. Stores every character starting at the given
+//   offset that _EventOscString would put into the OSC string as a single run.
+//   Anything that could end the string or has special meaning in any state
+//   (terminators, ESC, C1 controls, CAN and SUB) is left for ProcessCharacter.
+// Arguments:
+// - string - Characters to operate upon
+// - offset - Index of the first character to look at
+// Return Value:
+// - The index of the first character that wasn't stored,
+//   or the size of the string if all remaining characters were consumed.
+size_t StateMachine::_ProcessOscString(const std::wstring_view string, size_t offset)
+{
+    const auto begin = offset;
+    for (; offset < string.size(); ++offset)
+    {
+        const auto wch = til::at(string, offset);
+        if (_isOscTerminator(wch) || _isEscape(wch) || _isOscInvalid(wch) || _isC1ControlCharacter(wch) ||
+            wch == AsciiChars::CAN || wch == AsciiChars::SUB)
+        {
+            break;
+        }
+
+        _trace.TraceCharInput(wch);
+    }
+
+    if (offset != begin)
+    {
+        _ActionOscPut(string.substr(begin, offset - begin));
+    }
+    return offset;
+}
+
 // Routine Description:
 // - Helper for entry to the state machine. Will take an array of characters
 //     and print as many as it can without encountering a character indicating
@@ -1852,6 +2017,28 @@ void StateMachine::ProcessString(const std::wstring_view string)
 
         if (_processingIndividually)
         {
+            // Parameters make up most of a typical control sequence (think SGR colors),
+            // so runs of them are stored without going through the state dispatch one by one.
+            if (_state == VTStates::CsiParam)
+            {
+                current = _ProcessCsiParameters(string, current);
+                if (current >= string.size())
+                {
+                    break;
+                }
+                _runSize = current - start + 1;
+            }
+            // The same goes for the payload of OSC strings, which can be huge (e.g. OSC 52).
+            else if (_state == VTStates::OscString)
+            {
+                current = _ProcessOscString(string, current);
+                if (current >= string.size())
+                {
+                    break;
+                }
+                _runSize = current - start + 1;
+            }
+
             // If we're processing characters individually, send it to the state machine.
             ProcessCharacter(til::at(string, current));
             ++current;
@@ -1863,14 +2050,16 @@ void StateMachine::ProcessString(const std::wstring_view string)
         }
         else
         {
-            if (_isActionableFromGround(til::at(string, current))) // If the current char is the start of an escape sequence, or should be executed in ground state...
+            // Add all printable chars to the current run in one go. If we stopped before the end
+            // of the string, the current char is the start of an escape sequence, or should be executed in ground state...
+            current = _findActionableFromGround(string, current);
+            if (current < string.size())
             {
+                // The run above was composed INCLUDING the char we started scanning from,
+                // so we must recompute it here to only pass through everything before the actionable one.
+                _runSize = current - start;
                 if (_runSize > 0)
                 {
-                    // Because the run above is composed INCLUDING current, we must
-                    // trim it off here since we just determined it's actionable
-                    // and only pass through everything before it.
-                    _runSize -= 1;
                     const auto allLeadingUpTo = _CurrentRun();
 
                     _engine->ActionPrintString(allLeadingUpTo); // ... print all the chars leading up to it as part of the run...
@@ -1879,11 +2068,6 @@ void StateMachine::ProcessString(const std::wstring_view string)
 
                 _processingIndividually = true; // begin processing future characters individually...
                 start = current;
-                continue;
-            }
-            else
-            {
-                ++current; // Otherwise, add this char to the current run to be printed.
             }
         }
     }
@@ -1971,11 +2155,12 @@ void StateMachine::ProcessString(const std::wstring_view string)
             // after dispatching the characters
             _EnterGround();
         }
-        else
+        else if (_engine->CanFlushToTerminal())
         {
             // If the engine doesn't require flushing at the end of the string, we
             // want to cache the partial sequence in case we have to flush the whole
-            // thing to the terminal later.
+            // thing to the terminal later. The parser state itself persists across
+            // calls, so engines that never flush don't need this copy at all.
             if (!_cachedSequence)
             {
                 _cachedSequence.emplace(std::wstring{});
@@ -1985,6 +2170,78 @@ void StateMachine::ProcessString(const std::wstring_view string)
             cachedSequence.append(run);
         }
     }
+
+    // An unfinished OSC string may still reference the given string, which
+    // is about to go away. It has to be copied so the next call can continue it.
+    _MaterializeOscString();
+}
+
+// Routine Description:
+// - Helper for processing UTF-8 encoded input, for instance as read from a pipe.
+//   Partial code points at the end of the string are cached and completed
+//   by the next call. The converted string is then given to the UTF-16 variant
+//   of ProcessString in a single call, which matters for engines that
+//   rely on FlushAtEndOfString (like the InputStateMachineEngine).
+// - The vast majority of VT traffic is ASCII, including all escape sequences.
+//   Any leading ASCII is widened directly without going through
+//   MultiByteToWideChar and only the remainder is transcoded with til::u8u16.
+// Arguments:
+// - string - UTF-8 string to be processed
+// Return Value:
+// - <none>
+void StateMachine::ProcessString(const std::string_view string)
+{
+    const auto size = string.size();
+    size_t ascii = 0;
+
+    // If we have partials from a previous call, we need til::u8u16 to complete them.
+    if (!_utf8State.have)
+    {
+        _utf8Buffer.resize(size);
+
+#pragma warning(push)
+#pragma warning(disable : 26481) // Don't use pointer arithmetic. Use span instead (bounds.1).
+#pragma warning(disable : 26490) // Don't use reinterpret_cast (type.1).
+        const auto in = reinterpret_cast<const uint8_t*>(string.data());
+        const auto out = _utf8Buffer.data();
+#if defined(_M_AMD64) || defined(_M_IX86)
+        // 16 bytes at a time: stop as soon as any of them has its high bit set,
+        // otherwise zero-extend them into two blocks of 8 UTF-16 code units.
+        const auto zero = _mm_setzero_si128();
+        for (; ascii + 16 <= size; ascii += 16)
+        {
+            const auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + ascii));
+            if (_mm_movemask_epi8(bytes))
+            {
+                break;
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + ascii), _mm_unpacklo_epi8(bytes, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + ascii + 8), _mm_unpackhi_epi8(bytes, zero));
+        }
+#endif
+        for (; ascii < size && in[ascii] < 0x80; ++ascii)
+        {
+            out[ascii] = in[ascii];
+        }
+#pragma warning(pop)
+
+        _utf8Buffer.resize(ascii);
+    }
+    else
+    {
+        _utf8Buffer.clear();
+    }
+
+    if (ascii < size)
+    {
+        THROW_IF_FAILED(til::u8u16(string.substr(ascii), _utf8Remainder, _utf8State));
+        _utf8Buffer.append(_utf8Remainder);
+    }
+
+    if (!_utf8Buffer.empty())
+    {
+        ProcessString(_utf8Buffer);
+    }
 }
 
 // Routine Description:
@@ -46,6 +46,7 @@ namespace Microsoft::Console::VirtualTerminal
 
         void ProcessCharacter(const wchar_t wch);
         void ProcessString(const std::wstring_view string);
+        void ProcessString(const std::string_view string);
 
         void ResetState() noexcept;
 
@@ -65,6 +66,7 @@ namespace Microsoft::Console::VirtualTerminal
         void _ActionCsiDispatch(const wchar_t wch);
         void _ActionOscParam(const wchar_t wch) noexcept;
         void _ActionOscPut(const wchar_t wch);
+        void _ActionOscPut(const std::wstring_view string);
         void _ActionOscDispatch(const wchar_t wch);
         void _ActionSs3Dispatch(const wchar_t wch);
         void _ActionDcsDispatch(const wchar_t wch);
@@ -93,6 +95,10 @@ namespace Microsoft::Console::VirtualTerminal
         void _EnterDcsPassThrough() noexcept;
         void _EnterSosPmApcString() noexcept;
 
+        size_t _ProcessCsiParameters(const std::wstring_view string, size_t offset);
+        size_t _ProcessOscString(const std::wstring_view string, size_t offset);
+        void _MaterializeOscString();
+
         void _EventGround(const wchar_t wch);
         void _EventEscape(const wchar_t wch);
         void _EventEscapeIntermediate(const wchar_t wch);
@@ -164,12 +170,20 @@ namespace Microsoft::Console::VirtualTerminal
         bool _parameterLimitReached;
 
         std::wstring _oscString;
+        // The OSC string as long as it lies entirely within the current input. See _ActionOscPut.
+        std::wstring_view _oscStringView;
         size_t _oscParameter;
 
         IStateMachineEngine::StringHandler _dcsStringHandler;
 
         std::optional<std::wstring> _cachedSequence;
 
+        // State for the UTF-8 overload of ProcessString. The buffers are
+        // reused across calls so that we don't reallocate for every write.
+        til::u8state _utf8State;
+        std::wstring _utf8Buffer;
+        std::wstring _utf8Remainder;
+
         // This is tracked per state machine instance so that separate calls to Process*
         //   can start and finish a sequence.
         bool _processingIndividually;
@@ -85,6 +85,14 @@ class Microsoft::Console::VirtualTerminal::Base64Test
         success = Base64::s_Decode(L"Zm9vYg=", result);
         VERIFY_ARE_EQUAL(false, success);
 
+        // Characters outside of the base64 alphabet must be rejected, even if
+        // they only differ from a valid one in the upper byte or are NUL.
+        success = Base64::s_Decode(L"Zm9v\x0159mFy", result);
+        VERIFY_ARE_EQUAL(false, success);
+
+        success = Base64::s_Decode(std::wstring_view{ L"Zm9v\0mFy", 8 }, result);
+        VERIFY_ARE_EQUAL(false, success);
+
         // U+306b U+307b U+3093 U+3054 U+6c49 U+8bed U+d55c U+ad6d
         result = L"";
         success = Base64::s_Decode(L"44Gr44G744KT44GU5rGJ6K+t7ZWc6rWt", result);
@@ -38,6 +38,8 @@ public:
         dcsId = 0;
         dcsParams.clear();
         dcsDataString.clear();
+        oscParameter = 0;
+        oscString.clear();
     }
 
     bool ActionExecute(const wchar_t wch) override
@@ -69,14 +71,16 @@ public:
     bool ActionIgnore() override { return true; };
 
     bool ActionOscDispatch(const wchar_t /* wch */,
-                           const size_t /* parameter */,
-                           const std::wstring_view /* string */) override
+                           const size_t parameter,
+                           const std::wstring_view string) override
     {
         if (pfnFlushToTerminal)
         {
             pfnFlushToTerminal();
             return true;
         }
+        oscParameter = parameter;
+        oscString = string;
         return true;
     };
 
@@ -84,6 +88,7 @@ public:
 
     bool ParseControlSequenceAfterSs3() const override { return false; }
     bool FlushAtEndOfString() const override { return false; };
+    bool CanFlushToTerminal() const override { return pfnFlushToTerminal != nullptr; };
     bool DispatchControlCharsFromEscape() const override { return false; };
     bool DispatchIntermediatesFromEscape() const override { return false; };
 
@@ -138,6 +143,10 @@ public:
     uint64_t dcsId = 0;
     std::vector<size_t> dcsParams;
     std::wstring dcsDataString;
+
+    // These will only be populated if ActionOscDispatch is called.
+    size_t oscParameter = 0;
+    std::wstring oscString;
 };
 
 class Microsoft::Console::VirtualTerminal::StateMachineTest
@@ -159,7 +168,10 @@ class Microsoft::Console::VirtualTerminal::StateMachineTest
     TEST_METHOD(PassThroughUnhandled);
     TEST_METHOD(RunStorageBeforeEscape);
     TEST_METHOD(BulkTextPrint);
+    TEST_METHOD(BulkTextPrintStopsAtControlCharacters);
+    TEST_METHOD(Utf8TextPrint);
     TEST_METHOD(PassThroughUnhandledSplitAcrossWrites);
+    TEST_METHOD(OscStringSplitAcrossWrites);
 
     TEST_METHOD(DcsDataStringsReceivedByHandler);
 };
@@ -234,6 +246,104 @@ void StateMachineTest::BulkTextPrint()
     VERIFY_ARE_EQUAL(String(L"12345 Hello World"), String(engine.printed.c_str()));
 }
 
+void StateMachineTest::BulkTextPrintStopsAtControlCharacters()
+{
+    auto enginePtr{ std::make_unique<TestStateMachineEngine>() };
+    // this dance is required because StateMachine presumes to take ownership of its engine.
+    auto& engine{ *enginePtr.get() };
+    StateMachine machine{ std::move(enginePtr) };
+
+    // The printable run scanner works on blocks of 8 characters at a time.
+    // Place control characters at every offset within such a block, as well as in the
+    // remainder at the end of the string, to ensure none of them get printed.
+    const std::wstring_view printable{ L"Lorem ipsum dolor sit amet, consectetur" };
+    // (C1 IND is converted to ESC D and dispatched, so it needs no special handling either.)
+    for (const auto control : { L'\0', L'\a', L'\x1f', L'\x7f', L'\x84' })
+    {
+        for (size_t offset = 0; offset < printable.size(); ++offset)
+        {
+            std::wstring input{ printable };
+            input.insert(offset, 1, control);
+
+            engine.ResetTestState();
+            machine.ProcessString(input);
+
+            VERIFY_ARE_EQUAL(std::wstring{ printable }, engine.printed);
+            if (control != L'\x84')
+            {
+                VERIFY_ARE_EQUAL(std::wstring(1, control), engine.executed);
+            }
+            machine.ResetState();
+        }
+    }
+
+    // Characters just outside of the control ranges must be printed.
+    engine.ResetTestState();
+    machine.ProcessString(L" ~\xa0\x8000\xffff"
+                          L"0123456789");
+    VERIFY_ARE_EQUAL(std::wstring(L" ~\xa0\x8000\xffff"
+                                  L"0123456789"),
+                     engine.printed);
+    VERIFY_ARE_EQUAL(std::wstring(), engine.executed);
+}
+
+void StateMachineTest::Utf8TextPrint()
+{
+    auto enginePtr{ std::make_unique<TestStateMachineEngine>() };
+    // this dance is required because StateMachine presumes to take ownership of its engine.
+    auto& engine{ *enginePtr.get() };
+    StateMachine machine{ std::move(enginePtr) };
+
+    Log::Comment(L"Long ASCII runs take the widening fast path");
+    machine.ProcessString(std::string_view{ "0123456789abcdefghijklmnopqrstuvwxyz\x1b[12;34mABC" });
+    VERIFY_ARE_EQUAL(std::wstring(L"0123456789abcdefghijklmnopqrstuvwxyzABC"), engine.printed);
+    VERIFY_ARE_EQUAL(VTID("m"), engine.csiId);
+    VERIFY_ARE_EQUAL(std::vector<size_t>({ 12u, 34u }), engine.csiParams);
+
+    Log::Comment(L"Non-ASCII text following ASCII text is transcoded");
+    engine.ResetTestState();
+    machine.ProcessString(std::string_view{ "0123456789abcdef\xe2\x82\xac 123" });
+    VERIFY_ARE_EQUAL(std::wstring(L"0123456789abcdef\x20ac 123"), engine.printed);
+
+    Log::Comment(L"Code points split across two writes are completed by the second one");
+    engine.ResetTestState();
+    machine.ProcessString(std::string_view{ "0123456789abcdef\xf0\x9f" });
+    VERIFY_ARE_EQUAL(std::wstring(L"0123456789abcdef"), engine.printed);
+    machine.ProcessString(std::string_view{ "\x98\x80" "0123456789abcdef" });
+    VERIFY_ARE_EQUAL(std::wstring(L"0123456789abcdef\xD83D\xDE00"
+                                  L"0123456789abcdef"),
+                     engine.printed);
+}
+
+void StateMachineTest::OscStringSplitAcrossWrites()
+{
+    auto enginePtr{ std::make_unique<TestStateMachineEngine>() };
+    // this dance is required because StateMachine presumes to take ownership of its engine.
+    auto& engine{ *enginePtr.get() };
+    StateMachine machine{ std::move(enginePtr) };
+
+    Log::Comment(L"An OSC string within a single write");
+    machine.ProcessString(L"\x1b]2;title\x7fwith\x1fcontrols\x07");
+    VERIFY_ARE_EQUAL(2u, engine.oscParameter);
+    VERIFY_ARE_EQUAL(std::wstring(L"title\x7fwithcontrols"), engine.oscString);
+
+    Log::Comment(L"An OSC string split across writes");
+    engine.ResetTestState();
+    machine.ProcessString(L"\x1b]8;;https://");
+    machine.ProcessString(L"example.com");
+    VERIFY_ARE_EQUAL(std::wstring(), engine.oscString);
+    machine.ProcessString(L"/path\x1b\\");
+    VERIFY_ARE_EQUAL(8u, engine.oscParameter);
+    VERIFY_ARE_EQUAL(std::wstring(L";https://example.com/path"), engine.oscString);
+
+    Log::Comment(L"A C1 ST terminates the string");
+    engine.ResetTestState();
+    machine.ProcessString(L"\x1b]0;abc\x9cdef");
+    VERIFY_ARE_EQUAL(0u, engine.oscParameter);
+    VERIFY_ARE_EQUAL(std::wstring(L"abc"), engine.oscString);
+    VERIFY_ARE_EQUAL(std::wstring(L"def"), engine.printed);
+}
+
 void StateMachineTest::PassThroughUnhandledSplitAcrossWrites()
 {
     auto enginePtr{ std::make_unique<TestStateMachineEngine>() };
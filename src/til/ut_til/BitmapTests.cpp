@@ -625,6 +625,25 @@ class BitmapTests
         expectedSet.emplace_back(setZone);
         _checkBits(expectedSet, bitmap);
 
+        Log::Comment(L"Reset a rectangle of bits and test they went off.");
+        // |1 1|0 0       0 0 0 0
+        // |1 1|0 0  --\  1 1 0 0
+        // |1 1|0 0  --/  1 1 0 0
+        //  0 0 0 0       0 0 0 0
+        bitmap.reset(til::rectangle{ til::point{ 0, 0 }, til::size{ 2, 1 } });
+
+        expectedSet.clear();
+        expectedSet.emplace_back(til::rectangle{ til::point{ 0, 1 }, til::size{ 2, 2 } });
+        _checkBits(expectedSet, bitmap);
+
+        Log::Comment(L"Reset a single bit and test it went off.");
+        bitmap.reset(til::point{ 1, 2 });
+
+        expectedSet.clear();
+        expectedSet.emplace_back(til::rectangle{ til::point{ 0, 1 }, til::size{ 2, 1 } });
+        expectedSet.emplace_back(til::rectangle{ til::point{ 0, 2 }, til::size{ 1, 1 } });
+        _checkBits(expectedSet, bitmap);
+
         Log::Comment(L"Reset all.");
         bitmap.reset_all();
 
@@ -632,6 +651,42 @@ class BitmapTests
         _checkBits(expectedSet, bitmap);
     }
 
+    TEST_METHOD(UnionIntersect)
+    {
+        const til::size sz{ 4, 4 };
+        til::bitmap first{ sz };
+        til::bitmap second{ sz };
+
+        // 1 1 0 0     0 0 0 0
+        // 1 1 0 0     0 1 1 0
+        // 0 0 0 0     0 1 1 0
+        // 0 0 0 0     0 0 0 0
+        first.set(til::rectangle{ til::point{ 0, 0 }, til::size{ 2, 2 } });
+        second.set(til::rectangle{ til::point{ 1, 1 }, til::size{ 2, 2 } });
+
+        Log::Comment(L"Union should contain the bits of both.");
+        auto merged = first;
+        merged |= second;
+
+        std::vector<til::rectangle> expectedSet;
+        expectedSet.emplace_back(til::rectangle{ til::point{ 0, 0 }, til::size{ 2, 2 } });
+        expectedSet.emplace_back(til::rectangle{ til::point{ 1, 1 }, til::size{ 2, 2 } });
+        _checkBits(expectedSet, merged);
+
+        Log::Comment(L"Intersection should contain only the overlapping bit.");
+        auto overlap = first;
+        overlap &= second;
+
+        expectedSet.clear();
+        expectedSet.emplace_back(til::rectangle{ til::point{ 1, 1 } });
+        _checkBits(expectedSet, overlap);
+
+        Log::Comment(L"Combining bitmaps of different sizes should throw.");
+        til::bitmap other{ til::size{ 2, 2 } };
+        VERIFY_THROWS_SPECIFIC(merged |= other, wil::ResultException, [](wil::ResultException& e) { return e.GetErrorCode() == E_INVALIDARG; });
+        VERIFY_THROWS_SPECIFIC(overlap &= other, wil::ResultException, [](wil::ResultException& e) { return e.GetErrorCode() == E_INVALIDARG; });
+    }
+
     TEST_METHOD(SetResetExceptions)
     {
         til::bitmap map{ til::size{ 4, 4 } };
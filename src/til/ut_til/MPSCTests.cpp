@@ -0,0 +1,133 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "WexTestClass.h"
+
+#include <til/mpsc.h>
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+class MPSCTests
+{
+    BEGIN_TEST_CLASS(MPSCTests)
+        TEST_CLASS_PROPERTY(L"TestTimeout", L"0:0:10") // 10s timeout
+    END_TEST_CLASS()
+
+    TEST_METHOD(SmokeTest);
+    TEST_METHOD(DropTest);
+    TEST_METHOD(IntegrationTest);
+};
+
+void MPSCTests::SmokeTest()
+{
+    // This test mostly ensures that the API wasn't broken.
+
+    // construction
+    auto [tx, rx] = til::mpsc::channel<int>(32);
+    std::array<int, 3> data{};
+
+    // copy constructor
+    til::mpsc::producer tx2(tx);
+
+    // move assignment operator
+    tx = std::move(tx2);
+
+    // push
+    tx.emplace(0);
+    tx.push(data.begin(), data.end());
+    tx.push(til::mpsc::block_initially, data.begin(), data.end());
+    tx.push(til::mpsc::block_forever, data.begin(), data.end());
+    tx.push_n(data.begin(), data.size());
+    tx.push_n(til::mpsc::block_initially, data.begin(), data.size());
+    tx.push_n(til::mpsc::block_forever, data.begin(), data.size());
+
+    // pop
+    std::optional<int> x = rx.pop();
+    rx.pop_n(til::mpsc::block_initially, data.begin(), data.size());
+    rx.pop_n(til::mpsc::block_forever, data.begin(), data.size());
+}
+
+void MPSCTests::DropTest()
+{
+    auto [tx, rx] = til::mpsc::channel<int>(4);
+
+    {
+        auto tx2 = tx;
+        tx2.emplace(1);
+    }
+
+    Log::Comment(L"Dropping one copy of the producer must not close the channel.");
+    tx.emplace(2);
+    VERIFY_ARE_EQUAL(1, rx.pop());
+    VERIFY_ARE_EQUAL(2, rx.pop());
+
+    Log::Comment(L"Dropping the last copy closes the channel after the remaining items were read.");
+    tx.emplace(3);
+    {
+        auto _ = std::move(tx);
+    }
+    VERIFY_ARE_EQUAL(3, rx.pop());
+    VERIFY_IS_FALSE(rx.pop().has_value());
+}
+
+void MPSCTests::IntegrationTest()
+{
+    static constexpr int producerCount = 4;
+    static constexpr int batchCount = 25;
+    static constexpr int batchSize = 11;
+
+    auto [tx, rx] = til::mpsc::channel<int>(7);
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producerCount; ++p)
+    {
+        threads.emplace_back([p, tx = tx]() {
+            std::array<int, batchSize> buffer{};
+            for (int i = 0; i < batchCount; ++i)
+            {
+                buffer.fill(p);
+                tx.push(buffer.begin(), buffer.end());
+            }
+        });
+    }
+
+    // The threads hold their own copies of the producer.
+    // Dropping ours ensures that the consumer sees the end of the channel once they're done.
+    {
+        auto _ = std::move(tx);
+    }
+
+    // Batches must not be interleaved with each other, so every
+    // run of batchSize items must come from the same producer.
+    std::array<int, producerCount> counts{};
+    std::array<int, batchSize> buffer{};
+    for (;;)
+    {
+        const auto [count, ok] = rx.pop_n(buffer.data(), buffer.size());
+        if (count == 0)
+        {
+            VERIFY_IS_FALSE(ok);
+            break;
+        }
+
+        VERIFY_ARE_EQUAL(buffer.size(), count);
+        for (const auto v : buffer)
+        {
+            VERIFY_ARE_EQUAL(buffer[0], v);
+        }
+        ++counts.at(buffer[0]);
+    }
+
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+
+    for (const auto c : counts)
+    {
+        VERIFY_ARE_EQUAL(batchCount, c);
+    }
+}
@@ -0,0 +1,50 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+class PmrTests
+{
+    TEST_CLASS(PmrTests);
+
+    TEST_METHOD(CountingResourceCountsAllocations)
+    {
+        til::pmr::counting_resource resource;
+        VERIFY_ARE_EQUAL(0u, resource.bytes());
+        VERIFY_ARE_EQUAL(0u, resource.allocations());
+
+        const auto a = resource.allocate(16, alignof(std::max_align_t));
+        const auto b = resource.allocate(100, 4);
+        VERIFY_ARE_EQUAL(116u, resource.bytes());
+        VERIFY_ARE_EQUAL(2u, resource.allocations());
+
+        resource.deallocate(a, 16, alignof(std::max_align_t));
+        VERIFY_ARE_EQUAL(100u, resource.bytes());
+        VERIFY_ARE_EQUAL(1u, resource.allocations());
+
+        resource.deallocate(b, 100, 4);
+        VERIFY_ARE_EQUAL(0u, resource.bytes());
+        VERIFY_ARE_EQUAL(0u, resource.allocations());
+    }
+
+    TEST_METHOD(CountingResourceUnderneathAPool)
+    {
+        til::pmr::counting_resource resource;
+        {
+            std::pmr::unsynchronized_pool_resource pool{ &resource };
+            std::pmr::vector<int> vector{ &pool };
+            vector.resize(1000);
+
+            Log::Comment(L"The pool requests at least as much as the vector holds from upstream.");
+            VERIFY_IS_GREATER_THAN_OR_EQUAL(resource.bytes(), 1000 * sizeof(int));
+        }
+
+        Log::Comment(L"Destroying the pool returns everything upstream.");
+        VERIFY_ARE_EQUAL(0u, resource.bytes());
+        VERIFY_ARE_EQUAL(0u, resource.allocations());
+    }
+};
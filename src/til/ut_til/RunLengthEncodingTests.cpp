@@ -207,6 +207,19 @@ class RunLengthEncodingTests
         VERIFY_ARE_EQUAL("1 1 1 1 1"sv, rle);
     }
 
+    TEST_METHOD(ConstructWithAllocator)
+    {
+        std::pmr::monotonic_buffer_resource resource{ til::pmr::get_default_resource() };
+        til::pmr::rle<uint16_t, uint16_t> rle(5, 1, &resource);
+        VERIFY_ARE_EQUAL("1 1 1 1 1"sv, rle);
+        VERIFY_IS_TRUE(rle.get_allocator().resource() == &resource);
+
+        // Runs added later on must come from the same resource.
+        rle.replace(1, 3, 2);
+        VERIFY_ARE_EQUAL("1|2 2|1 1"sv, rle);
+        VERIFY_IS_TRUE(rle.runs().get_allocator().resource() == &resource);
+    }
+
     TEST_METHOD(CopyAndMove)
     {
         constexpr auto expected_full = "1 1 1|2 2|1 1 1"sv;
@@ -17,6 +17,7 @@ class Utf8Utf16ConvertTests
     TEST_METHOD(TestU8ToU16Partials);
     TEST_METHOD(TestU16ToU8Partials);
     TEST_METHOD(TestU8ToU16OneByOne);
+    TEST_METHOD(TestAsciiRuns);
 };
 
 void Utf8Utf16ConvertTests::TestU8ToU16()
@@ -191,3 +192,33 @@ void Utf8Utf16ConvertTests::TestU8ToU16OneByOne()
     VERIFY_SUCCEEDED(til::u8u16(u8String1_4, u16Out1, state));
     VERIFY_ARE_EQUAL(u16StringComp1, u16Out1);
 }
+
+void Utf8Utf16ConvertTests::TestAsciiRuns()
+{
+    // ASCII runs are converted without the platform functions. Make sure that they're
+    // stitched together correctly with the rest of the string, at every possible length.
+    for (size_t asciiLength = 0; asciiLength < 20; ++asciiLength)
+    {
+        const std::string ascii8(asciiLength, 'x');
+        const std::wstring ascii16(asciiLength, L'x');
+
+        const auto u8String{ ascii8 + "\xC3\xB6" + ascii8 }; // LATIN SMALL LETTER O WITH DIAERESIS
+        const auto u16String{ ascii16 + L"\x00F6" + ascii16 };
+
+        VERIFY_ARE_EQUAL(ascii16, til::u8u16(ascii8));
+        VERIFY_ARE_EQUAL(ascii8, til::u16u8(ascii16));
+        VERIFY_ARE_EQUAL(u16String, til::u8u16(u8String));
+        VERIFY_ARE_EQUAL(u8String, til::u16u8(u16String));
+
+        // Split the multibyte character between two calls.
+        til::u8state state8{};
+        auto u16Out{ til::u8u16(u8String.substr(0, asciiLength + 1), state8) };
+        u16Out += til::u8u16(u8String.substr(asciiLength + 1), state8);
+        VERIFY_ARE_EQUAL(u16String, u16Out);
+
+        til::u16state state16{};
+        auto u8Out{ til::u16u8(u16String.substr(0, asciiLength), state16) };
+        u8Out += til::u16u8(u16String.substr(asciiLength), state16);
+        VERIFY_ARE_EQUAL(u8String, u8Out);
+    }
+}
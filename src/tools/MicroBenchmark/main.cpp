@@ -0,0 +1,389 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+// TOOL MicroBenchmark
+// Measures the building blocks of the output and rendering hot paths: the til
+// conversions and containers, ROW/CharRow, TextAttribute and the glyph width
+// lookup. Every benchmark is warmed up first and then repeated a number of
+// times. The time per operation is reported as the minimum, median, 90th and
+// 99th percentile over all repetitions, either as a table or as JSON, which is
+// meant for comparing two builds with a script.
+//
+// Usage: MicroBenchmark.exe [/warmup:N] [/repetitions:N] [/filter:prefix] [/json]
+
+#include "pch.h"
+
+#include "../../buffer/out/textBuffer.hpp"
+#include "../../renderer/inc/DummyRenderTarget.hpp"
+#include "../../types/inc/CodepointWidthDetector.hpp"
+
+#include <chrono>
+#include <random>
+
+namespace
+{
+    constexpr COORD BufferSize{ 120, 30 };
+
+    struct Options
+    {
+        size_t warmup = 3;
+        size_t repetitions = 25;
+        std::wstring filter;
+        bool json = false;
+    };
+
+    struct Benchmark
+    {
+        std::wstring name;
+        // The number of operations a single call to run performs and
+        // the number of bytes of input they process, or 0 if that's meaningless.
+        size_t operations;
+        size_t bytes;
+        // Returns a value that depends on the work done, so that it can't be optimized away.
+        std::function<size_t()> run;
+    };
+
+    struct Result
+    {
+        // All values are in nanoseconds per operation.
+        double min;
+        double median;
+        double p90;
+        double p99;
+    };
+
+    // The results of the benchmarks are summed up in here, so that
+    // the compiler can't prove that nobody's looking at them.
+    volatile size_t s_sink = 0;
+
+    // Returns the nearest-rank percentile of the sorted samples.
+    double Percentile(const std::vector<double>& sorted, const double percentile) noexcept
+    {
+        const auto rank = static_cast<size_t>(std::ceil(percentile * sorted.size()));
+        return til::at(sorted, std::clamp<size_t>(rank, 1, sorted.size()) - 1);
+    }
+
+    Result Measure(const Benchmark& benchmark, const Options& options)
+    {
+        for (size_t i = 0; i < options.warmup; ++i)
+        {
+            s_sink = s_sink + benchmark.run();
+        }
+
+        std::vector<double> samples;
+        samples.reserve(options.repetitions);
+        for (size_t i = 0; i < options.repetitions; ++i)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            const auto value = benchmark.run();
+            const auto end = std::chrono::steady_clock::now();
+
+            s_sink = s_sink + value;
+            samples.push_back(std::chrono::duration<double, std::nano>(end - start).count() / benchmark.operations);
+        }
+
+        std::sort(samples.begin(), samples.end());
+        return { samples.front(), Percentile(samples, 0.5), Percentile(samples, 0.9), Percentile(samples, 0.99) };
+    }
+
+    // A mix of ASCII, Cyrillic, CJK and emoji, roughly like the output of a localized build tool.
+    std::wstring GenerateMixedText(const size_t length, const uint32_t seed)
+    {
+        static constexpr std::wstring_view samples[]{ L"ascii text ", L"\u0442\u0435\u043a\u0441\u0442 ", L"\u6587\u5b57", L"\U0001F600", L"0123456789" };
+
+        std::wstring text;
+        text.reserve(length + 16);
+        std::mt19937 rng{ seed };
+        while (text.size() < length)
+        {
+            text.append(til::at(samples, rng() % std::size(samples)));
+        }
+        text.resize(length);
+        // Don't end on a lone leading surrogate.
+        if (IS_HIGH_SURROGATE(text.back()))
+        {
+            text.back() = L' ';
+        }
+        return text;
+    }
+
+    std::string GenerateAscii(const size_t length, const uint32_t seed)
+    {
+        std::string text;
+        text.reserve(length);
+        std::mt19937 rng{ seed };
+        while (text.size() < length)
+        {
+            text.push_back(static_cast<char>(' ' + rng() % ('~' - ' ' + 1)));
+        }
+        return text;
+    }
+
+    std::vector<TextAttribute> GenerateAttributes(const size_t count, const uint32_t seed)
+    {
+        std::vector<TextAttribute> attributes;
+        attributes.reserve(count);
+        std::mt19937 rng{ seed };
+        for (size_t i = 0; i < count; ++i)
+        {
+            // Mostly legacy colors with few distinct values, like
+            // real output, so that comparisons aren't trivially false.
+            if (rng() % 4)
+            {
+                attributes.emplace_back(gsl::narrow_cast<WORD>(rng() % 4));
+            }
+            else
+            {
+                attributes.emplace_back(RGB(rng() % 256, rng() % 256, rng() % 256), RGB(0, 0, 0));
+            }
+        }
+        return attributes;
+    }
+
+    std::vector<Benchmark> CreateBenchmarks(DummyRenderTarget& renderTarget)
+    {
+        std::vector<Benchmark> benchmarks;
+
+        // til::u8u16 and til::u16u8 convert every chunk the connection reads.
+        {
+            constexpr size_t length = 1024 * 1024;
+            const auto ascii = GenerateAscii(length, 1);
+            const auto mixed = til::u16u8(GenerateMixedText(length / 2, 2));
+
+            benchmarks.push_back({ L"u8u16/ascii", 1, ascii.size(), [=, out = std::wstring{}]() mutable {
+                                      THROW_IF_FAILED(til::u8u16(ascii, out));
+                                      return out.size();
+                                  } });
+            benchmarks.push_back({ L"u8u16/mixed", 1, mixed.size(), [=, out = std::wstring{}]() mutable {
+                                      THROW_IF_FAILED(til::u8u16(mixed, out));
+                                      return out.size();
+                                  } });
+
+            const auto wide = GenerateMixedText(length / 2, 3);
+            benchmarks.push_back({ L"u16u8/mixed", 1, wide.size() * sizeof(wchar_t), [=, out = std::string{}]() mutable {
+                                      THROW_IF_FAILED(til::u16u8(wide, out));
+                                      return out.size();
+                                  } });
+        }
+
+        // basic_rle is what ATTR_ROW stores the attributes of a row in.
+        {
+            constexpr size_t operations = 10000;
+            constexpr uint16_t width = BufferSize.X;
+
+            const auto attributes = GenerateAttributes(64, 4);
+            std::vector<std::pair<uint16_t, uint16_t>> ranges;
+            std::vector<uint16_t> positions;
+            std::mt19937 rng{ 5 };
+            for (size_t i = 0; i < operations; ++i)
+            {
+                const auto start = gsl::narrow_cast<uint16_t>(rng() % width);
+                const auto end = gsl::narrow_cast<uint16_t>(start + 1 + rng() % (width - start));
+                ranges.emplace_back(start, end);
+                positions.push_back(gsl::narrow_cast<uint16_t>(rng() % width));
+            }
+
+            // A row with a run every few columns, like colored compiler output.
+            til::rle<TextAttribute, uint16_t> row{ width, TextAttribute{} };
+            for (uint16_t column = 0; column + 4 <= width; column += 4)
+            {
+                row.replace(column, gsl::narrow_cast<uint16_t>(column + 3), til::at(attributes, column % attributes.size()));
+            }
+
+            benchmarks.push_back({ L"rle/replace", operations, 0, [=]() mutable {
+                                      size_t i = 0;
+                                      for (const auto& [start, end] : ranges)
+                                      {
+                                          row.replace(start, end, til::at(attributes, i++ % attributes.size()));
+                                      }
+                                      return row.size();
+                                  } });
+            benchmarks.push_back({ L"rle/at", operations, 0, [=]() {
+                                      size_t hits = 0;
+                                      for (const auto position : positions)
+                                      {
+                                          hits += row.at(position).IsLegacy();
+                                      }
+                                      return hits;
+                                  } });
+        }
+
+        // The renderer walks the runs of its invalidation bitmap every frame.
+        {
+            til::bitmap bitmap{ til::size{ BufferSize } };
+            std::mt19937 rng{ 6 };
+            for (auto i = 0; i < 200; ++i)
+            {
+                const auto x = gsl::narrow_cast<ptrdiff_t>(rng() % BufferSize.X);
+                const auto y = gsl::narrow_cast<ptrdiff_t>(rng() % BufferSize.Y);
+                const auto w = gsl::narrow_cast<ptrdiff_t>(1 + rng() % 16);
+                bitmap.set(til::rectangle{ x, y, std::min<ptrdiff_t>(x + w, BufferSize.X), y + 1 });
+            }
+
+            benchmarks.push_back({ L"bitmap/runs", 1, 0, [=]() {
+                                      // Iterating doesn't use the cache that runs() fills.
+                                      size_t cells = 0;
+                                      for (const auto& run : bitmap)
+                                      {
+                                          cells += gsl::narrow_cast<size_t>(run.size().area());
+                                      }
+                                      return cells;
+                                  } });
+        }
+
+        // Writing to and reading from a ROW, which is what every printed character goes through.
+        {
+            auto buffer = std::make_shared<TextBuffer>(BufferSize, TextAttribute{}, 12, renderTarget);
+            const auto ascii = til::u8u16(GenerateAscii(BufferSize.X, 7));
+            const auto mixed = GenerateMixedText(BufferSize.X / 2, 8);
+            const TextAttribute attr{ 0x1f };
+
+            benchmarks.push_back({ L"row/WriteNarrowText", 1, ascii.size() * sizeof(wchar_t), [=]() {
+                                      return buffer->GetRowByOffset(0).WriteNarrowText(ascii, 0, attr);
+                                  } });
+            benchmarks.push_back({ L"row/WriteCells/mixed", 1, mixed.size() * sizeof(wchar_t), [=]() {
+                                      const auto it = buffer->GetRowByOffset(1).WriteCells(OutputCellIterator{ mixed, attr }, 0);
+                                      return gsl::narrow_cast<size_t>(it.GetCellDistance(OutputCellIterator{ mixed, attr }));
+                                  } });
+            benchmarks.push_back({ L"row/GetText", 1, 0, [=]() {
+                                      return buffer->GetRowByOffset(1).GetText().size();
+                                  } });
+            benchmarks.push_back({ L"row/ReadCharInfos", 1, 0, [=, infos = std::vector<CHAR_INFO>(BufferSize.X)]() mutable {
+                                      return buffer->GetRowByOffset(0).ReadCharInfos(0, infos);
+                                  } });
+        }
+
+        // The renderer compares the attributes of adjacent cells to split a line into runs.
+        {
+            constexpr size_t operations = 10000;
+            const auto attributes = GenerateAttributes(operations + 1, 9);
+
+            benchmarks.push_back({ L"TextAttribute/==", operations, 0, [=]() {
+                                      size_t equal = 0;
+                                      for (size_t i = 0; i < operations; ++i)
+                                      {
+                                          equal += til::at(attributes, i) == til::at(attributes, i + 1);
+                                      }
+                                      return equal;
+                                  } });
+        }
+
+        // Every glyph that isn't ASCII has its width looked up.
+        {
+            const auto text = GenerateMixedText(10000, 10);
+            std::vector<std::wstring_view> glyphs;
+            for (size_t i = 0; i < text.size(); ++i)
+            {
+                const auto length = IS_HIGH_SURROGATE(text[i]) && i + 1 < text.size() ? 2 : 1;
+                glyphs.emplace_back(text.data() + i, length);
+                i += length - 1;
+            }
+
+            auto detector = std::make_shared<CodepointWidthDetector>();
+            benchmarks.push_back({ L"CodepointWidthDetector/GetWidth", glyphs.size(), 0, [=]() {
+                                      size_t wide = 0;
+                                      for (const auto glyph : glyphs)
+                                      {
+                                          wide += detector->GetWidth(glyph) == CodepointWidth::Wide;
+                                      }
+                                      return wide;
+                                  } });
+        }
+
+        return benchmarks;
+    }
+
+    void PrintTable(const std::vector<std::pair<const Benchmark*, Result>>& results)
+    {
+        wprintf(L"%-32s %10s %10s %10s %10s %10s\n", L"benchmark", L"min (ns)", L"median", L"p90", L"p99", L"MB/s");
+        for (const auto& [benchmark, result] : results)
+        {
+            wprintf(L"%-32s %10.1f %10.1f %10.1f %10.1f", benchmark->name.c_str(), result.min, result.median, result.p90, result.p99);
+            if (benchmark->bytes)
+            {
+                const auto nsPerByte = result.median * benchmark->operations / benchmark->bytes;
+                wprintf(L" %10.1f", 1e9 / nsPerByte / (1024.0 * 1024.0));
+            }
+            wprintf(L"\n");
+        }
+    }
+
+    void PrintJson(const std::vector<std::pair<const Benchmark*, Result>>& results, const Options& options)
+    {
+        // The benchmark names are plain ASCII without quotes, so they don't need escaping.
+        wprintf(L"{\"warmup\":%zu,\"repetitions\":%zu,\"benchmarks\":[", options.warmup, options.repetitions);
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            const auto& [benchmark, result] = til::at(results, i);
+            wprintf(L"%s{\"name\":\"%s\",\"operations\":%zu,\"bytes\":%zu,\"min_ns\":%.2f,\"median_ns\":%.2f,\"p90_ns\":%.2f,\"p99_ns\":%.2f}",
+                    i ? L"," : L"",
+                    benchmark->name.c_str(),
+                    benchmark->operations,
+                    benchmark->bytes,
+                    result.min,
+                    result.median,
+                    result.p90,
+                    result.p99);
+        }
+        wprintf(L"]}\n");
+    }
+}
+
+int __cdecl wmain(int argc, wchar_t* argv[])
+try
+{
+    Options options;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::wstring_view arg{ argv[i] };
+        if (til::starts_with(arg, std::wstring_view{ L"/warmup:" }))
+        {
+            options.warmup = std::wcstoul(arg.data() + 8, nullptr, 10);
+        }
+        else if (til::starts_with(arg, std::wstring_view{ L"/repetitions:" }))
+        {
+            options.repetitions = std::max(1ul, std::wcstoul(arg.data() + 13, nullptr, 10));
+        }
+        else if (til::starts_with(arg, std::wstring_view{ L"/filter:" }))
+        {
+            options.filter = arg.substr(8);
+        }
+        else if (arg == L"/json")
+        {
+            options.json = true;
+        }
+        else
+        {
+            fwprintf(stderr, L"Usage: MicroBenchmark.exe [/warmup:N] [/repetitions:N] [/filter:prefix] [/json]\n");
+            return 1;
+        }
+    }
+
+    DummyRenderTarget renderTarget;
+    const auto benchmarks = CreateBenchmarks(renderTarget);
+
+    std::vector<std::pair<const Benchmark*, Result>> results;
+    for (const auto& benchmark : benchmarks)
+    {
+        if (til::starts_with(benchmark.name, options.filter))
+        {
+            results.emplace_back(&benchmark, Measure(benchmark, options));
+        }
+    }
+
+    if (options.json)
+    {
+        PrintJson(results, options);
+    }
+    else
+    {
+        PrintTable(results);
+    }
+
+    return 0;
+}
+catch (...)
+{
+    LOG_CAUGHT_EXCEPTION();
+    return 1;
+}
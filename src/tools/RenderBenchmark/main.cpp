@@ -0,0 +1,507 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+// TOOL RenderBenchmark
+// Measures the cost of the renderer apart from any connection. A headless
+// Terminal is filled with a recorded VT stream (or a generated one) and then
+// a replay script drives Renderer::PaintFrame against the DxEngine (optionally
+// on WARP), the GdiEngine and the VtEngine. Each engine gets a fresh terminal
+// and the same script, so the frames are identical between engines and runs.
+//
+// For every frame the wall clock time, the CPU cycles of the painting thread
+// and the heap allocations are recorded. The summary has the median, 90th and
+// 99th percentile of each engine. /csv: additionally writes every frame, for
+// comparing renderer changes across machines.
+//
+// The replay script has one command per line and paints one frame after each:
+//   write <text>                 writes text, with \e, \r, \n, \t, \\ and \xHH escapes
+//   invalidate-all               invalidates the entire viewport
+//   invalidate <l> <t> <r> <b>   invalidates an exclusive rectangle of viewport cells
+//   scroll <delta>               scrolls the viewport up (< 0) or down (> 0)
+//   cursor                       toggles the cursor, like a blink does
+//   repeat <n> <command>         runs a command, and paints a frame, n times
+// Empty lines and lines starting with # are ignored.
+//
+// Usage: RenderBenchmark.exe [/engine:dx|warp|gdi|vt]... [/state:path] [/script:path] [/csv:path]
+
+#include "pch.h"
+
+#include "../../cascadia/TerminalCore/Terminal.hpp"
+#include "../../inc/DefaultSettings.h"
+#include "../../renderer/base/renderer.hpp"
+#include "../../renderer/dx/DxRenderer.hpp"
+#include "../../renderer/gdi/gdirenderer.hpp"
+#include "../../renderer/vt/Xterm256Engine.hpp"
+
+#include <chrono>
+#include <random>
+
+using Microsoft::Terminal::Core::Terminal;
+using namespace Microsoft::Console::Render;
+using namespace Microsoft::Console::Types;
+
+// Every allocation made through the global operator new is counted, so that
+// we can report how many allocations a frame costs.
+static std::atomic<size_t> s_allocations{ 0 };
+
+void* operator new(size_t size)
+{
+    s_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (const auto p = malloc(size ? size : 1))
+    {
+        return p;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* p) noexcept
+{
+    free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+    free(p);
+}
+
+namespace
+{
+    constexpr COORD ViewportSize{ 120, 30 };
+    constexpr SHORT ScrollbackLines = 9001;
+    constexpr int Dpi = USER_DEFAULT_SCREEN_DPI;
+
+    // The generated state has one of these every few lines.
+    constexpr std::string_view PromptLine{ "\x1b[1;32muser@host\x1b[m:\x1b[1;34m~/src\x1b[m$ ls --color\r\n" };
+
+    // Roughly what a user does in a shell: typing, output, scrolling back and forth.
+    constexpr std::wstring_view DefaultScript{
+        L"invalidate-all\n"
+        L"repeat 100 cursor\n"
+        L"repeat 100 write x\n"
+        L"repeat 100 write \\r\\n\\e[33mwarning:\\e[m something happened in file.cpp(42)\n"
+        L"repeat 50 write \\e[H\\e[2J\\e[7mtop\\e[m \\xe6\\x96\\x87\\xe5\\xad\\x97 \\e[10;10Hcursor addressing\n"
+        L"repeat 50 scroll -1\n"
+        L"repeat 50 scroll 1\n"
+        L"repeat 50 invalidate 0 0 40 10\n"
+        L"repeat 50 invalidate-all\n"
+    };
+
+    enum class EngineKind
+    {
+        Dx,
+        Warp,
+        Gdi,
+        Vt,
+    };
+
+    struct Frame
+    {
+        double milliseconds;
+        uint64_t cycles;
+        size_t allocations;
+    };
+
+    // Colored lines with some wide glyphs, for whenever no recorded state is given.
+    std::string GenerateState()
+    {
+        std::string state;
+        std::mt19937 rng{ 1 };
+        for (auto line = 0; line < ScrollbackLines; ++line)
+        {
+            if (line % 10 == 0)
+            {
+                state.append(PromptLine);
+            }
+            for (auto column = 0; column < ViewportSize.X - 16;)
+            {
+                const auto length = 1 + rng() % 8;
+                state.append(fmt::format("\x1b[38;5;{}m", rng() % 256));
+                if (rng() % 8 == 0)
+                {
+                    // Two wide CJK glyphs.
+                    state.append("\xe6\x96\x87\xe5\xad\x97");
+                    column += 4;
+                }
+                state.append(length, static_cast<char>('a' + rng() % 26));
+                state.append("\x1b[m ");
+                column += gsl::narrow_cast<int>(length) + 1;
+            }
+            state.append("\r\n");
+        }
+        return state;
+    }
+
+    std::string ReadFile(const std::filesystem::path& path)
+    {
+        std::ifstream file{ path, std::ios::binary };
+        THROW_LAST_ERROR_IF(!file);
+        return { std::istreambuf_iterator<char>{ file }, std::istreambuf_iterator<char>{} };
+    }
+
+    // Turns the escapes of a "write" command into the UTF-8 they stand for.
+    std::wstring Unescape(const std::wstring_view text)
+    {
+        // \xHH escapes the bytes of UTF-8 sequences, so the text
+        // is assembled as UTF-8 and converted back at the end.
+        std::string utf8;
+        for (size_t i = 0; i < text.size(); ++i)
+        {
+            const auto escape = std::min(text.find(L'\\', i), text.size() - 1);
+            if (escape != i)
+            {
+                utf8.append(til::u16u8(text.substr(i, escape - i)));
+                i = escape;
+            }
+            if (til::at(text, i) != L'\\' || i + 1 == text.size())
+            {
+                utf8.append(til::u16u8(text.substr(i, 1)));
+                continue;
+            }
+
+            switch (til::at(text, ++i))
+            {
+            case L'e':
+                utf8.push_back('\x1b');
+                break;
+            case L'r':
+                utf8.push_back('\r');
+                break;
+            case L'n':
+                utf8.push_back('\n');
+                break;
+            case L't':
+                utf8.push_back('\t');
+                break;
+            case L'x':
+                utf8.push_back(static_cast<char>(std::wcstoul(std::wstring{ text.substr(i + 1, 2) }.c_str(), nullptr, 16)));
+                i += 2;
+                break;
+            default:
+                utf8.push_back(static_cast<char>(til::at(text, i)));
+                break;
+            }
+        }
+        return til::u8u16(utf8);
+    }
+
+    // A single command of the replay script. Applying it
+    // queues up the invalidations for the next frame.
+    struct Command
+    {
+        std::wstring verb;
+        std::wstring text;
+        std::array<SHORT, 4> args{};
+
+        void Apply(Terminal& terminal, Renderer& renderer) const
+        {
+            if (verb == L"write")
+            {
+                terminal.Write(text);
+            }
+            else if (verb == L"invalidate-all")
+            {
+                renderer.TriggerRedrawAll();
+            }
+            else if (verb == L"invalidate")
+            {
+                const auto view = terminal.GetViewport();
+                const SMALL_RECT rect{ gsl::narrow_cast<SHORT>(view.Left() + args[0]),
+                                       gsl::narrow_cast<SHORT>(view.Top() + args[1]),
+                                       gsl::narrow_cast<SHORT>(view.Left() + args[2]),
+                                       gsl::narrow_cast<SHORT>(view.Top() + args[3]) };
+                renderer.TriggerRedraw(Viewport::FromExclusive(rect));
+            }
+            else if (verb == L"scroll")
+            {
+                terminal.UserScrollViewport(terminal.GetScrollOffset() + args[0]);
+            }
+            else if (verb == L"cursor")
+            {
+                terminal.SetCursorOn(!terminal.IsCursorOn());
+            }
+        }
+    };
+
+    struct ScriptLine
+    {
+        size_t repeat;
+        Command command;
+    };
+
+    std::vector<ScriptLine> ParseScript(const std::wstring_view script)
+    {
+        std::vector<ScriptLine> lines;
+        std::wistringstream stream{ std::wstring{ script } };
+        std::wstring line;
+        while (std::getline(stream, line))
+        {
+            if (!line.empty() && line.back() == L'\r')
+            {
+                line.pop_back();
+            }
+            if (line.empty() || line.front() == L'#')
+            {
+                continue;
+            }
+
+            std::wistringstream words{ line };
+            ScriptLine parsed{ 1, {} };
+            words >> parsed.command.verb;
+            if (parsed.command.verb == L"repeat")
+            {
+                words >> parsed.repeat >> parsed.command.verb;
+            }
+
+            const auto& verb = parsed.command.verb;
+            size_t argCount = 0;
+            if (verb == L"write")
+            {
+                std::wstring text;
+                std::getline(words >> std::ws, text);
+                parsed.command.text = Unescape(text);
+            }
+            else if (verb == L"invalidate")
+            {
+                argCount = 4;
+            }
+            else if (verb == L"scroll")
+            {
+                argCount = 1;
+            }
+            else
+            {
+                THROW_HR_IF_MSG(E_INVALIDARG, verb != L"invalidate-all" && verb != L"cursor", "Unknown command: %ls", line.c_str());
+            }
+
+            for (size_t i = 0; i < argCount; ++i)
+            {
+                words >> til::at(parsed.command.args, i);
+            }
+
+            THROW_HR_IF_MSG(E_INVALIDARG, words.fail() && verb != L"write", "Malformed script line: %ls", line.c_str());
+            lines.push_back(std::move(parsed));
+        }
+        return lines;
+    }
+
+    // A window that's never shown, for the GdiEngine to paint into.
+    wil::unique_hwnd CreateHiddenWindow(const SIZE pixels)
+    {
+        wil::unique_hwnd hwnd{ CreateWindowExW(0, L"STATIC", L"RenderBenchmark", WS_POPUP, 0, 0, pixels.cx, pixels.cy, nullptr, nullptr, nullptr, nullptr) };
+        THROW_LAST_ERROR_IF(!hwnd);
+        return hwnd;
+    }
+
+    struct EngineHost
+    {
+        std::unique_ptr<IRenderEngine> engine;
+        wil::unique_hwnd hwnd;
+    };
+
+    EngineHost CreateEngine(const EngineKind kind)
+    {
+        const FontInfoDesired desired{ L"Consolas", 0, DEFAULT_FONT_WEIGHT, { 0, DEFAULT_FONT_SIZE }, CP_UTF8 };
+        FontInfo actual{ L"Consolas", 0, DEFAULT_FONT_WEIGHT, { 0, DEFAULT_FONT_SIZE }, CP_UTF8, false };
+
+        EngineHost host;
+        switch (kind)
+        {
+        case EngineKind::Dx:
+        case EngineKind::Warp:
+        {
+            // Without an HWND the DxEngine creates a swap chain for composition,
+            // which it can present into just fine without ever being shown.
+            auto dx = std::make_unique<DxEngine>();
+            dx->SetSoftwareRendering(kind == EngineKind::Warp);
+            THROW_IF_FAILED(dx->UpdateDpi(Dpi));
+            THROW_IF_FAILED(dx->UpdateFont(desired, actual));
+            const auto cell = actual.GetSize();
+            THROW_IF_FAILED(dx->SetWindowSize({ ViewportSize.X * cell.X, ViewportSize.Y * cell.Y }));
+            THROW_IF_FAILED(dx->Enable());
+            host.engine = std::move(dx);
+            break;
+        }
+        case EngineKind::Gdi:
+        {
+            auto gdi = std::make_unique<GdiEngine>();
+            THROW_IF_FAILED(gdi->UpdateDpi(Dpi));
+            THROW_IF_FAILED(gdi->UpdateFont(desired, actual));
+            const auto cell = actual.GetSize();
+            host.hwnd = CreateHiddenWindow({ ViewportSize.X * cell.X, ViewportSize.Y * cell.Y });
+            THROW_IF_FAILED(gdi->SetHwnd(host.hwnd.get()));
+            host.engine = std::move(gdi);
+            break;
+        }
+        case EngineKind::Vt:
+        {
+            // Conpty's output engine, writing into the void.
+            wil::unique_hfile nul{ CreateFileW(L"NUL", GENERIC_WRITE, 0, nullptr, OPEN_EXISTING, 0, nullptr) };
+            THROW_LAST_ERROR_IF(!nul);
+            host.engine = std::make_unique<Xterm256Engine>(std::move(nul), Viewport::FromDimensions({ 0, 0 }, ViewportSize));
+            break;
+        }
+        }
+        return host;
+    }
+
+    std::vector<Frame> Run(const EngineKind kind, const std::wstring_view state, const std::vector<ScriptLine>& script)
+    {
+        auto host = CreateEngine(kind);
+
+        // There's no render thread. Frames are painted synchronously
+        // with PaintFrame, right after a command was applied.
+        Terminal terminal;
+        Renderer renderer{ &terminal, nullptr, 0, nullptr };
+        terminal.Create(ViewportSize, ScrollbackLines, renderer);
+        renderer.AddRenderEngine(host.engine.get());
+
+        terminal.Write(state);
+        LOG_IF_FAILED(renderer.PaintFrame());
+
+        std::vector<Frame> frames;
+        const auto thread = GetCurrentThread();
+        for (const auto& line : script)
+        {
+            for (size_t i = 0; i < line.repeat; ++i)
+            {
+                line.command.Apply(terminal, renderer);
+
+                uint64_t cyclesBefore = 0;
+                uint64_t cyclesAfter = 0;
+                const auto allocationsBefore = s_allocations.load();
+                QueryThreadCycleTime(thread, &cyclesBefore);
+                const auto start = std::chrono::steady_clock::now();
+
+                LOG_IF_FAILED(renderer.PaintFrame());
+
+                const auto end = std::chrono::steady_clock::now();
+                QueryThreadCycleTime(thread, &cyclesAfter);
+                frames.push_back({ std::chrono::duration<double, std::milli>(end - start).count(),
+                                   cyclesAfter - cyclesBefore,
+                                   s_allocations.load() - allocationsBefore });
+            }
+        }
+        return frames;
+    }
+
+    template<typename T, typename Projection>
+    T Percentile(const std::vector<Frame>& frames, const double percentile, Projection&& projection)
+    {
+        std::vector<T> values;
+        values.reserve(frames.size());
+        std::transform(frames.begin(), frames.end(), std::back_inserter(values), projection);
+        std::sort(values.begin(), values.end());
+        const auto rank = static_cast<size_t>(std::ceil(percentile * values.size()));
+        return til::at(values, std::clamp<size_t>(rank, 1, values.size()) - 1);
+    }
+
+    const wchar_t* EngineName(const EngineKind kind) noexcept
+    {
+        switch (kind)
+        {
+        case EngineKind::Dx:
+            return L"dx";
+        case EngineKind::Warp:
+            return L"warp";
+        case EngineKind::Gdi:
+            return L"gdi";
+        default:
+            return L"vt";
+        }
+    }
+}
+
+int __cdecl wmain(int argc, wchar_t* argv[])
+try
+{
+    std::vector<EngineKind> engines;
+    std::optional<std::string> state;
+    std::wstring script{ DefaultScript };
+    std::optional<std::filesystem::path> csvPath;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::wstring_view arg{ argv[i] };
+        if (til::starts_with(arg, std::wstring_view{ L"/engine:" }))
+        {
+            static constexpr std::array<EngineKind, 4> kinds{ EngineKind::Dx, EngineKind::Warp, EngineKind::Gdi, EngineKind::Vt };
+            const auto name = arg.substr(8);
+            const auto it = std::find_if(kinds.begin(), kinds.end(), [&](const auto kind) { return name == EngineName(kind); });
+            THROW_HR_IF_MSG(E_INVALIDARG, it == kinds.end(), "Unknown engine: %.*ls", gsl::narrow<int>(name.size()), name.data());
+            engines.push_back(*it);
+        }
+        else if (til::starts_with(arg, std::wstring_view{ L"/state:" }))
+        {
+            state = ReadFile(arg.substr(7));
+        }
+        else if (til::starts_with(arg, std::wstring_view{ L"/script:" }))
+        {
+            script = til::u8u16(ReadFile(arg.substr(8)));
+        }
+        else if (til::starts_with(arg, std::wstring_view{ L"/csv:" }))
+        {
+            csvPath = arg.substr(5);
+        }
+        else
+        {
+            fwprintf(stderr, L"Usage: RenderBenchmark.exe [/engine:dx|warp|gdi|vt]... [/state:path] [/script:path] [/csv:path]\n");
+            return 1;
+        }
+    }
+
+    if (engines.empty())
+    {
+        engines = { EngineKind::Dx, EngineKind::Warp, EngineKind::Gdi, EngineKind::Vt };
+    }
+
+    const auto stateText = til::u8u16(state ? *state : GenerateState());
+    const auto lines = ParseScript(script);
+
+    std::wofstream csv;
+    if (csvPath)
+    {
+        csv.open(*csvPath);
+        THROW_LAST_ERROR_IF(!csv);
+        csv << L"engine,frame,milliseconds,cycles,allocations\n";
+    }
+
+    wprintf(L"%-8s %8s %10s %10s %10s %14s %12s\n", L"engine", L"frames", L"median ms", L"p90 ms", L"p99 ms", L"median cycles", L"allocs/frame");
+
+    for (const auto kind : engines)
+    {
+        const auto frames = Run(kind, stateText, lines);
+        if (frames.empty())
+        {
+            continue;
+        }
+
+        const auto milliseconds = [](const Frame& f) { return f.milliseconds; };
+        const auto cycles = [](const Frame& f) { return f.cycles; };
+        const auto allocations = std::accumulate(frames.begin(), frames.end(), size_t{ 0 }, [](size_t sum, const Frame& f) { return sum + f.allocations; });
+
+        wprintf(L"%-8s %8zu %10.3f %10.3f %10.3f %14llu %12.1f\n",
+                EngineName(kind),
+                frames.size(),
+                Percentile<double>(frames, 0.5, milliseconds),
+                Percentile<double>(frames, 0.9, milliseconds),
+                Percentile<double>(frames, 0.99, milliseconds),
+                Percentile<uint64_t>(frames, 0.5, cycles),
+                static_cast<double>(allocations) / frames.size());
+
+        if (csv.is_open())
+        {
+            for (size_t i = 0; i < frames.size(); ++i)
+            {
+                const auto& frame = til::at(frames, i);
+                csv << EngineName(kind) << L',' << i << L',' << frame.milliseconds << L',' << frame.cycles << L',' << frame.allocations << L'\n';
+            }
+        }
+    }
+
+    return 0;
+}
+catch (...)
+{
+    LOG_CAUGHT_EXCEPTION();
+    return 1;
+}
@@ -0,0 +1,256 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+// TOOL TerminalBenchmark
+// Measures the throughput of the output pipeline of the Terminal: the VT
+// parser, TerminalDispatch and the TextBuffer, without any renderer attached.
+// It writes a set of synthetic workloads (and optionally any number of
+// recorded VT streams given on the command line, e.g. captured with
+// `script`) into a headless Terminal in the same chunk size the conpty
+// connection uses, and reports MB/s and heap allocations per MB of input.
+// Session recordings (*.cast) are replayed by their output alone.
+//
+// Usage: TerminalBenchmark.exe [/iterations:N] [path to a VT stream or recording...]
+
+#include "pch.h"
+
+#include "../../cascadia/TerminalCore/Terminal.hpp"
+#include "../../cascadia/TerminalConnection/Asciicast.h"
+#include "../../renderer/inc/DummyRenderTarget.hpp"
+
+#include <chrono>
+#include <fstream>
+#include <random>
+
+using Microsoft::Terminal::Core::Terminal;
+
+// Every allocation made through the global operator new is counted, so that
+// we can report how many allocations processing a MB of output costs.
+static std::atomic<size_t> s_allocations{ 0 };
+
+void* operator new(size_t size)
+{
+    s_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (const auto p = malloc(size ? size : 1))
+    {
+        return p;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* p) noexcept
+{
+    free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+    free(p);
+}
+
+namespace
+{
+    // The ConptyConnection reads and forwards output in chunks of this size.
+    constexpr size_t ChunkSize = 4096;
+    // Every synthetic workload contains roughly this much output.
+    constexpr size_t WorkloadSize = 16 * 1024 * 1024;
+    constexpr COORD ViewportSize{ 120, 30 };
+    constexpr SHORT ScrollbackLines = 9001;
+
+    struct Workload
+    {
+        std::wstring name;
+        std::string utf8;
+    };
+
+    // Plain text, like `cat` on a log file.
+    std::string GenerateAscii()
+    {
+        std::string output;
+        output.reserve(WorkloadSize);
+        std::mt19937 rng{ 1 };
+        while (output.size() < WorkloadSize)
+        {
+            const auto length = rng() % ViewportSize.X;
+            for (size_t i = 0; i < length; ++i)
+            {
+                output.push_back(static_cast<char>(' ' + rng() % ('~' - ' ' + 1)));
+            }
+            output.append("\r\n");
+        }
+        return output;
+    }
+
+    // Colored output, like a compiler or `ls --color`, with an SGR sequence every word.
+    std::string GenerateSgr()
+    {
+        std::string output;
+        output.reserve(WorkloadSize);
+        std::mt19937 rng{ 2 };
+        while (output.size() < WorkloadSize)
+        {
+            for (auto column = 0; column < ViewportSize.X - 10;)
+            {
+                const auto length = 1 + rng() % 8;
+                output.append(fmt::format("\x1b[{};38;5;{}m", rng() % 2, rng() % 256));
+                output.append(length, static_cast<char>('a' + rng() % 26));
+                output.append("\x1b[m ");
+                column += gsl::narrow_cast<int>(length) + 1;
+            }
+            output.append("\r\n");
+        }
+        return output;
+    }
+
+    // Wide CJK text, which has to go through the width lookup for every character.
+    std::string GenerateCjk()
+    {
+        std::wstring output;
+        output.reserve(WorkloadSize / 3);
+        std::mt19937 rng{ 3 };
+        while (output.size() * 3 < WorkloadSize)
+        {
+            const auto length = rng() % (ViewportSize.X / 2);
+            for (size_t i = 0; i < length; ++i)
+            {
+                output.push_back(static_cast<wchar_t>(0x4E00 + rng() % 0x5000));
+            }
+            output.append(L"\r\n");
+        }
+        return til::u16u8(output);
+    }
+
+    // A full screen application, like htop or vim, repainting parts of the viewport.
+    std::string GenerateCursorAddressing()
+    {
+        std::string output;
+        output.reserve(WorkloadSize);
+        std::mt19937 rng{ 4 };
+        // Switch to the alternate buffer, just like a TUI would.
+        output.append("\x1b[?1049h");
+        while (output.size() < WorkloadSize)
+        {
+            const auto row = 1 + rng() % ViewportSize.Y;
+            const auto column = 1 + rng() % (ViewportSize.X - 20);
+            output.append(fmt::format("\x1b[{};{}H\x1b[{}m", row, column, 30 + rng() % 8));
+            output.append(rng() % 20, static_cast<char>('A' + rng() % 26));
+            if (rng() % 16 == 0)
+            {
+                output.append("\x1b[K");
+            }
+        }
+        output.append("\x1b[?1049l");
+        return output;
+    }
+
+    std::string ReadStream(const std::filesystem::path& path)
+    {
+        std::ifstream file{ path, std::ios::binary };
+        THROW_LAST_ERROR_IF(!file);
+        std::string bytes{ std::istreambuf_iterator<char>{ file }, std::istreambuf_iterator<char>{} };
+        if (path.extension() != L".cast")
+        {
+            return bytes;
+        }
+
+        std::wstring output;
+        for (const auto& event : Microsoft::Terminal::TerminalConnection::Asciicast::Parse(bytes).events)
+        {
+            if (event.type == L'o')
+            {
+                output.append(event.data);
+            }
+        }
+        return til::u16u8(output);
+    }
+
+    struct Result
+    {
+        double seconds;
+        size_t allocations;
+    };
+
+    Result Run(const std::wstring_view text)
+    {
+        DummyRenderTarget renderTarget;
+        Terminal terminal;
+        terminal.Create(ViewportSize, ScrollbackLines, renderTarget);
+
+        const auto allocationsBefore = s_allocations.load();
+        const auto start = std::chrono::steady_clock::now();
+
+        for (size_t offset = 0; offset < text.size();)
+        {
+            auto length = std::min(ChunkSize, text.size() - offset);
+            // Don't split surrogate pairs, just like the connection doesn't.
+            if (offset + length < text.size() && IS_HIGH_SURROGATE(text[offset + length - 1]))
+            {
+                --length;
+            }
+
+            // Write takes the terminal's lock itself, like it does for the connection.
+            terminal.Write(text.substr(offset, length));
+            offset += length;
+        }
+
+        const auto end = std::chrono::steady_clock::now();
+        return { std::chrono::duration<double>(end - start).count(), s_allocations.load() - allocationsBefore };
+    }
+}
+
+int __cdecl wmain(int argc, wchar_t* argv[])
+try
+{
+    size_t iterations = 5;
+    std::vector<Workload> workloads{
+        { L"ascii", GenerateAscii() },
+        { L"sgr", GenerateSgr() },
+        { L"cjk", GenerateCjk() },
+        { L"cursor addressing", GenerateCursorAddressing() },
+    };
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::wstring_view arg{ argv[i] };
+        if (til::starts_with(arg, std::wstring_view{ L"/iterations:" }))
+        {
+            iterations = std::max(1ul, std::wcstoul(arg.data() + 12, nullptr, 10));
+        }
+        else
+        {
+            workloads.push_back({ std::filesystem::path{ arg }.filename().wstring(), ReadStream(arg) });
+        }
+    }
+
+    wprintf(L"%-24s %10s %12s %14s\n", L"workload", L"size (MB)", L"MB/s", L"allocs/MB");
+
+    for (const auto& workload : workloads)
+    {
+        const auto text = til::u8u16(workload.utf8);
+        const auto megabytes = workload.utf8.size() / (1024.0 * 1024.0);
+
+        // The best of several runs is the most stable measure on a busy machine.
+        auto best = Run(text);
+        for (size_t i = 1; i < iterations; ++i)
+        {
+            const auto result = Run(text);
+            if (result.seconds < best.seconds)
+            {
+                best = result;
+            }
+        }
+
+        wprintf(L"%-24s %10.2f %12.2f %14.1f\n",
+                workload.name.c_str(),
+                megabytes,
+                megabytes / best.seconds,
+                best.allocations / megabytes);
+    }
+
+    return 0;
+}
+catch (...)
+{
+    LOG_CAUGHT_EXCEPTION();
+    return 1;
+}
@@ -0,0 +1,16 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- pch.h
+
+Abstract:
+- Contains external headers to include in the precompile phase of the
+  TerminalBenchmark tool.
+--*/
+
+#pragma once
+
+#define WIN32_LEAN_AND_MEAN
+#include <LibraryIncludes.h>
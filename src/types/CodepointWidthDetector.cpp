@@ -3,6 +3,7 @@
 
 #include "precomp.h"
 #include "inc/CodepointWidthDetector.hpp"
+#include "inc/Utf16Parser.hpp"
 
 namespace
 {
@@ -321,6 +322,67 @@ namespace
         UnicodeRange{ 0xf0000, 0xffffd, CodepointWidth::Ambiguous },
         UnicodeRange{ 0x100000, 0x10fffd, CodepointWidth::Ambiguous },
     };
+
+    // Lookup table for the width of every codepoint in the Basic Multilingual Plane,
+    // derived from s_wideAndAmbiguousTable. It turns the binary search over that table
+    // into two loads for the vast majority of glyphs, which are not surrogate pairs.
+    // The plane is split into 256 blocks of 256 codepoints. Most blocks are identical
+    // (entirely narrow or entirely wide), so every distinct block is only stored once
+    // and the first stage maps the high byte of a codepoint to the offset of its block.
+    class BmpWidthTable final
+    {
+    public:
+        BmpWidthTable()
+        {
+            std::vector<CodepointWidth> widths(0x10000, CodepointWidth::Narrow);
+            for (const auto& range : s_wideAndAmbiguousTable)
+            {
+                if (range.lowerBound > 0xffff)
+                {
+                    break;
+                }
+                const auto upperBound = std::min(range.upperBound, 0xffffu);
+                std::fill(widths.begin() + range.lowerBound, widths.begin() + upperBound + 1, range.width);
+            }
+
+            for (size_t block = 0; block < _stage1.size(); ++block)
+            {
+                const auto blockBegin = widths.begin() + block * s_blockSize;
+                const auto blockEnd = blockBegin + s_blockSize;
+
+                size_t offset = 0;
+                while (offset < _stage2.size() && !std::equal(blockBegin, blockEnd, _stage2.begin() + offset))
+                {
+                    offset += s_blockSize;
+                }
+                if (offset == _stage2.size())
+                {
+                    _stage2.insert(_stage2.end(), blockBegin, blockEnd);
+                }
+
+                til::at(_stage1, block) = gsl::narrow_cast<uint16_t>(offset);
+            }
+
+            _stage2.shrink_to_fit();
+        }
+
+        CodepointWidth operator[](const wchar_t wch) const noexcept
+        {
+            return til::at(_stage2, til::at(_stage1, wch >> 8) + (wch & 0xff));
+        }
+
+    private:
+        static constexpr size_t s_blockSize = 256;
+
+        std::array<uint16_t, 256> _stage1{};
+        std::vector<CodepointWidth> _stage2;
+    };
+
+    const BmpWidthTable& GetBmpWidthTable()
+    {
+        static const BmpWidthTable table;
+        return table;
+    }
 }
 
 // Routine Description:
@@ -342,37 +404,41 @@ CodepointWidth CodepointWidthDetector::GetWidth(const std::wstring_view glyph) c
     THROW_HR_IF(E_INVALIDARG, glyph.empty());
     if (glyph.size() == 1)
     {
-        // We first attempt to look at our custom quick lookup table of char width preferences.
-        const auto width = GetQuickCharWidth(glyph.front());
+        return _lookupBmpWidth(glyph.front());
+    }
+    else
+    {
+        return _lookupGlyphWidthWithCache(glyph);
+    }
+}
 
-        // If it's invalid, the quick width had no opinion, so go to the lookup table.
-        if (width == CodepointWidth::Invalid)
-        {
-            return _lookupGlyphWidthWithCache(glyph);
-        }
-        // If it's ambiguous, the quick width wanted us to ask the font directly, try that if we can.
-        // If not, go to the lookup table.
-        else if (width == CodepointWidth::Ambiguous)
+// Routine Description:
+// - returns the width type of every codepoint in the given text. This is faster
+//   than calling GetWidth for every codepoint individually.
+// Arguments:
+// - text - the utf16 encoded text to measure. Surrogate pairs are treated as one codepoint.
+// Return Value:
+// - the width type of each codepoint, in order
+std::vector<CodepointWidth> CodepointWidthDetector::GetWidths(const std::wstring_view text) const
+{
+    std::vector<CodepointWidth> widths;
+    widths.reserve(text.size());
+
+    for (size_t i = 0; i < text.size(); ++i)
+    {
+        const auto wch = til::at(text, i);
+        if (Utf16Parser::IsLeadingSurrogate(wch) && i + 1 < text.size() && Utf16Parser::IsTrailingSurrogate(til::at(text, i + 1)))
         {
-            if (_pfnFallbackMethod)
-            {
-                return _checkFallbackViaCache(glyph) ? CodepointWidth::Wide : CodepointWidth::Ambiguous;
-            }
-            else
-            {
-                return _lookupGlyphWidthWithCache(glyph);
-            }
+            widths.emplace_back(_lookupGlyphWidthWithCache(text.substr(i, 2)));
+            ++i;
         }
-        // Otherwise, return Width as it is.
         else
         {
-            return width;
+            widths.emplace_back(_lookupBmpWidth(wch));
         }
     }
-    else
-    {
-        return _lookupGlyphWidthWithCache(glyph);
-    }
+
+    return widths;
 }
 
 // Routine Description:
@@ -429,6 +495,26 @@ CodepointWidth CodepointWidthDetector::_lookupGlyphWidth(const std::wstring_view
     return CodepointWidth::Narrow;
 }
 
+// Routine Description:
+// - returns the width type of a codepoint in the Basic Multilingual Plane,
+//   using the fallback method for ambiguous ones.
+// Arguments:
+// - wch - the codepoint to check width of
+// Return Value:
+// - the width type of the codepoint
+CodepointWidth CodepointWidthDetector::_lookupBmpWidth(const wchar_t wch) const
+{
+    const auto width = GetBmpWidthTable()[wch];
+
+    // If it's ambiguous, then ask the font if we can.
+    if (width == CodepointWidth::Ambiguous && _pfnFallbackMethod)
+    {
+        return _checkFallbackViaCache({ &wch, 1 }) ? CodepointWidth::Wide : CodepointWidth::Ambiguous;
+    }
+
+    return width;
+}
+
 // Routine Description:
 // - returns the width type of codepoint using fallback methods.
 // Arguments:
@@ -0,0 +1,1285 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "inc/GraphemeSegmenter.hpp"
+#include "inc/Utf16Parser.hpp"
+
+namespace
+{
+    // Every entry of the table is the first codepoint of a run of codepoints that
+    // share the same property, packed into the upper 24 bits, and the property
+    // in the lower 8 bits. A run lasts until the start of the next one.
+    constexpr uint32_t GraphemeBreakRun(const char32_t start, const GraphemeClusterBreak value) noexcept
+    {
+        return static_cast<uint32_t>(start) << 8 | static_cast<uint32_t>(value);
+    }
+
+    constexpr char32_t HangulSyllableFirst = 0xAC00;
+    constexpr char32_t HangulSyllableLast = 0xD7A3;
+    constexpr char32_t HangulTCount = 28;
+
+    // The Hangul syllables are a single LV run, of which every one that isn't
+    // a multiple of HangulTCount past the first syllable is actually LVT.
+    // Generated by Generate-GraphemeBreakTableFromUCD.ps1 from Unicode 14.0.0.
+    static constexpr std::array<uint32_t, 1031> s_graphemeBreakTable{
+        GraphemeBreakRun(0x0, GraphemeClusterBreak::Control),
+        GraphemeBreakRun(0xa, GraphemeClusterBreak::LF),
+        GraphemeBreakRun(0xb, GraphemeClusterBreak::Control),
+        GraphemeBreakRun(0xd, GraphemeClusterBreak::CR),
+        GraphemeBreakRun(0xe, GraphemeClusterBreak::Control),
+        GraphemeBreakRun(0x20, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x7f, GraphemeClusterBreak::Control),
+        GraphemeBreakRun(0xa0, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xa9, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0xaa, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xad, GraphemeClusterBreak::Control),
+        GraphemeBreakRun(0xae, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0xaf, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x300, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x370, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x483, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x48a, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x591, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x5be, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x5bf, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x5c0, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x5c1, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x5c3, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x5c4, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x5c6, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x5c7, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x5c8, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x600, GraphemeClusterBreak::Prepend),
+        GraphemeBreakRun(0x606, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x610, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x61b, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x61c, GraphemeClusterBreak::Control),
+        GraphemeBreakRun(0x61d, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x64b, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x660, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x670, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x671, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x6d6, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x6dd, GraphemeClusterBreak::Prepend),
+        GraphemeBreakRun(0x6de, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x6df, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x6e5, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x6e7, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x6e9, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x6ea, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x6ee, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x70f, GraphemeClusterBreak::Prepend),
+        GraphemeBreakRun(0x710, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x711, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x712, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x730, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x74b, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x7a6, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x7b1, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x7eb, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x7f4, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x7fd, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x7fe, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x816, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x81a, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x81b, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x824, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x825, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x828, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x829, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x82e, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x859, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x85c, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x890, GraphemeClusterBreak::Prepend),
+        GraphemeBreakRun(0x892, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x898, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x8a0, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x8ca, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x8e2, GraphemeClusterBreak::Prepend),
+        GraphemeBreakRun(0x8e3, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x903, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x904, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x93a, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x93b, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x93c, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x93d, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x93e, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x941, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x949, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x94d, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x94e, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x950, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x951, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x958, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x962, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x964, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x981, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x982, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x984, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x9bc, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x9bd, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x9be, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x9bf, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x9c1, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x9c5, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x9c7, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x9c9, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x9cb, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x9cd, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x9ce, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x9d7, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x9d8, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x9e2, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x9e4, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x9fe, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x9ff, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xa01, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xa03, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0xa04, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xa3c, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xa3d, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xa3e, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0xa41, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xa43, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xa47, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xa49, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xa4b, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xa4e, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xa51, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xa52, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xa70, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xa72, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xa75, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xa76, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xa81, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xa83, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0xa84, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xabc, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xabd, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xabe, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0xac1, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xac6, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xac7, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xac9, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0xaca, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xacb, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0xacd, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xace, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xae2, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xae4, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xafa, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xb00, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xb01, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xb02, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0xb04, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xb3c, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xb3d, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xb3e, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xb40, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0xb41, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xb45, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xb47, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0xb49, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xb4b, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0xb4d, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xb4e, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xb55, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xb58, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xb62, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xb64, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xb82, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xb83, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xbbe, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xbbf, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0xbc0, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xbc1, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0xbc3, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xbc6, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0xbc9, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xbca, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0xbcd, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xbce, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xbd7, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xbd8, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xc00, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xc01, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0xc04, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xc05, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xc3c, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xc3d, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xc3e, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xc41, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0xc45, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xc46, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xc49, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xc4a, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xc4e, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xc55, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xc57, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xc62, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xc64, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xc81, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xc82, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0xc84, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xcbc, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xcbd, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xcbe, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0xcbf, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xcc0, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0xcc2, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xcc3, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0xcc5, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xcc6, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xcc7, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0xcc9, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xcca, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0xccc, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xcce, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xcd5, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xcd7, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xce2, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xce4, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xd00, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xd02, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0xd04, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xd3b, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xd3d, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xd3e, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xd3f, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0xd41, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xd45, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xd46, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0xd49, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xd4a, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0xd4d, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xd4e, GraphemeClusterBreak::Prepend),
+        GraphemeBreakRun(0xd4f, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xd57, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xd58, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xd62, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xd64, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xd81, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xd82, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0xd84, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xdca, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xdcb, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xdcf, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xdd0, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0xdd2, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xdd5, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xdd6, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xdd7, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xdd8, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0xddf, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xde0, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xdf2, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0xdf4, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xe31, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xe32, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xe33, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0xe34, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xe3b, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xe47, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xe4f, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xeb1, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xeb2, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xeb3, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0xeb4, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xebd, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xec8, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xece, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xf18, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xf1a, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xf35, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xf36, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xf37, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xf38, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xf39, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xf3a, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xf3e, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0xf40, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xf71, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xf7f, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0xf80, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xf85, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xf86, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xf88, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xf8d, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xf98, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xf99, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xfbd, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xfc6, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xfc7, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x102d, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1031, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x1032, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1038, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1039, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x103b, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x103d, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x103f, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1056, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x1058, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x105a, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x105e, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1061, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1071, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1075, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1082, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1083, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1084, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x1085, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1087, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x108d, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x108e, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x109d, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x109e, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1100, GraphemeClusterBreak::L),
+        GraphemeBreakRun(0x1160, GraphemeClusterBreak::V),
+        GraphemeBreakRun(0x11a8, GraphemeClusterBreak::T),
+        GraphemeBreakRun(0x1200, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x135d, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1360, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1712, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1715, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x1716, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1732, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1734, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x1735, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1752, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1754, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1772, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1774, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x17b4, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x17b6, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x17b7, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x17be, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x17c6, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x17c7, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x17c9, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x17d4, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x17dd, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x17de, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x180b, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x180e, GraphemeClusterBreak::Control),
+        GraphemeBreakRun(0x180f, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1810, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1885, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1887, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x18a9, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x18aa, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1920, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1923, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x1927, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1929, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x192c, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1930, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x1932, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1933, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x1939, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x193c, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1a17, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1a19, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x1a1b, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1a1c, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1a55, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x1a56, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1a57, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x1a58, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1a5f, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1a60, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1a61, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1a62, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1a63, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1a65, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1a6d, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x1a73, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1a7d, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1a7f, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1a80, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1ab0, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1acf, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1b00, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1b04, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x1b05, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1b34, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1b3b, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x1b3c, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1b3d, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x1b42, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1b43, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x1b45, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1b6b, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1b74, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1b80, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1b82, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x1b83, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1ba1, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x1ba2, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1ba6, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x1ba8, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1baa, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x1bab, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1bae, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1be6, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1be7, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x1be8, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1bea, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x1bed, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1bee, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x1bef, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1bf2, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x1bf4, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1c24, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x1c2c, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1c34, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x1c36, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1c38, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1cd0, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1cd3, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1cd4, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1ce1, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x1ce2, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1ce9, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1ced, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1cee, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1cf4, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1cf5, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1cf7, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x1cf8, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1cfa, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1dc0, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1e00, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x200b, GraphemeClusterBreak::Control),
+        GraphemeBreakRun(0x200c, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x200d, GraphemeClusterBreak::ZWJ),
+        GraphemeBreakRun(0x200e, GraphemeClusterBreak::Control),
+        GraphemeBreakRun(0x2010, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x2028, GraphemeClusterBreak::Control),
+        GraphemeBreakRun(0x202f, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x203c, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x203d, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x2049, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x204a, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x2060, GraphemeClusterBreak::Control),
+        GraphemeBreakRun(0x2070, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x20d0, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x20f1, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x2122, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x2123, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x2139, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x213a, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x2194, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x219a, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x21a9, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x21ab, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x231a, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x231c, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x2328, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x2329, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x2388, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x2389, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x23cf, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x23d0, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x23e9, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x23f4, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x23f8, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x23fb, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x24c2, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x24c3, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x25aa, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x25ac, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x25b6, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x25b7, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x25c0, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x25c1, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x25fb, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x25ff, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x2600, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x2606, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x2607, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x2613, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x2614, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x2686, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x2690, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x2706, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x2708, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x2713, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x2714, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x2715, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x2716, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x2717, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x271d, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x271e, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x2721, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x2722, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x2728, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x2729, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x2733, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x2735, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x2744, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x2745, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x2747, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x2748, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x274c, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x274d, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x274e, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x274f, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x2753, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x2756, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x2757, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x2758, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x2763, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x2768, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x2795, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x2798, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x27a1, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x27a2, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x27b0, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x27b1, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x27bf, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x27c0, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x2934, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x2936, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x2b05, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x2b08, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x2b1b, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x2b1d, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x2b50, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x2b51, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x2b55, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x2b56, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x2cef, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x2cf2, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x2d7f, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x2d80, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x2de0, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x2e00, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x302a, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x3030, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x3031, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x303d, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x303e, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x3099, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x309b, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x3297, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x3298, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x3299, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x329a, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xa66f, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xa673, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xa674, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xa67e, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xa69e, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xa6a0, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xa6f0, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xa6f2, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xa802, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xa803, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xa806, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xa807, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xa80b, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xa80c, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xa823, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0xa825, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xa827, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0xa828, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xa82c, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xa82d, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xa880, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0xa882, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xa8b4, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0xa8c4, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xa8c6, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xa8e0, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xa8f2, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xa8ff, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xa900, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xa926, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xa92e, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xa947, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xa952, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0xa954, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xa960, GraphemeClusterBreak::L),
+        GraphemeBreakRun(0xa97d, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xa980, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xa983, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0xa984, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xa9b3, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xa9b4, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0xa9b6, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xa9ba, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0xa9bc, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xa9be, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0xa9c1, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xa9e5, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xa9e6, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xaa29, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xaa2f, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0xaa31, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xaa33, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0xaa35, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xaa37, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xaa43, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xaa44, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xaa4c, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xaa4d, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0xaa4e, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xaa7c, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xaa7d, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xaab0, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xaab1, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xaab2, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xaab5, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xaab7, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xaab9, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xaabe, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xaac0, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xaac1, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xaac2, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xaaeb, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0xaaec, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xaaee, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0xaaf0, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xaaf5, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0xaaf6, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xaaf7, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xabe3, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0xabe5, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xabe6, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0xabe8, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xabe9, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0xabeb, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xabec, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0xabed, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xabee, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xac00, GraphemeClusterBreak::LV),
+        GraphemeBreakRun(0xd7a4, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xd7b0, GraphemeClusterBreak::V),
+        GraphemeBreakRun(0xd7c7, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xd7cb, GraphemeClusterBreak::T),
+        GraphemeBreakRun(0xd7fc, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xd800, GraphemeClusterBreak::Control),
+        GraphemeBreakRun(0xe000, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xfb1e, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xfb1f, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xfe00, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xfe10, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xfe20, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xfe30, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xfeff, GraphemeClusterBreak::Control),
+        GraphemeBreakRun(0xff00, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xff9e, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xffa0, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xfff0, GraphemeClusterBreak::Control),
+        GraphemeBreakRun(0xfffc, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x101fd, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x101fe, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x102e0, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x102e1, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x10376, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1037b, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x10a01, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x10a04, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x10a05, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x10a07, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x10a0c, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x10a10, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x10a38, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x10a3b, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x10a3f, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x10a40, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x10ae5, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x10ae7, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x10d24, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x10d28, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x10eab, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x10ead, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x10f46, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x10f51, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x10f82, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x10f86, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x11000, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x11001, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x11002, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x11003, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x11038, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x11047, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x11070, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x11071, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x11073, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x11075, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1107f, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x11082, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x11083, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x110b0, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x110b3, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x110b7, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x110b9, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x110bb, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x110bd, GraphemeClusterBreak::Prepend),
+        GraphemeBreakRun(0x110be, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x110c2, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x110c3, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x110cd, GraphemeClusterBreak::Prepend),
+        GraphemeBreakRun(0x110ce, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x11100, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x11103, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x11127, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1112c, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x1112d, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x11135, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x11145, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x11147, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x11173, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x11174, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x11180, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x11182, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x11183, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x111b3, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x111b6, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x111bf, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x111c1, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x111c2, GraphemeClusterBreak::Prepend),
+        GraphemeBreakRun(0x111c4, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x111c9, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x111cd, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x111ce, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x111cf, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x111d0, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1122c, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x1122f, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x11232, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x11234, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x11235, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x11236, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x11238, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1123e, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1123f, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x112df, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x112e0, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x112e3, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x112eb, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x11300, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x11302, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x11304, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1133b, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1133d, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1133e, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1133f, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x11340, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x11341, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x11345, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x11347, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x11349, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1134b, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x1134e, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x11357, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x11358, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x11362, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x11364, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x11366, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1136d, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x11370, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x11375, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x11435, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x11438, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x11440, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x11442, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x11445, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x11446, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x11447, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1145e, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1145f, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x114b0, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x114b1, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x114b3, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x114b9, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x114ba, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x114bb, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x114bd, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x114be, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x114bf, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x114c1, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x114c2, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x114c4, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x115af, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x115b0, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x115b2, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x115b6, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x115b8, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x115bc, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x115be, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x115bf, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x115c1, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x115dc, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x115de, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x11630, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x11633, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1163b, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x1163d, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1163e, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x1163f, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x11641, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x116ab, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x116ac, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x116ad, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x116ae, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x116b0, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x116b6, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x116b7, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x116b8, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1171d, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x11720, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x11722, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x11726, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x11727, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1172c, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1182c, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x1182f, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x11838, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x11839, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1183b, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x11930, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x11931, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x11936, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x11937, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x11939, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1193b, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1193d, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x1193e, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1193f, GraphemeClusterBreak::Prepend),
+        GraphemeBreakRun(0x11940, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x11941, GraphemeClusterBreak::Prepend),
+        GraphemeBreakRun(0x11942, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x11943, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x11944, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x119d1, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x119d4, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x119d8, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x119da, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x119dc, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x119e0, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x119e1, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x119e4, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x119e5, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x11a01, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x11a0b, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x11a33, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x11a39, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x11a3a, GraphemeClusterBreak::Prepend),
+        GraphemeBreakRun(0x11a3b, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x11a3f, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x11a47, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x11a48, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x11a51, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x11a57, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x11a59, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x11a5c, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x11a84, GraphemeClusterBreak::Prepend),
+        GraphemeBreakRun(0x11a8a, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x11a97, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x11a98, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x11a9a, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x11c2f, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x11c30, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x11c37, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x11c38, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x11c3e, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x11c3f, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x11c40, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x11c92, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x11ca8, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x11ca9, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x11caa, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x11cb1, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x11cb2, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x11cb4, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x11cb5, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x11cb7, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x11d31, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x11d37, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x11d3a, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x11d3b, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x11d3c, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x11d3e, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x11d3f, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x11d46, GraphemeClusterBreak::Prepend),
+        GraphemeBreakRun(0x11d47, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x11d48, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x11d8a, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x11d8f, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x11d90, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x11d92, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x11d93, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x11d95, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x11d96, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x11d97, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x11d98, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x11ef3, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x11ef5, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x11ef7, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x13430, GraphemeClusterBreak::Control),
+        GraphemeBreakRun(0x13439, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x16af0, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x16af5, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x16b30, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x16b37, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x16f4f, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x16f50, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x16f51, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x16f88, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x16f8f, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x16f93, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x16fe4, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x16fe5, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x16ff0, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x16ff2, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1bc9d, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1bc9f, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1bca0, GraphemeClusterBreak::Control),
+        GraphemeBreakRun(0x1bca4, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1cf00, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1cf2e, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1cf30, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1cf47, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1d165, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1d166, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x1d167, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1d16a, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1d16d, GraphemeClusterBreak::SpacingMark),
+        GraphemeBreakRun(0x1d16e, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1d173, GraphemeClusterBreak::Control),
+        GraphemeBreakRun(0x1d17b, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1d183, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1d185, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1d18c, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1d1aa, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1d1ae, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1d242, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1d245, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1da00, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1da37, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1da3b, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1da6d, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1da75, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1da76, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1da84, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1da85, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1da9b, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1daa0, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1daa1, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1dab0, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1e000, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1e007, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1e008, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1e019, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1e01b, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1e022, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1e023, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1e025, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1e026, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1e02b, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1e130, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1e137, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1e2ae, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1e2af, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1e2ec, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1e2f0, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1e8d0, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1e8d7, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1e944, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1e94b, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1f000, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x1f100, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1f10d, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x1f110, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1f12f, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x1f130, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1f16c, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x1f172, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1f17e, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x1f180, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1f18e, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x1f18f, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1f191, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x1f19b, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1f1ad, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x1f1e6, GraphemeClusterBreak::RegionalIndicator),
+        GraphemeBreakRun(0x1f200, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1f201, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x1f210, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1f21a, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x1f21b, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1f22f, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x1f230, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1f232, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x1f23b, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1f23c, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x1f240, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1f249, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x1f3fb, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0x1f400, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x1f53e, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1f546, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x1f650, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1f680, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x1f700, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1f774, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x1f780, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1f7d5, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x1f800, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1f80c, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x1f810, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1f848, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x1f850, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1f85a, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x1f860, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1f888, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x1f890, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1f8ae, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x1f900, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1f90c, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x1f93b, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1f93c, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x1f946, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1f947, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x1fb00, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0x1fc00, GraphemeClusterBreak::ExtendedPictographic),
+        GraphemeBreakRun(0x1fffe, GraphemeClusterBreak::Other),
+        GraphemeBreakRun(0xe0000, GraphemeClusterBreak::Control),
+        GraphemeBreakRun(0xe0020, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xe0080, GraphemeClusterBreak::Control),
+        GraphemeBreakRun(0xe0100, GraphemeClusterBreak::Extend),
+        GraphemeBreakRun(0xe01f0, GraphemeClusterBreak::Control),
+        GraphemeBreakRun(0xe1000, GraphemeClusterBreak::Other),
+    };
+}
+
+// Routine Description:
+// - Returns the Grapheme_Cluster_Break property of a codepoint, or
+//   ExtendedPictographic if it has the Extended_Pictographic property.
+// Arguments:
+// - codepoint - the codepoint to look up
+// Return Value:
+// - the property of the codepoint
+GraphemeClusterBreak GraphemeSegmenter::GetBreakProperty(const char32_t codepoint) noexcept
+{
+    // Latin-1 is common enough to be worth not looking it up in the table.
+    if (codepoint < 0x300)
+    {
+        if (codepoint >= 0x20 && codepoint < 0x7F)
+        {
+            return GraphemeClusterBreak::Other;
+        }
+        switch (codepoint)
+        {
+        case 0x0D:
+            return GraphemeClusterBreak::CR;
+        case 0x0A:
+            return GraphemeClusterBreak::LF;
+        case 0xA9: // COPYRIGHT SIGN
+        case 0xAE: // REGISTERED SIGN
+            return GraphemeClusterBreak::ExtendedPictographic;
+        case 0xAD: // SOFT HYPHEN
+            return GraphemeClusterBreak::Control;
+        default:
+            return codepoint < 0xA0 ? GraphemeClusterBreak::Control : GraphemeClusterBreak::Other;
+        }
+    }
+
+    return _LookupTable(codepoint);
+}
+
+GraphemeClusterBreak GraphemeSegmenter::_LookupTable(const char32_t codepoint) noexcept
+{
+    // Find the last run starting at or before the codepoint. The table starts at 0,
+    // so there always is one. The property bits are all set in the search key,
+    // so that a run starting at the codepoint itself compares as less or equal.
+    const auto key = static_cast<uint32_t>(codepoint) << 8 | 0xFF;
+    const auto it = std::upper_bound(s_graphemeBreakTable.begin(), s_graphemeBreakTable.end(), key) - 1;
+    const auto value = static_cast<GraphemeClusterBreak>(*it & 0xFF);
+
+    if (value == GraphemeClusterBreak::LV && codepoint >= HangulSyllableFirst && codepoint <= HangulSyllableLast &&
+        (codepoint - HangulSyllableFirst) % HangulTCount != 0)
+    {
+        return GraphemeClusterBreak::LVT;
+    }
+    return value;
+}
+
+// Routine Description:
+// - Decodes the codepoint at the given offset, and advances the offset past it.
+//   Unpaired surrogates are returned as is.
+char32_t GraphemeSegmenter::_DecodeAt(const std::wstring_view text, size_t& offset) noexcept
+{
+    const auto wch = til::at(text, offset++);
+    if (Utf16Parser::IsLeadingSurrogate(wch) && offset < text.size() && Utf16Parser::IsTrailingSurrogate(til::at(text, offset)))
+    {
+        const auto trailing = til::at(text, offset++);
+        return 0x10000 + ((static_cast<char32_t>(wch) & 0x3FF) << 10 | (static_cast<char32_t>(trailing) & 0x3FF));
+    }
+    return wch;
+}
+
+// Routine Description:
+// - Finds the end of the grapheme cluster starting at the given offset.
+// - Only the text from the offset on is looked at, so the offset should be
+//   a cluster boundary itself (0, or a value returned by this function).
+// Arguments:
+// - text - the text to segment
+// - offset - where the cluster starts
+// Return Value:
+// - the offset past the last code unit of the cluster. offset if it's at the end of the text.
+size_t GraphemeSegmenter::NextBoundary(const std::wstring_view text, const size_t offset) noexcept
+{
+    if (offset >= text.size())
+    {
+        return text.size();
+    }
+
+    auto end = offset;
+    auto previous = GetBreakProperty(_DecodeAt(text, end));
+    // GB11: whether we're in ExtendedPictographic Extend* (and after ZWJ, if previous == ZWJ).
+    auto inEmojiSequence = previous == GraphemeClusterBreak::ExtendedPictographic;
+    // GB12/GB13: the number of regional indicators in a row.
+    size_t regionalIndicators = previous == GraphemeClusterBreak::RegionalIndicator ? 1 : 0;
+
+    while (end < text.size())
+    {
+        auto next = end;
+        const auto current = GetBreakProperty(_DecodeAt(text, next));
+
+        bool join;
+        if (previous == GraphemeClusterBreak::CR)
+        {
+            // GB3, GB4
+            join = current == GraphemeClusterBreak::LF;
+        }
+        else if (previous == GraphemeClusterBreak::LF || previous == GraphemeClusterBreak::Control ||
+                 current == GraphemeClusterBreak::CR || current == GraphemeClusterBreak::LF || current == GraphemeClusterBreak::Control)
+        {
+            // GB4, GB5
+            join = false;
+        }
+        else if (previous == GraphemeClusterBreak::L)
+        {
+            // GB6
+            join = current == GraphemeClusterBreak::L || current == GraphemeClusterBreak::V ||
+                   current == GraphemeClusterBreak::LV || current == GraphemeClusterBreak::LVT;
+        }
+        else if ((previous == GraphemeClusterBreak::LV || previous == GraphemeClusterBreak::V) &&
+                 (current == GraphemeClusterBreak::V || current == GraphemeClusterBreak::T))
+        {
+            // GB7
+            join = true;
+        }
+        else if ((previous == GraphemeClusterBreak::LVT || previous == GraphemeClusterBreak::T) && current == GraphemeClusterBreak::T)
+        {
+            // GB8
+            join = true;
+        }
+        else if (current == GraphemeClusterBreak::Extend || current == GraphemeClusterBreak::ZWJ ||
+                 current == GraphemeClusterBreak::SpacingMark || previous == GraphemeClusterBreak::Prepend)
+        {
+            // GB9, GB9a, GB9b
+            join = true;
+        }
+        else if (previous == GraphemeClusterBreak::ZWJ && current == GraphemeClusterBreak::ExtendedPictographic)
+        {
+            // GB11
+            join = inEmojiSequence;
+        }
+        else if (previous == GraphemeClusterBreak::RegionalIndicator && current == GraphemeClusterBreak::RegionalIndicator)
+        {
+            // GB12, GB13
+            join = regionalIndicators % 2 == 1;
+        }
+        else
+        {
+            // GB999
+            join = false;
+        }
+
+        if (!join)
+        {
+            break;
+        }
+
+        if (current == GraphemeClusterBreak::ExtendedPictographic)
+        {
+            inEmojiSequence = true;
+        }
+        else if (current != GraphemeClusterBreak::Extend && current != GraphemeClusterBreak::ZWJ)
+        {
+            inEmojiSequence = false;
+        }
+        else if (previous == GraphemeClusterBreak::ZWJ)
+        {
+            // ZWJ must be followed by the pictograph directly.
+            inEmojiSequence = false;
+        }
+        regionalIndicators = current == GraphemeClusterBreak::RegionalIndicator ? regionalIndicators + 1 : 0;
+
+        previous = current;
+        end = next;
+    }
+
+    return end;
+}
+
+// Routine Description:
+// - Returns the first grapheme cluster of the given text.
+// Arguments:
+// - text - the text to segment
+// Return Value:
+// - a view of the first cluster of text. Empty if text is.
+std::wstring_view GraphemeSegmenter::NextCluster(const std::wstring_view text) noexcept
+{
+    return text.substr(0, NextBoundary(text, 0));
+}
+
+// Routine Description:
+// - Splits the given text into grapheme clusters, appending them to the given vector.
+// - A printable ASCII character followed by another (or the end of the text)
+//   is always a cluster of its own, so plain text only takes a comparison or
+//   two per character.
+// Arguments:
+// - text - the text to segment
+// - clusters - receives views into text, which thus must outlive them
+// Return Value:
+// - <none>
+void GraphemeSegmenter::Segment(const std::wstring_view text, std::vector<std::wstring_view>& clusters)
+{
+    size_t offset = 0;
+    while (offset < text.size())
+    {
+        const auto wch = til::at(text, offset);
+        if (wch >= L' ' && wch <= L'~' && (offset + 1 == text.size() || til::at(text, offset + 1) < 0x80))
+        {
+            clusters.emplace_back(text.substr(offset, 1));
+            ++offset;
+            continue;
+        }
+
+        const auto end = NextBoundary(text, offset);
+        clusters.emplace_back(text.substr(offset, end - offset));
+        offset = end;
+    }
+}
+
+// Routine Description:
+// - Splits the given text into grapheme clusters. See above.
+// Arguments:
+// - text - the text to segment
+// Return Value:
+// - views of the clusters of text, which thus must outlive them
+std::vector<std::wstring_view> GraphemeSegmenter::Segment(const std::wstring_view text)
+{
+    std::vector<std::wstring_view> clusters;
+    // Most text doesn't combine anything, so this is rarely too much.
+    clusters.reserve(text.size());
+    Segment(text, clusters);
+    return clusters;
+}
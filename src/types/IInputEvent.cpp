@@ -6,6 +6,76 @@
 
 #include <unordered_map>
 
+// Key and mouse events make up nearly all input traffic; make sure they're pooled.
+static_assert(sizeof(KeyEvent) <= 64 && sizeof(MouseEvent) <= 64);
+static_assert(sizeof(SLIST_ENTRY) <= 64);
+
+// Routine Description:
+// - Returns the lock-free list of recycled event blocks.
+static SLIST_HEADER& _GetEventPool() noexcept
+{
+    static SLIST_HEADER pool = []() noexcept {
+        SLIST_HEADER header;
+        InitializeSListHead(&header);
+        return header;
+    }();
+    return pool;
+}
+
+// Routine Description:
+// - Allocates storage for an event. Events small enough to fit into a pool block
+//   reuse a previously freed block when one is available.
+// Arguments:
+// - size - size of the event being allocated
+// Return Value:
+// - pointer to the storage. Will throw std::bad_alloc on failure.
+void* IInputEvent::operator new(size_t size)
+{
+    if (size > s_poolBlockSize)
+    {
+        return ::operator new(size);
+    }
+
+    if (const auto entry = InterlockedPopEntrySList(&_GetEventPool()))
+    {
+        return entry;
+    }
+
+    if (const auto block = _aligned_malloc(s_poolBlockSize, MEMORY_ALLOCATION_ALIGNMENT))
+    {
+        return block;
+    }
+    throw std::bad_alloc{};
+}
+
+// Routine Description:
+// - Releases storage allocated by IInputEvent::operator new. Pool blocks are
+//   kept for reuse until the pool holds s_maxPooledBlocks of them.
+// Arguments:
+// - p - storage to release
+// - size - size of the event that was destroyed
+void IInputEvent::operator delete(void* p, size_t size) noexcept
+{
+    if (!p)
+    {
+        return;
+    }
+
+    if (size > s_poolBlockSize)
+    {
+        ::operator delete(p);
+        return;
+    }
+
+    auto& pool = _GetEventPool();
+    if (QueryDepthSList(&pool) < s_maxPooledBlocks)
+    {
+        InterlockedPushEntrySList(&pool, static_cast<PSLIST_ENTRY>(p));
+        return;
+    }
+    _aligned_free(p);
+}
+
 std::unique_ptr<IInputEvent> IInputEvent::Create(const INPUT_RECORD& record)
 {
     switch (record.EventType)
@@ -46,6 +46,13 @@ CATCH_RETURN();
 [[nodiscard]] HRESULT ScreenInfoUiaProviderBase::Signal(_In_ EVENTID eventId)
 {
     HRESULT hr = S_OK;
+
+    // Raising an event is expensive even when nobody receives it.
+    if (!UiaClientsAreListening())
+    {
+        return hr;
+    }
+
     // check to see if we're already firing this particular event
     if (_signalFiringMapping.find(eventId) != _signalFiringMapping.end() &&
         _signalFiringMapping[eventId] == true)
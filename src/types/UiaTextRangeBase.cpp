@@ -981,7 +981,28 @@ std::wstring UiaTextRangeBase::_getTextValue(std::optional<unsigned int> maxLeng
         auto inclusiveEnd = _end;
         bufferSize.DecrementInBounds(inclusiveEnd, true);
 
-        const auto textRects = buffer.GetTextRects(_start, inclusiveEnd, _blockRange, true);
+        auto textRects = buffer.GetTextRects(_start, inclusiveEnd, _blockRange, true);
+
+        // Every cell holds at least half a character (a wide glyph spans two cells),
+        // so we can tell which rows can't make it into maxLength and skip reading them.
+        // Screen readers commonly ask for a few characters of a range spanning the whole buffer.
+        if (maxLength.has_value())
+        {
+            size_t minimumLength = 0;
+            auto rowsNeeded = textRects.size();
+            for (size_t i = 0; i < textRects.size(); ++i)
+            {
+                if (minimumLength >= *maxLength)
+                {
+                    rowsNeeded = i;
+                    break;
+                }
+                const auto& rect = til::at(textRects, i);
+                minimumLength += (gsl::narrow_cast<size_t>(rect.Right - rect.Left) + 2) / 2;
+            }
+            textRects.resize(rowsNeeded);
+        }
+
         const auto bufferData = buffer.GetText(true,
                                                false,
                                                textRects);
@@ -994,7 +1015,7 @@ std::wstring UiaTextRangeBase::_getTextValue(std::optional<unsigned int> maxLeng
         }
     }
 
-    if (maxLength.has_value())
+    if (maxLength.has_value() && textData.size() > *maxLength)
     {
         textData.resize(*maxLength);
     }
@@ -60,32 +60,33 @@ std::wstring_view Utf16Parser::ParseNext(std::wstring_view wstr) noexcept
 // Arguments:
 // - wstr - the string to parse
 // Return Value:
-// - a vector of utf16 codepoints. glyphs that require surrogate pairs will be grouped
-// together in a vector and codepoints that use only one wchar will be in a vector by themselves.
-std::vector<std::vector<wchar_t>> Utf16Parser::Parse(std::wstring_view wstr)
+// - a vector of utf16 codepoints as views into wstr, which thus must outlive the result.
+//   glyphs that require surrogate pairs will be a view of both code units
+//   and codepoints that use only one wchar will be a view of just that one.
+std::vector<std::wstring_view> Utf16Parser::Parse(std::wstring_view wstr)
 {
-    std::vector<std::vector<wchar_t>> result;
-    std::vector<wchar_t> sequence;
-    for (const auto wch : wstr)
+    std::vector<std::wstring_view> result;
+    // Most text doesn't contain surrogate pairs, so this is rarely too much.
+    result.reserve(wstr.size());
+
+    for (size_t pos = 0; pos < wstr.size(); ++pos)
     {
+        const auto wch = til::at(wstr, pos);
+
         if (IsLeadingSurrogate(wch))
         {
-            sequence.clear();
-            sequence.push_back(wch);
-        }
-        else if (IsTrailingSurrogate(wch))
-        {
-            if (!sequence.empty())
+            // A leading surrogate is only valid if it's directly followed by a trailing one.
+            if (pos + 1 < wstr.size() && IsTrailingSurrogate(til::at(wstr, pos + 1)))
             {
-                sequence.push_back(wch);
-                result.push_back(sequence);
-                sequence.clear();
+                result.emplace_back(wstr.substr(pos, 2));
+                ++pos;
             }
         }
-        else
+        else if (!IsTrailingSurrogate(wch))
         {
-            result.push_back({ wch });
+            result.emplace_back(wstr.substr(pos, 1));
         }
     }
+
     return result;
 }
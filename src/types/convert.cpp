@@ -8,6 +8,46 @@
 
 #pragma hdrstop
 
+// Routine Description:
+// - Determines whether the given codepage encodes U+0000 to U+007F as the bytes 0x00 to 0x7F and vice versa.
+//   Text consisting of ASCII only can be converted from and to these codepages by widening or narrowing it.
+//   This is true for the OEM and ANSI codepages console users typically run with, but not for all of them
+//   (for instance EBCDIC, ISO-2022 or UTF-7), so it's only claimed for the ones listed here.
+// Arguments:
+// - codepage - Windows Code Page
+// Return Value:
+// - true if ASCII maps to itself in the codepage
+[[nodiscard]] bool IsAsciiCompatibleCodepage(const UINT codepage) noexcept
+{
+    switch (codepage)
+    {
+    case 437: // OEM United States
+    case 850: // OEM Multilingual Latin 1
+    case 852: // OEM Latin 2
+    case 858: // OEM Multilingual Latin 1 + Euro
+    case 866: // OEM Russian
+    case 932: // Japanese Shift-JIS
+    case 936: // Simplified Chinese GBK
+    case 949: // Korean
+    case 950: // Traditional Chinese Big5
+    case 1250:
+    case 1251:
+    case 1252:
+    case 1253:
+    case 1254:
+    case 1255:
+    case 1256:
+    case 1257:
+    case 1258: // ANSI
+    case 20127: // US-ASCII
+    case 28591: // ISO 8859-1
+    case CP_UTF8:
+        return true;
+    default:
+        return false;
+    }
+}
+
 // Routine Description:
 // - Takes a multibyte string, allocates the appropriate amount of memory for the conversion, performs the conversion,
 //   and returns the Unicode UTF-16 result in the smart pointer (and the length).
@@ -19,16 +59,55 @@
 // - NOTE: Throws suitable HRESULT errors from memory allocation, safe math, or MultiByteToWideChar failures.
 [[nodiscard]] std::wstring ConvertToW(const UINT codePage, const std::string_view source)
 {
+    std::wstring out;
+    ConvertToW(codePage, source, out);
+    return out;
+}
+
+// Routine Description:
+// - Like ConvertToW above, but writes the result into the given string, so that callers
+//   converting text repeatedly can reuse its memory.
+// - Leading ASCII is widened directly (if the codepage permits it) and the rest is
+//   converted with a single call to MultiByteToWideChar.
+// Arguments:
+// - codepage - Windows Code Page representing the multibyte source text
+// - source - View of multibyte characters of source text
+// - out - Receives the UTF-16 wide string. Its previous contents are discarded.
+// Return Value:
+// - <none>
+// - NOTE: Throws suitable HRESULT errors from memory allocation, safe math, or MultiByteToWideChar failures.
+void ConvertToW(const UINT codePage, const std::string_view source, std::wstring& out)
+{
+    out.clear();
+
     // If there's nothing to convert, bail early.
     if (source.empty())
     {
-        return {};
+        return;
     }
 
     int iSource; // convert to int because Mb2Wc requires it.
     THROW_IF_FAILED(SizeTToInt(source.size(), &iSource));
 
-    // Ask how much space we will need.
+    // No codepage turns a byte into more than one UTF-16 code unit,
+    // so a buffer as long as the source suffices.
+    out.resize(source.size());
+
+    // A run of ASCII at the start only ever consists of complete characters,
+    // so the rest of the source can be converted on its own.
+    size_t ascii = 0;
+    if (IsAsciiCompatibleCodepage(codePage))
+    {
+        ascii = til::details::u8u16ascii(source.data(), source.size(), out.data());
+        if (ascii == source.size())
+        {
+            return;
+        }
+    }
+
+    const auto rest = source.substr(ascii);
+    const auto iRest = gsl::narrow_cast<int>(rest.size());
+
     // In certain codepages, Mb2Wc will "successfully" produce zero characters (like in CP50220, where a SHIFT-IN character
     // is consumed but not transformed into anything) without explicitly failing. When it does this, GetLastError will return
     // the last error encountered by the last function that actually did have an error.
@@ -36,21 +115,20 @@
     // difference that we **don't actually care about** between failing and successfully producing zero characters.,
     // Anyway: we need to clear the last error so that we can fail out and IGNORE_BAD_GLE after it inevitably succeed-fails.
     SetLastError(0);
-    int const iTarget = MultiByteToWideChar(codePage, 0, source.data(), iSource, nullptr, 0);
+    auto iTarget = MultiByteToWideChar(codePage, 0, rest.data(), iRest, out.data() + ascii, iRest);
+    if (0 == iTarget && GetLastError() == ERROR_INSUFFICIENT_BUFFER)
+    {
+        // Just in case a codepage proves the assumption above wrong: ask how much space we need after all.
+        iTarget = MultiByteToWideChar(codePage, 0, rest.data(), iRest, nullptr, 0);
+        THROW_LAST_ERROR_IF(0 == iTarget);
+        out.resize(ascii + iTarget);
+        iTarget = MultiByteToWideChar(codePage, 0, rest.data(), iRest, out.data() + ascii, iTarget);
+    }
     THROW_LAST_ERROR_IF_AND_IGNORE_BAD_GLE(0 == iTarget);
 
-    size_t cchNeeded;
-    THROW_IF_FAILED(IntToSizeT(iTarget, &cchNeeded));
-
-    // Allocate ourselves some space
-    std::wstring out;
-    out.resize(cchNeeded);
-
-    // Attempt conversion for real.
-    THROW_LAST_ERROR_IF_AND_IGNORE_BAD_GLE(0 == MultiByteToWideChar(codePage, 0, source.data(), iSource, out.data(), iTarget));
-
-    // Return as a string
-    return out;
+    size_t cchConverted;
+    THROW_IF_FAILED(IntToSizeT(iTarget, &cchConverted));
+    out.resize(ascii + cchConverted);
 }
 
 // Routine Description:
@@ -64,37 +142,82 @@
 // - NOTE: Throws suitable HRESULT errors from memory allocation, safe math, or MultiByteToWideChar failures.
 [[nodiscard]] std::string ConvertToA(const UINT codepage, const std::wstring_view source)
 {
+    std::string out;
+    ConvertToA(codepage, source, out);
+    return out;
+}
+
+// Routine Description:
+// - Like ConvertToA above, but writes the result into the given string, so that callers
+//   converting text repeatedly can reuse its memory.
+// - Leading ASCII is narrowed directly (if the codepage permits it) and the rest is
+//   converted with a single call to WideCharToMultiByte in the common case.
+// Arguments:
+// - codepage - Windows Code Page representing the multibyte destination text
+// - source - Unicode (UTF-16) characters of source text
+// - out - Receives the multibyte string. Its previous contents are discarded.
+// Return Value:
+// - <none>
+// - NOTE: Throws suitable HRESULT errors from memory allocation, safe math, or WideCharToMultiByte failures.
+void ConvertToA(const UINT codepage, const std::wstring_view source, std::string& out)
+{
+    out.clear();
+
     // If there's nothing to convert, bail early.
     if (source.empty())
     {
-        return {};
+        return;
     }
 
     int iSource; // convert to int because Wc2Mb requires it.
     THROW_IF_FAILED(SizeTToInt(source.size(), &iSource));
 
-    // Ask how much space we will need.
-    // clang-format off
-#pragma prefast(suppress: __WARNING_W2A_BEST_FIT, "WC_NO_BEST_FIT_CHARS doesn't work in many codepages. Retain old behavior.")
-    // clang-format on
-    int const iTarget = WideCharToMultiByte(codepage, 0, source.data(), iSource, nullptr, 0, nullptr, nullptr);
-    THROW_LAST_ERROR_IF(0 == iTarget);
+    size_t ascii = 0;
+    if (IsAsciiCompatibleCodepage(codepage))
+    {
+        out.resize(source.size());
+        ascii = til::details::u16u8ascii(source.data(), source.size(), out.data());
+        if (ascii == source.size())
+        {
+            return;
+        }
+    }
 
-    size_t cchNeeded;
-    THROW_IF_FAILED(IntToSizeT(iTarget, &cchNeeded));
+    const auto rest = source.substr(ascii);
+    const auto iRest = gsl::narrow_cast<int>(rest.size());
 
-    // Allocate ourselves some space
-    std::string out;
-    out.resize(cchNeeded);
+    // A UTF-16 code unit takes up to 3 bytes in UTF-8 and up to 2 in the DBCS codepages.
+    // Guess that much space and only ask for the exact amount if that wasn't enough.
+    const size_t bytesPerUnit = codepage == CP_UTF8 ? 3 : 2;
+    size_t cbGuess;
+    THROW_IF_FAILED(SizeTMult(rest.size(), bytesPerUnit, &cbGuess));
+    int iGuess;
+    THROW_IF_FAILED(SizeTToInt(cbGuess, &iGuess));
+    out.resize(ascii + cbGuess);
 
-    // Attempt conversion for real.
     // clang-format off
 #pragma prefast(suppress: __WARNING_W2A_BEST_FIT, "WC_NO_BEST_FIT_CHARS doesn't work in many codepages. Retain old behavior.")
     // clang-format on
-    THROW_LAST_ERROR_IF(0 == WideCharToMultiByte(codepage, 0, source.data(), iSource, out.data(), iTarget, nullptr, nullptr));
+    auto iTarget = WideCharToMultiByte(codepage, 0, rest.data(), iRest, out.data() + ascii, iGuess, nullptr, nullptr);
+    if (0 == iTarget && GetLastError() == ERROR_INSUFFICIENT_BUFFER)
+    {
+        // clang-format off
+#pragma prefast(suppress: __WARNING_W2A_BEST_FIT, "WC_NO_BEST_FIT_CHARS doesn't work in many codepages. Retain old behavior.")
+        // clang-format on
+        iTarget = WideCharToMultiByte(codepage, 0, rest.data(), iRest, nullptr, 0, nullptr, nullptr);
+        THROW_LAST_ERROR_IF(0 == iTarget);
+        out.resize(ascii + iTarget);
 
-    // Return as a string
-    return out;
+        // clang-format off
+#pragma prefast(suppress: __WARNING_W2A_BEST_FIT, "WC_NO_BEST_FIT_CHARS doesn't work in many codepages. Retain old behavior.")
+        // clang-format on
+        iTarget = WideCharToMultiByte(codepage, 0, rest.data(), iRest, out.data() + ascii, iTarget, nullptr, nullptr);
+    }
+    THROW_LAST_ERROR_IF(0 == iTarget);
+
+    size_t cchConverted;
+    THROW_IF_FAILED(IntToSizeT(iTarget, &cchConverted));
+    out.resize(ascii + cchConverted);
 }
 
 // Routine Description:
@@ -116,18 +239,31 @@
     int iSource; // convert to int because Wc2Mb requires it
     THROW_IF_FAILED(SizeTToInt(source.size(), &iSource));
 
-    // Ask how many bytes this string consumes in the other codepage
+    // Every ASCII character takes up exactly one byte, if the codepage permits it.
+    size_t ascii = 0;
+    if (IsAsciiCompatibleCodepage(codepage))
+    {
+        ascii = gsl::narrow_cast<size_t>(std::find_if(source.begin(), source.end(), [](const wchar_t wch) { return wch >= 0x80; }) - source.begin());
+        if (ascii == source.size())
+        {
+            return ascii;
+        }
+    }
+
+    const auto rest = source.substr(ascii);
+
+    // Ask how many bytes the rest of this string consumes in the other codepage
     // clang-format off
 #pragma prefast(suppress: __WARNING_W2A_BEST_FIT, "WC_NO_BEST_FIT_CHARS doesn't work in many codepages. Retain old behavior.")
     // clang-format on
-    int const iTarget = WideCharToMultiByte(codepage, 0, source.data(), iSource, nullptr, 0, nullptr, nullptr);
+    int const iTarget = WideCharToMultiByte(codepage, 0, rest.data(), gsl::narrow_cast<int>(rest.size()), nullptr, 0, nullptr, nullptr);
     THROW_LAST_ERROR_IF(0 == iTarget);
 
     // Convert types safely.
     size_t cchTarget;
     THROW_IF_FAILED(IntToSizeT(iTarget, &cchTarget));
 
-    return cchTarget;
+    return ascii + cchTarget;
 }
 
 // Routine Description:
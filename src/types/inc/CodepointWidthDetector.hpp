@@ -31,6 +31,7 @@ public:
     CodepointWidthDetector& operator=(CodepointWidthDetector&&) = delete;
 
     CodepointWidth GetWidth(const std::wstring_view glyph) const;
+    std::vector<CodepointWidth> GetWidths(const std::wstring_view text) const;
     bool IsWide(const std::wstring_view glyph) const;
     bool IsWide(const wchar_t wch) const noexcept;
     void SetFallbackMethod(std::function<bool(const std::wstring_view)> pfnFallback);
@@ -41,6 +42,7 @@ public:
 #endif
 
 private:
+    CodepointWidth _lookupBmpWidth(const wchar_t wch) const;
     CodepointWidth _lookupGlyphWidth(const std::wstring_view glyph) const;
     CodepointWidth _lookupGlyphWidthWithCache(const std::wstring_view glyph) const noexcept;
     bool _checkFallbackViaCache(const std::wstring_view glyph) const;
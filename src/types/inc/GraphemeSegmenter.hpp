@@ -0,0 +1,57 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- GraphemeSegmenter.hpp
+
+Abstract:
+- Splits UTF-16 text into extended grapheme clusters, following the rules of
+  UAX #29 (Unicode Text Segmentation). A cluster is what a user perceives
+  as a single character: a base with its combining marks, a Hangul syllable
+  made of jamo, an emoji ZWJ sequence, a flag made of two regional
+  indicators and so on.
+- The Grapheme_Cluster_Break and Extended_Pictographic properties are looked
+  up in a table generated by tools/Generate-GraphemeBreakTableFromUCD.ps1.
+  Printable ASCII and most of Latin-1 never combine with the text after them,
+  which Segment() uses to skip the lookup for runs of such text altogether.
+- Unpaired surrogates are clusters of their own.
+--*/
+
+#pragma once
+
+// The Grapheme_Cluster_Break property, with Extended_Pictographic (which only
+// ever applies to code points that are "Other" otherwise) folded into it.
+enum class GraphemeClusterBreak : uint8_t
+{
+    Other,
+    CR,
+    LF,
+    Control,
+    Extend,
+    ZWJ,
+    RegionalIndicator,
+    Prepend,
+    SpacingMark,
+    L,
+    V,
+    T,
+    LV,
+    LVT,
+    ExtendedPictographic,
+};
+
+class GraphemeSegmenter final
+{
+public:
+    static GraphemeClusterBreak GetBreakProperty(const char32_t codepoint) noexcept;
+
+    static size_t NextBoundary(const std::wstring_view text, const size_t offset) noexcept;
+    static std::wstring_view NextCluster(const std::wstring_view text) noexcept;
+    static void Segment(const std::wstring_view text, std::vector<std::wstring_view>& clusters);
+    static std::vector<std::wstring_view> Segment(const std::wstring_view text);
+
+private:
+    static char32_t _DecodeAt(const std::wstring_view text, size_t& offset) noexcept;
+    static GraphemeClusterBreak _LookupTable(const char32_t codepoint) noexcept;
+};
@@ -57,9 +57,18 @@ public:
 
     virtual InputEventType EventType() const noexcept = 0;
 
+    // Events are created and destroyed once per keystroke and mouse move.
+    // They're served from a small pool of fixed-size blocks instead of the heap.
+    static void* operator new(size_t size);
+    static void operator delete(void* p, size_t size) noexcept;
+
 #ifdef UNIT_TESTING
     friend std::wostream& operator<<(std::wostream& stream, const IInputEvent* const pEvent);
 #endif
+
+private:
+    static constexpr size_t s_poolBlockSize = 64;
+    static constexpr USHORT s_maxPooledBlocks = 1024;
 };
 
 inline IInputEvent::~IInputEvent()
@@ -25,6 +25,19 @@ namespace Microsoft::Console::Utils
 
     bool IsValidHandle(const HANDLE handle) noexcept;
 
+    // How eagerly the scheduler should run a thread, see SetThreadSchedulingPolicy.
+    enum class ThreadSchedulingPolicy
+    {
+        // Let the OS decide, like for any other thread.
+        Default,
+        // The thread serves what the user is interacting with right now.
+        Foreground,
+        // The thread serves something the user isn't looking at.
+        Background,
+    };
+
+    void SetThreadSchedulingPolicy(const HANDLE thread, const ThreadSchedulingPolicy policy) noexcept;
+
     // Function Description:
     // - Clamps a long in between `min` and `SHRT_MAX`
     // Arguments:
@@ -0,0 +1,60 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "WexTestClass.h"
+#include "../../inc/consoletaeftemplates.hpp"
+
+#include "../inc/convert.hpp"
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+class ConvertTests
+{
+    TEST_CLASS(ConvertTests);
+
+    TEST_METHOD(AsciiRoundTrips)
+    {
+        const std::string_view ascii{ "The quick brown fox jumps over the lazy dog.\r\n\x1b[0m" };
+        const std::wstring_view wide{ L"The quick brown fox jumps over the lazy dog.\r\n\x1b[0m" };
+
+        for (const UINT codepage : { 437u, 1252u, 932u, static_cast<UINT>(CP_UTF8) })
+        {
+            Log::Comment(NoThrowString().Format(L"codepage %u", codepage));
+            VERIFY_ARE_EQUAL(wide, std::wstring_view{ ConvertToW(codepage, ascii) });
+            VERIFY_ARE_EQUAL(ascii, std::string_view{ ConvertToA(codepage, wide) });
+            VERIFY_ARE_EQUAL(ascii.size(), GetALengthFromW(codepage, wide));
+        }
+    }
+
+    TEST_METHOD(MixedTextConvertsPastAscii)
+    {
+        // "abc" followed by U+00E9 and U+00FC, as encoded in 437, 1252 and UTF-8.
+        const std::wstring_view wide{ L"abc\u00e9\u00fc" };
+        VERIFY_ARE_EQUAL(wide, std::wstring_view{ ConvertToW(437, "abc\x82\x81") });
+        VERIFY_ARE_EQUAL(wide, std::wstring_view{ ConvertToW(1252, "abc\xe9\xfc") });
+        VERIFY_ARE_EQUAL(wide, std::wstring_view{ ConvertToW(CP_UTF8, "abc\xc3\xa9\xc3\xbc") });
+
+        VERIFY_ARE_EQUAL(std::string_view{ "abc\x82\x81" }, std::string_view{ ConvertToA(437, wide) });
+        VERIFY_ARE_EQUAL(std::string_view{ "abc\xc3\xa9\xc3\xbc" }, std::string_view{ ConvertToA(CP_UTF8, wide) });
+        VERIFY_ARE_EQUAL(size_t{ 7 }, GetALengthFromW(CP_UTF8, wide));
+
+        // U+6771 takes 3 bytes in UTF-8, more than the 2 we'd guess for the other codepages.
+        VERIFY_ARE_EQUAL(std::string_view{ "a\xe6\x9d\xb1\xe6\x9d\xb1" }, std::string_view{ ConvertToA(CP_UTF8, L"a\u6771\u6771") });
+    }
+
+    TEST_METHOD(ReusedBuffersDiscardTheirContents)
+    {
+        std::wstring wide{ L"previous" };
+        ConvertToW(CP_UTF8, "new", wide);
+        VERIFY_ARE_EQUAL(std::wstring_view{ L"new" }, std::wstring_view{ wide });
+        ConvertToW(CP_UTF8, {}, wide);
+        VERIFY_IS_TRUE(wide.empty());
+
+        std::string narrow{ "previous" };
+        ConvertToA(1252, L"new\u00e9", narrow);
+        VERIFY_ARE_EQUAL(std::string_view{ "new\xe9" }, std::string_view{ narrow });
+    }
+};
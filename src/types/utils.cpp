@@ -520,6 +520,46 @@ bool Utils::IsValidHandle(const HANDLE handle) noexcept
     return handle != nullptr && handle != INVALID_HANDLE_VALUE;
 }
 
+// Routine Description:
+// - Sets the priority and the power throttling (EcoQoS) of a thread.
+//   Foreground threads get a higher priority and opt out of power throttling,
+//   so that they stay on the fast cores. Background threads get a lower
+//   priority and opt into EcoQoS, which lets the OS run them on efficient
+//   cores at lower clock speeds.
+// - Power throttling needs Windows 10 1709 and EcoQoS Windows 11. On older
+//   versions only the priority changes, which is why failures are ignored.
+// Arguments:
+// - thread - the thread to change, with THREAD_SET_INFORMATION access
+// - policy - the policy to apply
+// Return Value:
+// - <none>
+void Utils::SetThreadSchedulingPolicy(const HANDLE thread, const ThreadSchedulingPolicy policy) noexcept
+{
+    auto priority = THREAD_PRIORITY_NORMAL;
+    THREAD_POWER_THROTTLING_STATE throttling{};
+    throttling.Version = THREAD_POWER_THROTTLING_CURRENT_VERSION;
+
+    switch (policy)
+    {
+    case ThreadSchedulingPolicy::Foreground:
+        priority = THREAD_PRIORITY_ABOVE_NORMAL;
+        // Controlling the flag but leaving it unset opts out of throttling.
+        throttling.ControlMask = THREAD_POWER_THROTTLING_EXECUTION_SPEED;
+        break;
+    case ThreadSchedulingPolicy::Background:
+        priority = THREAD_PRIORITY_BELOW_NORMAL;
+        throttling.ControlMask = THREAD_POWER_THROTTLING_EXECUTION_SPEED;
+        throttling.StateMask = THREAD_POWER_THROTTLING_EXECUTION_SPEED;
+        break;
+    default:
+        // Neither controlling nor setting the flag hands the decision back to the OS.
+        break;
+    }
+
+    SetThreadPriority(thread, priority);
+    SetThreadInformation(thread, ThreadPowerThrottling, &throttling, sizeof(throttling));
+}
+
 // Function Description:
 // - Generate a Version 5 UUID (specified in RFC4122 4.3)
 //   v5 UUIDs are stable given the same namespace and "name".
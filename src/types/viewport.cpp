@@ -249,38 +249,30 @@ Viewport Viewport::Clamp(const Viewport& other) const noexcept
 // - If False, we will restore the original position to the given coordinate.
 bool Viewport::MoveInBounds(const ptrdiff_t move, COORD& pos) const noexcept
 {
-    const auto backup = pos;
-    bool success = true; // If nothing happens, we're still successful (e.g. add = 0)
-
-    for (int i = 0; i < move; i++)
+    // If nothing happens, we're still successful (e.g. add = 0)
+    if (move == 0)
     {
-        success = IncrementInBounds(pos);
-
-        // If an operation fails, break.
-        if (!success)
-        {
-            break;
-        }
+        return true;
     }
 
-    for (int i = 0; i > move; i--)
-    {
-        success = DecrementInBounds(pos);
+    // Assert that the position given fits inside this viewport.
+    FAIL_FAST_IF(!IsInBounds(pos));
 
-        // If an operation fails, break.
-        if (!success)
-        {
-            break;
-        }
-    }
+    // Moving by repeated Increment/DecrementInBounds() calls is equivalent to
+    // moving the linear index of the position within the viewport. Callers move by
+    // entire fill lengths at once, so computing it directly avoids a loop per cell.
+    const ptrdiff_t width = Width();
+    const ptrdiff_t index = (pos.Y - Top()) * width + (pos.X - Left()) + move;
 
-    // If any operation failed, revert to backed up state.
-    if (!success)
+    // If we'd move outside, keep the original position.
+    if (index < 0 || index >= width * Height())
     {
-        pos = backup;
+        return false;
     }
 
-    return success;
+    pos.X = gsl::narrow_cast<SHORT>(Left() + index % width);
+    pos.Y = gsl::narrow_cast<SHORT>(Top() + index / width);
+    return true;
 }
 
 // Method Description:
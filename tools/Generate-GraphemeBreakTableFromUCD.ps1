@@ -0,0 +1,116 @@
+# Copyright (c) Microsoft Corporation.
+# Licensed under the MIT license.
+
+#Requires -Version 7
+
+################################################################################
+# This script generates an array suitable for replacing the body of
+# s_graphemeBreakTable in src/types/GraphemeSegmenter.cpp from a Unicode UCD
+# XML document[1] compliant with UAX#42[2].
+#
+# Every codepoint gets its Grapheme_Cluster_Break property (GCB), or
+# ExtendedPictographic if it has the Extended_Pictographic property (ExtPict)
+# instead. Runs of codepoints with the same property are merged, and only the
+# first codepoint of every run is emitted. The Hangul syllables alternate
+# between LV and LVT and are emitted as a single LV run; GraphemeSegmenter
+# tells them apart arithmetically.
+#
+# This script was developed against the flat "no han unification" UCD
+# "ucd.nounihan.flat.xml".
+# It does not support the grouped database format.
+#
+# Invoke as ./Generate-GraphemeBreakTableFromUCD ucd.nounihan.flat.xml |
+#           Out-File -Encoding UTF-8 Temporary.cpp
+#
+# [1]: https://www.unicode.org/Public/UCD/latest/ucdxml/
+# [2]: https://www.unicode.org/reports/tr42/
+
+[Diagnostics.CodeAnalysis.SuppressMessageAttribute('PSAvoidUsingPositionalParameters', '')]
+[CmdletBinding()]
+Param(
+    [Parameter(Position=0, ValueFromPipeline=$true, ParameterSetName="Parsed")]
+    [System.Xml.XmlDocument]$InputObject,
+
+    [Parameter(Position=0, ValueFromPipelineByPropertyName=$true, ParameterSetName="Unparsed")]
+    [string]$Path = "ucd.nounihan.flat.xml"
+)
+
+# The names of GraphemeClusterBreak in GraphemeSegmenter.hpp.
+$GraphemeClusterBreaks = @{
+    "XX"  = "Other";
+    "CR"  = "CR";
+    "LF"  = "LF";
+    "CN"  = "Control";
+    "EX"  = "Extend";
+    "ZWJ" = "ZWJ";
+    "RI"  = "RegionalIndicator";
+    "PP"  = "Prepend";
+    "SM"  = "SpacingMark";
+    "L"   = "L";
+    "V"   = "V";
+    "T"   = "T";
+    "LV"  = "LV";
+    # See above.
+    "LVT" = "LV";
+}
+
+Function Get-UCDEntryRange($entry) {
+    $s = $e = 0
+    if ($null -ne $entry.cp) {
+        # Individual Codepoint
+        $s = $e = [int]("0x"+$entry.cp)
+    } ElseIf ($null -ne $entry."first-cp") {
+        # Range of Codepoints
+        $s = [int]("0x"+$entry."first-cp")
+        $e = [int]("0x"+$entry."last-cp")
+    }
+    $s
+    $e
+}
+
+Function Get-UCDEntryBreak($entry) {
+    $value = $GraphemeClusterBreaks[$entry.GCB] ?? "Other"
+    If ($value -eq "Other" -and $entry.ExtPict -eq "Y") {
+        "ExtendedPictographic"
+        Return
+    }
+    $value
+}
+
+# Ingest UCD
+If ($null -eq $InputObject) {
+    $InputObject = [xml](Get-Content $Path)
+}
+
+$UCDRepertoire = $InputObject.ucd.repertoire.ChildNodes | Sort-Object {
+    # Sort by either cp or first-cp (for ranges)
+    if ($null -ne $_.cp) {
+        [int]("0x"+$_.cp)
+    } ElseIf ($null -ne $_."first-cp") {
+        [int]("0x"+$_."first-cp")
+    }
+}
+
+$runs = [System.Collections.Generic.List[Object]]::New(2048)
+$next = 0
+ForEach($v in $UCDRepertoire) {
+    $start, $end = Get-UCDEntryRange $v
+    $value = Get-UCDEntryBreak $v
+
+    If ($start -gt $next -and ($runs.Count -eq 0 -or $runs[$runs.Count - 1].Value -ne "Other")) {
+        # Codepoints missing from the repertoire are Other.
+        $runs.Add([PSCustomObject]@{ Start = $next; Value = "Other" })
+    }
+    If ($runs.Count -eq 0 -or $runs[$runs.Count - 1].Value -ne $value) {
+        $runs.Add([PSCustomObject]@{ Start = $start; Value = $value })
+    }
+    $next = $end + 1
+}
+
+# Emit Code
+"    // Generated by {0} on {1} (UTC) from {2}." -f $MyInvocation.MyCommand.Name, (Get-Date -AsUTC), $InputObject.ucd.description
+"    static constexpr std::array<uint32_t, {0}> s_graphemeBreakTable{{" -f $runs.Count
+ForEach($_ in $runs) {
+"        GraphemeBreakRun(0x{0:x}, GraphemeClusterBreak::{1})," -f $_.Start, $_.Value
+}
+"    };"